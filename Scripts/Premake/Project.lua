@@ -1,3 +1,30 @@
+local scalarMathOptionTrigger = "scalar-math"
+
+newoption {
+    trigger = scalarMathOptionTrigger,
+    description = "Use the portable scalar math paths instead of SIMD, for comparison"
+}
+
+local fastTrigOptionTrigger = "fast-trig"
+
+newoption {
+    trigger = fastTrigOptionTrigger,
+    value = "ACCURACY",
+    description = "Route the engine's trigonometry through Math::Fast at the given accuracy",
+    allowed = {
+        { "fast",   "Relative error below 1.2e-3" },
+        { "medium", "Relative error below 5e-6" },
+        { "full",   "Within 5 ULP of the exact result" },
+    }
+}
+
+local deterministicMathOptionTrigger = "deterministic-math"
+
+newoption {
+    trigger = deterministicMathOptionTrigger,
+    description = "Strict floating point without FMA or libm trigonometry, for reproducible simulations"
+}
+
 function filterEditor()
     filter(string.format("platforms:*%s*", Config.Platforms.Editor))
 end
@@ -62,6 +89,25 @@ function applyCommonCppSettings(assemblyDefinition)
         }
     end
 
+    if _OPTIONS[scalarMathOptionTrigger] then
+        defines { string.upper(Config.ShortName) .. "_MATH_SCALAR=1" }
+    end
+
+    if _OPTIONS[fastTrigOptionTrigger] then
+        local fastTrigLevels = { fast = 1, medium = 2, full = 3 }
+        defines { string.upper(Config.ShortName) .. "_MATH_FAST_TRIG=" .. fastTrigLevels[_OPTIONS[fastTrigOptionTrigger]] }
+    end
+
+    if _OPTIONS[deterministicMathOptionTrigger] then
+        defines { string.upper(Config.ShortName) .. "_MATH_DETERMINISTIC=1" }
+        floatingpoint "strict"
+
+        -- libm differs between platforms, Math::Fast is plain arithmetic
+        if not _OPTIONS[fastTrigOptionTrigger] then
+            defines { string.upper(Config.ShortName) .. "_MATH_FAST_TRIG=3" }
+        end
+    end
+
     flags {
         "FatalWarnings",
         "MultiProcessorCompile",
@@ -70,6 +116,17 @@ function applyCommonCppSettings(assemblyDefinition)
     filter "kind:StaticLib"
         targetdir(Config.LibraryDir .. Config.OutputDir)
 
+    -- Unlike MSVC, GCC and Clang also reassociate SIMD intrinsics under fast math, which undoes the split
+    -- constant range reduction in Math::Fast::SinCos
+    filter "toolset:gcc or clang"
+        buildoptions { "-fno-associative-math" }
+
+    -- GCC and Clang contract a * b + c into FMA by default, even without fast math
+    if _OPTIONS[deterministicMathOptionTrigger] then
+        filter "toolset:gcc or clang"
+            buildoptions { "-ffp-contract=off" }
+    end
+
     filter "toolset:msc*"
         disablewarnings {
             "4251", -- member needs dll-interface to be used by clients of class
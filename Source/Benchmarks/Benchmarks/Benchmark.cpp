@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		std::vector<BenchmarkDefinition>&
+		Registry()
+		{
+			// Function local so registrations from other translation units never see it uninitialized
+			static std::vector<BenchmarkDefinition> registry;
+			return registry;
+		}
+
+		double
+		Median(std::vector<double> a_values)
+		{
+			std::sort(a_values.begin(), a_values.end());
+			std::size_t middle = a_values.size() / 2;
+			return a_values.size() % 2 == 1 ? a_values[middle] : (a_values[middle - 1] + a_values[middle]) / 2;
+		}
+
+		/// Runs a fresh copy of the benchmark, including its setup
+		State
+		Sample(BenchmarkDefinition const& a_benchmark, std::size_t a_iterations)
+		{
+			State state(a_iterations);
+			a_benchmark.function(state);
+			return state;
+		}
+	}
+
+	namespace Detail
+	{
+		void
+		UseCharPointer(char const volatile* a_pointer)
+		{
+			OYL_UNUSED(a_pointer);
+		}
+	}
+
+	Registration::Registration(char const* a_group, char const* a_name, BenchmarkFunction a_function)
+	{
+		Registry().push_back(BenchmarkDefinition { a_group, a_name, a_function });
+	}
+
+	std::vector<BenchmarkDefinition>
+	GetBenchmarks()
+	{
+		std::vector<BenchmarkDefinition> result = Registry();
+		std::sort(result.begin(), result.end(), [](BenchmarkDefinition const& a_lhs, BenchmarkDefinition const& a_rhs)
+		{
+			int group = std::string(a_lhs.group).compare(a_rhs.group);
+			return group != 0 ? group < 0 : std::string(a_lhs.name) < a_rhs.name;
+		});
+		return result;
+	}
+
+	BenchmarkResult
+	Run(BenchmarkDefinition const& a_benchmark, double a_minimumTime, int a_repetitions)
+	{
+		double minimumNanoseconds = a_minimumTime * 1e9;
+
+		// Grow the iteration count until one sample takes long enough, then extrapolate to the minimum time
+		std::size_t iterations = 1;
+		for (;;)
+		{
+			State state = Sample(a_benchmark, iterations);
+			if (state.Elapsed() >= minimumNanoseconds)
+			{
+				break;
+			}
+
+			double      scale = state.Elapsed() > 0 ? minimumNanoseconds * 1.2 / state.Elapsed() : 100.0;
+			std::size_t next  = static_cast<std::size_t>(static_cast<double>(iterations) * std::min(scale, 100.0));
+			iterations = std::max(next, iterations + 1);
+
+			if (state.Elapsed() * 10 >= minimumNanoseconds)
+			{
+				break;
+			}
+		}
+
+		std::vector<double> nanoseconds, ticks;
+		std::size_t         itemsPerIteration = 1, bytesPerIteration = 0;
+		for (int i = 0; i < a_repetitions; i++)
+		{
+			State state = Sample(a_benchmark, iterations);
+
+			double items = static_cast<double>(state.Iterations() * state.ItemsPerIteration());
+			nanoseconds.push_back(state.Elapsed() / items);
+			ticks.push_back(static_cast<double>(state.Ticks()) / items);
+
+			itemsPerIteration = state.ItemsPerIteration();
+			bytesPerIteration = state.BytesPerIteration();
+		}
+
+		BenchmarkResult result;
+		result.group              = a_benchmark.group;
+		result.name               = a_benchmark.name;
+		result.iterations         = iterations;
+		result.nanosecondsPerItem = Median(nanoseconds);
+		result.ticksPerItem       = Median(ticks);
+		result.itemsPerSecond     = 1e9 / result.nanosecondsPerItem;
+		result.bytesPerSecond     = result.itemsPerSecond * static_cast<double>(bytesPerIteration) / static_cast<double>(itemsPerIteration);
+		return result;
+	}
+
+	std::vector<float>
+	RandomFloats(std::size_t a_count, float a_min, float a_max, unsigned a_seed)
+	{
+		std::mt19937                          engine(a_seed);
+		std::uniform_real_distribution<float> distribution(a_min, a_max);
+
+		std::vector<float> result(a_count);
+		for (float& value : result)
+		{
+			value = distribution(engine);
+		}
+		return result;
+	}
+}
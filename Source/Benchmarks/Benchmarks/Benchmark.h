@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Core/Common.h"
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#endif
+
+/**
+ * A minimal benchmark harness for the math library.
+ *
+ * Each benchmark is a function that prepares its inputs, then hands the timed part to State::Measure. The runner
+ * picks the iteration count so every sample lasts at least the requested time, repeats the samples and reports the
+ * median. Results are written as JSON so runs can be diffed across commits, see Main.cpp for the format.
+ */
+namespace Oyl::Benchmarks
+{
+	namespace Detail
+	{
+		/// Defined out of line so the compiler can't see that the pointer is never used
+		void UseCharPointer(char const volatile* a_pointer);
+
+		OYL_FORCE_INLINE
+		std::uint64_t
+		ReadTimestamp()
+		{
+		#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+		#else
+			return 0;
+		#endif
+		}
+	}
+
+	/// \brief Forces a_value to be computed, without adding more than a register move to the loop
+	template<typename T>
+	OYL_FORCE_INLINE
+	void
+	DoNotOptimize(T const& a_value)
+	{
+	#if defined(_MSC_VER)
+		Detail::UseCharPointer(&reinterpret_cast<char const volatile&>(a_value));
+		_ReadWriteBarrier();
+	#else
+		asm volatile("" : : "r,m"(a_value) : "memory");
+	#endif
+	}
+
+	/// \brief Forces pending writes to memory to happen, ie. the outputs of a bulk kernel
+	OYL_FORCE_INLINE
+	void
+	ClobberMemory()
+	{
+	#if defined(_MSC_VER)
+		_ReadWriteBarrier();
+	#else
+		asm volatile("" : : : "memory");
+	#endif
+	}
+
+	class State
+	{
+	public:
+		explicit
+		State(std::size_t a_iterations)
+			: m_iterations(a_iterations) {}
+
+		std::size_t Iterations() const noexcept { return m_iterations; }
+
+		/// \brief How many operations one iteration of the measured body performs, ie. the batch size
+		void SetItemsPerIteration(std::size_t a_items) { m_itemsPerIteration = a_items; }
+
+		std::size_t ItemsPerIteration() const noexcept { return m_itemsPerIteration; }
+
+		/// \brief Bytes read and written by one iteration, reported as throughput when set
+		void SetBytesPerIteration(std::size_t a_bytes) { m_bytesPerIteration = a_bytes; }
+
+		std::size_t BytesPerIteration() const noexcept { return m_bytesPerIteration; }
+
+		/// \brief Runs a_body Iterations() times, only this part of a benchmark is timed
+		template<typename TFunction>
+		void
+		Measure(TFunction&& a_body)
+		{
+			std::uint64_t startTicks = Detail::ReadTimestamp();
+			auto          start      = std::chrono::steady_clock::now();
+
+			for (std::size_t i = 0; i < m_iterations; i++)
+			{
+				a_body();
+			}
+
+			auto end = std::chrono::steady_clock::now();
+			m_ticks   = Detail::ReadTimestamp() - startTicks;
+			m_elapsed = std::chrono::duration<double, std::nano>(end - start).count();
+		}
+
+		/**
+		 * \brief Runs passes of tasks Iterations() times, only the slowest task of each pass is timed
+		 * \remarks For work split into tasks meant for a thread each, timed without threads so the result doesn't
+		 *          depend on the cores of the machine. a_task(pass, task) runs one task, every task of a pass runs
+		 *          before the next pass. The time is the critical path, what the work takes with a thread per task
+		 *          and nothing else running.
+		 */
+		template<typename TFunction>
+		void
+		MeasureCriticalPath(std::size_t a_passCount, std::size_t a_taskCount, TFunction&& a_task)
+		{
+			m_ticks   = 0;
+			m_elapsed = 0;
+			for (std::size_t i = 0; i < m_iterations; i++)
+			{
+				for (std::size_t pass = 0; pass < a_passCount; pass++)
+				{
+					std::uint64_t slowestTicks = 0;
+					double        slowest      = 0;
+					for (std::size_t task = 0; task < a_taskCount; task++)
+					{
+						std::uint64_t startTicks = Detail::ReadTimestamp();
+						auto          start      = std::chrono::steady_clock::now();
+
+						a_task(pass, task);
+
+						auto end = std::chrono::steady_clock::now();
+						slowestTicks = std::max(slowestTicks, Detail::ReadTimestamp() - startTicks);
+						slowest      = std::max(slowest, std::chrono::duration<double, std::nano>(end - start).count());
+					}
+					m_ticks   += slowestTicks;
+					m_elapsed += slowest;
+				}
+			}
+		}
+
+		/// \return Nanoseconds spent in Measure, or the critical path of MeasureCriticalPath
+		double Elapsed() const noexcept { return m_elapsed; }
+
+		/// \return Timestamp counter ticks spent in Measure or on the critical path, zero where there is no timestamp counter
+		std::uint64_t Ticks() const noexcept { return m_ticks; }
+
+	private:
+		std::size_t m_iterations;
+		std::size_t m_itemsPerIteration = 1;
+		std::size_t m_bytesPerIteration = 0;
+
+		double        m_elapsed = 0;
+		std::uint64_t m_ticks   = 0;
+	};
+
+	/// Inputs per iteration for benchmarks of single value functions, few enough that two Matrix4 arrays fit in L1
+	constexpr std::size_t batch_size = 256;
+
+	using BenchmarkFunction = void (*)(State&);
+
+	struct BenchmarkDefinition
+	{
+		char const*       group;
+		char const*       name;
+		BenchmarkFunction function;
+	};
+
+	/// \brief Adds a benchmark to the global list on construction, meant for static instances
+	struct Registration
+	{
+		Registration(char const* a_group, char const* a_name, BenchmarkFunction a_function);
+	};
+
+	/// \return Every registered benchmark, sorted by group then name
+	std::vector<BenchmarkDefinition>
+	GetBenchmarks();
+
+	struct BenchmarkResult
+	{
+		std::string group;
+		std::string name;
+
+		std::size_t iterations;
+
+		/// Medians over the repetitions
+		double nanosecondsPerItem;
+		double ticksPerItem;
+		double itemsPerSecond;
+		double bytesPerSecond;
+	};
+
+	/**
+	 * \brief Times a benchmark
+	 * \param a_minimumTime Minimum duration of each sample in seconds
+	 * \param a_repetitions Number of samples, the median is reported
+	 */
+	BenchmarkResult
+	Run(BenchmarkDefinition const& a_benchmark, double a_minimumTime, int a_repetitions);
+
+	/// \return a_count values uniformly distributed in [a_min, a_max), the same for every run
+	std::vector<float>
+	RandomFloats(std::size_t a_count, float a_min = -1.0f, float a_max = 1.0f, unsigned a_seed = 1234);
+
+	/// \return a_count vectors, matrices or quaternions with every element of their data array random
+	template<typename TValue>
+	std::vector<TValue>
+	RandomValues(std::size_t a_count, float a_min = -1.0f, float a_max = 1.0f, unsigned a_seed = 1234)
+	{
+		constexpr std::size_t components = sizeof(TValue::data) / sizeof(TValue::data[0]);
+
+		std::vector<float>  floats = RandomFloats(a_count * components, a_min, a_max, a_seed);
+		std::vector<TValue> result(a_count);
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			for (std::size_t c = 0; c < components; c++)
+			{
+				result[i].data[c] = floats[i * components + c];
+			}
+		}
+		return result;
+	}
+}
@@ -0,0 +1,1655 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include <cstring>
+
+#include "Core/Math/Affine3.h"
+#include "Core/Math/BVH.h"
+#include "Core/Math/Bounds.h"
+#include "Core/Math/Collision.h"
+#include "Core/Math/Curve.h"
+#include "Core/Math/DynamicTree.h"
+#include "Core/Math/Geometry.h"
+#include "Core/Math/MatrixLayout.h"
+#include "Core/Math/Noise.h"
+#include "Core/Math/Packing.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/Random.h"
+#include "Core/Math/SpatialHash.h"
+#include "Core/Math/TransformStream.h"
+#include "Core/Math/Transformations.h"
+#include "Core/Math/VectorExpression.h"
+#include "Core/Math/VectorStream.h"
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		/// Elements per kernel call, enough to amortize the call and small enough to stay in L2
+		constexpr std::size_t stream_size = 4096;
+
+		/// A thread per core for the WorkerPool overloads, shared so the threads start once
+		WorkerPool&
+		Pool()
+		{
+			static WorkerPool pool;
+			return pool;
+		}
+
+		Matrix4
+		SomeTransform()
+		{
+			return Matrix4(Matrix::Rotate(30, Vector::Normalize(Vector3(1, 2, 3)))) * Matrix::Translate(Vector3(1, 2, 3));
+		}
+
+		std::vector<Quaternionf>
+		RandomRotations(std::size_t a_count, unsigned a_seed)
+		{
+			std::vector<Quaternionf> result = RandomValues<Quaternionf>(a_count, -1, 1, a_seed);
+			for (Quaternionf& rotation : result)
+			{
+				rotation = Quaternion::Normalize(rotation);
+			}
+			return result;
+		}
+
+		std::vector<Vector3>
+		RandomDirections(std::size_t a_count)
+		{
+			std::vector<Vector3> result = RandomValues<Vector3>(a_count);
+			for (Vector3& direction : result)
+			{
+				direction = Vector::Normalize(direction);
+			}
+			return result;
+		}
+
+	#pragma region Vector Streams
+		void
+		TransformPointsStream(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(stream_size, -100, 100);
+			Vector3Stream        input(points.data(), points.size());
+			Vector3Stream        output(stream_size);
+			Matrix4              transform = SomeTransform();
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 6);
+			a_state.Measure([&]
+			{
+				Vector::TransformPoints(transform, input, output);
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as TransformPointsStream on an array of structures, one Vector4 * Matrix4 at a time
+		void
+		TransformPointsArray(State& a_state)
+		{
+			std::vector<Vector3> input = RandomValues<Vector3>(stream_size, -100, 100);
+			std::vector<Vector3> output(stream_size);
+			Matrix4              transform = SomeTransform();
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 6);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = Vector3(Vector4(input[i], 1) * transform);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		NormalizeStream(State& a_state)
+		{
+			std::vector<Vector3> vectors = RandomValues<Vector3>(stream_size);
+			Vector3Stream        input(vectors.data(), vectors.size());
+			Vector3Stream        output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 6);
+			a_state.Measure([&]
+			{
+				Vector::Normalize(input, output);
+				ClobberMemory();
+			});
+		}
+
+		void
+		DotStream(State& a_state)
+		{
+			std::vector<Vector3> lhsVectors = RandomValues<Vector3>(stream_size, -1, 1, 1);
+			std::vector<Vector3> rhsVectors = RandomValues<Vector3>(stream_size, -1, 1, 2);
+			Vector3Stream        lhs(lhsVectors.data(), lhsVectors.size());
+			Vector3Stream        rhs(rhsVectors.data(), rhsVectors.size());
+			std::vector<float>   output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 7);
+			a_state.Measure([&]
+			{
+				Vector::Dot(lhs, rhs, output.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		CrossStream(State& a_state)
+		{
+			std::vector<Vector3> lhsVectors = RandomValues<Vector3>(stream_size, -1, 1, 1);
+			std::vector<Vector3> rhsVectors = RandomValues<Vector3>(stream_size, -1, 1, 2);
+			Vector3Stream        lhs(lhsVectors.data(), lhsVectors.size());
+			Vector3Stream        rhs(rhsVectors.data(), rhsVectors.size());
+			Vector3Stream        output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 9);
+			a_state.Measure([&]
+			{
+				Vector::Cross(lhs, rhs, output);
+				ClobberMemory();
+			});
+		}
+
+		/// p + (v + g * dt) * dt fused into a single pass over the streams
+		void
+		IntegrateStream(State& a_state)
+		{
+			std::vector<Vector3> positions  = RandomValues<Vector3>(stream_size, -1, 1, 1);
+			std::vector<Vector3> velocities = RandomValues<Vector3>(stream_size, -1, 1, 2);
+			Vector3Stream        p(positions.data(), positions.size());
+			Vector3Stream        v(velocities.data(), velocities.size());
+			Vector3Stream        output(stream_size);
+			Vector3 const        gravity(0.0f, -9.81f, 0.0f);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 9);
+			a_state.Measure([&]
+			{
+				Vector::Assign(output, Vector::Lazy(p) + (Vector::Lazy(v) + gravity * 0.016f) * 0.016f);
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as IntegrateStream on an array of structures with the eager operators
+		void
+		IntegrateArray(State& a_state)
+		{
+			std::vector<Vector3> p = RandomValues<Vector3>(stream_size, -1, 1, 1);
+			std::vector<Vector3> v = RandomValues<Vector3>(stream_size, -1, 1, 2);
+			std::vector<Vector3> output(stream_size);
+			Vector3 const        gravity(0.0f, -9.81f, 0.0f);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 9);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = p[i] + (v[i] + gravity * 0.016f) * 0.016f;
+				}
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Transforms
+		void
+		AffineMultiplyBatch(State& a_state)
+		{
+			std::vector<Affine3> lhs = RandomValues<Affine3>(stream_size, -1, 1, 1);
+			std::vector<Affine3> rhs = RandomValues<Affine3>(stream_size, -1, 1, 2);
+			std::vector<Affine3> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(Affine3) * 3);
+			a_state.Measure([&]
+			{
+				Affine::MultiplyBatch(lhs.data(), rhs.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as AffineMultiplyBatch with full Matrix4 products
+		void
+		Matrix4MultiplyArray(State& a_state)
+		{
+			std::vector<Matrix4> lhs = RandomValues<Matrix4>(stream_size, -1, 1, 1);
+			std::vector<Matrix4> rhs = RandomValues<Matrix4>(stream_size, -1, 1, 2);
+			std::vector<Matrix4> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(Matrix4) * 3);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = lhs[i] * rhs[i];
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		QuaternionMultiplyBatch(State& a_state)
+		{
+			std::vector<Quaternionf> lhs = RandomRotations(stream_size, 1);
+			std::vector<Quaternionf> rhs = RandomRotations(stream_size, 2);
+			std::vector<Quaternionf> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(Quaternionf) * 3);
+			a_state.Measure([&]
+			{
+				Quaternion::MultiplyBatch(lhs.data(), rhs.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		QuaternionSlerpBatch(State& a_state)
+		{
+			std::vector<Quaternionf> lhs = RandomRotations(stream_size, 1);
+			std::vector<Quaternionf> rhs = RandomRotations(stream_size, 2);
+			std::vector<float>       t   = RandomFloats(stream_size, 0, 1);
+			std::vector<Quaternionf> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Quaternionf) * 3 + sizeof(float)));
+			a_state.Measure([&]
+			{
+				Quaternion::SlerpBatch(t.data(), lhs.data(), rhs.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as QuaternionSlerpBatch one pair at a time
+		void
+		QuaternionSlerpArray(State& a_state)
+		{
+			std::vector<Quaternionf> lhs = RandomRotations(stream_size, 1);
+			std::vector<Quaternionf> rhs = RandomRotations(stream_size, 2);
+			std::vector<float>       t   = RandomFloats(stream_size, 0, 1);
+			std::vector<Quaternionf> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Quaternionf) * 3 + sizeof(float)));
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = Quaternion::Slerp(t[i], lhs[i], rhs[i]);
+				}
+				ClobberMemory();
+			});
+		}
+
+		TransformStream
+		RandomTransforms(unsigned a_seed)
+		{
+			std::vector<Vector3>     translations = RandomValues<Vector3>(stream_size, -100, 100, a_seed);
+			std::vector<Quaternionf> rotations    = RandomRotations(stream_size, a_seed);
+			std::vector<Vector3>     scales       = RandomValues<Vector3>(stream_size, 0.5f, 2, a_seed);
+
+			TransformStream result;
+			result.Resize(stream_size);
+			for (std::size_t i = 0; i < stream_size; i++)
+			{
+				result.Set(i, translations[i], rotations[i], scales[i]);
+			}
+			return result;
+		}
+
+		void
+		InterpolateTransformsMatrix4(State& a_state)
+		{
+			TransformStream      previous = RandomTransforms(1);
+			TransformStream      current  = RandomTransforms(2);
+			std::vector<Matrix4> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) * 20 + sizeof(Matrix4)));
+			a_state.Measure([&]
+			{
+				Interpolation::TransformBatch(previous, current, 0.4f, output.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		InterpolateTransformsAffine(State& a_state)
+		{
+			TransformStream      previous = RandomTransforms(1);
+			TransformStream      current  = RandomTransforms(2);
+			std::vector<Affine3> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) * 20 + sizeof(Affine3)));
+			a_state.Measure([&]
+			{
+				Interpolation::TransformBatch(previous, current, 0.4f, output.data());
+				ClobberMemory();
+			});
+		}
+
+		/// InterpolateTransformsMatrix4 on a thread per core, for this size mostly the cost of waking the threads
+		void
+		InterpolateTransformsPool(State& a_state)
+		{
+			TransformStream      previous = RandomTransforms(1);
+			TransformStream      current  = RandomTransforms(2);
+			std::vector<Matrix4> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) * 20 + sizeof(Matrix4)));
+			a_state.Measure([&]
+			{
+				Interpolation::TransformBatch(previous, current, 0.4f, output.data(), Pool());
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as InterpolateTransformsMatrix4 one transform at a time, from arrays of structures
+		void
+		InterpolateTransformsArray(State& a_state)
+		{
+			std::vector<Vector3>     previousTranslations = RandomValues<Vector3>(stream_size, -100, 100, 1);
+			std::vector<Vector3>     currentTranslations  = RandomValues<Vector3>(stream_size, -100, 100, 2);
+			std::vector<Quaternionf> previousRotations    = RandomRotations(stream_size, 1);
+			std::vector<Quaternionf> currentRotations     = RandomRotations(stream_size, 2);
+			std::vector<Vector3>     previousScales       = RandomValues<Vector3>(stream_size, 0.5f, 2, 1);
+			std::vector<Vector3>     currentScales        = RandomValues<Vector3>(stream_size, 0.5f, 2, 2);
+			std::vector<Matrix4>     output(stream_size);
+
+			float const alpha = 0.4f;
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) * 20 + sizeof(Matrix4)));
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					Vector3     translation = previousTranslations[i] + (currentTranslations[i] - previousTranslations[i]) * alpha;
+					Quaternionf rotation    = Quaternion::Slerp(alpha, previousRotations[i], currentRotations[i]);
+					Vector3     scale       = previousScales[i] + (currentScales[i] - previousScales[i]) * alpha;
+					output[i] = Matrix4(Affine::FromTRS(translation, rotation, scale));
+				}
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Culling
+		Frustum
+		SomeFrustum()
+		{
+			Matrix4 view = Matrix::ViewInverse(Matrix::LookAt(Vector3(0, 0, -50), Vector3(0, 0, 0)));
+			return Bounds::ExtractFrustum(view * Matrix::Perspective(90, 9.0f / 16.0f, 0.1f, 200));
+		}
+
+		void
+		CullBoxes(State& a_state)
+		{
+			std::vector<Vector3> centers = RandomValues<Vector3>(stream_size, -100, 100, 1);
+			std::vector<Vector3> extents = RandomValues<Vector3>(stream_size, 0.5f, 5, 2);
+			std::vector<AABB>    boxes(stream_size);
+			for (std::size_t i = 0; i < stream_size; i++)
+			{
+				boxes[i] = Bounds::FromCenterExtents(centers[i], extents[i]);
+			}
+
+			AABBStream          stream(boxes.data(), boxes.size());
+			std::vector<uint32> visible(stream_size);
+			Frustum             frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 6);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Bounds::Cull(frustum, stream, visible.data()));
+				ClobberMemory();
+			});
+		}
+
+		void
+		CullSpheres(State& a_state)
+		{
+			std::vector<Vector3> centers = RandomValues<Vector3>(stream_size, -100, 100, 1);
+			std::vector<float>   radii   = RandomFloats(stream_size, 0.5f, 5, 2);
+			std::vector<Sphere>  spheres(stream_size);
+			for (std::size_t i = 0; i < stream_size; i++)
+			{
+				spheres[i] = Sphere { centers[i], radii[i] };
+			}
+
+			SphereStream        stream(spheres.data(), spheres.size());
+			std::vector<uint32> visible(stream_size);
+			Frustum             frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(float) * 4);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Bounds::Cull(frustum, stream, visible.data()));
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Packing
+		void
+		EncodeHalf(State& a_state)
+		{
+			std::vector<float> input = RandomFloats(stream_size, -1000, 1000);
+			std::vector<half>  output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) + sizeof(half)));
+			a_state.Measure([&]
+			{
+				Packing::EncodeHalf(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		DecodeHalf(State& a_state)
+		{
+			std::vector<float> values = RandomFloats(stream_size, -1000, 1000);
+			std::vector<half>  input(stream_size);
+			std::vector<float> output(stream_size);
+			Packing::EncodeHalf(values.data(), input.data(), stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(float) + sizeof(half)));
+			a_state.Measure([&]
+			{
+				Packing::DecodeHalf(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		EncodeOctahedral(State& a_state)
+		{
+			std::vector<Vector3>   input = RandomDirections(stream_size);
+			std::vector<Snorm16x2> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Vector3) + sizeof(Snorm16x2)));
+			a_state.Measure([&]
+			{
+				Packing::EncodeOctahedral(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		DecodeOctahedral(State& a_state)
+		{
+			std::vector<Vector3>   normals = RandomDirections(stream_size);
+			std::vector<Snorm16x2> input(stream_size);
+			std::vector<Vector3>   output(stream_size);
+			Packing::EncodeOctahedral(normals.data(), input.data(), stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Vector3) + sizeof(Snorm16x2)));
+			a_state.Measure([&]
+			{
+				Packing::DecodeOctahedral(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		PackQuaternion(State& a_state)
+		{
+			std::vector<Quaternionf>      input = RandomRotations(stream_size, 1);
+			std::vector<PackedQuaternion> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Quaternionf) + sizeof(PackedQuaternion)));
+			a_state.Measure([&]
+			{
+				Packing::PackQuaternion(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		UnpackQuaternion(State& a_state)
+		{
+			std::vector<Quaternionf>      rotations = RandomRotations(stream_size, 1);
+			std::vector<PackedQuaternion> input(stream_size);
+			std::vector<Quaternionf>      output(stream_size);
+			Packing::PackQuaternion(rotations.data(), input.data(), stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * (sizeof(Quaternionf) + sizeof(PackedQuaternion)));
+			a_state.Measure([&]
+			{
+				Packing::UnpackQuaternion(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Matrix Layout
+		void
+		ConvertLayoutMatrix4(State& a_state)
+		{
+			std::vector<Matrix4>            input = RandomValues<Matrix4>(stream_size);
+			std::vector<Matrix4ColumnMajor> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(Matrix4) * 2);
+			a_state.Measure([&]
+			{
+				Matrix::ConvertLayout(input.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// The upload path without layouts, a Transpose per matrix followed by a copy into the buffer
+		void
+		TransposeCopyMatrix4(State& a_state)
+		{
+			std::vector<Matrix4> input = RandomValues<Matrix4>(stream_size);
+			std::vector<Matrix4> transposed(stream_size);
+			std::vector<Matrix4> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.SetBytesPerIteration(stream_size * sizeof(Matrix4) * 2);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					transposed[i] = Matrix::Transpose(input[i]);
+				}
+				std::memcpy(output.data(), transposed.data(), stream_size * sizeof(Matrix4));
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+
+	#pragma region Curves
+		/// Control points of a curve long enough that the samples spread over many segments
+		constexpr std::size_t curve_size = 64;
+
+		void
+		CurveSampleBatch(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(curve_size);
+			std::vector<float>   t      = RandomFloats(stream_size, 0, 1);
+			std::vector<Vector3> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Curve::SampleBatch(Curve::Basis::CatmullRom, points.data(), curve_size, t.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as CurveSampleBatch one sample at a time
+		void
+		CurveSampleArray(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(curve_size);
+			std::vector<float>   t      = RandomFloats(stream_size, 0, 1);
+			std::vector<Vector3> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = Curve::Sample(Curve::Basis::CatmullRom, points.data(), curve_size, t[i]);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		CurveSampleQuaternionBatch(State& a_state)
+		{
+			std::vector<Quaternionf> keys = RandomRotations(curve_size, 1);
+			std::vector<float>       t    = RandomFloats(stream_size, 0, 1);
+			std::vector<Quaternionf> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Curve::SampleBatch(Curve::Basis::CatmullRom, keys.data(), curve_size, t.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// The spherical Catmull-Rom per sample, six slerps each
+		void
+		CurveSampleQuaternionArray(State& a_state)
+		{
+			std::vector<Quaternionf> keys = RandomRotations(curve_size, 1);
+			std::vector<float>       t    = RandomFloats(stream_size, 0, 1);
+			std::vector<Quaternionf> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = Curve::Sample(Curve::Basis::CatmullRom, keys.data(), curve_size, t[i]);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		CurveParameterBatch(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(curve_size);
+			Curve::ArcLengthTable table([&](float a_t) { return Curve::Sample(Curve::Basis::CatmullRom, points.data(), curve_size, a_t); }, 1024);
+
+			std::vector<float> distances(stream_size);
+			for (std::size_t i = 0; i < stream_size; i++)
+			{
+				distances[i] = table.Length() * static_cast<float>(i) / static_cast<float>(stream_size);
+			}
+			std::vector<float> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Curve::ParameterBatch(table, distances.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Random
+		void
+		UniformBatch(State& a_state)
+		{
+			Xoshiro128x8       generator;
+			std::vector<float> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Random::Uniform(generator, output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// Baseline for the batch functions, the standard library engine and distribution one value at a time
+		void
+		UniformStandard(State& a_state)
+		{
+			std::mt19937                          engine;
+			std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+			std::vector<float>                    output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (float& value : output)
+				{
+					value = distribution(engine);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		UniformXoshiro256(State& a_state)
+		{
+			Xoshiro256         generator;
+			std::vector<float> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (float& value : output)
+				{
+					value = generator.NextFloat();
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		NormalBatch(State& a_state)
+		{
+			Xoshiro128x8       generator;
+			std::vector<float> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Random::Normal(generator, output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		NormalStandard(State& a_state)
+		{
+			std::mt19937                    engine;
+			std::normal_distribution<float> distribution;
+			std::vector<float>              output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (float& value : output)
+				{
+					value = distribution(engine);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		UnitVectorsStream(State& a_state)
+		{
+			Xoshiro128x8  generator;
+			Vector3Stream output;
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Random::UnitVectors(generator, output, stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		UnitVectorsArray(State& a_state)
+		{
+			Xoshiro128x8         generator;
+			std::vector<Vector3> output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Random::UnitVectors(generator, output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		void
+		PointsInBoxStream(State& a_state)
+		{
+			Xoshiro128x8  generator;
+			Vector3Stream output;
+			AABB          box { Vector3(-10, 0, -10), Vector3(10, 5, 10) };
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Random::PointsInBox(generator, box, output, stream_size);
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Noise
+		NoiseSettings
+		TerrainNoise()
+		{
+			NoiseSettings result;
+			result.type      = NoiseType::Simplex;
+			result.fractal   = NoiseFractal::Fbm;
+			result.frequency = 0.05f;
+			return result;
+		}
+
+		void
+		NoiseFillGrid(State& a_state)
+		{
+			NoiseSettings const settings = TerrainNoise();
+			NoiseGrid3 const    grid     = { Vector3(-8.0f), Vector3(0.25f), Vector3u(16, 16, 16) };
+			std::vector<float>  output(grid.Count());
+
+			a_state.SetItemsPerIteration(grid.Count());
+			a_state.Measure([&]
+			{
+				Noise::FillGrid(settings, grid, output.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		NoiseFillGridPool(State& a_state)
+		{
+			NoiseSettings const settings = TerrainNoise();
+			NoiseGrid3 const    grid     = { Vector3(-8.0f), Vector3(0.25f), Vector3u(16, 16, 16) };
+			std::vector<float>  output(grid.Count());
+
+			a_state.SetItemsPerIteration(grid.Count());
+			a_state.Measure([&]
+			{
+				Noise::FillGrid(settings, grid, output.data(), Pool());
+				ClobberMemory();
+			});
+		}
+
+		void
+		NoiseSampleBatch(State& a_state)
+		{
+			NoiseSettings const  settings  = TerrainNoise();
+			std::vector<Vector3> positions = RandomValues<Vector3>(stream_size, -100, 100);
+			std::vector<float>   output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				Noise::SampleBatch(settings, positions.data(), output.data(), stream_size);
+				ClobberMemory();
+			});
+		}
+
+		/// Baseline for the batches, one position at a time through the single sample overload
+		void
+		NoiseSampleArray(State& a_state)
+		{
+			NoiseSettings const  settings  = TerrainNoise();
+			std::vector<Vector3> positions = RandomValues<Vector3>(stream_size, -100, 100);
+			std::vector<float>   output(stream_size);
+
+			a_state.SetItemsPerIteration(stream_size);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < stream_size; i++)
+				{
+					output[i] = Noise::Sample(settings, positions[i]);
+				}
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+	#pragma region Collision
+		/// Narrowphase pairs per kernel call, about what a busy physics frame produces
+		constexpr std::size_t pair_count = 256;
+
+		/// A pair per element, each B rotated at random and placed about a_spacing from its A so most of them touch
+		struct CollisionScene
+		{
+			std::vector<ConvexShape>   shapes;
+			std::vector<Matrix4>       transforms;
+			std::vector<CollisionPair> pairs;
+
+			CollisionScene(ConvexShape const& a_shapeA, ConvexShape const& a_shapeB, float a_spacing)
+			{
+				std::vector<Vector3> offsets = RandomValues<Vector3>(pair_count, -1, 1, 1);
+				std::vector<Vector3> axes    = RandomValues<Vector3>(pair_count * 2, -1, 1, 2);
+				std::vector<float>   angles  = RandomFloats(pair_count * 2, 0, 180, 3);
+
+				for (std::size_t i = 0; i < pair_count; i++)
+				{
+					Vector3 position = Vector3(static_cast<float>(i) * 10.0f, 0, 0);
+					Vector3 offset   = Vector::Normalize(offsets[i]) * a_spacing;
+
+					pairs.push_back(CollisionPair { static_cast<uint32>(shapes.size()), static_cast<uint32>(shapes.size() + 1) });
+					shapes.push_back(a_shapeA);
+					shapes.push_back(a_shapeB);
+					transforms.push_back(Matrix4(Matrix::Rotate(angles[2 * i], Vector::Normalize(axes[2 * i]))) * Matrix::Translate(position));
+					transforms.push_back(Matrix4(Matrix::Rotate(angles[2 * i + 1], Vector::Normalize(axes[2 * i + 1]))) * Matrix::Translate(position + offset));
+				}
+			}
+		};
+
+		Vector3Stream
+		RandomHull()
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(16, -1, 1, 4);
+			return Vector3Stream(points.data(), points.size());
+		}
+
+		void
+		CollideBatchBoxes(State& a_state)
+		{
+			ConvexShape const            box = ConvexShape::FromBox(Vector3(1.0f, 0.5f, 0.75f));
+			CollisionScene const         scene(box, box, 1.5f);
+			std::vector<ContactManifold> output(pair_count);
+
+			a_state.SetItemsPerIteration(pair_count);
+			a_state.Measure([&]
+			{
+				Collision::CollideBatch(scene.shapes.data(), scene.transforms.data(), scene.pairs.data(), pair_count, output.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		CollideBatchHulls(State& a_state)
+		{
+			Vector3Stream const          points = RandomHull();
+			ConvexShape const            hull   = ConvexShape::FromHull(points);
+			CollisionScene const         scene(hull, hull, 1.0f);
+			std::vector<ContactManifold> output(pair_count);
+
+			a_state.SetItemsPerIteration(pair_count);
+			a_state.Measure([&]
+			{
+				Collision::CollideBatch(scene.shapes.data(), scene.transforms.data(), scene.pairs.data(), pair_count, output.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		OverlapBatchHulls(State& a_state)
+		{
+			Vector3Stream const  points = RandomHull();
+			ConvexShape const    hull   = ConvexShape::FromHull(points);
+			CollisionScene const scene(hull, hull, 1.0f);
+			std::vector<char>    output(pair_count);
+
+			a_state.SetItemsPerIteration(pair_count);
+			a_state.Measure([&]
+			{
+				Collision::OverlapBatch(scene.shapes.data(), scene.transforms.data(), scene.pairs.data(), pair_count, reinterpret_cast<bool*>(output.data()));
+				ClobberMemory();
+			});
+		}
+
+		void
+		DistanceBatchCapsules(State& a_state)
+		{
+			ConvexShape const          capsule = ConvexShape::FromCapsule(Vector3(0, -1, 0), Vector3(0, 1, 0), 0.25f);
+			CollisionScene const       scene(capsule, capsule, 2.0f);
+			std::vector<ClosestPoints> output(pair_count);
+
+			a_state.SetItemsPerIteration(pair_count);
+			a_state.Measure([&]
+			{
+				Collision::DistanceBatch(scene.shapes.data(), scene.transforms.data(), scene.pairs.data(), pair_count, output.data());
+				ClobberMemory();
+			});
+		}
+	#pragma endregion
+
+	#pragma region Geometry
+		/// Triangles per kernel call, about a level's worth of collision geometry
+		constexpr std::size_t mesh_triangle_count = 100000;
+
+		/// Small triangles scattered through the same volume as the culling benchmarks, so SomeFrustum cuts some
+		std::vector<Vector3>
+		RandomTriangleSoup()
+		{
+			std::vector<Vector3> centers = RandomValues<Vector3>(mesh_triangle_count, -100, 100, 1);
+			std::vector<Vector3> corners = RandomValues<Vector3>(mesh_triangle_count * 3, -2, 2, 2);
+
+			std::vector<Vector3> result(mesh_triangle_count * 3);
+			for (std::size_t i = 0; i < result.size(); i++)
+			{
+				result[i] = centers[i / 3] + corners[i];
+			}
+			return result;
+		}
+
+		void
+		ClipTrianglesFrustum(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Vector3> output(3 * Geometry::MaxClippedTriangles(mesh_triangle_count, Frustum::side_count));
+			Frustum              frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.SetBytesPerIteration(mesh_triangle_count * sizeof(Vector3) * 3);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Geometry::ClipTriangles(triangles.data(), mesh_triangle_count, frustum.planes, Frustum::side_count, output.data()));
+				ClobberMemory();
+			});
+		}
+
+		/// The same work as ClipTrianglesFrustum one polygon at a time
+		void
+		ClipPolygonFrustum(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Vector3> output(3 * Geometry::MaxClippedTriangles(mesh_triangle_count, Frustum::side_count));
+			Frustum              frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.SetBytesPerIteration(mesh_triangle_count * sizeof(Vector3) * 3);
+			a_state.Measure([&]
+			{
+				std::size_t count = 0;
+				for (std::size_t i = 0; i < mesh_triangle_count; i++)
+				{
+					Vector3     polygon[3 + Frustum::side_count], scratch[3 + Frustum::side_count];
+					std::size_t points = Geometry::ClipPolygon(&triangles[i * 3], 3, frustum.planes, Frustum::side_count, polygon, scratch);
+					for (std::size_t j = 1; j + 1 < points; j++)
+					{
+						output[count * 3 + 0] = polygon[0];
+						output[count * 3 + 1] = polygon[j];
+						output[count * 3 + 2] = polygon[j + 1];
+						count++;
+					}
+				}
+				DoNotOptimize(count);
+				ClobberMemory();
+			});
+		}
+
+		void
+		SplitTrianglesPlane(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Vector3> front(mesh_triangle_count * 6), back(mesh_triangle_count * 6);
+			Plane const          plane = Bounds::PlaneFromNormal(Vector::Normalize(Vector3(1, 2, 3)), Vector3(5, 0, 0));
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.SetBytesPerIteration(mesh_triangle_count * sizeof(Vector3) * 3);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Geometry::SplitTriangles(triangles.data(), mesh_triangle_count, plane, front.data(), back.data()));
+				ClobberMemory();
+			});
+		}
+
+		/// Points on a sphere are all on the hull, the worst case for quickhull, giving about mesh_triangle_count faces
+		void
+		ConvexHullSphere(State& a_state)
+		{
+			std::vector<Vector3> points = RandomDirections(mesh_triangle_count / 2);
+			std::vector<uint32>  triangles(3 * Geometry::MaxHullTriangles(points.size()));
+
+			a_state.SetItemsPerIteration(points.size());
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Geometry::ConvexHull(points.data(), points.size(), triangles.data()));
+				ClobberMemory();
+			});
+		}
+
+		/// Points filling a box, most of them are discarded by the first tetrahedron
+		void
+		ConvexHullBox(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(mesh_triangle_count, -1, 1, 1);
+			std::vector<uint32>  triangles(3 * Geometry::MaxHullTriangles(points.size()));
+
+			a_state.SetItemsPerIteration(points.size());
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Geometry::ConvexHull(points.data(), points.size(), triangles.data()));
+				ClobberMemory();
+			});
+		}
+	#pragma region BVH
+		/// Rays per kernel call
+		constexpr std::size_t ray_count = 4096;
+
+		/// Rays from inside the triangle soup in every direction, each taking its own path through the tree
+		std::vector<Ray>
+		ScatteredRays()
+		{
+			std::vector<Vector3> origins    = RandomValues<Vector3>(ray_count, -100, 100, 3);
+			std::vector<Vector3> directions = RandomDirections(ray_count);
+
+			std::vector<Ray> result(ray_count);
+			for (std::size_t i = 0; i < ray_count; i++)
+			{
+				result[i] = Ray { origins[i], directions[i] };
+			}
+			return result;
+		}
+
+		/// A 64x64 image from a camera outside the soup, eight neighbouring pixels of a row per packet
+		std::vector<Ray>
+		CameraRays()
+		{
+			Vector3 const origin = Vector3(0, 0, -150);
+
+			std::vector<Ray> result(ray_count);
+			for (std::size_t i = 0; i < ray_count; i++)
+			{
+				float const x = (static_cast<float>(i % 64) + 0.5f) / 32.0f - 1.0f;
+				float const y = (static_cast<float>(i / 64) + 0.5f) / 32.0f - 1.0f;
+				result[i]     = Ray { origin, Vector::Normalize(Vector3(x * 0.5f, y * 0.5f, 1.0f)) };
+			}
+			return result;
+		}
+
+		void
+		BVHBuild(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			TriangleBVH          bvh;
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.Measure([&]
+			{
+				bvh.Build(triangles.data(), mesh_triangle_count);
+				DoNotOptimize(bvh.Tree().NodeCount());
+			});
+		}
+
+		void
+		BVHBuildPool(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			TriangleBVH          bvh;
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.Measure([&]
+			{
+				bvh.Build(triangles.data(), mesh_triangle_count, Pool());
+				DoNotOptimize(bvh.Tree().NodeCount());
+			});
+		}
+
+		/// The same build split into tasks, run one after the other to show the cost of splitting the top of the tree
+		void
+		BVHBuildTasks(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			TriangleBVH          bvh;
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.Measure([&]
+			{
+				std::size_t const tasks = bvh.BeginBuild(triangles.data(), mesh_triangle_count, 8);
+				for (std::size_t i = 0; i < tasks; i++)
+				{
+					bvh.BuildTask(i);
+				}
+				bvh.EndBuild();
+				DoNotOptimize(bvh.Tree().NodeCount());
+			});
+		}
+
+		void
+		BVHRefit(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(mesh_triangle_count);
+			a_state.Measure([&]
+			{
+				bvh.Refit(triangles.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		BVHRaycast(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Ray>     rays      = ScatteredRays();
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(ray_count);
+			a_state.Measure([&]
+			{
+				for (Ray const& ray : rays)
+				{
+					DoNotOptimize(bvh.Raycast(ray, 400.0f));
+				}
+			});
+		}
+
+		void
+		BVHOccluded(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Ray>     rays      = ScatteredRays();
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(ray_count);
+			a_state.Measure([&]
+			{
+				for (Ray const& ray : rays)
+				{
+					DoNotOptimize(bvh.Occluded(ray, 400.0f));
+				}
+			});
+		}
+
+		void
+		BVHRaycastCamera(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Ray>     rays      = CameraRays();
+			std::vector<RayHit>  hits(ray_count);
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(ray_count);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < ray_count; i++)
+				{
+					hits[i] = bvh.Raycast(rays[i], 400.0f);
+				}
+				ClobberMemory();
+			});
+		}
+
+		void
+		BVHRaycastPacket(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Ray>     rays      = CameraRays();
+			std::vector<RayHit>  hits(ray_count);
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(ray_count);
+			a_state.Measure([&]
+			{
+				bvh.RaycastPacket(rays.data(), ray_count, hits.data(), 400.0f);
+				ClobberMemory();
+			});
+		}
+
+		void
+		BVHSpherecast(State& a_state)
+		{
+			std::vector<Vector3> triangles = RandomTriangleSoup();
+			std::vector<Ray>     rays      = ScatteredRays();
+			TriangleBVH          bvh;
+			bvh.Build(triangles.data(), mesh_triangle_count);
+
+			a_state.SetItemsPerIteration(ray_count);
+			a_state.Measure([&]
+			{
+				for (Ray const& ray : rays)
+				{
+					DoNotOptimize(bvh.Spherecast(Sphere { ray.origin, 0.5f }, ray.direction, 400.0f));
+				}
+			});
+		}
+	#pragma region Dynamic Tree
+		/// Moving objects per frame, about a busy scene's worth of dynamic bodies
+		constexpr std::size_t proxy_count = 16384;
+
+		/// Queries per kernel call
+		constexpr std::size_t query_count = 1024;
+
+		/// Boxes the size of the culling benchmarks' through the same volume
+		std::vector<AABB>
+		RandomProxyBoxes()
+		{
+			std::vector<Vector3> centers = RandomValues<Vector3>(proxy_count, -100, 100, 1);
+			std::vector<Vector3> extents = RandomValues<Vector3>(proxy_count, 0.5f, 5, 2);
+			std::vector<AABB>    result(proxy_count);
+			for (std::size_t i = 0; i < proxy_count; i++)
+			{
+				result[i] = Bounds::FromCenterExtents(centers[i], extents[i]);
+			}
+			return result;
+		}
+
+		struct DynamicTreeScene
+		{
+			std::vector<AABB>   boxes = RandomProxyBoxes();
+			std::vector<uint32> proxies;
+			DynamicTree         tree;
+
+			DynamicTreeScene()
+			{
+				tree.Reserve(proxy_count);
+				for (std::size_t i = 0; i < proxy_count; i++)
+				{
+					proxies.push_back(tree.Insert(boxes[i], static_cast<uint32>(i)));
+				}
+			}
+		};
+
+		/// Every proxy moves back and forth by a_step a frame, a frame being one MoveBatch of all of them
+		void
+		DynamicTreeMove(State& a_state, float a_step)
+		{
+			DynamicTreeScene     scene;
+			std::vector<Vector3> directions = RandomDirections(proxy_count);
+			std::vector<AABB>    moved(proxy_count);
+			std::vector<Vector3> displacements(proxy_count);
+			float                sign = 1;
+
+			a_state.SetItemsPerIteration(proxy_count);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < proxy_count; i++)
+				{
+					displacements[i] = directions[i] * (a_step * sign);
+					moved[i]         = AABB { scene.boxes[i].min + displacements[i], scene.boxes[i].max + displacements[i] };
+				}
+				DoNotOptimize(scene.tree.MoveBatch(scene.proxies.data(), moved.data(), proxy_count, displacements.data()));
+				scene.boxes.swap(moved);
+				sign = -sign;
+			});
+		}
+
+		/// Movements within the margin, only the exact boxes change
+		void
+		DynamicTreeMoveSlow(State& a_state)
+		{
+			DynamicTreeMove(a_state, 0.02f);
+		}
+
+		/// Movements larger than the margin, every proxy is reinserted every frame
+		void
+		DynamicTreeMoveFast(State& a_state)
+		{
+			DynamicTreeMove(a_state, 1.0f);
+		}
+
+		void
+		DynamicTreeInsert(State& a_state)
+		{
+			std::vector<AABB> boxes = RandomProxyBoxes();
+			DynamicTree       tree;
+
+			a_state.SetItemsPerIteration(proxy_count);
+			a_state.Measure([&]
+			{
+				tree.Clear();
+				for (std::size_t i = 0; i < proxy_count; i++)
+				{
+					tree.Insert(boxes[i], static_cast<uint32>(i));
+				}
+				DoNotOptimize(tree.Height());
+			});
+		}
+
+		void
+		DynamicTreeCull(State& a_state)
+		{
+			DynamicTreeScene    scene;
+			std::vector<uint32> visible(proxy_count);
+			Frustum             frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(proxy_count);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(scene.tree.Cull(frustum, visible.data()));
+				ClobberMemory();
+			});
+		}
+
+		/// Baseline for the tree's cull, the same boxes tested eight at a time
+		void
+		DynamicTreeCullStream(State& a_state)
+		{
+			std::vector<AABB>   boxes = RandomProxyBoxes();
+			AABBStream          stream(boxes.data(), boxes.size());
+			std::vector<uint32> visible(proxy_count);
+			Frustum             frustum = SomeFrustum();
+
+			a_state.SetItemsPerIteration(proxy_count);
+			a_state.Measure([&]
+			{
+				DoNotOptimize(Bounds::Cull(frustum, stream, visible.data()));
+				ClobberMemory();
+			});
+		}
+
+		void
+		DynamicTreeOverlapBatch(State& a_state)
+		{
+			DynamicTreeScene     scene;
+			std::vector<Vector3> centers = RandomValues<Vector3>(query_count, -100, 100, 3);
+			std::vector<AABB>    queries(query_count);
+			for (std::size_t i = 0; i < query_count; i++)
+			{
+				queries[i] = Bounds::FromCenterExtents(centers[i], Vector3(5, 5, 5));
+			}
+
+			std::vector<uint32> hits;
+			std::vector<uint32> offsets(query_count + 1);
+
+			a_state.SetItemsPerIteration(query_count);
+			a_state.Measure([&]
+			{
+				scene.tree.OverlapBatch(queries.data(), query_count, hits, offsets.data());
+				ClobberMemory();
+			});
+		}
+
+		void
+		DynamicTreeNearest(State& a_state)
+		{
+			DynamicTreeScene     scene;
+			std::vector<Vector3> points = RandomValues<Vector3>(query_count, -100, 100, 3);
+			uint32               hits[8];
+			float                distances[8];
+
+			a_state.SetItemsPerIteration(query_count);
+			a_state.Measure([&]
+			{
+				for (Vector3 const& point : points)
+				{
+					DoNotOptimize(scene.tree.Nearest(point, 8, hits, distances));
+				}
+				ClobberMemory();
+			});
+		}
+	#pragma region Spatial Hash
+		/// Particles per rebuild, the size of a large particle system or crowd
+		constexpr std::size_t hash_point_count = 1000000;
+
+		/// Points for the neighbour queries, packed so each has about 20 neighbours within a cell
+		constexpr std::size_t neighbor_point_count = 65536;
+
+		constexpr float neighbor_radius = 1.0f;
+
+		void
+		SpatialHashBuild(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(hash_point_count, -100, 100, 1);
+			SpatialHash          hash;
+
+			a_state.SetItemsPerIteration(hash_point_count);
+			a_state.Measure([&]
+			{
+				hash.Build(points.data(), hash_point_count, 2.0f);
+				ClobberMemory();
+			});
+		}
+
+		/// The same build on a thread per core
+		void
+		SpatialHashBuildPool(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(hash_point_count, -100, 100, 1);
+			SpatialHash          hash;
+
+			a_state.SetItemsPerIteration(hash_point_count);
+			a_state.Measure([&]
+			{
+				hash.Build(points.data(), hash_point_count, 2.0f, Pool());
+				ClobberMemory();
+			});
+		}
+
+		/// The critical path of the build split into TaskCount tasks, unlike the pool above it doesn't depend on the machine's cores
+		template<std::size_t TaskCount>
+		void
+		SpatialHashBuildCriticalPath(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(hash_point_count, -100, 100, 1);
+			SpatialHash          hash;
+
+			a_state.SetItemsPerIteration(hash_point_count);
+			a_state.MeasureCriticalPath(SpatialHash::build_pass_count, TaskCount, [&](std::size_t a_pass, std::size_t a_task)
+			{
+				if (a_pass == 0 && a_task == 0)
+				{
+					hash.BeginBuild(points.data(), hash_point_count, 2.0f, TaskCount);
+				}
+
+				hash.BuildTask(a_pass, a_task);
+
+				if (a_pass == SpatialHash::build_pass_count - 1 && a_task == TaskCount - 1)
+				{
+					hash.EndBuild();
+					ClobberMemory();
+				}
+			});
+		}
+
+		/// Every task of the build split 32 ways run in turn, the total work, which barely grows with the task count
+		void
+		SpatialHashBuildWork(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(hash_point_count, -100, 100, 1);
+			SpatialHash          hash;
+
+			a_state.SetItemsPerIteration(hash_point_count);
+			a_state.Measure([&]
+			{
+				std::size_t const taskCount = hash.BeginBuild(points.data(), hash_point_count, 2.0f, 32);
+				for (std::size_t pass = 0; pass < SpatialHash::build_pass_count; pass++)
+				{
+					for (std::size_t task = 0; task < taskCount; task++)
+					{
+						hash.BuildTask(pass, task);
+					}
+				}
+				hash.EndBuild();
+				ClobberMemory();
+			});
+		}
+
+		/// Every point's neighbours, in cell order as a particle update would visit them
+		void
+		SpatialHashNeighbors(State& a_state)
+		{
+			std::vector<Vector3> points = RandomValues<Vector3>(neighbor_point_count, -12, 12, 2);
+			SpatialHash          hash;
+			hash.Build(points.data(), neighbor_point_count, neighbor_radius);
+
+			a_state.SetItemsPerIteration(neighbor_point_count);
+			a_state.Measure([&]
+			{
+				std::size_t    count     = 0;
+				Vector3 const* positions = hash.SortedPositions();
+				for (std::size_t i = 0; i < neighbor_point_count; i++)
+				{
+					hash.ForEachNeighbor(positions[i], neighbor_radius, [&](uint32, float) { count++; });
+				}
+				DoNotOptimize(count);
+			});
+		}
+
+		/// Baseline for the neighbour queries, every pair tested, over fewer points at the same density
+		void
+		BruteForceNeighbors(State& a_state)
+		{
+			constexpr std::size_t count  = 4096;
+			std::vector<Vector3>  points = RandomValues<Vector3>(count, -4.7f, 4.7f, 2);
+
+			a_state.SetItemsPerIteration(count);
+			a_state.Measure([&]
+			{
+				std::size_t neighbors = 0;
+				for (std::size_t i = 0; i < count; i++)
+				{
+					for (std::size_t j = 0; j < count; j++)
+					{
+						Vector3 const offset = points[j] - points[i];
+						neighbors += Vector::Dot(offset, offset) <= neighbor_radius * neighbor_radius ? 1 : 0;
+					}
+				}
+				DoNotOptimize(neighbors);
+			});
+		}
+	#pragma endregion
+
+		Registration const registrations[] = {
+			{ "Bulk", "TransformPoints Vector3Stream", &TransformPointsStream },
+			{ "Bulk", "TransformPoints Vector3 array", &TransformPointsArray },
+			{ "Bulk", "Normalize Vector3Stream", &NormalizeStream },
+			{ "Bulk", "Dot Vector3Stream", &DotStream },
+			{ "Bulk", "Cross Vector3Stream", &CrossStream },
+			{ "Bulk", "Integrate Vector3Stream lazy", &IntegrateStream },
+			{ "Bulk", "Integrate Vector3 array", &IntegrateArray },
+
+			{ "Bulk", "Affine3 MultiplyBatch", &AffineMultiplyBatch },
+			{ "Bulk", "Matrix4 multiply array", &Matrix4MultiplyArray },
+			{ "Bulk", "Quaternion MultiplyBatch", &QuaternionMultiplyBatch },
+			{ "Bulk", "Quaternion SlerpBatch", &QuaternionSlerpBatch },
+			{ "Bulk", "Quaternion Slerp array", &QuaternionSlerpArray },
+			{ "Bulk", "TransformBatch Matrix4", &InterpolateTransformsMatrix4 },
+			{ "Bulk", "TransformBatch Affine3", &InterpolateTransformsAffine },
+			{ "Bulk", "TransformBatch Matrix4 pool", &InterpolateTransformsPool },
+			{ "Bulk", "Interpolate transforms array", &InterpolateTransformsArray },
+
+			{ "Bulk", "Cull AABBStream", &CullBoxes },
+			{ "Bulk", "Cull SphereStream", &CullSpheres },
+
+			{ "Bulk", "EncodeHalf", &EncodeHalf },
+			{ "Bulk", "DecodeHalf", &DecodeHalf },
+			{ "Bulk", "EncodeOctahedral", &EncodeOctahedral },
+			{ "Bulk", "DecodeOctahedral", &DecodeOctahedral },
+			{ "Bulk", "PackQuaternion", &PackQuaternion },
+			{ "Bulk", "UnpackQuaternion", &UnpackQuaternion },
+
+			{ "Bulk", "ConvertLayout Matrix4", &ConvertLayoutMatrix4 },
+			{ "Bulk", "Transpose and copy Matrix4", &TransposeCopyMatrix4 },
+
+			{ "Bulk", "Curve SampleBatch Vector3", &CurveSampleBatch },
+			{ "Bulk", "Curve Sample Vector3 array", &CurveSampleArray },
+			{ "Bulk", "Curve SampleBatch Quaternion", &CurveSampleQuaternionBatch },
+			{ "Bulk", "Curve Sample Quaternion array", &CurveSampleQuaternionArray },
+			{ "Bulk", "Curve ParameterBatch", &CurveParameterBatch },
+
+			{ "Bulk", "Uniform Xoshiro128x8", &UniformBatch },
+			{ "Bulk", "Uniform Xoshiro256", &UniformXoshiro256 },
+			{ "Bulk", "Uniform std::mt19937", &UniformStandard },
+			{ "Bulk", "Normal Xoshiro128x8", &NormalBatch },
+			{ "Bulk", "Normal std::mt19937", &NormalStandard },
+			{ "Bulk", "UnitVectors Vector3Stream", &UnitVectorsStream },
+			{ "Bulk", "UnitVectors Vector3 array", &UnitVectorsArray },
+			{ "Bulk", "PointsInBox Vector3Stream", &PointsInBoxStream },
+
+			{ "Bulk", "Noise FillGrid", &NoiseFillGrid },
+			{ "Bulk", "Noise FillGrid pool", &NoiseFillGridPool },
+			{ "Bulk", "Noise SampleBatch", &NoiseSampleBatch },
+			{ "Bulk", "Noise Sample array", &NoiseSampleArray },
+
+			{ "Bulk", "CollideBatch boxes", &CollideBatchBoxes },
+			{ "Bulk", "CollideBatch hulls", &CollideBatchHulls },
+			{ "Bulk", "OverlapBatch hulls", &OverlapBatchHulls },
+			{ "Bulk", "DistanceBatch capsules", &DistanceBatchCapsules },
+
+			{ "Bulk", "ClipTriangles frustum", &ClipTrianglesFrustum },
+			{ "Bulk", "ClipPolygon frustum per triangle", &ClipPolygonFrustum },
+			{ "Bulk", "SplitTriangles plane", &SplitTrianglesPlane },
+			{ "Bulk", "ConvexHull sphere", &ConvexHullSphere },
+			{ "Bulk", "ConvexHull box", &ConvexHullBox },
+
+			{ "Bulk", "BVH Build triangles", &BVHBuild },
+			{ "Bulk", "BVH Build triangles in tasks", &BVHBuildTasks },
+			{ "Bulk", "BVH Build triangles pool", &BVHBuildPool },
+			{ "Bulk", "BVH Refit triangles", &BVHRefit },
+			{ "Bulk", "BVH Raycast scattered", &BVHRaycast },
+			{ "Bulk", "BVH Occluded scattered", &BVHOccluded },
+			{ "Bulk", "BVH Raycast camera", &BVHRaycastCamera },
+			{ "Bulk", "BVH RaycastPacket camera", &BVHRaycastPacket },
+			{ "Bulk", "BVH Spherecast scattered", &BVHSpherecast },
+
+			{ "Bulk", "DynamicTree MoveBatch within margin", &DynamicTreeMoveSlow },
+			{ "Bulk", "DynamicTree MoveBatch reinserting", &DynamicTreeMoveFast },
+			{ "Bulk", "DynamicTree Insert", &DynamicTreeInsert },
+			{ "Bulk", "DynamicTree Cull", &DynamicTreeCull },
+			{ "Bulk", "Cull AABBStream same boxes", &DynamicTreeCullStream },
+			{ "Bulk", "DynamicTree OverlapBatch", &DynamicTreeOverlapBatch },
+			{ "Bulk", "DynamicTree Nearest 8", &DynamicTreeNearest },
+
+			{ "Bulk", "SpatialHash Build 1M", &SpatialHashBuild },
+			{ "Bulk", "SpatialHash Build 1M pool", &SpatialHashBuildPool },
+			{ "Bulk", "SpatialHash Build 1M critical 8", &SpatialHashBuildCriticalPath<8> },
+			{ "Bulk", "SpatialHash Build 1M critical 32", &SpatialHashBuildCriticalPath<32> },
+			{ "Bulk", "SpatialHash Build 1M work 32", &SpatialHashBuildWork },
+			{ "Bulk", "SpatialHash ForEachNeighbor", &SpatialHashNeighbors },
+			{ "Bulk", "Neighbors brute force", &BruteForceNeighbors },
+		};
+	}
+}
@@ -0,0 +1,250 @@
+#include "pch.h"
+#include "Checks.h"
+
+#include "Benchmark.h"
+
+#include <cstring>
+#include <limits>
+
+#include "Core/Math/Affine3.h"
+#include "Core/Math/Fixed.h"
+#include "Core/Math/Matrix3.h"
+#include "Core/Math/Matrix4.h"
+#include "Core/Math/BVH.h"
+#include "Core/Math/Noise.h"
+#include "Core/Math/Packing.h"
+#include "Core/Math/Quaternion.h"
+#include "Core/Math/SpatialHash.h"
+#include "Core/Math/TransformStream.h"
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+	#pragma region Affine
+		// Built from a Matrix3 and converted to and from Matrix4 at compile time
+		constexpr Affine3 constant_affine = Affine3(Matrix3(Vector3(1, 2, 3), Vector3(4, 5, 6), Vector3(7, 8, 9)), Vector3(10, 11, 12));
+		static_assert(constant_affine.columns[0].data[1] == 4 && constant_affine.columns[2].data[3] == 12);
+
+		constexpr Matrix4 constant_affine_matrix = Matrix4(constant_affine);
+		static_assert(constant_affine_matrix.data[1] == 2 && constant_affine_matrix.data[12] == 10 && constant_affine_matrix.data[15] == 1);
+		static_assert(Affine3(constant_affine_matrix).columns[1].data[2] == 8);
+	#pragma endregion
+	#pragma region Fixed
+		// Division rounds to nearest with halves up, whatever the signs. FromRaw(56) / 10 is 5.6 steps of 2^-16.
+		static_assert((Fixed::FromRaw(56) / Fixed(10)).raw == 6);
+		static_assert((Fixed::FromRaw(-56) / Fixed(10)).raw == -6);
+		static_assert((Fixed::FromRaw(56) / Fixed(-10)).raw == -6);
+		static_assert((Fixed::FromRaw(-56) / Fixed(-10)).raw == 6);
+		static_assert((Fixed::FromRaw(-54) / Fixed(10)).raw == -5);
+		static_assert((Fixed::FromRaw(-55) / Fixed(10)).raw == -5);
+		static_assert((Fixed::FromRaw(-65) / Fixed(10)).raw == -6);
+		static_assert((Fixed(-7) / Fixed(2)).raw == -(7 << 15));
+		static_assert((Fixed(1) / Fixed(-3)).raw == -21845);
+	#pragma endregion
+	#pragma region Packing
+		/// \brief Bulk snorm16 encoding against the single value one, NaN and the infinities in both the blocks and the tail
+		bool
+		PackSnorm16Edges()
+		{
+			constexpr float nan      = std::numeric_limits<float>::quiet_NaN();
+			constexpr float infinity = std::numeric_limits<float>::infinity();
+
+			float const values[] = { nan, -nan, infinity, -infinity, 0.5f, -2.0f, 1.0f, -0.25f, nan, infinity, -nan };
+			constexpr std::size_t count = sizeof(values) / sizeof(values[0]);
+
+			int16 bulk[count];
+			Packing::PackSnorm16(values, bulk, count);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				if (bulk[i] != Packing::PackSnorm16(Vector2(values[i], 0.0f)).data[0])
+				{
+					return false;
+				}
+			}
+			return bulk[0] == 0 && bulk[1] == 0 && bulk[8] == 0 && bulk[10] == 0 && bulk[2] == 32767 && bulk[3] == -32767;
+		}
+	#pragma endregion
+	#pragma region Spatial Hash
+		/**
+		 * \brief Neighbour queries at a radius of exactly one cell, far from the origin
+		 * \remarks There a_point ± a_radius rounds outward into a fourth cell per axis often enough that a few
+		 *          thousand queries reach it, for a few cell sizes.
+		 */
+		bool
+		SpatialHashRadiusOfOneCell()
+		{
+			constexpr std::size_t count = 8192;
+
+			for (unsigned seed = 1; seed <= 8; seed++)
+			{
+				float const   cellSize = RandomFloats(1, 0.1f, 3.0f, seed)[0];
+				Vector3 const origin   = RandomValues<Vector3>(1, -100000, 100000, seed)[0];
+
+				std::vector<Vector3> points = RandomValues<Vector3>(count, -6 * cellSize, 6 * cellSize, seed + 100);
+				for (Vector3& point : points)
+				{
+					point += origin;
+				}
+
+				SpatialHash hash;
+				hash.Build(points.data(), count, cellSize);
+
+				float const radiusSquared = cellSize * cellSize;
+				for (std::size_t i = 0; i < count; i += 4)
+				{
+					std::size_t found = 0;
+					hash.ForEachNeighbor(points[i], cellSize, [&found](uint32, float) { found++; });
+
+					std::size_t expected = 0;
+					for (Vector3 const& point : points)
+					{
+						float const dx = point.x - points[i].x;
+						float const dy = point.y - points[i].y;
+						float const dz = point.z - points[i].z;
+						expected += dx * dx + dy * dy + dz * dz <= radiusSquared ? 1 : 0;
+					}
+
+					if (found != expected)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+		/// \brief Builds split into several task counts against each other, and every point found in its own cell
+		bool
+		SpatialHashBuildTasks()
+		{
+			constexpr std::size_t count = 100000;
+
+			std::vector<Vector3> points = RandomValues<Vector3>(count, -50, 50, 3);
+			SpatialHash          reference;
+			reference.Build(points.data(), count, 1.5f);
+
+			std::vector<bool> seen(count, false);
+			for (std::size_t i = 0; i < count; i++)
+			{
+				uint32 const index = reference.SortedIndices()[i];
+				if (seen[index] || reference.SortedPositions()[i] != points[index])
+				{
+					return false;
+				}
+				seen[index] = true;
+
+				bool found = false;
+				reference.ForEachNeighbor(points[index], 0, [&found, index](uint32 a_index, float) { found = found || a_index == index; });
+				if (!found)
+				{
+					return false;
+				}
+			}
+
+			for (std::size_t taskCount : { 2, 3, 8, 32, 1000 })
+			{
+				SpatialHash       hash;
+				std::size_t const tasks = hash.BeginBuild(points.data(), count, 1.5f, taskCount);
+				for (std::size_t pass = 0; pass < SpatialHash::build_pass_count; pass++)
+				{
+					// Backwards, tasks of a pass may run in any order
+					for (std::size_t task = tasks; task-- > 0;)
+					{
+						hash.BuildTask(pass, task);
+					}
+				}
+				hash.EndBuild();
+
+				if (!std::equal(hash.SortedIndices(), hash.SortedIndices() + count, reference.SortedIndices()))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	#pragma endregion
+	#pragma region Worker Pool
+		/// \brief The WorkerPool overloads against the same work on the calling thread, sizes picked to leave partial blocks
+		bool
+		WorkerPoolOverloads()
+		{
+			WorkerPool pool(4);
+
+			NoiseSettings const settings = {};
+			NoiseGrid3 const    grid     = { Vector3(-3.0f), Vector3(0.3f), Vector3u(13, 7, 5) };
+			std::vector<float>  serialNoise(grid.Count()), pooledNoise(grid.Count());
+			Noise::FillGrid(settings, grid, serialNoise.data());
+			Noise::FillGrid(settings, grid, pooledNoise.data(), pool);
+			if (std::memcmp(serialNoise.data(), pooledNoise.data(), serialNoise.size() * sizeof(float)) != 0)
+			{
+				return false;
+			}
+
+			constexpr std::size_t transform_count = 1001;
+
+			TransformStream      previous, current;
+			std::vector<Vector3> translations = RandomValues<Vector3>(transform_count * 2, -10, 10, 4);
+			std::vector<Vector4> rotations    = RandomValues<Vector4>(transform_count * 2, -1, 1, 5);
+			previous.Resize(transform_count);
+			current.Resize(transform_count);
+			for (std::size_t i = 0; i < transform_count; i++)
+			{
+				Vector4 const& a = rotations[i];
+				Vector4 const& b = rotations[i + transform_count];
+				previous.Set(i, translations[i], Quaternion::Normalize(Quaternionf(a)), Vector3(1));
+				current.Set(i, translations[i + transform_count], Quaternion::Normalize(Quaternionf(b)), Vector3(2));
+			}
+
+			std::vector<Matrix4> serialTransforms(transform_count), pooledTransforms(transform_count);
+			Interpolation::TransformBatch(previous, current, 0.3f, serialTransforms.data());
+			Interpolation::TransformBatch(previous, current, 0.3f, pooledTransforms.data(), pool);
+			if (std::memcmp(serialTransforms.data(), pooledTransforms.data(), transform_count * sizeof(Matrix4)) != 0)
+			{
+				return false;
+			}
+
+			constexpr std::size_t point_count = 50001;
+
+			std::vector<Vector3> points = RandomValues<Vector3>(point_count, -40, 40, 6);
+			SpatialHash          serialHash, pooledHash;
+			serialHash.Build(points.data(), point_count, 1.0f);
+			pooledHash.Build(points.data(), point_count, 1.0f, pool);
+			if (!std::equal(serialHash.SortedIndices(), serialHash.SortedIndices() + point_count, pooledHash.SortedIndices()))
+			{
+				return false;
+			}
+
+			// The tree depends on how many subtrees the top is split into, so the serial build splits as many
+			constexpr std::size_t triangle_count = 20001;
+
+			std::vector<Vector3> triangles = RandomValues<Vector3>(triangle_count * 3, -20, 20, 7);
+			TriangleBVH          serialTree, pooledTree;
+			std::size_t const    tasks = serialTree.BeginBuild(triangles.data(), triangle_count, pool.ThreadCount() * WorkerPool::ranges_per_thread);
+			for (std::size_t task = 0; task < tasks; task++)
+			{
+				serialTree.BuildTask(task);
+			}
+			serialTree.EndBuild();
+			pooledTree.Build(triangles.data(), triangle_count, pool);
+
+			BVH const& serial = serialTree.Tree();
+			BVH const& pooled = pooledTree.Tree();
+			return serial.NodeCount() == pooled.NodeCount()
+				&& std::equal(serial.Primitives(), serial.Primitives() + serial.PrimitiveCount(), pooled.Primitives());
+		}
+	#pragma endregion
+	}
+
+	std::vector<CheckResult>
+	RunChecks()
+	{
+		return {
+			{ "Packing snorm16 NaN and infinity", PackSnorm16Edges() },
+			{ "SpatialHash radius of one cell", SpatialHashRadiusOfOneCell() },
+			{ "SpatialHash build split into tasks", SpatialHashBuildTasks() },
+			{ "WorkerPool overloads match serial", WorkerPoolOverloads() },
+		};
+	}
+}
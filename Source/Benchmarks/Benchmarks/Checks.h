@@ -0,0 +1,22 @@
+#pragma once
+
+#include <vector>
+
+/**
+ * Pass or fail checks of edge cases the benchmarks never hit.
+ *
+ * Each check compares a fast path against a slow reference on inputs picked to reach the edge case, ie. the neighbour
+ * queries of the spatial hash against testing every pair. They run after the benchmarks like the determinism check,
+ * and a failed check fails the run. Checks of constexpr code are static_asserts in Checks.cpp, which fail the build.
+ */
+namespace Oyl::Benchmarks
+{
+	struct CheckResult
+	{
+		char const* name;
+		bool        passed;
+	};
+
+	std::vector<CheckResult>
+	RunChecks();
+}
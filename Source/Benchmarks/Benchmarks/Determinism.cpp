@@ -0,0 +1,127 @@
+#include "pch.h"
+#include "Determinism.h"
+
+#include <cstring>
+#include <type_traits>
+
+#include "Core/Math/Fixed.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		/// Result of Simulate<Fixed, 256>(1024), the same on every platform and compiler
+		constexpr std::uint64_t expected_fixed_checksum = 0xDC7647414081499Aull;
+
+		/// FNV-1a, one 32 bit word at a time
+		constexpr
+		std::uint64_t
+		Hash(std::uint64_t a_hash, std::uint32_t a_word)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				a_hash ^= (a_word >> (i * 8)) & 0xFF;
+				a_hash *= 0x100000001B3ull;
+			}
+			return a_hash;
+		}
+
+		template<typename TScalar>
+		constexpr
+		std::uint32_t
+		Bits(TScalar a_value)
+		{
+			if constexpr (std::is_same_v<TScalar, float>)
+			{
+				std::uint32_t bits = 0;
+				std::memcpy(&bits, &a_value, sizeof(bits));
+				return bits;
+			} else
+			{
+				return static_cast<std::uint32_t>(a_value.raw);
+			}
+		}
+
+		/**
+		 * \brief Bodies pulled towards the origin and pushed around by a rotating force, in a slowly turning frame
+		 * \remarks Touches the vector and matrix arithmetic, Normalize, Magnitude, Sqrt, SinCos, Tan and Atan2.
+		 */
+		template<typename TScalar, int BodyCount>
+		constexpr
+		std::uint64_t
+		Simulate(int a_steps)
+		{
+			using Vector3T = Vector_t<3, TScalar>;
+			using Matrix3T = Matrix_t<3, 3, TScalar>;
+
+			TScalar const timeStep = TScalar(1) / TScalar(64);
+			TScalar const damping  = TScalar(0.995);
+
+			Vector3T positions[BodyCount];
+			Vector3T velocities[BodyCount];
+			for (int i = 0; i < BodyCount; i++)
+			{
+				positions[i]  = Vector3T(TScalar(i % 16 - 8), TScalar(i / 16 % 16 - 8), TScalar(i * 7 % 5));
+				velocities[i] = Vector3T(TScalar(0));
+			}
+
+			std::uint64_t hash    = 0xCBF29CE484222325ull;
+			TScalar       heading = TScalar(0);
+			for (int step = 0; step < a_steps; step++)
+			{
+				TScalar sin = TScalar(0), cos = TScalar(0);
+				Math::SinCos(heading * TScalar(0.01), sin, cos);
+
+				Matrix3T frame = Matrix3T::Identity();
+				frame.data[0] = cos;
+				frame.data[2] = -sin;
+				frame.data[6] = sin;
+				frame.data[8] = cos;
+
+				for (int i = 0; i < BodyCount; i++)
+				{
+					TScalar forceSin = TScalar(0), forceCos = TScalar(0);
+					Math::SinCos(TScalar(step * 5 + i * 11), forceSin, forceCos);
+
+					Vector3T acceleration = Vector3T(forceCos, forceSin, TScalar(0));
+					Vector3T toCenter     = -positions[i];
+					TScalar  distance     = Vector::Magnitude(toCenter);
+					if (distance > TScalar(0))
+					{
+						acceleration += Vector::Normalize(toCenter) * Math::Sqrt(distance);
+					}
+
+					velocities[i] = (velocities[i] + acceleration * timeStep) * frame * damping;
+					positions[i] += velocities[i] * timeStep;
+				}
+
+				heading = Math::Atan2(velocities[0].data[1], velocities[0].data[0]) + Math::Tan(TScalar(step % 80));
+				hash    = Hash(hash, Bits(heading));
+			}
+
+			for (int i = 0; i < BodyCount; i++)
+			{
+				for (int c = 0; c < 3; c++)
+				{
+					hash = Hash(hash, Bits(positions[i].data[c]));
+					hash = Hash(hash, Bits(velocities[i].data[c]));
+				}
+			}
+			return hash;
+		}
+
+		constexpr std::uint64_t compile_time_checksum = Simulate<Fixed, 16>(32);
+	}
+
+	DeterminismReport
+	RunDeterminismCheck()
+	{
+		DeterminismReport report;
+		report.fixedChecksum         = Simulate<Fixed, 256>(1024);
+		report.expectedFixedChecksum = expected_fixed_checksum;
+		report.runtimeChecksum       = Simulate<Fixed, 16>(32);
+		report.compileTimeChecksum   = compile_time_checksum;
+		report.floatChecksum         = Simulate<float, 256>(1024);
+		return report;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Cross-build check for the deterministic math in Core/Math/Fixed.h.
+ *
+ * A few hundred bodies are simulated with Vector_t and Matrix_t of Fixed for a thousand steps, and the final state is
+ * hashed. Every build on every platform must arrive at the same hash, which is stored below, and a short run must also
+ * match the same simulation evaluated by the compiler. The same simulation in float is hashed as well, its hash is
+ * only expected to match between builds with the same compiler, SIMD backend and math defines.
+ */
+namespace Oyl::Benchmarks
+{
+	struct DeterminismReport
+	{
+		std::uint64_t fixedChecksum;
+		std::uint64_t expectedFixedChecksum;
+
+		/// The short run at runtime and evaluated during compilation, these only differ if the optimizer changed the results
+		std::uint64_t runtimeChecksum;
+		std::uint64_t compileTimeChecksum;
+
+		std::uint64_t floatChecksum;
+
+		bool
+		Passed() const noexcept
+		{
+			return fixedChecksum == expectedFixedChecksum && runtimeChecksum == compileTimeChecksum;
+		}
+	};
+
+	DeterminismReport
+	RunDeterminismCheck();
+}
@@ -0,0 +1,321 @@
+#include "pch.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+#include "Benchmark.h"
+#include "Checks.h"
+#include "Determinism.h"
+
+#include "Core/Math/Fast.h"
+#include "Core/Math/Simd.h"
+
+/**
+ * Usage: Oyl.Benchmarks [options]
+ *   --filter <text>      Only run benchmarks whose "group/name" contains text
+ *   --min-time <s>       Minimum duration of each sample in seconds, default 0.05
+ *   --repetitions <n>    Samples per benchmark, the median is reported, default 5
+ *   --out <file>         Write the JSON report to file instead of stdout
+ *   --label <text>       Stored in the report, ie. a commit hash, to tell runs apart
+ *   --no-accuracy        Skip the Math::Fast accuracy measurements
+ *   --no-determinism     Skip the fixed-point determinism check
+ *   --no-checks          Skip the edge case checks
+ *   --list               Print the benchmark names and exit
+ *
+ * The report is a single JSON object:
+ *   context:     label, timestamp, compiler, SIMD backend and the math defines the build used
+ *   benchmarks:  group, name, iterations, ns_per_op, ticks_per_op, ops_per_second and bytes_per_second per benchmark,
+ *                where an op is one call of a single value function or one element of a bulk kernel
+ *   accuracy:    function, accuracy, max_ulp_error and worst_input per Math::Fast function and tier
+ *   determinism: the simulation checksums from Determinism.h as hex strings, and whether they passed
+ *   checks:      name and passed per check from Checks.h
+ * Progress goes to stderr so stdout can be redirected straight to a file.
+ * The exit code is EXIT_FAILURE when the determinism check or any other check fails, after the report is written.
+ */
+namespace
+{
+	using namespace Oyl;
+
+	struct Options
+	{
+		std::string filter;
+		double      minimumTime  = 0.05;
+		int         repetitions  = 5;
+		std::string outputPath;
+		std::string label;
+		bool        accuracy     = true;
+		bool        determinism  = true;
+		bool        checks       = true;
+		bool        list         = false;
+	};
+
+	bool
+	ParseOptions(int a_argc, char** a_argv, Options& a_options)
+	{
+		for (int i = 1; i < a_argc; i++)
+		{
+			char const* argument = a_argv[i];
+			bool        hasValue = i + 1 < a_argc;
+
+			if (std::strcmp(argument, "--filter") == 0 && hasValue)
+			{
+				a_options.filter = a_argv[++i];
+			} else if (std::strcmp(argument, "--min-time") == 0 && hasValue)
+			{
+				a_options.minimumTime = std::atof(a_argv[++i]);
+			} else if (std::strcmp(argument, "--repetitions") == 0 && hasValue)
+			{
+				a_options.repetitions = std::max(1, std::atoi(a_argv[++i]));
+			} else if (std::strcmp(argument, "--out") == 0 && hasValue)
+			{
+				a_options.outputPath = a_argv[++i];
+			} else if (std::strcmp(argument, "--label") == 0 && hasValue)
+			{
+				a_options.label = a_argv[++i];
+			} else if (std::strcmp(argument, "--no-accuracy") == 0)
+			{
+				a_options.accuracy = false;
+			} else if (std::strcmp(argument, "--no-determinism") == 0)
+			{
+				a_options.determinism = false;
+			} else if (std::strcmp(argument, "--no-checks") == 0)
+			{
+				a_options.checks = false;
+			} else if (std::strcmp(argument, "--list") == 0)
+			{
+				a_options.list = true;
+			} else
+			{
+				std::fprintf(stderr, "Unknown or incomplete option \"%s\"\n", argument);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	std::string
+	Quote(std::string const& a_text)
+	{
+		std::string result = "\"";
+		for (char c : a_text)
+		{
+			switch (c)
+			{
+				case '"':  result += "\\\""; break;
+				case '\\': result += "\\\\"; break;
+				case '\n': result += "\\n"; break;
+				case '\t': result += "\\t"; break;
+				default:   result += c; break;
+			}
+		}
+		return result + "\"";
+	}
+
+	std::string
+	Number(double a_value)
+	{
+		// JSON has no infinity or NaN
+		if (!std::isfinite(a_value))
+		{
+			return "null";
+		}
+
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%.6g", a_value);
+		return buffer;
+	}
+
+	char const*
+	SimdBackend()
+	{
+	#if OYL_SIMD == OYL_SIMD_AVX
+		return OYL_SIMD_AVX2 ? "AVX2" : "AVX";
+	#elif OYL_SIMD == OYL_SIMD_SSE2
+		return "SSE2";
+	#elif OYL_SIMD == OYL_SIMD_NEON
+		return "NEON";
+	#else
+		return "Scalar";
+	#endif
+	}
+
+	char const*
+	Compiler()
+	{
+	#if defined(__clang__)
+		return "Clang " __clang_version__;
+	#elif defined(__GNUC__)
+		return "GCC " __VERSION__;
+	#elif defined(_MSC_VER)
+		return "MSVC " _OYL_STRINGIFY_MACRO(_MSC_FULL_VER);
+	#else
+		return "Unknown";
+	#endif
+	}
+
+	std::string
+	Hex(std::uint64_t a_value)
+	{
+		char buffer[24];
+		std::snprintf(buffer, sizeof(buffer), "0x%016llx", static_cast<unsigned long long>(a_value));
+		return buffer;
+	}
+
+	char const*
+	AccuracyName(Math::Fast::Accuracy a_accuracy)
+	{
+		switch (a_accuracy)
+		{
+			case Math::Fast::Accuracy::Fast:   return "Fast";
+			case Math::Fast::Accuracy::Medium: return "Medium";
+			case Math::Fast::Accuracy::Full:   return "Full";
+		}
+		return "Unknown";
+	}
+
+	std::string
+	ContextJson(Options const& a_options)
+	{
+		std::time_t now = std::time(nullptr);
+		char        timestamp[32];
+		std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+	#if defined(OYL_MATH_FAST_TRIG)
+		int fastTrig = OYL_MATH_FAST_TRIG;
+	#else
+		int fastTrig = 0;
+	#endif
+
+		std::string json = "{";
+		json += "\"label\": " + Quote(a_options.label);
+		json += ", \"timestamp\": " + Quote(timestamp);
+		json += ", \"compiler\": " + Quote(Compiler());
+		json += ", \"simd\": " + Quote(SimdBackend());
+		json += ", \"fma\": " + std::string(OYL_SIMD_FMA ? "true" : "false");
+		json += ", \"fast_trig\": " + std::to_string(fastTrig);
+		json += ", \"deterministic\": " + std::string(OYL_MATH_DETERMINISTIC ? "true" : "false");
+		json += ", \"min_time\": " + Number(a_options.minimumTime);
+		json += ", \"repetitions\": " + std::to_string(a_options.repetitions);
+		return json + "}";
+	}
+}
+
+int
+main(int a_argc, char** a_argv)
+{
+	Options options;
+	if (!ParseOptions(a_argc, a_argv, options))
+	{
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Benchmarks::BenchmarkDefinition> benchmarks;
+	for (Benchmarks::BenchmarkDefinition const& benchmark : Benchmarks::GetBenchmarks())
+	{
+		std::string fullName = std::string(benchmark.group) + "/" + benchmark.name;
+		if (fullName.find(options.filter) != std::string::npos)
+		{
+			benchmarks.push_back(benchmark);
+		}
+	}
+
+	if (options.list)
+	{
+		for (Benchmarks::BenchmarkDefinition const& benchmark : benchmarks)
+		{
+			std::printf("%s/%s\n", benchmark.group, benchmark.name);
+		}
+		return EXIT_SUCCESS;
+	}
+
+	std::string json = "{\n  \"context\": " + ContextJson(options) + ",\n  \"benchmarks\": [";
+	for (std::size_t i = 0; i < benchmarks.size(); i++)
+	{
+		Benchmarks::BenchmarkResult result = Benchmarks::Run(benchmarks[i], options.minimumTime, options.repetitions);
+		std::fprintf(stderr, "%-16s %-36s %10.3f ns/op %10.2f ticks/op\n", result.group.c_str(), result.name.c_str(), result.nanosecondsPerItem, result.ticksPerItem);
+
+		json += i == 0 ? "\n    {" : ",\n    {";
+		json += "\"group\": " + Quote(result.group);
+		json += ", \"name\": " + Quote(result.name);
+		json += ", \"iterations\": " + std::to_string(result.iterations);
+		json += ", \"ns_per_op\": " + Number(result.nanosecondsPerItem);
+		json += ", \"ticks_per_op\": " + Number(result.ticksPerItem);
+		json += ", \"ops_per_second\": " + Number(result.itemsPerSecond);
+		json += ", \"bytes_per_second\": " + Number(result.bytesPerSecond);
+		json += "}";
+	}
+	json += "\n  ],\n  \"accuracy\": [";
+
+	if (options.accuracy)
+	{
+		std::vector<Math::Fast::AccuracyReport> reports = Math::Fast::MeasureAccuracy();
+		for (std::size_t i = 0; i < reports.size(); i++)
+		{
+			Math::Fast::AccuracyReport const& report = reports[i];
+			std::fprintf(stderr, "%-16s %-8s %10.2f ulp\n", report.function, AccuracyName(report.accuracy), report.maxUlpError);
+
+			json += i == 0 ? "\n    {" : ",\n    {";
+			json += "\"function\": " + Quote(report.function);
+			json += ", \"accuracy\": " + Quote(AccuracyName(report.accuracy));
+			json += ", \"max_ulp_error\": " + Number(report.maxUlpError);
+			json += ", \"worst_input\": " + Number(report.worstInput);
+			json += "}";
+		}
+	}
+	json += "\n  ]";
+
+	bool passed = true;
+	if (options.determinism)
+	{
+		Benchmarks::DeterminismReport report = Benchmarks::RunDeterminismCheck();
+		passed = report.Passed();
+		std::fprintf(stderr, "Determinism      fixed %s, expected %s, %s\n", Hex(report.fixedChecksum).c_str(), Hex(report.expectedFixedChecksum).c_str(), passed ? "passed" : "FAILED");
+
+		json += ",\n  \"determinism\": {";
+		json += "\"fixed_checksum\": " + Quote(Hex(report.fixedChecksum));
+		json += ", \"expected_fixed_checksum\": " + Quote(Hex(report.expectedFixedChecksum));
+		json += ", \"runtime_checksum\": " + Quote(Hex(report.runtimeChecksum));
+		json += ", \"compile_time_checksum\": " + Quote(Hex(report.compileTimeChecksum));
+		json += ", \"float_checksum\": " + Quote(Hex(report.floatChecksum));
+		json += ", \"passed\": " + std::string(passed ? "true" : "false");
+		json += "}";
+	}
+
+	if (options.checks)
+	{
+		std::vector<Benchmarks::CheckResult> checks = Benchmarks::RunChecks();
+		json += ",\n  \"checks\": [";
+		for (std::size_t i = 0; i < checks.size(); i++)
+		{
+			Benchmarks::CheckResult const& check = checks[i];
+			passed = passed && check.passed;
+			std::fprintf(stderr, "Check            %-36s %s\n", check.name, check.passed ? "passed" : "FAILED");
+
+			json += i == 0 ? "\n    {" : ",\n    {";
+			json += "\"name\": " + Quote(check.name);
+			json += ", \"passed\": " + std::string(check.passed ? "true" : "false");
+			json += "}";
+		}
+		json += "\n  ]";
+	}
+	json += "\n}\n";
+
+	if (options.outputPath.empty())
+	{
+		std::fputs(json.c_str(), stdout);
+		return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	std::ofstream file(options.outputPath);
+	if (!file)
+	{
+		std::fprintf(stderr, "Couldn't open \"%s\" for writing\n", options.outputPath.c_str());
+		return EXIT_FAILURE;
+	}
+	file << json;
+	return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,205 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include <cstring>
+
+#include "Core/Math/Matrix.h"
+#include "Core/Math/MatrixLayout.h"
+#include "Core/Math/Transformations.h"
+#include "Core/Math/Vector.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		// The multiply loops as they were before the unrolled kernels, kept as a baseline for the cycle comparison.
+		// Only square shapes, where the old code produced correct results.
+		namespace Reference
+		{
+			template<int Size>
+			Matrix_t<Size, Size, float>
+			Multiply(Matrix_t<Size, Size, float> a_lhs, Matrix_t<Size, Size, float> a_rhs)
+			{
+				Matrix_t<Size, Size, float> result { 0 };
+
+				for (int y = 0; y < Size; y++)
+					for (int x = 0; x < Size; x++)
+						for (int z = 0; z < Size; z++)
+						{
+							result.data[y * Size + x] += a_lhs.data[y * Size + z] * a_rhs.data[z * Size + x];
+						}
+
+				return result;
+			}
+
+			template<int Size>
+			Vector_t<Size, float>
+			Multiply(Vector_t<Size, float> a_lhs, Matrix_t<Size, Size, float> a_rhs)
+			{
+				Matrix_t<Size, 1, float> lhsMatrix;
+				std::memcpy(lhsMatrix.data, a_lhs.data, sizeof(float) * Size);
+
+				Matrix_t<Size, 1, float> product { 0 };
+				for (int x = 0; x < Size; x++)
+					for (int z = 0; z < Size; z++)
+					{
+						product.data[x] += lhsMatrix.data[z] * a_rhs.data[z * Size + x];
+					}
+
+				Vector_t<Size, float> result;
+				std::memcpy(result.data, product.data, sizeof(float) * Size);
+				return result;
+			}
+		}
+
+		/// Rotations about random axes followed by random translations
+		std::vector<Matrix4>
+		RigidTransforms(std::size_t a_count)
+		{
+			std::vector<Vector3> axes         = RandomValues<Vector3>(a_count, -1, 1, 1);
+			std::vector<Vector3> translations = RandomValues<Vector3>(a_count, -10, 10, 2);
+			std::vector<float>   angles       = RandomFloats(a_count, -180, 180, 3);
+
+			std::vector<Matrix4> result(a_count);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				Matrix3 rotation = Matrix::Rotate(angles[i], Vector::Normalize(axes[i]));
+
+				result[i] = Matrix::Translate(translations[i]);
+				for (int row = 0; row < 3; row++)
+				{
+					result[i].cols[row] = Vector4(rotation.cols[row], 0);
+				}
+			}
+			return result;
+		}
+
+		template<typename TLhs, typename TRhs>
+		void
+		Multiply(State& a_state)
+		{
+			std::vector<TLhs> lhs = RandomValues<TLhs>(batch_size, -1, 1, 1);
+			std::vector<TRhs> rhs = RandomValues<TRhs>(batch_size, -1, 1, 2);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * (sizeof(TLhs) + sizeof(TRhs)));
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(lhs[i] * rhs[i]);
+				}
+			});
+		}
+
+		template<typename TLhs, typename TRhs>
+		void
+		ReferenceMultiply(State& a_state)
+		{
+			std::vector<TLhs> lhs = RandomValues<TLhs>(batch_size, -1, 1, 1);
+			std::vector<TRhs> rhs = RandomValues<TRhs>(batch_size, -1, 1, 2);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * (sizeof(TLhs) + sizeof(TRhs)));
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(Reference::Multiply(lhs[i], rhs[i]));
+				}
+			});
+		}
+
+		/// Times a_function over every element of a_values
+		template<typename TMatrix, typename TFunction>
+		void
+		Unary(State& a_state, std::vector<TMatrix> const& a_values, TFunction a_function)
+		{
+			a_state.SetItemsPerIteration(a_values.size());
+			a_state.SetBytesPerIteration(a_values.size() * sizeof(TMatrix));
+			a_state.Measure([&]
+			{
+				for (TMatrix const& value : a_values)
+				{
+					DoNotOptimize(a_function(value));
+				}
+			});
+		}
+
+		template<typename TMatrix>
+		void
+		Transpose(State& a_state)
+		{
+			Unary(a_state, RandomValues<TMatrix>(batch_size), [](TMatrix const& a_value) { return Matrix::Transpose(a_value); });
+		}
+
+		template<typename TMatrix>
+		void
+		Inverse(State& a_state)
+		{
+			Unary(a_state, RandomValues<TMatrix>(batch_size), [](TMatrix const& a_value) { return Matrix::Inverse(a_value); });
+		}
+
+		template<typename TMatrix>
+		void
+		InverseLU(State& a_state)
+		{
+			Unary(a_state, RandomValues<TMatrix>(batch_size), [](TMatrix const& a_value) { return Matrix::InverseLU(a_value); });
+		}
+
+		template<typename TMatrix>
+		void
+		Determinant(State& a_state)
+		{
+			Unary(a_state, RandomValues<TMatrix>(batch_size), [](TMatrix const& a_value) { return Matrix::Determinant(a_value); });
+		}
+
+		void
+		InverseAffine(State& a_state)
+		{
+			Unary(a_state, RigidTransforms(batch_size), [](Matrix4 const& a_value) { return Matrix::InverseAffine(a_value); });
+		}
+
+		void
+		InverseRigid(State& a_state)
+		{
+			Unary(a_state, RigidTransforms(batch_size), [](Matrix4 const& a_value) { return Matrix::InverseRigid(a_value); });
+		}
+
+		Registration const registrations[] = {
+			{ "Matrix", "Matrix2 * Matrix2", &Multiply<Matrix2, Matrix2> },
+			{ "Matrix", "Matrix3 * Matrix3", &Multiply<Matrix3, Matrix3> },
+			{ "Matrix", "Matrix4 * Matrix4", &Multiply<Matrix4, Matrix4> },
+			{ "Matrix", "Matrix4x3 * Matrix3x4", &Multiply<Matrix_t<4, 3, float>, Matrix_t<3, 4, float>> },
+			{ "Matrix", "Matrix3x4 * Matrix4x3", &Multiply<Matrix_t<3, 4, float>, Matrix_t<4, 3, float>> },
+			{ "Matrix", "Vector2 * Matrix2", &Multiply<Vector2, Matrix2> },
+			{ "Matrix", "Vector3 * Matrix3", &Multiply<Vector3, Matrix3> },
+			{ "Matrix", "Vector4 * Matrix4", &Multiply<Vector4, Matrix4> },
+
+			{ "Matrix", "Matrix3ColumnMajor * Matrix3ColumnMajor", &Multiply<Matrix3ColumnMajor, Matrix3ColumnMajor> },
+			{ "Matrix", "Matrix4ColumnMajor * Matrix4ColumnMajor", &Multiply<Matrix4ColumnMajor, Matrix4ColumnMajor> },
+			{ "Matrix", "Vector3 * Matrix3ColumnMajor", &Multiply<Vector3, Matrix3ColumnMajor> },
+			{ "Matrix", "Vector4 * Matrix4ColumnMajor", &Multiply<Vector4, Matrix4ColumnMajor> },
+
+			{ "Matrix", "Reference Matrix2 * Matrix2", &ReferenceMultiply<Matrix2, Matrix2> },
+			{ "Matrix", "Reference Matrix3 * Matrix3", &ReferenceMultiply<Matrix3, Matrix3> },
+			{ "Matrix", "Reference Matrix4 * Matrix4", &ReferenceMultiply<Matrix4, Matrix4> },
+			{ "Matrix", "Reference Vector3 * Matrix3", &ReferenceMultiply<Vector3, Matrix3> },
+			{ "Matrix", "Reference Vector4 * Matrix4", &ReferenceMultiply<Vector4, Matrix4> },
+
+			{ "Matrix", "Matrix2 Transpose", &Transpose<Matrix2> },
+			{ "Matrix", "Matrix3 Transpose", &Transpose<Matrix3> },
+			{ "Matrix", "Matrix4 Transpose", &Transpose<Matrix4> },
+
+			{ "Matrix", "Matrix2 Inverse", &Inverse<Matrix2> },
+			{ "Matrix", "Matrix3 Inverse", &Inverse<Matrix3> },
+			{ "Matrix", "Matrix4 Inverse", &Inverse<Matrix4> },
+			{ "Matrix", "Matrix4 InverseLU", &InverseLU<Matrix4> },
+			{ "Matrix", "Matrix4 InverseAffine", &InverseAffine },
+			{ "Matrix", "Matrix4 InverseRigid", &InverseRigid },
+
+			{ "Matrix", "Matrix3 Determinant", &Determinant<Matrix3> },
+			{ "Matrix", "Matrix4 Determinant", &Determinant<Matrix4> },
+		};
+	}
+}
@@ -0,0 +1,134 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include "Core/Math/Transformations.h"
+#include "Core/Math/Vector.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		/// Times a_function over batch_size random inputs
+		template<typename TInput, typename TFunction>
+		void
+		Builder(State& a_state, std::vector<TInput> const& a_inputs, TFunction a_function)
+		{
+			a_state.SetItemsPerIteration(a_inputs.size());
+			a_state.Measure([&]
+			{
+				for (TInput const& input : a_inputs)
+				{
+					DoNotOptimize(a_function(input));
+				}
+			});
+		}
+
+		std::vector<float>
+		Angles()
+		{
+			return RandomFloats(batch_size, -360, 360);
+		}
+
+		void
+		Perspective(State& a_state)
+		{
+			Builder(a_state, RandomFloats(batch_size, 45, 110), [](float a_fieldOfView)
+			{
+				return Matrix::Perspective(a_fieldOfView, 9.0f / 16.0f, 0.1f, 1000.0f);
+			});
+		}
+
+		void
+		RotateX(State& a_state)
+		{
+			Builder(a_state, Angles(), [](float a_angle) { return Matrix::RotateX(a_angle); });
+		}
+
+		void
+		RotateY(State& a_state)
+		{
+			Builder(a_state, Angles(), [](float a_angle) { return Matrix::RotateY(a_angle); });
+		}
+
+		void
+		RotateZ(State& a_state)
+		{
+			Builder(a_state, Angles(), [](float a_angle) { return Matrix::RotateZ(a_angle); });
+		}
+
+		void
+		Rotate(State& a_state)
+		{
+			std::vector<Vector4> inputs = RandomValues<Vector4>(batch_size);
+			for (Vector4& input : inputs)
+			{
+				input.w *= 360;
+			}
+
+			Builder(a_state, inputs, [](Vector4 const& a_input)
+			{
+				return Matrix::Rotate(a_input.w, Vector3(a_input.x, a_input.y, a_input.z));
+			});
+		}
+
+		void
+		Scale(State& a_state)
+		{
+			Builder(a_state, RandomValues<Vector3>(batch_size, 0.1f, 10), [](Vector3 const& a_scale) { return Matrix::Scale(a_scale); });
+		}
+
+		void
+		Translate(State& a_state)
+		{
+			Builder(a_state, RandomValues<Vector3>(batch_size, -100, 100), [](Vector3 const& a_position) { return Matrix::Translate(a_position); });
+		}
+
+		void
+		LookAt(State& a_state)
+		{
+			Builder(a_state, RandomValues<Vector3>(batch_size, -100, 100), [](Vector3 const& a_position)
+			{
+				return Matrix::LookAt(a_position, Vector3(0, 0, 0));
+			});
+		}
+
+		void
+		ViewInverse(State& a_state)
+		{
+			std::vector<Matrix4> cameras(batch_size);
+			std::vector<Vector3> positions = RandomValues<Vector3>(batch_size, -100, 100);
+			for (std::size_t i = 0; i < batch_size; i++)
+			{
+				cameras[i] = Matrix::LookAt(positions[i], Vector3(0, 0, 0));
+			}
+
+			Builder(a_state, cameras, [](Matrix4 const& a_camera) { return Matrix::ViewInverse(a_camera); });
+		}
+
+		void
+		EulerAngles(State& a_state)
+		{
+			std::vector<Matrix3> rotations(batch_size);
+			std::vector<float>   angles = Angles();
+			for (std::size_t i = 0; i < batch_size; i++)
+			{
+				rotations[i] = Matrix::RotateX(angles[i]) * Matrix::RotateY(angles[batch_size - 1 - i]);
+			}
+
+			Builder(a_state, rotations, [](Matrix3 const& a_rotation) { return Matrix::EulerAngles(a_rotation); });
+		}
+
+		Registration const registrations[] = {
+			{ "Transformations", "Perspective", &Perspective },
+			{ "Transformations", "RotateX", &RotateX },
+			{ "Transformations", "RotateY", &RotateY },
+			{ "Transformations", "RotateZ", &RotateZ },
+			{ "Transformations", "Rotate", &Rotate },
+			{ "Transformations", "Scale", &Scale },
+			{ "Transformations", "Translate", &Translate },
+			{ "Transformations", "LookAt", &LookAt },
+			{ "Transformations", "ViewInverse", &ViewInverse },
+			{ "Transformations", "EulerAngles", &EulerAngles },
+		};
+	}
+}
@@ -0,0 +1,143 @@
+#include "pch.h"
+#include "Benchmark.h"
+
+#include "Core/Math/Vector.h"
+#include "Core/Math/VectorExpression.h"
+
+namespace Oyl::Benchmarks
+{
+	namespace
+	{
+		template<typename TVector>
+		void
+		Dot(State& a_state)
+		{
+			std::vector<TVector> lhs = RandomValues<TVector>(batch_size, -1, 1, 1);
+			std::vector<TVector> rhs = RandomValues<TVector>(batch_size, -1, 1, 2);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(TVector) * 2);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(Vector::Dot(lhs[i], rhs[i]));
+				}
+			});
+		}
+
+		template<typename TVector>
+		void
+		Normalize(State& a_state)
+		{
+			std::vector<TVector> values = RandomValues<TVector>(batch_size);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(TVector));
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(Vector::Normalize(values[i]));
+				}
+			});
+		}
+
+		template<typename TVector>
+		void
+		Add(State& a_state)
+		{
+			std::vector<TVector> lhs = RandomValues<TVector>(batch_size, -1, 1, 1);
+			std::vector<TVector> rhs = RandomValues<TVector>(batch_size, -1, 1, 2);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(TVector) * 2);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(lhs[i] + rhs[i]);
+				}
+			});
+		}
+
+		void
+		Cross(State& a_state)
+		{
+			std::vector<Vector3> lhs = RandomValues<Vector3>(batch_size, -1, 1, 1);
+			std::vector<Vector3> rhs = RandomValues<Vector3>(batch_size, -1, 1, 2);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(Vector3) * 2);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(Vector::Cross(lhs[i], rhs[i]));
+				}
+			});
+		}
+
+		/// a * s + b * t - c, one temporary per operator
+		template<typename TVector>
+		void
+		Combine(State& a_state)
+		{
+			std::vector<TVector> a = RandomValues<TVector>(batch_size, -1, 1, 1);
+			std::vector<TVector> b = RandomValues<TVector>(batch_size, -1, 1, 2);
+			std::vector<TVector> c = RandomValues<TVector>(batch_size, -1, 1, 3);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(TVector) * 3);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(a[i] * 0.5f + b[i] * 0.25f - c[i]);
+				}
+			});
+		}
+
+		/// The same expression as Combine, fused by VectorExpression
+		template<typename TVector>
+		void
+		CombineLazy(State& a_state)
+		{
+			std::vector<TVector> a = RandomValues<TVector>(batch_size, -1, 1, 1);
+			std::vector<TVector> b = RandomValues<TVector>(batch_size, -1, 1, 2);
+			std::vector<TVector> c = RandomValues<TVector>(batch_size, -1, 1, 3);
+
+			a_state.SetItemsPerIteration(batch_size);
+			a_state.SetBytesPerIteration(batch_size * sizeof(TVector) * 3);
+			a_state.Measure([&]
+			{
+				for (std::size_t i = 0; i < batch_size; i++)
+				{
+					DoNotOptimize(Vector::Evaluate(Vector::Lazy(a[i]) * 0.5f + Vector::Lazy(b[i]) * 0.25f - c[i]));
+				}
+			});
+		}
+
+		Registration const registrations[] = {
+			{ "Vector", "Vector2 Dot", &Dot<Vector2> },
+			{ "Vector", "Vector3 Dot", &Dot<Vector3> },
+			{ "Vector", "Vector4 Dot", &Dot<Vector4> },
+
+			{ "Vector", "Vector2 Normalize", &Normalize<Vector2> },
+			{ "Vector", "Vector3 Normalize", &Normalize<Vector3> },
+			{ "Vector", "Vector4 Normalize", &Normalize<Vector4> },
+
+			{ "Vector", "Vector3 Add", &Add<Vector3> },
+			{ "Vector", "Vector4 Add", &Add<Vector4> },
+
+			{ "Vector", "Vector3 Cross", &Cross },
+
+			{ "Vector", "Vector3 a*s + b*t - c", &Combine<Vector3> },
+			{ "Vector", "Vector3 a*s + b*t - c lazy", &CombineLazy<Vector3> },
+			{ "Vector", "Vector4 a*s + b*t - c", &Combine<Vector4> },
+			{ "Vector", "Vector4 a*s + b*t - c lazy", &CombineLazy<Vector4> },
+			{ "Vector", "Vector_t<16> a*s + b*t - c", &Combine<Vector_t<16, float>> },
+			{ "Vector", "Vector_t<16> a*s + b*t - c lazy", &CombineLazy<Vector_t<16, float>> },
+		};
+	}
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
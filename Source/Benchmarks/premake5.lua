@@ -0,0 +1,35 @@
+EngineAssembly {
+    Group = "Tools",
+    Language = premake.CPP,
+    Kind = premake.CONSOLEAPP,
+    Dependencies = {},
+    Properties = function()
+        pchheader "pch.h"
+        pchsource "pch.cpp"
+
+        -- Compile the math sources, and the worker pool their parallel overloads run on, directly instead of
+        -- linking Oyl.Core, which pulls in GLFW and Vulkan, so the benchmarks also build on headless Linux machines
+        files {
+            "../Core/Core/Math/**.cpp",
+            "../Core/Core/Math/**.h",
+            "../Core/Core/Threading/**.cpp",
+            "../Core/Core/Threading/**.h",
+        }
+        includedirs {
+            "../Core",
+        }
+
+        -- The Premake project regenerates through the Windows binary
+        removelinks {
+            "Premake",
+        }
+
+        -- Math has no Editor specific code, and Tracy would skew the timings
+        removeconfigurations {
+            Config.Configurations.Profile,
+        }
+        removeplatforms {
+            Config.Platforms.Editor,
+        }
+    end
+}
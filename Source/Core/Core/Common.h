@@ -2,7 +2,7 @@
 
 #pragma region Environment Macros
 #	if defined(OYL_DISTRIBUTION) && defined(OYL_EDITOR)
-#		error Oyl Editor doesn't support Distribution configuration!
+#		error "Oyl Editor doesn't support Distribution configuration!"
 #	endif
 
 #	ifdef _WIN32
@@ -14,6 +14,9 @@
 #		endif
 #		define WIN32_LEAN_AND_MEAN
 #		define NOMINMAX
+#	elif defined(__linux__)
+		// Only headless tools like Oyl.Benchmarks build on Linux
+#		define OYL_LINUX
 #	else
 #		warning "Oyl3D only supports windows!"
 #	endif 
@@ -24,6 +27,20 @@
 #	define OYL_UNUSED(_var_) static_cast<void>(_var_)
 #	define OYL_FORCE_SEMICOLON static_assert(true)
 #	define OYL_FORCE_FORMAT_INDENT static_assert(true);
+
+#	if defined(_MSC_VER)
+#		define OYL_FORCE_INLINE __forceinline
+#	else
+#		define OYL_FORCE_INLINE inline __attribute__((always_inline))
+#	endif
+
+	// Lets constexpr functions take a faster non-constexpr path (ie. intrinsics) when evaluated at runtime
+#	if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#		define OYL_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#	else
+		// A constant false would pick the intrinsic path during constant evaluation and fail to compile there
+#		error "Oyl3D requires __builtin_is_constant_evaluated, ie. MSVC 19.25 (Visual Studio 2019 16.5), GCC 9 or Clang 9"
+#	endif
 #pragma endregion
 
 #pragma region Internal Macros
@@ -40,6 +57,8 @@
 #		define OYL_ENABLE_ASSERTS
 #	if defined(_MSC_VER)
             #define OYL_BREAKPOINT ::__debugbreak()
+#		elif defined(__GNUC__) || defined(__clang__)
+#			define OYL_BREAKPOINT __builtin_trap()
 #		else
 #			warning "Breakpoints only implemented for MSVC"
 #			define OYL_BREAKPOINT
@@ -61,7 +80,8 @@
 #		define _OYL_ASSERT_8(_expr_, _str_, ...) _OYL_EXPAND(_OYL_ASSERT_3(_expr_, _str_, __VA_ARGS__))
 #		define _OYL_ASSERT_9(_expr_, _str_, ...) _OYL_EXPAND(_OYL_ASSERT_3(_expr_, _str_, __VA_ARGS__))
 #	else
-#		define OYL_ASSERT(_expr_)
+		// Takes the same arguments as the enabled overloads, messages included
+#		define OYL_ASSERT(...)
 #	endif
 #pragma endregion
 
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "Archetype.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		std::size_t
+		AlignUp(std::size_t a_value, std::size_t a_alignment)
+		{
+			return (a_value + a_alignment - 1) & ~(a_alignment - 1);
+		}
+	}
+
+	Archetype::Archetype(std::vector<ComponentInfo const*> a_components)
+		: m_components(std::move(a_components))
+	{
+		// Start from as many rows as would fit without padding, then drop rows until the padded columns fit too
+		std::size_t rowSize = sizeof(Entity);
+		for (ComponentInfo const* component : m_components)
+		{
+			OYL_ASSERT(component->alignment <= chunk_alignment);
+			rowSize += component->size;
+		}
+
+		m_columnOffsets.resize(m_components.size());
+		for (m_chunkCapacity = chunk_size / rowSize; m_chunkCapacity > 0; m_chunkCapacity--)
+		{
+			std::size_t offset = m_chunkCapacity * sizeof(Entity);
+			for (std::size_t column = 0; column < m_components.size(); column++)
+			{
+				offset                  = AlignUp(offset, m_components[column]->alignment);
+				m_columnOffsets[column] = offset;
+				offset                 += m_chunkCapacity * m_components[column]->size;
+			}
+
+			if (offset <= chunk_size)
+			{
+				break;
+			}
+		}
+		OYL_ASSERT(m_chunkCapacity > 0);
+	}
+
+	Archetype::~Archetype()
+	{
+		Clear();
+		for (std::byte* chunk : m_chunks)
+		{
+			::operator delete(chunk, chunk_size, std::align_val_t(chunk_alignment));
+		}
+	}
+
+	std::size_t
+	Archetype::Push(Entity a_entity)
+	{
+		if (m_count == m_chunks.size() * m_chunkCapacity)
+		{
+			m_chunks.push_back(static_cast<std::byte*>(::operator new(chunk_size, std::align_val_t(chunk_alignment))));
+		}
+
+		std::size_t const row = m_count++;
+		Entities(row / m_chunkCapacity)[row % m_chunkCapacity] = a_entity;
+		return row;
+	}
+
+	Entity
+	Archetype::Erase(std::size_t a_row)
+	{
+		OYL_ASSERT(a_row < m_count);
+
+		std::size_t const last = --m_count;
+		if (a_row == last)
+		{
+			return null_entity;
+		}
+
+		for (std::size_t column = 0; column < m_components.size(); column++)
+		{
+			m_components[column]->Relocate(ComponentAt(a_row, column), ComponentAt(last, column), 1);
+		}
+
+		Entity const moved = EntityAt(last);
+		Entities(a_row / m_chunkCapacity)[a_row % m_chunkCapacity] = moved;
+		return moved;
+	}
+
+	void
+	Archetype::DestroyRow(std::size_t a_row)
+	{
+		for (std::size_t column = 0; column < m_components.size(); column++)
+		{
+			m_components[column]->Destroy(ComponentAt(a_row, column), 1);
+		}
+	}
+
+	void
+	Archetype::Clear()
+	{
+		for (std::size_t chunk = 0; chunk < ChunkCount(); chunk++)
+		{
+			for (std::size_t column = 0; column < m_components.size(); column++)
+			{
+				m_components[column]->Destroy(Column(chunk, column), ChunkEntityCount(chunk));
+			}
+		}
+		m_count = 0;
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include "Component.h"
+#include "Entity.h"
+
+#include "Core/Common.h"
+#include "Core/Types/TypeId.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Storage of every entity with exactly one set of components
+	 * \remarks Entities are stored in chunks of chunk_size bytes. A chunk holds an array of its entities followed by
+	 *          one array per component, so iterating a component of a chunk reads contiguous memory. Rows are kept
+	 *          dense, removing one moves the last row into its place, so every chunk but the last is full and a row
+	 *          index is its chunk times ChunkCapacity() plus its row in the chunk.
+	 *      <br>Chunks are kept when emptied and reused as the archetype grows again.
+	 */
+	class OYL_CORE_API Archetype
+	{
+	public:
+		constexpr static std::size_t chunk_size      = 16 * 1024;
+		constexpr static std::size_t chunk_alignment = 64;
+
+		/// \param a_components Sorted by id, without duplicates
+		explicit
+		Archetype(std::vector<ComponentInfo const*> a_components);
+
+		~Archetype();
+
+		Archetype(Archetype const&) = delete;
+		Archetype&
+		operator =(Archetype const&) = delete;
+
+#pragma region Layout
+		std::vector<ComponentInfo const*> const& Components() const noexcept { return m_components; }
+
+		std::size_t ComponentCount() const noexcept { return m_components.size(); }
+
+		/// \return The column of a_id, or ComponentCount() if the archetype does not have it
+		std::size_t
+		ColumnOf(TypeId a_id) const noexcept
+		{
+			std::size_t column = 0;
+			while (column < m_components.size() && m_components[column]->id != a_id)
+			{
+				column++;
+			}
+			return column;
+		}
+
+		bool Has(TypeId a_id) const noexcept { return ColumnOf(a_id) != m_components.size(); }
+
+		/// \brief Rows per chunk
+		std::size_t ChunkCapacity() const noexcept { return m_chunkCapacity; }
+#pragma endregion
+#pragma region Rows
+		std::size_t EntityCount() const noexcept { return m_count; }
+
+		/// \brief Chunks holding at least one entity
+		std::size_t ChunkCount() const noexcept { return (m_count + m_chunkCapacity - 1) / m_chunkCapacity; }
+
+		/// \brief Entities in a_chunk
+		std::size_t
+		ChunkEntityCount(std::size_t a_chunk) const noexcept
+		{
+			std::size_t const first = a_chunk * m_chunkCapacity;
+			return std::min(m_count - first, m_chunkCapacity);
+		}
+
+		Entity*
+		Entities(std::size_t a_chunk) const noexcept
+		{
+			return reinterpret_cast<Entity*>(m_chunks[a_chunk]);
+		}
+
+		std::byte*
+		Column(std::size_t a_chunk, std::size_t a_column) const noexcept
+		{
+			return m_chunks[a_chunk] + m_columnOffsets[a_column];
+		}
+
+		Entity
+		EntityAt(std::size_t a_row) const noexcept
+		{
+			return Entities(a_row / m_chunkCapacity)[a_row % m_chunkCapacity];
+		}
+
+		std::byte*
+		ComponentAt(std::size_t a_row, std::size_t a_column) const noexcept
+		{
+			std::size_t const chunk = a_row / m_chunkCapacity;
+			std::size_t const row   = a_row % m_chunkCapacity;
+			return Column(chunk, a_column) + row * m_components[a_column]->size;
+		}
+
+		/**
+		 * \brief Adds a row for a_entity at the end
+		 * \return The new row, its components are uninitialized
+		 */
+		std::size_t
+		Push(Entity a_entity);
+
+		/**
+		 * \brief Fills a_row with the last row, whose components must already have been destroyed or moved out
+		 * \return The entity moved into a_row, or null_entity when a_row was the last row
+		 */
+		Entity
+		Erase(std::size_t a_row);
+
+		/// \brief Destroys the components of a_row, the row still has to be erased
+		void
+		DestroyRow(std::size_t a_row);
+
+		/// \brief Destroys every entity's components, keeping the chunks
+		void
+		Clear();
+#pragma endregion
+
+	private:
+		friend class EntityWorld;
+
+		std::vector<ComponentInfo const*> m_components;
+		/// Byte offset of each column within a chunk, the entities are at offset 0
+		std::vector<std::size_t> m_columnOffsets;
+		std::size_t              m_chunkCapacity = 0;
+
+		std::vector<std::byte*> m_chunks;
+		std::size_t             m_count = 0;
+
+		// Archetypes with one component added or removed, filled in by EntityWorld as entities move
+		std::unordered_map<TypeId, Archetype*> m_addEdges;
+		std::unordered_map<TypeId, Archetype*> m_removeEdges;
+	};
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "Core/Common.h"
+#include "Core/Types/TypeId.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief What chunks need to store a component type without knowing it, one static instance per type
+	 * \remarks Components are plain structs stored by value. Entities moving between archetypes relocate their
+	 *          components, so components must be nothrow move constructible. Trivially copyable components have no
+	 *          functions and are relocated with memcpy.
+	 */
+	struct ComponentInfo
+	{
+		TypeId      id        = TypeId::Null;
+		std::size_t size      = 0;
+		std::size_t alignment = 0;
+
+		/// Move constructs a_count components into uninitialized a_destination and destroys the a_source ones
+		void (*relocate)(void* a_destination, void* a_source, std::size_t a_count) = nullptr;
+
+		/// Destroys a_count components
+		void (*destroy)(void* a_components, std::size_t a_count) = nullptr;
+
+		template<typename T>
+		static
+		ComponentInfo const&
+		Get() noexcept;
+
+		void
+		Relocate(void* a_destination, void* a_source, std::size_t a_count) const
+		{
+			if (relocate)
+			{
+				relocate(a_destination, a_source, a_count);
+			}
+			else
+			{
+				std::memcpy(a_destination, a_source, a_count * size);
+			}
+		}
+
+		void
+		Destroy(void* a_components, std::size_t a_count) const
+		{
+			if (destroy)
+			{
+				destroy(a_components, a_count);
+			}
+		}
+	};
+
+	namespace Detail
+	{
+		template<typename T>
+		void
+		RelocateComponents(void* a_destination, void* a_source, std::size_t a_count)
+		{
+			T* destination = static_cast<T*>(a_destination);
+			T* source      = static_cast<T*>(a_source);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				new(destination + i) T(std::move(source[i]));
+				source[i].~T();
+			}
+		}
+
+		template<typename T>
+		void
+		DestroyComponents(void* a_components, std::size_t a_count)
+		{
+			T* components = static_cast<T*>(a_components);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				components[i].~T();
+			}
+		}
+	}
+
+	template<typename T>
+	ComponentInfo const&
+	ComponentInfo::Get() noexcept
+	{
+		static_assert(std::is_same_v<T, Detail::raw_type_t<T>>, "Components are identified by their raw type");
+		static_assert(std::is_nothrow_move_constructible_v<T>, "Components must be nothrow move constructible");
+		static_assert(!std::is_empty_v<T>, "Empty components are not supported, every component takes a column");
+
+		static ComponentInfo const info = []()
+		{
+			ComponentInfo result;
+			result.id        = GetTypeId<T>();
+			result.size      = sizeof(T);
+			result.alignment = alignof(T);
+			if constexpr (!std::is_trivially_copyable_v<T>)
+			{
+				result.relocate = &Detail::RelocateComponents<T>;
+			}
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				result.destroy = &Detail::DestroyComponents<T>;
+			}
+			return result;
+		}();
+
+		return info;
+	}
+}
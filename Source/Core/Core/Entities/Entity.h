@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Handle to an entity of an EntityWorld
+	 * \remarks index is the entity's slot in the world, generation counts how many times the slot was reused. A
+	 *          destroyed entity's slot goes to the next entity created, with the next generation, so handles to the
+	 *          destroyed one stop being alive instead of pointing at the new one.
+	 *      <br>Live entities have a generation of at least 1, a default constructed handle is never alive.
+	 */
+	struct Entity
+	{
+		uint32 index      = 0;
+		uint32 generation = 0;
+
+		constexpr
+		bool
+		IsNull() const noexcept { return generation == 0; }
+
+		constexpr
+		bool
+		operator ==(Entity a_other) const noexcept { return index == a_other.index && generation == a_other.generation; }
+
+		constexpr
+		bool
+		operator !=(Entity a_other) const noexcept { return !(*this == a_other); }
+	};
+
+	constexpr Entity null_entity = Entity {};
+}
@@ -0,0 +1,304 @@
+#include "pch.h"
+#include "EntityWorld.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		bool
+		ComponentLess(ComponentInfo const* a_lhs, ComponentInfo const* a_rhs)
+		{
+			return a_lhs->id < a_rhs->id;
+		}
+
+		/// \brief Whether a_archetype has every one of a_types
+		bool
+		Matches(Archetype const& a_archetype, std::vector<TypeId> const& a_types)
+		{
+			return std::all_of(a_types.begin(), a_types.end(), [&a_archetype](TypeId a_type) { return a_archetype.Has(a_type); });
+		}
+	}
+
+	EntityWorld::EntityWorld(std::size_t a_threadCount)
+		: m_scheduler(a_threadCount)
+	{
+		m_emptyArchetype = FindOrCreateArchetype({});
+	}
+
+	EntityWorld::~EntityWorld() = default;
+
+#pragma region Entities
+	Entity
+	EntityWorld::Create()
+	{
+		OYL_ASSERT(m_iterating == 0, "Entities cannot be created while a query iterates");
+		ValidateStructuralChange();
+		return Allocate(m_emptyArchetype);
+	}
+
+	void
+	EntityWorld::Destroy(Entity a_entity)
+	{
+		OYL_ASSERT(m_iterating == 0, "Entities cannot be destroyed while a query iterates");
+		OYL_ASSERT(IsAlive(a_entity), "Destroying an entity that is not alive");
+		ValidateStructuralChange();
+
+		EntitySlot& slot = m_slots[a_entity.index];
+		slot.archetype->DestroyRow(slot.row);
+
+		Entity const moved = slot.archetype->Erase(slot.row);
+		if (!moved.IsNull())
+		{
+			m_slots[moved.index].row = slot.row;
+		}
+
+		// Generation 0 is never alive, skip it when the counter wraps
+		slot.archetype = nullptr;
+		if (++slot.generation == 0)
+		{
+			slot.generation = 1;
+		}
+		m_freeSlots.push_back(a_entity.index);
+	}
+
+	void
+	EntityWorld::Clear()
+	{
+		OYL_ASSERT(m_iterating == 0, "Entities cannot be destroyed while a query iterates");
+		ValidateStructuralChange();
+
+		for (std::unique_ptr<Archetype>& archetype : m_archetypes)
+		{
+			archetype->Clear();
+		}
+
+		for (uint32 index = 0; index < m_slots.size(); index++)
+		{
+			EntitySlot& slot = m_slots[index];
+			if (slot.archetype != nullptr)
+			{
+				slot.archetype = nullptr;
+				if (++slot.generation == 0)
+				{
+					slot.generation = 1;
+				}
+				m_freeSlots.push_back(index);
+			}
+		}
+	}
+
+	Entity
+	EntityWorld::Allocate(Archetype* a_archetype)
+	{
+		uint32 index;
+		if (!m_freeSlots.empty())
+		{
+			index = m_freeSlots.back();
+			m_freeSlots.pop_back();
+		}
+		else
+		{
+			index = static_cast<uint32>(m_slots.size());
+			m_slots.emplace_back();
+		}
+
+		EntitySlot&  slot   = m_slots[index];
+		Entity const entity = { index, slot.generation };
+		slot.archetype      = a_archetype;
+		slot.row            = a_archetype->Push(entity);
+		return entity;
+	}
+#pragma endregion
+#pragma region Archetypes
+	Archetype*
+	EntityWorld::FindOrCreateArchetype(std::vector<ComponentInfo const*> a_components)
+	{
+		std::vector<TypeId> key(a_components.size());
+		std::transform(a_components.begin(), a_components.end(), key.begin(), [](ComponentInfo const* a_component) { return a_component->id; });
+
+		auto found = m_archetypeLookup.find(key);
+		if (found != m_archetypeLookup.end())
+		{
+			return found->second;
+		}
+
+		Archetype* archetype = m_archetypes.emplace_back(std::make_unique<Archetype>(std::move(a_components))).get();
+		m_archetypeLookup.emplace(std::move(key), archetype);
+
+		std::lock_guard lock(m_queryMutex);
+		for (std::unique_ptr<Query>& query : m_queries)
+		{
+			if (Matches(*archetype, query->types))
+			{
+				query->archetypes.push_back(archetype);
+			}
+		}
+		return archetype;
+	}
+
+	Archetype*
+	EntityWorld::WithComponent(Archetype* a_archetype, ComponentInfo const& a_component)
+	{
+		auto edge = a_archetype->m_addEdges.find(a_component.id);
+		if (edge != a_archetype->m_addEdges.end())
+		{
+			return edge->second;
+		}
+		if (a_archetype->Has(a_component.id))
+		{
+			return a_archetype;
+		}
+
+		std::vector<ComponentInfo const*> components = a_archetype->Components();
+		components.insert(std::upper_bound(components.begin(), components.end(), &a_component, ComponentLess), &a_component);
+
+		Archetype* target = FindOrCreateArchetype(std::move(components));
+		a_archetype->m_addEdges[a_component.id] = target;
+		target->m_removeEdges[a_component.id]   = a_archetype;
+		return target;
+	}
+
+	Archetype*
+	EntityWorld::WithoutComponent(Archetype* a_archetype, TypeId a_id)
+	{
+		auto edge = a_archetype->m_removeEdges.find(a_id);
+		if (edge != a_archetype->m_removeEdges.end())
+		{
+			return edge->second;
+		}
+
+		std::vector<ComponentInfo const*> components = a_archetype->Components();
+		components.erase(components.begin() + a_archetype->ColumnOf(a_id));
+
+		Archetype* target = FindOrCreateArchetype(std::move(components));
+		a_archetype->m_removeEdges[a_id] = target;
+		target->m_addEdges[a_id]         = a_archetype;
+		return target;
+	}
+
+	std::size_t
+	EntityWorld::MoveEntity(Entity a_entity, Archetype* a_target)
+	{
+		EntitySlot&       slot      = m_slots[a_entity.index];
+		Archetype* const  source    = slot.archetype;
+		std::size_t const sourceRow = slot.row;
+		std::size_t const row       = a_target->Push(a_entity);
+
+		// Both archetypes' components are sorted by id, so matching columns are found in one pass over both
+		std::vector<ComponentInfo const*> const& targetComponents = a_target->Components();
+		std::size_t                              targetColumn     = 0;
+		for (std::size_t column = 0; column < source->ComponentCount(); column++)
+		{
+			ComponentInfo const& component = *source->Components()[column];
+			while (targetColumn < targetComponents.size() && targetComponents[targetColumn]->id < component.id)
+			{
+				targetColumn++;
+			}
+
+			if (targetColumn < targetComponents.size() && targetComponents[targetColumn]->id == component.id)
+			{
+				component.Relocate(a_target->ComponentAt(row, targetColumn), source->ComponentAt(sourceRow, column), 1);
+			}
+			else
+			{
+				component.Destroy(source->ComponentAt(sourceRow, column), 1);
+			}
+		}
+
+		Entity const moved = source->Erase(sourceRow);
+		if (!moved.IsNull())
+		{
+			m_slots[moved.index].row = sourceRow;
+		}
+
+		slot.archetype = a_target;
+		slot.row       = row;
+		return row;
+	}
+
+	EntityWorld::Query const&
+	EntityWorld::GetQuery(TypeId const* a_types, std::size_t a_count)
+	{
+		std::lock_guard lock(m_queryMutex);
+
+		// Few distinct queries exist, comparing against each is cheaper than building a key to look up
+		for (std::unique_ptr<Query> const& query : m_queries)
+		{
+			if (std::equal(query->types.begin(), query->types.end(), a_types, a_types + a_count))
+			{
+				return *query;
+			}
+		}
+
+		Query& query = *m_queries.emplace_back(std::make_unique<Query>());
+		query.types.assign(a_types, a_types + a_count);
+		for (std::unique_ptr<Archetype> const& archetype : m_archetypes)
+		{
+			if (Matches(*archetype, query.types))
+			{
+				query.archetypes.push_back(archetype.get());
+			}
+		}
+		return query;
+	}
+#pragma endregion
+#pragma region Validation
+#if OYL_DEBUG
+	void
+	EntityWorld::ValidateStructuralChange() const
+	{
+		SystemAccess const* access = SystemScheduler::CurrentAccess();
+		OYL_ASSERT(access == nullptr || access->exclusive, "Only exclusive systems can create, destroy or change the components of entities");
+	}
+
+	void
+	EntityWorld::ValidateAccess(TypeId a_id, bool a_write) const
+	{
+		SystemAccess const* access = SystemScheduler::CurrentAccess();
+
+		// Components a system did not declare are not part of the scheduler's graph, another system could be
+		// writing them right now
+		if (a_write)
+		{
+			OYL_ASSERT(access == nullptr || access->CanWrite(a_id), "System writes component {} without declaring it", static_cast<uint32>(a_id));
+		}
+		else
+		{
+			OYL_ASSERT(access == nullptr || access->CanRead(a_id), "System reads component {} without declaring it", static_cast<uint32>(a_id));
+		}
+	}
+#endif
+#pragma endregion
+#pragma region Systems
+	void
+	EntityWorld::AddSystem(std::string_view a_name, SystemFn a_fn)
+	{
+		AddSystem(a_name, SystemAccess::Exclusive(), std::move(a_fn));
+	}
+
+	void
+	EntityWorld::AddSystem(std::string_view a_name, SystemAccess a_access, SystemFn a_fn)
+	{
+		m_scheduler.Add(
+			a_name,
+			std::move(a_access),
+			[fn = std::move(a_fn)](EntityWorld& a_world, std::size_t, std::size_t) { fn(a_world); }
+		);
+	}
+
+	void
+	EntityWorld::OnUpdate()
+	{
+		OYL_PROFILE_FUNCTION();
+
+		m_scheduler.Run(*this);
+	}
+
+	void
+	EntityWorld::OnShutdown()
+	{
+		Clear();
+		m_scheduler.Clear();
+	}
+#pragma endregion
+}
@@ -0,0 +1,504 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "Archetype.h"
+#include "Component.h"
+#include "Entity.h"
+#include "SystemScheduler.h"
+
+#include "Core/Common.h"
+#include "Core/Application/Module.h"
+#include "Core/Types/TypeId.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief The entities of one chunk matched by a query, with a pointer to each queried component's array
+	 * \remarks Components queried as const are only readable, ie. Column<Transform const>().
+	 */
+	template<typename... TComponents>
+	struct EntityChunk
+	{
+		Entity const* entities = nullptr;
+		std::size_t   count    = 0;
+
+		std::tuple<TComponents*...> columns;
+
+		template<typename T>
+		T*
+		Column() const noexcept { return std::get<T*>(columns); }
+	};
+
+	/**
+	 * \brief Archetype based entity component system, entities with the same set of components are stored together
+	 * \remarks Components are plain structs identified by their TypeId, see ComponentInfo. Each distinct set of
+	 *          components is an Archetype, which stores its entities' components in arrays per chunk, so queries
+	 *          only read contiguous memory. Adding or removing a component moves the entity to the archetype with
+	 *          that component added or removed, found through edges cached on the archetypes.
+	 *      <br>Queries cache the archetypes they match and are updated as archetypes are created, so iterating
+	 *          never searches the archetypes. Entities cannot be created, destroyed or change their components while
+	 *          a query iterates, changing the values of existing components is fine. Queries may run on several
+	 *          threads at once as long as none writes a component another reads or writes.
+	 *      <br>Systems added with AddSystem run every OnUpdate on a SystemScheduler, in parallel where the components
+	 *          they declare allow it.
+	 */
+	class OYL_CORE_API EntityWorld : public Module
+	{
+		OYL_DECLARE_MODULE(EntityWorld, "Entity World");
+
+	public:
+		using SystemFn = std::function<void(EntityWorld&)>;
+
+		/// \param a_threadCount Threads systems run on, including the one calling OnUpdate, 0 for one per hardware thread
+		explicit
+		EntityWorld(std::size_t a_threadCount = 0);
+
+		~EntityWorld() override;
+
+#pragma region Entities
+		/// \brief Creates an entity without components
+		Entity
+		Create();
+
+		/// \brief Creates an entity with a_components, placed straight into its archetype
+		template<typename... TComponents>
+		Entity
+		Create(TComponents&&... a_components);
+
+		/// \brief Destroys a_entity and its components, handles to it stop being alive
+		void
+		Destroy(Entity a_entity);
+
+		bool
+		IsAlive(Entity a_entity) const noexcept
+		{
+			return a_entity.index < m_slots.size()
+				&& m_slots[a_entity.index].generation == a_entity.generation
+				&& m_slots[a_entity.index].archetype != nullptr;
+		}
+
+		std::size_t EntityCount() const noexcept { return m_slots.size() - m_freeSlots.size(); }
+
+		/// \brief Destroys every entity, handles to them stop being alive
+		void
+		Clear();
+#pragma endregion
+#pragma region Components
+		/**
+		 * \brief Adds a T built from a_args to a_entity, or replaces its T if it already has one
+		 * \return The entity's component, valid until the entity's components change
+		 */
+		template<typename T, typename... TArgs>
+		T&
+		Add(Entity a_entity, TArgs&&... a_args);
+
+		/// \return Whether a_entity had a T
+		template<typename T>
+		bool
+		Remove(Entity a_entity);
+
+		/// \return The entity's T or nullptr, valid until the entity's components change
+		template<typename T>
+		T*
+		Get(Entity a_entity) const;
+
+		template<typename T>
+		bool
+		Has(Entity a_entity) const;
+#pragma endregion
+#pragma region Queries
+		/**
+		 * \brief Calls a_func(EntityChunk<TComponents...> const&) for every chunk of entities with all of TComponents
+		 * \remarks The fastest way to iterate, the loop over a chunk's arrays is left to a_func.
+		 */
+		template<typename... TComponents, typename TFunc>
+		void
+		ForEachChunk(TFunc&& a_func);
+
+		/// \brief ForEachChunk over only chunks [a_firstChunk, a_lastChunk) of the ones it would visit
+		template<typename... TComponents, typename TFunc>
+		void
+		ForEachChunk(std::size_t a_firstChunk, std::size_t a_lastChunk, TFunc&& a_func);
+
+		/// \brief Calls a_func(TComponents&...), or a_func(Entity, TComponents&...), for every entity with all of TComponents
+		template<typename... TComponents, typename TFunc>
+		void
+		ForEach(TFunc&& a_func);
+
+		/// \brief Entities with all of TComponents
+		template<typename... TComponents>
+		std::size_t
+		Count();
+
+		/// \brief Chunks ForEachChunk<TComponents...> visits
+		template<typename... TComponents>
+		std::size_t
+		ChunkCount();
+
+		std::size_t ArchetypeCount() const noexcept { return m_archetypes.size(); }
+#pragma endregion
+#pragma region Systems
+		/// \brief Adds a_fn to run every update with exclusive access, alone and after every system added before it
+		void
+		AddSystem(std::string_view a_name, SystemFn a_fn);
+
+		/// \brief Adds a_fn to run every update, touching only the components in a_access
+		void
+		AddSystem(std::string_view a_name, SystemAccess a_access, SystemFn a_fn);
+
+		/**
+		 * \brief Adds a system calling a_func like ForEach, or like ForEachChunk, over the entities with all of the components
+		 * \remarks Reads the const components and writes the others. The chunks are split between the worker threads,
+		 *          so a_func may be called from several threads at once.
+		 */
+		template<typename TComponent, typename... TComponents, typename TFunc>
+		void
+		AddSystem(std::string_view a_name, TFunc a_func);
+
+		SystemScheduler const& Scheduler() const noexcept { return m_scheduler; }
+
+		void
+		OnUpdate() override;
+
+		void
+		OnShutdown() override;
+#pragma endregion
+
+	private:
+		struct EntitySlot
+		{
+			uint32 generation = 1;
+			/// Null while the slot is free
+			Archetype*  archetype = nullptr;
+			std::size_t row       = 0;
+		};
+
+		/// Archetypes with every one of types, kept up to date as archetypes are created
+		struct Query
+		{
+			std::vector<TypeId>     types;
+			std::vector<Archetype*> archetypes;
+		};
+
+		std::vector<EntitySlot> m_slots;
+		std::vector<uint32>     m_freeSlots;
+
+		std::vector<std::unique_ptr<Archetype>>    m_archetypes;
+		std::map<std::vector<TypeId>, Archetype*> m_archetypeLookup;
+		Archetype*                                 m_emptyArchetype = nullptr;
+
+		std::vector<std::unique_ptr<Query>> m_queries;
+		/// Systems on different threads can look up queries at the same time
+		std::mutex m_queryMutex;
+
+		SystemScheduler m_scheduler;
+
+		/// Queries iterating right now, entities cannot change archetype while this is not 0
+		std::atomic<uint32> m_iterating = 0;
+
+		/// \brief Takes a free slot for a new entity in a_archetype
+		/// \return The entity, its row is the archetype's last
+		Entity
+		Allocate(Archetype* a_archetype);
+
+		Archetype*
+		FindOrCreateArchetype(std::vector<ComponentInfo const*> a_components);
+
+		Archetype*
+		WithComponent(Archetype* a_archetype, ComponentInfo const& a_component);
+
+		Archetype*
+		WithoutComponent(Archetype* a_archetype, TypeId a_id);
+
+		/**
+		 * \brief Moves a_entity's components to a_target, components a_target does not have are destroyed
+		 * \return The entity's new row, components a_target has but the old archetype did not are uninitialized
+		 */
+		std::size_t
+		MoveEntity(Entity a_entity, Archetype* a_target);
+
+		/// \param a_types a_count ids, sorted
+		Query const&
+		GetQuery(TypeId const* a_types, std::size_t a_count);
+
+		template<typename... TComponents>
+		Query const&
+		GetQuery()
+		{
+			static_assert(sizeof...(TComponents) > 0, "Queries need at least one component");
+
+			std::array<TypeId, sizeof...(TComponents)> types = { ::Oyl::GetTypeId<TComponents>()... };
+			std::sort(types.begin(), types.end());
+			return GetQuery(types.data(), types.size());
+		}
+
+		/// \brief Debug builds check that the running system declared reading, or writing when not const, a T
+		template<typename T>
+		void
+		ValidateAccess() const
+		{
+		#if OYL_DEBUG
+			ValidateAccess(::Oyl::GetTypeId<T>(), !std::is_const_v<T>);
+		#endif
+		}
+
+		/// \brief Debug builds check that entities can be created, destroyed or change their components right now
+	#if OYL_DEBUG
+		void
+		ValidateStructuralChange() const;
+
+		void
+		ValidateAccess(TypeId a_id, bool a_write) const;
+	#else
+		void ValidateStructuralChange() const {}
+	#endif
+	};
+
+	namespace Detail
+	{
+		template<typename T, typename... TArgs>
+		T
+		MakeComponent(TArgs&&... a_args)
+		{
+			if constexpr (std::is_constructible_v<T, TArgs...>)
+			{
+				return T(std::forward<TArgs>(a_args)...);
+			}
+			else
+			{
+				return T { std::forward<TArgs>(a_args)... };
+			}
+		}
+
+		/// \brief Calls a_func like ForEach for every entity of a_chunk
+		template<typename TFunc, typename... TComponents>
+		void
+		ForEachInChunk(EntityChunk<TComponents...> const& a_chunk, TFunc& a_func)
+		{
+			std::tuple<TComponents*...> const columns = a_chunk.columns;
+			for (std::size_t i = 0; i < a_chunk.count; i++)
+			{
+				if constexpr (std::is_invocable_v<TFunc&, Entity, TComponents&...>)
+				{
+					a_func(a_chunk.entities[i], std::get<TComponents*>(columns)[i]...);
+				}
+				else
+				{
+					a_func(std::get<TComponents*>(columns)[i]...);
+				}
+			}
+		}
+
+		template<typename T>
+		void
+		ConstructComponent(Archetype& a_archetype, std::size_t a_row, T&& a_component)
+		{
+			using TComponent = std::decay_t<T>;
+			void* address = a_archetype.ComponentAt(a_row, a_archetype.ColumnOf(::Oyl::GetTypeId<TComponent>()));
+			new(address) TComponent(std::forward<T>(a_component));
+		}
+	}
+
+	template<typename... TComponents>
+	Entity
+	EntityWorld::Create(TComponents&&... a_components)
+	{
+		OYL_ASSERT(m_iterating == 0, "Entities cannot be created while a query iterates");
+		ValidateStructuralChange();
+
+		Archetype* archetype = m_emptyArchetype;
+		((archetype = WithComponent(archetype, ComponentInfo::Get<std::decay_t<TComponents>>())), ...);
+
+		Entity const      entity = Allocate(archetype);
+		std::size_t const row    = m_slots[entity.index].row;
+		(Detail::ConstructComponent(*archetype, row, std::forward<TComponents>(a_components)), ...);
+		return entity;
+	}
+
+	template<typename T, typename... TArgs>
+	T&
+	EntityWorld::Add(Entity a_entity, TArgs&&... a_args)
+	{
+		OYL_ASSERT(IsAlive(a_entity), "Adding a component to an entity that is not alive");
+
+		ComponentInfo const& info = ComponentInfo::Get<T>();
+
+		// Built before the entity moves, so a throwing constructor leaves the entity as it was
+		T component = Detail::MakeComponent<T>(std::forward<TArgs>(a_args)...);
+
+		EntitySlot const& slot   = m_slots[a_entity.index];
+		std::size_t const column = slot.archetype->ColumnOf(info.id);
+		if (column != slot.archetype->ComponentCount())
+		{
+			ValidateAccess<T>();
+			T& existing = *reinterpret_cast<T*>(slot.archetype->ComponentAt(slot.row, column));
+			existing    = std::move(component);
+			return existing;
+		}
+
+		OYL_ASSERT(m_iterating == 0, "Entities cannot change archetype while a query iterates");
+		ValidateStructuralChange();
+		Archetype* const  target = WithComponent(slot.archetype, info);
+		std::size_t const row    = MoveEntity(a_entity, target);
+		return *new(target->ComponentAt(row, target->ColumnOf(info.id))) T(std::move(component));
+	}
+
+	template<typename T>
+	bool
+	EntityWorld::Remove(Entity a_entity)
+	{
+		OYL_ASSERT(IsAlive(a_entity), "Removing a component from an entity that is not alive");
+
+		TypeId const      id     = ::Oyl::GetTypeId<T>();
+		EntitySlot const& slot   = m_slots[a_entity.index];
+		if (!slot.archetype->Has(id))
+		{
+			return false;
+		}
+
+		OYL_ASSERT(m_iterating == 0, "Entities cannot change archetype while a query iterates");
+		ValidateStructuralChange();
+		MoveEntity(a_entity, WithoutComponent(slot.archetype, id));
+		return true;
+	}
+
+	template<typename T>
+	T*
+	EntityWorld::Get(Entity a_entity) const
+	{
+		OYL_ASSERT(IsAlive(a_entity), "Getting a component of an entity that is not alive");
+		ValidateAccess<T>();
+
+		EntitySlot const& slot   = m_slots[a_entity.index];
+		std::size_t const column = slot.archetype->ColumnOf(::Oyl::GetTypeId<T>());
+		if (column == slot.archetype->ComponentCount())
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<T*>(slot.archetype->ComponentAt(slot.row, column));
+	}
+
+	template<typename T>
+	bool
+	EntityWorld::Has(Entity a_entity) const
+	{
+		OYL_ASSERT(IsAlive(a_entity), "Checking a component of an entity that is not alive");
+		return m_slots[a_entity.index].archetype->Has(::Oyl::GetTypeId<T>());
+	}
+
+	template<typename... TComponents, typename TFunc>
+	void
+	EntityWorld::ForEachChunk(TFunc&& a_func)
+	{
+		ForEachChunk<TComponents...>(0, std::numeric_limits<std::size_t>::max(), std::forward<TFunc>(a_func));
+	}
+
+	template<typename... TComponents, typename TFunc>
+	void
+	EntityWorld::ForEachChunk(std::size_t a_firstChunk, std::size_t a_lastChunk, TFunc&& a_func)
+	{
+		(ValidateAccess<TComponents>(), ...);
+		Query const& query = GetQuery<TComponents...>();
+
+		m_iterating++;
+		// Index among the query's chunks of the archetype's first chunk
+		std::size_t archetypeFirst = 0;
+		for (Archetype* archetype : query.archetypes)
+		{
+			if (archetypeFirst >= a_lastChunk)
+			{
+				break;
+			}
+
+			std::size_t const chunkCount = archetype->ChunkCount();
+			std::size_t const first      = a_firstChunk > archetypeFirst ? a_firstChunk - archetypeFirst : 0;
+			std::size_t const last       = std::min(a_lastChunk - archetypeFirst, chunkCount);
+			archetypeFirst += chunkCount;
+
+			std::array<std::size_t, sizeof...(TComponents)> const columns = { archetype->ColumnOf(::Oyl::GetTypeId<TComponents>())... };
+			for (std::size_t chunk = first; chunk < last; chunk++)
+			{
+				std::size_t column = 0;
+
+				EntityChunk<TComponents...> const view = {
+					archetype->Entities(chunk),
+					archetype->ChunkEntityCount(chunk),
+					{ reinterpret_cast<TComponents*>(archetype->Column(chunk, columns[column++]))... }
+				};
+				a_func(view);
+			}
+		}
+		m_iterating--;
+	}
+
+	template<typename... TComponents, typename TFunc>
+	void
+	EntityWorld::ForEach(TFunc&& a_func)
+	{
+		ForEachChunk<TComponents...>([&a_func](EntityChunk<TComponents...> const& a_chunk) { Detail::ForEachInChunk(a_chunk, a_func); });
+	}
+
+	template<typename... TComponents>
+	std::size_t
+	EntityWorld::Count()
+	{
+		std::size_t count = 0;
+		for (Archetype const* archetype : GetQuery<TComponents...>().archetypes)
+		{
+			count += archetype->EntityCount();
+		}
+		return count;
+	}
+
+	template<typename... TComponents>
+	std::size_t
+	EntityWorld::ChunkCount()
+	{
+		std::size_t count = 0;
+		for (Archetype const* archetype : GetQuery<TComponents...>().archetypes)
+		{
+			count += archetype->ChunkCount();
+		}
+		return count;
+	}
+
+	template<typename TComponent, typename... TComponents, typename TFunc>
+	void
+	EntityWorld::AddSystem(std::string_view a_name, TFunc a_func)
+	{
+		using Chunk = EntityChunk<TComponent, TComponents...>;
+
+		m_scheduler.Add(
+			a_name,
+			SystemAccess::Of<TComponent, TComponents...>(),
+			[func = std::move(a_func)](EntityWorld& a_world, std::size_t a_firstChunk, std::size_t a_lastChunk)
+			{
+				a_world.ForEachChunk<TComponent, TComponents...>(a_firstChunk, a_lastChunk, [&func](Chunk const& a_chunk)
+				{
+					if constexpr (std::is_invocable_v<TFunc const&, Chunk const&>)
+					{
+						func(a_chunk);
+					}
+					else
+					{
+						Detail::ForEachInChunk(a_chunk, func);
+					}
+				});
+			},
+			[](EntityWorld& a_world) { return a_world.ChunkCount<TComponent, TComponents...>(); }
+		);
+	}
+}
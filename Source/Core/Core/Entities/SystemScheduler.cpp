@@ -0,0 +1,185 @@
+#include "pch.h"
+#include "SystemScheduler.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		thread_local SystemAccess const* t_currentAccess = nullptr;
+
+		bool
+		Contains(std::vector<TypeId> const& a_types, TypeId a_id)
+		{
+			return std::find(a_types.begin(), a_types.end(), a_id) != a_types.end();
+		}
+
+		bool
+		Intersects(std::vector<TypeId> const& a_lhs, std::vector<TypeId> const& a_rhs)
+		{
+			return std::any_of(a_lhs.begin(), a_lhs.end(), [&a_rhs](TypeId a_id) { return Contains(a_rhs, a_id); });
+		}
+	}
+
+#pragma region System Access
+	bool
+	SystemAccess::CanRead(TypeId a_id) const noexcept
+	{
+		return exclusive || Contains(reads, a_id) || Contains(writes, a_id);
+	}
+
+	bool
+	SystemAccess::CanWrite(TypeId a_id) const noexcept
+	{
+		return exclusive || Contains(writes, a_id);
+	}
+
+	bool
+	SystemAccess::ConflictsWith(SystemAccess const& a_other) const noexcept
+	{
+		return exclusive
+			|| a_other.exclusive
+			|| Intersects(writes, a_other.reads)
+			|| Intersects(writes, a_other.writes)
+			|| Intersects(reads, a_other.writes);
+	}
+#pragma endregion
+#pragma region Scheduler
+	void
+	SystemScheduler::Add(std::string_view a_name, SystemAccess a_access, TaskFn a_fn, ChunkCountFn a_chunkCount)
+	{
+		m_systems.push_back({ std::string(a_name), std::move(a_access), std::move(a_fn), std::move(a_chunkCount) });
+	}
+
+	void
+	SystemScheduler::Run(EntityWorld& a_world)
+	{
+		OYL_PROFILE_FUNCTION();
+
+		if (m_systems.empty())
+		{
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_mutex);
+
+			// Each system waits on every earlier system it conflicts with. Some of those edges are implied by others,
+			// which costs a counter decrement each, cheaper than finding them with a handful of systems.
+			m_states.assign(m_systems.size(), SystemState {});
+			for (std::size_t system = 0; system < m_systems.size(); system++)
+			{
+				for (std::size_t earlier = 0; earlier < system; earlier++)
+				{
+					if (m_systems[system].access.ConflictsWith(m_systems[earlier].access))
+					{
+						m_states[earlier].dependents.push_back(system);
+						m_states[system].waitingOn++;
+					}
+				}
+			}
+
+			m_systemsLeft = m_systems.size();
+			for (std::size_t system = 0; system < m_systems.size(); system++)
+			{
+				if (m_states[system].waitingOn == 0)
+				{
+					Schedule(a_world, system);
+				}
+			}
+		}
+
+		m_pool.Run([this, &a_world](std::size_t) { Work(a_world); });
+	}
+
+	SystemAccess const*
+	SystemScheduler::CurrentAccess() noexcept
+	{
+		return t_currentAccess;
+	}
+
+	void
+	SystemScheduler::Schedule(EntityWorld& a_world, std::size_t a_system)
+	{
+		System const& system = m_systems[a_system];
+
+		// Query sizes are read once the systems the query waits on are done, as exclusive ones can change them
+		std::size_t chunkCount = 0;
+		std::size_t taskCount  = 1;
+		if (system.chunkCount)
+		{
+			chunkCount = system.chunkCount(a_world);
+			taskCount  = (chunkCount + min_chunks_per_task - 1) / min_chunks_per_task;
+			taskCount  = std::clamp<std::size_t>(taskCount, 1, ThreadCount() * tasks_per_thread);
+		}
+
+		m_states[a_system].tasksLeft = taskCount;
+		for (std::size_t task = 0; task < taskCount; task++)
+		{
+			m_ready.push_back({ a_system, chunkCount * task / taskCount, chunkCount * (task + 1) / taskCount });
+		}
+	}
+
+	void
+	SystemScheduler::Work(EntityWorld& a_world)
+	{
+		std::unique_lock lock(m_mutex);
+		while (true)
+		{
+			m_wake.wait(lock, [this] { return !m_ready.empty() || m_systemsLeft == 0; });
+			if (m_systemsLeft == 0)
+			{
+				return;
+			}
+
+			Task const task = m_ready.front();
+			m_ready.pop_front();
+
+		#if OYL_DEBUG
+			if (std::find(m_running.begin(), m_running.end(), task.system) == m_running.end())
+			{
+				for (std::size_t running : m_running)
+				{
+					OYL_ASSERT(
+						!m_systems[task.system].access.ConflictsWith(m_systems[running].access),
+						"Systems \"{}\" and \"{}\" conflict but ran at the same time",
+						m_systems[task.system].name,
+						m_systems[running].name
+					);
+				}
+				m_running.push_back(task.system);
+			}
+		#endif
+
+			lock.unlock();
+			{
+				System const& system = m_systems[task.system];
+				OYL_PROFILE_SCOPE(system.name.c_str(), system.name.size());
+
+				t_currentAccess = &system.access;
+				system.fn(a_world, task.firstChunk, task.lastChunk);
+				t_currentAccess = nullptr;
+			}
+			lock.lock();
+
+			if (--m_states[task.system].tasksLeft > 0)
+			{
+				continue;
+			}
+
+		#if OYL_DEBUG
+			m_running.erase(std::find(m_running.begin(), m_running.end(), task.system));
+		#endif
+
+			m_systemsLeft--;
+			for (std::size_t dependent : m_states[task.system].dependents)
+			{
+				if (--m_states[dependent].waitingOn == 0)
+				{
+					Schedule(a_world, dependent);
+				}
+			}
+			m_wake.notify_all();
+		}
+	}
+#pragma endregion
+}
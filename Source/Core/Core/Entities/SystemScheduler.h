@@ -0,0 +1,175 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Common.h"
+#include "Core/Threading/WorkerPool.h"
+#include "Core/Types/TypeId.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	class EntityWorld;
+
+	/**
+	 * \brief Components a system reads and writes
+	 * \remarks Systems conflict when either writes a component the other reads or writes, or either is exclusive.
+	 *          Exclusive systems may create and destroy entities and change their components, so they run alone.
+	 */
+	struct OYL_CORE_API SystemAccess
+	{
+		std::vector<TypeId> reads;
+		std::vector<TypeId> writes;
+
+		bool exclusive = false;
+
+		template<typename... TComponents>
+		SystemAccess&
+		Read()
+		{
+			(reads.push_back(GetTypeId<TComponents>()), ...);
+			return *this;
+		}
+
+		template<typename... TComponents>
+		SystemAccess&
+		Write()
+		{
+			(writes.push_back(GetTypeId<TComponents>()), ...);
+			return *this;
+		}
+
+		/// \brief Reads the const components of a query and writes the others
+		template<typename... TComponents>
+		static
+		SystemAccess
+		Of()
+		{
+			SystemAccess result;
+			((std::is_const_v<TComponents> ? result.reads : result.writes).push_back(GetTypeId<TComponents>()), ...);
+			return result;
+		}
+
+		static
+		SystemAccess
+		Exclusive()
+		{
+			SystemAccess result;
+			result.exclusive = true;
+			return result;
+		}
+
+		bool
+		CanRead(TypeId a_id) const noexcept;
+
+		bool
+		CanWrite(TypeId a_id) const noexcept;
+
+		bool
+		ConflictsWith(SystemAccess const& a_other) const noexcept;
+	};
+
+	/**
+	 * \brief Runs an EntityWorld's systems over a WorkerPool, in parallel where their access allows
+	 * \remarks Every run builds a dependency graph from the systems' access, a system waits for every system added
+	 *          before it that it conflicts with, so conflicting systems keep the order they were added in. Systems
+	 *          run as soon as what they wait for is done, on whichever thread is free.
+	 *      <br>Systems over a query are split into tasks of at least min_chunks_per_task chunks each, so one large
+	 *          query spreads over every thread. Every task shows in the profiler as a zone named after its system.
+	 *      <br>Debug builds check that no two conflicting systems ever run at once, and EntityWorld checks that a
+	 *          system only touches the components it declared, see CurrentAccess.
+	 */
+	class OYL_CORE_API SystemScheduler
+	{
+	public:
+		/// Runs chunks [a_firstChunk, a_lastChunk) of a system's query, systems without one ignore the range
+		using TaskFn = std::function<void(EntityWorld& a_world, std::size_t a_firstChunk, std::size_t a_lastChunk)>;
+
+		/// How many chunks a system's query matches this frame
+		using ChunkCountFn = std::function<std::size_t(EntityWorld& a_world)>;
+
+		/// Fewer chunks than this are not worth a task of their own, 64KB of components at 16KB chunks
+		constexpr static std::size_t min_chunks_per_task = 4;
+
+		/// Tasks per thread a system is split into at most, more than one so uneven tasks still balance
+		constexpr static std::size_t tasks_per_thread = 4;
+
+		/// \param a_threadCount Threads including the one calling Run, 0 for one per hardware thread
+		explicit
+		SystemScheduler(std::size_t a_threadCount = 0)
+			: m_pool(a_threadCount) {}
+
+		/// \param a_chunkCount Null for systems without a query, which run as one task
+		void
+		Add(std::string_view a_name, SystemAccess a_access, TaskFn a_fn, ChunkCountFn a_chunkCount = nullptr);
+
+		void
+		Clear() { m_systems.clear(); }
+
+		/// \brief Runs every system once, returning when all are done
+		void
+		Run(EntityWorld& a_world);
+
+		std::size_t SystemCount() const noexcept { return m_systems.size(); }
+
+		std::size_t ThreadCount() const noexcept { return m_pool.ThreadCount(); }
+
+		/// \brief Access of the system running on the calling thread, nullptr outside of systems
+		static
+		SystemAccess const*
+		CurrentAccess() noexcept;
+
+	private:
+		struct System
+		{
+			std::string  name;
+			SystemAccess access;
+			TaskFn       fn;
+			ChunkCountFn chunkCount;
+		};
+
+		struct Task
+		{
+			std::size_t system;
+			std::size_t firstChunk;
+			std::size_t lastChunk;
+		};
+
+		/// A system's place in this run's graph
+		struct SystemState
+		{
+			std::vector<std::size_t> dependents;
+			std::size_t              waitingOn = 0;
+			std::size_t              tasksLeft = 0;
+		};
+
+		std::vector<System> m_systems;
+		WorkerPool          m_pool;
+
+		// The current run, only touched under m_mutex
+		std::mutex               m_mutex;
+		std::condition_variable  m_wake;
+		std::vector<SystemState> m_states;
+		std::deque<Task>         m_ready;
+		std::size_t              m_systemsLeft = 0;
+#if OYL_DEBUG
+		std::vector<std::size_t> m_running;
+#endif
+
+		/// \brief Splits a_system into tasks and queues them, under m_mutex
+		void
+		Schedule(EntityWorld& a_world, std::size_t a_system);
+
+		/// \brief Runs tasks until every system is done, on every thread of the pool
+		void
+		Work(EntityWorld& a_world);
+	};
+}
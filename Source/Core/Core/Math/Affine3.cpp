@@ -0,0 +1,26 @@
+#include "pch.h"
+#include "Affine3.h"
+
+namespace Oyl::Affine
+{
+	void
+	MultiplyBatch(Affine3 const* a_lhs, Affine3 const* a_rhs, Affine3* a_out, std::size_t a_count)
+	{
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			a_out[i] = a_lhs[i] * a_rhs[i];
+		}
+	}
+
+	void
+	ConcatenateHierarchy(Affine3 const* a_local, int32 const* a_parents, Affine3* a_world, std::size_t a_count)
+	{
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			int32 parent = a_parents[i];
+			OYL_ASSERT(parent < static_cast<int32>(i));
+
+			a_world[i] = parent < 0 ? a_local[i] : a_local[i] * a_world[parent];
+		}
+	}
+}
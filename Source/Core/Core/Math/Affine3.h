@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Detail/type_Affine.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	typedef Affine_t<float> Affine3;
+	static_assert(sizeof(Affine3) == sizeof(Affine3::data));
+}
+
+namespace Oyl::Affine
+{
+	/// \brief a_out[i] = a_lhs[i] * a_rhs[i], a_out may alias either input
+	OYL_CORE_API
+	extern
+	void
+	MultiplyBatch(Affine3 const* a_lhs, Affine3 const* a_rhs, Affine3* a_out, std::size_t a_count);
+
+	/**
+	 * \brief Computes world transforms for a flattened hierarchy, a_world[i] = a_local[i] * a_world[a_parents[i]]
+	 * \param a_parents Index of each node's parent, or -1 for roots. Parents must come before their children.
+	 * \remark a_world must not alias a_local.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	ConcatenateHierarchy(Affine3 const* a_local, int32 const* a_parents, Affine3* a_world, std::size_t a_count);
+}
@@ -0,0 +1,1429 @@
+#include "pch.h"
+#include "BVH.h"
+
+#include "Simd.h"
+
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		constexpr uint32 no_index = ~0u;
+
+		constexpr uint32 max_bins = 64;
+
+		/// Deeper ranges are split at the median, which bounds the depth whatever the input
+		constexpr uint32 max_sah_depth = 64;
+
+		/// Enough for the deepest tree, each level leaves at most three siblings on the stack
+		constexpr std::size_t stack_size = 3 * (max_sah_depth + 32) + 4;
+
+		constexpr std::size_t packet_size = 8;
+
+		float
+		HalfArea(AABB const& a_box)
+		{
+			Vector3 size = a_box.Size();
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		float
+		HalfArea(Simd::Float4 a_min, Simd::Float4 a_max)
+		{
+			alignas(16) float size[4];
+			Simd::Store(size, Simd::Sub(a_max, a_min));
+			return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+		}
+
+		/// Direction components this small are replaced to keep the slab test free of infinities and NaNs
+		float
+		SafeInverse(float a_value)
+		{
+			constexpr float smallest = 1e-30f;
+			return 1.0f / (std::abs(a_value) < smallest ? std::copysign(smallest, a_value) : a_value);
+		}
+
+		/// \brief Moves the boxes a_predicate holds for to the front, with their primitives alongside
+		/// \return How many it holds for
+		template<typename TBox, typename TPredicate>
+		uint32
+		Partition(TBox* a_boxes, uint32* a_primitives, uint32 a_count, TPredicate a_predicate)
+		{
+			uint32 left = 0, right = a_count;
+			while (true)
+			{
+				while (left < right && a_predicate(a_boxes[left]))
+				{
+					left++;
+				}
+				while (left < right && !a_predicate(a_boxes[right - 1]))
+				{
+					right--;
+				}
+				if (left >= right)
+				{
+					return left;
+				}
+				right--;
+				std::swap(a_boxes[left], a_boxes[right]);
+				std::swap(a_primitives[left], a_primitives[right]);
+				left++;
+			}
+		}
+
+#pragma region Slab Tests
+		/**
+		 * \brief A ray prepared for the slab test against the four children of a BVHNode
+		 * \remarks Sweeping a box of half size extents is the same test against children grown by extents, which
+		 *          moves the near and far planes by the same amount. Folding that into the origin costs nothing.
+		 */
+		struct SlabRay
+		{
+			Simd::Float4 originNear[3];
+			Simd::Float4 originFar[3];
+			Simd::Float4 inverse[3];
+			/// Row of BVHNode::bounds the ray enters each child's slab through, and leaves through
+			int near[3];
+			int far[3];
+		};
+
+		SlabRay
+		MakeSlabRay(Vector3 const& a_origin, Vector3 const& a_direction, Vector3 const& a_extents = Vector3())
+		{
+			SlabRay result;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				bool  positive = a_direction.data[axis] >= 0;
+				float extent   = positive ? a_extents.data[axis] : -a_extents.data[axis];
+
+				result.near[axis]       = positive ? axis : axis + 3;
+				result.far[axis]        = positive ? axis + 3 : axis;
+				result.originNear[axis] = Simd::Splat(a_origin.data[axis] + extent);
+				result.originFar[axis]  = Simd::Splat(a_origin.data[axis] - extent);
+				result.inverse[axis]    = Simd::Splat(SafeInverse(a_direction.data[axis]));
+			}
+			return result;
+		}
+
+		/// \return A bit per child the ray enters within a_maxDistance, with the entry distances in a_distances
+		OYL_FORCE_INLINE
+		int
+		IntersectChildren(BVHNode const& a_node, SlabRay const& a_ray, Simd::Float4 a_maxDistance, float* a_distances)
+		{
+			Simd::Float4 nearX = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.near[0]]), a_ray.originNear[0]), a_ray.inverse[0]);
+			Simd::Float4 nearY = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.near[1]]), a_ray.originNear[1]), a_ray.inverse[1]);
+			Simd::Float4 nearZ = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.near[2]]), a_ray.originNear[2]), a_ray.inverse[2]);
+			Simd::Float4 farX  = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.far[0]]), a_ray.originFar[0]), a_ray.inverse[0]);
+			Simd::Float4 farY  = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.far[1]]), a_ray.originFar[1]), a_ray.inverse[1]);
+			Simd::Float4 farZ  = Simd::Mul(Simd::Sub(Simd::Load(a_node.bounds[a_ray.far[2]]), a_ray.originFar[2]), a_ray.inverse[2]);
+
+			// Unused children have min above max, so they are entered after they are left and never hit
+			Simd::Float4 entry = Simd::Max(Simd::Max(nearX, nearY), Simd::Max(nearZ, Simd::Zero()));
+			Simd::Float4 exit  = Simd::Min(Simd::Min(farX, farY), Simd::Min(farZ, a_maxDistance));
+
+			Simd::Store(a_distances, entry);
+			return Simd::MoveMask(Simd::LessEqual(entry, exit));
+		}
+
+		/// \return A bit per child whose box overlaps the box a_min to a_max
+		OYL_FORCE_INLINE
+		int
+		OverlapChildren(BVHNode const& a_node, Simd::Float4 const (&a_min)[3], Simd::Float4 const (&a_max)[3])
+		{
+			Simd::Float4 separated = Simd::Zero();
+			for (int axis = 0; axis < 3; axis++)
+			{
+				separated = Simd::Or(separated, Simd::Greater(Simd::Load(a_node.bounds[axis]), a_max[axis]));
+				separated = Simd::Or(separated, Simd::Less(Simd::Load(a_node.bounds[axis + 3]), a_min[axis]));
+			}
+			return ~Simd::MoveMask(separated) & 0xF;
+		}
+
+		/// Eight rays in structure of arrays form, see SlabRay
+		struct RayPacket
+		{
+			Simd::Float8 origin[3];
+			Simd::Float8 direction[3];
+			Simd::Float8 inverse[3];
+		};
+
+		/// \return A bit per ray of a_packet that enters the box of child a_child closer than its a_maxDistance
+		OYL_FORCE_INLINE
+		int
+		IntersectChild(BVHNode const& a_node, int a_child, RayPacket const& a_packet, Simd::Float8 a_maxDistance)
+		{
+			Simd::Float8 entry = Simd::Zero8();
+			Simd::Float8 exit  = a_maxDistance;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				Simd::Float8 low  = Simd::Mul(Simd::Sub(Simd::Splat8(a_node.bounds[axis][a_child]), a_packet.origin[axis]), a_packet.inverse[axis]);
+				Simd::Float8 high = Simd::Mul(Simd::Sub(Simd::Splat8(a_node.bounds[axis + 3][a_child]), a_packet.origin[axis]), a_packet.inverse[axis]);
+				entry = Simd::Max(entry, Simd::Min(low, high));
+				exit  = Simd::Min(exit, Simd::Max(low, high));
+			}
+			return Simd::MoveMask(Simd::LessEqual(entry, exit));
+		}
+#pragma endregion
+#pragma region Triangle Tests
+		/**
+		 * \brief Möller-Trumbore ray triangle test, hitting both sides
+		 * \return Whether the ray hits the triangle closer than a_hit.distance, in which case a_hit is updated
+		 */
+		OYL_FORCE_INLINE
+		bool
+		IntersectTriangle(Vector3 const& a_a, Vector3 const& a_ab, Vector3 const& a_ac, Ray const& a_ray, RayHit& a_hit)
+		{
+			Vector3 p   = Vector::Cross(a_ray.direction, a_ac);
+			float   det = Vector::Dot(a_ab, p);
+			if (std::abs(det) < std::numeric_limits<float>::min())
+			{
+				return false;
+			}
+			float inverse = 1.0f / det;
+
+			Vector3 s = a_ray.origin - a_a;
+			float   u = Vector::Dot(s, p) * inverse;
+			if (u < 0 || u > 1)
+			{
+				return false;
+			}
+
+			Vector3 q = Vector::Cross(s, a_ab);
+			float   v = Vector::Dot(a_ray.direction, q) * inverse;
+			if (v < 0 || u + v > 1)
+			{
+				return false;
+			}
+
+			float t = Vector::Dot(a_ac, q) * inverse;
+			if (t < 0 || t >= a_hit.distance)
+			{
+				return false;
+			}
+
+			a_hit.distance = t;
+			a_hit.u        = u;
+			a_hit.v        = v;
+			return true;
+		}
+
+		/// \brief IntersectTriangle for a packet, lanes that hit closer take a_primitive and the new distance
+		OYL_FORCE_INLINE
+		void
+		IntersectTriangle(
+			Vector3 const&   a_a,
+			Vector3 const&   a_ab,
+			Vector3 const&   a_ac,
+			uint32           a_primitive,
+			RayPacket const& a_packet,
+			Simd::Float8&    a_distance,
+			Simd::Float8&    a_u,
+			Simd::Float8&    a_v,
+			Simd::Int8&      a_primitives
+		)
+		{
+			Simd::Float8 const ab[3] = { Simd::Splat8(a_ab.x), Simd::Splat8(a_ab.y), Simd::Splat8(a_ab.z) };
+			Simd::Float8 const ac[3] = { Simd::Splat8(a_ac.x), Simd::Splat8(a_ac.y), Simd::Splat8(a_ac.z) };
+			Simd::Float8 const* d    = a_packet.direction;
+
+			Simd::Float8 p[3] = {
+				Simd::Sub(Simd::Mul(d[1], ac[2]), Simd::Mul(d[2], ac[1])),
+				Simd::Sub(Simd::Mul(d[2], ac[0]), Simd::Mul(d[0], ac[2])),
+				Simd::Sub(Simd::Mul(d[0], ac[1]), Simd::Mul(d[1], ac[0])),
+			};
+			Simd::Float8 det     = Simd::MulAdd(ab[2], p[2], Simd::MulAdd(ab[1], p[1], Simd::Mul(ab[0], p[0])));
+			Simd::Float8 inverse = Simd::Div(Simd::Splat8(1), det);
+
+			Simd::Float8 s[3] = {
+				Simd::Sub(a_packet.origin[0], Simd::Splat8(a_a.x)),
+				Simd::Sub(a_packet.origin[1], Simd::Splat8(a_a.y)),
+				Simd::Sub(a_packet.origin[2], Simd::Splat8(a_a.z)),
+			};
+			Simd::Float8 u = Simd::Mul(Simd::MulAdd(s[2], p[2], Simd::MulAdd(s[1], p[1], Simd::Mul(s[0], p[0]))), inverse);
+
+			Simd::Float8 q[3] = {
+				Simd::Sub(Simd::Mul(s[1], ab[2]), Simd::Mul(s[2], ab[1])),
+				Simd::Sub(Simd::Mul(s[2], ab[0]), Simd::Mul(s[0], ab[2])),
+				Simd::Sub(Simd::Mul(s[0], ab[1]), Simd::Mul(s[1], ab[0])),
+			};
+			Simd::Float8 v = Simd::Mul(Simd::MulAdd(d[2], q[2], Simd::MulAdd(d[1], q[1], Simd::Mul(d[0], q[0]))), inverse);
+			Simd::Float8 t = Simd::Mul(Simd::MulAdd(ac[2], q[2], Simd::MulAdd(ac[1], q[1], Simd::Mul(ac[0], q[0]))), inverse);
+
+			// Comparisons with NaN are false, so a parallel ray's division by zero misses on its own
+			Simd::Float8 const zero = Simd::Zero8();
+			Simd::Float8       hit  = Simd::And(Simd::LessEqual(zero, u), Simd::LessEqual(zero, v));
+			hit = Simd::And(hit, Simd::LessEqual(Simd::Add(u, v), Simd::Splat8(1)));
+			hit = Simd::And(hit, Simd::And(Simd::LessEqual(zero, t), Simd::Less(t, a_distance)));
+
+			a_distance   = Simd::Select(hit, t, a_distance);
+			a_u          = Simd::Select(hit, u, a_u);
+			a_v          = Simd::Select(hit, v, a_v);
+			a_primitives = Simd::Select(Simd::BitCastToInt(hit), Simd::SplatInt8(static_cast<int32>(a_primitive)), a_primitives);
+		}
+
+		Vector3
+		ClosestPointOnTriangle(Vector3 const& a_point, Vector3 const& a_a, Vector3 const& a_b, Vector3 const& a_c)
+		{
+			// Voronoi regions of the vertices, then the edges, then the face (Ericson, Real-Time Collision Detection)
+			Vector3 ab = a_b - a_a;
+			Vector3 ac = a_c - a_a;
+			Vector3 ap = a_point - a_a;
+			float   d1 = Vector::Dot(ab, ap);
+			float   d2 = Vector::Dot(ac, ap);
+			if (d1 <= 0 && d2 <= 0)
+			{
+				return a_a;
+			}
+
+			Vector3 bp = a_point - a_b;
+			float   d3 = Vector::Dot(ab, bp);
+			float   d4 = Vector::Dot(ac, bp);
+			if (d3 >= 0 && d4 <= d3)
+			{
+				return a_b;
+			}
+
+			float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0 && d1 >= 0 && d3 <= 0)
+			{
+				return a_a + ab * (d1 / (d1 - d3));
+			}
+
+			Vector3 cp = a_point - a_c;
+			float   d5 = Vector::Dot(ab, cp);
+			float   d6 = Vector::Dot(ac, cp);
+			if (d6 >= 0 && d5 <= d6)
+			{
+				return a_c;
+			}
+
+			float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0 && d2 >= 0 && d6 <= 0)
+			{
+				return a_a + ac * (d2 / (d2 - d6));
+			}
+
+			float va = d3 * d6 - d5 * d4;
+			if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+			{
+				return a_b + (a_c - a_b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+			}
+
+			float denominator = 1.0f / (va + vb + vc);
+			return a_a + ab * (vb * denominator) + ac * (vc * denominator);
+		}
+
+		/**
+		 * \brief First distance at which a unit ray comes within a_radius of the segment a_a to a_b
+		 * \return Infinity when it never does, the ray is expected to start further than a_radius from the segment
+		 */
+		float
+		RaycastCapsule(Vector3 const& a_origin, Vector3 const& a_direction, Vector3 const& a_a, Vector3 const& a_b, float a_radius)
+		{
+			constexpr float miss = std::numeric_limits<float>::infinity();
+
+			Vector3 ba   = a_b - a_a;
+			Vector3 oa   = a_origin - a_a;
+			float   baba = Vector::Dot(ba, ba);
+			float   bard = Vector::Dot(ba, a_direction);
+			float   baoa = Vector::Dot(ba, oa);
+			float   rdoa = Vector::Dot(a_direction, oa);
+			float   oaoa = Vector::Dot(oa, oa);
+
+			// The side of the capsule, unless the ray runs along the segment
+			float a = baba - bard * bard;
+			float y = baoa;
+			if (a > std::numeric_limits<float>::epsilon() * baba)
+			{
+				float b = baba * rdoa - baoa * bard;
+				float c = baba * oaoa - baoa * baoa - a_radius * a_radius * baba;
+				float h = b * b - a * c;
+				if (h < 0)
+				{
+					return miss;
+				}
+				float t = (-b - std::sqrt(h)) / a;
+				y       = baoa + t * bard;
+				if (y > 0 && y < baba)
+				{
+					return t >= 0 ? t : miss;
+				}
+			}
+
+			// The sphere at the end it would otherwise pass
+			Vector3 oc = y <= 0 ? oa : a_origin - a_b;
+			float   b  = Vector::Dot(a_direction, oc);
+			float   c  = Vector::Dot(oc, oc) - a_radius * a_radius;
+			float   h  = b * b - c;
+			if (h < 0)
+			{
+				return miss;
+			}
+			float t = -b - std::sqrt(h);
+			return t >= 0 ? t : miss;
+		}
+
+		/// \return The distance a sphere moves along the unit a_direction before it touches the triangle, or infinity
+		float
+		SpherecastTriangle(Vector3 const& a_center, float a_radius, Vector3 const& a_direction, Vector3 const& a_a, Vector3 const& a_ab, Vector3 const& a_ac)
+		{
+			Vector3 const b = a_a + a_ab;
+			Vector3 const c = a_a + a_ac;
+
+			Vector3 closest = ClosestPointOnTriangle(a_center, a_a, b, c);
+			if (Vector::MagnitudeSquared(closest - a_center) <= a_radius * a_radius)
+			{
+				return 0;
+			}
+
+			// The face, from whichever side the sphere is on
+			float   result = std::numeric_limits<float>::infinity();
+			Vector3 normal = Vector::Cross(a_ab, a_ac);
+			float   length = Vector::Magnitude(normal);
+			if (length > 0)
+			{
+				normal /= length;
+				float height = Vector::Dot(normal, a_center - a_a);
+				if (height < 0)
+				{
+					normal = -normal;
+					height = -height;
+				}
+
+				float approach = -Vector::Dot(normal, a_direction);
+				if (approach > 0)
+				{
+					float   t       = (height - a_radius) / approach;
+					Vector3 contact = a_center + a_direction * t - normal * a_radius;
+					if (Vector::MagnitudeSquared(ClosestPointOnTriangle(contact, a_a, b, c) - contact) <= 1e-8f * (1 + t * t))
+					{
+						return t;
+					}
+				}
+			}
+
+			// Otherwise the sphere first touches an edge or a vertex
+			result = std::min(result, RaycastCapsule(a_center, a_direction, a_a, b, a_radius));
+			result = std::min(result, RaycastCapsule(a_center, a_direction, b, c, a_radius));
+			result = std::min(result, RaycastCapsule(a_center, a_direction, c, a_a, a_radius));
+			return result;
+		}
+#pragma endregion
+	}
+
+#pragma region Build
+	void
+	BVH::Build(AABB const* a_boxes, std::size_t a_count, BVHSettings const& a_settings)
+	{
+		std::size_t taskCount = BeginBuild(a_boxes, a_count, 1, a_settings);
+		for (std::size_t task = 0; task < taskCount; task++)
+		{
+			BuildTask(task);
+		}
+		EndBuild();
+	}
+
+	void
+	BVH::Build(AABB const* a_boxes, std::size_t a_count, WorkerPool& a_pool, BVHSettings const& a_settings)
+	{
+		// Subtrees differ in size, a few per thread let threads that finish early take the remaining ones
+		std::size_t taskCount = BeginBuild(a_boxes, a_count, a_pool.ThreadCount() * WorkerPool::ranges_per_thread, a_settings);
+		a_pool.ParallelFor(taskCount, [this](std::size_t a_task) { BuildTask(a_task); });
+		EndBuild();
+	}
+
+	std::size_t
+	BVH::BeginBuild(AABB const* a_boxes, std::size_t a_count, std::size_t a_taskCount, BVHSettings const& a_settings)
+	{
+		OYL_ASSERT(a_count < no_index);
+		OYL_ASSERT(a_settings.binCount >= 2 && a_settings.binCount <= max_bins);
+		OYL_ASSERT(a_settings.maxLeafSize >= 1);
+
+		m_source   = a_boxes;
+		m_settings = a_settings;
+
+		m_primitives.resize(a_count);
+		m_buildBoxes.resize(a_count);
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			m_primitives[i] = static_cast<uint32>(i);
+
+			BuildBox& box = m_buildBoxes[i];
+			Simd::Store(box.min, Simd::Load3(a_boxes[i].min.data));
+			Simd::Store(box.max, Simd::Load3(a_boxes[i].max.data));
+		}
+
+		m_top.clear();
+		m_tasks.clear();
+		if (a_count == 0)
+		{
+			return 0;
+		}
+		m_top.push_back(MakeNode(0, static_cast<uint32>(a_count)));
+
+		// Split the largest range left until there are enough, each split at the top takes a whole pass over its
+		// range so these are the only part of the build that runs on one thread
+		std::vector<uint32> leaves = { 0 };
+		while (leaves.size() < a_taskCount)
+		{
+			auto largest = std::max_element(
+				leaves.begin(),
+				leaves.end(),
+				[this](uint32 a_lhs, uint32 a_rhs) { return m_top[a_lhs].count < m_top[a_rhs].count; }
+			);
+
+			uint32 node = *largest;
+			if (m_top[node].count <= m_settings.maxLeafSize * 4 || !Split(m_top, node, false))
+			{
+				break;
+			}
+			*largest = m_top[node].children[0];
+			leaves.push_back(m_top[node].children[1]);
+		}
+
+		for (uint32 leaf : leaves)
+		{
+			m_top[leaf].task = static_cast<uint32>(m_tasks.size());
+			m_tasks.push_back(Task { m_top[leaf].first, m_top[leaf].count, {} });
+		}
+		return m_tasks.size();
+	}
+
+	void
+	BVH::BuildTask(std::size_t a_task)
+	{
+		Task& task = m_tasks[a_task];
+
+		task.nodes.clear();
+		task.nodes.reserve(2 * (task.count / m_settings.maxLeafSize) + 1);
+		task.nodes.push_back(MakeNode(task.first, task.count));
+		BuildSubtree(task.nodes);
+	}
+
+	void
+	BVH::BuildSubtree(std::vector<BuildNode>& a_nodes)
+	{
+		struct Pending
+		{
+			uint32 node;
+			uint32 depth;
+		};
+
+		std::vector<Pending> pending = { Pending { 0, 0 } };
+		while (!pending.empty())
+		{
+			Pending current = pending.back();
+			pending.pop_back();
+
+			if (Split(a_nodes, current.node, current.depth >= max_sah_depth))
+			{
+				pending.push_back(Pending { a_nodes[current.node].children[1], current.depth + 1 });
+				pending.push_back(Pending { a_nodes[current.node].children[0], current.depth + 1 });
+			}
+		}
+	}
+
+	BVH::BuildNode
+	BVH::MakeNode(uint32 a_first, uint32 a_count) const
+	{
+		Simd::Float4 const infinity = Simd::Splat(std::numeric_limits<float>::infinity());
+
+		Simd::Float4 boundsMin = infinity, boundsMax = Simd::Negate(infinity);
+		Simd::Float4 centerMin = infinity, centerMax = Simd::Negate(infinity);
+		for (uint32 i = a_first; i < a_first + a_count; i++)
+		{
+			BuildBox const& box = m_buildBoxes[i];
+			Simd::Float4    min = Simd::Load(box.min);
+			Simd::Float4    max = Simd::Load(box.max);
+			Simd::Float4    sum = Simd::Add(min, max);
+
+			boundsMin = Simd::Min(boundsMin, min);
+			boundsMax = Simd::Max(boundsMax, max);
+			centerMin = Simd::Min(centerMin, sum);
+			centerMax = Simd::Max(centerMax, sum);
+		}
+
+		BuildNode node;
+		Simd::Store3(node.bounds.min.data, boundsMin);
+		Simd::Store3(node.bounds.max.data, boundsMax);
+		Simd::Store3(node.centers.min.data, centerMin);
+		Simd::Store3(node.centers.max.data, centerMax);
+		node.children[0] = no_index;
+		node.children[1] = no_index;
+		node.first       = a_first;
+		node.count       = a_count;
+		node.task        = no_index;
+		return node;
+	}
+
+	bool
+	BVH::Split(std::vector<BuildNode>& a_nodes, uint32 a_node, bool a_median)
+	{
+		uint32 const first = a_nodes[a_node].first;
+		uint32 const count = a_nodes[a_node].count;
+		if (count <= 1)
+		{
+			return false;
+		}
+
+		uint32* const   primitives = m_primitives.data() + first;
+		BuildBox* const boxes      = m_buildBoxes.data() + first;
+
+		// Centers are kept doubled, the sum of min and max, which sorts and bins the same
+		AABB const    centers = a_nodes[a_node].centers;
+		Vector3 const extent  = centers.Size();
+
+		// Small ranges get a bin per primitive at most, the fixed cost of the sweep dominates them
+		uint32 const binCount = std::min(m_settings.binCount, count);
+
+		Simd::Float4 const origin = Simd::Load3(centers.min.data);
+		Simd::Float4 const scale  = Simd::Set(
+			extent.x > 0 ? static_cast<float>(binCount) / extent.x : 0,
+			extent.y > 0 ? static_cast<float>(binCount) / extent.y : 0,
+			extent.z > 0 ? static_cast<float>(binCount) / extent.z : 0,
+			0
+		);
+		Simd::Float4 const lastBin = Simd::Splat(static_cast<float>(binCount - 1));
+
+		// Bin of the center of a_box along each axis
+		auto binOf = [&](BuildBox const& a_box, int32 (&a_bins)[4])
+		{
+			Simd::Float4 center = Simd::Add(Simd::Load(a_box.min), Simd::Load(a_box.max));
+			Simd::Store(a_bins, Simd::TruncateToInt(Simd::Min(Simd::Mul(Simd::Sub(center, origin), scale), lastBin)));
+		};
+
+		int   bestAxis  = -1;
+		int32 bestSplit = 0;
+		float bestCost  = std::numeric_limits<float>::infinity();
+		if (!a_median)
+		{
+			Simd::Float4 const infinity = Simd::Splat(std::numeric_limits<float>::infinity());
+
+			// Every axis is binned in the same pass, an axis without extent puts everything in its first bin
+			Simd::Float4 binMin[3][max_bins], binMax[3][max_bins];
+			uint32       binCounts[3][max_bins];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				std::fill(binMin[axis], binMin[axis] + binCount, infinity);
+				std::fill(binMax[axis], binMax[axis] + binCount, Simd::Negate(infinity));
+				std::fill(binCounts[axis], binCounts[axis] + binCount, 0u);
+			}
+
+			for (uint32 i = 0; i < count; i++)
+			{
+				BuildBox const& box = boxes[i];
+				Simd::Float4    min = Simd::Load(box.min);
+				Simd::Float4    max = Simd::Load(box.max);
+
+				int32 bins[4];
+				binOf(box, bins);
+				for (int axis = 0; axis < 3; axis++)
+				{
+					binMin[axis][bins[axis]] = Simd::Min(binMin[axis][bins[axis]], min);
+					binMax[axis][bins[axis]] = Simd::Max(binMax[axis][bins[axis]], max);
+					binCounts[axis][bins[axis]]++;
+				}
+			}
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (extent.data[axis] <= 0)
+				{
+					continue;
+				}
+
+				// Areas and counts left of each border, then sweep back from the right
+				float        leftArea[max_bins];
+				uint32       leftCount[max_bins];
+				Simd::Float4 min   = infinity, max = Simd::Negate(infinity);
+				uint32       total = 0;
+				for (uint32 bin = 0; bin + 1 < binCount; bin++)
+				{
+					min             = Simd::Min(min, binMin[axis][bin]);
+					max             = Simd::Max(max, binMax[axis][bin]);
+					total          += binCounts[axis][bin];
+					leftArea[bin]   = total > 0 ? HalfArea(min, max) : 0;
+					leftCount[bin]  = total;
+				}
+
+				min   = infinity;
+				max   = Simd::Negate(infinity);
+				total = 0;
+				for (uint32 bin = binCount - 1; bin > 0; bin--)
+				{
+					min    = Simd::Min(min, binMin[axis][bin]);
+					max    = Simd::Max(max, binMax[axis][bin]);
+					total += binCounts[axis][bin];
+					if (total == 0 || total == count)
+					{
+						continue;
+					}
+
+					float cost = leftArea[bin - 1] * static_cast<float>(leftCount[bin - 1]) + HalfArea(min, max) * static_cast<float>(total);
+					if (cost < bestCost)
+					{
+						bestCost  = cost;
+						bestAxis  = axis;
+						bestSplit = static_cast<int32>(bin);
+					}
+				}
+			}
+		}
+
+		uint32 middle = 0;
+		if (bestAxis >= 0)
+		{
+			// SAH cost relative to the parent's area, a leaf costs one per primitive
+			float const parentArea = HalfArea(a_nodes[a_node].bounds);
+			float const cost       = m_settings.traversalCost + (parentArea > 0 ? bestCost / parentArea : static_cast<float>(count));
+			if (count <= m_settings.maxLeafSize && cost >= static_cast<float>(count))
+			{
+				return false;
+			}
+
+			middle = Partition(
+				boxes,
+				primitives,
+				count,
+				[&](BuildBox const& a_box)
+				{
+					int32 bins[4];
+					binOf(a_box, bins);
+					return bins[bestAxis] < bestSplit;
+				}
+			);
+		}
+		else if (count <= m_settings.maxLeafSize)
+		{
+			return false;
+		}
+
+		if (middle == 0 || middle == count)
+		{
+			// Too deep for the heuristic, split the range at the median center along the longest axis. Ranges whose
+			// centers are all in one place are split in half as they are.
+			int const          axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+			std::vector<float> centers(count);
+			for (uint32 i = 0; i < count; i++)
+			{
+				centers[i] = boxes[i].min[axis] + boxes[i].max[axis];
+			}
+			std::nth_element(centers.begin(), centers.begin() + count / 2, centers.end());
+			float const median = centers[count / 2];
+
+			middle = Partition(boxes, primitives, count, [&](BuildBox const& a_box) { return a_box.min[axis] + a_box.max[axis] < median; });
+			if (middle == 0 || middle == count)
+			{
+				middle = count / 2;
+			}
+		}
+
+		uint32 const children = static_cast<uint32>(a_nodes.size());
+		a_nodes.push_back(MakeNode(first, middle));
+		a_nodes.push_back(MakeNode(first + middle, count - middle));
+		a_nodes[a_node].children[0] = children;
+		a_nodes[a_node].children[1] = children + 1;
+		return true;
+	}
+
+	void
+	BVH::EndBuild()
+	{
+		m_nodes.clear();
+		m_boxes.resize(m_primitives.size());
+		for (std::size_t i = 0; i < m_primitives.size(); i++)
+		{
+			m_boxes[i] = m_source[m_primitives[i]];
+		}
+
+		if (!m_top.empty())
+		{
+			// A node of the binary tree, which is either in m_top or in the nodes of a task
+			struct Ref
+			{
+				std::vector<BuildNode> const* nodes;
+				uint32                        index;
+
+				BuildNode const& Node() const { return (*nodes)[index]; }
+
+				bool IsLeaf() const { return Node().children[0] == no_index; }
+			};
+
+			auto resolve = [this](Ref a_ref)
+			{
+				uint32 task = a_ref.Node().task;
+				return task == no_index ? a_ref : Ref { &m_tasks[task].nodes, 0 };
+			};
+
+			auto allocate = [this]
+			{
+				BVHNode node;
+				for (int child = 0; child < 4; child++)
+				{
+					for (int axis = 0; axis < 3; axis++)
+					{
+						node.bounds[axis][child]     = std::numeric_limits<float>::infinity();
+						node.bounds[axis + 3][child] = -std::numeric_limits<float>::infinity();
+					}
+					node.children[child] = BVHNode::no_child;
+					node.counts[child]   = 0;
+				}
+				m_nodes.push_back(node);
+				return static_cast<uint32>(m_nodes.size() - 1);
+			};
+
+			struct Pending
+			{
+				Ref    ref;
+				uint32 wide;
+			};
+			std::vector<Pending> pending;
+
+			Ref root = resolve(Ref { &m_top, 0 });
+			pending.push_back(Pending { root, allocate() });
+			while (!pending.empty())
+			{
+				Pending current = pending.back();
+				pending.pop_back();
+
+				// Pull up to four descendants into one node, always opening the largest inner one
+				Ref    children[4];
+				uint32 childCount = 0;
+				if (current.ref.IsLeaf())
+				{
+					children[childCount++] = current.ref;
+				}
+				else
+				{
+					children[childCount++] = resolve(Ref { current.ref.nodes, current.ref.Node().children[0] });
+					children[childCount++] = resolve(Ref { current.ref.nodes, current.ref.Node().children[1] });
+				}
+				while (childCount < 4)
+				{
+					int   largest = -1;
+					float area    = -1;
+					for (uint32 i = 0; i < childCount; i++)
+					{
+						if (!children[i].IsLeaf() && HalfArea(children[i].Node().bounds) > area)
+						{
+							largest = static_cast<int>(i);
+							area    = HalfArea(children[i].Node().bounds);
+						}
+					}
+					if (largest < 0)
+					{
+						break;
+					}
+
+					Ref opened           = children[largest];
+					children[largest]    = resolve(Ref { opened.nodes, opened.Node().children[0] });
+					children[childCount] = resolve(Ref { opened.nodes, opened.Node().children[1] });
+					childCount++;
+				}
+
+				for (uint32 i = 0; i < childCount; i++)
+				{
+					BuildNode const& child = children[i].Node();
+
+					uint32 index = BVHNode::no_child, count = 0;
+					if (children[i].IsLeaf())
+					{
+						index = child.first;
+						count = child.count;
+					}
+					else
+					{
+						index = allocate();
+						pending.push_back(Pending { children[i], index });
+					}
+
+					BVHNode& node = m_nodes[current.wide];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						node.bounds[axis][i]     = child.bounds.min.data[axis];
+						node.bounds[axis + 3][i] = child.bounds.max.data[axis];
+					}
+					node.children[i] = index;
+					node.counts[i]   = count;
+				}
+			}
+		}
+
+		m_source = nullptr;
+		m_buildBoxes.clear();
+		m_buildBoxes.shrink_to_fit();
+		m_top.clear();
+		m_tasks.clear();
+	}
+
+	void
+	BVH::Refit(AABB const* a_boxes)
+	{
+		for (std::size_t i = 0; i < m_primitives.size(); i++)
+		{
+			m_boxes[i] = a_boxes[m_primitives[i]];
+		}
+
+		// Children come after their parent, so going backwards every child is refit before its parent reads it
+		Simd::Float4 const infinity = Simd::Splat(std::numeric_limits<float>::infinity());
+		for (std::size_t i = m_nodes.size(); i-- > 0;)
+		{
+			BVHNode& node = m_nodes[i];
+
+			alignas(16) float bounds[2][4][4];
+			for (int child = 0; child < 4; child++)
+			{
+				Simd::Float4 min = infinity, max = Simd::Negate(infinity);
+				if (node.counts[child] > 0)
+				{
+					for (uint32 j = node.children[child]; j < node.children[child] + node.counts[child]; j++)
+					{
+						min = Simd::Min(min, Simd::Load3(m_boxes[j].min.data));
+						max = Simd::Max(max, Simd::Load3(m_boxes[j].max.data));
+					}
+				}
+				else if (node.children[child] != BVHNode::no_child)
+				{
+					// The union of the inner node's children, a transpose turns its rows into one box per column
+					BVHNode const& inner = m_nodes[node.children[child]];
+					Simd::Float4   rows[2][4];
+					for (int axis = 0; axis < 3; axis++)
+					{
+						rows[0][axis] = Simd::Load(inner.bounds[axis]);
+						rows[1][axis] = Simd::Load(inner.bounds[axis + 3]);
+					}
+					rows[0][3] = Simd::Zero();
+					rows[1][3] = Simd::Zero();
+					Simd::Transpose(rows[0][0], rows[0][1], rows[0][2], rows[0][3]);
+					Simd::Transpose(rows[1][0], rows[1][1], rows[1][2], rows[1][3]);
+					for (int k = 0; k < 4; k++)
+					{
+						min = Simd::Min(min, rows[0][k]);
+						max = Simd::Max(max, rows[1][k]);
+					}
+				}
+				Simd::Store(bounds[0][child], min);
+				Simd::Store(bounds[1][child], max);
+			}
+
+			for (int child = 0; child < 4; child++)
+			{
+				for (int axis = 0; axis < 3; axis++)
+				{
+					node.bounds[axis][child]     = bounds[0][child][axis];
+					node.bounds[axis + 3][child] = bounds[1][child][axis];
+				}
+			}
+		}
+	}
+
+	AABB
+	BVH::RootBounds() const
+	{
+		AABB bounds = AABB::Empty();
+		if (!m_nodes.empty())
+		{
+			BVHNode const& root = m_nodes[0];
+			for (int child = 0; child < 4; child++)
+			{
+				if (root.children[child] != BVHNode::no_child)
+				{
+					bounds = Bounds::Merge(bounds, AABB {
+						Vector3(root.bounds[0][child], root.bounds[1][child], root.bounds[2][child]),
+						Vector3(root.bounds[3][child], root.bounds[4][child], root.bounds[5][child])
+					});
+				}
+			}
+		}
+		return bounds;
+	}
+#pragma endregion
+#pragma region Queries
+	std::size_t
+	BVH::Raycast(Ray const& a_ray, uint32* a_hits, float* a_distances, float a_maxDistance) const
+	{
+		AABB const shape { a_ray.origin, a_ray.origin };
+		return Shapecast(shape, a_ray.direction, a_hits, a_distances, a_maxDistance);
+	}
+
+	std::size_t
+	BVH::Overlap(AABB const& a_query, uint32* a_hits) const
+	{
+		if (m_nodes.empty())
+		{
+			return 0;
+		}
+
+		Simd::Float4 const min[3] = { Simd::Splat(a_query.min.x), Simd::Splat(a_query.min.y), Simd::Splat(a_query.min.z) };
+		Simd::Float4 const max[3] = { Simd::Splat(a_query.max.x), Simd::Splat(a_query.max.y), Simd::Splat(a_query.max.z) };
+
+		uint32      stack[stack_size];
+		std::size_t stackSize = 0;
+		std::size_t count     = 0;
+
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			BVHNode const& node = m_nodes[stack[--stackSize]];
+
+			int mask = OverlapChildren(node, min, max);
+			while (mask != 0)
+			{
+				int child = 0;
+				while (((mask >> child) & 1) == 0)
+				{
+					child++;
+				}
+				mask &= mask - 1;
+
+				if (node.counts[child] == 0)
+				{
+					OYL_ASSERT(stackSize < stack_size);
+					stack[stackSize++] = node.children[child];
+					continue;
+				}
+
+				for (uint32 i = node.children[child]; i < node.children[child] + node.counts[child]; i++)
+				{
+					if (Bounds::Overlaps(m_boxes[i], a_query))
+					{
+						a_hits[count++] = m_primitives[i];
+					}
+				}
+			}
+		}
+		return count;
+	}
+
+	std::size_t
+	BVH::Shapecast(AABB const& a_shape, Vector3 const& a_direction, uint32* a_hits, float* a_distances, float a_maxDistance) const
+	{
+		if (m_nodes.empty())
+		{
+			return 0;
+		}
+
+		Vector3 const extents = a_shape.Extents();
+		Ray const     ray { a_shape.Center(), a_direction };
+		SlabRay const slab        = MakeSlabRay(ray.origin, a_direction, extents);
+		Simd::Float4  maxDistance = Simd::Splat(a_maxDistance);
+
+		uint32      stack[stack_size];
+		std::size_t stackSize = 0;
+		std::size_t count     = 0;
+
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			BVHNode const& node = m_nodes[stack[--stackSize]];
+
+			alignas(16) float entries[4];
+			int               mask = IntersectChildren(node, slab, maxDistance, entries);
+			while (mask != 0)
+			{
+				int child = 0;
+				while (((mask >> child) & 1) == 0)
+				{
+					child++;
+				}
+				mask &= mask - 1;
+
+				if (node.counts[child] == 0)
+				{
+					OYL_ASSERT(stackSize < stack_size);
+					stack[stackSize++] = node.children[child];
+					continue;
+				}
+
+				for (uint32 i = node.children[child]; i < node.children[child] + node.counts[child]; i++)
+				{
+					AABB const grown { m_boxes[i].min - extents, m_boxes[i].max + extents };
+
+					float distance;
+					if (Bounds::Raycast(ray, grown, distance, a_maxDistance))
+					{
+						if (a_distances)
+						{
+							a_distances[count] = distance;
+						}
+						a_hits[count++] = m_primitives[i];
+					}
+				}
+			}
+		}
+		return count;
+	}
+#pragma endregion
+#pragma region Triangle BVH
+	void
+	TriangleBVH::ComputeBoxes(Vector3 const* a_triangles, std::size_t a_count)
+	{
+		m_boxes.resize(a_count);
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			Vector3 const* triangle = a_triangles + i * 3;
+			m_boxes[i] = AABB {
+				Vector::Min(triangle[0], Vector::Min(triangle[1], triangle[2])),
+				Vector::Max(triangle[0], Vector::Max(triangle[1], triangle[2]))
+			};
+		}
+	}
+
+	void
+	TriangleBVH::Build(Vector3 const* a_triangles, std::size_t a_count, BVHSettings const& a_settings)
+	{
+		std::size_t taskCount = BeginBuild(a_triangles, a_count, 1, a_settings);
+		for (std::size_t task = 0; task < taskCount; task++)
+		{
+			BuildTask(task);
+		}
+		EndBuild();
+	}
+
+	void
+	TriangleBVH::Build(Vector3 const* a_triangles, std::size_t a_count, WorkerPool& a_pool, BVHSettings const& a_settings)
+	{
+		std::size_t taskCount = BeginBuild(a_triangles, a_count, a_pool.ThreadCount() * WorkerPool::ranges_per_thread, a_settings);
+		a_pool.ParallelFor(taskCount, [this](std::size_t a_task) { BuildTask(a_task); });
+		EndBuild();
+	}
+
+	std::size_t
+	TriangleBVH::BeginBuild(Vector3 const* a_triangles, std::size_t a_count, std::size_t a_taskCount, BVHSettings const& a_settings)
+	{
+		m_source = a_triangles;
+		ComputeBoxes(a_triangles, a_count);
+		return m_tree.BeginBuild(m_boxes.data(), a_count, a_taskCount, a_settings);
+	}
+
+	void
+	TriangleBVH::EndBuild()
+	{
+		m_tree.EndBuild();
+
+		uint32 const* primitives = m_tree.Primitives();
+		m_triangles.resize(m_tree.PrimitiveCount());
+		for (std::size_t i = 0; i < m_triangles.size(); i++)
+		{
+			Vector3 const* triangle = m_source + primitives[i] * 3;
+			m_triangles[i] = Triangle { triangle[0], triangle[1] - triangle[0], triangle[2] - triangle[0] };
+		}
+
+		m_source = nullptr;
+		m_boxes.clear();
+		m_boxes.shrink_to_fit();
+	}
+
+	void
+	TriangleBVH::Refit(Vector3 const* a_triangles)
+	{
+		ComputeBoxes(a_triangles, m_triangles.size());
+		m_tree.Refit(m_boxes.data());
+
+		uint32 const* primitives = m_tree.Primitives();
+		for (std::size_t i = 0; i < m_triangles.size(); i++)
+		{
+			Vector3 const* triangle = a_triangles + primitives[i] * 3;
+			m_triangles[i] = Triangle { triangle[0], triangle[1] - triangle[0], triangle[2] - triangle[0] };
+		}
+		m_boxes.clear();
+	}
+
+	RayHit
+	TriangleBVH::Raycast(Ray const& a_ray, float a_maxDistance) const
+	{
+		RayHit result;
+		result.distance = a_maxDistance;
+		if (m_tree.NodeCount() == 0)
+		{
+			result.distance = std::numeric_limits<float>::infinity();
+			return result;
+		}
+
+		BVHNode const* nodes      = m_tree.Nodes();
+		uint32 const*  primitives = m_tree.Primitives();
+		SlabRay const  slab       = MakeSlabRay(a_ray.origin, a_ray.direction);
+
+		struct Entry
+		{
+			uint32 node;
+			float  distance;
+		};
+		Entry       stack[stack_size];
+		std::size_t stackSize = 0;
+
+		stack[stackSize++] = Entry { 0, 0 };
+		while (stackSize > 0)
+		{
+			Entry current = stack[--stackSize];
+			if (current.distance > result.distance)
+			{
+				continue;
+			}
+			BVHNode const& node = nodes[current.node];
+
+			alignas(16) float entries[4];
+			int               mask = IntersectChildren(node, slab, Simd::Splat(result.distance), entries);
+
+			// Children nearest first, leaves are tested right away and inner nodes pushed farthest first
+			int order[4], count = 0;
+			for (int child = 0; child < 4; child++)
+			{
+				if ((mask >> child) & 1)
+				{
+					int j = count++;
+					for (; j > 0 && entries[order[j - 1]] > entries[child]; j--)
+					{
+						order[j] = order[j - 1];
+					}
+					order[j] = child;
+				}
+			}
+
+			for (int i = 0; i < count; i++)
+			{
+				int child = order[i];
+				if (node.counts[child] == 0 || entries[child] > result.distance)
+				{
+					continue;
+				}
+				for (uint32 j = node.children[child]; j < node.children[child] + node.counts[child]; j++)
+				{
+					Triangle const& triangle = m_triangles[j];
+					if (IntersectTriangle(triangle.a, triangle.ab, triangle.ac, a_ray, result))
+					{
+						result.primitive = primitives[j];
+					}
+				}
+			}
+			for (int i = count; i-- > 0;)
+			{
+				int child = order[i];
+				if (node.counts[child] == 0 && entries[child] <= result.distance)
+				{
+					OYL_ASSERT(stackSize < stack_size);
+					stack[stackSize++] = Entry { node.children[child], entries[child] };
+				}
+			}
+		}
+
+		if (result.primitive == BVH::no_hit)
+		{
+			result.distance = std::numeric_limits<float>::infinity();
+		}
+		return result;
+	}
+
+	bool
+	TriangleBVH::Occluded(Ray const& a_ray, float a_maxDistance) const
+	{
+		if (m_tree.NodeCount() == 0)
+		{
+			return false;
+		}
+
+		BVHNode const*     nodes       = m_tree.Nodes();
+		SlabRay const      slab        = MakeSlabRay(a_ray.origin, a_ray.direction);
+		Simd::Float4 const maxDistance = Simd::Splat(a_maxDistance);
+
+		uint32      stack[stack_size];
+		std::size_t stackSize = 0;
+
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			BVHNode const& node = nodes[stack[--stackSize]];
+
+			alignas(16) float entries[4];
+			int               mask = IntersectChildren(node, slab, maxDistance, entries);
+			while (mask != 0)
+			{
+				int child = 0;
+				while (((mask >> child) & 1) == 0)
+				{
+					child++;
+				}
+				mask &= mask - 1;
+
+				if (node.counts[child] == 0)
+				{
+					OYL_ASSERT(stackSize < stack_size);
+					stack[stackSize++] = node.children[child];
+					continue;
+				}
+
+				RayHit hit;
+				hit.distance = a_maxDistance;
+				for (uint32 j = node.children[child]; j < node.children[child] + node.counts[child]; j++)
+				{
+					Triangle const& triangle = m_triangles[j];
+					if (IntersectTriangle(triangle.a, triangle.ab, triangle.ac, a_ray, hit))
+					{
+						return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	void
+	TriangleBVH::RaycastPacket(Ray const* a_rays, std::size_t a_count, RayHit* a_hits, float a_maxDistance) const
+	{
+		if (m_tree.NodeCount() == 0)
+		{
+			std::fill(a_hits, a_hits + a_count, RayHit {});
+			return;
+		}
+
+		BVHNode const* nodes      = m_tree.Nodes();
+		uint32 const*  primitives = m_tree.Primitives();
+
+		for (std::size_t first = 0; first < a_count; first += packet_size)
+		{
+			std::size_t lanes = std::min(packet_size, a_count - first);
+
+			// Missing lanes repeat the first ray, their results are dropped
+			alignas(32) float components[9][packet_size];
+			for (std::size_t lane = 0; lane < packet_size; lane++)
+			{
+				Ray const& ray = a_rays[first + (lane < lanes ? lane : 0)];
+				for (int axis = 0; axis < 3; axis++)
+				{
+					components[axis][lane]     = ray.origin.data[axis];
+					components[axis + 3][lane] = ray.direction.data[axis];
+					components[axis + 6][lane] = SafeInverse(ray.direction.data[axis]);
+				}
+			}
+
+			RayPacket packet;
+			for (int axis = 0; axis < 3; axis++)
+			{
+				packet.origin[axis]    = Simd::Load8(components[axis]);
+				packet.direction[axis] = Simd::Load8(components[axis + 3]);
+				packet.inverse[axis]   = Simd::Load8(components[axis + 6]);
+			}
+
+			Simd::Float8 distance = Simd::Splat8(a_maxDistance);
+			Simd::Float8 u        = Simd::Zero8();
+			Simd::Float8 v        = Simd::Zero8();
+			Simd::Int8   hits     = Simd::SplatInt8(static_cast<int32>(BVH::no_hit));
+
+			uint32      stack[stack_size];
+			std::size_t stackSize = 0;
+
+			stack[stackSize++] = 0;
+			while (stackSize > 0)
+			{
+				BVHNode const& node = nodes[stack[--stackSize]];
+				for (int child = 3; child >= 0; child--)
+				{
+					if (node.children[child] == BVHNode::no_child || IntersectChild(node, child, packet, distance) == 0)
+					{
+						continue;
+					}
+
+					if (node.counts[child] == 0)
+					{
+						OYL_ASSERT(stackSize < stack_size);
+						stack[stackSize++] = node.children[child];
+						continue;
+					}
+
+					for (uint32 j = node.children[child]; j < node.children[child] + node.counts[child]; j++)
+					{
+						Triangle const& triangle = m_triangles[j];
+						IntersectTriangle(triangle.a, triangle.ab, triangle.ac, j, packet, distance, u, v, hits);
+					}
+				}
+			}
+
+			alignas(32) float distances[packet_size], us[packet_size], vs[packet_size];
+			alignas(32) int32 leaves[packet_size];
+			Simd::Store(distances, distance);
+			Simd::Store(us, u);
+			Simd::Store(vs, v);
+			Simd::Store(leaves, hits);
+
+			for (std::size_t lane = 0; lane < lanes; lane++)
+			{
+				RayHit& hit = a_hits[first + lane];
+				hit = RayHit {};
+				if (static_cast<uint32>(leaves[lane]) != BVH::no_hit)
+				{
+					hit.distance  = distances[lane];
+					hit.primitive = primitives[leaves[lane]];
+					hit.u         = us[lane];
+					hit.v         = vs[lane];
+				}
+			}
+		}
+	}
+
+	RayHit
+	TriangleBVH::Spherecast(Sphere const& a_sphere, Vector3 const& a_direction, float a_maxDistance) const
+	{
+		RayHit result;
+		float  length = Vector::Magnitude(a_direction);
+		if (m_tree.NodeCount() == 0 || length == 0)
+		{
+			return result;
+		}
+
+		// The capsule test wants a unit direction, distances are scaled back at the end
+		Vector3 const  direction  = a_direction / length;
+		BVHNode const* nodes      = m_tree.Nodes();
+		uint32 const*  primitives = m_tree.Primitives();
+		SlabRay const  slab       = MakeSlabRay(a_sphere.center, direction, Vector3(a_sphere.radius, a_sphere.radius, a_sphere.radius));
+
+		float best = a_maxDistance * length;
+
+		uint32      stack[stack_size];
+		std::size_t stackSize = 0;
+
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			BVHNode const& node = nodes[stack[--stackSize]];
+
+			alignas(16) float entries[4];
+			int               mask = IntersectChildren(node, slab, Simd::Splat(best), entries);
+			while (mask != 0)
+			{
+				int child = 0;
+				while (((mask >> child) & 1) == 0)
+				{
+					child++;
+				}
+				mask &= mask - 1;
+
+				if (node.counts[child] == 0)
+				{
+					OYL_ASSERT(stackSize < stack_size);
+					stack[stackSize++] = node.children[child];
+					continue;
+				}
+
+				for (uint32 j = node.children[child]; j < node.children[child] + node.counts[child]; j++)
+				{
+					Triangle const& triangle = m_triangles[j];
+
+					float distance = SpherecastTriangle(a_sphere.center, a_sphere.radius, direction, triangle.a, triangle.ab, triangle.ac);
+					if (distance < best)
+					{
+						best             = distance;
+						result.primitive = primitives[j];
+					}
+				}
+			}
+		}
+
+		if (result.primitive != BVH::no_hit)
+		{
+			result.distance = best / length;
+		}
+		return result;
+	}
+#pragma endregion
+}
@@ -0,0 +1,281 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "Bounds.h"
+#include "Vector3.h"
+
+#include "Core/Common.h"
+#include "Core/Types/AlignedAllocator.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	class WorkerPool;
+
+	/// Binned surface area heuristic parameters of BVH::Build
+	struct BVHSettings
+	{
+		/// Candidate split planes per axis are the borders between bins, more bins find better splits more slowly
+		uint32 binCount = 16;
+
+		/// Leaves hold at most this many primitives, ranges this small or smaller may still be split if that is cheaper
+		uint32 maxLeafSize = 4;
+
+		/// Cost of visiting a node relative to intersecting one primitive
+		float traversalCost = 1.0f;
+	};
+
+	/**
+	 * \brief A node of four children, their boxes stored as structure of arrays to be tested by one SIMD slab test
+	 * \remarks bounds[0 to 2] are the minimum and bounds[3 to 5] the maximum x, y and z of each child.
+	 *          A child with count 0 is the node at index child, or unused when child is BVHNode::no_child. A child
+	 *          with a count is a leaf of the primitives [child, child + count) of BVH::Primitives().
+	 *      <br>Children always have a larger index than their parent, nodes are stored depth first.
+	 */
+	struct alignas(64) BVHNode
+	{
+		constexpr static uint32 no_child = ~0u;
+
+		float  bounds[6][4];
+		uint32 children[4];
+		uint32 counts[4];
+	};
+
+	/// Closest hit of a ray or shape cast, primitive is ~0u (BVH::no_hit) when nothing was hit
+	struct RayHit
+	{
+		float  distance  = std::numeric_limits<float>::infinity();
+		uint32 primitive = ~0u;
+		/// Barycentric coordinates of the hit on the triangle, weights of its second and third vertex
+		float u = 0;
+		float v = 0;
+	};
+
+	/**
+	 * \brief Bounding volume hierarchy over a set of boxes, built with the binned surface area heuristic
+	 * \remarks The tree has four children per node, laid out depth first in one array so traversal reads nodes
+	 *          mostly in order. Queries are const and safe to run from many threads at once.
+	 *      <br>The build can be spread over a WorkerPool, or over another job system with BeginBuild. Moving
+	 *          primitives only need Refit, which keeps the tree and recomputes the boxes, rebuild when the tree gets
+	 *          too loose after large movements.
+	 */
+	class OYL_CORE_API BVH
+	{
+	public:
+		constexpr static uint32 no_hit = ~0u;
+
+		/// \brief Builds the tree over a_count boxes, the whole build on the calling thread
+		void
+		Build(AABB const* a_boxes, std::size_t a_count, BVHSettings const& a_settings = {});
+
+		/// \brief Build with the subtrees split between the threads of a_pool, see BeginBuild
+		void
+		Build(AABB const* a_boxes, std::size_t a_count, WorkerPool& a_pool, BVHSettings const& a_settings = {});
+
+		/**
+		 * \brief Splits the top of the tree into independent subtrees, to be built by BuildTask then EndBuild
+		 * \param a_taskCount How many subtrees to split the top into, about the number of worker threads.
+		 *                    Fewer are made when there are too few primitives to split.
+		 * \return The number of tasks
+		 * \remarks a_boxes must stay valid until EndBuild.
+		 */
+		std::size_t
+		BeginBuild(AABB const* a_boxes, std::size_t a_count, std::size_t a_taskCount, BVHSettings const& a_settings = {});
+
+		/// \brief Builds the subtree of one task, different tasks may run on different threads at the same time
+		void
+		BuildTask(std::size_t a_task);
+
+		/// \brief Joins the subtrees of every task into the final tree, after every BuildTask has returned
+		void
+		EndBuild();
+
+		/**
+		 * \brief Recomputes every node's box bottom up for new boxes of the same primitives, keeping the tree
+		 * \param a_boxes The same number of boxes as the tree was built from, in the same order
+		 */
+		void
+		Refit(AABB const* a_boxes);
+
+		/// \brief Box of everything in the tree, AABB::Empty() when it is empty
+		AABB
+		RootBounds() const;
+
+		/**
+		 * \brief Writes the index of every primitive whose box the ray hits within a_maxDistance, in no particular order
+		 * \param a_hits, a_distances Need room for PrimitiveCount() entries, a_distances is optional and receives the
+		 *                            entry distance of each hit
+		 */
+		std::size_t
+		Raycast(
+			Ray const& a_ray,
+			uint32*    a_hits,
+			float*     a_distances = nullptr,
+			float      a_maxDistance = std::numeric_limits<float>::infinity()
+		) const;
+
+		/// \brief Writes the index of every primitive whose box overlaps a_query, a_hits needs room for PrimitiveCount()
+		std::size_t
+		Overlap(AABB const& a_query, uint32* a_hits) const;
+
+		/**
+		 * \brief Sweeps a_shape along a_direction and writes every primitive whose box it touches within a_maxDistance
+		 * \remarks Distances are in units of a_direction, like a Ray's. The sweep is exact for boxes, callers with
+		 *          other shapes use their bounds and test the candidates themselves.
+		 */
+		std::size_t
+		Shapecast(
+			AABB const&    a_shape,
+			Vector3 const& a_direction,
+			uint32*        a_hits,
+			float*         a_distances = nullptr,
+			float          a_maxDistance = std::numeric_limits<float>::infinity()
+		) const;
+
+		std::size_t PrimitiveCount() const noexcept { return m_primitives.size(); }
+
+		std::size_t NodeCount() const noexcept { return m_nodes.size(); }
+
+		BVHNode const* Nodes() const noexcept { return m_nodes.data(); }
+
+		/// Original index of each primitive in leaf order, leaves refer to ranges of this
+		uint32 const* Primitives() const noexcept { return m_primitives.data(); }
+
+	private:
+		struct BuildNode
+		{
+			AABB bounds;
+			/// Bounds of the sums of each primitive's min and max, twice their centers
+			AABB centers;
+
+			uint32 children[2];
+			uint32 first;
+			uint32 count;
+			/// The root of this task's subtree stands in for this node
+			uint32 task;
+		};
+
+		struct Task
+		{
+			uint32                 first;
+			uint32                 count;
+			std::vector<BuildNode> nodes;
+		};
+
+		std::vector<BVHNode, AlignedAllocator<BVHNode, 64>> m_nodes;
+		std::vector<uint32>                                 m_primitives;
+		/// Box of each primitive in leaf order
+		std::vector<AABB>                                   m_boxes;
+
+		/// A primitive's box padded for aligned SIMD loads
+		struct BuildBox
+		{
+			alignas(16) float min[4];
+			alignas(16) float max[4];
+		};
+
+		// Only while building
+		AABB const*            m_source = nullptr;
+		std::vector<BuildBox>  m_buildBoxes;
+		std::vector<BuildNode> m_top;
+		std::vector<Task>      m_tasks;
+		BVHSettings            m_settings;
+
+		/// \brief A leaf over primitives [a_first, a_first + a_count) in their current order
+		BuildNode
+		MakeNode(uint32 a_first, uint32 a_count) const;
+
+		bool
+		Split(std::vector<BuildNode>& a_nodes, uint32 a_node, bool a_median);
+
+		void
+		BuildSubtree(std::vector<BuildNode>& a_nodes);
+	};
+
+	/**
+	 * \brief A BVH over a triangle soup, three consecutive Vector3s per triangle, with exact ray and sphere casts
+	 * \remarks Keeps its own copy of the triangles in leaf order, so the source can be freed after Build.
+	 *          Hits report the index of the triangle in the source.
+	 */
+	class OYL_CORE_API TriangleBVH
+	{
+	public:
+		void
+		Build(Vector3 const* a_triangles, std::size_t a_count, BVHSettings const& a_settings = {});
+
+		void
+		Build(Vector3 const* a_triangles, std::size_t a_count, WorkerPool& a_pool, BVHSettings const& a_settings = {});
+
+		/// \brief See BVH::BeginBuild, a_triangles must stay valid until EndBuild
+		std::size_t
+		BeginBuild(Vector3 const* a_triangles, std::size_t a_count, std::size_t a_taskCount, BVHSettings const& a_settings = {});
+
+		void
+		BuildTask(std::size_t a_task) { m_tree.BuildTask(a_task); }
+
+		void
+		EndBuild();
+
+		/// \brief Moves the triangles and refits the tree, a_triangles has the same triangles as the build in new places
+		void
+		Refit(Vector3 const* a_triangles);
+
+		/// \brief Closest triangle the ray hits within a_maxDistance, triangles are hit from both sides
+		RayHit
+		Raycast(Ray const& a_ray, float a_maxDistance = std::numeric_limits<float>::infinity()) const;
+
+		/// \brief Whether any triangle is in the way within a_maxDistance, cheaper than Raycast as it stops at the first
+		bool
+		Occluded(Ray const& a_ray, float a_maxDistance = std::numeric_limits<float>::infinity()) const;
+
+		/**
+		 * \brief Raycast for a_count rays, traced eight at a time through the tree together
+		 * \remarks Packets pay off when the rays of each group of eight are coherent, ie. neighbouring pixels or
+		 *          listeners probing the same room. Scattered rays are better off with Raycast.
+		 */
+		void
+		RaycastPacket(
+			Ray const*  a_rays,
+			std::size_t a_count,
+			RayHit*     a_hits,
+			float       a_maxDistance = std::numeric_limits<float>::infinity()
+		) const;
+
+		/**
+		 * \brief First triangle a_sphere touches moving along a_direction, in units of a_direction
+		 * \remarks Spheres that start touching a triangle hit it at distance 0. u and v are left at 0.
+		 */
+		RayHit
+		Spherecast(
+			Sphere const&  a_sphere,
+			Vector3 const& a_direction,
+			float          a_maxDistance = std::numeric_limits<float>::infinity()
+		) const;
+
+		std::size_t TriangleCount() const noexcept { return m_triangles.size(); }
+
+		BVH const& Tree() const noexcept { return m_tree; }
+
+	private:
+		/// A vertex and the edges to the other two, as the ray test wants them
+		struct Triangle
+		{
+			Vector3 a;
+			Vector3 ab;
+			Vector3 ac;
+		};
+
+		BVH                   m_tree;
+		std::vector<Triangle> m_triangles;
+
+		// Only while building
+		std::vector<AABB> m_boxes;
+		Vector3 const*    m_source = nullptr;
+
+		void
+		ComputeBoxes(Vector3 const* a_triangles, std::size_t a_count);
+	};
+}
@@ -0,0 +1,439 @@
+#include "pch.h"
+#include "Bounds.h"
+
+#include "Simd.h"
+
+namespace Oyl::Bounds
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+
+		/// Plane broadcast into one register per coefficient, with the absolute normal for box tests
+		struct PlaneBlock
+		{
+			Simd::Float8 x, y, z, distance;
+			Simd::Float8 absX, absY, absZ;
+		};
+
+		PlaneBlock
+		LoadPlane(Plane const& a_plane)
+		{
+			return PlaneBlock {
+				Simd::Splat8(a_plane.normal.x),
+				Simd::Splat8(a_plane.normal.y),
+				Simd::Splat8(a_plane.normal.z),
+				Simd::Splat8(a_plane.distance),
+				Simd::Splat8(std::abs(a_plane.normal.x)),
+				Simd::Splat8(std::abs(a_plane.normal.y)),
+				Simd::Splat8(std::abs(a_plane.normal.z)),
+			};
+		}
+
+		Simd::Float8
+		SignedDistance(PlaneBlock const& a_plane, Simd::Float8 a_x, Simd::Float8 a_y, Simd::Float8 a_z)
+		{
+			return Simd::MulAdd(a_z, a_plane.z, Simd::MulAdd(a_y, a_plane.y, Simd::MulAdd(a_x, a_plane.x, a_plane.distance)));
+		}
+
+		/**
+		 * \brief Appends a_base + lane for every set bit of a_mask below a_valid
+		 * \remark Writes unconditionally and only advances on set bits, so there is no branch per lane
+		 */
+		std::size_t
+		AppendIndices(int a_mask, std::size_t a_base, std::size_t a_valid, uint32* a_out)
+		{
+			std::size_t count = 0;
+			for (std::size_t lane = 0; lane < a_valid; lane++)
+			{
+				a_out[count] = static_cast<uint32>(a_base + lane);
+				count += (a_mask >> lane) & 1;
+			}
+			return count;
+		}
+	}
+
+#pragma region Construction
+	AABB
+	FromPoints(Vector3 const* a_points, std::size_t a_count)
+	{
+		AABB result = AABB::Empty();
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			result = Merge(result, a_points[i]);
+		}
+		return result;
+	}
+
+	// Arvo, "Transforming Axis-Aligned Bounding Boxes", Graphics Gems
+	AABB
+	Transform(AABB const& a_box, Matrix4 const& a_transform)
+	{
+		if (a_box.IsEmpty())
+		{
+			return a_box;
+		}
+
+		Vector3 center  = Vector3(Vector4(a_box.Center(), 1.0f) * a_transform);
+		Vector3 extents = a_box.Extents();
+
+		Vector3 newExtents;
+		for (int i = 0; i < 3; i++)
+		{
+			newExtents = newExtents + Vector::Abs(Vector3(a_transform.cols[i])) * extents.data[i];
+		}
+
+		return FromCenterExtents(center, newExtents);
+	}
+
+	OBB
+	Transform(OBB const& a_box, Matrix4 const& a_transform)
+	{
+		Matrix3 linear = Matrix3(
+			Vector3(a_transform.cols[0]),
+			Vector3(a_transform.cols[1]),
+			Vector3(a_transform.cols[2])
+		);
+
+		OBB result;
+		result.center = Vector3(Vector4(a_box.center, 1.0f) * a_transform);
+		for (int i = 0; i < 3; i++)
+		{
+			// Scale ends up in the length of each transformed axis, move it into the extents
+			Vector3 axis  = a_box.axes.cols[i] * linear;
+			float   scale = Vector::Magnitude(axis);
+
+			result.axes.cols[i]    = scale == 0 ? axis : axis / scale;
+			result.extents.data[i] = a_box.extents.data[i] * scale;
+		}
+		return result;
+	}
+
+	Frustum
+	ExtractFrustum(Matrix4 const& a_viewProjection)
+	{
+		// Row vectors, so clip space component j of a point is its dot product with column j of the matrix
+		auto column = [&a_viewProjection](int a_index)
+		{
+			return Vector4(
+				a_viewProjection.cols[0].data[a_index],
+				a_viewProjection.cols[1].data[a_index],
+				a_viewProjection.cols[2].data[a_index],
+				a_viewProjection.cols[3].data[a_index]
+			);
+		};
+
+		Vector4 x = column(0);
+		Vector4 y = column(1);
+		Vector4 z = column(2);
+		Vector4 w = column(3);
+
+		auto toPlane = [](Vector4 a_coefficients)
+		{
+			return Normalize(Plane { Vector3(a_coefficients), a_coefficients.w });
+		};
+
+		Frustum result;
+		result.planes[Frustum::Left]   = toPlane(w + x);
+		result.planes[Frustum::Right]  = toPlane(w - x);
+		result.planes[Frustum::Bottom] = toPlane(w + y);
+		result.planes[Frustum::Top]    = toPlane(w - y);
+		result.planes[Frustum::Near]   = toPlane(z);
+		result.planes[Frustum::Far]    = toPlane(w - z);
+		return result;
+	}
+#pragma endregion
+#pragma region Queries
+	// Ericson, "Real-Time Collision Detection", 4.4.1
+	bool
+	Overlaps(OBB const& a_lhs, OBB const& a_rhs)
+	{
+		// Absorbs the error in near parallel edge pairs, whose cross product is close to zero
+		constexpr float epsilon = 1e-6f;
+
+		float rotation[3][3];
+		float absRotation[3][3];
+		for (int i = 0; i < 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				rotation[i][j]    = Vector::Dot(a_lhs.axes.cols[i], a_rhs.axes.cols[j]);
+				absRotation[i][j] = std::abs(rotation[i][j]) + epsilon;
+			}
+		}
+
+		// Offset between the centers in a_lhs's frame
+		Vector3 offset = a_rhs.center - a_lhs.center;
+		float   t[3];
+		for (int i = 0; i < 3; i++)
+		{
+			t[i] = Vector::Dot(offset, a_lhs.axes.cols[i]);
+		}
+
+		Vector3 const& a = a_lhs.extents;
+		Vector3 const& b = a_rhs.extents;
+
+		// a_lhs's axes
+		for (int i = 0; i < 3; i++)
+		{
+			float radiusB = b.data[0] * absRotation[i][0] + b.data[1] * absRotation[i][1] + b.data[2] * absRotation[i][2];
+			if (std::abs(t[i]) > a.data[i] + radiusB)
+			{
+				return false;
+			}
+		}
+
+		// a_rhs's axes
+		for (int j = 0; j < 3; j++)
+		{
+			float radiusA = a.data[0] * absRotation[0][j] + a.data[1] * absRotation[1][j] + a.data[2] * absRotation[2][j];
+			float distance = t[0] * rotation[0][j] + t[1] * rotation[1][j] + t[2] * rotation[2][j];
+			if (std::abs(distance) > radiusA + b.data[j])
+			{
+				return false;
+			}
+		}
+
+		// Cross products of each pair of axes
+		for (int i = 0; i < 3; i++)
+		{
+			int i1 = (i + 1) % 3;
+			int i2 = (i + 2) % 3;
+			for (int j = 0; j < 3; j++)
+			{
+				int j1 = (j + 1) % 3;
+				int j2 = (j + 2) % 3;
+
+				float radiusA  = a.data[i1] * absRotation[i2][j] + a.data[i2] * absRotation[i1][j];
+				float radiusB  = b.data[j1] * absRotation[i][j2] + b.data[j2] * absRotation[i][j1];
+				float distance = t[i2] * rotation[i1][j] - t[i1] * rotation[i2][j];
+				if (std::abs(distance) > radiusA + radiusB)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool
+	Raycast(Ray const& a_ray, AABB const& a_box, float& a_distance, float a_maxDistance)
+	{
+		float entry = 0;
+		float exit  = a_maxDistance;
+		for (int i = 0; i < 3; i++)
+		{
+			float inverseDirection = 1.0f / a_ray.direction.data[i];
+			float t0 = (a_box.min.data[i] - a_ray.origin.data[i]) * inverseDirection;
+			float t1 = (a_box.max.data[i] - a_ray.origin.data[i]) * inverseDirection;
+
+			entry = std::max(entry, std::min(t0, t1));
+			exit  = std::min(exit, std::max(t0, t1));
+		}
+
+		if (entry > exit)
+		{
+			return false;
+		}
+		a_distance = entry;
+		return true;
+	}
+
+	bool
+	Raycast(Ray const& a_ray, Sphere const& a_sphere, float& a_distance, float a_maxDistance)
+	{
+		Vector3 offset = a_ray.origin - a_sphere.center;
+
+		float a = Vector::Dot(a_ray.direction, a_ray.direction);
+		float b = Vector::Dot(offset, a_ray.direction);
+		float c = Vector::Dot(offset, offset) - a_sphere.radius * a_sphere.radius;
+
+		// Starting outside and pointing away
+		if (c > 0 && b > 0)
+		{
+			return false;
+		}
+
+		float discriminant = b * b - a * c;
+		if (discriminant < 0 || a == 0)
+		{
+			return false;
+		}
+
+		float distance = std::max((-b - std::sqrt(discriminant)) / a, 0.0f);
+		if (distance > a_maxDistance)
+		{
+			return false;
+		}
+		a_distance = distance;
+		return true;
+	}
+
+	bool
+	Raycast(Ray const& a_ray, Plane const& a_plane, float& a_distance, float a_maxDistance)
+	{
+		float denominator = Vector::Dot(a_plane.normal, a_ray.direction);
+		if (denominator == 0)
+		{
+			return false;
+		}
+
+		float distance = -SignedDistance(a_plane, a_ray.origin) / denominator;
+		if (distance < 0 || distance > a_maxDistance)
+		{
+			return false;
+		}
+		a_distance = distance;
+		return true;
+	}
+#pragma endregion
+#pragma region Batched Queries
+	std::size_t
+	Cull(Frustum const& a_frustum, AABBStream const& a_boxes, uint32* a_visible)
+	{
+		PlaneBlock planes[Frustum::side_count];
+		for (int i = 0; i < Frustum::side_count; i++)
+		{
+			planes[i] = LoadPlane(a_frustum.planes[i]);
+		}
+
+		Vector3Stream const& min  = a_boxes.Min();
+		Vector3Stream const& max  = a_boxes.Max();
+		Simd::Float8         half = Simd::Splat8(0.5f);
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < a_boxes.Count(); i += block_size)
+		{
+			Simd::Float8 minX = Simd::Load8(min.X() + i), maxX = Simd::Load8(max.X() + i);
+			Simd::Float8 minY = Simd::Load8(min.Y() + i), maxY = Simd::Load8(max.Y() + i);
+			Simd::Float8 minZ = Simd::Load8(min.Z() + i), maxZ = Simd::Load8(max.Z() + i);
+
+			Simd::Float8 centerX  = Simd::Mul(Simd::Add(minX, maxX), half);
+			Simd::Float8 centerY  = Simd::Mul(Simd::Add(minY, maxY), half);
+			Simd::Float8 centerZ  = Simd::Mul(Simd::Add(minZ, maxZ), half);
+			Simd::Float8 extentsX = Simd::Mul(Simd::Sub(maxX, minX), half);
+			Simd::Float8 extentsY = Simd::Mul(Simd::Sub(maxY, minY), half);
+			Simd::Float8 extentsZ = Simd::Mul(Simd::Sub(maxZ, minZ), half);
+
+			Simd::Float8 outside = Simd::Zero8();
+			for (PlaneBlock const& plane : planes)
+			{
+				// Distance to the corner furthest along the plane normal
+				Simd::Float8 radius   = Simd::MulAdd(extentsZ, plane.absZ, Simd::MulAdd(extentsY, plane.absY, Simd::Mul(extentsX, plane.absX)));
+				Simd::Float8 distance = Simd::Add(SignedDistance(plane, centerX, centerY, centerZ), radius);
+				outside = Simd::Or(outside, Simd::Less(distance, Simd::Zero8()));
+			}
+
+			int visible = ~Simd::MoveMask(outside);
+			count += AppendIndices(visible, i, std::min(block_size, a_boxes.Count() - i), a_visible + count);
+		}
+		return count;
+	}
+
+	std::size_t
+	Cull(Frustum const& a_frustum, SphereStream const& a_spheres, uint32* a_visible)
+	{
+		PlaneBlock planes[Frustum::side_count];
+		for (int i = 0; i < Frustum::side_count; i++)
+		{
+			planes[i] = LoadPlane(a_frustum.planes[i]);
+		}
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < a_spheres.Count(); i += block_size)
+		{
+			Simd::Float8 x      = Simd::Load8(a_spheres.X() + i);
+			Simd::Float8 y      = Simd::Load8(a_spheres.Y() + i);
+			Simd::Float8 z      = Simd::Load8(a_spheres.Z() + i);
+			Simd::Float8 radius = Simd::Load8(a_spheres.Radius() + i);
+
+			Simd::Float8 outside = Simd::Zero8();
+			for (PlaneBlock const& plane : planes)
+			{
+				Simd::Float8 distance = Simd::Add(SignedDistance(plane, x, y, z), radius);
+				outside = Simd::Or(outside, Simd::Less(distance, Simd::Zero8()));
+			}
+
+			int visible = ~Simd::MoveMask(outside);
+			count += AppendIndices(visible, i, std::min(block_size, a_spheres.Count() - i), a_visible + count);
+		}
+		return count;
+	}
+
+	std::size_t
+	Overlap(AABB const& a_query, AABBStream const& a_boxes, uint32* a_hits)
+	{
+		Simd::Float8 queryMinX = Simd::Splat8(a_query.min.x), queryMaxX = Simd::Splat8(a_query.max.x);
+		Simd::Float8 queryMinY = Simd::Splat8(a_query.min.y), queryMaxY = Simd::Splat8(a_query.max.y);
+		Simd::Float8 queryMinZ = Simd::Splat8(a_query.min.z), queryMaxZ = Simd::Splat8(a_query.max.z);
+
+		Vector3Stream const& min = a_boxes.Min();
+		Vector3Stream const& max = a_boxes.Max();
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < a_boxes.Count(); i += block_size)
+		{
+			Simd::Float8 overlapX = Simd::And(Simd::LessEqual(Simd::Load8(min.X() + i), queryMaxX), Simd::LessEqual(queryMinX, Simd::Load8(max.X() + i)));
+			Simd::Float8 overlapY = Simd::And(Simd::LessEqual(Simd::Load8(min.Y() + i), queryMaxY), Simd::LessEqual(queryMinY, Simd::Load8(max.Y() + i)));
+			Simd::Float8 overlapZ = Simd::And(Simd::LessEqual(Simd::Load8(min.Z() + i), queryMaxZ), Simd::LessEqual(queryMinZ, Simd::Load8(max.Z() + i)));
+
+			int overlapping = Simd::MoveMask(Simd::And(overlapX, Simd::And(overlapY, overlapZ)));
+			count += AppendIndices(overlapping, i, std::min(block_size, a_boxes.Count() - i), a_hits + count);
+		}
+		return count;
+	}
+
+	std::size_t
+	Raycast(Ray const& a_ray, AABBStream const& a_boxes, uint32* a_hits, float* a_distances, float a_maxDistance)
+	{
+		Simd::Float8 originX = Simd::Splat8(a_ray.origin.x);
+		Simd::Float8 originY = Simd::Splat8(a_ray.origin.y);
+		Simd::Float8 originZ = Simd::Splat8(a_ray.origin.z);
+
+		Simd::Float8 inverseX = Simd::Splat8(1.0f / a_ray.direction.x);
+		Simd::Float8 inverseY = Simd::Splat8(1.0f / a_ray.direction.y);
+		Simd::Float8 inverseZ = Simd::Splat8(1.0f / a_ray.direction.z);
+
+		Simd::Float8 maxDistance = Simd::Splat8(a_maxDistance);
+
+		Vector3Stream const& min = a_boxes.Min();
+		Vector3Stream const& max = a_boxes.Max();
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < a_boxes.Count(); i += block_size)
+		{
+			Simd::Float8 entry = Simd::Zero8();
+			Simd::Float8 exit  = maxDistance;
+
+			auto slab = [&](Simd::Float8 a_min, Simd::Float8 a_max, Simd::Float8 a_origin, Simd::Float8 a_inverse)
+			{
+				Simd::Float8 t0 = Simd::Mul(Simd::Sub(a_min, a_origin), a_inverse);
+				Simd::Float8 t1 = Simd::Mul(Simd::Sub(a_max, a_origin), a_inverse);
+				entry = Simd::Max(entry, Simd::Min(t0, t1));
+				exit  = Simd::Min(exit, Simd::Max(t0, t1));
+			};
+			slab(Simd::Load8(min.X() + i), Simd::Load8(max.X() + i), originX, inverseX);
+			slab(Simd::Load8(min.Y() + i), Simd::Load8(max.Y() + i), originY, inverseY);
+			slab(Simd::Load8(min.Z() + i), Simd::Load8(max.Z() + i), originZ, inverseZ);
+
+			int         hits  = Simd::MoveMask(Simd::LessEqual(entry, exit));
+			std::size_t valid = std::min(block_size, a_boxes.Count() - i);
+			if (a_distances)
+			{
+				alignas(32) float distances[block_size];
+				Simd::Store(distances, entry);
+
+				std::size_t written = 0;
+				for (std::size_t lane = 0; lane < valid; lane++)
+				{
+					a_distances[count + written] = distances[lane];
+					written += (hits >> lane) & 1;
+				}
+			}
+			count += AppendIndices(hits, i, valid, a_hits + count);
+		}
+		return count;
+	}
+#pragma endregion
+}
@@ -0,0 +1,511 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/// Axis aligned bounding box, empty when any component of min is greater than the same component of max
+	struct AABB
+	{
+		Vector3 min;
+		Vector3 max;
+
+		constexpr Vector3 Center() const { return (min + max) * 0.5f; }
+
+		/// \return The half size of the box along each axis
+		constexpr Vector3 Extents() const { return (max - min) * 0.5f; }
+
+		constexpr Vector3 Size() const { return max - min; }
+
+		constexpr bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+		/// \return A box that contains nothing and becomes exactly the first point or box merged into it
+		constexpr
+		static
+		AABB
+		Empty()
+		{
+			constexpr float infinity = std::numeric_limits<float>::infinity();
+			return AABB { Vector3(infinity, infinity, infinity), Vector3(-infinity, -infinity, -infinity) };
+		}
+	};
+
+	struct Sphere
+	{
+		Vector3 center;
+		float   radius = 0;
+	};
+
+	/// Oriented bounding box, the rows of axes are the box's local x, y and z axes in world space
+	struct OBB
+	{
+		Vector3 center;
+		Vector3 extents;
+		Matrix3 axes = Matrix3::Identity();
+	};
+
+	/// The set of points p where Dot(normal, p) + distance == 0, normal points towards the positive half space
+	struct Plane
+	{
+		Vector3 normal;
+		float   distance = 0;
+	};
+
+	/// Half line starting at origin, direction does not need to be normalized but distances are measured in units of it
+	struct Ray
+	{
+		Vector3 origin;
+		Vector3 direction;
+	};
+
+	/// Six inward facing planes, a point is inside when it is on the positive side of all of them
+	struct Frustum
+	{
+		enum Side
+		{
+			Left,
+			Right,
+			Bottom,
+			Top,
+			Near,
+			Far,
+
+			side_count
+		};
+
+		Plane planes[side_count];
+	};
+
+	/**
+	 * \brief Structure of arrays storage for boxes tested in bulk, see Bounds::Cull and Bounds::Overlap
+	 */
+	class AABBStream
+	{
+	public:
+		AABBStream() = default;
+
+		explicit
+		AABBStream(std::size_t a_count)
+			: m_min(a_count),
+			  m_max(a_count) {}
+
+		AABBStream(AABB const* a_src, std::size_t a_count)
+		{
+			Assign(a_src, a_count);
+		}
+
+		std::size_t Count() const noexcept { return m_min.Count(); }
+
+		bool Empty() const noexcept { return m_min.Empty(); }
+
+		void
+		Resize(std::size_t a_count)
+		{
+			m_min.Resize(a_count);
+			m_max.Resize(a_count);
+		}
+
+		void
+		Reserve(std::size_t a_count)
+		{
+			m_min.Reserve(a_count);
+			m_max.Reserve(a_count);
+		}
+
+		void
+		Clear() noexcept
+		{
+			m_min.Clear();
+			m_max.Clear();
+		}
+
+		void
+		PushBack(AABB const& a_value)
+		{
+			m_min.PushBack(a_value.min);
+			m_max.PushBack(a_value.max);
+		}
+
+		void
+		Assign(AABB const* a_src, std::size_t a_count)
+		{
+			Resize(a_count);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				Set(i, a_src[i]);
+			}
+		}
+
+		AABB Get(std::size_t a_index) const { return AABB { m_min.Get(a_index), m_max.Get(a_index) }; }
+
+		void
+		Set(std::size_t a_index, AABB const& a_value)
+		{
+			m_min.Set(a_index, a_value.min);
+			m_max.Set(a_index, a_value.max);
+		}
+
+		Vector3Stream&       Min() noexcept { return m_min; }
+		Vector3Stream const& Min() const noexcept { return m_min; }
+
+		Vector3Stream&       Max() noexcept { return m_max; }
+		Vector3Stream const& Max() const noexcept { return m_max; }
+
+	private:
+		Vector3Stream m_min;
+		Vector3Stream m_max;
+	};
+
+	/**
+	 * \brief Structure of arrays storage for spheres tested in bulk, see Bounds::Cull
+	 * \remark Spheres are kept in a single Vector4Stream with the radius in w, so one stream walk loads everything
+	 */
+	class SphereStream
+	{
+	public:
+		SphereStream() = default;
+
+		explicit
+		SphereStream(std::size_t a_count)
+			: m_spheres(a_count) {}
+
+		SphereStream(Sphere const* a_src, std::size_t a_count)
+		{
+			Assign(a_src, a_count);
+		}
+
+		std::size_t Count() const noexcept { return m_spheres.Count(); }
+
+		bool Empty() const noexcept { return m_spheres.Empty(); }
+
+		void Resize(std::size_t a_count) { m_spheres.Resize(a_count); }
+
+		void Reserve(std::size_t a_count) { m_spheres.Reserve(a_count); }
+
+		void Clear() noexcept { m_spheres.Clear(); }
+
+		void PushBack(Sphere const& a_value) { m_spheres.PushBack(Vector4(a_value.center, a_value.radius)); }
+
+		void
+		Assign(Sphere const* a_src, std::size_t a_count)
+		{
+			Resize(a_count);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				Set(i, a_src[i]);
+			}
+		}
+
+		Sphere
+		Get(std::size_t a_index) const
+		{
+			Vector4 value = m_spheres.Get(a_index);
+			return Sphere { Vector3(value), value.w };
+		}
+
+		void Set(std::size_t a_index, Sphere const& a_value) { m_spheres.Set(a_index, Vector4(a_value.center, a_value.radius)); }
+
+		float const* X() const noexcept { return m_spheres.X(); }
+		float const* Y() const noexcept { return m_spheres.Y(); }
+		float const* Z() const noexcept { return m_spheres.Z(); }
+
+		float const* Radius() const noexcept { return m_spheres.W(); }
+
+		Vector4Stream&       Data() noexcept { return m_spheres; }
+		Vector4Stream const& Data() const noexcept { return m_spheres; }
+
+	private:
+		Vector4Stream m_spheres;
+	};
+}
+
+namespace Oyl::Bounds
+{
+#pragma region Construction
+	inline
+	constexpr
+	AABB
+	Merge(AABB const& a_lhs, AABB const& a_rhs)
+	{
+		return AABB { Vector::Min(a_lhs.min, a_rhs.min), Vector::Max(a_lhs.max, a_rhs.max) };
+	}
+
+	inline
+	constexpr
+	AABB
+	Merge(AABB const& a_box, Vector3 const& a_point)
+	{
+		return AABB { Vector::Min(a_box.min, a_point), Vector::Max(a_box.max, a_point) };
+	}
+
+	inline
+	constexpr
+	AABB
+	FromCenterExtents(Vector3 const& a_center, Vector3 const& a_extents)
+	{
+		return AABB { a_center - a_extents, a_center + a_extents };
+	}
+
+	/// \return The smallest box containing every point, or AABB::Empty() if a_count is 0
+	OYL_CORE_API
+	extern
+	AABB
+	FromPoints(Vector3 const* a_points, std::size_t a_count);
+
+	/// \return The smallest axis aligned box containing a_box after it is transformed by a_transform
+	OYL_CORE_API
+	extern
+	AABB
+	Transform(AABB const& a_box, Matrix4 const& a_transform);
+
+	/// \return The sphere circumscribing a_box
+	inline
+	Sphere
+	BoundingSphere(AABB const& a_box)
+	{
+		return Sphere { a_box.Center(), Vector::Magnitude(a_box.Extents()) };
+	}
+
+	/// \return a_box transformed by a_transform, which may contain rotation and non-uniform scale but no shear
+	OYL_CORE_API
+	extern
+	OBB
+	Transform(OBB const& a_box, Matrix4 const& a_transform);
+
+	/// \return The plane through a_point facing along a_normal, a_normal must be normalized
+	inline
+	constexpr
+	Plane
+	PlaneFromNormal(Vector3 const& a_normal, Vector3 const& a_point)
+	{
+		return Plane { a_normal, -Vector::Dot(a_normal, a_point) };
+	}
+
+	/// \return The plane through the three points, with its normal along Cross(a_b - a_a, a_c - a_a)
+	inline
+	Plane
+	PlaneFromPoints(Vector3 const& a_a, Vector3 const& a_b, Vector3 const& a_c)
+	{
+		return PlaneFromNormal(Vector::Normalize(Vector::Cross(a_b - a_a, a_c - a_a)), a_a);
+	}
+
+	/// \return a_plane scaled so its normal has unit length
+	inline
+	Plane
+	Normalize(Plane const& a_plane)
+	{
+		float magnitude = Vector::Magnitude(a_plane.normal);
+		if (magnitude == 0)
+		{
+			return a_plane;
+		}
+		return Plane { a_plane.normal / magnitude, a_plane.distance / magnitude };
+	}
+
+	/**
+	 * \brief Extracts the view frustum of a view-projection matrix (Gribb and Hartmann)
+	 * \param a_viewProjection The view matrix multiplied by the projection, ie.
+	 *                         Matrix::ViewInverse(Matrix::LookAt(...)) * Matrix::Perspective(...)
+	 * \remark Expects the engine's clip space, with depth in [0, 1] as produced by Matrix::Perspective.
+	 *         The planes are normalized so SignedDistance returns distances in world units.
+	 */
+	OYL_CORE_API
+	extern
+	Frustum
+	ExtractFrustum(Matrix4 const& a_viewProjection);
+#pragma endregion
+#pragma region Queries
+	inline
+	constexpr
+	float
+	SignedDistance(Plane const& a_plane, Vector3 const& a_point)
+	{
+		return Vector::Dot(a_plane.normal, a_point) + a_plane.distance;
+	}
+
+	inline
+	constexpr
+	bool
+	Contains(AABB const& a_box, Vector3 const& a_point)
+	{
+		return a_point.x >= a_box.min.x && a_point.x <= a_box.max.x &&
+		       a_point.y >= a_box.min.y && a_point.y <= a_box.max.y &&
+		       a_point.z >= a_box.min.z && a_point.z <= a_box.max.z;
+	}
+
+	/// \return Whether a_outer fully contains a_inner
+	inline
+	constexpr
+	bool
+	Contains(AABB const& a_outer, AABB const& a_inner)
+	{
+		return a_inner.min.x >= a_outer.min.x && a_inner.max.x <= a_outer.max.x &&
+		       a_inner.min.y >= a_outer.min.y && a_inner.max.y <= a_outer.max.y &&
+		       a_inner.min.z >= a_outer.min.z && a_inner.max.z <= a_outer.max.z;
+	}
+
+	inline
+	constexpr
+	bool
+	Overlaps(AABB const& a_lhs, AABB const& a_rhs)
+	{
+		return a_lhs.min.x <= a_rhs.max.x && a_lhs.max.x >= a_rhs.min.x &&
+		       a_lhs.min.y <= a_rhs.max.y && a_lhs.max.y >= a_rhs.min.y &&
+		       a_lhs.min.z <= a_rhs.max.z && a_lhs.max.z >= a_rhs.min.z;
+	}
+
+	inline
+	constexpr
+	bool
+	Overlaps(Sphere const& a_lhs, Sphere const& a_rhs)
+	{
+		Vector3 offset = a_rhs.center - a_lhs.center;
+		float   radius = a_lhs.radius + a_rhs.radius;
+		return Vector::Dot(offset, offset) <= radius * radius;
+	}
+
+	inline
+	constexpr
+	bool
+	Overlaps(AABB const& a_box, Sphere const& a_sphere)
+	{
+		Vector3 closest = Vector::Min(Vector::Max(a_sphere.center, a_box.min), a_box.max);
+		Vector3 offset  = a_sphere.center - closest;
+		return Vector::Dot(offset, offset) <= a_sphere.radius * a_sphere.radius;
+	}
+
+	/// \brief Separating axis test over the 15 candidate axes of two boxes
+	OYL_CORE_API
+	extern
+	bool
+	Overlaps(OBB const& a_lhs, OBB const& a_rhs);
+
+	/// \return False only if a_box is entirely outside a_frustum. Boxes near a corner may be reported as intersecting.
+	inline
+	bool
+	Intersects(Frustum const& a_frustum, AABB const& a_box)
+	{
+		Vector3 center  = a_box.Center();
+		Vector3 extents = a_box.Extents();
+		for (Plane const& plane : a_frustum.planes)
+		{
+			if (SignedDistance(plane, center) + Vector::Dot(Vector::Abs(plane.normal), extents) < 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// \return False only if a_sphere is entirely outside a_frustum. Spheres near a corner may be reported as intersecting.
+	inline
+	bool
+	Intersects(Frustum const& a_frustum, Sphere const& a_sphere)
+	{
+		for (Plane const& plane : a_frustum.planes)
+		{
+			if (SignedDistance(plane, a_sphere.center) < -a_sphere.radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// \return False only if a_box is entirely outside a_frustum. Boxes near a corner may be reported as intersecting.
+	inline
+	bool
+	Intersects(Frustum const& a_frustum, OBB const& a_box)
+	{
+		for (Plane const& plane : a_frustum.planes)
+		{
+			// Project the box onto the plane normal in the box's local space
+			Vector3 localNormal = Vector3(
+				Vector::Dot(plane.normal, a_box.axes.cols[0]),
+				Vector::Dot(plane.normal, a_box.axes.cols[1]),
+				Vector::Dot(plane.normal, a_box.axes.cols[2])
+			);
+			if (SignedDistance(plane, a_box.center) + Vector::Dot(Vector::Abs(localNormal), a_box.extents) < 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * \brief Slab test between a ray and a box
+	 * \param a_distance Set to the distance along the ray at which it enters the box, or 0 if it starts inside
+	 * \return Whether the ray hits the box within a_maxDistance
+	 */
+	OYL_CORE_API
+	extern
+	bool
+	Raycast(Ray const& a_ray, AABB const& a_box, float& a_distance, float a_maxDistance = std::numeric_limits<float>::infinity());
+
+	/**
+	 * \param a_distance Set to the distance along the ray at which it enters the sphere, or 0 if it starts inside
+	 * \return Whether the ray hits the sphere within a_maxDistance
+	 */
+	OYL_CORE_API
+	extern
+	bool
+	Raycast(Ray const& a_ray, Sphere const& a_sphere, float& a_distance, float a_maxDistance = std::numeric_limits<float>::infinity());
+
+	/**
+	 * \param a_distance Set to the distance along the ray at which it crosses the plane
+	 * \return Whether the ray crosses the plane within a_maxDistance, rays parallel to the plane never do
+	 */
+	OYL_CORE_API
+	extern
+	bool
+	Raycast(Ray const& a_ray, Plane const& a_plane, float& a_distance, float a_maxDistance = std::numeric_limits<float>::infinity());
+#pragma endregion
+#pragma region Batched Queries
+	// Batched tests over structure of arrays storage, 8 volumes per iteration.
+	// Each writes the indices of the volumes that pass in ascending order and returns how many it wrote,
+	// so the output arrays must hold at least Count() elements.
+
+	/// \brief Frustum culling, writes the index of every box that Intersects(a_frustum, box)
+	OYL_CORE_API
+	extern
+	std::size_t
+	Cull(Frustum const& a_frustum, AABBStream const& a_boxes, uint32* a_visible);
+
+	/// \brief Frustum culling, writes the index of every sphere that Intersects(a_frustum, sphere)
+	OYL_CORE_API
+	extern
+	std::size_t
+	Cull(Frustum const& a_frustum, SphereStream const& a_spheres, uint32* a_visible);
+
+	/// \brief Broadphase query, writes the index of every box that Overlaps(a_query, box)
+	OYL_CORE_API
+	extern
+	std::size_t
+	Overlap(AABB const& a_query, AABBStream const& a_boxes, uint32* a_hits);
+
+	/**
+	 * \brief Writes the index of every box the ray hits within a_maxDistance
+	 * \param a_distances Optional, receives the entry distance of each hit in the same order as a_hits
+	 */
+	OYL_CORE_API
+	extern
+	std::size_t
+	Raycast(
+		Ray const&        a_ray,
+		AABBStream const& a_boxes,
+		uint32*           a_hits,
+		float*            a_distances = nullptr,
+		float             a_maxDistance = std::numeric_limits<float>::infinity()
+	);
+#pragma endregion
+}
@@ -0,0 +1,1508 @@
+#include "pch.h"
+#include "Collision.h"
+
+#include "Simd.h"
+
+namespace Oyl::Collision
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+
+		constexpr int gjk_max_iterations = 64;
+
+		/// GJK has converged once the closest point improves by less than this fraction of its squared distance
+		constexpr float gjk_relative_tolerance = 1e-6f;
+
+		/// Squared distances this small relative to the squared size of the simplex count as touching
+		constexpr float overlap_tolerance = 1e-10f;
+
+		constexpr int epa_max_vertices = 64;
+		constexpr int epa_max_faces    = 2 * epa_max_vertices;
+
+		/// EPA stops once a support point is less than this fraction of the polytope's size beyond the closest face
+		constexpr float epa_relative_tolerance = 1e-4f;
+
+		/// Sine of the angle below which an edge or face counts as perpendicular to the contact normal, about 2 degrees
+		constexpr float feature_sin_tolerance = 0.035f;
+
+		constexpr int max_feature_points = 16;
+		constexpr int max_clip_points    = 2 * max_feature_points;
+
+		// GJK and EPA keep every point in a Float4 with w = 0, Vector3 only appears at the edges of the file. Going
+		// through Vector3 for each operation costs a load and a store per temporary, which was most of the time spent.
+
+		OYL_FORCE_INLINE Simd::Float4 ToSimd(Vector3 const& a_value) { return Simd::Load3(a_value.data); }
+
+		OYL_FORCE_INLINE
+		Vector3
+		ToVector(Simd::Float4 a_value)
+		{
+			Vector3 result;
+			Simd::Store3(result.data, a_value);
+			return result;
+		}
+
+		OYL_FORCE_INLINE float Dot(Simd::Float4 a_lhs, Simd::Float4 a_rhs) { return Simd::GetX(Simd::Dot3(a_lhs, a_rhs)); }
+
+		OYL_FORCE_INLINE Simd::Float4 Scale(Simd::Float4 a_value, float a_scale) { return Simd::Mul(a_value, Simd::Splat(a_scale)); }
+
+		/// A shape with its transform split into rows, how every query sees it
+		struct Frame
+		{
+			ConvexShape const* shape;
+
+			Simd::Float4 rows[3];
+			/// The transposed rows, to bring directions into the shape's space
+			Simd::Float4 columns[3];
+			Simd::Float4 translation;
+
+			/// The shape's points, see ConvexShape
+			Simd::Float4 a, b, c;
+
+			/// The shape's radius in world units
+			float radius;
+		};
+
+		Frame
+		MakeFrame(ConvexShape const& a_shape, Matrix4 const& a_transform)
+		{
+			Frame result;
+			result.shape       = &a_shape;
+			result.rows[0]     = Simd::Load3(a_transform.cols[0].data);
+			result.rows[1]     = Simd::Load3(a_transform.cols[1].data);
+			result.rows[2]     = Simd::Load3(a_transform.cols[2].data);
+			result.translation = Simd::Load3(a_transform.cols[3].data);
+
+			Simd::Float4 unused = Simd::Zero();
+			result.columns[0]   = result.rows[0];
+			result.columns[1]   = result.rows[1];
+			result.columns[2]   = result.rows[2];
+			Simd::Transpose(result.columns[0], result.columns[1], result.columns[2], unused);
+
+			result.a      = ToSimd(a_shape.a);
+			result.b      = ToSimd(a_shape.b);
+			result.c      = ToSimd(a_shape.c);
+			result.radius = a_shape.radius * std::sqrt(Dot(result.rows[0], result.rows[0]));
+			return result;
+		}
+
+		/// \brief Brings a world direction into the shape's space, by the transpose of the linear part
+		OYL_FORCE_INLINE
+		Simd::Float4
+		ToLocalDirection(Frame const& a_frame, Simd::Float4 a_direction)
+		{
+			Simd::Float4 result = Simd::Mul(a_frame.columns[0], Simd::Shuffle<0, 0, 0, 0>(a_direction));
+			result = Simd::MulAdd(a_frame.columns[1], Simd::Shuffle<1, 1, 1, 1>(a_direction), result);
+			return Simd::MulAdd(a_frame.columns[2], Simd::Shuffle<2, 2, 2, 2>(a_direction), result);
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float4
+		ToWorld(Frame const& a_frame, Simd::Float4 a_point)
+		{
+			Simd::Float4 result = Simd::MulAdd(a_frame.rows[0], Simd::Shuffle<0, 0, 0, 0>(a_point), a_frame.translation);
+			result = Simd::MulAdd(a_frame.rows[1], Simd::Shuffle<1, 1, 1, 1>(a_point), result);
+			return Simd::MulAdd(a_frame.rows[2], Simd::Shuffle<2, 2, 2, 2>(a_point), result);
+		}
+
+		/// \brief Whether both cores are a point or a segment, which has a closed form
+		bool
+		IsSegmentCore(ConvexShape const& a_shape)
+		{
+			return a_shape.type == ConvexType::Sphere || a_shape.type == ConvexType::Capsule;
+		}
+
+		/// \brief Eight points per iteration, keeping the best dot product and its index in each lane
+		Simd::Float4
+		HullSupport(Vector3Stream const& a_points, Simd::Float4 a_direction)
+		{
+			alignas(32) constexpr std::int32_t lane_indices[block_size] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+			std::size_t const count = a_points.Count();
+
+			Simd::Float8 const dx = Simd::Splat8(Simd::GetX(a_direction));
+			Simd::Float8 const dy = Simd::Splat8(Simd::GetX(Simd::Shuffle<1, 1, 1, 1>(a_direction)));
+			Simd::Float8 const dz = Simd::Splat8(Simd::GetX(Simd::Shuffle<2, 2, 2, 2>(a_direction)));
+
+			Simd::Float8 const lowest = Simd::Splat8(-std::numeric_limits<float>::infinity());
+			Simd::Int8 const   last   = Simd::SplatInt8(static_cast<std::int32_t>(count));
+			Simd::Int8 const   step   = Simd::SplatInt8(static_cast<std::int32_t>(block_size));
+
+			Simd::Float8 best      = lowest;
+			Simd::Int8   bestIndex = Simd::SplatInt8(0);
+			Simd::Int8   index     = Simd::LoadInt8(lane_indices);
+
+			for (std::size_t i = 0; i < count; i += block_size)
+			{
+				Simd::Float8 x = Simd::Load8(a_points.X() + i);
+				Simd::Float8 y = Simd::Load8(a_points.Y() + i);
+				Simd::Float8 z = Simd::Load8(a_points.Z() + i);
+
+				Simd::Float8 dot = Simd::MulAdd(z, dz, Simd::MulAdd(y, dy, Simd::Mul(x, dx)));
+
+				// The padding past Count() holds arbitrary values
+				dot = Simd::Select(Simd::BitCastToFloat(Simd::Less(index, last)), dot, lowest);
+
+				Simd::Float8 better = Simd::Greater(dot, best);
+				best      = Simd::Select(better, dot, best);
+				bestIndex = Simd::Select(Simd::BitCastToInt(better), index, bestIndex);
+				index     = Simd::Add(index, step);
+			}
+
+			alignas(32) float        dots[block_size];
+			alignas(32) std::int32_t indices[block_size];
+			Simd::Store(dots, best);
+			Simd::Store(indices, bestIndex);
+
+			std::size_t lane = 0;
+			for (std::size_t i = 1; i < block_size; i++)
+			{
+				lane = dots[i] > dots[lane] ? i : lane;
+			}
+
+			std::size_t const point = static_cast<std::size_t>(indices[lane]);
+			return Simd::Set(a_points.X()[point], a_points.Y()[point], a_points.Z()[point], 0.0f);
+		}
+
+		/// \return The point of a_frame's core furthest along a_direction, both in the shape's space
+		Simd::Float4
+		LocalSupport(Frame const& a_frame, Simd::Float4 a_direction)
+		{
+			switch (a_frame.shape->type)
+			{
+				case ConvexType::Sphere:
+					return a_frame.a;
+				case ConvexType::Capsule:
+				{
+					Simd::Float4 towardsEnd = Simd::Greater(Simd::Dot3(Simd::Sub(a_frame.b, a_frame.a), a_direction), Simd::Zero());
+					return Simd::Select(towardsEnd, a_frame.b, a_frame.a);
+				}
+				case ConvexType::Box:
+					return Simd::FlipSign(a_frame.a, a_direction);
+				case ConvexType::Hull:
+					return HullSupport(*a_frame.shape->hull, a_direction);
+				case ConvexType::Triangle:
+				{
+					Simd::Float4 dotA   = Simd::Dot3(a_frame.a, a_direction);
+					Simd::Float4 dotB   = Simd::Dot3(a_frame.b, a_direction);
+					Simd::Float4 dotC   = Simd::Dot3(a_frame.c, a_direction);
+					Simd::Float4 result = Simd::Select(Simd::Greater(dotB, dotA), a_frame.b, a_frame.a);
+					return Simd::Select(Simd::Greater(dotC, Simd::Max(dotA, dotB)), a_frame.c, result);
+				}
+			}
+			return a_frame.a;
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float4
+		CoreSupport(Frame const& a_frame, Simd::Float4 a_direction)
+		{
+			return ToWorld(a_frame, LocalSupport(a_frame, ToLocalDirection(a_frame, a_direction)));
+		}
+
+		/// A vertex of the Minkowski difference A - B, with the points of A and B it came from
+		struct SupportPoint
+		{
+			Simd::Float4 a;
+			Simd::Float4 b;
+			Simd::Float4 w;
+		};
+
+		/// \brief A support point of the difference of the cores, the radii are added by the callers
+		SupportPoint
+		MinkowskiSupport(Frame const& a_frameA, Frame const& a_frameB, Simd::Float4 a_direction)
+		{
+			SupportPoint result;
+			result.a = CoreSupport(a_frameA, a_direction);
+			result.b = CoreSupport(a_frameB, Simd::Negate(a_direction));
+			result.w = Simd::Sub(result.a, result.b);
+			return result;
+		}
+
+#pragma region GJK
+		struct Simplex
+		{
+			SupportPoint points[4];
+			float        weights[4];
+			int          count = 0;
+
+			Simd::Float4
+			Closest() const
+			{
+				Simd::Float4 result = Simd::Zero();
+				for (int i = 0; i < count; i++)
+				{
+					result = Simd::MulAdd(points[i].w, Simd::Splat(weights[i]), result);
+				}
+				return result;
+			}
+
+			void
+			Witnesses(Simd::Float4& a_pointA, Simd::Float4& a_pointB) const
+			{
+				a_pointA = Simd::Zero();
+				a_pointB = Simd::Zero();
+				for (int i = 0; i < count; i++)
+				{
+					Simd::Float4 weight = Simd::Splat(weights[i]);
+					a_pointA = Simd::MulAdd(points[i].a, weight, a_pointA);
+					a_pointB = Simd::MulAdd(points[i].b, weight, a_pointB);
+				}
+			}
+
+			/// \brief Keeps only the listed points, with the given barycentric weights
+			void
+			Reduce(int a_count, int const* a_indices, float const* a_weights)
+			{
+				SupportPoint kept[4];
+				for (int i = 0; i < a_count; i++)
+				{
+					kept[i] = points[a_indices[i]];
+				}
+				for (int i = 0; i < a_count; i++)
+				{
+					points[i]  = kept[i];
+					weights[i] = a_weights[i];
+				}
+				count = a_count;
+			}
+		};
+
+		float
+		SegmentParameter(Simd::Float4 a_start, Simd::Float4 a_end)
+		{
+			Simd::Float4 edge   = Simd::Sub(a_end, a_start);
+			float        length = Dot(edge, edge);
+			return length > 0 ? -Dot(a_start, edge) / length : 0.0f;
+		}
+
+		/// \brief Closest point to the origin on the segment of the first two points of a_simplex
+		void
+		SolveSegment(Simplex& a_simplex)
+		{
+			float t = SegmentParameter(a_simplex.points[0].w, a_simplex.points[1].w);
+			if (t <= 0)
+			{
+				int const   indices[] = { 0 };
+				float const weights[] = { 1.0f };
+				a_simplex.Reduce(1, indices, weights);
+			}
+			else if (t >= 1)
+			{
+				int const   indices[] = { 1 };
+				float const weights[] = { 1.0f };
+				a_simplex.Reduce(1, indices, weights);
+			}
+			else
+			{
+				a_simplex.weights[0] = 1 - t;
+				a_simplex.weights[1] = t;
+			}
+		}
+
+		/// \brief Closest point to the origin on a triangle by its Voronoi regions (Ericson, Real-Time Collision Detection 5.1.5)
+		void
+		SolveTriangle(Simplex& a_simplex)
+		{
+			Simd::Float4 const a = a_simplex.points[0].w;
+			Simd::Float4 const b = a_simplex.points[1].w;
+			Simd::Float4 const c = a_simplex.points[2].w;
+
+			Simd::Float4 ab = Simd::Sub(b, a);
+			Simd::Float4 ac = Simd::Sub(c, a);
+
+			float d1 = -Dot(ab, a);
+			float d2 = -Dot(ac, a);
+			if (d1 <= 0 && d2 <= 0)
+			{
+				int const   indices[] = { 0 };
+				float const weights[] = { 1.0f };
+				a_simplex.Reduce(1, indices, weights);
+				return;
+			}
+
+			float d3 = -Dot(ab, b);
+			float d4 = -Dot(ac, b);
+			if (d3 >= 0 && d4 <= d3)
+			{
+				int const   indices[] = { 1 };
+				float const weights[] = { 1.0f };
+				a_simplex.Reduce(1, indices, weights);
+				return;
+			}
+
+			float vc = d1 * d4 - d3 * d2;
+			if (vc <= 0 && d1 >= 0 && d3 <= 0)
+			{
+				float       t         = d1 / (d1 - d3);
+				int const   indices[] = { 0, 1 };
+				float const weights[] = { 1 - t, t };
+				a_simplex.Reduce(2, indices, weights);
+				return;
+			}
+
+			float d5 = -Dot(ab, c);
+			float d6 = -Dot(ac, c);
+			if (d6 >= 0 && d5 <= d6)
+			{
+				int const   indices[] = { 2 };
+				float const weights[] = { 1.0f };
+				a_simplex.Reduce(1, indices, weights);
+				return;
+			}
+
+			float vb = d5 * d2 - d1 * d6;
+			if (vb <= 0 && d2 >= 0 && d6 <= 0)
+			{
+				float       t         = d2 / (d2 - d6);
+				int const   indices[] = { 0, 2 };
+				float const weights[] = { 1 - t, t };
+				a_simplex.Reduce(2, indices, weights);
+				return;
+			}
+
+			float va = d3 * d6 - d5 * d4;
+			if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0)
+			{
+				float       t         = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+				int const   indices[] = { 1, 2 };
+				float const weights[] = { 1 - t, t };
+				a_simplex.Reduce(2, indices, weights);
+				return;
+			}
+
+			float sum = va + vb + vc;
+			if (sum <= 0)
+			{
+				// Degenerate triangle, its closest point is on the longest edge
+				int const   indices[] = { 0, 1 };
+				float const weights[] = { 0.5f, 0.5f };
+				a_simplex.Reduce(2, indices, weights);
+				SolveSegment(a_simplex);
+				return;
+			}
+
+			a_simplex.weights[0] = va / sum;
+			a_simplex.weights[1] = vb / sum;
+			a_simplex.weights[2] = vc / sum;
+		}
+
+		/// \brief Closest point to the origin on a tetrahedron, the nearest of the faces the origin is in front of
+		void
+		SolveTetrahedron(Simplex& a_simplex)
+		{
+			constexpr int faces[4][4] = {
+				{ 0, 1, 2, 3 },
+				{ 0, 3, 1, 2 },
+				{ 0, 2, 3, 1 },
+				{ 1, 3, 2, 0 },
+			};
+
+			Simplex best;
+			float   bestDistance = std::numeric_limits<float>::infinity();
+			bool    inside       = true;
+
+			for (auto const& face : faces)
+			{
+				Simd::Float4 a = a_simplex.points[face[0]].w;
+				Simd::Float4 n = Simd::Cross3(Simd::Sub(a_simplex.points[face[1]].w, a), Simd::Sub(a_simplex.points[face[2]].w, a));
+
+				float originSide   = -Dot(n, a);
+				float oppositeSide = Dot(n, Simd::Sub(a_simplex.points[face[3]].w, a));
+
+				// A flat tetrahedron has no inside, so every face is a candidate
+				if (originSide * oppositeSide > 0 && oppositeSide * oppositeSide > overlap_tolerance * Dot(n, n))
+				{
+					continue;
+				}
+				inside = false;
+
+				Simplex candidate;
+				candidate.count = 3;
+				for (int i = 0; i < 3; i++)
+				{
+					candidate.points[i] = a_simplex.points[face[i]];
+				}
+				SolveTriangle(candidate);
+
+				Simd::Float4 closest  = candidate.Closest();
+				float        distance = Dot(closest, closest);
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best         = candidate;
+				}
+			}
+
+			if (inside)
+			{
+				for (float& weight : a_simplex.weights)
+				{
+					weight = 0.25f;
+				}
+				return;
+			}
+			a_simplex = best;
+		}
+
+		void
+		Solve(Simplex& a_simplex)
+		{
+			switch (a_simplex.count)
+			{
+				case 1:
+					a_simplex.weights[0] = 1.0f;
+					break;
+				case 2:
+					SolveSegment(a_simplex);
+					break;
+				case 3:
+					SolveTriangle(a_simplex);
+					break;
+				default:
+					SolveTetrahedron(a_simplex);
+					break;
+			}
+		}
+
+		struct GjkResult
+		{
+			Simplex      simplex;
+			Simd::Float4 closest;
+			float        distance;
+			bool         overlapping;
+		};
+
+		/**
+		 * \brief GJK distance (van den Bergen, "A Fast and Robust GJK Implementation for Collision Detection of Convex Objects")
+		 * \param a_separation Stops early once the shapes are known to be further apart than this
+		 */
+		GjkResult
+		Gjk(Frame const& a_frameA, Frame const& a_frameB, float a_separation = std::numeric_limits<float>::infinity())
+		{
+			GjkResult result;
+			result.overlapping = false;
+
+			Simd::Float4 direction = Simd::Sub(a_frameB.translation, a_frameA.translation);
+			if (Dot(direction, direction) == 0)
+			{
+				direction = Simd::Set(1, 0, 0, 0);
+			}
+
+			Simplex& simplex = result.simplex;
+			simplex.points[0]  = MinkowskiSupport(a_frameA, a_frameB, Simd::Negate(direction));
+			simplex.weights[0] = 1.0f;
+			simplex.count      = 1;
+
+			Simd::Float4 closest = simplex.points[0].w;
+			float        scale   = Dot(closest, closest);
+
+			for (int iteration = 0; iteration < gjk_max_iterations; iteration++)
+			{
+				float distanceSquared = Dot(closest, closest);
+				if (distanceSquared <= overlap_tolerance * scale)
+				{
+					result.overlapping = true;
+					break;
+				}
+
+				SupportPoint support = MinkowskiSupport(a_frameA, a_frameB, Simd::Negate(closest));
+				scale = std::max(scale, Dot(support.w, support.w));
+
+				// Dot(closest, support.w) / |closest| is a lower bound for the distance
+				float bound = Dot(closest, support.w);
+				if (bound > 0 && bound * bound > a_separation * a_separation * distanceSquared)
+				{
+					break;
+				}
+				if (distanceSquared - bound <= gjk_relative_tolerance * distanceSquared)
+				{
+					break;
+				}
+
+				bool repeated = false;
+				for (int i = 0; i < simplex.count; i++)
+				{
+					Simd::Float4 offset = Simd::Sub(simplex.points[i].w, support.w);
+					repeated |= Dot(offset, offset) <= overlap_tolerance * scale;
+				}
+				if (repeated)
+				{
+					break;
+				}
+
+				Simplex previous = simplex;
+				simplex.points[simplex.count++] = support;
+				Solve(simplex);
+
+				if (simplex.count == 4)
+				{
+					closest            = Simd::Zero();
+					result.overlapping = true;
+					break;
+				}
+
+				Simd::Float4 next = simplex.Closest();
+				if (Dot(next, next) >= distanceSquared)
+				{
+					// No progress, rounding has taken over
+					simplex = previous;
+					break;
+				}
+				closest = next;
+			}
+
+			result.closest  = closest;
+			result.distance = result.overlapping ? 0.0f : std::sqrt(Dot(closest, closest));
+			return result;
+		}
+#pragma endregion
+#pragma region EPA
+		struct EpaFace
+		{
+			Simd::Float4 normal;
+			float        distance;
+			int          vertices[3];
+		};
+
+		struct Polytope
+		{
+			SupportPoint vertices[epa_max_vertices];
+			EpaFace      faces[epa_max_faces];
+			int          vertexCount = 0;
+			int          faceCount   = 0;
+
+			void
+			AddFace(int a_a, int a_b, int a_c)
+			{
+				EpaFace& face = faces[faceCount++];
+				face.vertices[0] = a_a;
+				face.vertices[1] = a_b;
+				face.vertices[2] = a_c;
+
+				Simd::Float4 a = vertices[a_a].w;
+				Simd::Float4 n = Simd::Cross3(Simd::Sub(vertices[a_b].w, a), Simd::Sub(vertices[a_c].w, a));
+
+				float magnitude = std::sqrt(Dot(n, n));
+				if (magnitude > 0)
+				{
+					face.normal   = Scale(n, 1.0f / magnitude);
+					face.distance = Dot(face.normal, a);
+				}
+				else
+				{
+					// A sliver keeps the polytope closed but is never the closest face and never faces a support point
+					face.normal   = Simd::Zero();
+					face.distance = std::numeric_limits<float>::infinity();
+				}
+			}
+		};
+
+		/**
+		 * \brief Grows a GJK simplex that touches or contains the origin into a tetrahedron
+		 * \return False if the Minkowski difference is flat, ie. for two coplanar triangles
+		 */
+		bool
+		ExpandSimplex(Frame const& a_frameA, Frame const& a_frameB, Simplex& a_simplex, float a_scale)
+		{
+			float const tolerance = 1e-6f * a_scale;
+
+			if (a_simplex.count == 1)
+			{
+				Simd::Float4 const axes[] = {
+					Simd::Set(1, 0, 0, 0), Simd::Set(-1, 0, 0, 0),
+					Simd::Set(0, 1, 0, 0), Simd::Set(0, -1, 0, 0),
+					Simd::Set(0, 0, 1, 0), Simd::Set(0, 0, -1, 0),
+				};
+				for (Simd::Float4 axis : axes)
+				{
+					SupportPoint support = MinkowskiSupport(a_frameA, a_frameB, axis);
+					Simd::Float4 offset  = Simd::Sub(support.w, a_simplex.points[0].w);
+					if (Dot(offset, offset) > tolerance * tolerance)
+					{
+						a_simplex.points[a_simplex.count++] = support;
+						break;
+					}
+				}
+				if (a_simplex.count == 1)
+				{
+					return false;
+				}
+			}
+
+			if (a_simplex.count == 2)
+			{
+				// Search around the segment in 60 degree steps for a point off its line
+				Vector3 line = Vector::Normalize(ToVector(Simd::Sub(a_simplex.points[1].w, a_simplex.points[0].w)));
+				Vector3 axis = std::abs(line.x) < 0.57f ? Vector3(1, 0, 0) : (std::abs(line.y) < 0.57f ? Vector3(0, 1, 0) : Vector3(0, 0, 1));
+
+				Vector3 u = Vector::Normalize(Vector::Cross(line, axis));
+				Vector3 v = Vector::Cross(line, u);
+				for (int step = 0; step < 6 && a_simplex.count == 2; step++)
+				{
+					float   angle     = static_cast<float>(step) * 1.04719755f;
+					Vector3 direction = u * std::cos(angle) + v * std::sin(angle);
+
+					SupportPoint support = MinkowskiSupport(a_frameA, a_frameB, ToSimd(direction));
+					Simd::Float4 offset  = Simd::Cross3(Simd::Sub(support.w, a_simplex.points[0].w), ToSimd(line));
+					if (Dot(offset, offset) > tolerance * tolerance)
+					{
+						a_simplex.points[a_simplex.count++] = support;
+					}
+				}
+				if (a_simplex.count == 2)
+				{
+					return false;
+				}
+			}
+
+			if (a_simplex.count == 3)
+			{
+				Simd::Float4 a = a_simplex.points[0].w;
+				Simd::Float4 n = Simd::Cross3(Simd::Sub(a_simplex.points[1].w, a), Simd::Sub(a_simplex.points[2].w, a));
+				n = Scale(n, 1.0f / std::sqrt(Dot(n, n)));
+
+				SupportPoint above = MinkowskiSupport(a_frameA, a_frameB, n);
+				SupportPoint below = MinkowskiSupport(a_frameA, a_frameB, Simd::Negate(n));
+
+				float heightAbove = Dot(Simd::Sub(above.w, a), n);
+				float heightBelow = -Dot(Simd::Sub(below.w, a), n);
+				if (std::max(heightAbove, heightBelow) <= tolerance)
+				{
+					return false;
+				}
+				a_simplex.points[a_simplex.count++] = heightAbove >= heightBelow ? above : below;
+			}
+			return true;
+		}
+
+		/// \brief The barycentric coordinates of a_point in the triangle (a_a, a_b, a_c), a_point must be in its plane
+		void
+		Barycentric(Simd::Float4 a_point, Simd::Float4 a_a, Simd::Float4 a_b, Simd::Float4 a_c, float* a_out)
+		{
+			Simd::Float4 v0 = Simd::Sub(a_b, a_a);
+			Simd::Float4 v1 = Simd::Sub(a_c, a_a);
+			Simd::Float4 v2 = Simd::Sub(a_point, a_a);
+
+			float d00 = Dot(v0, v0);
+			float d01 = Dot(v0, v1);
+			float d11 = Dot(v1, v1);
+			float d20 = Dot(v2, v0);
+			float d21 = Dot(v2, v1);
+
+			float denominator = d00 * d11 - d01 * d01;
+			if (denominator <= 0)
+			{
+				a_out[0] = 1.0f;
+				a_out[1] = 0.0f;
+				a_out[2] = 0.0f;
+				return;
+			}
+			a_out[1] = (d11 * d20 - d01 * d21) / denominator;
+			a_out[2] = (d00 * d21 - d01 * d20) / denominator;
+			a_out[0] = 1.0f - a_out[1] - a_out[2];
+		}
+
+		/**
+		 * \brief When EPA can't build a polytope the cores are flat and only touch, the depth is zero
+		 * \remarks The normal leaves the plane or line of the flat difference, towards B where that is defined.
+		 */
+		void
+		TouchingContact(Frame const& a_frameA, Frame const& a_frameB, Simplex& a_simplex, Contact& a_out)
+		{
+			Simd::Float4 const centers = Simd::Sub(a_frameB.translation, a_frameA.translation);
+			Simd::Float4 const a       = a_simplex.points[0].w;
+
+			Simd::Float4 normal = centers;
+			if (a_simplex.count == 3)
+			{
+				normal = Simd::Cross3(Simd::Sub(a_simplex.points[1].w, a), Simd::Sub(a_simplex.points[2].w, a));
+				normal = Dot(normal, centers) >= 0 ? normal : Simd::Negate(normal);
+			}
+			else if (a_simplex.count == 2)
+			{
+				Simd::Float4 line = Simd::Sub(a_simplex.points[1].w, a);
+				normal = Simd::Sub(centers, Scale(line, Dot(centers, line) / Dot(line, line)));
+				if (Dot(normal, normal) <= overlap_tolerance * Dot(line, line))
+				{
+					bool alongX = std::abs(Simd::GetX(line)) < 0.57f;
+					normal = Simd::Cross3(line, alongX ? Simd::Set(1, 0, 0, 0) : Simd::Set(0, 1, 0, 0));
+				}
+			}
+
+			float magnitude = std::sqrt(Dot(normal, normal));
+			a_out.normal = magnitude > 0 ? ToVector(Scale(normal, 1.0f / magnitude)) : Vector3(0, 1, 0);
+			a_out.depth  = 0;
+
+			Solve(a_simplex);
+
+			Simd::Float4 pointA, pointB;
+			a_simplex.Witnesses(pointA, pointB);
+			a_out.pointA = ToVector(pointA);
+			a_out.pointB = ToVector(pointB);
+		}
+
+		/// \brief Expanding polytope algorithm (van den Bergen), on the cores
+		void
+		Epa(Frame const& a_frameA, Frame const& a_frameB, Simplex a_simplex, Contact& a_out)
+		{
+			float scale = 0;
+			for (int i = 0; i < a_simplex.count; i++)
+			{
+				scale = std::max(scale, Dot(a_simplex.points[i].w, a_simplex.points[i].w));
+			}
+			scale = std::sqrt(scale);
+
+			if (!ExpandSimplex(a_frameA, a_frameB, a_simplex, scale))
+			{
+				TouchingContact(a_frameA, a_frameB, a_simplex, a_out);
+				return;
+			}
+
+			Polytope polytope;
+			for (int i = 0; i < 4; i++)
+			{
+				polytope.vertices[i] = a_simplex.points[i];
+			}
+			polytope.vertexCount = 4;
+
+			// Wind every face so its normal points away from the fourth vertex
+			Simd::Float4 w0 = polytope.vertices[0].w;
+			Simd::Float4 n0 = Simd::Cross3(Simd::Sub(polytope.vertices[1].w, w0), Simd::Sub(polytope.vertices[2].w, w0));
+			if (Dot(n0, Simd::Sub(polytope.vertices[3].w, w0)) > 0)
+			{
+				std::swap(polytope.vertices[1], polytope.vertices[2]);
+			}
+			polytope.AddFace(0, 1, 2);
+			polytope.AddFace(0, 3, 1);
+			polytope.AddFace(0, 2, 3);
+			polytope.AddFace(1, 3, 2);
+
+			float const tolerance = epa_relative_tolerance * scale;
+
+			int closest = 0;
+			while (true)
+			{
+				closest = 0;
+				for (int i = 1; i < polytope.faceCount; i++)
+				{
+					closest = polytope.faces[i].distance < polytope.faces[closest].distance ? i : closest;
+				}
+
+				EpaFace const& face = polytope.faces[closest];
+				if (polytope.vertexCount == epa_max_vertices || face.distance == std::numeric_limits<float>::infinity())
+				{
+					break;
+				}
+
+				SupportPoint support = MinkowskiSupport(a_frameA, a_frameB, face.normal);
+				if (Dot(support.w, face.normal) - face.distance <= tolerance)
+				{
+					break;
+				}
+
+				// Remove every face the new point is in front of, edges shared by two of them cancel out and what
+				// remains is the horizon the new faces fan out from
+				int edges[epa_max_faces * 3][2];
+				int edgeCount = 0;
+				int kept      = 0;
+				for (int i = 0; i < polytope.faceCount; i++)
+				{
+					EpaFace const& candidate = polytope.faces[i];
+					if (Dot(candidate.normal, support.w) - candidate.distance <= 0)
+					{
+						polytope.faces[kept++] = candidate;
+						continue;
+					}
+
+					for (int j = 0; j < 3; j++)
+					{
+						int from = candidate.vertices[j];
+						int to   = candidate.vertices[(j + 1) % 3];
+
+						bool shared = false;
+						for (int k = 0; k < edgeCount; k++)
+						{
+							if (edges[k][0] == to && edges[k][1] == from)
+							{
+								edges[k][0] = edges[edgeCount - 1][0];
+								edges[k][1] = edges[edgeCount - 1][1];
+								edgeCount--;
+								shared = true;
+								break;
+							}
+						}
+						if (!shared)
+						{
+							edges[edgeCount][0] = from;
+							edges[edgeCount][1] = to;
+							edgeCount++;
+						}
+					}
+				}
+
+				if (kept + edgeCount > epa_max_faces)
+				{
+					// Out of room, the faces removed above are lost so answer from a fresh search of what is left
+					polytope.faceCount = kept;
+					break;
+				}
+
+				int added = polytope.vertexCount++;
+				polytope.vertices[added] = support;
+				polytope.faceCount       = kept;
+				for (int i = 0; i < edgeCount; i++)
+				{
+					polytope.AddFace(edges[i][0], edges[i][1], added);
+				}
+			}
+
+			closest = 0;
+			for (int i = 1; i < polytope.faceCount; i++)
+			{
+				closest = polytope.faces[i].distance < polytope.faces[closest].distance ? i : closest;
+			}
+
+			EpaFace const&      face = polytope.faces[closest];
+			SupportPoint const& a    = polytope.vertices[face.vertices[0]];
+			SupportPoint const& b    = polytope.vertices[face.vertices[1]];
+			SupportPoint const& c    = polytope.vertices[face.vertices[2]];
+
+			float depth = std::max(face.distance, 0.0f);
+			float weights[3];
+			Barycentric(Scale(face.normal, depth), a.w, b.w, c.w, weights);
+
+			Simd::Float4 const wa = Simd::Splat(weights[0]);
+			Simd::Float4 const wb = Simd::Splat(weights[1]);
+			Simd::Float4 const wc = Simd::Splat(weights[2]);
+
+			a_out.normal = ToVector(face.normal);
+			a_out.depth  = depth;
+			a_out.pointA = ToVector(Simd::MulAdd(c.a, wc, Simd::MulAdd(b.a, wb, Simd::Mul(a.a, wa))));
+			a_out.pointB = ToVector(Simd::MulAdd(c.b, wc, Simd::MulAdd(b.b, wb, Simd::Mul(a.b, wa))));
+		}
+#pragma endregion
+#pragma region Queries
+		/// \brief Closest points of two segments (Ericson, Real-Time Collision Detection 5.1.9)
+		void
+		ClosestSegmentPoints(Simd::Float4 a_startA, Simd::Float4 a_endA, Simd::Float4 a_startB, Simd::Float4 a_endB, Simd::Float4& a_pointA, Simd::Float4& a_pointB)
+		{
+			Simd::Float4 edgeA  = Simd::Sub(a_endA, a_startA);
+			Simd::Float4 edgeB  = Simd::Sub(a_endB, a_startB);
+			Simd::Float4 offset = Simd::Sub(a_startA, a_startB);
+
+			float lengthA = Dot(edgeA, edgeA);
+			float lengthB = Dot(edgeB, edgeB);
+			float f       = Dot(edgeB, offset);
+
+			float s = 0;
+			float t = 0;
+			if (lengthA > 0 && lengthB > 0)
+			{
+				float b = Dot(edgeA, edgeB);
+				float c = Dot(edgeA, offset);
+
+				float denominator = lengthA * lengthB - b * b;
+				s = denominator > 0 ? std::clamp((b * f - c * lengthB) / denominator, 0.0f, 1.0f) : 0.0f;
+				t = (b * s + f) / lengthB;
+				if (t < 0)
+				{
+					t = 0;
+					s = std::clamp(-c / lengthA, 0.0f, 1.0f);
+				}
+				else if (t > 1)
+				{
+					t = 1;
+					s = std::clamp((b - c) / lengthA, 0.0f, 1.0f);
+				}
+			}
+			else if (lengthA > 0)
+			{
+				s = std::clamp(-Dot(edgeA, offset) / lengthA, 0.0f, 1.0f);
+			}
+			else if (lengthB > 0)
+			{
+				t = std::clamp(f / lengthB, 0.0f, 1.0f);
+			}
+
+			a_pointA = Simd::MulAdd(edgeA, Simd::Splat(s), a_startA);
+			a_pointB = Simd::MulAdd(edgeB, Simd::Splat(t), a_startB);
+		}
+
+		/// \brief The core points of both shapes closest to each other, and the distance between them
+		float
+		CoreClosestPoints(Frame const& a_frameA, Frame const& a_frameB, Simd::Float4& a_pointA, Simd::Float4& a_pointB, GjkResult* a_gjk)
+		{
+			if (IsSegmentCore(*a_frameA.shape) && IsSegmentCore(*a_frameB.shape))
+			{
+				Simd::Float4 startA = ToWorld(a_frameA, a_frameA.a);
+				Simd::Float4 startB = ToWorld(a_frameB, a_frameB.a);
+				Simd::Float4 endA   = a_frameA.shape->type == ConvexType::Capsule ? ToWorld(a_frameA, a_frameA.b) : startA;
+				Simd::Float4 endB   = a_frameB.shape->type == ConvexType::Capsule ? ToWorld(a_frameB, a_frameB.b) : startB;
+
+				ClosestSegmentPoints(startA, endA, startB, endB, a_pointA, a_pointB);
+
+				Simd::Float4 offset = Simd::Sub(a_pointB, a_pointA);
+				return std::sqrt(Dot(offset, offset));
+			}
+
+			*a_gjk = Gjk(a_frameA, a_frameB);
+			a_gjk->simplex.Witnesses(a_pointA, a_pointB);
+			return a_gjk->distance;
+		}
+
+		bool
+		FindContact(Frame const& a_frameA, Frame const& a_frameB, Contact& a_out)
+		{
+			float const radius = a_frameA.radius + a_frameB.radius;
+
+			Simd::Float4 pointA, pointB;
+			GjkResult    gjk;
+			float        distance = CoreClosestPoints(a_frameA, a_frameB, pointA, pointB, &gjk);
+			if (distance > radius)
+			{
+				return false;
+			}
+
+			// Cores apart, the contact follows from the closest points and the radii
+			if (distance > 1e-4f * radius)
+			{
+				Simd::Float4 normal = Scale(Simd::Sub(pointB, pointA), 1.0f / distance);
+				a_out.normal = ToVector(normal);
+				a_out.depth  = radius - distance;
+				a_out.pointA = ToVector(Simd::MulAdd(normal, Simd::Splat(a_frameA.radius), pointA));
+				a_out.pointB = ToVector(Simd::MulAdd(normal, Simd::Splat(-a_frameB.radius), pointB));
+				return true;
+			}
+
+			// Cores overlap. Growing a convex set by a ball moves its boundary out by the radius everywhere, so the
+			// penetration of the rounded shapes is that of the cores plus the radii, along the same normal
+			if (IsSegmentCore(*a_frameA.shape) && IsSegmentCore(*a_frameB.shape))
+			{
+				gjk = Gjk(a_frameA, a_frameB);
+			}
+			Epa(a_frameA, a_frameB, gjk.simplex, a_out);
+
+			a_out.depth += radius;
+			a_out.pointA = a_out.pointA + a_out.normal * a_frameA.radius;
+			a_out.pointB = a_out.pointB - a_out.normal * a_frameB.radius;
+			return true;
+		}
+#pragma endregion
+#pragma region Manifolds
+		/// \brief The points among a_count of a_getPoint(i) that are furthest along a_direction, within the feature angle
+		template<typename TGetPoint>
+		int
+		PointFeature(TGetPoint const& a_getPoint, std::size_t a_count, Vector3 const& a_direction, Vector3* a_out)
+		{
+			std::size_t furthest = 0;
+			float       maximum  = -std::numeric_limits<float>::infinity();
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				float dot = Vector::Dot(a_getPoint(i), a_direction);
+				if (dot > maximum)
+				{
+					maximum  = dot;
+					furthest = i;
+				}
+			}
+
+			Vector3 top   = a_getPoint(furthest);
+			int     count = 0;
+			for (std::size_t i = 0; i < a_count && count < max_feature_points; i++)
+			{
+				Vector3 point  = a_getPoint(i);
+				Vector3 offset = top - point;
+				float   drop   = Vector::Dot(offset, a_direction);
+				if (drop * drop <= feature_sin_tolerance * feature_sin_tolerance * Vector::Dot(offset, offset))
+				{
+					a_out[count++] = point;
+				}
+			}
+			return count;
+		}
+
+		/**
+		 * \brief The vertex, edge or face of a core facing a_direction, in the shape's space
+		 * \param a_direction Normalized, in the shape's space
+		 */
+		int
+		LocalFeature(ConvexShape const& a_shape, Vector3 const& a_direction, Vector3* a_out)
+		{
+			switch (a_shape.type)
+			{
+				case ConvexType::Sphere:
+					a_out[0] = a_shape.a;
+					return 1;
+				case ConvexType::Capsule:
+				{
+					Vector3 const points[] = { a_shape.a, a_shape.b };
+					return PointFeature([&](std::size_t a_index) { return points[a_index]; }, 2, a_direction, a_out);
+				}
+				case ConvexType::Box:
+				{
+					int count = 0;
+					for (int corner = 0; corner < 8; corner++)
+					{
+						Vector3 point;
+						bool    facing = true;
+						for (int axis = 0; axis < 3; axis++)
+						{
+							float sign = (corner >> axis) & 1 ? 1.0f : -1.0f;
+							point.data[axis] = a_shape.a.data[axis] * sign;
+							facing &= std::abs(a_direction.data[axis]) <= feature_sin_tolerance || a_direction.data[axis] * sign > 0;
+						}
+						if (facing)
+						{
+							a_out[count++] = point;
+						}
+					}
+					return count;
+				}
+				case ConvexType::Hull:
+				{
+					Vector3Stream const& hull = *a_shape.hull;
+					return PointFeature([&](std::size_t a_index) { return hull.Get(a_index); }, hull.Count(), a_direction, a_out);
+				}
+				case ConvexType::Triangle:
+				{
+					Vector3 const points[] = { a_shape.a, a_shape.b, a_shape.c };
+					return PointFeature([&](std::size_t a_index) { return points[a_index]; }, 3, a_direction, a_out);
+				}
+			}
+			return 0;
+		}
+
+		/// A feature of one shape in world space, projected onto the plane of the contact normal and in convex order
+		struct Feature
+		{
+			Vector3 points[max_feature_points];
+			int     count;
+		};
+
+		/// \brief Andrew's monotone chain over the 2D coordinates, drops points inside or on the hull's edges
+		int
+		ConvexOrder(Vector3* a_points, int a_count, Vector3 const& a_u, Vector3 const& a_v)
+		{
+			if (a_count < 3)
+			{
+				return a_count;
+			}
+
+			struct Projected
+			{
+				float   x, y;
+				Vector3 point;
+			};
+
+			Projected sorted[max_feature_points];
+			for (int i = 0; i < a_count; i++)
+			{
+				sorted[i] = Projected { Vector::Dot(a_points[i], a_u), Vector::Dot(a_points[i], a_v), a_points[i] };
+			}
+			std::sort(sorted, sorted + a_count, [](Projected const& a_lhs, Projected const& a_rhs)
+			{
+				return a_lhs.x < a_rhs.x || (a_lhs.x == a_rhs.x && a_lhs.y < a_rhs.y);
+			});
+
+			auto turn = [](Projected const& a_o, Projected const& a_a, Projected const& a_b)
+			{
+				return (a_a.x - a_o.x) * (a_b.y - a_o.y) - (a_a.y - a_o.y) * (a_b.x - a_o.x);
+			};
+
+			Projected hull[2 * max_feature_points];
+			int       count = 0;
+			for (int i = 0; i < a_count; i++)
+			{
+				while (count >= 2 && turn(hull[count - 2], hull[count - 1], sorted[i]) <= 0)
+				{
+					count--;
+				}
+				hull[count++] = sorted[i];
+			}
+			for (int i = a_count - 2, lower = count + 1; i >= 0; i--)
+			{
+				while (count >= lower && turn(hull[count - 2], hull[count - 1], sorted[i]) <= 0)
+				{
+					count--;
+				}
+				hull[count++] = sorted[i];
+			}
+			count--;
+
+			for (int i = 0; i < count; i++)
+			{
+				a_points[i] = hull[i].point;
+			}
+			return count;
+		}
+
+		/// \param a_direction World space and normalized, the feature is grown by the radius along it
+		void
+		WorldFeature(Frame const& a_frame, Vector3 const& a_direction, Vector3 const& a_u, Vector3 const& a_v, Feature& a_out)
+		{
+			Vector3 local = Vector::Normalize(ToVector(ToLocalDirection(a_frame, ToSimd(a_direction))));
+
+			a_out.count = LocalFeature(*a_frame.shape, local, a_out.points);
+			for (int i = 0; i < a_out.count; i++)
+			{
+				a_out.points[i] = ToVector(ToWorld(a_frame, ToSimd(a_out.points[i]))) + a_direction * a_frame.radius;
+			}
+			a_out.count = ConvexOrder(a_out.points, a_out.count, a_u, a_v);
+		}
+
+		/// \return How closely the plane of a polygon faces a_normal, 0 for segments and points
+		float
+		Alignment(Feature const& a_feature, Vector3 const& a_normal)
+		{
+			if (a_feature.count < 3)
+			{
+				return 0;
+			}
+
+			// Newell's method
+			Vector3 normal;
+			for (int i = 0; i < a_feature.count; i++)
+			{
+				normal = normal + Vector::Cross(a_feature.points[i], a_feature.points[(i + 1) % a_feature.count]);
+			}
+			float magnitude = Vector::Magnitude(normal);
+			return magnitude > 0 ? std::abs(Vector::Dot(normal, a_normal)) / magnitude : 0.0f;
+		}
+
+		/// \brief Keeps the part of a_points on the inner side of the plane through a_origin facing a_inward
+		int
+		ClipPolygon(Vector3 const* a_points, int a_count, Vector3 const& a_origin, Vector3 const& a_inward, Vector3* a_out)
+		{
+			if (a_count == 1)
+			{
+				a_out[0] = a_points[0];
+				return Vector::Dot(a_points[0] - a_origin, a_inward) >= 0 ? 1 : 0;
+			}
+
+			int count = 0;
+			if (a_count == 2)
+			{
+				float d0 = Vector::Dot(a_points[0] - a_origin, a_inward);
+				float d1 = Vector::Dot(a_points[1] - a_origin, a_inward);
+				if (d0 < 0 && d1 < 0)
+				{
+					return 0;
+				}
+				a_out[count++] = d0 >= 0 ? a_points[0] : a_points[0] + (a_points[1] - a_points[0]) * (d0 / (d0 - d1));
+				a_out[count++] = d1 >= 0 ? a_points[1] : a_points[1] + (a_points[0] - a_points[1]) * (d1 / (d1 - d0));
+				return count;
+			}
+
+			// Sutherland-Hodgman
+			for (int i = 0; i < a_count; i++)
+			{
+				Vector3 const& current = a_points[i];
+				Vector3 const& next    = a_points[(i + 1) % a_count];
+
+				float d0 = Vector::Dot(current - a_origin, a_inward);
+				float d1 = Vector::Dot(next - a_origin, a_inward);
+				if (d0 >= 0)
+				{
+					a_out[count++] = current;
+				}
+				if ((d0 >= 0) != (d1 >= 0))
+				{
+					a_out[count++] = current + (next - current) * (d0 / (d0 - d1));
+				}
+			}
+			return count;
+		}
+
+		/// \brief Keeps the deepest point, the one furthest from it and the two spanning the most area with them
+		void
+		ReduceManifold(ContactPoint const* a_points, int a_count, Vector3 const& a_normal, ContactManifold& a_out)
+		{
+			if (a_count <= ContactManifold::max_points)
+			{
+				for (int i = 0; i < a_count; i++)
+				{
+					a_out.points[i] = a_points[i];
+				}
+				a_out.count = a_count;
+				return;
+			}
+
+			int first = 0;
+			for (int i = 1; i < a_count; i++)
+			{
+				first = a_points[i].depth > a_points[first].depth ? i : first;
+			}
+
+			int   second  = first == 0 ? 1 : 0;
+			float longest = -1;
+			for (int i = 0; i < a_count; i++)
+			{
+				float length = Vector::MagnitudeSquared(a_points[i].position - a_points[first].position);
+				if (length > longest)
+				{
+					longest = length;
+					second  = i;
+				}
+			}
+
+			Vector3 const edge = a_points[second].position - a_points[first].position;
+			auto area = [&](int a_index)
+			{
+				return Vector::Dot(Vector::Cross(edge, a_points[a_index].position - a_points[first].position), a_normal);
+			};
+
+			int third  = first;
+			int fourth = first;
+			float largest = 0, smallest = 0;
+			for (int i = 0; i < a_count; i++)
+			{
+				float value = area(i);
+				if (value > largest)
+				{
+					largest = value;
+					third   = i;
+				}
+				if (value < smallest)
+				{
+					smallest = value;
+					fourth   = i;
+				}
+			}
+
+			a_out.count = 0;
+			for (int index : { first, second, third, fourth })
+			{
+				bool repeated = false;
+				for (int i = 0; i < a_out.count; i++)
+				{
+					repeated |= a_out.points[i].position == a_points[index].position;
+				}
+				if (!repeated)
+				{
+					a_out.points[a_out.count++] = a_points[index];
+				}
+			}
+		}
+
+		/**
+		 * \brief Clips the incident feature against the side planes of the reference feature
+		 * \param a_referenceIsA Whether the reference feature belongs to A, the normal always points from A to B
+		 */
+		int
+		ClipFeatures(Feature const& a_reference, Feature const& a_incident, bool a_referenceIsA, Vector3 const& a_normal, ContactPoint* a_out)
+		{
+			Vector3 buffers[2][max_clip_points];
+			int     count = a_incident.count;
+			for (int i = 0; i < count; i++)
+			{
+				buffers[0][i] = a_incident.points[i];
+			}
+
+			int current = 0;
+			if (a_reference.count == 2)
+			{
+				// Two edges, clip to the span of the reference edge
+				Vector3 edge = a_reference.points[1] - a_reference.points[0];
+				count   = ClipPolygon(buffers[0], count, a_reference.points[0], edge, buffers[1]);
+				count   = ClipPolygon(buffers[1], count, a_reference.points[1], -edge, buffers[0]);
+			}
+			else
+			{
+				// Points are in counter-clockwise order around the normal, so Cross(normal, edge) faces inwards
+				for (int i = 0; i < a_reference.count && count > 0; i++)
+				{
+					Vector3 const& start = a_reference.points[i];
+					Vector3 const& end   = a_reference.points[(i + 1) % a_reference.count];
+
+					count   = ClipPolygon(buffers[current], count, start, Vector::Cross(a_normal, end - start), buffers[1 - current]);
+					current = 1 - current;
+				}
+			}
+
+			float plane = 0;
+			for (int i = 0; i < a_reference.count; i++)
+			{
+				plane += Vector::Dot(a_reference.points[i], a_normal);
+			}
+			plane /= static_cast<float>(a_reference.count);
+
+			int result = 0;
+			for (int i = 0; i < count; i++)
+			{
+				Vector3 const& point = buffers[current][i];
+
+				float height = Vector::Dot(point, a_normal) - plane;
+				float depth  = a_referenceIsA ? -height : height;
+				if (depth >= 0)
+				{
+					a_out[result++] = ContactPoint { point - a_normal * (height * 0.5f), depth };
+				}
+			}
+			return result;
+		}
+
+		void
+		BuildManifold(Frame const& a_frameA, Frame const& a_frameB, Contact const& a_contact, ContactManifold& a_out)
+		{
+			Vector3 const& normal = a_contact.normal;
+
+			a_out.normal = normal;
+			a_out.count  = 0;
+
+			Vector3 axis = std::abs(normal.x) < 0.57f ? Vector3(1, 0, 0) : (std::abs(normal.y) < 0.57f ? Vector3(0, 1, 0) : Vector3(0, 0, 1));
+			Vector3 u    = Vector::Normalize(Vector::Cross(axis, normal));
+			Vector3 v    = Vector::Cross(normal, u);
+
+			Feature featureA, featureB;
+			WorldFeature(a_frameA, normal, u, v, featureA);
+			WorldFeature(a_frameB, -normal, u, v, featureB);
+
+			ContactPoint points[max_clip_points];
+			int          count = 0;
+
+			if (featureA.count >= 3 || featureB.count >= 3)
+			{
+				bool referenceIsA = Alignment(featureA, normal) >= Alignment(featureB, normal) - 0.01f;
+				count = referenceIsA
+					? ClipFeatures(featureA, featureB, true, normal, points)
+					: ClipFeatures(featureB, featureA, false, normal, points);
+			}
+			else if (featureA.count == 2 && featureB.count == 2)
+			{
+				Vector3 edgeA = featureA.points[1] - featureA.points[0];
+				Vector3 edgeB = featureB.points[1] - featureB.points[0];
+				Vector3 cross = Vector::Cross(edgeA, edgeB);
+
+				// Only parallel edges touch along a line, crossing ones touch at the EPA point
+				float const sine = feature_sin_tolerance * feature_sin_tolerance;
+				if (Vector::Dot(cross, cross) <= sine * Vector::Dot(edgeA, edgeA) * Vector::Dot(edgeB, edgeB))
+				{
+					count = ClipFeatures(featureA, featureB, true, normal, points);
+				}
+			}
+
+			if (count == 0)
+			{
+				points[0] = ContactPoint { (a_contact.pointA + a_contact.pointB) * 0.5f, a_contact.depth };
+				count     = 1;
+			}
+			ReduceManifold(points, count, normal, a_out);
+		}
+#pragma endregion
+	}
+
+	Vector3
+	Support(ConvexShape const& a_shape, Matrix4 const& a_transform, Vector3 const& a_direction)
+	{
+		Frame   frame  = MakeFrame(a_shape, a_transform);
+		Vector3 result = ToVector(CoreSupport(frame, ToSimd(a_direction)));
+
+		float magnitude = Vector::Magnitude(a_direction);
+		return magnitude > 0 ? result + a_direction * (frame.radius / magnitude) : result;
+	}
+
+	ClosestPoints
+	Distance(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB)
+	{
+		Frame frameA = MakeFrame(a_shapeA, a_transformA);
+		Frame frameB = MakeFrame(a_shapeB, a_transformB);
+
+		Simd::Float4 pointA, pointB;
+		GjkResult    gjk;
+		float        distance = CoreClosestPoints(frameA, frameB, pointA, pointB, &gjk);
+
+		ClosestPoints result;
+		result.pointA = ToVector(pointA);
+		result.pointB = ToVector(pointB);
+
+		float const radius = frameA.radius + frameB.radius;
+		if (distance <= radius)
+		{
+			Vector3 middle = (result.pointA + result.pointB) * 0.5f;
+			result.pointA   = middle;
+			result.pointB   = middle;
+			result.distance = 0;
+			return result;
+		}
+
+		Vector3 normal = (result.pointB - result.pointA) / distance;
+		result.pointA   = result.pointA + normal * frameA.radius;
+		result.pointB   = result.pointB - normal * frameB.radius;
+		result.distance = distance - radius;
+		return result;
+	}
+
+	bool
+	Overlaps(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB)
+	{
+		Frame frameA = MakeFrame(a_shapeA, a_transformA);
+		Frame frameB = MakeFrame(a_shapeB, a_transformB);
+
+		float const radius = frameA.radius + frameB.radius;
+		if (IsSegmentCore(a_shapeA) && IsSegmentCore(a_shapeB))
+		{
+			Simd::Float4 pointA, pointB;
+			GjkResult    unused;
+			return CoreClosestPoints(frameA, frameB, pointA, pointB, &unused) <= radius;
+		}
+
+		GjkResult gjk = Gjk(frameA, frameB, radius);
+		return gjk.overlapping || gjk.distance <= radius;
+	}
+
+	bool
+	Penetration(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB, Contact& a_out)
+	{
+		return FindContact(MakeFrame(a_shapeA, a_transformA), MakeFrame(a_shapeB, a_transformB), a_out);
+	}
+
+	bool
+	Collide(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB, ContactManifold& a_out)
+	{
+		Frame frameA = MakeFrame(a_shapeA, a_transformA);
+		Frame frameB = MakeFrame(a_shapeB, a_transformB);
+
+		Contact contact;
+		if (!FindContact(frameA, frameB, contact))
+		{
+			a_out.count = 0;
+			return false;
+		}
+		BuildManifold(frameA, frameB, contact, a_out);
+		return true;
+	}
+
+	void
+	DistanceBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, ClosestPoints* a_out)
+	{
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			CollisionPair const& pair = a_pairs[i];
+			a_out[i] = Distance(a_shapes[pair.a], a_transforms[pair.a], a_shapes[pair.b], a_transforms[pair.b]);
+		}
+	}
+
+	void
+	OverlapBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, bool* a_out)
+	{
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			CollisionPair const& pair = a_pairs[i];
+			a_out[i] = Overlaps(a_shapes[pair.a], a_transforms[pair.a], a_shapes[pair.b], a_transforms[pair.b]);
+		}
+	}
+
+	std::size_t
+	CollideBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, ContactManifold* a_out)
+	{
+		std::size_t result = 0;
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			CollisionPair const& pair = a_pairs[i];
+			result += Collide(a_shapes[pair.a], a_transforms[pair.a], a_shapes[pair.b], a_transforms[pair.b], a_out[i]);
+		}
+		return result;
+	}
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Bounds.h"
+#include "Matrix4.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	enum class ConvexType : uint8
+	{
+		Sphere,
+		Capsule,
+		Box,
+		Hull,
+		Triangle,
+	};
+
+	/**
+	 * \brief A convex shape in its local space, placed in the world by the Matrix4 passed next to it
+	 * \remarks Every shape is a core (a point, segment, box, point cloud or triangle) grown by radius in every
+	 *          direction, so spheres and capsules are a point and a segment with a radius, and any other shape
+	 *          can be rounded the same way. The queries work on the cores and add the radii afterwards where
+	 *          they can, which is both cheaper and more precise than treating the rounding as part of the shape.
+	 *      <br>Shapes are small and hold no allocations, a hull only points at a Vector3Stream owned elsewhere,
+	 *          which must outlive it.
+	 *      <br>Transforms may rotate, translate and scale uniformly, the radius is scaled by the length of the
+	 *          first row. Cores alone also handle non-uniform scale.
+	 */
+	struct ConvexShape
+	{
+		ConvexType type = ConvexType::Sphere;
+
+		/// Sphere center, capsule start, box half extents or first triangle vertex
+		Vector3 a;
+		/// Capsule end or second triangle vertex
+		Vector3 b;
+		/// Third triangle vertex
+		Vector3 c;
+
+		float radius = 0;
+
+		Vector3Stream const* hull = nullptr;
+
+		static
+		ConvexShape
+		FromSphere(Sphere const& a_sphere)
+		{
+			ConvexShape result;
+			result.type   = ConvexType::Sphere;
+			result.a      = a_sphere.center;
+			result.radius = a_sphere.radius;
+			return result;
+		}
+
+		static
+		ConvexShape
+		FromCapsule(Vector3 const& a_start, Vector3 const& a_end, float a_radius)
+		{
+			ConvexShape result;
+			result.type   = ConvexType::Capsule;
+			result.a      = a_start;
+			result.b      = a_end;
+			result.radius = a_radius;
+			return result;
+		}
+
+		/// \brief A box centered on the local origin
+		static
+		ConvexShape
+		FromBox(Vector3 const& a_extents, float a_radius = 0)
+		{
+			ConvexShape result;
+			result.type   = ConvexType::Box;
+			result.a      = a_extents;
+			result.radius = a_radius;
+			return result;
+		}
+
+		/// \brief The convex hull of a_points, which need not all be on the hull but must not be empty
+		static
+		ConvexShape
+		FromHull(Vector3Stream const& a_points, float a_radius = 0)
+		{
+			ConvexShape result;
+			result.type   = ConvexType::Hull;
+			result.hull   = &a_points;
+			result.radius = a_radius;
+			return result;
+		}
+
+		static
+		ConvexShape
+		FromTriangle(Vector3 const& a_a, Vector3 const& a_b, Vector3 const& a_c, float a_radius = 0)
+		{
+			ConvexShape result;
+			result.type   = ConvexType::Triangle;
+			result.a      = a_a;
+			result.b      = a_b;
+			result.c      = a_c;
+			result.radius = a_radius;
+			return result;
+		}
+	};
+
+	/// The closest points between two separated shapes, both points are equal when the shapes overlap
+	struct ClosestPoints
+	{
+		Vector3 pointA;
+		Vector3 pointB;
+		float   distance = 0;
+	};
+
+	/// The smallest translation that separates two overlapping shapes, moving B by normal * depth
+	struct Contact
+	{
+		/// Points from A towards B
+		Vector3 normal;
+		float   depth = 0;
+
+		/// The deepest point of A inside B and of B inside A, pointA - pointB == normal * depth
+		Vector3 pointA;
+		Vector3 pointB;
+	};
+
+	struct ContactPoint
+	{
+		/// Halfway between the two surfaces
+		Vector3 position;
+		float   depth = 0;
+	};
+
+	/// Up to four points that keep a resting pair stable, all sharing one normal from A towards B
+	struct ContactManifold
+	{
+		constexpr static int max_points = 4;
+
+		Vector3      normal;
+		int32        count = 0;
+		ContactPoint points[max_points];
+	};
+
+	/// Indices of two shapes, and of their transforms, in the arrays passed to the batch queries
+	struct CollisionPair
+	{
+		uint32 a;
+		uint32 b;
+	};
+}
+
+namespace Oyl::Collision
+{
+	/// \return The point of a_shape, placed by a_transform, furthest along a_direction in world space
+	OYL_CORE_API
+	extern
+	Vector3
+	Support(ConvexShape const& a_shape, Matrix4 const& a_transform, Vector3 const& a_direction);
+
+	/// \brief GJK distance between two shapes, see ClosestPoints
+	OYL_CORE_API
+	extern
+	ClosestPoints
+	Distance(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB);
+
+	/// \brief Boolean GJK, stops as soon as either a separating axis or an enclosing simplex is found
+	OYL_CORE_API
+	extern
+	bool
+	Overlaps(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB);
+
+	/**
+	 * \brief Penetration depth and direction of two overlapping shapes
+	 * \return False, leaving a_out untouched, if the shapes don't overlap
+	 * \remarks Rounded shapes whose cores are apart are resolved by GJK alone, only shapes whose cores overlap
+	 *          expand the GJK simplex with EPA. EPA works in fixed size buffers on the stack and gives up after
+	 *          a bounded number of iterations with the best face found so far.
+	 */
+	OYL_CORE_API
+	extern
+	bool
+	Penetration(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB, Contact& a_out);
+
+	/**
+	 * \brief Contact points of two overlapping shapes
+	 * \return False, with a_out.count set to 0, if the shapes don't overlap
+	 * \remarks Clips the features of both shapes facing each other along the penetration normal against one
+	 *          another, so a box resting on a face gets up to four points rather than one. Reduced to the deepest
+	 *          point and the three that span the largest area with it.
+	 */
+	OYL_CORE_API
+	extern
+	bool
+	Collide(ConvexShape const& a_shapeA, Matrix4 const& a_transformA, ConvexShape const& a_shapeB, Matrix4 const& a_transformB, ContactManifold& a_out);
+
+	/// \brief a_out[i] = Collision::Distance for shapes a_pairs[i].a and a_pairs[i].b
+	OYL_CORE_API
+	extern
+	void
+	DistanceBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, ClosestPoints* a_out);
+
+	/// \brief a_out[i] = Collision::Overlaps for shapes a_pairs[i].a and a_pairs[i].b
+	OYL_CORE_API
+	extern
+	void
+	OverlapBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, bool* a_out);
+
+	/**
+	 * \brief a_out[i] = Collision::Collide for shapes a_pairs[i].a and a_pairs[i].b, count is 0 for pairs apart
+	 * \return The number of pairs in contact
+	 * \remarks Pairs are independent, so a large batch can be split into ranges handled by different worker threads.
+	 */
+	OYL_CORE_API
+	extern
+	std::size_t
+	CollideBatch(ConvexShape const* a_shapes, Matrix4 const* a_transforms, CollisionPair const* a_pairs, std::size_t a_count, ContactManifold* a_out);
+}
@@ -6,7 +6,7 @@
 
 namespace Oyl::Math
 {
-	constexpr float PI = 3.1415f;
+	constexpr float PI = 3.14159265358979323846f;
 
 	constexpr float DEG_TO_RAD = PI / 180.f;
 	constexpr float RAD_TO_DEG = 180.f / PI;
@@ -0,0 +1,385 @@
+#include "pch.h"
+#include "Curve.h"
+
+#include "Simd.h"
+
+namespace Oyl::Curve
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+
+		Simd::Float8
+		LoadPartial(float const* a_src, std::size_t a_count)
+		{
+			if (a_count == block_size)
+			{
+				return Simd::Load8(a_src);
+			}
+
+			alignas(32) float lanes[block_size] = {};
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				lanes[i] = a_src[i];
+			}
+			return Simd::Load8(lanes);
+		}
+
+		/// Writes the first a_count lanes of the components to a_dst as Components floats per element
+		template<int Components>
+		void
+		StoreInterleaved(float* a_dst, Simd::Float8 const (&a_components)[Components], std::size_t a_count)
+		{
+			alignas(32) float lanes[Components][block_size];
+			for (int c = 0; c < Components; c++)
+			{
+				Simd::Store(lanes[c], a_components[c]);
+			}
+
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				for (int c = 0; c < Components; c++)
+				{
+					a_dst[i * Components + c] = lanes[c][i];
+				}
+			}
+		}
+
+		/// One control value in the first Components lanes, without reading past it
+		template<int Components>
+		OYL_FORCE_INLINE
+		Simd::Float4
+		LoadRow(float const* a_src)
+		{
+			if constexpr (Components == 4)
+			{
+				return Simd::Load(a_src);
+			}
+			else if constexpr (Components == 3)
+			{
+				return Simd::Load3(a_src);
+			}
+			else if constexpr (Components == 2)
+			{
+				return Simd::Set(a_src[0], a_src[1], 0, 0);
+			}
+			else
+			{
+				return Simd::Set(a_src[0], 0, 0, 0);
+			}
+		}
+
+		/**
+		 * Loads the four control values starting at each of a_sources into SoA form, a_keys[k][c] holding component c
+		 * of control value k for every lane. Transposing whole rows keeps the gather in registers, filling the lanes
+		 * through memory instead stalls every load on store forwarding.
+		 */
+		template<int Components>
+		OYL_FORCE_INLINE
+		void
+		GatherKeys(float const* const (&a_sources)[block_size], Simd::Float8 (&a_keys)[4][Components])
+		{
+			Simd::Float4 rows[block_size];
+			if constexpr (Components == 1)
+			{
+				// The four control values of a scalar segment make up one row
+				for (std::size_t lane = 0; lane < block_size; lane++)
+				{
+					rows[lane] = Simd::Load(a_sources[lane]);
+				}
+				Simd::Transpose(rows[0], rows[1], rows[2], rows[3]);
+				Simd::Transpose(rows[4], rows[5], rows[6], rows[7]);
+
+				for (int k = 0; k < 4; k++)
+				{
+					a_keys[k][0] = Simd::Combine(rows[k], rows[4 + k]);
+				}
+			}
+			else
+			{
+				for (int k = 0; k < 4; k++)
+				{
+					for (std::size_t lane = 0; lane < block_size; lane++)
+					{
+						rows[lane] = LoadRow<Components>(a_sources[lane] + k * Components);
+					}
+					Simd::Transpose(rows[0], rows[1], rows[2], rows[3]);
+					Simd::Transpose(rows[4], rows[5], rows[6], rows[7]);
+
+					for (int c = 0; c < Components; c++)
+					{
+						a_keys[k][c] = Simd::Combine(rows[c], rows[4 + c]);
+					}
+				}
+			}
+		}
+
+		/// The same polynomials as Curve::Weights, eight parameters at a time
+		template<Basis TBasis>
+		OYL_FORCE_INLINE
+		void
+		BlockWeights(Simd::Float8 a_t, Simd::Float8 (&a_weights)[4])
+		{
+			Simd::Float8 const t  = a_t;
+			Simd::Float8 const t2 = Simd::Mul(t, t);
+			Simd::Float8 const t3 = Simd::Mul(t2, t);
+
+			auto polynomial = [&](float a_cubic, float a_square, float a_linear, float a_constant)
+			{
+				Simd::Float8 result = Simd::Mul(t3, Simd::Splat8(a_cubic));
+				result = Simd::MulAdd(t2, Simd::Splat8(a_square), result);
+				result = Simd::MulAdd(t, Simd::Splat8(a_linear), result);
+				return Simd::Add(result, Simd::Splat8(a_constant));
+			};
+
+			if constexpr (TBasis == Basis::Bezier)
+			{
+				Simd::Float8 u  = Simd::Sub(Simd::Splat8(1.0f), t);
+				Simd::Float8 u2 = Simd::Mul(u, u);
+				a_weights[0] = Simd::Mul(u2, u);
+				a_weights[1] = Simd::Mul(Simd::Mul(u2, t), Simd::Splat8(3.0f));
+				a_weights[2] = Simd::Mul(Simd::Mul(u, t2), Simd::Splat8(3.0f));
+				a_weights[3] = t3;
+			}
+			else if constexpr (TBasis == Basis::CatmullRom)
+			{
+				a_weights[0] = polynomial(-0.5f, 1.0f, -0.5f, 0.0f);
+				a_weights[1] = polynomial(1.5f, -2.5f, 0.0f, 1.0f);
+				a_weights[2] = polynomial(-1.5f, 2.0f, 0.5f, 0.0f);
+				a_weights[3] = polynomial(0.5f, -0.5f, 0.0f, 0.0f);
+			}
+			else if constexpr (TBasis == Basis::Hermite)
+			{
+				a_weights[0] = polynomial(2.0f, -3.0f, 0.0f, 1.0f);
+				a_weights[1] = polynomial(1.0f, -2.0f, 1.0f, 0.0f);
+				a_weights[2] = polynomial(-2.0f, 3.0f, 0.0f, 0.0f);
+				a_weights[3] = polynomial(1.0f, -1.0f, 0.0f, 0.0f);
+			}
+			else
+			{
+				constexpr float sixth = 1.0f / 6.0f;
+				a_weights[0] = polynomial(-sixth, 0.5f, -0.5f, sixth);
+				a_weights[1] = polynomial(0.5f, -1.0f, 0.0f, 4.0f * sixth);
+				a_weights[2] = polynomial(-0.5f, 0.5f, 0.5f, sixth);
+				a_weights[3] = Simd::Mul(t3, Simd::Splat8(sixth));
+			}
+		}
+
+		/// Flips the weights of the keys on the other hemisphere than key 1, which is the same as flipping the keys
+		OYL_FORCE_INLINE
+		void
+		AlignHemispheres(Simd::Float8 const (&a_keys)[4][4], Simd::Float8 (&a_weights)[4])
+		{
+			for (int k : { 0, 2, 3 })
+			{
+				Simd::Float8 dot = Simd::Mul(a_keys[k][0], a_keys[1][0]);
+				for (int c = 1; c < 4; c++)
+				{
+					dot = Simd::MulAdd(a_keys[k][c], a_keys[1][c], dot);
+				}
+				a_weights[k] = Simd::FlipSign(a_weights[k], dot);
+			}
+		}
+
+		OYL_FORCE_INLINE
+		void
+		NormalizeBlock(Simd::Float8 (&a_components)[4])
+		{
+			Simd::Float8 magnitudeSquared = Simd::Mul(a_components[0], a_components[0]);
+			for (int c = 1; c < 4; c++)
+			{
+				magnitudeSquared = Simd::MulAdd(a_components[c], a_components[c], magnitudeSquared);
+			}
+
+			Simd::Float8 isZero    = Simd::Equal(magnitudeSquared, Simd::Zero8());
+			Simd::Float8 magnitude = Simd::Sqrt(magnitudeSquared);
+			for (int c = 0; c < 4; c++)
+			{
+				a_components[c] = Simd::Select(isZero, a_components[c], Simd::Div(a_components[c], magnitude));
+			}
+		}
+
+		/**
+		 * Evaluates a_sampleCount samples of the curve through a_values, Components floats per control value,
+		 * handing a_store the index of each block of eight, the number of valid lanes and the components.
+		 * Segments are located in SIMD, then the four control values of every lane's segment are loaded as rows and
+		 * transposed into SoA form, as the Simd layer has no gather.
+		 */
+		template<Basis TBasis, int Components, bool IsRotation, typename TStore>
+		void
+		SampleKernel(float const* a_values, std::size_t a_count, float const* a_t, std::size_t a_sampleCount, TStore&& a_store)
+		{
+			std::size_t segmentCount = SegmentCount(TBasis, a_count);
+			OYL_ASSERT(segmentCount > 0);
+
+			std::size_t const segmentStride = SegmentStride(TBasis) * Components;
+
+			Simd::Float8 const scale       = Simd::Splat8(static_cast<float>(segmentCount));
+			Simd::Float8 const lastSegment = Simd::Splat8(static_cast<float>(segmentCount - 1));
+
+			for (std::size_t i = 0; i < a_sampleCount; i += block_size)
+			{
+				std::size_t valid = a_sampleCount - i < block_size ? a_sampleCount - i : block_size;
+
+				// Same steps as Curve::Locate, Max first so NaN parameters land on the first segment
+				Simd::Float8 t        = Simd::Min(Simd::Max(LoadPartial(a_t + i, valid), Simd::Zero8()), Simd::Splat8(1.0f));
+				Simd::Float8 position = Simd::Mul(t, scale);
+				Simd::Float8 segment  = Simd::Min(Simd::ConvertToFloat(Simd::TruncateToInt(position)), lastSegment);
+				Simd::Float8 local    = Simd::Sub(position, segment);
+
+				alignas(32) std::int32_t segments[block_size];
+				Simd::Store(segments, Simd::TruncateToInt(segment));
+
+				float const* sources[block_size];
+				for (std::size_t lane = 0; lane < block_size; lane++)
+				{
+					sources[lane] = a_values + static_cast<std::size_t>(segments[lane]) * segmentStride;
+				}
+
+				Simd::Float8 keys[4][Components];
+				GatherKeys<Components>(sources, keys);
+
+				Simd::Float8 weights[4];
+				BlockWeights<TBasis>(local, weights);
+				if constexpr (IsRotation)
+				{
+					AlignHemispheres(keys, weights);
+				}
+
+				Simd::Float8 result[Components];
+				for (int c = 0; c < Components; c++)
+				{
+					result[c] = Simd::Mul(keys[0][c], weights[0]);
+					for (int k = 1; k < 4; k++)
+					{
+						result[c] = Simd::MulAdd(keys[k][c], weights[k], result[c]);
+					}
+				}
+				if constexpr (IsRotation)
+				{
+					NormalizeBlock(result);
+				}
+
+				a_store(i, valid, result);
+			}
+		}
+
+		/// Resolves a_basis once per call rather than once per block
+		template<int Components, bool IsRotation = false, typename TStore>
+		void
+		Sample(Basis a_basis, float const* a_values, std::size_t a_count, float const* a_t, std::size_t a_sampleCount, TStore&& a_store)
+		{
+			switch (a_basis)
+			{
+				case Basis::Bezier:
+					SampleKernel<Basis::Bezier, Components, IsRotation>(a_values, a_count, a_t, a_sampleCount, a_store);
+					break;
+				case Basis::CatmullRom:
+					SampleKernel<Basis::CatmullRom, Components, IsRotation>(a_values, a_count, a_t, a_sampleCount, a_store);
+					break;
+				case Basis::Hermite:
+					SampleKernel<Basis::Hermite, Components, IsRotation>(a_values, a_count, a_t, a_sampleCount, a_store);
+					break;
+				case Basis::BSpline:
+					SampleKernel<Basis::BSpline, Components, IsRotation>(a_values, a_count, a_t, a_sampleCount, a_store);
+					break;
+			}
+		}
+
+		template<int Components>
+		void
+		SampleInterleaved(Basis a_basis, float const* a_values, std::size_t a_count, float const* a_t, float* a_out, std::size_t a_sampleCount)
+		{
+			Sample<Components>(a_basis, a_values, a_count, a_t, a_sampleCount, [&](std::size_t a_index, std::size_t a_valid, Simd::Float8 const (&a_result)[Components])
+			{
+				StoreInterleaved(a_out + a_index * Components, a_result, a_valid);
+			});
+		}
+	}
+
+	void
+	SampleBatch(Basis a_basis, float const* a_values, std::size_t a_count, float const* a_t, float* a_out, std::size_t a_sampleCount)
+	{
+		SampleInterleaved<1>(a_basis, a_values, a_count, a_t, a_out, a_sampleCount);
+	}
+
+	void
+	SampleBatch(Basis a_basis, Vector2 const* a_values, std::size_t a_count, float const* a_t, Vector2* a_out, std::size_t a_sampleCount)
+	{
+		SampleInterleaved<2>(a_basis, a_values->data, a_count, a_t, a_out->data, a_sampleCount);
+	}
+
+	void
+	SampleBatch(Basis a_basis, Vector3 const* a_values, std::size_t a_count, float const* a_t, Vector3* a_out, std::size_t a_sampleCount)
+	{
+		SampleInterleaved<3>(a_basis, a_values->data, a_count, a_t, a_out->data, a_sampleCount);
+	}
+
+	void
+	SampleBatch(Basis a_basis, Vector3 const* a_values, std::size_t a_count, float const* a_t, Vector3Stream& a_out, std::size_t a_sampleCount)
+	{
+		a_out.Resize(a_sampleCount);
+
+		// The padding lanes are unspecified, so whole blocks are stored
+		Sample<3>(a_basis, a_values->data, a_count, a_t, a_sampleCount, [&](std::size_t a_index, std::size_t, Simd::Float8 const (&a_result)[3])
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				Simd::Store(a_out.Component(c) + a_index, a_result[c]);
+			}
+		});
+	}
+
+	void
+	SampleBatch(Basis a_basis, Vector4 const* a_values, std::size_t a_count, float const* a_t, Vector4* a_out, std::size_t a_sampleCount)
+	{
+		SampleInterleaved<4>(a_basis, a_values->data, a_count, a_t, a_out->data, a_sampleCount);
+	}
+
+	void
+	SampleBatch(Basis a_basis, Quaternionf const* a_values, std::size_t a_count, float const* a_t, Quaternionf* a_out, std::size_t a_sampleCount)
+	{
+		OYL_ASSERT(a_basis != Basis::Hermite);
+
+		Sample<4, true>(a_basis, a_values->data, a_count, a_t, a_sampleCount, [&](std::size_t a_index, std::size_t a_valid, Simd::Float8 const (&a_result)[4])
+		{
+			StoreInterleaved(a_out->data + a_index * 4, a_result, a_valid);
+		});
+	}
+
+	void
+	ParameterBatch(ArcLengthTable const& a_table, float const* a_distances, float* a_out, std::size_t a_count)
+	{
+		OYL_ASSERT(a_table.Resolution() > 0);
+
+		float const* lengths = a_table.Lengths();
+		float const  length  = a_table.Length();
+
+		// Keeps lengths[chord] <= distance < lengths[chord + 1] between iterations
+		std::size_t chord = 0;
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			float distance = a_distances[i];
+			if (distance <= 0)
+			{
+				a_out[i] = 0;
+				continue;
+			}
+			if (distance >= length)
+			{
+				a_out[i] = 1;
+				continue;
+			}
+
+			if (distance < lengths[chord])
+			{
+				chord = a_table.Chord(distance);
+			}
+			while (lengths[chord + 1] <= distance)
+			{
+				chord++;
+			}
+			a_out[i] = a_table.ParameterInChord(chord, distance);
+		}
+	}
+}
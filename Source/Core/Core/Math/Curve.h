@@ -0,0 +1,383 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Quaternion.h"
+#include "Vector.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+
+namespace Oyl::Curve
+{
+	/// \brief The cubic bases below, each segment of a curve is weighted from four consecutive control values
+	enum class Basis
+	{
+		/// Passes through the first and last value, the middle two pull on the curve like handles
+		Bezier,
+		/// Passes through the middle two values, the outer two only shape the tangents. Uniform, tension 0.5
+		CatmullRom,
+		/// Values and tangents interleaved as p0, m0, p1, m1
+		Hermite,
+		/// Uniform cubic B-spline, continuous up to the second derivative but passes through none of the values
+		BSpline,
+	};
+
+	/**
+	 * \return How many control values apart consecutive segments of a_basis start
+	 * \remarks Bezier segments share their end points, Hermite segments share a value and tangent pair,
+	 *          Catmull-Rom and B-spline segments slide along by one.
+	 */
+	constexpr
+	std::size_t
+	SegmentStride(Basis a_basis)
+	{
+		switch (a_basis)
+		{
+			case Basis::Bezier:  return 3;
+			case Basis::Hermite: return 2;
+			default:             return 1;
+		}
+	}
+
+	/// \return The number of segments in a curve of a_count control values, 0 if there are fewer than four
+	constexpr
+	std::size_t
+	SegmentCount(Basis a_basis, std::size_t a_count)
+	{
+		return a_count < 4 ? 0 : (a_count - 4) / SegmentStride(a_basis) + 1;
+	}
+
+	/// \return The weights of the four control values of a segment at a_t in [0, 1]
+	template<typename TScalar>
+	constexpr
+	Vector_t<4, TScalar>
+	Weights(Basis a_basis, TScalar a_t)
+	{
+		TScalar const t  = a_t;
+		TScalar const t2 = t * t;
+		TScalar const t3 = t2 * t;
+		TScalar const u  = 1 - t;
+
+		switch (a_basis)
+		{
+			case Basis::Bezier:
+				return Vector_t<4, TScalar>(u * u * u, 3 * u * u * t, 3 * u * t2, t3);
+			case Basis::CatmullRom:
+				return Vector_t<4, TScalar>(-t3 + 2 * t2 - t, 3 * t3 - 5 * t2 + 2, -3 * t3 + 4 * t2 + t, t3 - t2) * static_cast<TScalar>(0.5);
+			case Basis::Hermite:
+				return Vector_t<4, TScalar>(2 * t3 - 3 * t2 + 1, t3 - 2 * t2 + t, -2 * t3 + 3 * t2, t3 - t2);
+			default:
+				return Vector_t<4, TScalar>(u * u * u, 3 * t3 - 6 * t2 + 4, -3 * t3 + 3 * t2 + 3 * t + 1, t3) * (static_cast<TScalar>(1) / 6);
+		}
+	}
+
+	/// \return The weights of the four control values in the derivative of a segment with respect to a_t
+	template<typename TScalar>
+	constexpr
+	Vector_t<4, TScalar>
+	DerivativeWeights(Basis a_basis, TScalar a_t)
+	{
+		TScalar const t  = a_t;
+		TScalar const t2 = t * t;
+		TScalar const u  = 1 - t;
+
+		switch (a_basis)
+		{
+			case Basis::Bezier:
+				return Vector_t<4, TScalar>(-u * u, u * u - 2 * u * t, 2 * u * t - t2, t2) * static_cast<TScalar>(3);
+			case Basis::CatmullRom:
+				return Vector_t<4, TScalar>(-3 * t2 + 4 * t - 1, 9 * t2 - 10 * t, -9 * t2 + 8 * t + 1, 3 * t2 - 2 * t) * static_cast<TScalar>(0.5);
+			case Basis::Hermite:
+				return Vector_t<4, TScalar>(6 * t2 - 6 * t, 3 * t2 - 4 * t + 1, -6 * t2 + 6 * t, 3 * t2 - 2 * t);
+			default:
+				return Vector_t<4, TScalar>(-u * u, 3 * t2 - 4 * t, -3 * t2 + 2 * t + 1, t2) * static_cast<TScalar>(0.5);
+		}
+	}
+
+	/**
+	 * \return The segment a_values[0..3] evaluated at a_t in [0, 1]
+	 * \remarks TValue is anything that can be scaled by TScalar and summed, ie. float or Vector_t<N, float>.
+	 *          Quaternions have their own overloads below that stay on the unit sphere.
+	 */
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	Evaluate(Basis a_basis, TScalar a_t, TValue const& a_p0, TValue const& a_p1, TValue const& a_p2, TValue const& a_p3)
+	{
+		Vector_t<4, TScalar> weights = Weights(a_basis, a_t);
+		return a_p0 * weights.data[0] + a_p1 * weights.data[1] + a_p2 * weights.data[2] + a_p3 * weights.data[3];
+	}
+
+	/// \return The derivative of the segment a_values[0..3] with respect to a_t, ie. the velocity along a rail
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	Tangent(Basis a_basis, TScalar a_t, TValue const& a_p0, TValue const& a_p1, TValue const& a_p2, TValue const& a_p3)
+	{
+		Vector_t<4, TScalar> weights = DerivativeWeights(a_basis, a_t);
+		return a_p0 * weights.data[0] + a_p1 * weights.data[1] + a_p2 * weights.data[2] + a_p3 * weights.data[3];
+	}
+
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	Bezier(TScalar a_t, TValue const& a_p0, TValue const& a_p1, TValue const& a_p2, TValue const& a_p3)
+	{
+		return Evaluate(Basis::Bezier, a_t, a_p0, a_p1, a_p2, a_p3);
+	}
+
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	CatmullRom(TScalar a_t, TValue const& a_p0, TValue const& a_p1, TValue const& a_p2, TValue const& a_p3)
+	{
+		return Evaluate(Basis::CatmullRom, a_t, a_p0, a_p1, a_p2, a_p3);
+	}
+
+	/// \brief The curve from a_p0 to a_p1 leaving with tangent a_m0 and arriving with tangent a_m1
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	Hermite(TScalar a_t, TValue const& a_p0, TValue const& a_m0, TValue const& a_p1, TValue const& a_m1)
+	{
+		return Evaluate(Basis::Hermite, a_t, a_p0, a_m0, a_p1, a_m1);
+	}
+
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	BSpline(TScalar a_t, TValue const& a_p0, TValue const& a_p1, TValue const& a_p2, TValue const& a_p3)
+	{
+		return Evaluate(Basis::BSpline, a_t, a_p0, a_p1, a_p2, a_p3);
+	}
+
+	// Spherical versions for rotations, the linear interpolations of the pyramid formulations of each basis
+	// replaced by Quaternion::Slerp. They move along great arcs between nearby keys rather than cutting through
+	// the sphere, and always return unit quaternions for unit inputs.
+
+	/// \brief Spherical Bezier through De Casteljau's algorithm (Shoemake)
+	template<typename TUnderlying>
+	Quaternion_t<TUnderlying>
+	Bezier(TUnderlying a_t, Quaternion_t<TUnderlying> const& a_q0, Quaternion_t<TUnderlying> const& a_q1, Quaternion_t<TUnderlying> const& a_q2, Quaternion_t<TUnderlying> const& a_q3)
+	{
+		Quaternion_t<TUnderlying> a = Quaternion::Slerp(a_t, a_q0, a_q1);
+		Quaternion_t<TUnderlying> b = Quaternion::Slerp(a_t, a_q1, a_q2);
+		Quaternion_t<TUnderlying> c = Quaternion::Slerp(a_t, a_q2, a_q3);
+		return Quaternion::Slerp(a_t, Quaternion::Slerp(a_t, a, b), Quaternion::Slerp(a_t, b, c));
+	}
+
+	/// \brief Spherical Catmull-Rom through the Barry-Goldman pyramid, passes through a_q1 and a_q2
+	template<typename TUnderlying>
+	Quaternion_t<TUnderlying>
+	CatmullRom(TUnderlying a_t, Quaternion_t<TUnderlying> const& a_q0, Quaternion_t<TUnderlying> const& a_q1, Quaternion_t<TUnderlying> const& a_q2, Quaternion_t<TUnderlying> const& a_q3)
+	{
+		Quaternion_t<TUnderlying> a = Quaternion::Slerp(a_t + 1, a_q0, a_q1);
+		Quaternion_t<TUnderlying> b = Quaternion::Slerp(a_t, a_q1, a_q2);
+		Quaternion_t<TUnderlying> c = Quaternion::Slerp(a_t - 1, a_q2, a_q3);
+		return Quaternion::Slerp(a_t, Quaternion::Slerp((a_t + 1) / 2, a, b), Quaternion::Slerp(a_t / 2, b, c));
+	}
+
+	/// \brief Spherical uniform B-spline through De Boor's algorithm
+	template<typename TUnderlying>
+	Quaternion_t<TUnderlying>
+	BSpline(TUnderlying a_t, Quaternion_t<TUnderlying> const& a_q0, Quaternion_t<TUnderlying> const& a_q1, Quaternion_t<TUnderlying> const& a_q2, Quaternion_t<TUnderlying> const& a_q3)
+	{
+		Quaternion_t<TUnderlying> a = Quaternion::Slerp((a_t + 2) / 3, a_q0, a_q1);
+		Quaternion_t<TUnderlying> b = Quaternion::Slerp((a_t + 1) / 3, a_q1, a_q2);
+		Quaternion_t<TUnderlying> c = Quaternion::Slerp(a_t / 3, a_q2, a_q3);
+		return Quaternion::Slerp(a_t, Quaternion::Slerp((a_t + 1) / 2, a, b), Quaternion::Slerp(a_t / 2, b, c));
+	}
+
+	/// \brief Dispatches to the spherical overloads above, Hermite is not defined for quaternion keys
+	template<typename TUnderlying>
+	Quaternion_t<TUnderlying>
+	Evaluate(Basis a_basis, TUnderlying a_t, Quaternion_t<TUnderlying> const& a_q0, Quaternion_t<TUnderlying> const& a_q1, Quaternion_t<TUnderlying> const& a_q2, Quaternion_t<TUnderlying> const& a_q3)
+	{
+		OYL_ASSERT(a_basis != Basis::Hermite);
+		switch (a_basis)
+		{
+			case Basis::Bezier:     return Bezier(a_t, a_q0, a_q1, a_q2, a_q3);
+			case Basis::CatmullRom: return CatmullRom(a_t, a_q0, a_q1, a_q2, a_q3);
+			default:                return BSpline(a_t, a_q0, a_q1, a_q2, a_q3);
+		}
+	}
+
+	/**
+	 * \brief Maps a_t in [0, 1] over a whole curve to one of its segments
+	 * \param a_segment Receives the index of the segment, in [0, a_segmentCount)
+	 * \return The parameter within the segment, every segment spans an equal share of a_t
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Locate(TScalar a_t, std::size_t a_segmentCount, std::size_t& a_segment)
+	{
+		TScalar clamped  = a_t < 0 ? 0 : (a_t > 1 ? 1 : a_t);
+		TScalar position = clamped * static_cast<TScalar>(a_segmentCount);
+
+		a_segment = static_cast<std::size_t>(position);
+		if (a_segment >= a_segmentCount)
+		{
+			a_segment = a_segmentCount - 1;
+		}
+		return position - static_cast<TScalar>(a_segment);
+	}
+
+	/**
+	 * \return The curve through a_values evaluated at a_t in [0, 1] across all its segments
+	 * \remarks a_count needs to be at least 4, see SegmentCount. Values outside [0, 1] are clamped.
+	 */
+	template<typename TScalar, typename TValue>
+	constexpr
+	TValue
+	Sample(Basis a_basis, TValue const* a_values, std::size_t a_count, TScalar a_t)
+	{
+		std::size_t segmentCount = SegmentCount(a_basis, a_count);
+		OYL_ASSERT(segmentCount > 0);
+
+		std::size_t segment;
+		TScalar     t      = Locate(a_t, segmentCount, segment);
+		TValue const* values = a_values + segment * SegmentStride(a_basis);
+		return Evaluate(a_basis, t, values[0], values[1], values[2], values[3]);
+	}
+
+	/**
+	 * \brief Cumulative lengths of a curve at evenly spaced parameters, to move along it at constant speed
+	 * \remarks Parameters map to distance unevenly on most curves, so stepping a_t by a constant makes a camera
+	 *          rail speed up and slow down. Parameter inverts the table to fix that.
+	 *      <br>The curve is approximated by a_resolution chords, so the error shrinks with the square of it.
+	 */
+	class ArcLengthTable
+	{
+	public:
+		ArcLengthTable() = default;
+
+		/// \param a_curve Any callable returning the point at a parameter in [0, 1], ie. a lambda around Sample
+		template<typename TCurve, std::enable_if_t<!std::is_same_v<std::decay_t<TCurve>, ArcLengthTable>, bool> = true>
+		explicit
+		ArcLengthTable(TCurve&& a_curve, std::size_t a_resolution = 64)
+		{
+			OYL_ASSERT(a_resolution > 0);
+
+			m_lengths.resize(a_resolution + 1);
+			m_lengths[0] = 0;
+
+			auto previous = a_curve(0.0f);
+			for (std::size_t i = 1; i <= a_resolution; i++)
+			{
+				auto current = a_curve(static_cast<float>(i) / static_cast<float>(a_resolution));
+				m_lengths[i] = m_lengths[i - 1] + Vector::Magnitude(current - previous);
+				previous     = current;
+			}
+		}
+
+		float Length() const { return m_lengths.empty() ? 0.0f : m_lengths.back(); }
+
+		std::size_t Resolution() const { return m_lengths.empty() ? 0 : m_lengths.size() - 1; }
+
+		/// \return The cumulative length at each of the Resolution() + 1 sampled parameters
+		float const* Lengths() const { return m_lengths.data(); }
+
+		/// \return The parameter a_distance along the curve, distances outside [0, Length()] are clamped
+		float
+		Parameter(float a_distance) const
+		{
+			OYL_ASSERT(!m_lengths.empty());
+
+			if (a_distance <= 0)
+			{
+				return 0;
+			}
+			if (a_distance >= Length())
+			{
+				return 1;
+			}
+			return ParameterInChord(Chord(a_distance), a_distance);
+		}
+
+		/// \return The index of the chord a_distance falls on, a_distance needs to be in (0, Length())
+		std::size_t
+		Chord(float a_distance) const
+		{
+			// Lengths never decrease, so keep m_lengths[low] <= a_distance < m_lengths[high]
+			std::size_t low  = 0;
+			std::size_t high = m_lengths.size() - 1;
+			while (high - low > 1)
+			{
+				std::size_t middle = (low + high) / 2;
+				(m_lengths[middle] <= a_distance ? low : high) = middle;
+			}
+			return low;
+		}
+
+		/// \return The parameter a_distance along the curve, which falls on chord a_chord
+		float
+		ParameterInChord(std::size_t a_chord, float a_distance) const
+		{
+			float chord    = m_lengths[a_chord + 1] - m_lengths[a_chord];
+			float fraction = chord > 0 ? (a_distance - m_lengths[a_chord]) / chord : 0;
+			return (static_cast<float>(a_chord) + fraction) / static_cast<float>(Resolution());
+		}
+
+	private:
+		std::vector<float> m_lengths;
+	};
+}
+
+namespace Oyl::Curve
+{
+	// Batched sampling of a whole curve, a_out[i] = Sample(a_basis, a_values, a_count, a_t[i]).
+	// Evaluates eight samples per iteration, so thousands of samples of the same curve (particle trails, animation
+	// channels, a camera rail's preview) cost a fraction of calling Sample per element.
+	// a_count needs to be at least 4, see SegmentCount.
+
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, float const* a_values, std::size_t a_count, float const* a_t, float* a_out, std::size_t a_sampleCount);
+
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, Vector2 const* a_values, std::size_t a_count, float const* a_t, Vector2* a_out, std::size_t a_sampleCount);
+
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, Vector3 const* a_values, std::size_t a_count, float const* a_t, Vector3* a_out, std::size_t a_sampleCount);
+
+	/// \brief Resizes a_out to a_sampleCount and samples straight into its components
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, Vector3 const* a_values, std::size_t a_count, float const* a_t, Vector3Stream& a_out, std::size_t a_sampleCount);
+
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, Vector4 const* a_values, std::size_t a_count, float const* a_t, Vector4* a_out, std::size_t a_sampleCount);
+
+	/**
+	 * \brief Blends the keys with the weights of a_basis and normalizes, Hermite is not defined for quaternion keys
+	 * \remarks Keys are flipped onto the hemisphere of the segment's second key first, so it takes the short way.
+	 *          This follows the spherical Sample closely while neighbouring keys are well under 90 degrees apart,
+	 *          as is the case for sampled animation, but it is not the same curve.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(Basis a_basis, Quaternionf const* a_values, std::size_t a_count, float const* a_t, Quaternionf* a_out, std::size_t a_sampleCount);
+
+	/**
+	 * \brief a_out[i] = a_table.Parameter(a_distances[i])
+	 * \remarks Walks the table instead of searching it while a_distances increase, so evenly spaced points along
+	 *          a rail cost O(a_count + resolution) rather than a binary search each.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	ParameterBatch(ArcLengthTable const& a_table, float const* a_distances, float* a_out, std::size_t a_count);
+}
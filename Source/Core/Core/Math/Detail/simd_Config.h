@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Core/Common.h"
+
+/**
+ * Instruction set used by the math library.
+ * 
+ * Selected automatically from the target architecture, unless OYL_SIMD is defined beforehand.
+ * Define OYL_MATH_SCALAR=1 (or generate with --scalar-math) to force the portable scalar loops,
+ * eg. to compare results or timings against the SIMD paths.
+ */
+#define OYL_SIMD_SCALAR 0
+#define OYL_SIMD_SSE2   1
+#define OYL_SIMD_AVX    2
+#define OYL_SIMD_NEON   3
+
+#if !defined(OYL_SIMD)
+#	if defined(OYL_MATH_SCALAR) && OYL_MATH_SCALAR
+#		define OYL_SIMD OYL_SIMD_SCALAR
+#	elif defined(__AVX__)
+#		define OYL_SIMD OYL_SIMD_AVX
+#	elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define OYL_SIMD OYL_SIMD_SSE2
+#	elif defined(__aarch64__) || defined(_M_ARM64)
+#		define OYL_SIMD OYL_SIMD_NEON
+#	else
+#		define OYL_SIMD OYL_SIMD_SCALAR
+#	endif
+#endif
+
+#define OYL_SIMD_X86 (OYL_SIMD == OYL_SIMD_SSE2 || OYL_SIMD == OYL_SIMD_AVX)
+
+// 256-bit integer instructions, without them Int8 is emulated with two Int4 halves
+#if !defined(OYL_SIMD_AVX2)
+#	if OYL_SIMD == OYL_SIMD_AVX && defined(__AVX2__)
+#		define OYL_SIMD_AVX2 1
+#	else
+#		define OYL_SIMD_AVX2 0
+#	endif
+#endif
+
+/**
+ * Define OYL_MATH_DETERMINISTIC=1 (or generate with --deterministic-math) for float results that only depend on
+ * the source and the SIMD backend, ie. the same between an FMA and a non-FMA machine running the same backend.
+ * It disables FMA below, and the premake option also turns off FMA contraction and routes trigonometry through
+ * Math::Fast instead of libm. Bit-identical results across backends and compilers need Fixed_t instead.
+ */
+#if !defined(OYL_MATH_DETERMINISTIC)
+#	define OYL_MATH_DETERMINISTIC 0
+#endif
+
+// Fused multiply-add changes rounding, so only use it when the compiler was explicitly told it's available
+#if !defined(OYL_SIMD_FMA)
+#	if OYL_SIMD_X86 && (defined(__FMA__) || defined(__AVX2__)) && !OYL_MATH_DETERMINISTIC
+#		define OYL_SIMD_FMA 1
+#	else
+#		define OYL_SIMD_FMA 0
+#	endif
+#endif
+
+// Hardware half <-> float conversion, MSVC has no __F16C__ but every AVX2 capable CPU also has F16C
+#if !defined(OYL_SIMD_F16C)
+#	if OYL_SIMD == OYL_SIMD_AVX && (defined(__F16C__) || defined(__AVX2__))
+#		define OYL_SIMD_F16C 1
+#	else
+#		define OYL_SIMD_F16C 0
+#	endif
+#endif
+
+#if OYL_SIMD_X86
+#	include <immintrin.h>
+#elif OYL_SIMD == OYL_SIMD_NEON
+#	include <arm_neon.h>
+#endif
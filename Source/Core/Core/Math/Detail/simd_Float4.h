@@ -0,0 +1,600 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "simd_Config.h"
+
+namespace Oyl::Simd
+{
+	/**
+	 * \brief Four packed single precision floats, mapped to the native register type of the selected backend
+	 * \remarks Lanes are referred to as x, y, z, w in memory order.
+	 *          All Load and Store functions accept unaligned pointers.
+	 */
+#if OYL_SIMD_X86
+	using Float4 = __m128;
+#elif OYL_SIMD == OYL_SIMD_NEON
+	using Float4 = float32x4_t;
+#else
+	struct Float4
+	{
+		float lanes[4];
+	};
+#endif
+
+#if OYL_SIMD_X86
+	OYL_FORCE_INLINE Float4 Zero() { return _mm_setzero_ps(); }
+
+	OYL_FORCE_INLINE Float4 Splat(float a_value) { return _mm_set1_ps(a_value); }
+
+	OYL_FORCE_INLINE Float4 Set(float a_x, float a_y, float a_z, float a_w) { return _mm_setr_ps(a_x, a_y, a_z, a_w); }
+
+	OYL_FORCE_INLINE Float4 Load(float const* a_src) { return _mm_loadu_ps(a_src); }
+
+	/// Loads three floats into x, y, z without touching memory past a_src[2]. w is set to zero.
+	OYL_FORCE_INLINE
+	Float4
+	Load3(float const* a_src)
+	{
+		// _mm_loadl_pi/_mm_storel_pi go through __m64, which unlike double* is allowed to alias float
+		__m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<__m64 const*>(a_src));
+		__m128 z  = _mm_load_ss(a_src + 2);
+		return _mm_movelh_ps(xy, z);
+	}
+
+	OYL_FORCE_INLINE void Store(float* a_dst, Float4 a_value) { _mm_storeu_ps(a_dst, a_value); }
+
+	/// Stores x, y, z without touching memory past a_dst[2]
+	OYL_FORCE_INLINE
+	void
+	Store3(float* a_dst, Float4 a_value)
+	{
+		_mm_storel_pi(reinterpret_cast<__m64*>(a_dst), a_value);
+		_mm_store_ss(a_dst + 2, _mm_movehl_ps(a_value, a_value));
+	}
+
+	OYL_FORCE_INLINE float GetX(Float4 a_value) { return _mm_cvtss_f32(a_value); }
+
+	OYL_FORCE_INLINE Float4 Add(Float4 a_lhs, Float4 a_rhs) { return _mm_add_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Sub(Float4 a_lhs, Float4 a_rhs) { return _mm_sub_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Mul(Float4 a_lhs, Float4 a_rhs) { return _mm_mul_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Div(Float4 a_lhs, Float4 a_rhs) { return _mm_div_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Min(Float4 a_lhs, Float4 a_rhs) { return _mm_min_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Max(Float4 a_lhs, Float4 a_rhs) { return _mm_max_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Sqrt(Float4 a_value) { return _mm_sqrt_ps(a_value); }
+
+	OYL_FORCE_INLINE Float4 Negate(Float4 a_value) { return _mm_xor_ps(a_value, _mm_set1_ps(-0.0f)); }
+
+	OYL_FORCE_INLINE Float4 Abs(Float4 a_value) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a_value); }
+
+	/// \return a_value with its sign flipped in every lane where a_sign has its sign bit set
+	OYL_FORCE_INLINE
+	Float4
+	FlipSign(Float4 a_value, Float4 a_sign)
+	{
+		return _mm_xor_ps(a_value, _mm_and_ps(a_sign, _mm_set1_ps(-0.0f)));
+	}
+
+	/// \return An approximation of 1 / sqrt(a_value) with a relative error of at most 1.5 * 2^-12
+	OYL_FORCE_INLINE Float4 RSqrtEstimate(Float4 a_value) { return _mm_rsqrt_ps(a_value); }
+
+	/// \return a_value rounded to the nearest integer, ties to even
+	OYL_FORCE_INLINE
+	Float4
+	Round(Float4 a_value)
+	{
+	#if OYL_SIMD == OYL_SIMD_AVX
+		return _mm_round_ps(a_value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	#else
+		// Only exact for |a_value| < 2^31, larger floats have no fractional part anyway
+		__m128 rounded = _mm_cvtepi32_ps(_mm_cvtps_epi32(a_value));
+		__m128 isLarge = _mm_cmpge_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a_value), _mm_set1_ps(2147483648.0f));
+		return _mm_or_ps(_mm_and_ps(isLarge, a_value), _mm_andnot_ps(isLarge, rounded));
+	#endif
+	}
+
+	// Comparisons return a mask with all bits set in the lanes where the comparison holds
+
+	OYL_FORCE_INLINE Float4 Equal(Float4 a_lhs, Float4 a_rhs) { return _mm_cmpeq_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Less(Float4 a_lhs, Float4 a_rhs) { return _mm_cmplt_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 LessEqual(Float4 a_lhs, Float4 a_rhs) { return _mm_cmple_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Greater(Float4 a_lhs, Float4 a_rhs) { return _mm_cmpgt_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 And(Float4 a_lhs, Float4 a_rhs) { return _mm_and_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Or(Float4 a_lhs, Float4 a_rhs) { return _mm_or_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Xor(Float4 a_lhs, Float4 a_rhs) { return _mm_xor_ps(a_lhs, a_rhs); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Float4
+	Select(Float4 a_mask, Float4 a_ifTrue, Float4 a_ifFalse)
+	{
+	#if OYL_SIMD == OYL_SIMD_AVX
+		return _mm_blendv_ps(a_ifFalse, a_ifTrue, a_mask);
+	#else
+		return _mm_or_ps(_mm_and_ps(a_mask, a_ifTrue), _mm_andnot_ps(a_mask, a_ifFalse));
+	#endif
+	}
+
+	/// \return The sign bit of each lane packed into the low 4 bits, lane 0 in bit 0
+	OYL_FORCE_INLINE int MoveMask(Float4 a_mask) { return _mm_movemask_ps(a_mask); }
+
+	/// \return a_a * a_b + a_c
+	OYL_FORCE_INLINE
+	Float4
+	MulAdd(Float4 a_a, Float4 a_b, Float4 a_c)
+	{
+	#if OYL_SIMD_FMA
+		return _mm_fmadd_ps(a_a, a_b, a_c);
+	#else
+		return _mm_add_ps(_mm_mul_ps(a_a, a_b), a_c);
+	#endif
+	}
+
+	/// \return A vector whose lanes are taken from a_value at the given lane indices
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle(Float4 a_value)
+	{
+		return _mm_shuffle_ps(a_value, a_value, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	/// \return (a_lo[X], a_lo[Y], a_hi[Z], a_hi[W])
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle2(Float4 a_lo, Float4 a_hi)
+	{
+		return _mm_shuffle_ps(a_lo, a_hi, _MM_SHUFFLE(W, Z, Y, X));
+	}
+
+	OYL_FORCE_INLINE
+	bool
+	AllEqual(Float4 a_lhs, Float4 a_rhs)
+	{
+		return _mm_movemask_ps(_mm_cmpeq_ps(a_lhs, a_rhs)) == 0xF;
+	}
+
+	OYL_FORCE_INLINE
+	void
+	Transpose(Float4& a_row0, Float4& a_row1, Float4& a_row2, Float4& a_row3)
+	{
+		_MM_TRANSPOSE4_PS(a_row0, a_row1, a_row2, a_row3);
+	}
+#elif OYL_SIMD == OYL_SIMD_NEON
+	OYL_FORCE_INLINE Float4 Zero() { return vdupq_n_f32(0.0f); }
+
+	OYL_FORCE_INLINE Float4 Splat(float a_value) { return vdupq_n_f32(a_value); }
+
+	OYL_FORCE_INLINE
+	Float4
+	Set(float a_x, float a_y, float a_z, float a_w)
+	{
+		float lanes[4] = { a_x, a_y, a_z, a_w };
+		return vld1q_f32(lanes);
+	}
+
+	OYL_FORCE_INLINE Float4 Load(float const* a_src) { return vld1q_f32(a_src); }
+
+	/// Loads three floats into x, y, z without touching memory past a_src[2]. w is set to zero.
+	OYL_FORCE_INLINE
+	Float4
+	Load3(float const* a_src)
+	{
+		return vcombine_f32(vld1_f32(a_src), vld1_lane_f32(a_src + 2, vdup_n_f32(0.0f), 0));
+	}
+
+	OYL_FORCE_INLINE void Store(float* a_dst, Float4 a_value) { vst1q_f32(a_dst, a_value); }
+
+	/// Stores x, y, z without touching memory past a_dst[2]
+	OYL_FORCE_INLINE
+	void
+	Store3(float* a_dst, Float4 a_value)
+	{
+		vst1_f32(a_dst, vget_low_f32(a_value));
+		vst1q_lane_f32(a_dst + 2, a_value, 2);
+	}
+
+	OYL_FORCE_INLINE float GetX(Float4 a_value) { return vgetq_lane_f32(a_value, 0); }
+
+	OYL_FORCE_INLINE Float4 Add(Float4 a_lhs, Float4 a_rhs) { return vaddq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Sub(Float4 a_lhs, Float4 a_rhs) { return vsubq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Mul(Float4 a_lhs, Float4 a_rhs) { return vmulq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Div(Float4 a_lhs, Float4 a_rhs) { return vdivq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Min(Float4 a_lhs, Float4 a_rhs) { return vminq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Max(Float4 a_lhs, Float4 a_rhs) { return vmaxq_f32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float4 Sqrt(Float4 a_value) { return vsqrtq_f32(a_value); }
+
+	OYL_FORCE_INLINE Float4 Negate(Float4 a_value) { return vnegq_f32(a_value); }
+
+	OYL_FORCE_INLINE Float4 Abs(Float4 a_value) { return vabsq_f32(a_value); }
+
+	/// \return a_value with its sign flipped in every lane where a_sign has its sign bit set
+	OYL_FORCE_INLINE
+	Float4
+	FlipSign(Float4 a_value, Float4 a_sign)
+	{
+		uint32x4_t signBits = vandq_u32(vreinterpretq_u32_f32(a_sign), vdupq_n_u32(0x80000000u));
+		return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a_value), signBits));
+	}
+
+	/// \return An approximation of 1 / sqrt(a_value) with a relative error of at most 1.5 * 2^-12
+	OYL_FORCE_INLINE
+	Float4
+	RSqrtEstimate(Float4 a_value)
+	{
+		// The raw estimate only has 8 bits, one Newton-Raphson step matches the x86 precision
+		float32x4_t estimate = vrsqrteq_f32(a_value);
+		return vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(a_value, estimate), estimate));
+	}
+
+	/// \return a_value rounded to the nearest integer, ties to even
+	OYL_FORCE_INLINE Float4 Round(Float4 a_value) { return vrndnq_f32(a_value); }
+
+	// Comparisons return a mask with all bits set in the lanes where the comparison holds
+
+	OYL_FORCE_INLINE Float4 Equal(Float4 a_lhs, Float4 a_rhs) { return vreinterpretq_f32_u32(vceqq_f32(a_lhs, a_rhs)); }
+
+	OYL_FORCE_INLINE Float4 Less(Float4 a_lhs, Float4 a_rhs) { return vreinterpretq_f32_u32(vcltq_f32(a_lhs, a_rhs)); }
+
+	OYL_FORCE_INLINE Float4 LessEqual(Float4 a_lhs, Float4 a_rhs) { return vreinterpretq_f32_u32(vcleq_f32(a_lhs, a_rhs)); }
+
+	OYL_FORCE_INLINE Float4 Greater(Float4 a_lhs, Float4 a_rhs) { return vreinterpretq_f32_u32(vcgtq_f32(a_lhs, a_rhs)); }
+
+	#define _SIMD_FLOAT4_BITWISE(_intrinsic_) \
+		return vreinterpretq_f32_u32(_intrinsic_(vreinterpretq_u32_f32(a_lhs), vreinterpretq_u32_f32(a_rhs)))
+
+	OYL_FORCE_INLINE Float4 And(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(vandq_u32); }
+
+	OYL_FORCE_INLINE Float4 Or(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(vorrq_u32); }
+
+	OYL_FORCE_INLINE Float4 Xor(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(veorq_u32); }
+
+	#undef _SIMD_FLOAT4_BITWISE
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Float4
+	Select(Float4 a_mask, Float4 a_ifTrue, Float4 a_ifFalse)
+	{
+		return vbslq_f32(vreinterpretq_u32_f32(a_mask), a_ifTrue, a_ifFalse);
+	}
+
+	/// \return The sign bit of each lane packed into the low 4 bits, lane 0 in bit 0
+	OYL_FORCE_INLINE
+	int
+	MoveMask(Float4 a_mask)
+	{
+		static int32_t const shifts[4] = { 0, 1, 2, 3 };
+		uint32x4_t signs = vshrq_n_u32(vreinterpretq_u32_f32(a_mask), 31);
+		return static_cast<int>(vaddvq_u32(vshlq_u32(signs, vld1q_s32(shifts))));
+	}
+
+	/// \return a_a * a_b + a_c
+	OYL_FORCE_INLINE
+	Float4
+	MulAdd(Float4 a_a, Float4 a_b, Float4 a_c)
+	{
+		// vmlaq_f32 is not fused, which keeps rounding consistent with the other backends
+		return vmlaq_f32(a_c, a_a, a_b);
+	}
+
+	/// \return A vector whose lanes are taken from a_value at the given lane indices
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle(Float4 a_value)
+	{
+		constexpr uint8_t table[16] = {
+			X * 4, X * 4 + 1, X * 4 + 2, X * 4 + 3,
+			Y * 4, Y * 4 + 1, Y * 4 + 2, Y * 4 + 3,
+			Z * 4, Z * 4 + 1, Z * 4 + 2, Z * 4 + 3,
+			W * 4, W * 4 + 1, W * 4 + 2, W * 4 + 3,
+		};
+		uint8x16_t bytes = vreinterpretq_u8_f32(a_value);
+		return vreinterpretq_f32_u8(vqtbl1q_u8(bytes, vld1q_u8(table)));
+	}
+
+	/// \return (a_lo[X], a_lo[Y], a_hi[Z], a_hi[W])
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle2(Float4 a_lo, Float4 a_hi)
+	{
+		// Bytes 16-31 of the table index into a_hi
+		constexpr uint8_t table[16] = {
+			X * 4,      X * 4 + 1,      X * 4 + 2,      X * 4 + 3,
+			Y * 4,      Y * 4 + 1,      Y * 4 + 2,      Y * 4 + 3,
+			16 + Z * 4, 16 + Z * 4 + 1, 16 + Z * 4 + 2, 16 + Z * 4 + 3,
+			16 + W * 4, 16 + W * 4 + 1, 16 + W * 4 + 2, 16 + W * 4 + 3,
+		};
+		uint8x16x2_t bytes = { { vreinterpretq_u8_f32(a_lo), vreinterpretq_u8_f32(a_hi) } };
+		return vreinterpretq_f32_u8(vqtbl2q_u8(bytes, vld1q_u8(table)));
+	}
+
+	OYL_FORCE_INLINE
+	bool
+	AllEqual(Float4 a_lhs, Float4 a_rhs)
+	{
+		return vminvq_u32(vceqq_f32(a_lhs, a_rhs)) == 0xFFFFFFFFu;
+	}
+
+	OYL_FORCE_INLINE
+	void
+	Transpose(Float4& a_row0, Float4& a_row1, Float4& a_row2, Float4& a_row3)
+	{
+		Float4 t0 = vzip1q_f32(a_row0, a_row2);
+		Float4 t1 = vzip2q_f32(a_row0, a_row2);
+		Float4 t2 = vzip1q_f32(a_row1, a_row3);
+		Float4 t3 = vzip2q_f32(a_row1, a_row3);
+
+		a_row0 = vzip1q_f32(t0, t2);
+		a_row1 = vzip2q_f32(t0, t2);
+		a_row2 = vzip1q_f32(t1, t3);
+		a_row3 = vzip2q_f32(t1, t3);
+	}
+#else
+	#define _SIMD_FLOAT4_LANEWISE(_expr_) \
+		Float4 result; \
+		for (int i = 0; i < 4; i++) \
+		{ \
+			result.lanes[i] = _expr_; \
+		} \
+		return result
+
+	OYL_FORCE_INLINE Float4 Zero() { return Float4 { { 0, 0, 0, 0 } }; }
+
+	OYL_FORCE_INLINE Float4 Splat(float a_value) { return Float4 { { a_value, a_value, a_value, a_value } }; }
+
+	OYL_FORCE_INLINE Float4 Set(float a_x, float a_y, float a_z, float a_w) { return Float4 { { a_x, a_y, a_z, a_w } }; }
+
+	OYL_FORCE_INLINE Float4 Load(float const* a_src) { return Float4 { { a_src[0], a_src[1], a_src[2], a_src[3] } }; }
+
+	/// Loads three floats into x, y, z without touching memory past a_src[2]. w is set to zero.
+	OYL_FORCE_INLINE Float4 Load3(float const* a_src) { return Float4 { { a_src[0], a_src[1], a_src[2], 0 } }; }
+
+	OYL_FORCE_INLINE
+	void
+	Store(float* a_dst, Float4 a_value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			a_dst[i] = a_value.lanes[i];
+		}
+	}
+
+	/// Stores x, y, z without touching memory past a_dst[2]
+	OYL_FORCE_INLINE
+	void
+	Store3(float* a_dst, Float4 a_value)
+	{
+		for (int i = 0; i < 3; i++)
+		{
+			a_dst[i] = a_value.lanes[i];
+		}
+	}
+
+	OYL_FORCE_INLINE float GetX(Float4 a_value) { return a_value.lanes[0]; }
+
+	OYL_FORCE_INLINE Float4 Add(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] + a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE Float4 Sub(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] - a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE Float4 Mul(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] * a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE Float4 Div(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] / a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE
+	Float4
+	Min(Float4 a_lhs, Float4 a_rhs)
+	{
+		_SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] < a_rhs.lanes[i] ? a_lhs.lanes[i] : a_rhs.lanes[i]);
+	}
+
+	OYL_FORCE_INLINE
+	Float4
+	Max(Float4 a_lhs, Float4 a_rhs)
+	{
+		_SIMD_FLOAT4_LANEWISE(a_lhs.lanes[i] > a_rhs.lanes[i] ? a_lhs.lanes[i] : a_rhs.lanes[i]);
+	}
+
+	OYL_FORCE_INLINE Float4 Sqrt(Float4 a_value) { _SIMD_FLOAT4_LANEWISE(std::sqrt(a_value.lanes[i])); }
+
+	OYL_FORCE_INLINE Float4 Negate(Float4 a_value) { _SIMD_FLOAT4_LANEWISE(-a_value.lanes[i]); }
+
+	OYL_FORCE_INLINE Float4 Abs(Float4 a_value) { _SIMD_FLOAT4_LANEWISE(std::fabs(a_value.lanes[i])); }
+
+	/// \return a_value with its sign flipped in every lane where a_sign has its sign bit set
+	OYL_FORCE_INLINE
+	Float4
+	FlipSign(Float4 a_value, Float4 a_sign)
+	{
+		_SIMD_FLOAT4_LANEWISE(a_value.lanes[i] * std::copysign(1.0f, a_sign.lanes[i]));
+	}
+
+	/// \return An approximation of 1 / sqrt(a_value) with a relative error of at most 1.5 * 2^-12
+	OYL_FORCE_INLINE Float4 RSqrtEstimate(Float4 a_value) { _SIMD_FLOAT4_LANEWISE(1 / std::sqrt(a_value.lanes[i])); }
+
+	/// \return a_value rounded to the nearest integer, ties to even
+	OYL_FORCE_INLINE Float4 Round(Float4 a_value) { _SIMD_FLOAT4_LANEWISE(std::nearbyint(a_value.lanes[i])); }
+
+	OYL_FORCE_INLINE
+	float
+	_FromBits(std::uint32_t a_bits)
+	{
+		float result;
+		std::memcpy(&result, &a_bits, sizeof(result));
+		return result;
+	}
+
+	OYL_FORCE_INLINE
+	std::uint32_t
+	_ToBits(float a_value)
+	{
+		std::uint32_t result;
+		std::memcpy(&result, &a_value, sizeof(result));
+		return result;
+	}
+
+	// Comparisons return a mask with all bits set in the lanes where the comparison holds
+
+	#define _SIMD_FLOAT4_COMPARE(_operator_) \
+		_SIMD_FLOAT4_LANEWISE(_FromBits(a_lhs.lanes[i] _operator_ a_rhs.lanes[i] ? ~0u : 0u))
+
+	OYL_FORCE_INLINE Float4 Equal(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_COMPARE(==); }
+
+	OYL_FORCE_INLINE Float4 Less(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_COMPARE(<); }
+
+	OYL_FORCE_INLINE Float4 LessEqual(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_COMPARE(<=); }
+
+	OYL_FORCE_INLINE Float4 Greater(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_COMPARE(>); }
+
+	#undef _SIMD_FLOAT4_COMPARE
+
+	#define _SIMD_FLOAT4_BITWISE(_operator_) \
+		_SIMD_FLOAT4_LANEWISE(_FromBits(_ToBits(a_lhs.lanes[i]) _operator_ _ToBits(a_rhs.lanes[i])))
+
+	OYL_FORCE_INLINE Float4 And(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(&); }
+
+	OYL_FORCE_INLINE Float4 Or(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(|); }
+
+	OYL_FORCE_INLINE Float4 Xor(Float4 a_lhs, Float4 a_rhs) { _SIMD_FLOAT4_BITWISE(^); }
+
+	#undef _SIMD_FLOAT4_BITWISE
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Float4
+	Select(Float4 a_mask, Float4 a_ifTrue, Float4 a_ifFalse)
+	{
+		_SIMD_FLOAT4_LANEWISE(_ToBits(a_mask.lanes[i]) ? a_ifTrue.lanes[i] : a_ifFalse.lanes[i]);
+	}
+
+	/// \return The sign bit of each lane packed into the low 4 bits, lane 0 in bit 0
+	OYL_FORCE_INLINE
+	int
+	MoveMask(Float4 a_mask)
+	{
+		int result = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			result |= static_cast<int>(_ToBits(a_mask.lanes[i]) >> 31) << i;
+		}
+		return result;
+	}
+
+	/// \return a_a * a_b + a_c
+	OYL_FORCE_INLINE
+	Float4
+	MulAdd(Float4 a_a, Float4 a_b, Float4 a_c)
+	{
+		_SIMD_FLOAT4_LANEWISE(a_a.lanes[i] * a_b.lanes[i] + a_c.lanes[i]);
+	}
+
+	/// \return A vector whose lanes are taken from a_value at the given lane indices
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle(Float4 a_value)
+	{
+		return Float4 { { a_value.lanes[X], a_value.lanes[Y], a_value.lanes[Z], a_value.lanes[W] } };
+	}
+
+	/// \return (a_lo[X], a_lo[Y], a_hi[Z], a_hi[W])
+	template<int X, int Y, int Z, int W>
+	OYL_FORCE_INLINE
+	Float4
+	Shuffle2(Float4 a_lo, Float4 a_hi)
+	{
+		return Float4 { { a_lo.lanes[X], a_lo.lanes[Y], a_hi.lanes[Z], a_hi.lanes[W] } };
+	}
+
+	OYL_FORCE_INLINE
+	bool
+	AllEqual(Float4 a_lhs, Float4 a_rhs)
+	{
+		bool result = true;
+		for (int i = 0; i < 4; i++)
+		{
+			result &= a_lhs.lanes[i] == a_rhs.lanes[i];
+		}
+		return result;
+	}
+
+	OYL_FORCE_INLINE
+	void
+	Transpose(Float4& a_row0, Float4& a_row1, Float4& a_row2, Float4& a_row3)
+	{
+		Float4 rows[4] = { a_row0, a_row1, a_row2, a_row3 };
+		a_row0 = Float4 { { rows[0].lanes[0], rows[1].lanes[0], rows[2].lanes[0], rows[3].lanes[0] } };
+		a_row1 = Float4 { { rows[0].lanes[1], rows[1].lanes[1], rows[2].lanes[1], rows[3].lanes[1] } };
+		a_row2 = Float4 { { rows[0].lanes[2], rows[1].lanes[2], rows[2].lanes[2], rows[3].lanes[2] } };
+		a_row3 = Float4 { { rows[0].lanes[3], rows[1].lanes[3], rows[2].lanes[3], rows[3].lanes[3] } };
+	}
+
+	#undef _SIMD_FLOAT4_LANEWISE
+#endif
+
+	// Backend-agnostic helpers built on the primitives above
+
+	/// \return The sum of all four lanes, broadcast to every lane
+	OYL_FORCE_INLINE
+	Float4
+	HorizontalSum(Float4 a_value)
+	{
+		Float4 pairs = Add(a_value, Shuffle<1, 0, 3, 2>(a_value));
+		return Add(pairs, Shuffle<2, 3, 0, 1>(pairs));
+	}
+
+	/// \return The 4 component dot product, broadcast to every lane
+	OYL_FORCE_INLINE
+	Float4
+	Dot4(Float4 a_lhs, Float4 a_rhs)
+	{
+		return HorizontalSum(Mul(a_lhs, a_rhs));
+	}
+
+	/// \return The 3 component dot product ignoring w, broadcast to every lane
+	OYL_FORCE_INLINE
+	Float4
+	Dot3(Float4 a_lhs, Float4 a_rhs)
+	{
+		Float4 product = Mul(a_lhs, a_rhs);
+		Float4 x = Shuffle<0, 0, 0, 0>(product);
+		Float4 y = Shuffle<1, 1, 1, 1>(product);
+		Float4 z = Shuffle<2, 2, 2, 2>(product);
+		return Add(Add(x, y), z);
+	}
+
+	/// \return The cross product of the xyz components. The w lane is a_lhs.w * a_rhs.w - a_lhs.w * a_rhs.w
+	OYL_FORCE_INLINE
+	Float4
+	Cross3(Float4 a_lhs, Float4 a_rhs)
+	{
+		Float4 lhsYzx = Shuffle<1, 2, 0, 3>(a_lhs);
+		Float4 rhsYzx = Shuffle<1, 2, 0, 3>(a_rhs);
+		// Computed in zxy order, rotate back into xyz
+		Float4 zxy = Sub(Mul(a_lhs, rhsYzx), Mul(lhsYzx, a_rhs));
+		return Shuffle<1, 2, 0, 3>(zxy);
+	}
+}
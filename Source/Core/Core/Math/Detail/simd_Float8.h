@@ -0,0 +1,357 @@
+#pragma once
+
+#include <cstdint>
+
+#include "simd_Config.h"
+#include "simd_Float4.h"
+#include "simd_Int4.h"
+
+namespace Oyl::Simd
+{
+	/**
+	 * \brief Eight packed single precision floats, an AVX register where available and two Float4 halves otherwise
+	 * \remarks Shares its function names with Float4 where the argument types disambiguate them,
+	 *          the rest carry an 8 suffix, ie. Splat8 and Load8. Lane 0 is the lowest address in memory.
+	 */
+#if OYL_SIMD == OYL_SIMD_AVX
+	using Float8 = __m256;
+#else
+	struct Float8
+	{
+		Float4 lo, hi;
+	};
+#endif
+
+	/**
+	 * \brief Eight packed 32-bit signed integers, see Int4
+	 * \remarks 256-bit integer instructions need AVX2, plain AVX splits the integer work into two Int4 halves.
+	 */
+#if OYL_SIMD_AVX2
+	using Int8 = __m256i;
+#else
+	struct Int8
+	{
+		Int4 lo, hi;
+	};
+#endif
+
+#if OYL_SIMD == OYL_SIMD_AVX
+	OYL_FORCE_INLINE Float8 Zero8() { return _mm256_setzero_ps(); }
+
+	OYL_FORCE_INLINE Float8 Splat8(float a_value) { return _mm256_set1_ps(a_value); }
+
+	OYL_FORCE_INLINE Float8 Load8(float const* a_src) { return _mm256_loadu_ps(a_src); }
+
+	OYL_FORCE_INLINE void Store(float* a_dst, Float8 a_value) { _mm256_storeu_ps(a_dst, a_value); }
+
+	OYL_FORCE_INLINE Float8 Combine(Float4 a_lo, Float4 a_hi) { return _mm256_insertf128_ps(_mm256_castps128_ps256(a_lo), a_hi, 1); }
+
+	OYL_FORCE_INLINE Float4 Low(Float8 a_value) { return _mm256_castps256_ps128(a_value); }
+
+	OYL_FORCE_INLINE Float4 High(Float8 a_value) { return _mm256_extractf128_ps(a_value, 1); }
+
+	OYL_FORCE_INLINE float GetX(Float8 a_value) { return _mm256_cvtss_f32(a_value); }
+
+	OYL_FORCE_INLINE Float8 Add(Float8 a_lhs, Float8 a_rhs) { return _mm256_add_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Sub(Float8 a_lhs, Float8 a_rhs) { return _mm256_sub_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Mul(Float8 a_lhs, Float8 a_rhs) { return _mm256_mul_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Div(Float8 a_lhs, Float8 a_rhs) { return _mm256_div_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Min(Float8 a_lhs, Float8 a_rhs) { return _mm256_min_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Max(Float8 a_lhs, Float8 a_rhs) { return _mm256_max_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Sqrt(Float8 a_value) { return _mm256_sqrt_ps(a_value); }
+
+	OYL_FORCE_INLINE Float8 Negate(Float8 a_value) { return _mm256_xor_ps(a_value, _mm256_set1_ps(-0.0f)); }
+
+	OYL_FORCE_INLINE Float8 Abs(Float8 a_value) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a_value); }
+
+	/// \return a_value with its sign flipped in every lane where a_sign has its sign bit set
+	OYL_FORCE_INLINE
+	Float8
+	FlipSign(Float8 a_value, Float8 a_sign)
+	{
+		return _mm256_xor_ps(a_value, _mm256_and_ps(a_sign, _mm256_set1_ps(-0.0f)));
+	}
+
+	/// \return a_a * a_b + a_c
+	OYL_FORCE_INLINE
+	Float8
+	MulAdd(Float8 a_a, Float8 a_b, Float8 a_c)
+	{
+	#if OYL_SIMD_FMA
+		return _mm256_fmadd_ps(a_a, a_b, a_c);
+	#else
+		return _mm256_add_ps(_mm256_mul_ps(a_a, a_b), a_c);
+	#endif
+	}
+
+	/// \return An approximation of 1 / sqrt(a_value) with a relative error of at most 1.5 * 2^-12
+	OYL_FORCE_INLINE Float8 RSqrtEstimate(Float8 a_value) { return _mm256_rsqrt_ps(a_value); }
+
+	/// \return a_value rounded to the nearest integer, ties to even
+	OYL_FORCE_INLINE
+	Float8
+	Round(Float8 a_value)
+	{
+		return _mm256_round_ps(a_value, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	}
+
+	// Comparisons return a mask with all bits set in the lanes where the comparison holds
+
+	OYL_FORCE_INLINE Float8 Equal(Float8 a_lhs, Float8 a_rhs) { return _mm256_cmp_ps(a_lhs, a_rhs, _CMP_EQ_OQ); }
+
+	OYL_FORCE_INLINE Float8 Less(Float8 a_lhs, Float8 a_rhs) { return _mm256_cmp_ps(a_lhs, a_rhs, _CMP_LT_OQ); }
+
+	OYL_FORCE_INLINE Float8 LessEqual(Float8 a_lhs, Float8 a_rhs) { return _mm256_cmp_ps(a_lhs, a_rhs, _CMP_LE_OQ); }
+
+	OYL_FORCE_INLINE Float8 Greater(Float8 a_lhs, Float8 a_rhs) { return _mm256_cmp_ps(a_lhs, a_rhs, _CMP_GT_OQ); }
+
+	OYL_FORCE_INLINE Float8 And(Float8 a_lhs, Float8 a_rhs) { return _mm256_and_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Or(Float8 a_lhs, Float8 a_rhs) { return _mm256_or_ps(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Float8 Xor(Float8 a_lhs, Float8 a_rhs) { return _mm256_xor_ps(a_lhs, a_rhs); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Float8
+	Select(Float8 a_mask, Float8 a_ifTrue, Float8 a_ifFalse)
+	{
+		return _mm256_blendv_ps(a_ifFalse, a_ifTrue, a_mask);
+	}
+
+	/// \return The sign bit of each lane packed into the low 8 bits, lane 0 in bit 0
+	OYL_FORCE_INLINE int MoveMask(Float8 a_mask) { return _mm256_movemask_ps(a_mask); }
+#else
+	#define _SIMD_FLOAT8_HALVES_1(_function_) \
+		return Float8 { _function_(a_value.lo), _function_(a_value.hi) }
+
+	#define _SIMD_FLOAT8_HALVES_2(_function_) \
+		return Float8 { _function_(a_lhs.lo, a_rhs.lo), _function_(a_lhs.hi, a_rhs.hi) }
+
+	OYL_FORCE_INLINE Float8 Zero8() { return Float8 { Zero(), Zero() }; }
+
+	OYL_FORCE_INLINE Float8 Splat8(float a_value) { return Float8 { Splat(a_value), Splat(a_value) }; }
+
+	OYL_FORCE_INLINE Float8 Load8(float const* a_src) { return Float8 { Load(a_src), Load(a_src + 4) }; }
+
+	OYL_FORCE_INLINE
+	void
+	Store(float* a_dst, Float8 a_value)
+	{
+		Store(a_dst, a_value.lo);
+		Store(a_dst + 4, a_value.hi);
+	}
+
+	OYL_FORCE_INLINE Float8 Combine(Float4 a_lo, Float4 a_hi) { return Float8 { a_lo, a_hi }; }
+
+	OYL_FORCE_INLINE Float4 Low(Float8 a_value) { return a_value.lo; }
+
+	OYL_FORCE_INLINE Float4 High(Float8 a_value) { return a_value.hi; }
+
+	OYL_FORCE_INLINE float GetX(Float8 a_value) { return GetX(a_value.lo); }
+
+	OYL_FORCE_INLINE Float8 Add(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Add); }
+
+	OYL_FORCE_INLINE Float8 Sub(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Sub); }
+
+	OYL_FORCE_INLINE Float8 Mul(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Mul); }
+
+	OYL_FORCE_INLINE Float8 Div(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Div); }
+
+	OYL_FORCE_INLINE Float8 Min(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Min); }
+
+	OYL_FORCE_INLINE Float8 Max(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Max); }
+
+	OYL_FORCE_INLINE Float8 Sqrt(Float8 a_value) { _SIMD_FLOAT8_HALVES_1(Sqrt); }
+
+	OYL_FORCE_INLINE Float8 Negate(Float8 a_value) { _SIMD_FLOAT8_HALVES_1(Negate); }
+
+	OYL_FORCE_INLINE Float8 Abs(Float8 a_value) { _SIMD_FLOAT8_HALVES_1(Abs); }
+
+	/// \return a_value with its sign flipped in every lane where a_sign has its sign bit set
+	OYL_FORCE_INLINE
+	Float8
+	FlipSign(Float8 a_value, Float8 a_sign)
+	{
+		return Float8 { FlipSign(a_value.lo, a_sign.lo), FlipSign(a_value.hi, a_sign.hi) };
+	}
+
+	/// \return a_a * a_b + a_c
+	OYL_FORCE_INLINE
+	Float8
+	MulAdd(Float8 a_a, Float8 a_b, Float8 a_c)
+	{
+		return Float8 { MulAdd(a_a.lo, a_b.lo, a_c.lo), MulAdd(a_a.hi, a_b.hi, a_c.hi) };
+	}
+
+	/// \return An approximation of 1 / sqrt(a_value) with a relative error of at most 1.5 * 2^-12
+	OYL_FORCE_INLINE Float8 RSqrtEstimate(Float8 a_value) { _SIMD_FLOAT8_HALVES_1(RSqrtEstimate); }
+
+	/// \return a_value rounded to the nearest integer, ties to even
+	OYL_FORCE_INLINE Float8 Round(Float8 a_value) { _SIMD_FLOAT8_HALVES_1(Round); }
+
+	// Comparisons return a mask with all bits set in the lanes where the comparison holds
+
+	OYL_FORCE_INLINE Float8 Equal(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Equal); }
+
+	OYL_FORCE_INLINE Float8 Less(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Less); }
+
+	OYL_FORCE_INLINE Float8 LessEqual(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(LessEqual); }
+
+	OYL_FORCE_INLINE Float8 Greater(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Greater); }
+
+	OYL_FORCE_INLINE Float8 And(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(And); }
+
+	OYL_FORCE_INLINE Float8 Or(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Or); }
+
+	OYL_FORCE_INLINE Float8 Xor(Float8 a_lhs, Float8 a_rhs) { _SIMD_FLOAT8_HALVES_2(Xor); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Float8
+	Select(Float8 a_mask, Float8 a_ifTrue, Float8 a_ifFalse)
+	{
+		return Float8 { Select(a_mask.lo, a_ifTrue.lo, a_ifFalse.lo), Select(a_mask.hi, a_ifTrue.hi, a_ifFalse.hi) };
+	}
+
+	/// \return The sign bit of each lane packed into the low 8 bits, lane 0 in bit 0
+	OYL_FORCE_INLINE int MoveMask(Float8 a_mask) { return MoveMask(a_mask.lo) | (MoveMask(a_mask.hi) << 4); }
+
+	#undef _SIMD_FLOAT8_HALVES_2
+	#undef _SIMD_FLOAT8_HALVES_1
+#endif
+
+#if OYL_SIMD_AVX2
+	OYL_FORCE_INLINE Int8 SplatInt8(std::int32_t a_value) { return _mm256_set1_epi32(a_value); }
+
+	OYL_FORCE_INLINE Int8 LoadInt8(std::int32_t const* a_src) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a_src)); }
+
+	OYL_FORCE_INLINE void Store(std::int32_t* a_dst, Int8 a_value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(a_dst), a_value); }
+
+	OYL_FORCE_INLINE Int8 Add(Int8 a_lhs, Int8 a_rhs) { return _mm256_add_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int8 Sub(Int8 a_lhs, Int8 a_rhs) { return _mm256_sub_epi32(a_lhs, a_rhs); }
+
+	/// \return The low 32 bits of each product
+	OYL_FORCE_INLINE Int8 Mul(Int8 a_lhs, Int8 a_rhs) { return _mm256_mullo_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int8 And(Int8 a_lhs, Int8 a_rhs) { return _mm256_and_si256(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int8 Or(Int8 a_lhs, Int8 a_rhs) { return _mm256_or_si256(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int8 Xor(Int8 a_lhs, Int8 a_rhs) { return _mm256_xor_si256(a_lhs, a_rhs); }
+
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftLeft(Int8 a_value) { return _mm256_slli_epi32(a_value, Bits); }
+
+	/// Arithmetic shift, copies the sign bit in
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftRight(Int8 a_value) { return _mm256_srai_epi32(a_value, Bits); }
+
+	/// Logical shift, shifts zeroes in
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftRightLogical(Int8 a_value) { return _mm256_srli_epi32(a_value, Bits); }
+
+	OYL_FORCE_INLINE Int8 Equal(Int8 a_lhs, Int8 a_rhs) { return _mm256_cmpeq_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int8 Less(Int8 a_lhs, Int8 a_rhs) { return _mm256_cmpgt_epi32(a_rhs, a_lhs); }
+
+	OYL_FORCE_INLINE Int8 Greater(Int8 a_lhs, Int8 a_rhs) { return _mm256_cmpgt_epi32(a_lhs, a_rhs); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE Int8 Select(Int8 a_mask, Int8 a_ifTrue, Int8 a_ifFalse) { return _mm256_blendv_epi8(a_ifFalse, a_ifTrue, a_mask); }
+
+	/// \return a_value rounded to the nearest integer, ties to even. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int8 ConvertToInt(Float8 a_value) { return _mm256_cvtps_epi32(a_value); }
+
+	/// \return a_value rounded towards zero. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int8 TruncateToInt(Float8 a_value) { return _mm256_cvttps_epi32(a_value); }
+
+	OYL_FORCE_INLINE Float8 ConvertToFloat(Int8 a_value) { return _mm256_cvtepi32_ps(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Float8 BitCastToFloat(Int8 a_value) { return _mm256_castsi256_ps(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Int8 BitCastToInt(Float8 a_value) { return _mm256_castps_si256(a_value); }
+#else
+	#define _SIMD_INT8_HALVES_1(_function_) \
+		return Int8 { _function_(a_value.lo), _function_(a_value.hi) }
+
+	#define _SIMD_INT8_HALVES_2(_function_) \
+		return Int8 { _function_(a_lhs.lo, a_rhs.lo), _function_(a_lhs.hi, a_rhs.hi) }
+
+	OYL_FORCE_INLINE Int8 SplatInt8(std::int32_t a_value) { return Int8 { SplatInt(a_value), SplatInt(a_value) }; }
+
+	OYL_FORCE_INLINE Int8 LoadInt8(std::int32_t const* a_src) { return Int8 { LoadInt(a_src), LoadInt(a_src + 4) }; }
+
+	OYL_FORCE_INLINE
+	void
+	Store(std::int32_t* a_dst, Int8 a_value)
+	{
+		Store(a_dst, a_value.lo);
+		Store(a_dst + 4, a_value.hi);
+	}
+
+	OYL_FORCE_INLINE Int8 Add(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Add); }
+
+	OYL_FORCE_INLINE Int8 Sub(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Sub); }
+
+	/// \return The low 32 bits of each product
+	OYL_FORCE_INLINE Int8 Mul(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Mul); }
+
+	OYL_FORCE_INLINE Int8 And(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(And); }
+
+	OYL_FORCE_INLINE Int8 Or(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Or); }
+
+	OYL_FORCE_INLINE Int8 Xor(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Xor); }
+
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftLeft(Int8 a_value) { _SIMD_INT8_HALVES_1(ShiftLeft<Bits>); }
+
+	/// Arithmetic shift, copies the sign bit in
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftRight(Int8 a_value) { _SIMD_INT8_HALVES_1(ShiftRight<Bits>); }
+
+	/// Logical shift, shifts zeroes in
+	template<int Bits>
+	OYL_FORCE_INLINE Int8 ShiftRightLogical(Int8 a_value) { _SIMD_INT8_HALVES_1(ShiftRightLogical<Bits>); }
+
+	OYL_FORCE_INLINE Int8 Equal(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Equal); }
+
+	OYL_FORCE_INLINE Int8 Less(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Less); }
+
+	OYL_FORCE_INLINE Int8 Greater(Int8 a_lhs, Int8 a_rhs) { _SIMD_INT8_HALVES_2(Greater); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Int8
+	Select(Int8 a_mask, Int8 a_ifTrue, Int8 a_ifFalse)
+	{
+		return Int8 { Select(a_mask.lo, a_ifTrue.lo, a_ifFalse.lo), Select(a_mask.hi, a_ifTrue.hi, a_ifFalse.hi) };
+	}
+
+	/// \return a_value rounded to the nearest integer, ties to even. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int8 ConvertToInt(Float8 a_value) { return Int8 { ConvertToInt(Low(a_value)), ConvertToInt(High(a_value)) }; }
+
+	/// \return a_value rounded towards zero. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int8 TruncateToInt(Float8 a_value) { return Int8 { TruncateToInt(Low(a_value)), TruncateToInt(High(a_value)) }; }
+
+	OYL_FORCE_INLINE Float8 ConvertToFloat(Int8 a_value) { return Combine(ConvertToFloat(a_value.lo), ConvertToFloat(a_value.hi)); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Float8 BitCastToFloat(Int8 a_value) { return Combine(BitCastToFloat(a_value.lo), BitCastToFloat(a_value.hi)); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Int8 BitCastToInt(Float8 a_value) { return Int8 { BitCastToInt(Low(a_value)), BitCastToInt(High(a_value)) }; }
+
+	#undef _SIMD_INT8_HALVES_2
+	#undef _SIMD_INT8_HALVES_1
+#endif
+}
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "simd_Config.h"
+#include "simd_Float4.h"
+
+namespace Oyl::Simd
+{
+	/**
+	 * \brief Four packed 32-bit signed integers, mapped to the native register type of the selected backend
+	 * \remarks Arithmetic wraps around on overflow, like unsigned arithmetic.
+	 *          Functions that would be ambiguous with their Float4 counterparts carry an Int suffix, ie. SplatInt.
+	 */
+#if OYL_SIMD_X86
+	using Int4 = __m128i;
+#elif OYL_SIMD == OYL_SIMD_NEON
+	using Int4 = int32x4_t;
+#else
+	struct Int4
+	{
+		std::int32_t lanes[4];
+	};
+#endif
+
+#if OYL_SIMD_X86
+	OYL_FORCE_INLINE Int4 SplatInt(std::int32_t a_value) { return _mm_set1_epi32(a_value); }
+
+	OYL_FORCE_INLINE
+	Int4
+	SetInt(std::int32_t a_x, std::int32_t a_y, std::int32_t a_z, std::int32_t a_w)
+	{
+		return _mm_setr_epi32(a_x, a_y, a_z, a_w);
+	}
+
+	OYL_FORCE_INLINE Int4 LoadInt(std::int32_t const* a_src) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(a_src)); }
+
+	OYL_FORCE_INLINE void Store(std::int32_t* a_dst, Int4 a_value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(a_dst), a_value); }
+
+	/// \return Four 16 bit values sign extended to 32 bits
+	OYL_FORCE_INLINE
+	Int4
+	LoadInt16(std::int16_t const* a_src)
+	{
+		__m128i value = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(a_src));
+		return _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+	}
+
+	/// \return Four 16 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE
+	Int4
+	LoadUint16(std::uint16_t const* a_src)
+	{
+		return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(a_src)), _mm_setzero_si128());
+	}
+
+	/// \return Four 8 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE
+	Int4
+	LoadUint8(std::uint8_t const* a_src)
+	{
+		std::int32_t bytes;
+		std::memcpy(&bytes, a_src, sizeof(bytes));
+		__m128i zero = _mm_setzero_si128();
+		return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero), zero);
+	}
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the int16 range
+	OYL_FORCE_INLINE
+	void
+	Store(std::int16_t* a_dst, Int4 a_value)
+	{
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(a_dst), _mm_packs_epi32(a_value, a_value));
+	}
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the uint16 range
+	OYL_FORCE_INLINE
+	void
+	Store(std::uint16_t* a_dst, Int4 a_value)
+	{
+		// There is no unsigned 32 to 16 bit pack before SSE4.1, so clamp, then sign extend the low half so the
+		// signed pack keeps the bit pattern
+		__m128i zero = _mm_setzero_si128();
+		__m128i max  = _mm_set1_epi32(0xFFFF);
+		a_value = _mm_andnot_si128(_mm_cmplt_epi32(a_value, zero), a_value);
+		a_value = _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi32(a_value, max), max), _mm_andnot_si128(_mm_cmpgt_epi32(a_value, max), a_value));
+		a_value = _mm_srai_epi32(_mm_slli_epi32(a_value, 16), 16);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(a_dst), _mm_packs_epi32(a_value, a_value));
+	}
+
+	/// \brief Stores four values narrowed to 8 bits, saturating to the uint8 range
+	OYL_FORCE_INLINE
+	void
+	Store(std::uint8_t* a_dst, Int4 a_value)
+	{
+		__m128i words = _mm_packs_epi32(a_value, a_value);
+		std::int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+		std::memcpy(a_dst, &bytes, sizeof(bytes));
+	}
+
+	OYL_FORCE_INLINE std::int32_t GetX(Int4 a_value) { return _mm_cvtsi128_si32(a_value); }
+
+	OYL_FORCE_INLINE Int4 Add(Int4 a_lhs, Int4 a_rhs) { return _mm_add_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Sub(Int4 a_lhs, Int4 a_rhs) { return _mm_sub_epi32(a_lhs, a_rhs); }
+
+	/// \return The low 32 bits of each product
+	OYL_FORCE_INLINE
+	Int4
+	Mul(Int4 a_lhs, Int4 a_rhs)
+	{
+	#if OYL_SIMD == OYL_SIMD_AVX
+		return _mm_mullo_epi32(a_lhs, a_rhs);
+	#else
+		// SSE2 only multiplies the even lanes, do the odd ones separately and interleave
+		__m128i even = _mm_mul_epu32(a_lhs, a_rhs);
+		__m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a_lhs, 32), _mm_srli_epi64(a_rhs, 32));
+		return _mm_unpacklo_epi32(
+			_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+			_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+		);
+	#endif
+	}
+
+	OYL_FORCE_INLINE Int4 And(Int4 a_lhs, Int4 a_rhs) { return _mm_and_si128(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Or(Int4 a_lhs, Int4 a_rhs) { return _mm_or_si128(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Xor(Int4 a_lhs, Int4 a_rhs) { return _mm_xor_si128(a_lhs, a_rhs); }
+
+	template<int Bits>
+	OYL_FORCE_INLINE Int4 ShiftLeft(Int4 a_value) { return _mm_slli_epi32(a_value, Bits); }
+
+	/// Arithmetic shift, copies the sign bit in
+	template<int Bits>
+	OYL_FORCE_INLINE Int4 ShiftRight(Int4 a_value) { return _mm_srai_epi32(a_value, Bits); }
+
+	/// Logical shift, shifts zeroes in
+	template<int Bits>
+	OYL_FORCE_INLINE Int4 ShiftRightLogical(Int4 a_value) { return _mm_srli_epi32(a_value, Bits); }
+
+	OYL_FORCE_INLINE Int4 Equal(Int4 a_lhs, Int4 a_rhs) { return _mm_cmpeq_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Less(Int4 a_lhs, Int4 a_rhs) { return _mm_cmplt_epi32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Greater(Int4 a_lhs, Int4 a_rhs) { return _mm_cmpgt_epi32(a_lhs, a_rhs); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Int4
+	Select(Int4 a_mask, Int4 a_ifTrue, Int4 a_ifFalse)
+	{
+		return _mm_or_si128(_mm_and_si128(a_mask, a_ifTrue), _mm_andnot_si128(a_mask, a_ifFalse));
+	}
+
+	/// \return a_value rounded to the nearest integer, ties to even. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 ConvertToInt(Float4 a_value) { return _mm_cvtps_epi32(a_value); }
+
+	/// \return a_value rounded towards zero. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 TruncateToInt(Float4 a_value) { return _mm_cvttps_epi32(a_value); }
+
+	OYL_FORCE_INLINE Float4 ConvertToFloat(Int4 a_value) { return _mm_cvtepi32_ps(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Float4 BitCastToFloat(Int4 a_value) { return _mm_castsi128_ps(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Int4 BitCastToInt(Float4 a_value) { return _mm_castps_si128(a_value); }
+#elif OYL_SIMD == OYL_SIMD_NEON
+	OYL_FORCE_INLINE Int4 SplatInt(std::int32_t a_value) { return vdupq_n_s32(a_value); }
+
+	OYL_FORCE_INLINE
+	Int4
+	SetInt(std::int32_t a_x, std::int32_t a_y, std::int32_t a_z, std::int32_t a_w)
+	{
+		std::int32_t lanes[4] = { a_x, a_y, a_z, a_w };
+		return vld1q_s32(lanes);
+	}
+
+	OYL_FORCE_INLINE Int4 LoadInt(std::int32_t const* a_src) { return vld1q_s32(a_src); }
+
+	OYL_FORCE_INLINE void Store(std::int32_t* a_dst, Int4 a_value) { vst1q_s32(a_dst, a_value); }
+
+	/// \return Four 16 bit values sign extended to 32 bits
+	OYL_FORCE_INLINE Int4 LoadInt16(std::int16_t const* a_src) { return vmovl_s16(vld1_s16(a_src)); }
+
+	/// \return Four 16 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE Int4 LoadUint16(std::uint16_t const* a_src) { return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(a_src))); }
+
+	/// \return Four 8 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE
+	Int4
+	LoadUint8(std::uint8_t const* a_src)
+	{
+		std::uint32_t bytes;
+		std::memcpy(&bytes, a_src, sizeof(bytes));
+		uint16x8_t words = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(bytes)));
+		return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(words)));
+	}
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the int16 range
+	OYL_FORCE_INLINE void Store(std::int16_t* a_dst, Int4 a_value) { vst1_s16(a_dst, vqmovn_s32(a_value)); }
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the uint16 range
+	OYL_FORCE_INLINE void Store(std::uint16_t* a_dst, Int4 a_value) { vst1_u16(a_dst, vqmovun_s32(a_value)); }
+
+	/// \brief Stores four values narrowed to 8 bits, saturating to the uint8 range
+	OYL_FORCE_INLINE
+	void
+	Store(std::uint8_t* a_dst, Int4 a_value)
+	{
+		uint16x4_t   words = vqmovun_s32(a_value);
+		std::uint32_t bytes = vget_lane_u32(vreinterpret_u32_u8(vqmovn_u16(vcombine_u16(words, words))), 0);
+		std::memcpy(a_dst, &bytes, sizeof(bytes));
+	}
+
+	OYL_FORCE_INLINE std::int32_t GetX(Int4 a_value) { return vgetq_lane_s32(a_value, 0); }
+
+	OYL_FORCE_INLINE Int4 Add(Int4 a_lhs, Int4 a_rhs) { return vaddq_s32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Sub(Int4 a_lhs, Int4 a_rhs) { return vsubq_s32(a_lhs, a_rhs); }
+
+	/// \return The low 32 bits of each product
+	OYL_FORCE_INLINE Int4 Mul(Int4 a_lhs, Int4 a_rhs) { return vmulq_s32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 And(Int4 a_lhs, Int4 a_rhs) { return vandq_s32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Or(Int4 a_lhs, Int4 a_rhs) { return vorrq_s32(a_lhs, a_rhs); }
+
+	OYL_FORCE_INLINE Int4 Xor(Int4 a_lhs, Int4 a_rhs) { return veorq_s32(a_lhs, a_rhs); }
+
+	template<int Bits>
+	OYL_FORCE_INLINE Int4 ShiftLeft(Int4 a_value) { return vshlq_n_s32(a_value, Bits); }
+
+	/// Arithmetic shift, copies the sign bit in
+	template<int Bits>
+	OYL_FORCE_INLINE Int4 ShiftRight(Int4 a_value) { return vshrq_n_s32(a_value, Bits); }
+
+	/// Logical shift, shifts zeroes in
+	template<int Bits>
+	OYL_FORCE_INLINE
+	Int4
+	ShiftRightLogical(Int4 a_value)
+	{
+		return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a_value), Bits));
+	}
+
+	OYL_FORCE_INLINE Int4 Equal(Int4 a_lhs, Int4 a_rhs) { return vreinterpretq_s32_u32(vceqq_s32(a_lhs, a_rhs)); }
+
+	OYL_FORCE_INLINE Int4 Less(Int4 a_lhs, Int4 a_rhs) { return vreinterpretq_s32_u32(vcltq_s32(a_lhs, a_rhs)); }
+
+	OYL_FORCE_INLINE Int4 Greater(Int4 a_lhs, Int4 a_rhs) { return vreinterpretq_s32_u32(vcgtq_s32(a_lhs, a_rhs)); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Int4
+	Select(Int4 a_mask, Int4 a_ifTrue, Int4 a_ifFalse)
+	{
+		return vbslq_s32(vreinterpretq_u32_s32(a_mask), a_ifTrue, a_ifFalse);
+	}
+
+	/// \return a_value rounded to the nearest integer, ties to even. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 ConvertToInt(Float4 a_value) { return vcvtnq_s32_f32(a_value); }
+
+	/// \return a_value rounded towards zero. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 TruncateToInt(Float4 a_value) { return vcvtq_s32_f32(a_value); }
+
+	OYL_FORCE_INLINE Float4 ConvertToFloat(Int4 a_value) { return vcvtq_f32_s32(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Float4 BitCastToFloat(Int4 a_value) { return vreinterpretq_f32_s32(a_value); }
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE Int4 BitCastToInt(Float4 a_value) { return vreinterpretq_s32_f32(a_value); }
+#else
+	#define _SIMD_INT4_LANEWISE(_expr_) \
+		Int4 result; \
+		for (int i = 0; i < 4; i++) \
+		{ \
+			result.lanes[i] = _expr_; \
+		} \
+		return result
+
+	// Wrapping arithmetic is done on unsigned values, signed overflow is undefined behaviour
+	#define _SIMD_INT4_WRAPPING(_operator_) \
+		_SIMD_INT4_LANEWISE(static_cast<std::int32_t>( \
+			static_cast<std::uint32_t>(a_lhs.lanes[i]) _operator_ static_cast<std::uint32_t>(a_rhs.lanes[i]) \
+		))
+
+	OYL_FORCE_INLINE Int4 SplatInt(std::int32_t a_value) { return Int4 { { a_value, a_value, a_value, a_value } }; }
+
+	OYL_FORCE_INLINE
+	Int4
+	SetInt(std::int32_t a_x, std::int32_t a_y, std::int32_t a_z, std::int32_t a_w)
+	{
+		return Int4 { { a_x, a_y, a_z, a_w } };
+	}
+
+	OYL_FORCE_INLINE Int4 LoadInt(std::int32_t const* a_src) { return Int4 { { a_src[0], a_src[1], a_src[2], a_src[3] } }; }
+
+	OYL_FORCE_INLINE
+	void
+	Store(std::int32_t* a_dst, Int4 a_value)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			a_dst[i] = a_value.lanes[i];
+		}
+	}
+
+	/// \return Four 16 bit values sign extended to 32 bits
+	OYL_FORCE_INLINE Int4 LoadInt16(std::int16_t const* a_src) { return Int4 { { a_src[0], a_src[1], a_src[2], a_src[3] } }; }
+
+	/// \return Four 16 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE Int4 LoadUint16(std::uint16_t const* a_src) { return Int4 { { a_src[0], a_src[1], a_src[2], a_src[3] } }; }
+
+	/// \return Four 8 bit values zero extended to 32 bits
+	OYL_FORCE_INLINE Int4 LoadUint8(std::uint8_t const* a_src) { return Int4 { { a_src[0], a_src[1], a_src[2], a_src[3] } }; }
+
+	#define _SIMD_INT4_STORE_SATURATED(_type_, _min_, _max_) \
+		for (int i = 0; i < 4; i++) \
+		{ \
+			std::int32_t value = a_value.lanes[i]; \
+			a_dst[i] = static_cast<_type_>(value < (_min_) ? (_min_) : value > (_max_) ? (_max_) : value); \
+		}
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the int16 range
+	OYL_FORCE_INLINE void Store(std::int16_t* a_dst, Int4 a_value) { _SIMD_INT4_STORE_SATURATED(std::int16_t, -32768, 32767) }
+
+	/// \brief Stores four values narrowed to 16 bits, saturating to the uint16 range
+	OYL_FORCE_INLINE void Store(std::uint16_t* a_dst, Int4 a_value) { _SIMD_INT4_STORE_SATURATED(std::uint16_t, 0, 65535) }
+
+	/// \brief Stores four values narrowed to 8 bits, saturating to the uint8 range
+	OYL_FORCE_INLINE void Store(std::uint8_t* a_dst, Int4 a_value) { _SIMD_INT4_STORE_SATURATED(std::uint8_t, 0, 255) }
+
+	#undef _SIMD_INT4_STORE_SATURATED
+
+	OYL_FORCE_INLINE std::int32_t GetX(Int4 a_value) { return a_value.lanes[0]; }
+
+	OYL_FORCE_INLINE Int4 Add(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_WRAPPING(+); }
+
+	OYL_FORCE_INLINE Int4 Sub(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_WRAPPING(-); }
+
+	/// \return The low 32 bits of each product
+	OYL_FORCE_INLINE Int4 Mul(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_WRAPPING(*); }
+
+	OYL_FORCE_INLINE Int4 And(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] & a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE Int4 Or(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] | a_rhs.lanes[i]); }
+
+	OYL_FORCE_INLINE Int4 Xor(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] ^ a_rhs.lanes[i]); }
+
+	template<int Bits>
+	OYL_FORCE_INLINE
+	Int4
+	ShiftLeft(Int4 a_value)
+	{
+		_SIMD_INT4_LANEWISE(static_cast<std::int32_t>(static_cast<std::uint32_t>(a_value.lanes[i]) << Bits));
+	}
+
+	/// Arithmetic shift, copies the sign bit in
+	template<int Bits>
+	OYL_FORCE_INLINE
+	Int4
+	ShiftRight(Int4 a_value)
+	{
+		// Right shifting negative values is implementation defined before C++20, spell out the sign extension
+		_SIMD_INT4_LANEWISE(a_value.lanes[i] < 0 ? ~(~a_value.lanes[i] >> Bits) : a_value.lanes[i] >> Bits);
+	}
+
+	/// Logical shift, shifts zeroes in
+	template<int Bits>
+	OYL_FORCE_INLINE
+	Int4
+	ShiftRightLogical(Int4 a_value)
+	{
+		_SIMD_INT4_LANEWISE(static_cast<std::int32_t>(static_cast<std::uint32_t>(a_value.lanes[i]) >> Bits));
+	}
+
+	OYL_FORCE_INLINE Int4 Equal(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] == a_rhs.lanes[i] ? -1 : 0); }
+
+	OYL_FORCE_INLINE Int4 Less(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] < a_rhs.lanes[i] ? -1 : 0); }
+
+	OYL_FORCE_INLINE Int4 Greater(Int4 a_lhs, Int4 a_rhs) { _SIMD_INT4_LANEWISE(a_lhs.lanes[i] > a_rhs.lanes[i] ? -1 : 0); }
+
+	/// \return a_ifTrue in the lanes where a_mask is set, a_ifFalse elsewhere
+	OYL_FORCE_INLINE
+	Int4
+	Select(Int4 a_mask, Int4 a_ifTrue, Int4 a_ifFalse)
+	{
+		_SIMD_INT4_LANEWISE(a_mask.lanes[i] ? a_ifTrue.lanes[i] : a_ifFalse.lanes[i]);
+	}
+
+	/// \return a_value rounded to the nearest integer, ties to even. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 ConvertToInt(Float4 a_value) { _SIMD_INT4_LANEWISE(static_cast<std::int32_t>(std::nearbyint(a_value.lanes[i]))); }
+
+	/// \return a_value rounded towards zero. Out of range lanes are undefined
+	OYL_FORCE_INLINE Int4 TruncateToInt(Float4 a_value) { _SIMD_INT4_LANEWISE(static_cast<std::int32_t>(a_value.lanes[i])); }
+
+	OYL_FORCE_INLINE
+	Float4
+	ConvertToFloat(Int4 a_value)
+	{
+		Float4 result;
+		for (int i = 0; i < 4; i++)
+		{
+			result.lanes[i] = static_cast<float>(a_value.lanes[i]);
+		}
+		return result;
+	}
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE
+	Float4
+	BitCastToFloat(Int4 a_value)
+	{
+		Float4 result;
+		std::memcpy(&result, &a_value, sizeof(result));
+		return result;
+	}
+
+	/// Reinterprets the bits without conversion
+	OYL_FORCE_INLINE
+	Int4
+	BitCastToInt(Float4 a_value)
+	{
+		Int4 result;
+		std::memcpy(&result, &a_value, sizeof(result));
+		return result;
+	}
+
+	#undef _SIMD_INT4_WRAPPING
+	#undef _SIMD_INT4_LANEWISE
+#endif
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "type_Matrix3.h"
+#include "type_Matrix4.h"
+#include "type_Quaternion.h"
+#include "type_Vector3.h"
+#include "type_Vector4.h"
+
+#pragma warning( push )
+#pragma warning( disable : 26495 ) // Possibly uninitialized member
+
+namespace Oyl
+{
+	namespace Detail
+	{
+		/// Whether operations on Affine_t<TUnderlying> are routed through Simd::Float4
+		template<typename TUnderlying>
+		constexpr bool use_simd_affine_v = use_simd_vector_v<4, TUnderlying>;
+	}
+
+	/**
+	 * \brief A 3D affine transform, ie. any composition of Translate, Scale and Rotate, in 12 values instead of 16
+	 * \tparam TUnderlying The underlying data type
+	 * \remarks Uses _t type notation for the same reason as Vector_t, the free functions live in the
+	 *          Oyl::Affine namespace.
+	 *      <br>Stores the first three columns of the equivalent row-major Matrix4, each as a Vector4 whose w is
+	 *          the translation along that axis. The fourth column of an affine Matrix4 is always (0, 0, 0, 1)
+	 *          so it is implied rather than stored.
+	 *      <br>Products compose in the same order as matrices in this engine, a * b applies a then b, so
+	 *          Matrix4(a * b) == Matrix4(a) * Matrix4(b).
+	 */
+	template<typename TUnderlying>
+	struct Affine_t
+	{
+		using value_type = TUnderlying;
+		using type = Affine_t;
+
+		/// Constructs the identity transform
+		constexpr
+		Affine_t()
+			: columns {
+				Vector_t<4, TUnderlying>(1, 0, 0, 0),
+				Vector_t<4, TUnderlying>(0, 1, 0, 0),
+				Vector_t<4, TUnderlying>(0, 0, 1, 0),
+			} {}
+
+		constexpr
+		Affine_t(Vector_t<4, TUnderlying> a_x, Vector_t<4, TUnderlying> a_y, Vector_t<4, TUnderlying> a_z)
+			: columns { a_x, a_y, a_z } {}
+
+		/**
+		 * \param a_linear Rotation and scale, applied to row vectors like any other Matrix3
+		 * \remarks Matrices are read through data, the union member their constexpr constructors initialize, so
+		 *          this and the conversions to and from Matrix4 work at compile time.
+		 */
+		constexpr
+		Affine_t(Matrix_t<3, 3, TUnderlying> const& a_linear, Vector_t<3, TUnderlying> const& a_translation = Vector_t<3, TUnderlying>(0))
+			: columns {
+				Vector_t<4, TUnderlying>(a_linear.data[0], a_linear.data[3], a_linear.data[6], a_translation.data[0]),
+				Vector_t<4, TUnderlying>(a_linear.data[1], a_linear.data[4], a_linear.data[7], a_translation.data[1]),
+				Vector_t<4, TUnderlying>(a_linear.data[2], a_linear.data[5], a_linear.data[8], a_translation.data[2]),
+			} {}
+
+		/// \brief Drops the fourth column of a_matrix, which should be (0, 0, 0, 1)
+		constexpr
+		explicit
+		Affine_t(Matrix_t<4, 4, TUnderlying> const& a_matrix)
+			: columns {
+				Vector_t<4, TUnderlying>(a_matrix.data[0], a_matrix.data[4], a_matrix.data[8], a_matrix.data[12]),
+				Vector_t<4, TUnderlying>(a_matrix.data[1], a_matrix.data[5], a_matrix.data[9], a_matrix.data[13]),
+				Vector_t<4, TUnderlying>(a_matrix.data[2], a_matrix.data[6], a_matrix.data[10], a_matrix.data[14]),
+			} {}
+
+		explicit
+		constexpr
+		operator
+		Matrix_t<4, 4, TUnderlying>() const
+		{
+			Matrix_t<4, 4, TUnderlying> result;
+			for (int row = 0; row < 4; row++)
+			{
+				for (int column = 0; column < 3; column++)
+				{
+					result.data[row * 4 + column] = columns[column].data[row];
+				}
+				result.data[row * 4 + 3] = row == 3 ? 1 : 0;
+			}
+			return result;
+		}
+
+	#pragma warning( push )
+	#pragma warning( disable : 4615 ) // Unknown user type
+		union
+		{
+			Vector_t<4, TUnderlying> columns[3];
+
+			TUnderlying data[12];
+		};
+	#pragma warning( pop )
+
+		constexpr static Affine_t Identity() { return Affine_t(); }
+
+		/// \return The rotation and scale part of the transform
+		constexpr
+		Matrix_t<3, 3, TUnderlying>
+		Linear() const
+		{
+			return Matrix_t<3, 3, TUnderlying>(
+				Vector_t<3, TUnderlying>(columns[0].data[0], columns[1].data[0], columns[2].data[0]),
+				Vector_t<3, TUnderlying>(columns[0].data[1], columns[1].data[1], columns[2].data[1]),
+				Vector_t<3, TUnderlying>(columns[0].data[2], columns[1].data[2], columns[2].data[2])
+			);
+		}
+
+		constexpr
+		Vector_t<3, TUnderlying>
+		Translation() const
+		{
+			return Vector_t<3, TUnderlying>(columns[0].data[3], columns[1].data[3], columns[2].data[3]);
+		}
+
+		constexpr
+		void
+		SetTranslation(Vector_t<3, TUnderlying> const& a_translation)
+		{
+			for (int column = 0; column < 3; column++)
+			{
+				columns[column].data[3] = a_translation.data[column];
+			}
+		}
+
+		constexpr
+		Affine_t&
+		operator *=(Affine_t const& a_other) noexcept
+		{
+			*this = *this * a_other;
+			return *this;
+		}
+	};
+
+	namespace Detail
+	{
+		/**
+		 * \brief a_lhs * a_rhs for affine transforms stored as three columns
+		 * \remarks Column j of the product is a_lhs's columns weighted by the linear part of a_rhs's column j,
+		 *          plus the translation of a_rhs's column j. Each column is three broadcast multiply-adds.
+		 */
+		OYL_FORCE_INLINE
+		void
+		MultiplyAffine(float const* a_lhs, float const* a_rhs, float* a_out)
+		{
+			Simd::Float4 lhs0 = Simd::Load(a_lhs + 0);
+			Simd::Float4 lhs1 = Simd::Load(a_lhs + 4);
+			Simd::Float4 lhs2 = Simd::Load(a_lhs + 8);
+
+			Simd::Float4 translationMask = Simd::Set(0, 0, 0, 1);
+
+			for (int i = 0; i < 12; i += 4)
+			{
+				Simd::Float4 rhs    = Simd::Load(a_rhs + i);
+				Simd::Float4 result = Simd::Mul(rhs, translationMask);
+				result = Simd::MulAdd(lhs0, Simd::Shuffle<0, 0, 0, 0>(rhs), result);
+				result = Simd::MulAdd(lhs1, Simd::Shuffle<1, 1, 1, 1>(rhs), result);
+				result = Simd::MulAdd(lhs2, Simd::Shuffle<2, 2, 2, 2>(rhs), result);
+				Simd::Store(a_out + i, result);
+			}
+		}
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	Affine_t<TUnderlying>
+	operator *(Affine_t<TUnderlying> const& a_lhs, Affine_t<TUnderlying> const& a_rhs) noexcept
+	{
+		Affine_t<TUnderlying> result;
+
+		if constexpr (Detail::use_simd_affine_v<TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Detail::MultiplyAffine(a_lhs.data, a_rhs.data, result.data);
+				return result;
+			}
+		}
+
+		// 27 multiplies for the linear part and 9 for the translation, against 64 for a Matrix4 product
+		for (int column = 0; column < 3; column++)
+		{
+			Vector_t<4, TUnderlying> const& rhs = a_rhs.columns[column];
+			for (int row = 0; row < 4; row++)
+			{
+				result.columns[column].data[row] =
+					a_lhs.columns[0].data[row] * rhs.data[0] +
+					a_lhs.columns[1].data[row] * rhs.data[1] +
+					a_lhs.columns[2].data[row] * rhs.data[2] +
+					(row == 3 ? rhs.data[3] : 0);
+			}
+		}
+		return result;
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	bool
+	operator ==(Affine_t<TUnderlying> const& a_lhs, Affine_t<TUnderlying> const& a_rhs) noexcept
+	{
+		for (int i = 0; i < 12; i++)
+		{
+			if (a_lhs.data[i] != a_rhs.data[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	bool
+	operator !=(Affine_t<TUnderlying> const& a_lhs, Affine_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return !(a_lhs == a_rhs);
+	}
+
+	namespace Affine
+	{
+		/// \return a_point * Matrix4(a_transform), treating a_point as (x, y, z, 1)
+		template<typename TUnderlying>
+		constexpr
+		Vector_t<3, TUnderlying>
+		TransformPoint(Affine_t<TUnderlying> const& a_transform, Vector_t<3, TUnderlying> const& a_point)
+		{
+			Vector_t<3, TUnderlying> result;
+			for (int column = 0; column < 3; column++)
+			{
+				Vector_t<4, TUnderlying> const& value = a_transform.columns[column];
+				result.data[column] = a_point.data[0] * value.data[0] + a_point.data[1] * value.data[1] + a_point.data[2] * value.data[2] + value.data[3];
+			}
+			return result;
+		}
+
+		/// \return a_direction * Matrix4(a_transform), treating a_direction as (x, y, z, 0)
+		template<typename TUnderlying>
+		constexpr
+		Vector_t<3, TUnderlying>
+		TransformDirection(Affine_t<TUnderlying> const& a_transform, Vector_t<3, TUnderlying> const& a_direction)
+		{
+			Vector_t<3, TUnderlying> result;
+			for (int column = 0; column < 3; column++)
+			{
+				Vector_t<4, TUnderlying> const& value = a_transform.columns[column];
+				result.data[column] = a_direction.data[0] * value.data[0] + a_direction.data[1] * value.data[1] + a_direction.data[2] * value.data[2];
+			}
+			return result;
+		}
+
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Affine_t<TUnderlying> const& a_transform)
+		{
+			return Matrix::Determinant(a_transform.Linear());
+		}
+
+		/**
+		 * \brief General affine inverse, inverts the linear part and moves the translation through it
+		 * \remark The result is unspecified if the linear part is singular, ie. a zero scale.
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Affine_t<TUnderlying>
+		Inverse(Affine_t<TUnderlying> const& a_transform)
+		{
+			Matrix_t<3, 3, TUnderlying> linear      = Matrix::Inverse(a_transform.Linear());
+			Vector_t<3, TUnderlying>    translation = -(a_transform.Translation() * linear);
+			return Affine_t<TUnderlying>(linear, translation);
+		}
+
+		/// \brief Inverse of a transform made of only rotation and translation, where the linear part is orthonormal
+		template<typename TUnderlying>
+		constexpr
+		Affine_t<TUnderlying>
+		InverseRigid(Affine_t<TUnderlying> const& a_transform)
+		{
+			Matrix_t<3, 3, TUnderlying> rotation    = Matrix::Transpose(a_transform.Linear());
+			Vector_t<3, TUnderlying>    translation = -(a_transform.Translation() * rotation);
+			return Affine_t<TUnderlying>(rotation, translation);
+		}
+
+		/// \return The transform that scales by a_scale, then rotates by a_rotation, then translates by a_translation
+		template<typename TUnderlying>
+		constexpr
+		Affine_t<TUnderlying>
+		FromTRS(Vector_t<3, TUnderlying> const& a_translation, Quaternion_t<TUnderlying> const& a_rotation, Vector_t<3, TUnderlying> const& a_scale)
+		{
+			Matrix_t<3, 3, TUnderlying> linear = Quaternion::ToMatrix3(a_rotation);
+			for (int row = 0; row < 3; row++)
+			{
+				linear.cols[row] = linear.cols[row] * a_scale.data[row];
+			}
+			return Affine_t<TUnderlying>(linear, a_translation);
+		}
+	}
+}
+
+#pragma warning( pop )
@@ -3,17 +3,33 @@
 #include <cstring>
 #include <cstdint>
 #include <cmath>
+#include <utility>
 
 #include "Core/Common.h"
+#include "simd_Float4.h"
 #include "type_Vector.h"
 
 namespace Oyl
 {
+	/**
+	 * \brief Order in which Matrix_t stores its elements in data
+	 * \remarks The layout only changes the memory, every operation gives the same results in either one.
+	 *          Row vectors are multiplied on the left in both, ie. v * M.
+	 */
+	enum class MatrixLayout
+	{
+		/// data holds one row after the other, this is what the engine computes with
+		RowMajor,
+		/// data holds one column after the other, for consumers such as GPU buffers or physics libraries
+		ColumnMajor,
+	};
+
 	/**
 	 * \brief Row-Major arbitrary-dimensional representation of a matrix
 	 * \tparam SizeX The number of columns in the matrix
 	 * \tparam SizeY The number of rows in the matrix
 	 * \tparam TUnderlying The underlying data type
+	 * \tparam Layout Storage order of data, column-major matrices are declared in MatrixLayout.h
 	 * \remark The name uses _t type notation because for the API we want, there is no way to
 	 *         have a template and non-template type share an identifier.
 	 *         ie.
@@ -28,22 +44,180 @@ namespace Oyl
 	 *		       ...
 	 *		   } // Compile error, redefinition
 	 *		   \endcode
-	 *	   <br>All matrix specializations should implement the _MATRIX_GENERATE_MEMBER_FUNCTIONS() macro.
+	 *	   <br>All row-major matrix specializations should implement the _MATRIX_GENERATE_MEMBER_FUNCTIONS() macro.
 	 */
-	template<int SizeX, int SizeY, typename TUnderlying>
+	template<int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout = MatrixLayout::RowMajor>
 	struct Matrix_t
 	{
 		using value_type = TUnderlying;
 		using type = Matrix_t;
 
-		constexpr static int size_x = SizeX;
-		constexpr static int size_y = SizeY;
+		constexpr static int          size_x = SizeX;
+		constexpr static int          size_y = SizeY;
+		constexpr static MatrixLayout layout = Layout;
 
 		TUnderlying data[SizeX * SizeY];
 	};
 
+	namespace Detail
+	{
+		/**
+		 * \brief Whether operations on Matrix_t<SizeX, SizeY, TUnderlying> are routed through Simd::Float4,
+		 *        with each row held in one register
+		 */
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr bool use_simd_matrix_v =
+			OYL_SIMD != OYL_SIMD_SCALAR && std::is_same_v<TUnderlying, float> && SizeX == 4 && SizeY == 4;
+
+		/// a_out = a_lhs * a_rhs for row-major 4x4 matrices. a_out may alias either input.
+		OYL_FORCE_INLINE
+		void
+		MultiplyMatrix4(float const* a_lhs, float const* a_rhs, float* a_out) noexcept
+		{
+			Simd::Float4 rhs0 = Simd::Load(a_rhs + 0);
+			Simd::Float4 rhs1 = Simd::Load(a_rhs + 4);
+			Simd::Float4 rhs2 = Simd::Load(a_rhs + 8);
+			Simd::Float4 rhs3 = Simd::Load(a_rhs + 12);
+
+			// Each result row is a linear combination of the rows of a_rhs, weighted by the matching row of a_lhs
+			Simd::Float4 rows[4];
+			for (int y = 0; y < 4; y++)
+			{
+				Simd::Float4 lhs = Simd::Load(a_lhs + y * 4);
+
+				Simd::Float4 row = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(lhs), rhs0);
+				row = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(lhs), rhs1, row);
+				row = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(lhs), rhs2, row);
+				row = Simd::MulAdd(Simd::Shuffle<3, 3, 3, 3>(lhs), rhs3, row);
+				rows[y] = row;
+			}
+
+			for (int y = 0; y < 4; y++)
+			{
+				Simd::Store(a_out + y * 4, rows[y]);
+			}
+		}
+
+	#if OYL_SIMD == OYL_SIMD_AVX
+		/// AVX variant of MultiplyMatrix4 that computes two result rows per instruction
+		OYL_FORCE_INLINE
+		void
+		MultiplyMatrix4Avx(float const* a_lhs, float const* a_rhs, float* a_out) noexcept
+		{
+			__m256 rhs0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a_rhs + 0));
+			__m256 rhs1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a_rhs + 4));
+			__m256 rhs2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a_rhs + 8));
+			__m256 rhs3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(a_rhs + 12));
+
+			__m256 lhs01 = _mm256_loadu_ps(a_lhs + 0);
+			__m256 lhs23 = _mm256_loadu_ps(a_lhs + 8);
+
+			auto combineRows = [&](__m256 a_lhsRows)
+			{
+				__m256 rows = _mm256_mul_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0x00), rhs0);
+			#if OYL_SIMD_FMA
+				rows = _mm256_fmadd_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0x55), rhs1, rows);
+				rows = _mm256_fmadd_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0xAA), rhs2, rows);
+				rows = _mm256_fmadd_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0xFF), rhs3, rows);
+			#else
+				rows = _mm256_add_ps(rows, _mm256_mul_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0x55), rhs1));
+				rows = _mm256_add_ps(rows, _mm256_mul_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0xAA), rhs2));
+				rows = _mm256_add_ps(rows, _mm256_mul_ps(_mm256_shuffle_ps(a_lhsRows, a_lhsRows, 0xFF), rhs3));
+			#endif
+				return rows;
+			};
+
+			__m256 out01 = combineRows(lhs01);
+			__m256 out23 = combineRows(lhs23);
+
+			_mm256_storeu_ps(a_out + 0, out01);
+			_mm256_storeu_ps(a_out + 8, out23);
+		}
+	#endif
+
+		/// \return a_lhs * a_rhs where a_lhs is treated as a row vector
+		OYL_FORCE_INLINE
+		Simd::Float4
+		MultiplyVector4Matrix4(Simd::Float4 a_lhs, float const* a_rhs) noexcept
+		{
+			Simd::Float4 result = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(a_lhs), Simd::Load(a_rhs + 0));
+			result = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(a_lhs), Simd::Load(a_rhs + 4), result);
+			result = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(a_lhs), Simd::Load(a_rhs + 8), result);
+			result = Simd::MulAdd(Simd::Shuffle<3, 3, 3, 3>(a_lhs), Simd::Load(a_rhs + 12), result);
+			return result;
+		}
+
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr bool use_simd_matrix3_v =
+			OYL_SIMD != OYL_SIMD_SCALAR && std::is_same_v<TUnderlying, float> && SizeX == 3 && SizeY == 3;
+
+		/// \return a_lhs * a_rhs where a_lhs is treated as a row vector. The w lane of the result is unspecified.
+		OYL_FORCE_INLINE
+		Simd::Float4
+		MultiplyVector3Matrix3(Simd::Float4 a_lhs, float const* a_rhs) noexcept
+		{
+			// The first two rows are read with a full load, the extra lane only reaches into the next row
+			Simd::Float4 result = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(a_lhs), Simd::Load(a_rhs + 0));
+			result = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(a_lhs), Simd::Load(a_rhs + 3), result);
+			result = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(a_lhs), Simd::Load3(a_rhs + 6), result);
+			return result;
+		}
+
+		/// a_out = a_lhs * a_rhs for row-major 3x3 matrices. a_out must not alias either input.
+		OYL_FORCE_INLINE
+		void
+		MultiplyMatrix3(float const* a_lhs, float const* a_rhs, float* a_out) noexcept
+		{
+			Simd::Store3(a_out + 0, MultiplyVector3Matrix3(Simd::Load(a_lhs + 0), a_rhs));
+			Simd::Store3(a_out + 3, MultiplyVector3Matrix3(Simd::Load(a_lhs + 3), a_rhs));
+			Simd::Store3(a_out + 6, MultiplyVector3Matrix3(Simd::Load3(a_lhs + 6), a_rhs));
+		}
+
+		/// \return Element (X, Y) of a_lhs * a_rhs, with the sum over the shared dimension expanded at compile time
+		template<int SizeShared, int SizeRhsX, int Y, int X, typename TUnderlying, int... Shared>
+		constexpr
+		TUnderlying
+		MultiplyElement(TUnderlying const* a_lhs, TUnderlying const* a_rhs, std::integer_sequence<int, Shared...>) noexcept
+		{
+			return (... + (a_lhs[Y * SizeShared + Shared] * a_rhs[Shared * SizeRhsX + X]));
+		}
+
+		/**
+		 * \brief Computes every element of a_lhs * a_rhs for row-major matrices, fully unrolled
+		 * \param a_out Storage for sizeof...(Indices) elements, must not alias either input
+		 */
+		template<int SizeShared, int SizeRhsX, typename TUnderlying, int... Indices>
+		constexpr
+		void
+		MultiplyUnrolled(
+			TUnderlying const* a_lhs,
+			TUnderlying const* a_rhs,
+			TUnderlying*       a_out,
+			std::integer_sequence<int, Indices...>
+		) noexcept
+		{
+			constexpr auto shared = std::make_integer_sequence<int, SizeShared>();
+			((a_out[Indices] = MultiplyElement<SizeShared, SizeRhsX, Indices / SizeRhsX, Indices % SizeRhsX>(a_lhs, a_rhs, shared)), ...);
+		}
+	}
+
 	namespace Matrix
 	{
+		/// \return The position of the element in row a_row and column a_column within TMatrix::data
+		template<typename TMatrix>
+		constexpr
+		int
+		Index(int a_row, int a_column) noexcept
+		{
+			if constexpr (TMatrix::layout == MatrixLayout::ColumnMajor)
+			{
+				return a_column * TMatrix::size_y + a_row;
+			} else
+			{
+				return a_row * TMatrix::size_x + a_column;
+			}
+		}
+
 		template<typename TMatrix>
 		static
 		constexpr
@@ -58,7 +232,7 @@ namespace Oyl
 			TMatrix result { 0 };
 			for (int i = 0; i < min_size; i++)
 			{
-				result.data[i * size_x + i] = a_diagonal;
+				result.data[Index<TMatrix>(i, i)] = a_diagonal;
 			}
 			return result;
 		}
@@ -73,43 +247,274 @@ namespace Oyl
 			return Identity<TMatrix>(a_diagonal);
 		}
 
-		template<int SizeX, int SizeY, typename TUnderlying>
+		template<int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout>
 		constexpr
-		Matrix_t<SizeY, SizeX, TUnderlying>
-		Transpose(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
+		Matrix_t<SizeY, SizeX, TUnderlying, Layout>
+		Transpose(Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_value) noexcept
 		{
-			//constexpr int min_size = SizeX < SizeY ? SizeX : SizeY;
+			using TResult = Matrix_t<SizeY, SizeX, TUnderlying, Layout>;
+			using TValue  = Matrix_t<SizeX, SizeY, TUnderlying, Layout>;
 
-			Matrix_t<SizeY, SizeX, TUnderlying> result;
+			TResult result {};
+
+			if constexpr (Detail::use_simd_matrix_v<SizeX, SizeY, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Simd::Float4 row0 = Simd::Load(a_value.data + 0);
+					Simd::Float4 row1 = Simd::Load(a_value.data + 4);
+					Simd::Float4 row2 = Simd::Load(a_value.data + 8);
+					Simd::Float4 row3 = Simd::Load(a_value.data + 12);
+					Simd::Transpose(row0, row1, row2, row3);
+					Simd::Store(result.data + 0, row0);
+					Simd::Store(result.data + 4, row1);
+					Simd::Store(result.data + 8, row2);
+					Simd::Store(result.data + 12, row3);
+					return result;
+				}
+			}
 
 			for (int y = 0; y < SizeY; y++)
 			{	
 				for (int x = 0; x < SizeX; x++)
 				{
 					//result[x][y] = a_value[y][x];
-					result.data[x * SizeY + y] = a_value.data[y * SizeX + x];
+					result.data[Index<TResult>(x, y)] = a_value.data[Index<TValue>(y, x)];
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		 * \brief Copies a_value into the storage order TargetLayout, the elements stay where they are in the matrix
+		 * \remarks Converting between layouts is a transpose of data. For arrays see the bulk overloads in MatrixLayout.h.
+		 */
+		template<MatrixLayout TargetLayout, int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout>
+		constexpr
+		Matrix_t<SizeX, SizeY, TUnderlying, TargetLayout>
+		ConvertLayout(Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_value) noexcept
+		{
+			using TResult = Matrix_t<SizeX, SizeY, TUnderlying, TargetLayout>;
+			using TValue  = Matrix_t<SizeX, SizeY, TUnderlying, Layout>;
+
+			TResult result {};
+
+			if constexpr (Detail::use_simd_matrix_v<SizeX, SizeY, TUnderlying> && TargetLayout != Layout)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Simd::Float4 row0 = Simd::Load(a_value.data + 0);
+					Simd::Float4 row1 = Simd::Load(a_value.data + 4);
+					Simd::Float4 row2 = Simd::Load(a_value.data + 8);
+					Simd::Float4 row3 = Simd::Load(a_value.data + 12);
+					Simd::Transpose(row0, row1, row2, row3);
+					Simd::Store(result.data + 0, row0);
+					Simd::Store(result.data + 4, row1);
+					Simd::Store(result.data + 8, row2);
+					Simd::Store(result.data + 12, row3);
+					return result;
+				}
+			}
+
+			for (int y = 0; y < SizeY; y++)
+			{
+				for (int x = 0; x < SizeX; x++)
+				{
+					result.data[Index<TResult>(y, x)] = a_value.data[Index<TValue>(y, x)];
 				}
 			}
 
 			return result;
 		}
 
+		/**
+		 * \brief Factorizes a_value into PA = LU with partial pivoting
+		 * \param a_lu Receives L below the diagonal (with an implied unit diagonal) and U on and above it
+		 * \param a_pivots Receives the source row of each row of the factorization
+		 * \return 1 or -1 depending on the parity of the row swaps, or 0 if a_value is singular
+		 */
+		template<int Size, typename TUnderlying>
+		constexpr
+		TUnderlying
+		DecomposeLU(Matrix_t<Size, Size, TUnderlying> const& a_value, TUnderlying* a_lu, int* a_pivots) noexcept
+		{
+			TUnderlying sign = 1;
+
+			for (int i = 0; i < Size * Size; i++)
+			{
+				a_lu[i] = a_value.data[i];
+			}
+			for (int i = 0; i < Size; i++)
+			{
+				a_pivots[i] = i;
+			}
+
+			for (int k = 0; k < Size; k++)
+			{
+				int         pivot    = k;
+				TUnderlying pivotAbs = a_lu[k * Size + k] < 0 ? -a_lu[k * Size + k] : a_lu[k * Size + k];
+				for (int y = k + 1; y < Size; y++)
+				{
+					TUnderlying candidate = a_lu[y * Size + k] < 0 ? -a_lu[y * Size + k] : a_lu[y * Size + k];
+					if (candidate > pivotAbs)
+					{
+						pivot    = y;
+						pivotAbs = candidate;
+					}
+				}
+
+				if (pivotAbs == 0)
+				{
+					return 0;
+				}
+
+				if (pivot != k)
+				{
+					for (int x = 0; x < Size; x++)
+					{
+						TUnderlying temp       = a_lu[k * Size + x];
+						a_lu[k * Size + x]     = a_lu[pivot * Size + x];
+						a_lu[pivot * Size + x] = temp;
+					}
+
+					int temp        = a_pivots[k];
+					a_pivots[k]     = a_pivots[pivot];
+					a_pivots[pivot] = temp;
+
+					sign = -sign;
+				}
+
+				for (int y = k + 1; y < Size; y++)
+				{
+					TUnderlying factor = a_lu[y * Size + k] / a_lu[k * Size + k];
+					a_lu[y * Size + k] = factor;
+					for (int x = k + 1; x < Size; x++)
+					{
+						a_lu[y * Size + x] -= factor * a_lu[k * Size + x];
+					}
+				}
+			}
+
+			return sign;
+		}
+
+		/**
+		 * \brief Determinant through LU decomposition. Valid for any size, O(n^3).
+		 */
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr
+		TUnderlying
+		DeterminantLU(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
+		{
+			static_assert(SizeX == SizeY, "Determinant is only defined for square matrices");
+
+			TUnderlying lu[SizeX * SizeX] {};
+			int         pivots[SizeX] {};
+
+			TUnderlying result = DecomposeLU(a_value, lu, pivots);
+			for (int i = 0; i < SizeX; i++)
+			{
+				result *= lu[i * SizeX + i];
+			}
+			return result;
+		}
+
+		/**
+		 * \brief Inverse through LU decomposition. Valid for any size, O(n^3).
+		 * \remark The result is unspecified if a_value is singular, check Determinant() first if that's possible.
+		 */
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr
+		Matrix_t<SizeX, SizeY, TUnderlying>
+		InverseLU(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
+		{
+			static_assert(SizeX == SizeY, "Inverse is only defined for square matrices");
+			constexpr int size = SizeX;
+
+			TUnderlying lu[size * size] {};
+			int         pivots[size] {};
+			DecomposeLU(a_value, lu, pivots);
+
+			Matrix_t<SizeX, SizeY, TUnderlying> result { 0 };
+
+			// Solve LU * column = P * e_x for each column of the identity
+			for (int x = 0; x < size; x++)
+			{
+				TUnderlying column[size] {};
+				for (int y = 0; y < size; y++)
+				{
+					TUnderlying sum = pivots[y] == x ? 1 : 0;
+					for (int k = 0; k < y; k++)
+					{
+						sum -= lu[y * size + k] * column[k];
+					}
+					column[y] = sum;
+				}
+				for (int y = size - 1; y >= 0; y--)
+				{
+					TUnderlying sum = column[y];
+					for (int k = y + 1; k < size; k++)
+					{
+						sum -= lu[y * size + k] * column[k];
+					}
+					column[y] = sum / lu[y * size + y];
+				}
+
+				for (int y = 0; y < size; y++)
+				{
+					result.data[y * size + x] = column[y];
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		 * \brief General determinant. Sizes 2, 3 and 4 have closed form overloads in their respective headers.
+		 */
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
+		{
+			return DeterminantLU(a_value);
+		}
+
+		/**
+		 * \brief General inverse. Sizes 2, 3 and 4 have closed form overloads in their respective headers,
+		 *        for 4x4 transforms see also InverseAffine and InverseRigid.
+		 * \remark The result is unspecified if a_value is singular, check Determinant() first if that's possible.
+		 */
 		template<int SizeX, int SizeY, typename TUnderlying>
 		constexpr
 		Matrix_t<SizeX, SizeY, TUnderlying>
 		Inverse(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
 		{
-			// TODO: Implement Inverse and Determinant
+			return InverseLU(a_value);
 		}
 	}
 	
 	// Matrix-Matrix Addition
-	template<int SizeX, int SizeY, typename TUnderlying>
+	template<int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout>
 	constexpr
-	Matrix_t<SizeX, SizeY, TUnderlying>
-	operator +(Matrix_t<SizeX, SizeY, TUnderlying> const& a_lhs, Matrix_t<SizeX, SizeY, TUnderlying> const& a_rhs) noexcept
+	Matrix_t<SizeX, SizeY, TUnderlying, Layout>
+	operator +(Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_lhs, Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_rhs) noexcept
 	{
-		Matrix_t<SizeX, SizeY, TUnderlying> result;
+		Matrix_t<SizeX, SizeY, TUnderlying, Layout> result {};
+
+		if constexpr (Detail::use_simd_matrix_v<SizeX, SizeY, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				for (int i = 0; i < SizeX * SizeY; i += 4)
+				{
+					Simd::Store(result.data + i, Simd::Add(Simd::Load(a_lhs.data + i), Simd::Load(a_rhs.data + i)));
+				}
+				return result;
+			}
+		}
+
 		for (int i = 0; i < SizeX * SizeY; i++)
 		{
 			result.data[i] = a_lhs.data[i] + a_rhs.data[i];
@@ -118,12 +523,25 @@ namespace Oyl
 	}
 
 	// Matrix-Matrix Subtraction
-	template<int SizeX, int SizeY, typename TUnderlying>
+	template<int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout>
 	constexpr
-	Matrix_t<SizeX, SizeY, TUnderlying>
-	operator -(Matrix_t<SizeX, SizeY, TUnderlying> const& a_lhs, Matrix_t<SizeX, SizeY, TUnderlying> const& a_rhs) noexcept
+	Matrix_t<SizeX, SizeY, TUnderlying, Layout>
+	operator -(Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_lhs, Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_rhs) noexcept
 	{
-		Matrix_t<SizeX, SizeY, TUnderlying> result;
+		Matrix_t<SizeX, SizeY, TUnderlying, Layout> result {};
+
+		if constexpr (Detail::use_simd_matrix_v<SizeX, SizeY, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				for (int i = 0; i < SizeX * SizeY; i += 4)
+				{
+					Simd::Store(result.data + i, Simd::Sub(Simd::Load(a_lhs.data + i), Simd::Load(a_rhs.data + i)));
+				}
+				return result;
+			}
+		}
+
 		for (int i = 0; i < SizeX * SizeY; i++)
 		{
 			result.data[i] = a_lhs.data[i] - a_rhs.data[i];
@@ -132,12 +550,25 @@ namespace Oyl
 	}
 
 	// Matrix-Scalar Multiplication
-	template<int SizeX, int SizeY, typename TUnderlying>
+	template<int SizeX, int SizeY, typename TUnderlying, MatrixLayout Layout>
 	constexpr
-	Matrix_t<SizeX, SizeY, TUnderlying>
-	operator *(Matrix_t<SizeX, SizeY, TUnderlying> a_lhs, TUnderlying a_rhs) noexcept
+	Matrix_t<SizeX, SizeY, TUnderlying, Layout>
+	operator *(Matrix_t<SizeX, SizeY, TUnderlying, Layout> const& a_lhs, TUnderlying a_rhs) noexcept
 	{
-		Matrix_t<SizeX, SizeY, TUnderlying> result;
+		Matrix_t<SizeX, SizeY, TUnderlying, Layout> result {};
+
+		if constexpr (Detail::use_simd_matrix_v<SizeX, SizeY, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Simd::Float4 scale = Simd::Splat(a_rhs);
+				for (int i = 0; i < SizeX * SizeY; i += 4)
+				{
+					Simd::Store(result.data + i, Simd::Mul(Simd::Load(a_lhs.data + i), scale));
+				}
+				return result;
+			}
+		}
 		for (int i = 0; i < SizeX * SizeY; i++)
 		{
 			result.data[i] = a_lhs.data[i] * a_rhs;
@@ -146,55 +577,74 @@ namespace Oyl
 	}
 
 	// Matrix-Matrix Multiplication
+	// Produces a SizeRhsX x SizeLhsY matrix, ie. (n x m) * (p x n) = (p x m) in (columns x rows)
 	template<int SizeShared, int SizeLhsY, int SizeRhsX, typename TUnderlying>
 	constexpr
-	Matrix_t<SizeShared, SizeLhsY, TUnderlying>
-	operator *(Matrix_t<SizeShared, SizeLhsY, TUnderlying> a_lhs, Matrix_t<SizeRhsX, SizeShared, TUnderlying> a_rhs) noexcept
+	Matrix_t<SizeRhsX, SizeLhsY, TUnderlying>
+	operator *(Matrix_t<SizeShared, SizeLhsY, TUnderlying> const& a_lhs, Matrix_t<SizeRhsX, SizeShared, TUnderlying> const& a_rhs) noexcept
 	{
-		Matrix_t<SizeShared, SizeLhsY, TUnderlying> result { 0 };
-
-		const auto sizeX      = SizeRhsX;
-		const auto sizeY      = SizeLhsY;
-		const auto sizeShared = SizeShared;
-
-		// ReSharper disable CppBadChildStatementIndent
-		for (int y = 0; y < SizeLhsY; y++)
-			for (int x = 0; x < SizeRhsX; x++)
-				for (int z = 0; z < SizeShared; z++)
-				{
-					auto        leftIndex = y * SizeShared + z;
-					TUnderlying left      = a_lhs.data[leftIndex];
+		Matrix_t<SizeRhsX, SizeLhsY, TUnderlying> result { 0 };
 
-					auto        rightIndex = z * SizeRhsX + x;
-					TUnderlying right      = a_rhs.data[rightIndex];
+		if constexpr (Detail::use_simd_matrix_v<SizeShared, SizeLhsY, TUnderlying> && SizeRhsX == 4)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+			#if OYL_SIMD == OYL_SIMD_AVX
+				Detail::MultiplyMatrix4Avx(a_lhs.data, a_rhs.data, result.data);
+			#else
+				Detail::MultiplyMatrix4(a_lhs.data, a_rhs.data, result.data);
+			#endif
+				return result;
+			}
+		} else if constexpr (Detail::use_simd_matrix3_v<SizeShared, SizeLhsY, TUnderlying> && SizeRhsX == 3)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Detail::MultiplyMatrix3(a_lhs.data, a_rhs.data, result.data);
+				return result;
+			}
+		}
 
-					TUnderlying product = left * right;
-					result.data[y * SizeShared + x] += product;
-				}
-		// ReSharper restore CppBadChildStatementIndent
+		Detail::MultiplyUnrolled<SizeShared, SizeRhsX>(
+			a_lhs.data,
+			a_rhs.data,
+			result.data,
+			std::make_integer_sequence<int, SizeRhsX * SizeLhsY>()
+		);
 
 		return result;
 	}
 
-	// Matrix-Vector Multiplication Specialization
+	// Vector-Matrix Multiplication, treating the vector as a single row
 	template<int SizeShared, int SizeRhsX, typename TUnderlying>
 	constexpr
-	Vector_t<SizeShared, TUnderlying>
-	operator *(Vector_t<SizeShared, TUnderlying> a_lhs, Matrix_t<SizeRhsX, SizeShared, TUnderlying> a_rhs) noexcept
+	Vector_t<SizeRhsX, TUnderlying>
+	operator *(Vector_t<SizeShared, TUnderlying> const& a_lhs, Matrix_t<SizeRhsX, SizeShared, TUnderlying> const& a_rhs) noexcept
 	{
-		constexpr int size_shared = SizeShared;
-		constexpr int size_rhs_x  = SizeRhsX;
-
-		// Don't use SizeShared directly, causes stack corruptions on some systems
-		std::size_t sizeof_data = sizeof(TUnderlying) * size_shared;
+		Vector_t<SizeRhsX, TUnderlying> result {};
 
-		Matrix_t<SizeShared, 1, TUnderlying> lhsMatrix;
-		std::memcpy(lhsMatrix.data, a_lhs.data, sizeof_data);
-
-		Matrix_t<SizeShared, 1, TUnderlying> product = lhsMatrix * a_rhs;
+		if constexpr (Detail::use_simd_matrix_v<SizeRhsX, SizeShared, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Simd::Store(result.data, Detail::MultiplyVector4Matrix4(Simd::Load(a_lhs.data), a_rhs.data));
+				return result;
+			}
+		} else if constexpr (Detail::use_simd_matrix3_v<SizeRhsX, SizeShared, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Simd::Store3(result.data, Detail::MultiplyVector3Matrix3(Simd::Load3(a_lhs.data), a_rhs.data));
+				return result;
+			}
+		}
 
-		Vector_t<SizeShared, TUnderlying> result;
-		std::memcpy(result.data, product.data, sizeof_data);
+		Detail::MultiplyUnrolled<SizeShared, SizeRhsX>(
+			a_lhs.data,
+			a_rhs.data,
+			result.data,
+			std::make_integer_sequence<int, SizeRhsX>()
+		);
 
 		return result;
 	}
@@ -204,6 +654,7 @@ namespace Oyl
 		constexpr \
 		explicit \
 		Matrix_t(Matrix_t<SizeX, SizeY, TUnderlying> const& a_other) noexcept \
+			: data {} \
 		{ \
 			constexpr int min_x = SizeX < size_x ? SizeX : size_x; \
 			constexpr int min_y = SizeY < size_y ? SizeY : size_y; \
@@ -234,7 +685,7 @@ namespace Oyl
 	#define _MATRIX_GENERATE_MEMBER_FUNCTIONS() \
 		constexpr \
 		Matrix_t& \
-		operator *=(Matrix_t a_other) noexcept \
+		operator *=(Matrix_t const& a_other) noexcept \
 		{ \
 			*this = *this * a_other; \
 			return *this; \
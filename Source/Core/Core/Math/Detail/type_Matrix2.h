@@ -18,20 +18,27 @@ namespace Oyl
 		using value_type = TUnderlying;
 		using type = Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>;
 
-		constexpr static int size_x = MATRIX_SIZE;
-		constexpr static int size_y = MATRIX_SIZE;
+		constexpr static int          size_x = MATRIX_SIZE;
+		constexpr static int          size_y = MATRIX_SIZE;
+		constexpr static MatrixLayout layout = MatrixLayout::RowMajor;
 
+		constexpr
 		Matrix_t()
 			: Matrix_t(0) {}
 
+		constexpr
 		explicit
 		Matrix_t(TUnderlying a_value)
 			: data { a_value } { }
 
+		constexpr
 		Matrix_t(
 			Vector_t<MATRIX_SIZE, TUnderlying> a_x,
 			Vector_t<MATRIX_SIZE, TUnderlying> a_y
-		) : cols { a_x, a_y } {}
+		) : data {
+			a_x.data[0], a_x.data[1],
+			a_y.data[0], a_y.data[1]
+		} {}
 
 		_MATRIX_GENERATE_CONSTRUCTORS();
 
@@ -53,6 +60,32 @@ namespace Oyl
 
 		_MATRIX_GENERATE_MEMBER_FUNCTIONS();
 	};
+
+	namespace Matrix
+	{
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			return a_value.data[0] * a_value.data[3] - a_value.data[1] * a_value.data[2];
+		}
+
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>
+		Inverse(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			TUnderlying inverseDeterminant = 1 / Determinant(a_value);
+
+			Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> result;
+			result.data[0] =  a_value.data[3] * inverseDeterminant;
+			result.data[1] = -a_value.data[1] * inverseDeterminant;
+			result.data[2] = -a_value.data[2] * inverseDeterminant;
+			result.data[3] =  a_value.data[0] * inverseDeterminant;
+			return result;
+		}
+	}
 }
 
 #pragma warning( pop )
@@ -18,21 +18,29 @@ namespace Oyl
 		using value_type = TUnderlying;
 		using type = Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>;
 
-		constexpr static int size_x = MATRIX_SIZE;
-		constexpr static int size_y = MATRIX_SIZE;
+		constexpr static int          size_x = MATRIX_SIZE;
+		constexpr static int          size_y = MATRIX_SIZE;
+		constexpr static MatrixLayout layout = MatrixLayout::RowMajor;
 
+		constexpr
 		Matrix_t()
 			: Matrix_t(0) {}
 
+		constexpr
 		explicit
 		Matrix_t(TUnderlying a_value)
 			: data { a_value } { }
 
+		constexpr
 		Matrix_t(
 			Vector_t<MATRIX_SIZE, TUnderlying> a_x,
 			Vector_t<MATRIX_SIZE, TUnderlying> a_y,
 			Vector_t<MATRIX_SIZE, TUnderlying> a_z
-		) : cols { a_x, a_y, a_z } {}
+		) : data {
+			a_x.data[0], a_x.data[1], a_x.data[2],
+			a_y.data[0], a_y.data[1], a_y.data[2],
+			a_z.data[0], a_z.data[1], a_z.data[2]
+		} {}
 
 		_MATRIX_GENERATE_CONSTRUCTORS();
 		
@@ -56,6 +64,46 @@ namespace Oyl
 
 		_MATRIX_GENERATE_MEMBER_FUNCTIONS();
 	};
+
+	namespace Matrix
+	{
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			auto const& m = a_value.data;
+			return m[0] * (m[4] * m[8] - m[5] * m[7])
+			     - m[1] * (m[3] * m[8] - m[5] * m[6])
+			     + m[2] * (m[3] * m[7] - m[4] * m[6]);
+		}
+
+		/**
+		 * \brief Closed form inverse through the adjugate
+		 * \remark The result is unspecified if a_value is singular
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>
+		Inverse(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			auto const& m = a_value.data;
+
+			TUnderlying inverseDeterminant = 1 / Determinant(a_value);
+
+			Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> result;
+			result.data[0] = (m[4] * m[8] - m[5] * m[7]) * inverseDeterminant;
+			result.data[1] = (m[2] * m[7] - m[1] * m[8]) * inverseDeterminant;
+			result.data[2] = (m[1] * m[5] - m[2] * m[4]) * inverseDeterminant;
+			result.data[3] = (m[5] * m[6] - m[3] * m[8]) * inverseDeterminant;
+			result.data[4] = (m[0] * m[8] - m[2] * m[6]) * inverseDeterminant;
+			result.data[5] = (m[2] * m[3] - m[0] * m[5]) * inverseDeterminant;
+			result.data[6] = (m[3] * m[7] - m[4] * m[6]) * inverseDeterminant;
+			result.data[7] = (m[1] * m[6] - m[0] * m[7]) * inverseDeterminant;
+			result.data[8] = (m[0] * m[4] - m[1] * m[3]) * inverseDeterminant;
+			return result;
+		}
+	}
 }
 
 #pragma warning( pop )
@@ -22,8 +22,9 @@ namespace Oyl
 		using value_type = TUnderlying;
 		using type = Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>;
 
-		constexpr static int size_x = MATRIX_SIZE;
-		constexpr static int size_y = MATRIX_SIZE;
+		constexpr static int          size_x = MATRIX_SIZE;
+		constexpr static int          size_y = MATRIX_SIZE;
+		constexpr static MatrixLayout layout = MatrixLayout::RowMajor;
 
 		constexpr
 		Matrix_t()
@@ -40,16 +41,21 @@ namespace Oyl
 			Vector_t<MATRIX_SIZE, TUnderlying> a_y,
 			Vector_t<MATRIX_SIZE, TUnderlying> a_z,
 			Vector_t<MATRIX_SIZE, TUnderlying> a_w
-		) : cols { a_x, a_y, a_z, a_w } {}
+		) : data {
+			a_x.data[0], a_x.data[1], a_x.data[2], a_x.data[3],
+			a_y.data[0], a_y.data[1], a_y.data[2], a_y.data[3],
+			a_z.data[0], a_z.data[1], a_z.data[2], a_z.data[3],
+			a_w.data[0], a_w.data[1], a_w.data[2], a_w.data[3]
+		} {}
 		
 		constexpr
 		Matrix_t(
 			Matrix_t<3, 3, TUnderlying> a_matrix
-		) : cols {
-			Vector_t<4, TUnderlying>(a_matrix.cols[0], 0),
-			Vector_t<4, TUnderlying>(a_matrix.cols[1], 0),
-			Vector_t<4, TUnderlying>(a_matrix.cols[2], 0),
-			Vector_t<4, TUnderlying>(Vector_t<3, TUnderlying>(0), 1),
+		) : data {
+			a_matrix.data[0], a_matrix.data[1], a_matrix.data[2], 0,
+			a_matrix.data[3], a_matrix.data[4], a_matrix.data[5], 0,
+			a_matrix.data[6], a_matrix.data[7], a_matrix.data[8], 0,
+			0,                0,                0,                1
 		} {}
 		
 		explicit
@@ -57,11 +63,7 @@ namespace Oyl
 		operator
 		Matrix_t<3, 3, TUnderlying>()
 		{
-			return Matrix_t<3, 3, TUnderlying> {
-				Vector_t<3, TUnderlying>(cols[0]),
-				Vector_t<3, TUnderlying>(cols[1]),
-				Vector_t<3, TUnderlying>(cols[2])
-			};
+			return Matrix_t<3, 3, TUnderlying>(*this);
 		}
 		
 		_MATRIX_GENERATE_CONSTRUCTORS();
@@ -87,6 +89,279 @@ namespace Oyl
 
 		_MATRIX_GENERATE_MEMBER_FUNCTIONS();
 	};
+
+	namespace Detail
+	{
+		// 2x2 matrices are packed into one register as (m00, m01, m10, m11)
+
+		/// \return a_lhs * a_rhs
+		OYL_FORCE_INLINE
+		Simd::Float4
+		Matrix2Multiply(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept
+		{
+			return Simd::Add(
+				Simd::Mul(a_lhs, Simd::Shuffle<0, 3, 0, 3>(a_rhs)),
+				Simd::Mul(Simd::Shuffle<1, 0, 3, 2>(a_lhs), Simd::Shuffle<2, 1, 2, 1>(a_rhs))
+			);
+		}
+
+		/// \return adjugate(a_lhs) * a_rhs
+		OYL_FORCE_INLINE
+		Simd::Float4
+		Matrix2AdjugateMultiply(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept
+		{
+			return Simd::Sub(
+				Simd::Mul(Simd::Shuffle<3, 3, 0, 0>(a_lhs), a_rhs),
+				Simd::Mul(Simd::Shuffle<1, 1, 2, 2>(a_lhs), Simd::Shuffle<2, 3, 0, 1>(a_rhs))
+			);
+		}
+
+		/// \return a_lhs * adjugate(a_rhs)
+		OYL_FORCE_INLINE
+		Simd::Float4
+		Matrix2MultiplyAdjugate(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept
+		{
+			return Simd::Sub(
+				Simd::Mul(a_lhs, Simd::Shuffle<3, 0, 3, 0>(a_rhs)),
+				Simd::Mul(Simd::Shuffle<1, 0, 3, 2>(a_lhs), Simd::Shuffle<2, 1, 2, 1>(a_rhs))
+			);
+		}
+
+		/**
+		 * \brief General 4x4 inverse by blockwise inversion of the 2x2 sub-matrices
+		 *        | A B |
+		 *        | C D |
+		 *        See https://lxjk.github.io/2017/09/03/Fast-4x4-Matrix-Inverse-with-SSE-SIMD-Explained.html
+		 */
+		OYL_FORCE_INLINE
+		void
+		InverseMatrix4(float const* a_value, float* a_out) noexcept
+		{
+			Simd::Float4 row0 = Simd::Load(a_value + 0);
+			Simd::Float4 row1 = Simd::Load(a_value + 4);
+			Simd::Float4 row2 = Simd::Load(a_value + 8);
+			Simd::Float4 row3 = Simd::Load(a_value + 12);
+
+			Simd::Float4 a = Simd::Shuffle2<0, 1, 0, 1>(row0, row1);
+			Simd::Float4 b = Simd::Shuffle2<2, 3, 2, 3>(row0, row1);
+			Simd::Float4 c = Simd::Shuffle2<0, 1, 0, 1>(row2, row3);
+			Simd::Float4 d = Simd::Shuffle2<2, 3, 2, 3>(row2, row3);
+
+			// (|A|, |B|, |C|, |D|)
+			Simd::Float4 subDeterminants = Simd::Sub(
+				Simd::Mul(Simd::Shuffle2<0, 2, 0, 2>(row0, row2), Simd::Shuffle2<1, 3, 1, 3>(row1, row3)),
+				Simd::Mul(Simd::Shuffle2<1, 3, 1, 3>(row0, row2), Simd::Shuffle2<0, 2, 0, 2>(row1, row3))
+			);
+			Simd::Float4 determinantA = Simd::Shuffle<0, 0, 0, 0>(subDeterminants);
+			Simd::Float4 determinantB = Simd::Shuffle<1, 1, 1, 1>(subDeterminants);
+			Simd::Float4 determinantC = Simd::Shuffle<2, 2, 2, 2>(subDeterminants);
+			Simd::Float4 determinantD = Simd::Shuffle<3, 3, 3, 3>(subDeterminants);
+
+			Simd::Float4 adjugateDTimesC = Matrix2AdjugateMultiply(d, c);
+			Simd::Float4 adjugateATimesB = Matrix2AdjugateMultiply(a, b);
+
+			// Adjugates of the blocks of the inverse
+			Simd::Float4 x = Simd::Sub(Simd::Mul(determinantD, a), Matrix2Multiply(b, adjugateDTimesC));
+			Simd::Float4 w = Simd::Sub(Simd::Mul(determinantA, d), Matrix2Multiply(c, adjugateATimesB));
+			Simd::Float4 y = Simd::Sub(Simd::Mul(determinantB, c), Matrix2MultiplyAdjugate(d, adjugateATimesB));
+			Simd::Float4 z = Simd::Sub(Simd::Mul(determinantC, b), Matrix2MultiplyAdjugate(a, adjugateDTimesC));
+
+			// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+			Simd::Float4 trace = Simd::HorizontalSum(
+				Simd::Mul(adjugateATimesB, Simd::Shuffle<0, 2, 1, 3>(adjugateDTimesC))
+			);
+			Simd::Float4 determinant = Simd::Sub(
+				Simd::Add(Simd::Mul(determinantA, determinantD), Simd::Mul(determinantB, determinantC)),
+				trace
+			);
+
+			Simd::Float4 inverseDeterminant = Simd::Div(Simd::Set(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+			x = Simd::Mul(x, inverseDeterminant);
+			y = Simd::Mul(y, inverseDeterminant);
+			z = Simd::Mul(z, inverseDeterminant);
+			w = Simd::Mul(w, inverseDeterminant);
+
+			// Undo the adjugate and reassemble the rows in one shuffle
+			Simd::Store(a_out + 0, Simd::Shuffle2<3, 1, 3, 1>(x, y));
+			Simd::Store(a_out + 4, Simd::Shuffle2<2, 0, 2, 0>(x, y));
+			Simd::Store(a_out + 8, Simd::Shuffle2<3, 1, 3, 1>(z, w));
+			Simd::Store(a_out + 12, Simd::Shuffle2<2, 0, 2, 0>(z, w));
+		}
+
+		/// a_out = a_rotation^T for the upper 3x3, row 3 = -translation * a_rotation^T
+		OYL_FORCE_INLINE
+		void
+		InverseRigidMatrix4(float const* a_value, float* a_out) noexcept
+		{
+			Simd::Float4 row0        = Simd::Load(a_value + 0);
+			Simd::Float4 row1        = Simd::Load(a_value + 4);
+			Simd::Float4 row2        = Simd::Load(a_value + 8);
+			Simd::Float4 translation = Simd::Load(a_value + 12);
+			Simd::Float4 unused      = Simd::Zero();
+
+			Simd::Transpose(row0, row1, row2, unused);
+
+			Simd::Float4 position = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(translation), row0);
+			position = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(translation), row1, position);
+			position = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(translation), row2, position);
+			position = Simd::Add(Simd::Negate(position), Simd::Set(0, 0, 0, 1));
+
+			Simd::Store(a_out + 0, row0);
+			Simd::Store(a_out + 4, row1);
+			Simd::Store(a_out + 8, row2);
+			Simd::Store(a_out + 12, position);
+		}
+
+		/// Like InverseRigidMatrix4, but inverts the upper 3x3 as a general linear transform
+		OYL_FORCE_INLINE
+		void
+		InverseAffineMatrix4(float const* a_value, float* a_out) noexcept
+		{
+			Simd::Float4 row0        = Simd::Load(a_value + 0);
+			Simd::Float4 row1        = Simd::Load(a_value + 4);
+			Simd::Float4 row2        = Simd::Load(a_value + 8);
+			Simd::Float4 translation = Simd::Load(a_value + 12);
+
+			// The columns of the inverse are the pairwise cross products of the rows, over the determinant
+			Simd::Float4 column0 = Simd::Cross3(row1, row2);
+			Simd::Float4 column1 = Simd::Cross3(row2, row0);
+			Simd::Float4 column2 = Simd::Cross3(row0, row1);
+			Simd::Float4 unused  = Simd::Zero();
+
+			Simd::Float4 inverseDeterminant = Simd::Div(Simd::Splat(1.0f), Simd::Dot3(row0, column0));
+
+			Simd::Transpose(column0, column1, column2, unused);
+			row0 = Simd::Mul(column0, inverseDeterminant);
+			row1 = Simd::Mul(column1, inverseDeterminant);
+			row2 = Simd::Mul(column2, inverseDeterminant);
+
+			Simd::Float4 position = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(translation), row0);
+			position = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(translation), row1, position);
+			position = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(translation), row2, position);
+			position = Simd::Add(Simd::Negate(position), Simd::Set(0, 0, 0, 1));
+
+			Simd::Store(a_out + 0, row0);
+			Simd::Store(a_out + 4, row1);
+			Simd::Store(a_out + 8, row2);
+			Simd::Store(a_out + 12, position);
+		}
+	}
+
+	namespace Matrix
+	{
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			auto const& m = a_value.data;
+
+			// 2x2 minors of the top two and bottom two rows
+			TUnderlying top01 = m[0] * m[5] - m[1] * m[4];
+			TUnderlying top02 = m[0] * m[6] - m[2] * m[4];
+			TUnderlying top03 = m[0] * m[7] - m[3] * m[4];
+			TUnderlying top12 = m[1] * m[6] - m[2] * m[5];
+			TUnderlying top13 = m[1] * m[7] - m[3] * m[5];
+			TUnderlying top23 = m[2] * m[7] - m[3] * m[6];
+
+			TUnderlying bottom01 = m[8] * m[13] - m[9] * m[12];
+			TUnderlying bottom02 = m[8] * m[14] - m[10] * m[12];
+			TUnderlying bottom03 = m[8] * m[15] - m[11] * m[12];
+			TUnderlying bottom12 = m[9] * m[14] - m[10] * m[13];
+			TUnderlying bottom13 = m[9] * m[15] - m[11] * m[13];
+			TUnderlying bottom23 = m[10] * m[15] - m[11] * m[14];
+
+			return top01 * bottom23 - top02 * bottom13 + top03 * bottom12
+			     + top12 * bottom03 - top13 * bottom02 + top23 * bottom01;
+		}
+
+		/**
+		 * \brief General 4x4 inverse, through blockwise cofactors for float and LU decomposition otherwise
+		 * \remark The result is unspecified if a_value is singular.
+		 *         Prefer InverseAffine or InverseRigid when the matrix is known to be one of those.
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>
+		Inverse(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> result;
+
+			if constexpr (std::is_same_v<TUnderlying, float>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Detail::InverseMatrix4(a_value.data, result.data);
+					return result;
+				}
+			}
+
+			return InverseLU(a_value);
+		}
+
+		/**
+		 * \brief Inverse of a transform whose last column is (0, 0, 0, 1), ie. any composition of
+		 *        Translate, Scale and Rotate
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>
+		InverseAffine(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> result;
+
+			if constexpr (std::is_same_v<TUnderlying, float>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Detail::InverseAffineMatrix4(a_value.data, result.data);
+					return result;
+				}
+			}
+
+			Matrix_t<3, 3, TUnderlying> linear = Inverse(Matrix_t<3, 3, TUnderlying>(a_value));
+			Vector_t<3, TUnderlying>    position = -(Vector_t<3, TUnderlying>(a_value.data[12], a_value.data[13], a_value.data[14]) * linear);
+
+			result = Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>(linear);
+			for (int i = 0; i < 3; i++)
+			{
+				result.data[12 + i] = position.data[i];
+			}
+			return result;
+		}
+
+		/**
+		 * \brief Inverse of a transform made of only rotation and translation, where the upper 3x3 is orthonormal.
+		 *        Useful for computing view matrices from camera transforms.
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>
+		InverseRigid(Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> const& a_value) noexcept
+		{
+			Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying> result;
+
+			if constexpr (std::is_same_v<TUnderlying, float>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Detail::InverseRigidMatrix4(a_value.data, result.data);
+					return result;
+				}
+			}
+
+			Matrix_t<3, 3, TUnderlying> rotation = Transpose(Matrix_t<3, 3, TUnderlying>(a_value));
+			Vector_t<3, TUnderlying>    position = -(Vector_t<3, TUnderlying>(a_value.data[12], a_value.data[13], a_value.data[14]) * rotation);
+
+			result = Matrix_t<MATRIX_SIZE, MATRIX_SIZE, TUnderlying>(rotation);
+			for (int i = 0; i < 3; i++)
+			{
+				result.data[12 + i] = position.data[i];
+			}
+			return result;
+		}
+	}
 }
 
 #pragma warning( pop )
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "type_Matrix.h"
+#include "type_Matrix2.h"
+#include "type_Matrix3.h"
+#include "type_Matrix4.h"
+
+#define COLUMN_MAJOR ::Oyl::MatrixLayout::ColumnMajor
+
+namespace Oyl
+{
+	/**
+	 * \brief Matrix_t that stores its elements one column after the other
+	 * \remarks The data of a column-major matrix is the data of its transpose in row-major order, so every
+	 *          operation here runs the row-major kernels on the storage as is, with the operands swapped
+	 *          where the transpose reverses them, ie. a * b is computed as transpose(b) * transpose(a).
+	 *          Matrices can be kept in this layout permanently and handed to column-major consumers directly.
+	 *      <br>Products and sums match the row-major results bit for bit. Inverse and Determinant evaluate
+	 *          the transpose, so they agree up to rounding.
+	 */
+	template<int SizeX, int SizeY, typename TUnderlying>
+	struct Matrix_t<SizeX, SizeY, TUnderlying, COLUMN_MAJOR>
+	{
+		using value_type = TUnderlying;
+		using type = Matrix_t;
+
+		constexpr static int          size_x = SizeX;
+		constexpr static int          size_y = SizeY;
+		constexpr static MatrixLayout layout = COLUMN_MAJOR;
+
+		TUnderlying data[SizeX * SizeY];
+
+		/// \return The element in row a_row and column a_column
+		constexpr
+		TUnderlying&
+		operator ()(int a_row, int a_column) noexcept
+		{
+			return data[a_column * SizeY + a_row];
+		}
+
+		constexpr
+		TUnderlying
+		operator ()(int a_row, int a_column) const noexcept
+		{
+			return data[a_column * SizeY + a_row];
+		}
+
+		constexpr
+		Matrix_t&
+		operator *=(Matrix_t const& a_other) noexcept
+		{
+			*this = *this * a_other;
+			return *this;
+		}
+
+		constexpr
+		static
+		type
+		Identity(TUnderlying a_diagonal = 1) noexcept
+		{
+			return ::Oyl::Matrix::Identity<type>(a_diagonal);
+		}
+	};
+
+	namespace Detail
+	{
+		/// \return a_lhs * a_rhs where a_lhs is treated as a row vector and a_rhs is a column-major 4x4 matrix
+		OYL_FORCE_INLINE
+		Simd::Float4
+		MultiplyVector4Matrix4ColumnMajor(Simd::Float4 a_lhs, float const* a_rhs) noexcept
+		{
+			// Back to rows so the sums run in the same order as MultiplyVector4Matrix4, which keeps the results identical
+			Simd::Float4 row0 = Simd::Load(a_rhs + 0);
+			Simd::Float4 row1 = Simd::Load(a_rhs + 4);
+			Simd::Float4 row2 = Simd::Load(a_rhs + 8);
+			Simd::Float4 row3 = Simd::Load(a_rhs + 12);
+			Simd::Transpose(row0, row1, row2, row3);
+
+			Simd::Float4 result = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(a_lhs), row0);
+			result = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(a_lhs), row1, result);
+			result = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(a_lhs), row2, result);
+			result = Simd::MulAdd(Simd::Shuffle<3, 3, 3, 3>(a_lhs), row3, result);
+			return result;
+		}
+
+		/// \return a_lhs * a_rhs where a_lhs is treated as a row vector and a_rhs is a column-major 3x3 matrix.
+		///         The w lane of the result is unspecified.
+		OYL_FORCE_INLINE
+		Simd::Float4
+		MultiplyVector3Matrix3ColumnMajor(Simd::Float4 a_lhs, float const* a_rhs) noexcept
+		{
+			// Same as above, the first two columns are read with a full load that reaches into the next column
+			Simd::Float4 row0 = Simd::Load(a_rhs + 0);
+			Simd::Float4 row1 = Simd::Load(a_rhs + 3);
+			Simd::Float4 row2 = Simd::Load3(a_rhs + 6);
+			Simd::Float4 row3 = Simd::Zero();
+			Simd::Transpose(row0, row1, row2, row3);
+
+			Simd::Float4 result = Simd::Mul(Simd::Shuffle<0, 0, 0, 0>(a_lhs), row0);
+			result = Simd::MulAdd(Simd::Shuffle<1, 1, 1, 1>(a_lhs), row1, result);
+			result = Simd::MulAdd(Simd::Shuffle<2, 2, 2, 2>(a_lhs), row2, result);
+			return result;
+		}
+
+		/// \return The row-major transpose of a_value, which shares its data
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr
+		Matrix_t<SizeY, SizeX, TUnderlying>
+		TransposedRowMajor(Matrix_t<SizeX, SizeY, TUnderlying, COLUMN_MAJOR> const& a_value) noexcept
+		{
+			Matrix_t<SizeY, SizeX, TUnderlying> result {};
+			for (int i = 0; i < SizeX * SizeY; i++)
+			{
+				result.data[i] = a_value.data[i];
+			}
+			return result;
+		}
+
+		/// \return The column-major transpose of a_value, which shares its data
+		template<int SizeX, int SizeY, typename TUnderlying>
+		constexpr
+		Matrix_t<SizeY, SizeX, TUnderlying, COLUMN_MAJOR>
+		TransposedColumnMajor(Matrix_t<SizeX, SizeY, TUnderlying> const& a_value) noexcept
+		{
+			Matrix_t<SizeY, SizeX, TUnderlying, COLUMN_MAJOR> result {};
+			for (int i = 0; i < SizeX * SizeY; i++)
+			{
+				result.data[i] = a_value.data[i];
+			}
+			return result;
+		}
+	}
+
+	namespace Matrix
+	{
+		/// \brief det(transpose(a)) == det(a), so the row-major determinant of the storage is the determinant
+		template<int Size, typename TUnderlying>
+		constexpr
+		TUnderlying
+		Determinant(Matrix_t<Size, Size, TUnderlying, COLUMN_MAJOR> const& a_value) noexcept
+		{
+			return Determinant(Detail::TransposedRowMajor(a_value));
+		}
+
+		/**
+		 * \brief inverse(transpose(a)) == transpose(inverse(a)), so this inverts the storage as a row-major matrix
+		 * \remark The result is unspecified if a_value is singular
+		 */
+		template<int Size, typename TUnderlying>
+		constexpr
+		Matrix_t<Size, Size, TUnderlying, COLUMN_MAJOR>
+		Inverse(Matrix_t<Size, Size, TUnderlying, COLUMN_MAJOR> const& a_value) noexcept
+		{
+			return Detail::TransposedColumnMajor(Inverse(Detail::TransposedRowMajor(a_value)));
+		}
+
+		/**
+		 * \brief Inverse of a transform whose last column is (0, 0, 0, 1), see the row-major InverseAffine
+		 * \remarks The shortcut depends on where the translation lies, so this converts to row-major and back.
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<4, 4, TUnderlying, COLUMN_MAJOR>
+		InverseAffine(Matrix_t<4, 4, TUnderlying, COLUMN_MAJOR> const& a_value) noexcept
+		{
+			return ConvertLayout<COLUMN_MAJOR>(InverseAffine(ConvertLayout<MatrixLayout::RowMajor>(a_value)));
+		}
+
+		/// \brief Inverse of a rotation and translation, see the row-major InverseRigid and InverseAffine above
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<4, 4, TUnderlying, COLUMN_MAJOR>
+		InverseRigid(Matrix_t<4, 4, TUnderlying, COLUMN_MAJOR> const& a_value) noexcept
+		{
+			return ConvertLayout<COLUMN_MAJOR>(InverseRigid(ConvertLayout<MatrixLayout::RowMajor>(a_value)));
+		}
+	}
+
+	// Matrix-Matrix Multiplication, as transpose(a_rhs) * transpose(a_lhs) on the row-major kernels
+	template<int SizeShared, int SizeLhsY, int SizeRhsX, typename TUnderlying>
+	constexpr
+	Matrix_t<SizeRhsX, SizeLhsY, TUnderlying, COLUMN_MAJOR>
+	operator *(
+		Matrix_t<SizeShared, SizeLhsY, TUnderlying, COLUMN_MAJOR> const& a_lhs,
+		Matrix_t<SizeRhsX, SizeShared, TUnderlying, COLUMN_MAJOR> const& a_rhs
+	) noexcept
+	{
+		Matrix_t<SizeRhsX, SizeLhsY, TUnderlying, COLUMN_MAJOR> result { 0 };
+
+		if constexpr (Detail::use_simd_matrix_v<SizeShared, SizeLhsY, TUnderlying> && SizeRhsX == 4)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+			#if OYL_SIMD == OYL_SIMD_AVX
+				Detail::MultiplyMatrix4Avx(a_rhs.data, a_lhs.data, result.data);
+			#else
+				Detail::MultiplyMatrix4(a_rhs.data, a_lhs.data, result.data);
+			#endif
+				return result;
+			}
+		} else if constexpr (Detail::use_simd_matrix3_v<SizeShared, SizeLhsY, TUnderlying> && SizeRhsX == 3)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Detail::MultiplyMatrix3(a_rhs.data, a_lhs.data, result.data);
+				return result;
+			}
+		}
+
+		Detail::MultiplyUnrolled<SizeShared, SizeLhsY>(
+			a_rhs.data,
+			a_lhs.data,
+			result.data,
+			std::make_integer_sequence<int, SizeRhsX * SizeLhsY>()
+		);
+
+		return result;
+	}
+
+	// Vector-Matrix Multiplication, treating the vector as a single row. Each element is a dot product with a column.
+	template<int SizeShared, int SizeRhsX, typename TUnderlying>
+	constexpr
+	Vector_t<SizeRhsX, TUnderlying>
+	operator *(Vector_t<SizeShared, TUnderlying> const& a_lhs, Matrix_t<SizeRhsX, SizeShared, TUnderlying, COLUMN_MAJOR> const& a_rhs) noexcept
+	{
+		Vector_t<SizeRhsX, TUnderlying> result {};
+
+		if constexpr (Detail::use_simd_matrix_v<SizeRhsX, SizeShared, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Simd::Store(result.data, Detail::MultiplyVector4Matrix4ColumnMajor(Simd::Load(a_lhs.data), a_rhs.data));
+				return result;
+			}
+		} else if constexpr (Detail::use_simd_matrix3_v<SizeRhsX, SizeShared, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				Simd::Store3(result.data, Detail::MultiplyVector3Matrix3ColumnMajor(Simd::Load3(a_lhs.data), a_rhs.data));
+				return result;
+			}
+		}
+
+		Detail::MultiplyUnrolled<SizeShared, 1>(
+			a_rhs.data,
+			a_lhs.data,
+			result.data,
+			std::make_integer_sequence<int, SizeRhsX>()
+		);
+
+		return result;
+	}
+}
+
+#undef COLUMN_MAJOR
@@ -0,0 +1,452 @@
+#pragma once
+
+#include "type_Matrix3.h"
+#include "type_Matrix4.h"
+#include "type_Vector3.h"
+#include "type_Vector4.h"
+
+#pragma warning( push )
+#pragma warning( disable : 26495 ) // Possibly uninitialized member
+
+namespace Oyl
+{
+	namespace Detail
+	{
+		/// Whether operations on Quaternion_t<TUnderlying> are routed through Simd::Float4
+		template<typename TUnderlying>
+		constexpr bool use_simd_quaternion_v = use_simd_vector_v<4, TUnderlying>;
+	}
+
+	/**
+	 * \brief A rotation in 3D space stored as a unit quaternion
+	 * \tparam TUnderlying The underlying data type
+	 * \remarks Uses _t type notation for the same reason as Vector_t, the free functions live in the
+	 *          Oyl::Quaternion namespace.
+	 *      <br>The vector part is stored in x, y, z and the scalar part in w, so a quaternion has the same
+	 *          layout as a Vector4 and can be loaded into a single SIMD register.
+	 *      <br>Products compose in the same order as matrices in this engine, a * b rotates by a then by b,
+	 *          so Quaternion::ToMatrix3(a * b) == Quaternion::ToMatrix3(a) * Quaternion::ToMatrix3(b).
+	 */
+	template<typename TUnderlying>
+	struct alignas(Detail::use_simd_quaternion_v<TUnderlying> ? 16 : alignof(TUnderlying))
+	Quaternion_t
+	{
+		using value_type = TUnderlying;
+		using type = Quaternion_t;
+
+		constexpr static int size = 4;
+
+		/// Constructs the identity rotation
+		constexpr
+		Quaternion_t()
+			: x(0),
+			  y(0),
+			  z(0),
+			  w(1) { }
+
+		constexpr
+		Quaternion_t(TUnderlying a_x, TUnderlying a_y, TUnderlying a_z, TUnderlying a_w)
+			: x(a_x),
+			  y(a_y),
+			  z(a_z),
+			  w(a_w) { }
+
+		constexpr
+		Quaternion_t(Vector_t<3, TUnderlying> a_vector, TUnderlying a_w)
+			: x(a_vector.data[0]),
+			  y(a_vector.data[1]),
+			  z(a_vector.data[2]),
+			  w(a_w) { }
+
+		constexpr
+		explicit
+		Quaternion_t(Vector_t<4, TUnderlying> a_vector)
+			: x(a_vector.data[0]),
+			  y(a_vector.data[1]),
+			  z(a_vector.data[2]),
+			  w(a_vector.data[3]) { }
+
+		explicit
+		constexpr
+		operator
+		Vector_t<4, TUnderlying>() const
+		{
+			return Vector_t<4, TUnderlying>(x, y, z, w);
+		}
+
+	#pragma warning( push )
+	#pragma warning( disable : 4615 ) // Unknown user type
+		union
+		{
+			struct
+			{
+				TUnderlying x;
+				TUnderlying y;
+				TUnderlying z;
+				TUnderlying w;
+			};
+
+			TUnderlying data[4];
+		};
+	#pragma warning( pop )
+
+		constexpr static Quaternion_t Identity() { return Quaternion_t(0, 0, 0, 1); }
+
+		constexpr
+		Quaternion_t&
+		operator *=(Quaternion_t const& a_other) noexcept
+		{
+			*this = *this * a_other;
+			return *this;
+		}
+
+		constexpr
+		TUnderlying&
+		operator [](int a_index)
+		{
+			if (a_index >= size)
+			{
+				throw "Index out of range!";
+			}
+			return data[a_index];
+		}
+	};
+
+	namespace Detail
+	{
+		OYL_FORCE_INLINE
+		Simd::Float4
+		LoadQuaternion(Quaternion_t<float> const& a_value)
+		{
+			return Simd::Load(a_value.data);
+		}
+
+		OYL_FORCE_INLINE
+		Quaternion_t<float>
+		StoreQuaternion(Simd::Float4 a_value)
+		{
+			Quaternion_t<float> result;
+			Simd::Store(result.data, a_value);
+			return result;
+		}
+
+		/**
+		 * \brief The Hamilton product a_lhs (x) a_rhs, which applies a_rhs first and a_lhs second
+		 * \remarks Each output lane is a signed sum of four products, the signs are applied by negating whole
+		 *          registers so the kernel stays branch-free with one shuffle per term.
+		 */
+		OYL_FORCE_INLINE
+		Simd::Float4
+		HamiltonProduct(Simd::Float4 a_lhs, Simd::Float4 a_rhs)
+		{
+			//   x = lw*rx + lx*rw + ly*rz - lz*ry
+			//   y = lw*ry - lx*rz + ly*rw + lz*rx
+			//   z = lw*rz + lx*ry - ly*rx + lz*rw
+			//   w = lw*rw - lx*rx - ly*ry - lz*rz
+			Simd::Float4 lhsW = Simd::Shuffle<3, 3, 3, 3>(a_lhs);
+			Simd::Float4 lhsX = Simd::Shuffle<0, 0, 0, 0>(a_lhs);
+			Simd::Float4 lhsY = Simd::Shuffle<1, 1, 1, 1>(a_lhs);
+			Simd::Float4 lhsZ = Simd::Shuffle<2, 2, 2, 2>(a_lhs);
+
+			Simd::Float4 signX = Simd::Set( 1, -1,  1, -1);
+			Simd::Float4 signY = Simd::Set( 1,  1, -1, -1);
+			Simd::Float4 signZ = Simd::Set(-1,  1,  1, -1);
+
+			Simd::Float4 result = Simd::Mul(lhsW, a_rhs);
+			result = Simd::MulAdd(Simd::Mul(lhsX, signX), Simd::Shuffle<3, 2, 1, 0>(a_rhs), result);
+			result = Simd::MulAdd(Simd::Mul(lhsY, signY), Simd::Shuffle<2, 3, 0, 1>(a_rhs), result);
+			result = Simd::MulAdd(Simd::Mul(lhsZ, signZ), Simd::Shuffle<1, 0, 3, 2>(a_rhs), result);
+			return result;
+		}
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	Quaternion_t<TUnderlying>
+	operator *(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		if constexpr (Detail::use_simd_quaternion_v<TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				// Matrix order, a_lhs is applied first
+				return Detail::StoreQuaternion(
+					Detail::HamiltonProduct(Detail::LoadQuaternion(a_rhs), Detail::LoadQuaternion(a_lhs))
+				);
+			}
+		}
+
+		Quaternion_t<TUnderlying> const& l = a_rhs;
+		Quaternion_t<TUnderlying> const& r = a_lhs;
+		return Quaternion_t<TUnderlying>(
+			l.w * r.x + l.x * r.w + l.y * r.z - l.z * r.y,
+			l.w * r.y - l.x * r.z + l.y * r.w + l.z * r.x,
+			l.w * r.z + l.x * r.y - l.y * r.x + l.z * r.w,
+			l.w * r.w - l.x * r.x - l.y * r.y - l.z * r.z
+		);
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	Quaternion_t<TUnderlying>
+	operator *(Quaternion_t<TUnderlying> const& a_lhs, TUnderlying a_rhs) noexcept
+	{
+		return Quaternion_t<TUnderlying>(a_lhs.x * a_rhs, a_lhs.y * a_rhs, a_lhs.z * a_rhs, a_lhs.w * a_rhs);
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	Quaternion_t<TUnderlying>
+	operator +(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return Quaternion_t<TUnderlying>(a_lhs.x + a_rhs.x, a_lhs.y + a_rhs.y, a_lhs.z + a_rhs.z, a_lhs.w + a_rhs.w);
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	Quaternion_t<TUnderlying>
+	operator -(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return Quaternion_t<TUnderlying>(a_lhs.x - a_rhs.x, a_lhs.y - a_rhs.y, a_lhs.z - a_rhs.z, a_lhs.w - a_rhs.w);
+	}
+
+	/// \remark q and -q represent the same rotation
+	template<typename TUnderlying>
+	constexpr
+	Quaternion_t<TUnderlying>
+	operator -(Quaternion_t<TUnderlying> const& a_value) noexcept
+	{
+		return Quaternion_t<TUnderlying>(-a_value.x, -a_value.y, -a_value.z, -a_value.w);
+	}
+
+	/// \remark Compares components, q and -q compare unequal even though they represent the same rotation
+	template<typename TUnderlying>
+	constexpr
+	bool
+	operator ==(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return a_lhs.x == a_rhs.x && a_lhs.y == a_rhs.y && a_lhs.z == a_rhs.z && a_lhs.w == a_rhs.w;
+	}
+
+	template<typename TUnderlying>
+	constexpr
+	bool
+	operator !=(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return !(a_lhs == a_rhs);
+	}
+
+	namespace Quaternion
+	{
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Dot(Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs)
+		{
+			return a_lhs.x * a_rhs.x + a_lhs.y * a_rhs.y + a_lhs.z * a_rhs.z + a_lhs.w * a_rhs.w;
+		}
+
+		template<typename TUnderlying>
+		constexpr
+		TUnderlying
+		Magnitude(Quaternion_t<TUnderlying> const& a_value)
+		{
+			return std::sqrt(Dot(a_value, a_value));
+		}
+
+		template<typename TUnderlying>
+		constexpr
+		Quaternion_t<TUnderlying>
+		Normalize(Quaternion_t<TUnderlying> const& a_value)
+		{
+			if constexpr (Detail::use_simd_quaternion_v<TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Simd::Float4 value            = Detail::LoadQuaternion(a_value);
+					Simd::Float4 magnitudeSquared = Simd::Dot4(value, value);
+					if (Simd::GetX(magnitudeSquared) == 0)
+					{
+						return Quaternion_t<TUnderlying>::Identity();
+					}
+					return Detail::StoreQuaternion(Simd::Div(value, Simd::Sqrt(magnitudeSquared)));
+				}
+			}
+
+			TUnderlying magnitude = Magnitude(a_value);
+			if (magnitude == 0)
+			{
+				return Quaternion_t<TUnderlying>::Identity();
+			}
+			return a_value * (1 / magnitude);
+		}
+
+		/// \return The inverse rotation, only valid for unit quaternions. See Quaternion::Inverse otherwise
+		template<typename TUnderlying>
+		constexpr
+		Quaternion_t<TUnderlying>
+		Conjugate(Quaternion_t<TUnderlying> const& a_value)
+		{
+			return Quaternion_t<TUnderlying>(-a_value.x, -a_value.y, -a_value.z, a_value.w);
+		}
+
+		template<typename TUnderlying>
+		constexpr
+		Quaternion_t<TUnderlying>
+		Inverse(Quaternion_t<TUnderlying> const& a_value)
+		{
+			return Conjugate(a_value) * (1 / Dot(a_value, a_value));
+		}
+
+		/**
+		 * \param a_angle The angle in degrees by which to rotate around the axis
+		 * \param a_axis The axis around which to rotate, does not need to be normalized
+		 * \return A quaternion representing the same rotation as Matrix::Rotate(a_angle, a_axis)
+		 */
+		template<typename TUnderlying>
+		Quaternion_t<TUnderlying>
+		AngleAxis(TUnderlying a_angle, Vector_t<3, TUnderlying> const& a_axis)
+		{
+			TUnderlying halfAngle = a_angle * static_cast<TUnderlying>(Math::DEG_TO_RAD) / 2;
+			return Quaternion_t<TUnderlying>(Vector::Normalize(a_axis) * std::sin(halfAngle), std::cos(halfAngle));
+		}
+
+		/// \return a_vector rotated by a_rotation, equivalent to a_vector * Quaternion::ToMatrix3(a_rotation)
+		template<typename TUnderlying>
+		constexpr
+		Vector_t<3, TUnderlying>
+		Rotate(Quaternion_t<TUnderlying> const& a_rotation, Vector_t<3, TUnderlying> const& a_vector)
+		{
+			// v' = v + 2w(u x v) + 2(u x (u x v)), with u the vector part
+			Vector_t<3, TUnderlying> u(a_rotation.x, a_rotation.y, a_rotation.z);
+			Vector_t<3, TUnderlying> t = Vector::Cross(u, a_vector) * static_cast<TUnderlying>(2);
+			return a_vector + t * a_rotation.w + Vector::Cross(u, t);
+		}
+
+		/**
+		 * \brief Normalized linear interpolation along the shortest arc
+		 * \remarks Cheaper than Slerp but does not move at constant angular velocity, the error is
+		 *          negligible when a_lhs and a_rhs are close together (ie. consecutive animation keys)
+		 */
+		template<typename TUnderlying>
+		constexpr
+		Quaternion_t<TUnderlying>
+		Nlerp(TUnderlying a_t, Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs)
+		{
+			TUnderlying rhsWeight = Dot(a_lhs, a_rhs) < 0 ? -a_t : a_t;
+			return Normalize(a_lhs * (1 - a_t) + a_rhs * rhsWeight);
+		}
+
+		/// \brief Spherical linear interpolation along the shortest arc at constant angular velocity
+		template<typename TUnderlying>
+		Quaternion_t<TUnderlying>
+		Slerp(TUnderlying a_t, Quaternion_t<TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs)
+		{
+			TUnderlying cosTheta = Dot(a_lhs, a_rhs);
+			TUnderlying sign     = 1;
+			if (cosTheta < 0)
+			{
+				cosTheta = -cosTheta;
+				sign     = -1;
+			}
+
+			// sin(theta) vanishes as the inputs approach each other, the arc is a straight line there anyway
+			if (cosTheta > static_cast<TUnderlying>(0.9995))
+			{
+				return Nlerp(a_t, a_lhs, a_rhs);
+			}
+
+			TUnderlying theta    = std::acos(cosTheta);
+			TUnderlying sinTheta = std::sin(theta);
+
+			TUnderlying lhsWeight = std::sin((1 - a_t) * theta) / sinTheta;
+			TUnderlying rhsWeight = std::sin(a_t * theta) / sinTheta * sign;
+			return a_lhs * lhsWeight + a_rhs * rhsWeight;
+		}
+
+		/// \return A 3x3 row-major rotation matrix, a_rotation is expected to be normalized
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<3, 3, TUnderlying>
+		ToMatrix3(Quaternion_t<TUnderlying> const& a_rotation)
+		{
+			TUnderlying const x = a_rotation.x, y = a_rotation.y, z = a_rotation.z, w = a_rotation.w;
+
+			TUnderlying const xx = x * x * 2, yy = y * y * 2, zz = z * z * 2;
+			TUnderlying const xy = x * y * 2, xz = x * z * 2, yz = y * z * 2;
+			TUnderlying const wx = w * x * 2, wy = w * y * 2, wz = w * z * 2;
+
+			// Transpose of the usual column vector form, since our vectors are rows
+			return Matrix_t<3, 3, TUnderlying> {
+				Vector_t<3, TUnderlying>(1 - yy - zz, xy + wz,     xz - wy),
+				Vector_t<3, TUnderlying>(xy - wz,     1 - xx - zz, yz + wx),
+				Vector_t<3, TUnderlying>(xz + wy,     yz - wx,     1 - xx - yy)
+			};
+		}
+
+		/// \return A 4x4 row-major rotation matrix with no translation, a_rotation is expected to be normalized
+		template<typename TUnderlying>
+		constexpr
+		Matrix_t<4, 4, TUnderlying>
+		ToMatrix4(Quaternion_t<TUnderlying> const& a_rotation)
+		{
+			return Matrix_t<4, 4, TUnderlying>(ToMatrix3(a_rotation));
+		}
+
+		/**
+		 * \brief Extract the rotation from a 3x3 row-major rotation matrix
+		 * \remarks Pivots on the largest diagonal term so the square root never approaches zero.
+		 *          a_matrix is expected to be orthonormal, remove any scale beforehand.
+		 */
+		template<typename TUnderlying>
+		Quaternion_t<TUnderlying>
+		FromMatrix(Matrix_t<3, 3, TUnderlying> const& a_matrix)
+		{
+			TUnderlying const m00 = a_matrix.data[0], m01 = a_matrix.data[1], m02 = a_matrix.data[2];
+			TUnderlying const m10 = a_matrix.data[3], m11 = a_matrix.data[4], m12 = a_matrix.data[5];
+			TUnderlying const m20 = a_matrix.data[6], m21 = a_matrix.data[7], m22 = a_matrix.data[8];
+
+			TUnderlying trace = m00 + m11 + m22;
+			if (trace > 0)
+			{
+				TUnderlying s = std::sqrt(trace + 1) * 2;
+				return Quaternion_t<TUnderlying>((m12 - m21) / s, (m20 - m02) / s, (m01 - m10) / s, s / 4);
+			}
+			if (m00 > m11 && m00 > m22)
+			{
+				TUnderlying s = std::sqrt(1 + m00 - m11 - m22) * 2;
+				return Quaternion_t<TUnderlying>(s / 4, (m01 + m10) / s, (m02 + m20) / s, (m12 - m21) / s);
+			}
+			if (m11 > m22)
+			{
+				TUnderlying s = std::sqrt(1 + m11 - m00 - m22) * 2;
+				return Quaternion_t<TUnderlying>((m01 + m10) / s, s / 4, (m12 + m21) / s, (m20 - m02) / s);
+			}
+			TUnderlying s = std::sqrt(1 + m22 - m00 - m11) * 2;
+			return Quaternion_t<TUnderlying>((m02 + m20) / s, (m12 + m21) / s, s / 4, (m01 - m10) / s);
+		}
+
+		/// \brief Extract the rotation from the upper 3x3 of a 4x4 row-major transformation matrix
+		template<typename TUnderlying>
+		Quaternion_t<TUnderlying>
+		FromMatrix(Matrix_t<4, 4, TUnderlying> const& a_matrix)
+		{
+			return FromMatrix(Matrix_t<3, 3, TUnderlying> {
+				Vector_t<3, TUnderlying>(a_matrix.cols[0]),
+				Vector_t<3, TUnderlying>(a_matrix.cols[1]),
+				Vector_t<3, TUnderlying>(a_matrix.cols[2])
+			});
+		}
+	}
+
+	/// \return a_lhs rotated by a_rhs, mirrors a_lhs * Matrix for row vectors
+	template<typename TUnderlying>
+	constexpr
+	Vector_t<3, TUnderlying>
+	operator *(Vector_t<3, TUnderlying> const& a_lhs, Quaternion_t<TUnderlying> const& a_rhs) noexcept
+	{
+		return Quaternion::Rotate(a_rhs, a_lhs);
+	}
+}
+
+#pragma warning( pop )
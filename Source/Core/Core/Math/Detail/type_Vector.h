@@ -4,6 +4,8 @@
 
 #include "Core/Common.h"
 #include "Core/Math/Constants.h"
+#include "Core/Math/Scalar.h"
+#include "Core/Math/Detail/simd_Float4.h"
 
 namespace Oyl
 {
@@ -39,6 +41,47 @@ namespace Oyl
 		TUnderlying data[Size];
 	};
 
+	namespace Detail
+	{
+		/**
+		 * \brief Whether operations on Vector_t<Size, TUnderlying> are routed through Simd::Float4.
+		 *        3-component vectors are padded to 4 lanes in registers only, their storage stays tightly packed.
+		 */
+		template<int Size, typename TUnderlying>
+		constexpr bool use_simd_vector_v =
+			OYL_SIMD != OYL_SIMD_SCALAR && std::is_same_v<TUnderlying, float> && (Size == 3 || Size == 4);
+
+		template<int Size>
+		OYL_FORCE_INLINE
+		Simd::Float4
+		LoadVector(Vector_t<Size, float> const& a_value)
+		{
+			if constexpr (Size == 4)
+			{
+				return Simd::Load(a_value.data);
+			} else
+			{
+				return Simd::Load3(a_value.data);
+			}
+		}
+
+		template<int Size>
+		OYL_FORCE_INLINE
+		Vector_t<Size, float>
+		StoreVector(Simd::Float4 a_value)
+		{
+			Vector_t<Size, float> result;
+			if constexpr (Size == 4)
+			{
+				Simd::Store(result.data, a_value);
+			} else
+			{
+				Simd::Store3(result.data, a_value);
+			}
+			return result;
+		}
+	}
+
 	namespace Vector
 	{
 		template<int Size, typename TUnderlying>
@@ -46,6 +89,14 @@ namespace Oyl
 		TUnderlying
 		Dot(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs)
 		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Simd::GetX(Simd::Dot4(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+				}
+			}
+
 			TUnderlying result = 0;
 			for (int i = 0; i < Size; i++)
 			{
@@ -59,6 +110,15 @@ namespace Oyl
 		float
 		MagnitudeSquared(Vector_t<Size, TUnderlying> const& a_value)
 		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					Simd::Float4 value = Detail::LoadVector(a_value);
+					return Simd::GetX(Simd::Dot4(value, value));
+				}
+			}
+
 			TUnderlying result = 0;
 			for (int i = 0; i < Size; i++)
 			{
@@ -73,7 +133,7 @@ namespace Oyl
 		Magnitude(Vector_t<Size, TUnderlying> const& a_value)
 		{
 			float result = MagnitudeSquared(a_value);
-			return std::sqrt(result);
+			return Math::Sqrt(result);
 		}
 
 		template<int Size, typename TUnderlying>
@@ -81,6 +141,21 @@ namespace Oyl
 		Vector_t<Size, TUnderlying>
 		Normalize(Vector_t<Size, TUnderlying> const& a_value)
 		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					// Padded w lane of 3-component vectors is zero, so Dot4 is the 3 component dot product
+					Simd::Float4 value            = Detail::LoadVector(a_value);
+					Simd::Float4 magnitudeSquared = Simd::Dot4(value, value);
+					if (Simd::GetX(magnitudeSquared) == 0)
+					{
+						return a_value;
+					}
+					return Detail::StoreVector<Size>(Simd::Div(value, Simd::Sqrt(magnitudeSquared)));
+				}
+			}
+
 			float magnitude = Magnitude(a_value);
 			if (magnitude == 0)
 			{
@@ -98,13 +173,87 @@ namespace Oyl
 			
 			return std::acos(cos_theta) * Math::RAD_TO_DEG;
 		}
+
+		/// \return The component-wise minimum of a_lhs and a_rhs
+		template<int Size, typename TUnderlying>
+		constexpr
+		Vector_t<Size, TUnderlying>
+		Min(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs)
+		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Detail::StoreVector<Size>(Simd::Min(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+				}
+			}
+
+			Vector_t<Size, TUnderlying> result;
+			for (int i = 0; i < Size; i++)
+			{
+				result.data[i] = a_rhs.data[i] < a_lhs.data[i] ? a_rhs.data[i] : a_lhs.data[i];
+			}
+			return result;
+		}
+
+		/// \return The component-wise maximum of a_lhs and a_rhs
+		template<int Size, typename TUnderlying>
+		constexpr
+		Vector_t<Size, TUnderlying>
+		Max(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs)
+		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Detail::StoreVector<Size>(Simd::Max(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+				}
+			}
+
+			Vector_t<Size, TUnderlying> result;
+			for (int i = 0; i < Size; i++)
+			{
+				result.data[i] = a_lhs.data[i] < a_rhs.data[i] ? a_rhs.data[i] : a_lhs.data[i];
+			}
+			return result;
+		}
+
+		/// \return The component-wise absolute value of a_value
+		template<int Size, typename TUnderlying>
+		constexpr
+		Vector_t<Size, TUnderlying>
+		Abs(Vector_t<Size, TUnderlying> const& a_value)
+		{
+			if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Detail::StoreVector<Size>(Simd::Abs(Detail::LoadVector(a_value)));
+				}
+			}
+
+			Vector_t<Size, TUnderlying> result;
+			for (int i = 0; i < Size; i++)
+			{
+				result.data[i] = a_value.data[i] < 0 ? -a_value.data[i] : a_value.data[i];
+			}
+			return result;
+		}
 	}
 
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator +(Vector_t<Size, TUnderlying> a_lhs, Vector_t<Size, TUnderlying> a_rhs)
+	operator +(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Add(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -116,8 +265,16 @@ namespace Oyl
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator -(Vector_t<Size, TUnderlying> a_lhs, Vector_t<Size, TUnderlying> a_rhs)
+	operator -(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Sub(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -129,8 +286,16 @@ namespace Oyl
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator *(Vector_t<Size, TUnderlying> a_lhs, Vector_t<Size, TUnderlying> a_rhs) noexcept
+	operator *(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Mul(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -142,8 +307,16 @@ namespace Oyl
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator /(Vector_t<Size, TUnderlying> a_lhs, Vector_t<Size, TUnderlying> a_rhs) noexcept
+	operator /(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Div(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -155,8 +328,16 @@ namespace Oyl
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator *(Vector_t<Size, TUnderlying> a_lhs, TUnderlying a_rhs) noexcept
+	operator *(Vector_t<Size, TUnderlying> const& a_lhs, TUnderlying a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Mul(Detail::LoadVector(a_lhs), Simd::Splat(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -168,8 +349,16 @@ namespace Oyl
 	template<int Size, typename TUnderlying>
 	constexpr
 	Vector_t<Size, TUnderlying>
-	operator /(Vector_t<Size, TUnderlying> a_lhs, TUnderlying a_rhs) noexcept
+	operator /(Vector_t<Size, TUnderlying> const& a_lhs, TUnderlying a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Div(Detail::LoadVector(a_lhs), Simd::Splat(a_rhs)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -183,6 +372,14 @@ namespace Oyl
 	Vector_t<Size, TUnderlying>
 	operator -(Vector_t<Size, TUnderlying> const& a_value) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Detail::StoreVector<Size>(Simd::Negate(Detail::LoadVector(a_value)));
+			}
+		}
+
 		Vector_t<Size, TUnderlying> result;
 		for (int i = 0; i < Size; i++)
 		{
@@ -196,6 +393,14 @@ namespace Oyl
 	bool
 	operator ==(Vector_t<Size, TUnderlying> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept
 	{
+		if constexpr (Detail::use_simd_vector_v<Size, TUnderlying>)
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return Simd::AllEqual(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs));
+			}
+		}
+
 		bool result = true;
 		for (int i = 0; i < Size; i++)
 		{
@@ -215,7 +420,7 @@ namespace Oyl
 	#define _VECTOR_DEFINE_BINARY_OPERATOR_MEMBER_SAME_TYPE(_operator_) \
 		constexpr\
 		Vector_t& \
-		operator _operator_##=(Vector_t a_other) noexcept \
+		operator _operator_##=(Vector_t const& a_other) noexcept \
 		{ \
 			*this = *this _operator_ a_other;\
 			return *this; \
@@ -237,6 +442,7 @@ namespace Oyl
 		constexpr \
 		explicit \
 		Vector_t(Vector_t<Size, TUnderlying> a_other) \
+			: data {} \
 		{ \
 			constexpr int min_index = VECTOR_SIZE < Size ? VECTOR_SIZE : Size; \
 			for (int i = 0; i < min_index; i++) \
@@ -244,6 +450,19 @@ namespace Oyl
 				data[i] = a_other.data[i]; \
 			} \
 		} \
+		\
+		/* Component-wise conversion between underlying types, ie. Vector3h to Vector3 */ \
+		template<typename TOther, std::enable_if_t<!std::is_same_v<TOther, TUnderlying>, bool> = true> \
+		constexpr \
+		explicit \
+		Vector_t(Vector_t<VECTOR_SIZE, TOther> const& a_other) \
+			: data {} \
+		{ \
+			for (int i = 0; i < VECTOR_SIZE; i++) \
+			{ \
+				data[i] = static_cast<TUnderlying>(a_other.data[i]); \
+			} \
+		} \
 		_OYL_REQUIRE_SEMICOLON
 	
 	#define _VECTOR_GENERATE_MEMBER_FUNCTIONS() \
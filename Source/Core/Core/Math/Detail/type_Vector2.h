@@ -19,19 +19,16 @@ namespace Oyl
 
 		constexpr
 		Vector_t()
-			: x(0),
-			  y(0) { }
+			: data { 0, 0 } { }
 		
 		constexpr
 		explicit
 		Vector_t(TUnderlying a_value)
-			: x(a_value),
-			  y(a_value) { }
+			: data { a_value, a_value } { }
 
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y)
-			: x(a_x),
-			  y(a_y) { }
+			: data { a_x, a_y } { }
 	
 		_VECTOR_GENERATE_CONSTRUCTORS();
 		
@@ -26,28 +26,20 @@ namespace Oyl
 
 		constexpr
 		Vector_t()
-			: x(0),
-			  y(0),
-			  z(0) { }
+			: data { 0, 0, 0 } { }
 		
 		constexpr
 		explicit
 		Vector_t(TUnderlying a_value)
-			: x(a_value),
-			  y(a_value),
-			  z(a_value) { }
+			: data { a_value, a_value, a_value } { }
 
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y)
-			: x(a_x),
-			  y(a_y),
-			  z(0) { }
+			: data { a_x, a_y, 0 } { }
 		
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y, TUnderlying a_z)
-			: x(a_x),
-			  y(a_y),
-			  z(a_z) { }
+			: data { a_x, a_y, a_z } { }
 		
 		_VECTOR_GENERATE_CONSTRUCTORS();
 
@@ -106,9 +98,17 @@ namespace Oyl
 		Vector_t<3, TUnderlying>
 		Cross(Vector_t<3, TUnderlying> a_lhs, Vector_t<3, TUnderlying> a_rhs)
 		{
-			TUnderlying x_component = a_lhs.y * a_rhs.z - a_lhs.z * a_rhs.y;
-			TUnderlying y_component = a_lhs.z * a_rhs.x - a_lhs.x * a_rhs.z;
-			TUnderlying z_component = a_lhs.x * a_rhs.y - a_lhs.y * a_rhs.x;
+			if constexpr (Detail::use_simd_vector_v<3, TUnderlying>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Detail::StoreVector<3>(Simd::Cross3(Detail::LoadVector(a_lhs), Detail::LoadVector(a_rhs)));
+				}
+			}
+
+			TUnderlying x_component = a_lhs.data[1] * a_rhs.data[2] - a_lhs.data[2] * a_rhs.data[1];
+			TUnderlying y_component = a_lhs.data[2] * a_rhs.data[0] - a_lhs.data[0] * a_rhs.data[2];
+			TUnderlying z_component = a_lhs.data[0] * a_rhs.data[1] - a_lhs.data[1] * a_rhs.data[0];
 
 			return Vector_t<3, TUnderlying>(x_component, y_component, z_component);
 		}
@@ -10,7 +10,8 @@
 namespace Oyl
 {
 	template<typename TUnderlying>
-	struct Vector_t<VECTOR_SIZE, TUnderlying>
+	struct alignas(Detail::use_simd_vector_v<VECTOR_SIZE, TUnderlying> ? 16 : alignof(TUnderlying))
+	Vector_t<VECTOR_SIZE, TUnderlying>
 	{
 		using value_type = TUnderlying;
 		using type = Vector_t;
@@ -20,38 +21,23 @@ namespace Oyl
 		constexpr
 		explicit
 		Vector_t(TUnderlying a_value = 0)
-			: x(a_value),
-			  y(a_value),
-			  z(a_value),
-			  w(a_value) { }
+			: data { a_value, a_value, a_value, a_value } { }
 
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y)
-			: x(a_x),
-			  y(a_y),
-			  z(0),
-			  w(0) { }
+			: data { a_x, a_y, 0, 0 } { }
 
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y, TUnderlying a_z)
-			: x(a_x),
-			  y(a_y),
-			  z(a_z),
-			  w(0) { }
+			: data { a_x, a_y, a_z, 0 } { }
 
 		constexpr
 		Vector_t(TUnderlying a_x, TUnderlying a_y, TUnderlying a_z, TUnderlying a_w)
-			: x(a_x),
-			  y(a_y),
-			  z(a_z),
-			  w(a_w) { }
+			: data { a_x, a_y, a_z, a_w } { }
 		
 		constexpr
 		Vector_t(Vector_t<3, TUnderlying> a_vector, TUnderlying a_w)
-			: x(a_vector.data[0]),
-			  y(a_vector.data[1]),
-			  z(a_vector.data[2]),
-			  w(a_w) { }
+			: data { a_vector.data[0], a_vector.data[1], a_vector.data[2], a_w } { }
 		
 		_VECTOR_GENERATE_CONSTRUCTORS();
 
@@ -0,0 +1,791 @@
+#include "pch.h"
+#include "DynamicTree.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		/// Balanced trees over any number of proxies stay under 64 high, a descent leaves one sibling per level behind
+		constexpr std::size_t stack_size = 128;
+
+		constexpr uint32 all_planes = (1u << Frustum::side_count) - 1;
+
+		float
+		HalfArea(AABB const& a_box)
+		{
+			Vector3 size = a_box.Size();
+			return size.x * size.y + size.y * size.z + size.z * size.x;
+		}
+
+		/// Bounds::Merge one component at a time, which the tree updates call often enough for it to matter
+		AABB
+		Union(AABB const& a_lhs, AABB const& a_rhs)
+		{
+			return AABB {
+				Vector3(std::min(a_lhs.min.x, a_rhs.min.x), std::min(a_lhs.min.y, a_rhs.min.y), std::min(a_lhs.min.z, a_rhs.min.z)),
+				Vector3(std::max(a_lhs.max.x, a_rhs.max.x), std::max(a_lhs.max.y, a_rhs.max.y), std::max(a_lhs.max.z, a_rhs.max.z))
+			};
+		}
+
+		bool
+		SameBox(AABB const& a_lhs, AABB const& a_rhs)
+		{
+			return a_lhs.min.x == a_rhs.min.x && a_lhs.min.y == a_rhs.min.y && a_lhs.min.z == a_rhs.min.z &&
+			       a_lhs.max.x == a_rhs.max.x && a_lhs.max.y == a_rhs.max.y && a_lhs.max.z == a_rhs.max.z;
+		}
+
+		float
+		DistanceSquared(AABB const& a_box, Vector3 const& a_point)
+		{
+			float x = std::max(std::max(a_box.min.x - a_point.x, a_point.x - a_box.max.x), 0.0f);
+			float y = std::max(std::max(a_box.min.y - a_point.y, a_point.y - a_box.max.y), 0.0f);
+			float z = std::max(std::max(a_box.min.z - a_point.z, a_point.z - a_box.max.z), 0.0f);
+			return x * x + y * y + z * z;
+		}
+
+		/**
+		 * \brief Depth first walk of the subtrees whose boxes pass a_test, calling a_emit with each leaf that passes
+		 * \remarks Inner nodes are tested with their fat boxes, leaves with their exact boxes.
+		 */
+		template<typename TNode, typename TTest, typename TEmit>
+		void
+		Query(TNode const* a_nodes, uint32 a_root, TTest a_test, TEmit a_emit)
+		{
+			if (a_root == DynamicTree::null_proxy)
+			{
+				return;
+			}
+
+			uint32      stack[stack_size];
+			std::size_t size = 0;
+			stack[size++]    = a_root;
+			while (size > 0)
+			{
+				TNode const& node = a_nodes[stack[--size]];
+				if (node.IsLeaf())
+				{
+					if (a_test(node.exact))
+					{
+						a_emit(node.userData);
+					}
+				}
+				else if (a_test(node.bounds))
+				{
+					OYL_ASSERT(size + 2 <= stack_size);
+					stack[size++] = node.children[0];
+					stack[size++] = node.children[1];
+				}
+			}
+		}
+	}
+
+#pragma region Updates
+	uint32
+	DynamicTree::Insert(AABB const& a_bounds, uint32 a_userData)
+	{
+		uint32 leaf = AllocateNode();
+		Node&  node = m_nodes[leaf];
+		node.bounds   = Fatten(a_bounds, Vector3(0, 0, 0));
+		node.exact    = a_bounds;
+		node.userData = a_userData;
+		node.height   = 0;
+
+		InsertLeaf(leaf);
+		m_proxyCount++;
+		return leaf;
+	}
+
+	void
+	DynamicTree::Remove(uint32 a_proxy)
+	{
+		OYL_ASSERT(a_proxy < m_nodes.size() && m_nodes[a_proxy].height == 0);
+
+		RemoveLeaf(a_proxy);
+		FreeNode(a_proxy);
+		m_proxyCount--;
+	}
+
+	bool
+	DynamicTree::Move(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement)
+	{
+		OYL_ASSERT(a_proxy < m_nodes.size() && m_nodes[a_proxy].height == 0);
+
+		m_nodes[a_proxy].exact = a_bounds;
+		if (!NeedsReinsert(a_proxy, a_bounds, a_displacement))
+		{
+			return false;
+		}
+
+		RemoveLeaf(a_proxy);
+		m_nodes[a_proxy].bounds = Fatten(a_bounds, a_displacement);
+		InsertLeaf(a_proxy);
+		return true;
+	}
+
+	std::size_t
+	DynamicTree::MoveBatch(uint32 const* a_proxies, AABB const* a_bounds, std::size_t a_count, Vector3 const* a_displacements)
+	{
+		m_reinserted.clear();
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			uint32 const  proxy        = a_proxies[i];
+			Vector3 const displacement = a_displacements ? a_displacements[i] : Vector3(0, 0, 0);
+			OYL_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].height == 0);
+
+			m_nodes[proxy].exact = a_bounds[i];
+			if (NeedsReinsert(proxy, a_bounds[i], displacement))
+			{
+				RemoveLeaf(proxy);
+				m_nodes[proxy].bounds = Fatten(a_bounds[i], displacement);
+				m_reinserted.push_back(proxy);
+			}
+		}
+
+		for (uint32 proxy : m_reinserted)
+		{
+			InsertLeaf(proxy);
+		}
+		return m_reinserted.size();
+	}
+
+	void
+	DynamicTree::Clear()
+	{
+		// Keeps the pool's memory for the next inserts
+		m_nodes.clear();
+		m_root       = null_node;
+		m_free       = null_node;
+		m_proxyCount = 0;
+	}
+
+	void
+	DynamicTree::Reserve(std::size_t a_proxyCount)
+	{
+		std::size_t const oldSize = m_nodes.size();
+		std::size_t const newSize = 2 * a_proxyCount;
+		if (newSize <= oldSize)
+		{
+			return;
+		}
+
+		// New nodes go to the front of the free list in order, so a fresh tree fills the pool front to back
+		m_nodes.resize(newSize);
+		for (std::size_t i = newSize; i-- > oldSize;)
+		{
+			m_nodes[i].parent = m_free;
+			m_nodes[i].height = -1;
+			m_free            = static_cast<uint32>(i);
+		}
+	}
+#pragma endregion
+#pragma region Queries
+	std::size_t
+	DynamicTree::Overlap(AABB const& a_query, uint32* a_hits) const
+	{
+		std::size_t count = 0;
+		Query(
+			m_nodes.data(),
+			m_root,
+			[&](AABB const& a_box) { return Bounds::Overlaps(a_box, a_query); },
+			[&](uint32 a_userData) { a_hits[count++] = a_userData; }
+		);
+		return count;
+	}
+
+	std::size_t
+	DynamicTree::Overlap(Sphere const& a_query, uint32* a_hits) const
+	{
+		float const radiusSquared = a_query.radius * a_query.radius;
+
+		std::size_t count = 0;
+		Query(
+			m_nodes.data(),
+			m_root,
+			[&](AABB const& a_box) { return DistanceSquared(a_box, a_query.center) <= radiusSquared; },
+			[&](uint32 a_userData) { a_hits[count++] = a_userData; }
+		);
+		return count;
+	}
+
+	std::size_t
+	DynamicTree::Cull(Frustum const& a_frustum, uint32* a_hits) const
+	{
+		if (m_root == null_node)
+		{
+			return 0;
+		}
+
+		// Each entry carries the planes its box still straddles, a box fully inside a plane passes it for the whole
+		// subtree, so nodes inside the frustum are not tested at all
+		struct Entry
+		{
+			uint32 node;
+			uint32 planes;
+		};
+
+		Entry       stack[stack_size];
+		std::size_t size  = 0;
+		std::size_t count = 0;
+		stack[size++]     = Entry { m_root, all_planes };
+		while (size > 0)
+		{
+			Entry const entry = stack[--size];
+			Node const& node  = m_nodes[entry.node];
+			AABB const& box   = node.IsLeaf() ? node.exact : node.bounds;
+
+			Vector3 const center  = box.Center();
+			Vector3 const extents = box.Extents();
+			uint32        planes  = entry.planes;
+			bool          outside = false;
+			for (uint32 side = 0; side < Frustum::side_count && !outside; side++)
+			{
+				if ((planes & (1u << side)) == 0)
+				{
+					continue;
+				}
+
+				Plane const& plane    = a_frustum.planes[side];
+				float const  distance = Bounds::SignedDistance(plane, center);
+				float const  radius   = std::abs(plane.normal.x) * extents.x +
+				                        std::abs(plane.normal.y) * extents.y +
+				                        std::abs(plane.normal.z) * extents.z;
+				if (distance + radius < 0)
+				{
+					outside = true;
+				}
+				else if (distance - radius >= 0)
+				{
+					planes &= ~(1u << side);
+				}
+			}
+
+			if (outside)
+			{
+				continue;
+			}
+
+			if (node.IsLeaf())
+			{
+				a_hits[count++] = node.userData;
+			}
+			else
+			{
+				OYL_ASSERT(size + 2 <= stack_size);
+				stack[size++] = Entry { node.children[0], planes };
+				stack[size++] = Entry { node.children[1], planes };
+			}
+		}
+		return count;
+	}
+
+	std::size_t
+	DynamicTree::Nearest(
+		Vector3 const& a_point,
+		std::size_t    a_count,
+		uint32*        a_hits,
+		float*         a_distances,
+		float          a_maxDistance
+	) const
+	{
+		if (m_root == null_node || a_count == 0)
+		{
+			return 0;
+		}
+
+		// The results so far are kept sorted nearest first by squared distance, the last one bounds the search.
+		// They go straight to a_distances when given.
+		float              localDistances[16];
+		std::vector<float> allocatedDistances;
+		float*             distances = a_distances;
+		if (!distances && a_count <= 16)
+		{
+			distances = localDistances;
+		}
+		else if (!distances)
+		{
+			allocatedDistances.resize(a_count);
+			distances = allocatedDistances.data();
+		}
+
+		std::size_t count = 0;
+		float const limit = a_maxDistance * a_maxDistance;
+		auto        bound = [&] { return count == a_count ? distances[count - 1] : limit; };
+
+		struct Entry
+		{
+			uint32 node;
+			float  distance;
+		};
+
+		Entry       stack[stack_size];
+		std::size_t size = 0;
+		stack[size++]    = Entry { m_root, DistanceSquared(m_nodes[m_root].bounds, a_point) };
+		while (size > 0)
+		{
+			Entry const entry = stack[--size];
+			if (entry.distance > bound())
+			{
+				continue;
+			}
+
+			Node const& node = m_nodes[entry.node];
+			if (node.IsLeaf())
+			{
+				float const distance = DistanceSquared(node.exact, a_point);
+				if (distance > bound() || (count == a_count && distance == bound()))
+				{
+					continue;
+				}
+
+				std::size_t slot = std::min(count, a_count - 1);
+				for (; slot > 0 && distances[slot - 1] > distance; slot--)
+				{
+					distances[slot] = distances[slot - 1];
+					a_hits[slot]    = a_hits[slot - 1];
+				}
+				distances[slot] = distance;
+				a_hits[slot]    = node.userData;
+				count           = std::min(count + 1, a_count);
+				continue;
+			}
+
+			// The nearer child goes on top so it is searched first and tightens the bound for the other
+			Entry near = Entry { node.children[0], DistanceSquared(m_nodes[node.children[0]].bounds, a_point) };
+			Entry far  = Entry { node.children[1], DistanceSquared(m_nodes[node.children[1]].bounds, a_point) };
+			if (far.distance < near.distance)
+			{
+				std::swap(near, far);
+			}
+
+			OYL_ASSERT(size + 2 <= stack_size);
+			if (far.distance <= bound())
+			{
+				stack[size++] = far;
+			}
+			if (near.distance <= bound())
+			{
+				stack[size++] = near;
+			}
+		}
+
+		if (a_distances)
+		{
+			for (std::size_t i = 0; i < count; i++)
+			{
+				a_distances[i] = std::sqrt(a_distances[i]);
+			}
+		}
+		return count;
+	}
+
+	void
+	DynamicTree::OverlapBatch(AABB const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const
+	{
+		a_hits.clear();
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			AABB const& query = a_queries[i];
+			a_offsets[i]      = static_cast<uint32>(a_hits.size());
+			Query(
+				m_nodes.data(),
+				m_root,
+				[&](AABB const& a_box) { return Bounds::Overlaps(a_box, query); },
+				[&](uint32 a_userData) { a_hits.push_back(a_userData); }
+			);
+		}
+		a_offsets[a_count] = static_cast<uint32>(a_hits.size());
+	}
+
+	void
+	DynamicTree::OverlapBatch(Sphere const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const
+	{
+		a_hits.clear();
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			Sphere const& query         = a_queries[i];
+			float const   radiusSquared = query.radius * query.radius;
+			a_offsets[i]                = static_cast<uint32>(a_hits.size());
+			Query(
+				m_nodes.data(),
+				m_root,
+				[&](AABB const& a_box) { return DistanceSquared(a_box, query.center) <= radiusSquared; },
+				[&](uint32 a_userData) { a_hits.push_back(a_userData); }
+			);
+		}
+		a_offsets[a_count] = static_cast<uint32>(a_hits.size());
+	}
+#pragma endregion
+#pragma region Accessors
+	AABB
+	DynamicTree::RootBounds() const
+	{
+		return m_root == null_node ? AABB::Empty() : m_nodes[m_root].bounds;
+	}
+
+	uint32
+	DynamicTree::Height() const
+	{
+		return m_root == null_node ? 0 : static_cast<uint32>(m_nodes[m_root].height);
+	}
+
+	float
+	DynamicTree::AreaRatio() const
+	{
+		if (m_root == null_node)
+		{
+			return 0;
+		}
+
+		float rootArea = HalfArea(m_nodes[m_root].bounds);
+		if (rootArea <= 0)
+		{
+			return 0;
+		}
+
+		float totalArea = 0;
+		for (Node const& node : m_nodes)
+		{
+			if (node.height > 0)
+			{
+				totalArea += HalfArea(node.bounds);
+			}
+		}
+		return totalArea / rootArea;
+	}
+#pragma endregion
+#pragma region Tree Maintenance
+	uint32
+	DynamicTree::AllocateNode()
+	{
+		if (m_free == null_node)
+		{
+			// Doubles the pool, Reserve counts two nodes per proxy
+			Reserve(std::max<std::size_t>(16, m_nodes.size()));
+		}
+
+		uint32 index = m_free;
+		Node&  node  = m_nodes[index];
+		m_free       = node.parent;
+
+		node.parent      = null_node;
+		node.children[0] = null_node;
+		node.children[1] = null_node;
+		node.height      = 0;
+		return index;
+	}
+
+	void
+	DynamicTree::FreeNode(uint32 a_node)
+	{
+		m_nodes[a_node].parent = m_free;
+		m_nodes[a_node].height = -1;
+		m_free                 = a_node;
+	}
+
+	AABB
+	DynamicTree::Fatten(AABB const& a_bounds, Vector3 const& a_displacement) const
+	{
+		Vector3 const margin = Vector3(m_settings.margin, m_settings.margin, m_settings.margin);
+		Vector3 const stretch = a_displacement * m_settings.displacementScale;
+
+		AABB result = AABB { a_bounds.min - margin, a_bounds.max + margin };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (stretch.data[axis] < 0)
+			{
+				result.min.data[axis] += stretch.data[axis];
+			}
+			else
+			{
+				result.max.data[axis] += stretch.data[axis];
+			}
+		}
+		return result;
+	}
+
+	bool
+	DynamicTree::NeedsReinsert(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement) const
+	{
+		AABB const& fat = m_nodes[a_proxy].bounds;
+		if (!Bounds::Contains(fat, a_bounds))
+		{
+			return true;
+		}
+
+		// A fat box much larger than a fresh one would be, after a fast proxy slows down, is worth shrinking
+		float const slack  = 4.0f * m_settings.margin;
+		AABB        loose  = Fatten(a_bounds, a_displacement);
+		loose.min         -= Vector3(slack, slack, slack);
+		loose.max         += Vector3(slack, slack, slack);
+		return !Bounds::Contains(loose, fat);
+	}
+
+	void
+	DynamicTree::InsertLeaf(uint32 a_leaf)
+	{
+		if (m_root == null_node)
+		{
+			m_root                 = a_leaf;
+			m_nodes[a_leaf].parent = null_node;
+			return;
+		}
+
+		// Walks down to the sibling whose new parent grows the tree's total surface area the least. Every node on the
+		// way grows to contain the leaf, so going further down only pays off while a child costs less than stopping.
+		AABB const leafBounds = m_nodes[a_leaf].bounds;
+		uint32     sibling    = m_root;
+		while (!m_nodes[sibling].IsLeaf())
+		{
+			Node const& node         = m_nodes[sibling];
+			float const area         = HalfArea(node.bounds);
+			float const combinedArea = HalfArea(Union(node.bounds, leafBounds));
+
+			float const cost        = 2.0f * combinedArea;
+			float const inheritance = 2.0f * (combinedArea - area);
+
+			float childCosts[2];
+			for (int i = 0; i < 2; i++)
+			{
+				Node const& child = m_nodes[node.children[i]];
+				float const grown = HalfArea(Union(child.bounds, leafBounds));
+				childCosts[i]     = (child.IsLeaf() ? grown : grown - HalfArea(child.bounds)) + inheritance;
+			}
+
+			if (cost < childCosts[0] && cost < childCosts[1])
+			{
+				break;
+			}
+			sibling = node.children[childCosts[0] <= childCosts[1] ? 0 : 1];
+		}
+
+		// May grow the pool, so no references into it are held across
+		uint32 const oldParent = m_nodes[sibling].parent;
+		uint32 const newParent = AllocateNode();
+
+		Node& parent       = m_nodes[newParent];
+		parent.parent      = oldParent;
+		parent.children[0] = sibling;
+		parent.children[1] = a_leaf;
+		parent.bounds      = Union(leafBounds, m_nodes[sibling].bounds);
+		parent.height      = m_nodes[sibling].height + 1;
+
+		m_nodes[sibling].parent = newParent;
+		m_nodes[a_leaf].parent  = newParent;
+
+		if (oldParent == null_node)
+		{
+			m_root = newParent;
+		}
+		else
+		{
+			Node& grandParent = m_nodes[oldParent];
+			grandParent.children[grandParent.children[0] == sibling ? 0 : 1] = newParent;
+		}
+
+		FixUpwards(newParent);
+	}
+
+	void
+	DynamicTree::RemoveLeaf(uint32 a_leaf)
+	{
+		if (a_leaf == m_root)
+		{
+			m_root = null_node;
+			return;
+		}
+
+		uint32 const parent      = m_nodes[a_leaf].parent;
+		uint32 const grandParent = m_nodes[parent].parent;
+		uint32 const sibling     = m_nodes[parent].children[m_nodes[parent].children[0] == a_leaf ? 1 : 0];
+
+		// The sibling takes the parent's place
+		m_nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		if (grandParent == null_node)
+		{
+			m_root = sibling;
+			return;
+		}
+
+		Node& node = m_nodes[grandParent];
+		node.children[node.children[0] == parent ? 0 : 1] = sibling;
+		FixUpwards(grandParent);
+	}
+
+	void
+	DynamicTree::FixUpwards(uint32 a_node)
+	{
+		uint32 index = a_node;
+		while (index != null_node)
+		{
+			uint32 const balanced  = Balance(index);
+			AABB const   oldBounds = m_nodes[balanced].bounds;
+			int32 const  oldHeight = m_nodes[balanced].height;
+
+			Refit(balanced);
+			bool const rotated = Rotate(balanced);
+
+			// Ancestors of a node that kept its box and height have nothing to update
+			Node const& node    = m_nodes[balanced];
+			bool const  changed = balanced != index || rotated || node.height != oldHeight || !SameBox(node.bounds, oldBounds);
+			if (!changed && index != a_node)
+			{
+				break;
+			}
+			index = node.parent;
+		}
+	}
+
+	void
+	DynamicTree::Refit(uint32 a_node)
+	{
+		Node&       node  = m_nodes[a_node];
+		Node const& left  = m_nodes[node.children[0]];
+		Node const& right = m_nodes[node.children[1]];
+		node.bounds       = Union(left.bounds, right.bounds);
+		node.height       = 1 + std::max(left.height, right.height);
+	}
+
+	bool
+	DynamicTree::Rotate(uint32 a_node)
+	{
+		Node const& node = m_nodes[a_node];
+		if (node.height < 2)
+		{
+			return false;
+		}
+
+		uint32 const children[2] = { node.children[0], node.children[1] };
+		float const  areas[2]    = { HalfArea(m_nodes[children[0]].bounds), HalfArea(m_nodes[children[1]].bounds) };
+
+		// Candidate swaps are named by the parent and slot of the two nodes they exchange
+		float  bestGain = 0;
+		uint32 lhsParent = null_node, rhsParent = null_node;
+		int    lhsSlot = 0, rhsSlot = 0;
+
+		// A child swapped with a grandchild under its sibling, which then holds the child and the other grandchild
+		for (int side = 0; side < 2; side++)
+		{
+			Node const& sibling = m_nodes[children[1 - side]];
+			if (sibling.IsLeaf())
+			{
+				continue;
+			}
+
+			AABB const& child = m_nodes[children[side]].bounds;
+			for (int slot = 0; slot < 2; slot++)
+			{
+				float gain = areas[1 - side] - HalfArea(Union(child, m_nodes[sibling.children[1 - slot]].bounds));
+				if (gain > bestGain)
+				{
+					bestGain  = gain;
+					lhsParent = a_node;
+					lhsSlot   = side;
+					rhsParent = children[1 - side];
+					rhsSlot   = slot;
+				}
+			}
+		}
+
+		// Two grandchildren swapped across the children
+		Node const& left  = m_nodes[children[0]];
+		Node const& right = m_nodes[children[1]];
+		if (!left.IsLeaf() && !right.IsLeaf())
+		{
+			for (int slot = 0; slot < 2; slot++)
+			{
+				AABB const& fromLeft  = m_nodes[left.children[0]].bounds;
+				AABB const& keptLeft  = m_nodes[left.children[1]].bounds;
+				AABB const& fromRight = m_nodes[right.children[slot]].bounds;
+				AABB const& keptRight = m_nodes[right.children[1 - slot]].bounds;
+
+				float gain = areas[0] + areas[1] - HalfArea(Union(fromRight, keptLeft)) - HalfArea(Union(fromLeft, keptRight));
+				if (gain > bestGain)
+				{
+					bestGain  = gain;
+					lhsParent = children[0];
+					lhsSlot   = 0;
+					rhsParent = children[1];
+					rhsSlot   = slot;
+				}
+			}
+		}
+
+		if (lhsParent == null_node)
+		{
+			return false;
+		}
+
+		uint32 const lhs = m_nodes[lhsParent].children[lhsSlot];
+		uint32 const rhs = m_nodes[rhsParent].children[rhsSlot];
+		m_nodes[lhsParent].children[lhsSlot] = rhs;
+		m_nodes[rhsParent].children[rhsSlot] = lhs;
+		m_nodes[rhs].parent                  = lhsParent;
+		m_nodes[lhs].parent                  = rhsParent;
+
+		for (uint32 child : children)
+		{
+			if (!m_nodes[child].IsLeaf())
+			{
+				Refit(child);
+			}
+		}
+		Refit(a_node);
+		return true;
+	}
+
+	uint32
+	DynamicTree::Balance(uint32 a_node)
+	{
+		Node& node = m_nodes[a_node];
+		if (node.IsLeaf() || node.height < 2)
+		{
+			return a_node;
+		}
+
+		int32 const balance = m_nodes[node.children[1]].height - m_nodes[node.children[0]].height;
+		if (balance >= -1 && balance <= 1)
+		{
+			return a_node;
+		}
+
+		// The taller child moves up into a_node's place and a_node becomes its first child
+		int const    tall    = balance > 1 ? 1 : 0;
+		uint32 const up      = node.children[tall];
+		Node&        upNode  = m_nodes[up];
+		uint32 const first   = upNode.children[0];
+		uint32 const second  = upNode.children[1];
+
+		upNode.children[0] = a_node;
+		upNode.parent      = node.parent;
+		node.parent        = up;
+		if (upNode.parent == null_node)
+		{
+			m_root = up;
+		}
+		else
+		{
+			Node& parent = m_nodes[upNode.parent];
+			parent.children[parent.children[0] == a_node ? 0 : 1] = up;
+		}
+
+		// The taller grandchild stays under the risen node, the shorter one takes its place under a_node
+		bool const   firstTaller = m_nodes[first].height > m_nodes[second].height;
+		uint32 const keep        = firstTaller ? first : second;
+		uint32 const move        = firstTaller ? second : first;
+
+		upNode.children[1]     = keep;
+		node.children[tall]    = move;
+		m_nodes[move].parent   = a_node;
+
+		Node const& left  = m_nodes[node.children[0]];
+		Node const& right = m_nodes[node.children[1]];
+		node.bounds       = Union(left.bounds, right.bounds);
+		node.height       = 1 + std::max(left.height, right.height);
+
+		upNode.bounds = Union(node.bounds, m_nodes[keep].bounds);
+		upNode.height = 1 + std::max(node.height, m_nodes[keep].height);
+		return up;
+	}
+#pragma endregion
+}
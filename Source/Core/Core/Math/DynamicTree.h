@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "Bounds.h"
+#include "Vector3.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/// How much DynamicTree fattens each proxy's box, so small movements do not touch the tree
+	struct DynamicTreeSettings
+	{
+		/// Added to every side of a proxy's box
+		float margin = 0.1f;
+
+		/// The box is also stretched along the displacement passed to Move, scaled by this, to predict the next frames
+		float displacementScale = 2.0f;
+	};
+
+	/**
+	 * \brief Dynamic AABB tree for moving objects, updated incrementally instead of rebuilt
+	 * \remarks Each proxy is a leaf holding its box fattened by DynamicTreeSettings, Move only touches the tree once
+	 *          the box leaves its fat box. Leaves are inserted next to the sibling that grows the total surface area
+	 *          the least. On the way back up, nodes swap children with grandchildren where that shrinks the tree's
+	 *          area, and are rotated by height where one side grows taller, so the height stays logarithmic.
+	 *      <br>Nodes come from a pool with a free list, a proxy's handle is its node index and stays valid until
+	 *          Remove. Queries test the fat boxes while descending and the exact boxes at the leaves, so they report
+	 *          exactly what overlaps. Queries are const and safe to run from many threads at once.
+	 */
+	class OYL_CORE_API DynamicTree
+	{
+	public:
+		constexpr static uint32 null_proxy = ~0u;
+
+		DynamicTree() = default;
+
+		explicit
+		DynamicTree(DynamicTreeSettings const& a_settings)
+			: m_settings(a_settings) {}
+
+#pragma region Updates
+		/// \brief Adds a proxy for a_bounds, queries report a_userData for it
+		/// \return The proxy's handle
+		uint32
+		Insert(AABB const& a_bounds, uint32 a_userData);
+
+		void
+		Remove(uint32 a_proxy);
+
+		/**
+		 * \brief Moves a proxy to a_bounds, reinserting it only if it left its fat box or the fat box is far too loose
+		 * \param a_displacement How far the proxy moved since the last update, stretches the new fat box
+		 * \return Whether the tree changed
+		 */
+		bool
+		Move(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement = Vector3(0, 0, 0));
+
+		/**
+		 * \brief Move for a_count proxies, cheaper than one call per proxy when many of them move each frame
+		 * \param a_displacements Optional, one per proxy
+		 * \return How many proxies were reinserted
+		 * \remarks Proxies that stayed in their fat box only have their exact box updated. The ones that left are
+		 *          all removed first and inserted after, so they do not rotate the tree back and forth between them.
+		 */
+		std::size_t
+		MoveBatch(uint32 const* a_proxies, AABB const* a_bounds, std::size_t a_count, Vector3 const* a_displacements = nullptr);
+
+		void
+		Clear();
+
+		/// \brief Grows the node pool for at least a_proxyCount proxies so inserts do not allocate
+		void
+		Reserve(std::size_t a_proxyCount);
+#pragma endregion
+#pragma region Queries
+		// Each writes the user data of every proxy that passes, in no particular order, and returns how many it wrote,
+		// so the output arrays must hold at least ProxyCount() elements.
+
+		/// \brief Writes every proxy whose box overlaps a_query
+		std::size_t
+		Overlap(AABB const& a_query, uint32* a_hits) const;
+
+		/// \brief Writes every proxy whose box overlaps a_query
+		std::size_t
+		Overlap(Sphere const& a_query, uint32* a_hits) const;
+
+		/// \brief Writes every proxy whose box Intersects(a_frustum, box), subtrees inside the frustum are not tested
+		std::size_t
+		Cull(Frustum const& a_frustum, uint32* a_hits) const;
+
+		/**
+		 * \brief Writes the up to a_count proxies whose boxes are closest to a_point, nearest first
+		 * \param a_distances Optional, receives the distance to each box, 0 for boxes containing a_point
+		 */
+		std::size_t
+		Nearest(
+			Vector3 const& a_point,
+			std::size_t    a_count,
+			uint32*        a_hits,
+			float*         a_distances = nullptr,
+			float          a_maxDistance = std::numeric_limits<float>::infinity()
+		) const;
+
+		/**
+		 * \brief Overlap for a_count boxes, appending the hits of each query to a_hits one after the other
+		 * \param a_offsets Receives a_count + 1 entries, the hits of query i are a_hits[a_offsets[i], a_offsets[i + 1])
+		 */
+		void
+		OverlapBatch(AABB const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const;
+
+		/// \brief See OverlapBatch
+		void
+		OverlapBatch(Sphere const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const;
+#pragma endregion
+#pragma region Accessors
+		/// \brief The proxy's box as passed to Insert or Move
+		AABB const& ExactBounds(uint32 a_proxy) const { return m_nodes[a_proxy].exact; }
+
+		/// \brief The proxy's fattened box as stored in the tree
+		AABB const& FatBounds(uint32 a_proxy) const { return m_nodes[a_proxy].bounds; }
+
+		uint32 UserData(uint32 a_proxy) const { return m_nodes[a_proxy].userData; }
+
+		/// \brief Fat box of everything in the tree, AABB::Empty() when it is empty
+		AABB
+		RootBounds() const;
+
+		std::size_t ProxyCount() const noexcept { return m_proxyCount; }
+
+		/// \brief Nodes in use, leaves and inner nodes
+		std::size_t NodeCount() const noexcept { return m_proxyCount > 0 ? 2 * m_proxyCount - 1 : 0; }
+
+		/// \brief Nodes allocated in the pool, in use or free
+		std::size_t Capacity() const noexcept { return m_nodes.size(); }
+
+		/// \brief Longest path from the root to a leaf, 0 for a single leaf
+		uint32
+		Height() const;
+
+		/// \brief Summed surface area of the inner nodes over the root's, lower is a tighter tree that queries faster
+		float
+		AreaRatio() const;
+
+		DynamicTreeSettings const& Settings() const noexcept { return m_settings; }
+#pragma endregion
+
+	private:
+		constexpr static uint32 null_node = ~0u;
+
+		struct Node
+		{
+			/// Fattened for leaves, the union of the children for inner nodes
+			AABB bounds;
+			/// Exact box of a leaf
+			AABB exact;
+
+			/// The next free node while the node is in the free list
+			uint32 parent = null_node;
+			/// Both null_node for leaves
+			uint32 children[2] = { null_node, null_node };
+			/// 0 for leaves, -1 for free nodes
+			int32  height = -1;
+			uint32 userData = 0;
+
+			bool IsLeaf() const { return children[0] == null_node; }
+		};
+
+		std::vector<Node> m_nodes;
+		uint32            m_root       = null_node;
+		uint32            m_free       = null_node;
+		std::size_t       m_proxyCount = 0;
+
+		DynamicTreeSettings m_settings;
+
+		// Scratch of MoveBatch, kept to avoid allocating every frame
+		std::vector<uint32> m_reinserted;
+
+		uint32
+		AllocateNode();
+
+		void
+		FreeNode(uint32 a_node);
+
+		AABB
+		Fatten(AABB const& a_bounds, Vector3 const& a_displacement) const;
+
+		/// \brief Whether a proxy at a_bounds moving by a_displacement needs a new fat box
+		bool
+		NeedsReinsert(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement) const;
+
+		void
+		InsertLeaf(uint32 a_leaf);
+
+		void
+		RemoveLeaf(uint32 a_leaf);
+
+		/// \brief Refits a_node and its ancestors from their children, rotating where that shrinks the tree or balances it
+		void
+		FixUpwards(uint32 a_node);
+
+		/// \brief Recomputes a_node's box and height from its children
+		void
+		Refit(uint32 a_node);
+
+		/// \brief Swaps a child and a grandchild, or two grandchildren, of a_node if that shrinks its children's area
+		/// \return Whether it swapped
+		bool
+		Rotate(uint32 a_node);
+
+		/// \brief Rotates a_node's taller child up if the children's heights differ by more than one
+		/// \return The node now at a_node's place in the tree
+		uint32
+		Balance(uint32 a_node);
+	};
+}
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "Fast.h"
+
+#include <random>
+
+namespace Oyl::Math::Fast
+{
+	namespace
+	{
+		/// \return The distance between a_approximation and a_exact, in units of the float spacing at a_exact
+		double
+		UlpError(float a_approximation, double a_exact)
+		{
+			if (std::isnan(a_exact))
+			{
+				return std::isnan(a_approximation) ? 0 : std::numeric_limits<double>::infinity();
+			}
+
+			float  exact = std::fabs(static_cast<float>(a_exact));
+			double ulp   = std::nextafter(exact, std::numeric_limits<float>::infinity()) - exact;
+			return std::fabs(a_approximation - a_exact) / ulp;
+		}
+
+		/**
+		 * \param a_input Callable producing the next (first, second) input pair from the generator
+		 * \param a_approximation Callable (first, second) -> float under test
+		 * \param a_exact Callable (first, second) -> double reference
+		 */
+		template<typename TInput, typename TApproximation, typename TExact>
+		AccuracyReport
+		Measure(
+			char const*    a_function,
+			Accuracy       a_accuracy,
+			std::size_t    a_samples,
+			TInput         a_input,
+			TApproximation a_approximation,
+			TExact         a_exact
+		)
+		{
+			// Fixed seed, reports are comparable between runs and machines
+			std::mt19937 generator;
+
+			AccuracyReport report { a_function, a_accuracy, 0, 0 };
+			for (std::size_t i = 0; i < a_samples; i++)
+			{
+				auto [first, second] = a_input(generator, i);
+
+				double error = UlpError(a_approximation(first, second), a_exact(first, second));
+				if (error > report.maxUlpError)
+				{
+					report.maxUlpError = error;
+					report.worstInput  = first;
+				}
+			}
+			return report;
+		}
+
+		template<Accuracy Tier>
+		void
+		MeasureTier(std::vector<AccuracyReport>& a_reports, std::size_t a_samples)
+		{
+			using Input = std::pair<float, float>;
+
+			// Half the angles near the origin where most calls land, half over the whole supported range
+			auto angle = [](std::mt19937& a_generator, std::size_t a_index)
+			{
+				float range = a_index % 2 == 0 ? 2 * 3.14159265f : 8192.0f;
+				return Input { std::uniform_real_distribution<float>(-range, range)(a_generator), 0.0f };
+			};
+			auto plane = [](std::mt19937& a_generator, std::size_t)
+			{
+				std::uniform_real_distribution<float> distribution(-100, 100);
+				float y = distribution(a_generator);
+				return Input { y, distribution(a_generator) };
+			};
+			auto unit = [](std::mt19937& a_generator, std::size_t)
+			{
+				return Input { std::uniform_real_distribution<float>(-1, 1)(a_generator), 0.0f };
+			};
+			auto positive = [](std::mt19937& a_generator, std::size_t)
+			{
+				float exponent = std::uniform_real_distribution<float>(-30, 30)(a_generator);
+				return Input { std::exp2(exponent), 0.0f };
+			};
+
+			a_reports.push_back(Measure(
+				"Sin", Tier, a_samples, angle,
+				[](float a_x, float) { float s, c; SinCos<Tier>(a_x, s, c); return s; },
+				[](float a_x, float) { return std::sin(static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"Cos", Tier, a_samples, angle,
+				[](float a_x, float) { float s, c; SinCos<Tier>(a_x, s, c); return c; },
+				[](float a_x, float) { return std::cos(static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"Atan2", Tier, a_samples, plane,
+				[](float a_y, float a_x) { return Atan2<Tier>(a_y, a_x); },
+				[](float a_y, float a_x) { return std::atan2(static_cast<double>(a_y), static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"Asin", Tier, a_samples, unit,
+				[](float a_x, float) { return Asin<Tier>(a_x); },
+				[](float a_x, float) { return std::asin(static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"Acos", Tier, a_samples, unit,
+				[](float a_x, float) { return Acos<Tier>(a_x); },
+				[](float a_x, float) { return std::acos(static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"Sqrt", Tier, a_samples, positive,
+				[](float a_x, float) { return Sqrt<Tier>(a_x); },
+				[](float a_x, float) { return std::sqrt(static_cast<double>(a_x)); }
+			));
+			a_reports.push_back(Measure(
+				"RSqrt", Tier, a_samples, positive,
+				[](float a_x, float) { return RSqrt<Tier>(a_x); },
+				[](float a_x, float) { return 1 / std::sqrt(static_cast<double>(a_x)); }
+			));
+		}
+	}
+
+	std::vector<AccuracyReport>
+	MeasureAccuracy(std::size_t a_samplesPerFunction)
+	{
+		std::vector<AccuracyReport> result;
+		MeasureTier<Accuracy::Fast>(result, a_samplesPerFunction);
+		MeasureTier<Accuracy::Medium>(result, a_samplesPerFunction);
+		MeasureTier<Accuracy::Full>(result, a_samplesPerFunction);
+		return result;
+	}
+}
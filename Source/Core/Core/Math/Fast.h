@@ -0,0 +1,449 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "Simd.h"
+
+#include "Core/Common.h"
+
+/**
+ * Polynomial approximations of the trigonometric functions, Sqrt and RSqrt.
+ *
+ * Every function comes in a scalar, Simd::Float4 and Simd::Float8 form. The scalar form runs the Float4 kernel
+ * on a single lane, so all three forms return bit-identical results for the same input.
+ * Angles are in radians, unlike the rest of Oyl::Math.
+ *
+ * Scalar.h, and through it the Transformations.h builders, route through these functions when OYL_MATH_FAST_TRIG is set
+ * (generate with --fast-trig=fast|medium|full).
+ * Math::Fast::MeasureAccuracy reports the measured error of every function and tier.
+ */
+namespace Oyl::Math::Fast
+{
+	/**
+	 * \brief Accuracy tiers, each step up evaluates higher degree polynomials
+	 * \remarks Fast   - relative error below 1.2e-3, for visuals that only need to look right
+	 *          Medium - relative error below 5e-6
+	 *          Full   - within 5 ULP of the exact result over the documented input ranges
+	 *      <br>The bounds are the worst MeasureAccuracy reports, Sin for Fast and Atan2 for Full at about 4.4 ULP.
+	 */
+	enum class Accuracy
+	{
+		Fast,
+		Medium,
+		Full,
+	};
+
+#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+	/// Accuracy used by the engine functions that opt in through OYL_MATH_FAST_TRIG
+	constexpr Accuracy engine_accuracy = static_cast<Accuracy>(OYL_MATH_FAST_TRIG - 1);
+#endif
+
+	namespace Detail
+	{
+		template<typename TFloat>
+		constexpr bool is_float4_v = std::is_same_v<TFloat, Simd::Float4>;
+
+		template<typename TFloat>
+		constexpr bool is_simd_float_v = is_float4_v<TFloat> || std::is_same_v<TFloat, Simd::Float8>;
+
+		template<typename TInt>
+		constexpr bool is_int4_v = std::is_same_v<TInt, Simd::Int4>;
+
+		template<typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		Broadcast(float a_value)
+		{
+			if constexpr (is_float4_v<TFloat>)
+			{
+				return Simd::Splat(a_value);
+			} else
+			{
+				return Simd::Splat8(a_value);
+			}
+		}
+
+		template<typename TInt>
+		OYL_FORCE_INLINE
+		TInt
+		BroadcastInt(std::int32_t a_value)
+		{
+			if constexpr (is_int4_v<TInt>)
+			{
+				return Simd::SplatInt(a_value);
+			} else
+			{
+				return Simd::SplatInt8(a_value);
+			}
+		}
+
+		/// \return a_coefficients[0] + a_coefficients[1] * a_x + a_coefficients[2] * a_x^2 + ...
+		template<typename TFloat, std::size_t Size>
+		OYL_FORCE_INLINE
+		TFloat
+		Polynomial(TFloat a_x, float const (&a_coefficients)[Size])
+		{
+			TFloat result = Broadcast<TFloat>(a_coefficients[Size - 1]);
+			for (std::size_t i = Size - 1; i-- > 0;)
+			{
+				result = Simd::MulAdd(result, a_x, Broadcast<TFloat>(a_coefficients[i]));
+			}
+			return result;
+		}
+
+		/**
+		 * Minimax coefficients, fitted for relative error over the reduced ranges:
+		 *     sin(r)  = r + r^3 * sine(r^2)         r in [-pi/4, pi/4]
+		 *     cos(r)  = 1 - r^2 / 2 + r^4 * cosine(r^2)
+		 *     atan(t) = t + t^3 * arc_tangent(t^2)  t in [0, tan(pi/8)]
+		 *     asin(x) = x + x^3 * arc_sine(x^2)     x in [0, 1/2]
+		 */
+		template<Accuracy Tier>
+		struct Coefficients;
+
+		template<>
+		struct Coefficients<Accuracy::Fast>
+		{
+			constexpr static float sine[]        = { -1.624279119e-01f };
+			constexpr static float cosine[]      = { 4.089930495e-02f };
+			constexpr static float arc_tangent[] = { -3.318337738e-01f, 1.703417647e-01f };
+			constexpr static float arc_sine[]    = { 1.650577567e-01f, 9.429869351e-02f };
+		};
+
+		template<>
+		struct Coefficients<Accuracy::Medium>
+		{
+			constexpr static float sine[]        = { -1.666339037e-01f, 8.163281832e-03f };
+			constexpr static float cosine[]      = { 4.166107130e-02f, -1.364871428e-03f };
+			constexpr static float arc_tangent[] = { -3.332550778e-01f, 1.971414354e-01f, -1.122516195e-01f };
+			constexpr static float arc_sine[]    = { 1.668012596e-01f, 7.189979407e-02f, 6.410731872e-02f };
+		};
+
+		template<>
+		struct Coefficients<Accuracy::Full>
+		{
+			constexpr static float sine[]        = { -1.666665461e-01f, 8.332160761e-03f, -1.951528307e-04f };
+			constexpr static float cosine[]      = { 4.166664568e-02f, -1.388731625e-03f, 2.443315694e-05f };
+			constexpr static float arc_tangent[] = { -3.333294914e-01f, 1.997771001e-01f, -1.387767853e-01f, 8.053721966e-02f };
+			constexpr static float arc_sine[]    = { 1.666675248e-01f, 7.495297638e-02f, 4.547037671e-02f, 2.417951065e-02f, 4.216631583e-02f };
+		};
+
+		constexpr float half_pi    = 1.57079637f;
+		constexpr float quarter_pi = 0.785398185f;
+		constexpr float two_by_pi  = 0.636619747f;
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		void
+		SinCos(TFloat a_radians, TFloat& a_sin, TFloat& a_cos)
+		{
+			using TInt = decltype(Simd::ConvertToInt(a_radians));
+
+			// Reduce to r in [-pi/4, pi/4] with a_radians = r + quadrant * pi/2.
+			// pi/2 is split in four parts (Cody-Waite), the first three have few enough bits that their
+			// products with the quadrant are exact, which keeps the reduction accurate up to |a_radians| ~ 8192
+			TFloat quadrant = Simd::Round(Simd::Mul(a_radians, Broadcast<TFloat>(two_by_pi)));
+
+			TFloat r = Simd::MulAdd(quadrant, Broadcast<TFloat>(-1.5703125f), a_radians);
+			r = Simd::MulAdd(quadrant, Broadcast<TFloat>(-4.837512969970703125e-4f), r);
+			r = Simd::MulAdd(quadrant, Broadcast<TFloat>(-7.549533620476723e-8f), r);
+			r = Simd::MulAdd(quadrant, Broadcast<TFloat>(-2.5633440682570896e-12f), r);
+
+			TFloat r2 = Simd::Mul(r, r);
+
+			TFloat sinR = Simd::MulAdd(Simd::Mul(r, r2), Polynomial(r2, Coefficients<Tier>::sine), r);
+			TFloat cosR = Simd::MulAdd(
+				Simd::Mul(r2, r2),
+				Polynomial(r2, Coefficients<Tier>::cosine),
+				Simd::MulAdd(r2, Broadcast<TFloat>(-0.5f), Broadcast<TFloat>(1))
+			);
+
+			// Odd quadrants swap sin and cos, quadrants 2 and 3 negate sin, quadrants 1 and 2 negate cos.
+			// Two's complement keeps the low bits correct for negative quadrants
+			TInt quadrantBits = Simd::ConvertToInt(quadrant);
+			TInt one          = BroadcastInt<TInt>(1);
+			TInt two          = BroadcastInt<TInt>(2);
+
+			TFloat swap    = Simd::BitCastToFloat(Simd::Equal(Simd::And(quadrantBits, one), one));
+			TFloat sinSign = Simd::BitCastToFloat(Simd::ShiftLeft<30>(Simd::And(quadrantBits, two)));
+			TFloat cosSign = Simd::BitCastToFloat(Simd::ShiftLeft<30>(Simd::And(Simd::Add(quadrantBits, one), two)));
+
+			a_sin = Simd::Xor(Simd::Select(swap, cosR, sinR), sinSign);
+			a_cos = Simd::Xor(Simd::Select(swap, sinR, cosR), cosSign);
+		}
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		RSqrt(TFloat a_value)
+		{
+			if constexpr (Tier == Accuracy::Full)
+			{
+				return Simd::Div(Broadcast<TFloat>(1), Simd::Sqrt(a_value));
+			} else if constexpr (Tier == Accuracy::Medium)
+			{
+				// One Newton-Raphson step, y' = y * (1.5 - 0.5 * x * y^2)
+				TFloat estimate = Simd::RSqrtEstimate(a_value);
+				TFloat halfX    = Simd::Mul(a_value, Broadcast<TFloat>(-0.5f));
+				return Simd::Mul(estimate, Simd::MulAdd(Simd::Mul(halfX, estimate), estimate, Broadcast<TFloat>(1.5f)));
+			} else
+			{
+				return Simd::RSqrtEstimate(a_value);
+			}
+		}
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		Sqrt(TFloat a_value)
+		{
+			if constexpr (Tier == Accuracy::Full)
+			{
+				return Simd::Sqrt(a_value);
+			} else
+			{
+				// x * 1/sqrt(x) is 0 * inf at zero
+				TFloat isZero = Simd::Equal(a_value, Broadcast<TFloat>(0));
+				return Simd::Select(isZero, a_value, Simd::Mul(a_value, RSqrt<Tier>(a_value)));
+			}
+		}
+
+		/// atan for a_value in [0, 1]
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		AtanUnit(TFloat a_value)
+		{
+			// atan(t) = pi/4 + atan((t - 1) / (t + 1)) brings (tan(pi/8), 1] down to [-tan(pi/8), 0]
+			TFloat one     = Broadcast<TFloat>(1);
+			TFloat reduce  = Simd::Greater(a_value, Broadcast<TFloat>(0.414213568f));
+			TFloat reduced = Simd::Div(Simd::Sub(a_value, one), Simd::Add(a_value, one));
+
+			TFloat t  = Simd::Select(reduce, reduced, a_value);
+			TFloat t2 = Simd::Mul(t, t);
+
+			TFloat result = Simd::MulAdd(Simd::Mul(t, t2), Polynomial(t2, Coefficients<Tier>::arc_tangent), t);
+			return Simd::Select(reduce, Simd::Add(result, Broadcast<TFloat>(quarter_pi)), result);
+		}
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		Atan2(TFloat a_y, TFloat a_x)
+		{
+			TFloat absY = Simd::Abs(a_y);
+			TFloat absX = Simd::Abs(a_x);
+
+			// Work with the octant angle in [0, pi/4], max is clamped so atan2(0, 0) comes out as 0
+			TFloat ratio = Simd::Div(
+				Simd::Min(absX, absY),
+				Simd::Max(Simd::Max(absX, absY), Broadcast<TFloat>(std::numeric_limits<float>::min()))
+			);
+			TFloat result = AtanUnit<Tier>(ratio);
+
+			result = Simd::Select(Simd::Greater(absY, absX), Simd::Sub(Broadcast<TFloat>(half_pi), result), result);
+			result = Simd::Select(
+				Simd::Less(a_x, Broadcast<TFloat>(0)),
+				Simd::Sub(Broadcast<TFloat>(3.14159274f), result),
+				result
+			);
+			return Simd::FlipSign(result, a_y);
+		}
+
+		/**
+		 * \return asin(|a_value|) with the reduction asin(x) = pi/2 - 2 * asin(sqrt((1 - x) / 2)) for x > 1/2.
+		 *         a_isReduced and a_reduced receive the mask and the partial result so Acos can reuse them
+		 */
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		AsinAbs(TFloat a_value, TFloat& a_isReduced, TFloat& a_reduced)
+		{
+			TFloat half = Broadcast<TFloat>(0.5f);
+			TFloat absX = Simd::Abs(a_value);
+			a_isReduced = Simd::Greater(absX, half);
+
+			TFloat reducedSquare = Simd::Mul(Simd::Sub(Broadcast<TFloat>(1), absX), half);
+
+			TFloat x2 = Simd::Select(a_isReduced, reducedSquare, Simd::Mul(absX, absX));
+			TFloat x  = Simd::Select(a_isReduced, Sqrt<Tier>(reducedSquare), absX);
+
+			a_reduced = Simd::MulAdd(Simd::Mul(x, x2), Polynomial(x2, Coefficients<Tier>::arc_sine), x);
+			return Simd::Select(
+				a_isReduced,
+				Simd::MulAdd(a_reduced, Broadcast<TFloat>(-2), Broadcast<TFloat>(half_pi)),
+				a_reduced
+			);
+		}
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		Asin(TFloat a_value)
+		{
+			TFloat isReduced, reduced;
+			return Simd::FlipSign(AsinAbs<Tier>(a_value, isReduced, reduced), a_value);
+		}
+
+		template<Accuracy Tier, typename TFloat>
+		OYL_FORCE_INLINE
+		TFloat
+		Acos(TFloat a_value)
+		{
+			TFloat isReduced, reduced;
+			TFloat asinAbs = AsinAbs<Tier>(a_value, isReduced, reduced);
+
+			// acos(x) = pi/2 - asin(x) loses the low bits as x approaches 1, use 2 * asin(sqrt((1 - x) / 2)) there
+			TFloat small = Simd::Sub(Broadcast<TFloat>(half_pi), Simd::FlipSign(asinAbs, a_value));
+			TFloat large = Simd::Add(reduced, reduced);
+			large = Simd::Select(
+				Simd::Less(a_value, Broadcast<TFloat>(0)),
+				Simd::Sub(Broadcast<TFloat>(3.14159274f), large),
+				large
+			);
+			return Simd::Select(isReduced, large, small);
+		}
+	}
+
+	/**
+	 * \brief Computes the sine and cosine of the same angle together, sharing the range reduction
+	 * \param a_radians Angle in radians, accuracy degrades gradually beyond |a_radians| > 8192
+	 */
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	void
+	SinCos(TFloat a_radians, TFloat& a_sin, TFloat& a_cos)
+	{
+		Detail::SinCos<Tier>(a_radians, a_sin, a_cos);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	void
+	SinCos(float a_radians, float& a_sin, float& a_cos)
+	{
+		Simd::Float4 sin, cos;
+		Detail::SinCos<Tier>(Simd::Splat(a_radians), sin, cos);
+		a_sin = Simd::GetX(sin);
+		a_cos = Simd::GetX(cos);
+	}
+
+	/// \return The angle in radians in [-pi, pi] of the vector (a_x, a_y), same argument order as std::atan2
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	TFloat
+	Atan2(TFloat a_y, TFloat a_x)
+	{
+		return Detail::Atan2<Tier>(a_y, a_x);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	float
+	Atan2(float a_y, float a_x)
+	{
+		return Simd::GetX(Detail::Atan2<Tier>(Simd::Splat(a_y), Simd::Splat(a_x)));
+	}
+
+	/// \return The arc-sine in radians of a_value in [-1, 1], NaN outside of it
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	TFloat
+	Asin(TFloat a_value)
+	{
+		return Detail::Asin<Tier>(a_value);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	float
+	Asin(float a_value)
+	{
+		return Simd::GetX(Detail::Asin<Tier>(Simd::Splat(a_value)));
+	}
+
+	/// \return The arc-cosine in radians of a_value in [-1, 1], NaN outside of it
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	TFloat
+	Acos(TFloat a_value)
+	{
+		return Detail::Acos<Tier>(a_value);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	float
+	Acos(float a_value)
+	{
+		return Simd::GetX(Detail::Acos<Tier>(Simd::Splat(a_value)));
+	}
+
+	/**
+	 * \brief Square root of a non-negative value
+	 * \remarks Full uses the hardware square root. Fast and Medium multiply by RSqrt, which is only
+	 *          faster where the hardware square root is slow or the result feeds straight into a multiply.
+	 */
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	TFloat
+	Sqrt(TFloat a_value)
+	{
+		return Detail::Sqrt<Tier>(a_value);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	float
+	Sqrt(float a_value)
+	{
+		return Simd::GetX(Detail::Sqrt<Tier>(Simd::Splat(a_value)));
+	}
+
+	/**
+	 * \brief 1 / sqrt(a_value) of a positive value
+	 * \remarks Fast is the hardware estimate (12 bits), Medium refines it with one Newton-Raphson step (22 bits),
+	 *          Full divides by the hardware square root.
+	 */
+	template<Accuracy Tier = Accuracy::Full, typename TFloat, std::enable_if_t<Detail::is_simd_float_v<TFloat>, bool> = true>
+	OYL_FORCE_INLINE
+	TFloat
+	RSqrt(TFloat a_value)
+	{
+		return Detail::RSqrt<Tier>(a_value);
+	}
+
+	template<Accuracy Tier = Accuracy::Full>
+	OYL_FORCE_INLINE
+	float
+	RSqrt(float a_value)
+	{
+		return Simd::GetX(Detail::RSqrt<Tier>(Simd::Splat(a_value)));
+	}
+
+	struct AccuracyReport
+	{
+		char const* function;
+		Accuracy    accuracy;
+
+		/// Largest error in units in the last place of the float result, against libm in double precision
+		double maxUlpError;
+
+		/// Input that produced maxUlpError, a_y for Atan2
+		float worstInput;
+	};
+
+	/**
+	 * \brief Samples every function at every accuracy tier and compares against libm
+	 * \param a_samplesPerFunction Inputs per function and tier, spread over the ranges documented above
+	 * \remarks Slow, meant for the benchmarks and for checking new coefficients, not for use at runtime.
+	 */
+	OYL_CORE_API
+	extern
+	std::vector<AccuracyReport>
+	MeasureAccuracy(std::size_t a_samplesPerFunction = 1 << 16);
+}
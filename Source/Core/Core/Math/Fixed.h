@@ -0,0 +1,472 @@
+#pragma once
+
+#include <type_traits>
+
+#include "Matrix3.h"
+#include "Matrix4.h"
+#include "Scalar.h"
+#include "Vector.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Signed fixed-point number, a 32 bit integer counting steps of 2^-FractionBits
+	 * \remarks Every operation is integer arithmetic with a defined result, so a simulation written against
+	 *          Fixed_t produces the same bits on every compiler, instruction set and optimization level,
+	 *          regardless of FMA contraction, fast math or libm. This is what lockstep networking and replays
+	 *          need, float code only gives that within a single build, see OYL_MATH_DETERMINISTIC.
+	 *      <br>Usable as the TUnderlying of Vector_t and Matrix_t. The generic scalar paths run for it since the
+	 *          SIMD paths are float only, and Math::Sqrt, Sin, Cos, Tan and Atan2 have integer-only overloads below.
+	 *      <br>+, - and * wrap around on overflow instead of being undefined. * and / round to nearest,
+	 *          / by zero is undefined like integer division.
+	 *          Converting from float or double rounds to nearest, which is exact for IEEE 754 on every platform.
+	 */
+	template<int FractionBits>
+	struct Fixed_t
+	{
+		static_assert(FractionBits > 0 && FractionBits < 31, "Fixed_t needs at least one integer and one fraction bit");
+
+		constexpr static int   fraction_bits = FractionBits;
+		constexpr static int32 one           = int32(1) << FractionBits;
+
+		constexpr
+		Fixed_t() noexcept
+			: raw(0) {}
+
+		/**
+		 * \brief Implicit so integer literals work in expressions and as the defaults of the Vector_t and Matrix_t constructors
+		 * \remarks Integers only, so Fixed x = 0.5f doesn't compile instead of silently converting through int.
+		 */
+		template<typename TInteger, std::enable_if_t<std::is_integral_v<TInteger>, bool> = true>
+		constexpr
+		Fixed_t(TInteger a_value) noexcept
+			: raw(Wrap(static_cast<uint64>(a_value) << FractionBits)) {}
+
+		constexpr
+		explicit
+		Fixed_t(float a_value) noexcept
+			: raw(FromFloating(a_value)) {}
+
+		constexpr
+		explicit
+		Fixed_t(double a_value) noexcept
+			: raw(FromFloating(a_value)) {}
+
+		constexpr
+		static
+		Fixed_t
+		FromRaw(int32 a_raw) noexcept
+		{
+			Fixed_t result;
+			result.raw = a_raw;
+			return result;
+		}
+
+		constexpr explicit operator float() const noexcept { return static_cast<float>(raw) / one; }
+
+		constexpr explicit operator double() const noexcept { return static_cast<double>(raw) / one; }
+
+		/// Rounds toward zero, like float to int
+		constexpr explicit operator int() const noexcept { return raw / one; }
+
+		friend constexpr Fixed_t operator +(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return FromRaw(Wrap(static_cast<uint32>(a_lhs.raw) + static_cast<uint32>(a_rhs.raw))); }
+
+		friend constexpr Fixed_t operator -(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return FromRaw(Wrap(static_cast<uint32>(a_lhs.raw) - static_cast<uint32>(a_rhs.raw))); }
+
+		friend constexpr Fixed_t operator -(Fixed_t a_value) noexcept { return FromRaw(Wrap(0u - static_cast<uint32>(a_value.raw))); }
+
+		friend
+		constexpr
+		Fixed_t
+		operator *(Fixed_t a_lhs, Fixed_t a_rhs) noexcept
+		{
+			int64 product = static_cast<int64>(a_lhs.raw) * a_rhs.raw;
+			return FromRaw(Wrap(static_cast<uint64>(RoundShift(product, FractionBits))));
+		}
+
+		friend
+		constexpr
+		Fixed_t
+		operator /(Fixed_t a_lhs, Fixed_t a_rhs) noexcept
+		{
+			// Twice the quotient with one more fraction bit, then halved with rounding. Integer division truncates
+			// toward zero, RoundShift needs the floor or negative quotients would round the wrong way.
+			int64 numerator = static_cast<int64>(a_lhs.raw) * (int64(2) << FractionBits);
+			int64 quotient  = numerator / a_rhs.raw;
+			if (numerator % a_rhs.raw != 0 && (numerator < 0) != (a_rhs.raw < 0))
+			{
+				quotient--;
+			}
+			return FromRaw(Wrap(static_cast<uint64>(RoundShift(quotient, 1))));
+		}
+
+		friend constexpr bool operator ==(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw == a_rhs.raw; }
+		friend constexpr bool operator !=(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw != a_rhs.raw; }
+		friend constexpr bool operator <(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw < a_rhs.raw; }
+		friend constexpr bool operator >(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw > a_rhs.raw; }
+		friend constexpr bool operator <=(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw <= a_rhs.raw; }
+		friend constexpr bool operator >=(Fixed_t a_lhs, Fixed_t a_rhs) noexcept { return a_lhs.raw >= a_rhs.raw; }
+
+		constexpr Fixed_t& operator +=(Fixed_t a_other) noexcept { return *this = *this + a_other; }
+		constexpr Fixed_t& operator -=(Fixed_t a_other) noexcept { return *this = *this - a_other; }
+		constexpr Fixed_t& operator *=(Fixed_t a_other) noexcept { return *this = *this * a_other; }
+		constexpr Fixed_t& operator /=(Fixed_t a_other) noexcept { return *this = *this / a_other; }
+
+		int32 raw;
+
+	private:
+		/// \return The low 32 bits of a_value as a signed integer, the two's complement wrap around
+		constexpr
+		static
+		int32
+		Wrap(uint64 a_value) noexcept
+		{
+			uint32 bits = static_cast<uint32>(a_value);
+			return bits < 0x80000000u ? static_cast<int32>(bits) : -static_cast<int32>(~bits) - 1;
+		}
+
+		/// \return a_value / 2^a_shift rounded to nearest, halves round up
+		constexpr
+		static
+		int64
+		RoundShift(int64 a_value, int a_shift) noexcept
+		{
+			// Floor division through the unsigned bit pattern, since shifting negative values is implementation-defined
+			uint64 biased = static_cast<uint64>(a_value) + (uint64(1) << (a_shift - 1)) + (uint64(1) << 63);
+			return static_cast<int64>((biased >> a_shift) - (uint64(1) << (63 - a_shift)));
+		}
+
+		template<typename TFloating>
+		constexpr
+		static
+		int32
+		FromFloating(TFloating a_value) noexcept
+		{
+			// Scaling by a power of two is exact, only the rounding to an integer loses precision
+			TFloating scaled = a_value * static_cast<TFloating>(one);
+			return static_cast<int32>(scaled < 0 ? scaled - TFloating(0.5) : scaled + TFloating(0.5));
+		}
+	};
+
+	/// Q16.16, the range is [-32768, 32768) with a resolution of 1.5e-5
+	typedef Fixed_t<16> Fixed;
+	static_assert(sizeof(Fixed) == sizeof(int32));
+
+	typedef Vector_t<2, Fixed> Vector2fx;
+	static_assert(sizeof(Vector2fx) == sizeof(Vector2fx::data));
+
+	typedef Vector_t<3, Fixed> Vector3fx;
+	static_assert(sizeof(Vector3fx) == sizeof(Vector3fx::data));
+
+	typedef Vector_t<4, Fixed> Vector4fx;
+	static_assert(sizeof(Vector4fx) == sizeof(Vector4fx::data));
+
+	typedef Matrix_t<3, 3, Fixed> Matrix3fx;
+	static_assert(sizeof(Matrix3fx) == sizeof(Matrix3fx::data));
+
+	typedef Matrix_t<4, 4, Fixed> Matrix4fx;
+	static_assert(sizeof(Matrix4fx) == sizeof(Matrix4fx::data));
+}
+
+namespace Oyl::Math
+{
+	namespace Detail
+	{
+		/// \return sqrt(a_value) rounded to the nearest integer, one result bit per iteration
+		constexpr
+		uint64
+		IntegerSqrt(uint64 a_value) noexcept
+		{
+			uint64 remainder = a_value;
+			uint64 result    = 0;
+			uint64 bit       = uint64(1) << 62;
+			while (bit > remainder)
+			{
+				bit >>= 2;
+			}
+
+			while (bit != 0)
+			{
+				if (remainder >= result + bit)
+				{
+					remainder -= result + bit;
+					result = (result >> 1) + bit;
+				} else
+				{
+					result >>= 1;
+				}
+				bit >>= 2;
+			}
+
+			// (result + 0.5)^2 = result^2 + result + 0.25
+			return remainder > result ? result + 1 : result;
+		}
+
+		/// \return a_lhs * a_rhs for Q2.30 values
+		constexpr
+		int64
+		MultiplyQ30(int64 a_lhs, int64 a_rhs) noexcept
+		{
+			return a_lhs * a_rhs / (int64(1) << 30);
+		}
+
+		/**
+		 * \brief Sine and cosine in Q2.30 of an angle in degrees with a_fractionBits fraction bits
+		 * \remarks The same steps as the constexpr double version above, in integers: exact reduction
+		 *          to [-45, 45] degrees, then Taylor series up to x^9 and x^10, which are below 2^-29 there.
+		 */
+		constexpr
+		void
+		FixedSinCos(int32 a_angle, int a_fractionBits, int64& a_sin, int64& a_cos) noexcept
+		{
+			constexpr int64 q30_one = int64(1) << 30;
+
+			// pi / 180 in Q46, so degrees in Q16 times this is radians in Q62
+			constexpr int64 pi_over_180_q46 = 1228166276394;
+
+			int64 fullTurn = int64(360) << a_fractionBits;
+			int64 angle    = a_angle % fullTurn;
+			if (angle < 0)
+			{
+				angle += fullTurn;
+			}
+
+			int64 quarterTurn = int64(90) << a_fractionBits;
+			int64 quadrant    = (angle + quarterTurn / 2) / quarterTurn;
+			int64 remainder   = angle - quadrant * quarterTurn;
+
+			// To Q16 first, so the product below can't overflow for any number of fraction bits
+			int64 degreesQ16 = a_fractionBits >= 16 ? remainder / (int64(1) << (a_fractionBits - 16)) : remainder * (int64(1) << (16 - a_fractionBits));
+			int64 radians    = degreesQ16 * pi_over_180_q46 / (int64(1) << 32);
+			int64 square     = MultiplyQ30(radians, radians);
+
+			int64 sin = q30_one;
+			sin = q30_one - MultiplyQ30(square, sin) / 72;
+			sin = q30_one - MultiplyQ30(square, sin) / 42;
+			sin = q30_one - MultiplyQ30(square, sin) / 20;
+			sin = q30_one - MultiplyQ30(square, sin) / 6;
+			sin = MultiplyQ30(radians, sin);
+
+			int64 cos = q30_one;
+			cos = q30_one - MultiplyQ30(square, cos) / 90;
+			cos = q30_one - MultiplyQ30(square, cos) / 56;
+			cos = q30_one - MultiplyQ30(square, cos) / 30;
+			cos = q30_one - MultiplyQ30(square, cos) / 12;
+			cos = q30_one - MultiplyQ30(square, cos) / 2;
+
+			switch (quadrant % 4)
+			{
+				case 0:  a_sin =  sin; a_cos =  cos; break;
+				case 1:  a_sin =  cos; a_cos = -sin; break;
+				case 2:  a_sin = -sin; a_cos = -cos; break;
+				default: a_sin = -cos; a_cos =  sin; break;
+			}
+		}
+
+		/// \return a_value in Q2.30 rounded to a_fractionBits fraction bits
+		constexpr
+		int32
+		FromQ30(int64 a_value, int a_fractionBits) noexcept
+		{
+			int64 step = int64(1) << (30 - a_fractionBits);
+			int64 half = step / 2;
+			return static_cast<int32>(a_value >= 0 ? (a_value + half) / step : -((-a_value + half) / step));
+		}
+
+		/**
+		 * \return atan2(a_y, a_x) in degrees with 32 fraction bits
+		 * \remarks CORDIC in vectoring mode, rotating (a_x, a_y) onto the x axis by the angles atan(2^-i)
+		 *          and adding them up. Integer shifts and adds only, so it gives the same bits everywhere.
+		 */
+		constexpr
+		int64
+		FixedAtan2(int64 a_y, int64 a_x) noexcept
+		{
+			// atan(2^-i) in degrees, Q32
+			constexpr int64 angles[32] = {
+				193273528320, 114096026022, 60285206653, 30601712202,
+				15360239180, 7687607525, 3844741810, 1922488225,
+				961258780, 480631223, 240315841, 120157949,
+				60078978, 30039490, 15019745, 7509872,
+				3754936, 1877468, 938734, 469367,
+				234684, 117342, 58671, 29335,
+				14668, 7334, 3667, 1833,
+				917, 458, 229, 115,
+			};
+
+			if (a_x == 0 && a_y == 0)
+			{
+				return 0;
+			}
+
+			int64 angle = 0;
+			if (a_x < 0)
+			{
+				// Rotate by half a turn into the right half plane, where CORDIC converges
+				angle = a_y >= 0 ? int64(180) << 32 : -(int64(180) << 32);
+				a_x   = -a_x;
+				a_y   = -a_y;
+			}
+
+			// Room for the CORDIC gain of 1.65 times the diagonal, inputs are at most 2^31
+			int64 x = a_x * (int64(1) << 29);
+			int64 y = a_y * (int64(1) << 29);
+			for (int i = 0; i < 32; i++)
+			{
+				int64 xStep = x / (int64(1) << i);
+				int64 yStep = y / (int64(1) << i);
+				if (y > 0)
+				{
+					x += yStep;
+					y -= xStep;
+					angle += angles[i];
+				} else
+				{
+					x -= yStep;
+					y += xStep;
+					angle -= angles[i];
+				}
+			}
+			return angle;
+		}
+	}
+
+	/**
+	 * \return The square root of a_value rounded to nearest, 0 if it is negative
+	 * \remarks Integer only, and exact to the last bit on every platform.
+	 */
+	template<int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Sqrt(Fixed_t<FractionBits> a_value) noexcept
+	{
+		if (a_value.raw <= 0)
+		{
+			return {};
+		}
+
+		// sqrt(raw / 2^F) * 2^F = sqrt(raw * 2^F)
+		uint64 scaled = static_cast<uint64>(a_value.raw) << FractionBits;
+		return Fixed_t<FractionBits>::FromRaw(static_cast<int32>(Detail::IntegerSqrt(scaled)));
+	}
+
+	/**
+	 * \brief Computes the sine and cosine of the angle a_angle in degrees together
+	 * \remarks Integer only, the error is within one step of the fixed-point resolution.
+	 *          Multiples of 90 degrees give exact zeroes and ones.
+	 */
+	template<int FractionBits>
+	constexpr
+	void
+	SinCos(Fixed_t<FractionBits> a_angle, Fixed_t<FractionBits>& a_sin, Fixed_t<FractionBits>& a_cos) noexcept
+	{
+		int64 sin = 0, cos = 0;
+		Detail::FixedSinCos(a_angle.raw, FractionBits, sin, cos);
+
+		a_sin = Fixed_t<FractionBits>::FromRaw(Detail::FromQ30(sin, FractionBits));
+		a_cos = Fixed_t<FractionBits>::FromRaw(Detail::FromQ30(cos, FractionBits));
+	}
+
+	/// \return The sine of the angle a_angle in degrees, see SinCos
+	template<int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Sin(Fixed_t<FractionBits> a_angle) noexcept
+	{
+		Fixed_t<FractionBits> sin, cos;
+		SinCos(a_angle, sin, cos);
+		return sin;
+	}
+
+	/// \return The cosine of the angle a_angle in degrees, see SinCos
+	template<int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Cos(Fixed_t<FractionBits> a_angle) noexcept
+	{
+		Fixed_t<FractionBits> sin, cos;
+		SinCos(a_angle, sin, cos);
+		return cos;
+	}
+
+	/**
+	 * \return The tangent of the angle a_angle in degrees
+	 * \remarks Odd multiples of 90 degrees are a division by zero.
+	 */
+	template<int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Tan(Fixed_t<FractionBits> a_angle) noexcept
+	{
+		int64 sin = 0, cos = 0;
+		Detail::FixedSinCos(a_angle.raw, FractionBits, sin, cos);
+
+		// Divide before rounding to keep the precision of the Q30 values
+		int64 quotient = sin * (int64(2) << FractionBits) / cos;
+		return Fixed_t<FractionBits>::FromRaw(static_cast<int32>(quotient >= 0 ? (quotient + 1) / 2 : -((-quotient + 1) / 2)));
+	}
+
+	/**
+	 * \return The angle in degrees about the origin of the vector with y component a_y and x component a_x,
+	 *         with the same convention as the floating point Atan2
+	 */
+	template<int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Atan2(Fixed_t<FractionBits> a_y, Fixed_t<FractionBits> a_x) noexcept
+	{
+		// Flipped like the floating point version
+		int64 angle = Detail::FixedAtan2(a_x.raw, a_y.raw);
+
+		int64 step = int64(1) << (32 - FractionBits);
+		int64 half = step / 2;
+		return Fixed_t<FractionBits>::FromRaw(static_cast<int32>(angle >= 0 ? (angle + half) / step : -((-angle + half) / step)));
+	}
+}
+
+namespace Oyl::Vector
+{
+	// The generic versions go through float, these stay in integers
+
+	/// \return The squared length of a_value, see Magnitude for a version with more range
+	template<int Size, int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	MagnitudeSquared(Vector_t<Size, Fixed_t<FractionBits>> const& a_value) noexcept
+	{
+		return Dot(a_value, a_value);
+	}
+
+	/// \return The length of a_value, accumulated at full precision so it's exact even where the squares overflow Fixed_t
+	template<int Size, int FractionBits>
+	constexpr
+	Fixed_t<FractionBits>
+	Magnitude(Vector_t<Size, Fixed_t<FractionBits>> const& a_value) noexcept
+	{
+		// sqrt(sum(raw^2)) = length * 2^F
+		uint64 sum = 0;
+		for (int i = 0; i < Size; i++)
+		{
+			int64 raw = a_value.data[i].raw;
+			sum += static_cast<uint64>(raw * raw);
+		}
+		return Fixed_t<FractionBits>::FromRaw(static_cast<int32>(Math::Detail::IntegerSqrt(sum)));
+	}
+
+	/// \return a_value scaled to unit length, zero length vectors are returned unchanged
+	template<int Size, int FractionBits>
+	constexpr
+	Vector_t<Size, Fixed_t<FractionBits>>
+	Normalize(Vector_t<Size, Fixed_t<FractionBits>> const& a_value) noexcept
+	{
+		Fixed_t<FractionBits> magnitude = Magnitude(a_value);
+		if (magnitude == 0)
+		{
+			return a_value;
+		}
+		return a_value / magnitude;
+	}
+}
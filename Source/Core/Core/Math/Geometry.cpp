@@ -0,0 +1,870 @@
+#include "pch.h"
+#include "Geometry.h"
+
+#include "Simd.h"
+
+namespace Oyl::Geometry
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+
+		constexpr uint32 no_index = ~0u;
+
+		/// Room for a triangle clipped by max_clip_planes planes
+		constexpr std::size_t max_clipped_points = 3 + max_clip_planes;
+
+		OYL_FORCE_INLINE
+		float
+		Distance(Plane const& a_plane, Vector3 const& a_point)
+		{
+			// Component wise rather than Vector::Dot, these run once per point per plane
+			return a_plane.normal.x * a_point.x + a_plane.normal.y * a_point.y + a_plane.normal.z * a_point.z + a_plane.distance;
+		}
+
+		OYL_FORCE_INLINE
+		Vector3
+		Intersection(Vector3 const& a_start, Vector3 const& a_end, float a_startDistance, float a_endDistance)
+		{
+			return a_start + (a_end - a_start) * (a_startDistance / (a_startDistance - a_endDistance));
+		}
+
+#pragma region Quickhull
+		struct HullFace
+		{
+			uint32 vertices[3];
+			/// The face across edge i, which runs from vertices[i] to vertices[(i + 1) % 3]
+			uint32 neighbors[3];
+
+			/// Outward normal and offset, see Height
+			double plane[4];
+
+			/// Head of the list of points outside this face and no other face assigned before it
+			uint32 outside;
+			uint32 farthest;
+			float  farthestDistance;
+
+			uint32 visited;
+			bool   alive;
+		};
+
+		class HullBuilder
+		{
+		public:
+			HullBuilder(Vector3 const* a_points, std::size_t a_count, float a_epsilon, double a_coplanar)
+				: m_points(a_points),
+				  m_count(a_count),
+				  m_epsilon(a_epsilon),
+				  m_coplanar(a_coplanar),
+				  m_next(a_count, no_index) {}
+
+			bool
+			Build()
+			{
+				if (!BuildSimplex())
+				{
+					return false;
+				}
+
+				while (!m_pending.empty())
+				{
+					uint32 face = m_pending.back();
+					m_pending.pop_back();
+					if (m_faces[face].alive && m_faces[face].outside != no_index)
+					{
+						AddPoint(face);
+					}
+				}
+				return true;
+			}
+
+			std::size_t
+			Write(uint32* a_triangles) const
+			{
+				std::size_t count = 0;
+				for (HullFace const& face : m_faces)
+				{
+					if (face.alive)
+					{
+						a_triangles[count * 3 + 0] = face.vertices[0];
+						a_triangles[count * 3 + 1] = face.vertices[1];
+						a_triangles[count * 3 + 2] = face.vertices[2];
+						count++;
+					}
+				}
+				return count;
+			}
+
+		private:
+			struct HorizonEdge
+			{
+				uint32 from;
+				uint32 to;
+				/// The face beyond the horizon that stays
+				uint32 neighbor;
+			};
+
+			struct VisitFrame
+			{
+				uint32 face;
+				int    edge;
+				int    remaining;
+			};
+
+			Vector3 const* m_points;
+			std::size_t    m_count;
+			float          m_epsilon;
+			/// Round-off of Height, an eye closer than this to a face is coplanar with it
+			double         m_coplanar;
+
+			std::vector<HullFace> m_faces;
+			std::vector<uint32>   m_freeFaces;
+			/// Links the outside lists, one entry per point
+			std::vector<uint32>   m_next;
+
+			std::vector<uint32>      m_pending;
+			std::vector<uint32>      m_visible;
+			std::vector<HorizonEdge> m_horizon;
+			std::vector<VisitFrame>  m_stack;
+			std::vector<uint32>      m_newFaces;
+
+			uint32 m_visitStamp = 0;
+
+			uint32
+			CreateFace(uint32 a_a, uint32 a_b, uint32 a_c)
+			{
+				uint32 index;
+				if (m_freeFaces.empty())
+				{
+					index = static_cast<uint32>(m_faces.size());
+					m_faces.emplace_back();
+				}
+				else
+				{
+					index = m_freeFaces.back();
+					m_freeFaces.pop_back();
+				}
+
+				Vector3 const& a = m_points[a_a];
+				Vector3 const& b = m_points[a_b];
+				Vector3 const& c = m_points[a_c];
+
+				HullFace& face = m_faces[index];
+				face.vertices[0] = a_a;
+				face.vertices[1] = a_b;
+				face.vertices[2] = a_c;
+				face.outside     = no_index;
+				face.farthest    = no_index;
+				face.visited     = 0;
+				face.alive       = true;
+
+				// In double, as the horizon test leaves no room for the rounding of a float plane. The offset goes
+				// through the centroid.
+				double const ab[3] = { double(b.x) - a.x, double(b.y) - a.y, double(b.z) - a.z };
+				double const ac[3] = { double(c.x) - a.x, double(c.y) - a.y, double(c.z) - a.z };
+				double normal[3] = {
+					ab[1] * ac[2] - ab[2] * ac[1],
+					ab[2] * ac[0] - ab[0] * ac[2],
+					ab[0] * ac[1] - ab[1] * ac[0],
+				};
+				double const length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+				double const scale  = length > 0 ? 1.0 / length : 0.0;
+
+				face.plane[3] = 0;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					face.plane[axis]  = normal[axis] * scale;
+					face.plane[3]    -= face.plane[axis] * ((double(a.data[axis]) + b.data[axis] + c.data[axis]) / 3.0);
+				}
+				return index;
+			}
+
+			/// \brief Height of a_point above a_face, negative below it
+			double
+			Height(HullFace const& a_face, Vector3 const& a_point) const
+			{
+				return a_face.plane[0] * a_point.x + a_face.plane[1] * a_point.y + a_face.plane[2] * a_point.z + a_face.plane[3];
+			}
+
+			/// \brief Adds a_point to the outside list of a_face, keeping track of the farthest point
+			void
+			Assign(uint32 a_face, uint32 a_point, float a_distance)
+			{
+				HullFace& face = m_faces[a_face];
+				if (face.outside == no_index)
+				{
+					m_pending.push_back(a_face);
+				}
+				m_next[a_point] = face.outside;
+				face.outside    = a_point;
+				if (face.farthest == no_index || a_distance > face.farthestDistance)
+				{
+					face.farthest         = a_point;
+					face.farthestDistance = a_distance;
+				}
+			}
+
+			int
+			EdgeTo(HullFace const& a_face, uint32 a_neighbor) const
+			{
+				for (int i = 0; i < 3; i++)
+				{
+					if (a_face.neighbors[i] == a_neighbor)
+					{
+						return i;
+					}
+				}
+				OYL_ASSERT(false);
+				return 0;
+			}
+
+			/// \brief Picks four extreme points spanning a tetrahedron and assigns every other point to one of its faces
+			bool
+			BuildSimplex()
+			{
+				uint32 extremes[6] = { 0, 0, 0, 0, 0, 0 };
+				for (std::size_t i = 1; i < m_count; i++)
+				{
+					for (int axis = 0; axis < 3; axis++)
+					{
+						float value = m_points[i].data[axis];
+						extremes[axis * 2 + 0] = value < m_points[extremes[axis * 2 + 0]].data[axis] ? static_cast<uint32>(i) : extremes[axis * 2 + 0];
+						extremes[axis * 2 + 1] = value > m_points[extremes[axis * 2 + 1]].data[axis] ? static_cast<uint32>(i) : extremes[axis * 2 + 1];
+					}
+				}
+
+				// The longest extent is the first edge
+				uint32 a = 0, b = 0;
+				float  longest = 0;
+				for (int axis = 0; axis < 3; axis++)
+				{
+					uint32 low = extremes[axis * 2 + 0], high = extremes[axis * 2 + 1];
+					float  length = Vector::MagnitudeSquared(m_points[high] - m_points[low]);
+					if (length > longest)
+					{
+						longest = length;
+						a       = low;
+						b       = high;
+					}
+				}
+				if (longest <= m_epsilon * m_epsilon)
+				{
+					return false;
+				}
+
+				Vector3 const line = Vector::Normalize(m_points[b] - m_points[a]);
+				uint32        c    = a;
+				float         away = 0;
+				for (std::size_t i = 0; i < m_count; i++)
+				{
+					float distance = Vector::MagnitudeSquared(Vector::Cross(m_points[i] - m_points[a], line));
+					if (distance > away)
+					{
+						away = distance;
+						c    = static_cast<uint32>(i);
+					}
+				}
+				if (away <= m_epsilon * m_epsilon)
+				{
+					return false;
+				}
+
+				Plane const base   = Bounds::PlaneFromPoints(m_points[a], m_points[b], m_points[c]);
+				uint32      d      = a;
+				float       height = 0;
+				for (std::size_t i = 0; i < m_count; i++)
+				{
+					float distance = Distance(base, m_points[i]);
+					if (std::abs(distance) > std::abs(height))
+					{
+						height = distance;
+						d      = static_cast<uint32>(i);
+					}
+				}
+				if (std::abs(height) <= m_epsilon)
+				{
+					return false;
+				}
+
+				// Wind every face so its normal points away from the fourth vertex
+				if (height > 0)
+				{
+					std::swap(b, c);
+				}
+				uint32 const faces[4] = {
+					CreateFace(a, b, c),
+					CreateFace(a, d, b),
+					CreateFace(a, c, d),
+					CreateFace(b, d, c),
+				};
+				for (uint32 face : faces)
+				{
+					for (int edge = 0; edge < 3; edge++)
+					{
+						uint32 from = m_faces[face].vertices[edge];
+						uint32 to   = m_faces[face].vertices[(edge + 1) % 3];
+						for (uint32 other : faces)
+						{
+							HullFace const& candidate = m_faces[other];
+							for (int j = 0; j < 3; j++)
+							{
+								if (candidate.vertices[j] == to && candidate.vertices[(j + 1) % 3] == from)
+								{
+									m_faces[face].neighbors[edge] = other;
+								}
+							}
+						}
+					}
+				}
+
+				AssignInitial(faces);
+				return true;
+			}
+
+			/// \brief Assigns every point to the first face of the tetrahedron it is outside of, eight points at a time
+			void
+			AssignInitial(uint32 const (&a_faces)[4])
+			{
+				Simd::Float8 planes[4][4];
+				for (int f = 0; f < 4; f++)
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						planes[f][c] = Simd::Splat8(static_cast<float>(m_faces[a_faces[f]].plane[c]));
+					}
+				}
+				Simd::Float8 const epsilon = Simd::Splat8(m_epsilon);
+
+				for (std::size_t i = 0; i < m_count; i += block_size)
+				{
+					std::size_t lanes = std::min(block_size, m_count - i);
+
+					alignas(32) float x[block_size] = { 0 }, y[block_size] = { 0 }, z[block_size] = { 0 };
+					for (std::size_t lane = 0; lane < lanes; lane++)
+					{
+						x[lane] = m_points[i + lane].x;
+						y[lane] = m_points[i + lane].y;
+						z[lane] = m_points[i + lane].z;
+					}
+					Simd::Float8 px = Simd::Load8(x), py = Simd::Load8(y), pz = Simd::Load8(z);
+
+					alignas(32) float distances[4][block_size];
+					int               outside = 0;
+					for (int f = 0; f < 4; f++)
+					{
+						Simd::Float8 distance = Simd::MulAdd(pz, planes[f][2], Simd::MulAdd(py, planes[f][1], Simd::MulAdd(px, planes[f][0], planes[f][3])));
+						Simd::Store(distances[f], distance);
+						outside |= Simd::MoveMask(Simd::Greater(distance, epsilon));
+					}
+
+					// Most points of a large cloud are inside the tetrahedron and skipped here
+					outside &= (1 << lanes) - 1;
+					while (outside != 0)
+					{
+						int lane = 0;
+						while (((outside >> lane) & 1) == 0)
+						{
+							lane++;
+						}
+						outside &= outside - 1;
+
+						for (int f = 0; f < 4; f++)
+						{
+							if (distances[f][lane] > m_epsilon)
+							{
+								Assign(a_faces[f], static_cast<uint32>(i + lane), distances[f][lane]);
+								break;
+							}
+						}
+					}
+				}
+			}
+
+			/// \brief Collects the faces a_eye can see from a_face on, and the loop of edges around them in order
+			void
+			FindHorizon(uint32 a_face, Vector3 const& a_eye)
+			{
+				m_visitStamp++;
+				m_visible.clear();
+				m_horizon.clear();
+				m_stack.clear();
+
+				m_faces[a_face].visited = m_visitStamp;
+				m_visible.push_back(a_face);
+				m_stack.push_back(VisitFrame { a_face, 0, 3 });
+
+				// Depth first, crossing each face's edges in order starting after the one it was entered by, which
+				// walks the horizon counter-clockwise
+				while (!m_stack.empty())
+				{
+					VisitFrame& frame = m_stack.back();
+					if (frame.remaining == 0)
+					{
+						m_stack.pop_back();
+						continue;
+					}
+
+					uint32 const face = frame.face;
+					int const    edge = frame.edge;
+					frame.edge = (edge + 1) % 3;
+					frame.remaining--;
+
+					uint32 const neighbor = m_faces[face].neighbors[edge];
+					HullFace&    other    = m_faces[neighbor];
+					if (other.visited == m_visitStamp)
+					{
+						continue;
+					}
+
+					// Only faces coplanar with the eye count as hidden, so every new face is convex with the horizon
+					// face it meets. Hiding faces within epsilon lets the hull fold in slightly, and thin faces at
+					// such a fold tilt far enough to leave other points well outside.
+					if (Height(other, a_eye) > m_coplanar)
+					{
+						other.visited = m_visitStamp;
+						m_visible.push_back(neighbor);
+						m_stack.push_back(VisitFrame { neighbor, (EdgeTo(other, face) + 1) % 3, 2 });
+					}
+					else
+					{
+						HullFace const& current = m_faces[face];
+						m_horizon.push_back(HorizonEdge { current.vertices[edge], current.vertices[(edge + 1) % 3], neighbor });
+					}
+				}
+			}
+
+			void
+			AddPoint(uint32 a_face)
+			{
+				uint32 const   eye      = m_faces[a_face].farthest;
+				Vector3 const& eyePoint = m_points[eye];
+
+				FindHorizon(a_face, eyePoint);
+
+				// Fan new faces out from the eye to every horizon edge, each linked to the faces beside it
+				m_newFaces.clear();
+				for (HorizonEdge const& edge : m_horizon)
+				{
+					uint32 face = CreateFace(edge.from, edge.to, eye);
+					m_newFaces.push_back(face);
+
+					HullFace& neighbor = m_faces[edge.neighbor];
+					for (int j = 0; j < 3; j++)
+					{
+						if (neighbor.vertices[j] == edge.to && neighbor.vertices[(j + 1) % 3] == edge.from)
+						{
+							neighbor.neighbors[j] = face;
+						}
+					}
+					m_faces[face].neighbors[0] = edge.neighbor;
+				}
+
+				std::size_t const count = m_newFaces.size();
+				for (std::size_t i = 0; i < count; i++)
+				{
+					HullFace& face = m_faces[m_newFaces[i]];
+					face.neighbors[1] = m_newFaces[(i + 1) % count];
+					face.neighbors[2] = m_newFaces[(i + count - 1) % count];
+				}
+
+				// Points outside the faces being replaced either move to a new face or are now inside
+				for (uint32 visible : m_visible)
+				{
+					HullFace& face = m_faces[visible];
+					face.alive = false;
+
+					uint32 point = face.outside;
+					while (point != no_index)
+					{
+						uint32 next = m_next[point];
+						if (point != eye)
+						{
+							uint32 best         = no_index;
+							float  bestDistance = m_epsilon;
+							for (uint32 candidate : m_newFaces)
+							{
+								float distance = static_cast<float>(Height(m_faces[candidate], m_points[point]));
+								if (distance > bestDistance)
+								{
+									best         = candidate;
+									bestDistance = distance;
+								}
+							}
+							if (best != no_index)
+							{
+								Assign(best, point, bestDistance);
+							}
+						}
+						point = next;
+					}
+				}
+
+				for (uint32 visible : m_visible)
+				{
+					m_freeFaces.push_back(visible);
+				}
+			}
+		};
+#pragma endregion
+#pragma region Clipping
+		/// \brief Clips a convex polygon against one plane, points within a_epsilon of it are kept as they are
+		std::size_t
+		ClipAgainstPlane(Vector3 const* a_points, std::size_t a_count, Plane const& a_plane, float a_epsilon, Vector3* a_out)
+		{
+			std::size_t count = 0;
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				Vector3 const& current = a_points[i];
+				Vector3 const& next    = a_points[i + 1 == a_count ? 0 : i + 1];
+
+				float d0 = Distance(a_plane, current);
+				float d1 = Distance(a_plane, next);
+
+				if (d0 >= -a_epsilon)
+				{
+					a_out[count++] = current;
+				}
+				// Only edges with an end strictly on either side cross the plane, which avoids duplicate points
+				if ((d0 > a_epsilon && d1 < -a_epsilon) || (d0 < -a_epsilon && d1 > a_epsilon))
+				{
+					a_out[count++] = Intersection(current, next, d0, d1);
+				}
+			}
+			return count;
+		}
+
+		/// \brief Writes the triangles of a fan over a convex polygon, nothing for fewer than three points
+		std::size_t
+		Triangulate(Vector3 const* a_points, std::size_t a_count, Vector3* a_out)
+		{
+			if (a_count < 3)
+			{
+				return 0;
+			}
+			for (std::size_t i = 1; i + 1 < a_count; i++)
+			{
+				a_out[(i - 1) * 3 + 0] = a_points[0];
+				a_out[(i - 1) * 3 + 1] = a_points[i];
+				a_out[(i - 1) * 3 + 2] = a_points[i + 1];
+			}
+			return a_count - 2;
+		}
+
+		/// Eight triangles in SoA form, with the signed distances of their vertices to one plane
+		struct TriangleBlock
+		{
+			Simd::Float8 x[3], y[3], z[3];
+		};
+
+		TriangleBlock
+		LoadTriangles(Vector3 const* a_triangles, std::size_t a_lanes)
+		{
+			alignas(32) float components[3][3][block_size] = {};
+			for (std::size_t lane = 0; lane < a_lanes; lane++)
+			{
+				for (int vertex = 0; vertex < 3; vertex++)
+				{
+					Vector3 const& point = a_triangles[lane * 3 + vertex];
+					components[vertex][0][lane] = point.x;
+					components[vertex][1][lane] = point.y;
+					components[vertex][2][lane] = point.z;
+				}
+			}
+
+			TriangleBlock result;
+			for (int vertex = 0; vertex < 3; vertex++)
+			{
+				result.x[vertex] = Simd::Load8(components[vertex][0]);
+				result.y[vertex] = Simd::Load8(components[vertex][1]);
+				result.z[vertex] = Simd::Load8(components[vertex][2]);
+			}
+			return result;
+		}
+
+		/// \brief Masks of the lanes with any vertex more than a_epsilon in front of and behind a_plane
+		void
+		Classify(TriangleBlock const& a_block, Plane const& a_plane, float a_epsilon, int& a_anyFront, int& a_anyBack)
+		{
+			Simd::Float8 const nx = Simd::Splat8(a_plane.normal.x);
+			Simd::Float8 const ny = Simd::Splat8(a_plane.normal.y);
+			Simd::Float8 const nz = Simd::Splat8(a_plane.normal.z);
+			Simd::Float8 const d  = Simd::Splat8(a_plane.distance);
+
+			Simd::Float8 const front = Simd::Splat8(a_epsilon);
+			Simd::Float8 const back  = Simd::Splat8(-a_epsilon);
+
+			Simd::Float8 anyFront = Simd::Zero8();
+			Simd::Float8 anyBack  = Simd::Zero8();
+			for (int vertex = 0; vertex < 3; vertex++)
+			{
+				Simd::Float8 distance = Simd::MulAdd(a_block.z[vertex], nz, Simd::MulAdd(a_block.y[vertex], ny, Simd::MulAdd(a_block.x[vertex], nx, d)));
+				anyFront = Simd::Or(anyFront, Simd::Greater(distance, front));
+				anyBack  = Simd::Or(anyBack, Simd::Less(distance, back));
+			}
+			a_anyFront = Simd::MoveMask(anyFront);
+			a_anyBack  = Simd::MoveMask(anyBack);
+		}
+
+		/// \brief Classifies every vertex against every plane, a_inside and a_outside are masks of whole lanes
+		void
+		Classify(TriangleBlock const& a_block, Plane const* a_planes, std::size_t a_planeCount, float a_epsilon, int& a_inside, int& a_outside)
+		{
+			Simd::Float8 const limit = Simd::Splat8(-a_epsilon);
+
+			int inside  = 0xFF;
+			int outside = 0;
+			for (std::size_t i = 0; i < a_planeCount; i++)
+			{
+				Plane const& plane = a_planes[i];
+
+				Simd::Float8 const nx = Simd::Splat8(plane.normal.x);
+				Simd::Float8 const ny = Simd::Splat8(plane.normal.y);
+				Simd::Float8 const nz = Simd::Splat8(plane.normal.z);
+				Simd::Float8 const d  = Simd::Splat8(plane.distance);
+
+				Simd::Float8 anyOut, allOut;
+				for (int vertex = 0; vertex < 3; vertex++)
+				{
+					Simd::Float8 distance = Simd::MulAdd(a_block.z[vertex], nz, Simd::MulAdd(a_block.y[vertex], ny, Simd::MulAdd(a_block.x[vertex], nx, d)));
+					Simd::Float8 out      = Simd::Less(distance, limit);
+					anyOut = vertex == 0 ? out : Simd::Or(anyOut, out);
+					allOut = vertex == 0 ? out : Simd::And(allOut, out);
+				}
+				inside  &= ~Simd::MoveMask(anyOut);
+				outside |= Simd::MoveMask(allOut);
+			}
+			a_inside  = inside;
+			a_outside = outside;
+		}
+
+		/// \brief Clips one triangle by every plane and writes it as a fan, the slow path of ClipTriangles
+		std::size_t
+		ClipTriangle(Vector3 const* a_triangle, Plane const* a_planes, std::size_t a_planeCount, float a_epsilon, Vector3* a_out)
+		{
+			Vector3 clipped[max_clipped_points];
+			Vector3 scratch[max_clipped_points];
+
+			std::size_t count = ClipPolygon(a_triangle, 3, a_planes, a_planeCount, clipped, scratch, a_epsilon);
+			return Triangulate(clipped, count, a_out);
+		}
+#pragma endregion
+	}
+
+	std::size_t
+	ConvexHull(Vector3 const* a_points, std::size_t a_count, uint32* a_triangles, float a_epsilon)
+	{
+		OYL_ASSERT(a_count < no_index);
+		if (a_count < 4)
+		{
+			return 0;
+		}
+
+		// Round-off of a plane distance grows with the magnitude of the coordinates (Barber et al.)
+		Vector3 extent;
+		for (std::size_t i = 0; i < a_count; i++)
+		{
+			extent = Vector::Max(extent, Vector::Abs(a_points[i]));
+		}
+		float const magnitude = extent.x + extent.y + extent.z;
+
+		if (a_epsilon <= 0)
+		{
+			a_epsilon = 3 * std::numeric_limits<float>::epsilon() * magnitude;
+		}
+
+		HullBuilder builder(a_points, a_count, a_epsilon, 16 * std::numeric_limits<double>::epsilon() * magnitude);
+		if (!builder.Build())
+		{
+			return 0;
+		}
+		return builder.Write(a_triangles);
+	}
+
+	std::size_t
+	ClipPolygon(
+		Vector3 const* a_points,
+		std::size_t    a_count,
+		Plane const*   a_planes,
+		std::size_t    a_planeCount,
+		Vector3*       a_out,
+		Vector3*       a_scratch,
+		float          a_epsilon
+	)
+	{
+		OYL_ASSERT(a_planeCount <= max_clip_planes);
+
+		if (a_planeCount == 0)
+		{
+			std::copy(a_points, a_points + a_count, a_out);
+			return a_count;
+		}
+
+		// Alternate between the buffers so that the last plane writes to a_out
+		Vector3* buffers[2] = { a_planeCount % 2 == 1 ? a_out : a_scratch, a_planeCount % 2 == 1 ? a_scratch : a_out };
+
+		Vector3 const* source = a_points;
+		std::size_t    count  = a_count;
+		for (std::size_t i = 0; i < a_planeCount; i++)
+		{
+			Vector3* destination = buffers[i % 2];
+			count  = ClipAgainstPlane(source, count, a_planes[i], a_epsilon, destination);
+			source = destination;
+			if (count == 0)
+			{
+				return 0;
+			}
+		}
+		return count;
+	}
+
+	std::size_t
+	ClipTriangles(
+		Vector3 const* a_triangles,
+		std::size_t    a_count,
+		Plane const*   a_planes,
+		std::size_t    a_planeCount,
+		Vector3*       a_out,
+		float          a_epsilon
+	)
+	{
+		OYL_ASSERT(a_planeCount <= max_clip_planes);
+
+		std::size_t result = 0;
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t         lanes    = std::min(block_size, a_count - i);
+			Vector3 const*      triangle = a_triangles + i * 3;
+			TriangleBlock const block    = LoadTriangles(triangle, lanes);
+
+			int inside, outside;
+			Classify(block, a_planes, a_planeCount, a_epsilon, inside, outside);
+
+			for (std::size_t lane = 0; lane < lanes; lane++, triangle += 3)
+			{
+				if ((outside >> lane) & 1)
+				{
+					continue;
+				}
+				if ((inside >> lane) & 1)
+				{
+					std::copy(triangle, triangle + 3, a_out + result * 3);
+					result++;
+					continue;
+				}
+				result += ClipTriangle(triangle, a_planes, a_planeCount, a_epsilon, a_out + result * 3);
+			}
+		}
+		return result;
+	}
+
+	TriangleSplit
+	SplitTriangle(Vector3 const* a_triangle, Plane const& a_plane, Vector3* a_front, Vector3* a_back, float a_epsilon)
+	{
+		float const distances[3] = {
+			Distance(a_plane, a_triangle[0]),
+			Distance(a_plane, a_triangle[1]),
+			Distance(a_plane, a_triangle[2]),
+		};
+
+		bool anyFront = false, anyBack = false;
+		for (float distance : distances)
+		{
+			anyFront |= distance > a_epsilon;
+			anyBack  |= distance < -a_epsilon;
+		}
+
+		if (!anyFront && !anyBack)
+		{
+			Vector3 normal = Vector::Cross(a_triangle[1] - a_triangle[0], a_triangle[2] - a_triangle[0]);
+			anyFront = Vector::Dot(normal, a_plane.normal) >= 0;
+			anyBack  = !anyFront;
+		}
+
+		TriangleSplit result;
+		if (!anyBack)
+		{
+			std::copy(a_triangle, a_triangle + 3, a_front);
+			result.front = 1;
+			return result;
+		}
+		if (!anyFront)
+		{
+			std::copy(a_triangle, a_triangle + 3, a_back);
+			result.back = 1;
+			return result;
+		}
+
+		// Each side of a straddling triangle is a triangle or a quad, points on the plane go to both
+		Vector3     front[4], back[4];
+		std::size_t frontCount = 0, backCount = 0;
+		for (int i = 0; i < 3; i++)
+		{
+			int   next = i == 2 ? 0 : i + 1;
+			float d0   = distances[i];
+			float d1   = distances[next];
+
+			if (d0 >= -a_epsilon)
+			{
+				front[frontCount++] = a_triangle[i];
+			}
+			if (d0 <= a_epsilon)
+			{
+				back[backCount++] = a_triangle[i];
+			}
+			if ((d0 > a_epsilon && d1 < -a_epsilon) || (d0 < -a_epsilon && d1 > a_epsilon))
+			{
+				Vector3 point = Intersection(a_triangle[i], a_triangle[next], d0, d1);
+				front[frontCount++] = point;
+				back[backCount++]   = point;
+			}
+		}
+
+		result.front = Triangulate(front, frontCount, a_front);
+		result.back  = Triangulate(back, backCount, a_back);
+		return result;
+	}
+
+	TriangleSplit
+	SplitTriangles(
+		Vector3 const* a_triangles,
+		std::size_t    a_count,
+		Plane const&   a_plane,
+		Vector3*       a_front,
+		Vector3*       a_back,
+		float          a_epsilon
+	)
+	{
+		TriangleSplit result;
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t    lanes    = std::min(block_size, a_count - i);
+			Vector3 const* triangle = a_triangles + i * 3;
+
+			int anyFront, anyBack;
+			Classify(LoadTriangles(triangle, lanes), a_plane, a_epsilon, anyFront, anyBack);
+
+			for (std::size_t lane = 0; lane < lanes; lane++, triangle += 3)
+			{
+				bool front = (anyFront >> lane) & 1;
+				bool back  = (anyBack >> lane) & 1;
+				if (front && !back)
+				{
+					std::copy(triangle, triangle + 3, a_front + result.front * 3);
+					result.front++;
+				}
+				else if (back && !front)
+				{
+					std::copy(triangle, triangle + 3, a_back + result.back * 3);
+					result.back++;
+				}
+				else
+				{
+					TriangleSplit split = SplitTriangle(triangle, a_plane, a_front + result.front * 3, a_back + result.back * 3, a_epsilon);
+					result.front += split.front;
+					result.back  += split.back;
+				}
+			}
+		}
+		return result;
+	}
+}
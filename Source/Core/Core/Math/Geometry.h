@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Bounds.h"
+#include "Vector3.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/// Number of triangles written to each side by Geometry::SplitTriangle and Geometry::SplitTriangles
+	struct TriangleSplit
+	{
+		std::size_t front = 0;
+		std::size_t back  = 0;
+	};
+}
+
+namespace Oyl::Geometry
+{
+	// Mesh cooking and clipping utilities.
+	// Triangles are triangle soups, three consecutive Vector3s per triangle wound counter-clockwise around their
+	// front face. Every function writes to buffers owned by the caller and returns how much it wrote, the largest
+	// possible output is known up front so the buffers can come from an arena or a reused vector.
+	// a_epsilon is in world units, points closer than it to a plane count as lying on the plane.
+
+	/// Largest number of triangles ConvexHull writes for a_count points, by Euler's formula
+	constexpr
+	std::size_t
+	MaxHullTriangles(std::size_t a_count)
+	{
+		return a_count < 4 ? 0 : 2 * a_count - 4;
+	}
+
+	/// Largest number of triangles ClipTriangles writes for a_count triangles and a_planeCount planes
+	constexpr
+	std::size_t
+	MaxClippedTriangles(std::size_t a_count, std::size_t a_planeCount)
+	{
+		return a_count * (a_planeCount + 1);
+	}
+
+	/// Most planes ClipPolygon and ClipTriangles accept at once
+	constexpr std::size_t max_clip_planes = 32;
+
+	/**
+	 * \brief Convex hull of a point cloud by quickhull (Barber, Dobkin and Huhdanpaa)
+	 * \param a_triangles Receives 3 indices into a_points per hull triangle, wound counter-clockwise seen from
+	 *                    outside. Needs room for 3 * MaxHullTriangles(a_count) indices.
+	 * \param a_epsilon Points less than this outside the hull are dropped as inside, 0 derives it from the extent
+	 *                  of the points and float precision. Larger values give fewer, coarser triangles.
+	 * \return The number of triangles, 0 if the points are all within a_epsilon of a plane
+	 * \remarks Duplicated and nearly coplanar points don't break the hull, faces closer to coplanar than
+	 *          a_epsilon are left as separate triangles rather than merged into polygons.
+	 */
+	OYL_CORE_API
+	extern
+	std::size_t
+	ConvexHull(Vector3 const* a_points, std::size_t a_count, uint32* a_triangles, float a_epsilon = 0);
+
+	/**
+	 * \brief Sutherland-Hodgman clipping of a convex polygon, keeping the part on the positive side of every plane
+	 * \param a_out, a_scratch Each need room for a_count + a_planeCount points
+	 * \return The number of points written to a_out, 0 when nothing is left
+	 */
+	OYL_CORE_API
+	extern
+	std::size_t
+	ClipPolygon(
+		Vector3 const* a_points,
+		std::size_t    a_count,
+		Plane const*   a_planes,
+		std::size_t    a_planeCount,
+		Vector3*       a_out,
+		Vector3*       a_scratch,
+		float          a_epsilon = 1e-5f
+	);
+
+	/**
+	 * \brief Clips a triangle soup to the positive side of every plane, ie. to a Frustum or a portal
+	 * \param a_out Receives the clipped triangles, needs room for 3 * MaxClippedTriangles(a_count, a_planeCount) points
+	 * \return The number of triangles written
+	 * \remarks Classifies eight triangles per iteration, triangles entirely inside are copied and triangles entirely
+	 *          outside one plane dropped without clipping, so large meshes mostly pay for the classification.
+	 */
+	OYL_CORE_API
+	extern
+	std::size_t
+	ClipTriangles(
+		Vector3 const* a_triangles,
+		std::size_t    a_count,
+		Plane const*   a_planes,
+		std::size_t    a_planeCount,
+		Vector3*       a_out,
+		float          a_epsilon = 1e-5f
+	);
+
+	/**
+	 * \brief Splits a triangle by a plane, as for building a BSP tree
+	 * \param a_triangle Three points
+	 * \param a_front, a_back Each need room for two triangles, six points
+	 * \remarks Triangles within a_epsilon of the plane go to the side their normal faces, so coplanar geometry
+	 *          is never split into slivers.
+	 */
+	OYL_CORE_API
+	extern
+	TriangleSplit
+	SplitTriangle(Vector3 const* a_triangle, Plane const& a_plane, Vector3* a_front, Vector3* a_back, float a_epsilon = 1e-5f);
+
+	/**
+	 * \brief SplitTriangle for a whole triangle soup, keeping the order of the input on each side
+	 * \param a_front, a_back Each need room for 2 * a_count triangles
+	 */
+	OYL_CORE_API
+	extern
+	TriangleSplit
+	SplitTriangles(
+		Vector3 const* a_triangles,
+		std::size_t    a_count,
+		Plane const&   a_plane,
+		Vector3*       a_front,
+		Vector3*       a_back,
+		float          a_epsilon = 1e-5f
+	);
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	namespace Detail
+	{
+		OYL_FORCE_INLINE
+		uint32
+		FloatBits(float a_value)
+		{
+			uint32 result;
+			std::memcpy(&result, &a_value, sizeof(result));
+			return result;
+		}
+
+		OYL_FORCE_INLINE
+		float
+		FloatFromBits(uint32 a_bits)
+		{
+			float result;
+			std::memcpy(&result, &a_bits, sizeof(result));
+			return result;
+		}
+
+		/**
+		 * \brief IEEE 754 binary32 to binary16 with round to nearest even
+		 * \remarks Giesen, "float->half variants". Values too large for a half become infinity, NaNs stay NaN.
+		 *          Packing::EncodeHalf runs the same steps four lanes at a time.
+		 */
+		inline
+		uint16
+		FloatToHalfBits(float a_value)
+		{
+			constexpr uint32 float_infinity = 255u << 23;
+			constexpr uint32 half_overflow  = (127u + 16u) << 23;
+			constexpr uint32 denormal_magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+			constexpr uint32 half_min_normal = 113u << 23;
+
+			uint32 bits = FloatBits(a_value);
+			uint32 sign = bits & 0x80000000u;
+			bits ^= sign;
+
+			uint32 result;
+			if (bits >= half_overflow)
+			{
+				result = bits > float_infinity ? 0x7E00u : 0x7C00u;
+			} else if (bits < half_min_normal)
+			{
+				// Let the FPU do the rounding by adding a value that shifts the mantissa into place
+				result = FloatBits(FloatFromBits(bits) + FloatFromBits(denormal_magic)) - denormal_magic;
+			} else
+			{
+				uint32 mantissaOdd = (bits >> 13) & 1;
+				bits += ((15u - 127u) << 23) + 0xFFFu;
+				bits += mantissaOdd;
+				result = bits >> 13;
+			}
+
+			return static_cast<uint16>(result | (sign >> 16));
+		}
+
+		/// \brief IEEE 754 binary16 to binary32, always exact
+		inline
+		float
+		HalfBitsToFloat(uint16 a_bits)
+		{
+			constexpr uint32 shifted_exponent = 0x7C00u << 13;
+			constexpr uint32 denormal_magic   = 113u << 23;
+
+			uint32 bits     = (a_bits & 0x7FFFu) << 13;
+			uint32 exponent = bits & shifted_exponent;
+			bits += (127u - 15u) << 23;
+
+			if (exponent == shifted_exponent)
+			{
+				// Infinity or NaN
+				bits += (128u - 16u) << 23;
+			} else if (exponent == 0)
+			{
+				// Zero or denormal, renormalize through the FPU
+				bits += 1u << 23;
+				bits = FloatBits(FloatFromBits(bits) - FloatFromBits(denormal_magic));
+			}
+
+			return FloatFromBits(bits | (static_cast<uint32>(a_bits & 0x8000u) << 16));
+		}
+	}
+
+	/**
+	 * \brief IEEE 754 half precision float, for storage only
+	 * \remarks Converts implicitly to and from float, so arithmetic happens in float and only the result is
+	 *          rounded back. This makes Vector_t<N, half> usable with the generic vector code, but every operation
+	 *          pays for two conversions, so decode to float before doing real work. See Packing::DecodeHalf.
+	 *      <br>Relative error is at most 2^-11 (about 0.05%) for magnitudes between 6.1e-5 and 65504.
+	 *          Smaller magnitudes lose precision gradually, larger ones become infinity.
+	 */
+	struct half
+	{
+		half() = default;
+
+		half(float a_value)
+			: bits(Detail::FloatToHalfBits(a_value)) {}
+
+		operator float() const { return Detail::HalfBitsToFloat(bits); }
+
+		half& operator +=(float a_other) { return *this = *this + a_other; }
+		half& operator -=(float a_other) { return *this = *this - a_other; }
+		half& operator *=(float a_other) { return *this = *this * a_other; }
+		half& operator /=(float a_other) { return *this = *this / a_other; }
+
+		static
+		half
+		FromBits(uint16 a_bits)
+		{
+			half result;
+			result.bits = a_bits;
+			return result;
+		}
+
+		uint16 bits;
+	};
+	static_assert(sizeof(half) == 2);
+}
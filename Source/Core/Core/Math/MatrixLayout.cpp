@@ -0,0 +1,105 @@
+#include "pch.h"
+#include "MatrixLayout.h"
+
+#include "Simd.h"
+
+namespace Oyl::Matrix
+{
+	namespace
+	{
+		/// Transposes the 4x4 blocks of a_count matrices from a_src into a_dst, either direction is the same operation
+		void
+		TransposeMatrix4Array(float const* a_src, float* a_dst, std::size_t a_count)
+		{
+			std::size_t i = 0;
+
+		#if OYL_SIMD == OYL_SIMD_AVX
+			// Two matrices per iteration, one in each 128 bit half
+			for (; i + 2 <= a_count; i += 2)
+			{
+				float const* src = a_src + i * 16;
+				float*       dst = a_dst + i * 16;
+
+				__m256 row0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 0)), _mm_loadu_ps(src + 16), 1);
+				__m256 row1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 20), 1);
+				__m256 row2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 24), 1);
+				__m256 row3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 12)), _mm_loadu_ps(src + 28), 1);
+
+				__m256 low01  = _mm256_unpacklo_ps(row0, row1);
+				__m256 low23  = _mm256_unpacklo_ps(row2, row3);
+				__m256 high01 = _mm256_unpackhi_ps(row0, row1);
+				__m256 high23 = _mm256_unpackhi_ps(row2, row3);
+
+				__m256 column0 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(1, 0, 1, 0));
+				__m256 column1 = _mm256_shuffle_ps(low01, low23, _MM_SHUFFLE(3, 2, 3, 2));
+				__m256 column2 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(1, 0, 1, 0));
+				__m256 column3 = _mm256_shuffle_ps(high01, high23, _MM_SHUFFLE(3, 2, 3, 2));
+
+				// Recombine the halves so each store writes two consecutive columns of one matrix
+				_mm256_storeu_ps(dst + 0,  _mm256_permute2f128_ps(column0, column1, 0x20));
+				_mm256_storeu_ps(dst + 8,  _mm256_permute2f128_ps(column2, column3, 0x20));
+				_mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(column0, column1, 0x31));
+				_mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(column2, column3, 0x31));
+			}
+		#endif
+
+			for (; i < a_count; i++)
+			{
+				float const* src = a_src + i * 16;
+				float*       dst = a_dst + i * 16;
+
+				Simd::Float4 row0 = Simd::Load(src + 0);
+				Simd::Float4 row1 = Simd::Load(src + 4);
+				Simd::Float4 row2 = Simd::Load(src + 8);
+				Simd::Float4 row3 = Simd::Load(src + 12);
+				Simd::Transpose(row0, row1, row2, row3);
+				Simd::Store(dst + 0, row0);
+				Simd::Store(dst + 4, row1);
+				Simd::Store(dst + 8, row2);
+				Simd::Store(dst + 12, row3);
+			}
+		}
+
+		void
+		TransposeMatrix3Array(float const* a_src, float* a_dst, std::size_t a_count)
+		{
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				float const* src = a_src + i * 9;
+				float*       dst = a_dst + i * 9;
+
+				for (int y = 0; y < 3; y++)
+				{
+					for (int x = 0; x < 3; x++)
+					{
+						dst[x * 3 + y] = src[y * 3 + x];
+					}
+				}
+			}
+		}
+	}
+
+	void
+	ConvertLayout(Matrix4 const* a_src, Matrix4ColumnMajor* a_dst, std::size_t a_count)
+	{
+		TransposeMatrix4Array(reinterpret_cast<float const*>(a_src), reinterpret_cast<float*>(a_dst), a_count);
+	}
+
+	void
+	ConvertLayout(Matrix4ColumnMajor const* a_src, Matrix4* a_dst, std::size_t a_count)
+	{
+		TransposeMatrix4Array(reinterpret_cast<float const*>(a_src), reinterpret_cast<float*>(a_dst), a_count);
+	}
+
+	void
+	ConvertLayout(Matrix3 const* a_src, Matrix3ColumnMajor* a_dst, std::size_t a_count)
+	{
+		TransposeMatrix3Array(reinterpret_cast<float const*>(a_src), reinterpret_cast<float*>(a_dst), a_count);
+	}
+
+	void
+	ConvertLayout(Matrix3ColumnMajor const* a_src, Matrix3* a_dst, std::size_t a_count)
+	{
+		TransposeMatrix3Array(reinterpret_cast<float const*>(a_src), reinterpret_cast<float*>(a_dst), a_count);
+	}
+}
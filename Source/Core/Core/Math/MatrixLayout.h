@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Detail/type_MatrixColumnMajor.h"
+
+#include "Matrix.h"
+
+#include "Core/Common.h"
+
+namespace Oyl
+{
+	typedef Matrix_t<2, 2, float, MatrixLayout::ColumnMajor> Matrix2ColumnMajor;
+	static_assert(sizeof(Matrix2ColumnMajor) == sizeof(Matrix2ColumnMajor::data));
+
+	typedef Matrix_t<3, 3, float, MatrixLayout::ColumnMajor> Matrix3ColumnMajor;
+	static_assert(sizeof(Matrix3ColumnMajor) == sizeof(Matrix3ColumnMajor::data));
+
+	typedef Matrix_t<4, 4, float, MatrixLayout::ColumnMajor> Matrix4ColumnMajor;
+	static_assert(sizeof(Matrix4ColumnMajor) == sizeof(Matrix4ColumnMajor::data));
+}
+
+/**
+ * Bulk conversion between storage orders for arrays of matrices, ie. instance transforms streamed to the GPU.
+ * a_dst can point straight at mapped buffer memory, the transpose happens on the way there in a single pass.
+ * Matrices that only ever go to column-major consumers can also be kept as Matrix4ColumnMajor throughout,
+ * which needs no conversion at all.
+ */
+namespace Oyl::Matrix
+{
+	/// \brief a_dst[i] = ConvertLayout<MatrixLayout::ColumnMajor>(a_src[i]), a_dst must not overlap a_src
+	OYL_CORE_API
+	extern
+	void
+	ConvertLayout(Matrix4 const* a_src, Matrix4ColumnMajor* a_dst, std::size_t a_count);
+
+	/// \brief a_dst[i] = ConvertLayout<MatrixLayout::RowMajor>(a_src[i]), a_dst must not overlap a_src
+	OYL_CORE_API
+	extern
+	void
+	ConvertLayout(Matrix4ColumnMajor const* a_src, Matrix4* a_dst, std::size_t a_count);
+
+	/// \brief a_dst[i] = ConvertLayout<MatrixLayout::ColumnMajor>(a_src[i]), a_dst must not overlap a_src
+	OYL_CORE_API
+	extern
+	void
+	ConvertLayout(Matrix3 const* a_src, Matrix3ColumnMajor* a_dst, std::size_t a_count);
+
+	/// \brief a_dst[i] = ConvertLayout<MatrixLayout::RowMajor>(a_src[i]), a_dst must not overlap a_src
+	OYL_CORE_API
+	extern
+	void
+	ConvertLayout(Matrix3ColumnMajor const* a_src, Matrix3* a_dst, std::size_t a_count);
+}
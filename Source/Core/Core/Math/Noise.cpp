@@ -0,0 +1,611 @@
+#include "pch.h"
+#include "Noise.h"
+
+#include "Simd.h"
+
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl::Noise
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+
+		/// Large primes the lattice coordinates are multiplied by before hashing, one per axis
+		constexpr std::int32_t primes[4] = { 501125321, 1136930381, 1720413743, 1066037191 };
+
+		/// Multiplies each kernel's raw output into roughly [-1, 1], measured over a large set of samples
+		constexpr float perlin_scale[5]  = { 0, 0, 0.662f, 1.0f, 0.918f };
+		constexpr float simplex_scale[5] = { 0, 0, 45.2f, 76.9f, 62.9f };
+		constexpr float worley_scale[5]  = { 0, 0, 1.614f, 1.707f, 1.802f };
+
+		OYL_FORCE_INLINE
+		Simd::Float8
+		Floor(Simd::Float8 a_value)
+		{
+			Simd::Float8 rounded = Simd::Round(a_value);
+			return Simd::Sub(rounded, Simd::And(Simd::Greater(rounded, a_value), Simd::Splat8(1.0f)));
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Int8
+		AsInt(Simd::Float8 a_mask)
+		{
+			return Simd::BitCastToInt(a_mask);
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float8
+		AsFloat(Simd::Int8 a_mask)
+		{
+			return Simd::BitCastToFloat(a_mask);
+		}
+
+		/// \return All bits set in the lanes where a_hash has bit Bit set
+		template<int Bit>
+		OYL_FORCE_INLINE
+		Simd::Float8
+		IsBitSet(Simd::Int8 a_hash)
+		{
+			return AsFloat(Simd::ShiftRight<31>(Simd::ShiftLeft<31 - Bit>(a_hash)));
+		}
+
+		/// \return a_value negated in the lanes where a_hash has bit Bit set
+		template<int Bit>
+		OYL_FORCE_INLINE
+		Simd::Float8
+		FlipSign(Simd::Float8 a_value, Simd::Int8 a_hash)
+		{
+			return Simd::FlipSign(a_value, AsFloat(Simd::ShiftLeft<31 - Bit>(a_hash)));
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Int8
+		Mix(Simd::Int8 a_hash)
+		{
+			a_hash = Simd::Mul(a_hash, Simd::SplatInt8(0x27D4EB2D));
+			return Simd::Xor(a_hash, Simd::ShiftRightLogical<15>(a_hash));
+		}
+
+		/// \return A well mixed hash of a lattice point, a_primed holds its coordinates times primes
+		template<int Dimensions>
+		OYL_FORCE_INLINE
+		Simd::Int8
+		Hash(Simd::Int8 a_seed, Simd::Int8 const (&a_primed)[Dimensions])
+		{
+			Simd::Int8 hash = a_seed;
+			for (int d = 0; d < Dimensions; d++)
+			{
+				hash = Simd::Xor(hash, a_primed[d]);
+			}
+			return Mix(hash);
+		}
+
+		/// \return The hash mapped to [-1, 1)
+		OYL_FORCE_INLINE
+		Simd::Float8
+		HashToSigned(Simd::Int8 a_hash)
+		{
+			return Simd::Mul(Simd::ConvertToFloat(a_hash), Simd::Splat8(1.0f / 2147483648.0f));
+		}
+
+		/// \return The top 24 bits of the hash mapped to [0, 1)
+		OYL_FORCE_INLINE
+		Simd::Float8
+		HashToUnit(Simd::Int8 a_hash)
+		{
+			return Simd::Mul(Simd::ConvertToFloat(Simd::ShiftRightLogical<8>(a_hash)), Simd::Splat8(1.0f / 16777216.0f));
+		}
+
+		/**
+		 * \return The dot product of a_offset with the gradient picked by a_hash
+		 * \remarks Gradients are picked with selects and sign flips rather than a table, there is no gather to read
+		 *          one with. 2D uses the eight (1, 2) permutations, 3D the twelve cube edge midpoints of improved
+		 *          Perlin noise, 4D the 32 (0, 1, 1, 1) permutations.
+		 */
+		template<int Dimensions>
+		OYL_FORCE_INLINE
+		Simd::Float8
+		GradientDot(Simd::Int8 a_hash, Simd::Float8 const (&a_offset)[Dimensions])
+		{
+			if constexpr (Dimensions == 2)
+			{
+				Simd::Float8 swap = IsBitSet<2>(a_hash);
+				Simd::Float8 u    = Simd::Select(swap, a_offset[1], a_offset[0]);
+				Simd::Float8 v    = Simd::Select(swap, a_offset[0], a_offset[1]);
+				return Simd::Add(FlipSign<0>(u, a_hash), FlipSign<1>(Simd::Add(v, v), a_hash));
+			}
+			else if constexpr (Dimensions == 3)
+			{
+				Simd::Int8 h = Simd::And(a_hash, Simd::SplatInt8(15));
+
+				Simd::Float8 u    = Simd::Select(AsFloat(Simd::Less(h, Simd::SplatInt8(8))), a_offset[0], a_offset[1]);
+				Simd::Float8 vIsY = AsFloat(Simd::Less(h, Simd::SplatInt8(4)));
+				Simd::Float8 vIsX = AsFloat(Simd::Or(Simd::Equal(h, Simd::SplatInt8(12)), Simd::Equal(h, Simd::SplatInt8(14))));
+				Simd::Float8 v    = Simd::Select(vIsY, a_offset[1], Simd::Select(vIsX, a_offset[0], a_offset[2]));
+				return Simd::Add(FlipSign<0>(u, a_hash), FlipSign<1>(v, a_hash));
+			}
+			else
+			{
+				// Bits 3 and 4 pick the axis the gradient is zero along, the other three keep their order
+				Simd::Int8 axis = Simd::And(Simd::ShiftRightLogical<3>(a_hash), Simd::SplatInt8(3));
+
+				Simd::Float8 u = Simd::Select(AsFloat(Simd::Equal(axis, Simd::SplatInt8(0))), a_offset[1], a_offset[0]);
+				Simd::Float8 v = Simd::Select(AsFloat(Simd::Less(axis, Simd::SplatInt8(2))), a_offset[2], a_offset[1]);
+				Simd::Float8 w = Simd::Select(AsFloat(Simd::Equal(axis, Simd::SplatInt8(3))), a_offset[2], a_offset[3]);
+				return Simd::Add(Simd::Add(FlipSign<0>(u, a_hash), FlipSign<1>(v, a_hash)), FlipSign<2>(w, a_hash));
+			}
+		}
+
+		/// \return 6t^5 - 15t^4 + 10t^3, which has zero first and second derivatives at 0 and 1
+		OYL_FORCE_INLINE
+		Simd::Float8
+		Quintic(Simd::Float8 a_t)
+		{
+			Simd::Float8 result = Simd::MulAdd(a_t, Simd::Splat8(6.0f), Simd::Splat8(-15.0f));
+			result = Simd::MulAdd(result, a_t, Simd::Splat8(10.0f));
+			return Simd::Mul(result, Simd::Mul(Simd::Mul(a_t, a_t), a_t));
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float8
+		Lerp(Simd::Float8 a_t, Simd::Float8 a_lhs, Simd::Float8 a_rhs)
+		{
+			return Simd::MulAdd(Simd::Sub(a_rhs, a_lhs), a_t, a_lhs);
+		}
+
+		/// The cell a position falls in and where it lies within it
+		template<int Dimensions>
+		struct Lattice
+		{
+			Simd::Float8 fraction[Dimensions];
+			Simd::Int8   primed[Dimensions];
+		};
+
+		template<int Dimensions>
+		OYL_FORCE_INLINE
+		Lattice<Dimensions>
+		Locate(Simd::Float8 const (&a_position)[Dimensions])
+		{
+			Lattice<Dimensions> result;
+			for (int d = 0; d < Dimensions; d++)
+			{
+				Simd::Float8 cell = Floor(a_position[d]);
+				result.fraction[d] = Simd::Sub(a_position[d], cell);
+				result.primed[d]   = Simd::Mul(Simd::ConvertToInt(cell), Simd::SplatInt8(primes[d]));
+			}
+			return result;
+		}
+
+		/// Value and Perlin noise, interpolating TCorner of every corner of the cell with the quintic fade
+		template<int Dimensions, typename TCorner>
+		OYL_FORCE_INLINE
+		Simd::Float8
+		LatticeNoise(Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions], TCorner&& a_corner)
+		{
+			constexpr int corner_count = 1 << Dimensions;
+
+			Lattice<Dimensions> lattice = Locate(a_position);
+
+			Simd::Float8 values[corner_count];
+			for (int c = 0; c < corner_count; c++)
+			{
+				Simd::Int8   primed[Dimensions];
+				Simd::Float8 offset[Dimensions];
+				for (int d = 0; d < Dimensions; d++)
+				{
+					bool isFar = (c >> d) & 1;
+					primed[d] = isFar ? Simd::Add(lattice.primed[d], Simd::SplatInt8(primes[d])) : lattice.primed[d];
+					offset[d] = isFar ? Simd::Sub(lattice.fraction[d], Simd::Splat8(1.0f)) : lattice.fraction[d];
+				}
+				values[c] = a_corner(Hash(a_seed, primed), offset);
+			}
+
+			// Corner bit d is axis d, so pairs along axis 0 are adjacent, and each pass halves the corners
+			for (int d = 0; d < Dimensions; d++)
+			{
+				Simd::Float8 fade = Quintic(lattice.fraction[d]);
+				for (int c = 0; c < (corner_count >> (d + 1)); c++)
+				{
+					values[c] = Lerp(fade, values[2 * c], values[2 * c + 1]);
+				}
+			}
+			return values[0];
+		}
+
+		template<int Dimensions>
+		Simd::Float8
+		Value(Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			return LatticeNoise(a_seed, a_position, [](Simd::Int8 a_hash, Simd::Float8 const (&)[Dimensions])
+			{
+				return HashToSigned(a_hash);
+			});
+		}
+
+		template<int Dimensions>
+		Simd::Float8
+		Perlin(Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			Simd::Float8 result = LatticeNoise(a_seed, a_position, [](Simd::Int8 a_hash, Simd::Float8 const (&a_offset)[Dimensions])
+			{
+				return GradientDot(a_hash, a_offset);
+			});
+			return Simd::Mul(result, Simd::Splat8(perlin_scale[Dimensions]));
+		}
+
+		/**
+		 * Simplex noise (Perlin, Gustavson's "Simplex noise demystified") in any of 2, 3 or 4 dimensions.
+		 * The simplex a position falls in is found by ranking its offset components, each component is compared with
+		 * every other, so the corners follow without the branches of the reference implementation.
+		 */
+		template<int Dimensions>
+		Simd::Float8
+		Simplex(Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			// (sqrt(n + 1) - 1) / n and (1 - 1 / sqrt(n + 1)) / n
+			constexpr float skew   = Dimensions == 2 ? 0.36602540f : (Dimensions == 3 ? 1.0f / 3.0f : 0.30901699f);
+			constexpr float unskew = Dimensions == 2 ? 0.21132487f : (Dimensions == 3 ? 1.0f / 6.0f : 0.13819660f);
+
+			Simd::Float8 sum = a_position[0];
+			for (int d = 1; d < Dimensions; d++)
+			{
+				sum = Simd::Add(sum, a_position[d]);
+			}
+			Simd::Float8 skewed = Simd::Mul(sum, Simd::Splat8(skew));
+
+			Simd::Float8 cell[Dimensions];
+			Simd::Float8 cellSum = Simd::Zero8();
+			for (int d = 0; d < Dimensions; d++)
+			{
+				cell[d] = Floor(Simd::Add(a_position[d], skewed));
+				cellSum = Simd::Add(cellSum, cell[d]);
+			}
+			Simd::Float8 unskewed = Simd::Mul(cellSum, Simd::Splat8(unskew));
+
+			Simd::Float8 origin[Dimensions];
+			Simd::Int8   primed[Dimensions];
+			Simd::Int8   rank[Dimensions];
+			for (int d = 0; d < Dimensions; d++)
+			{
+				origin[d] = Simd::Sub(a_position[d], Simd::Sub(cell[d], unskewed));
+				primed[d] = Simd::Mul(Simd::ConvertToInt(cell[d]), Simd::SplatInt8(primes[d]));
+				rank[d]   = Simd::SplatInt8(0);
+			}
+
+			// The rank of a component is how many others it is at least as large as, ties go to the lower axis
+			for (int a = 0; a < Dimensions; a++)
+			{
+				for (int b = a + 1; b < Dimensions; b++)
+				{
+					Simd::Int8 aWins = AsInt(Simd::LessEqual(origin[b], origin[a]));
+					rank[a] = Simd::Sub(rank[a], aWins);
+					rank[b] = Simd::Add(rank[b], Simd::Add(aWins, Simd::SplatInt8(1)));
+				}
+			}
+
+			Simd::Float8 result = Simd::Zero8();
+			for (int corner = 0; corner <= Dimensions; corner++)
+			{
+				// Corner k steps along the k axes with the largest components
+				Simd::Int8   cornerPrimed[Dimensions];
+				Simd::Float8 offset[Dimensions];
+				Simd::Float8 distanceSquared = Simd::Zero8();
+				for (int d = 0; d < Dimensions; d++)
+				{
+					// All bits set along the axes the corner steps along
+					Simd::Int8 steps = Simd::SplatInt8(corner == Dimensions ? -1 : 0);
+					if (corner > 0 && corner < Dimensions)
+					{
+						steps = Simd::Greater(rank[d], Simd::SplatInt8(Dimensions - 1 - corner));
+					}
+
+					cornerPrimed[d] = Simd::Add(primed[d], Simd::And(steps, Simd::SplatInt8(primes[d])));
+					offset[d]       = Simd::Sub(origin[d], Simd::And(AsFloat(steps), Simd::Splat8(1.0f)));
+					offset[d]       = Simd::Add(offset[d], Simd::Splat8(unskew * static_cast<float>(corner)));
+					distanceSquared = Simd::MulAdd(offset[d], offset[d], distanceSquared);
+				}
+
+				// (r^2 - d^2)^4 falloff, with r^2 = 0.5 the contributions vanish before crossing into other simplices
+				Simd::Float8 falloff = Simd::Max(Simd::Sub(Simd::Splat8(0.5f), distanceSquared), Simd::Zero8());
+				falloff = Simd::Mul(falloff, falloff);
+				falloff = Simd::Mul(falloff, falloff);
+				result  = Simd::MulAdd(falloff, GradientDot(Hash(a_seed, cornerPrimed), offset), result);
+			}
+			return Simd::Mul(result, Simd::Splat8(simplex_scale[Dimensions]));
+		}
+
+		/// Distance to the nearest feature point, one per cell jittered anywhere inside it, searched over the 3^n cells around
+		template<int Dimensions>
+		Simd::Float8
+		Worley(Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			constexpr int neighbour_count = Dimensions == 2 ? 9 : (Dimensions == 3 ? 27 : 81);
+
+			Lattice<Dimensions> lattice = Locate(a_position);
+
+			Simd::Float8 nearest = Simd::Splat8(1e10f);
+			for (int n = 0; n < neighbour_count; n++)
+			{
+				Simd::Int8   primed[Dimensions];
+				Simd::Float8 cellOffset[Dimensions];
+				int          index = n;
+				for (int d = 0; d < Dimensions; d++)
+				{
+					int step = index % 3 - 1;
+					index /= 3;
+
+					primed[d]     = Simd::Add(lattice.primed[d], Simd::SplatInt8(primes[d] * step));
+					cellOffset[d] = Simd::Sub(Simd::Splat8(static_cast<float>(step)), lattice.fraction[d]);
+				}
+
+				// Each axis of the feature point gets fresh bits by mixing the hash again
+				Simd::Int8   hash            = Hash(a_seed, primed);
+				Simd::Float8 distanceSquared = Simd::Zero8();
+				for (int d = 0; d < Dimensions; d++)
+				{
+					Simd::Float8 delta = Simd::Add(cellOffset[d], HashToUnit(hash));
+					distanceSquared = Simd::MulAdd(delta, delta, distanceSquared);
+					hash = Mix(hash);
+				}
+				nearest = Simd::Min(nearest, distanceSquared);
+			}
+
+			return Simd::MulAdd(Simd::Sqrt(nearest), Simd::Splat8(worley_scale[Dimensions]), Simd::Splat8(-1.0f));
+		}
+
+		template<int Dimensions>
+		OYL_FORCE_INLINE
+		Simd::Float8
+		Single(NoiseType a_type, Simd::Int8 a_seed, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			switch (a_type)
+			{
+				case NoiseType::Value:   return Value(a_seed, a_position);
+				case NoiseType::Perlin:  return Perlin(a_seed, a_position);
+				case NoiseType::Simplex: return Simplex(a_seed, a_position);
+				default:                 return Worley(a_seed, a_position);
+			}
+		}
+
+		/// Evaluates a_settings at eight positions, including the frequency and fractal
+		template<int Dimensions>
+		Simd::Float8
+		Evaluate(NoiseSettings const& a_settings, Simd::Float8 const (&a_position)[Dimensions])
+		{
+			Simd::Float8 position[Dimensions];
+			for (int d = 0; d < Dimensions; d++)
+			{
+				position[d] = Simd::Mul(a_position[d], Simd::Splat8(a_settings.frequency));
+			}
+
+			if (a_settings.fractal == NoiseFractal::None || a_settings.octaves <= 1)
+			{
+				return Single(a_settings.type, Simd::SplatInt8(a_settings.seed), position);
+			}
+
+			Simd::Float8 result    = Simd::Zero8();
+			float        amplitude = 1.0f;
+			float        total     = 0.0f;
+			for (int32 octave = 0; octave < a_settings.octaves; octave++)
+			{
+				// Octaves get their own seed, or they would all share a feature at the origin
+				Simd::Float8 value = Single(a_settings.type, Simd::SplatInt8(a_settings.seed + octave), position);
+				if (a_settings.fractal == NoiseFractal::Ridged)
+				{
+					value = Simd::MulAdd(Simd::Abs(value), Simd::Splat8(-2.0f), Simd::Splat8(1.0f));
+				}
+				result = Simd::MulAdd(value, Simd::Splat8(amplitude), result);
+
+				total     += amplitude;
+				amplitude *= a_settings.gain;
+				for (int d = 0; d < Dimensions; d++)
+				{
+					position[d] = Simd::Mul(position[d], Simd::Splat8(a_settings.lacunarity));
+				}
+			}
+			return Simd::Mul(result, Simd::Splat8(1.0f / total));
+		}
+
+		template<int Dimensions>
+		float
+		SampleOne(NoiseSettings const& a_settings, Vector_t<Dimensions, float> const& a_position)
+		{
+			Simd::Float8 position[Dimensions];
+			for (int d = 0; d < Dimensions; d++)
+			{
+				position[d] = Simd::Splat8(a_position.data[d]);
+			}
+			return Simd::GetX(Evaluate(a_settings, position));
+		}
+
+		void
+		StorePartial(float* a_dst, Simd::Float8 a_value, std::size_t a_count)
+		{
+			if (a_count == block_size)
+			{
+				Simd::Store(a_dst, a_value);
+				return;
+			}
+
+			alignas(32) float lanes[block_size];
+			Simd::Store(lanes, a_value);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				a_dst[i] = lanes[i];
+			}
+		}
+
+		template<int Dimensions>
+		void
+		SampleArray(NoiseSettings const& a_settings, Vector_t<Dimensions, float> const* a_positions, float* a_out, std::size_t a_count)
+		{
+			for (std::size_t i = 0; i < a_count; i += block_size)
+			{
+				std::size_t valid = a_count - i < block_size ? a_count - i : block_size;
+
+				// Unused lanes sample the origin, their results are dropped
+				alignas(32) float lanes[Dimensions][block_size] = {};
+				for (std::size_t lane = 0; lane < valid; lane++)
+				{
+					for (int d = 0; d < Dimensions; d++)
+					{
+						lanes[d][lane] = a_positions[i + lane].data[d];
+					}
+				}
+
+				Simd::Float8 position[Dimensions];
+				for (int d = 0; d < Dimensions; d++)
+				{
+					position[d] = Simd::Load8(lanes[d]);
+				}
+				StorePartial(a_out + i, Evaluate(a_settings, position), valid);
+			}
+		}
+
+		template<int Dimensions>
+		void
+		FillRows(NoiseSettings const& a_settings, NoiseGrid_t<Dimensions> const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out)
+		{
+			OYL_ASSERT(a_firstRow + a_rowCount <= a_grid.RowCount());
+
+			alignas(32) float const lane_index[block_size] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+			std::size_t const width = a_grid.size.data[0];
+			for (std::size_t row = a_firstRow; row < a_firstRow + a_rowCount; row++)
+			{
+				Simd::Float8 position[Dimensions];
+
+				// The other axes are constant along a row
+				std::size_t index = row;
+				for (int d = 1; d < Dimensions; d++)
+				{
+					std::size_t coordinate = index % a_grid.size.data[d];
+					index /= a_grid.size.data[d];
+					position[d] = Simd::Splat8(a_grid.origin.data[d] + static_cast<float>(coordinate) * a_grid.step.data[d]);
+				}
+
+				float* out = a_out + (row - a_firstRow) * width;
+				for (std::size_t x = 0; x < width; x += block_size)
+				{
+					std::size_t  valid  = width - x < block_size ? width - x : block_size;
+					Simd::Float8 column = Simd::Add(Simd::Load8(lane_index), Simd::Splat8(static_cast<float>(x)));
+					position[0] = Simd::MulAdd(column, Simd::Splat8(a_grid.step.data[0]), Simd::Splat8(a_grid.origin.data[0]));
+					StorePartial(out + x, Evaluate(a_settings, position), valid);
+				}
+			}
+		}
+
+		template<int Dimensions>
+		void
+		FillRowsParallel(NoiseSettings const& a_settings, NoiseGrid_t<Dimensions> const& a_grid, float* a_out, WorkerPool& a_pool)
+		{
+			a_pool.ParallelForRanges(a_grid.RowCount(), [&](std::size_t a_first, std::size_t a_last)
+			{
+				FillRows(a_settings, a_grid, a_first, a_last - a_first, a_out + a_first * a_grid.size.data[0]);
+			});
+		}
+	}
+
+	float
+	Sample(NoiseSettings const& a_settings, Vector2 const& a_position)
+	{
+		return SampleOne(a_settings, a_position);
+	}
+
+	float
+	Sample(NoiseSettings const& a_settings, Vector3 const& a_position)
+	{
+		return SampleOne(a_settings, a_position);
+	}
+
+	float
+	Sample(NoiseSettings const& a_settings, Vector4 const& a_position)
+	{
+		return SampleOne(a_settings, a_position);
+	}
+
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector2 const* a_positions, float* a_out, std::size_t a_count)
+	{
+		SampleArray(a_settings, a_positions, a_out, a_count);
+	}
+
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector3 const* a_positions, float* a_out, std::size_t a_count)
+	{
+		SampleArray(a_settings, a_positions, a_out, a_count);
+	}
+
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector4 const* a_positions, float* a_out, std::size_t a_count)
+	{
+		SampleArray(a_settings, a_positions, a_out, a_count);
+	}
+
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector3Stream const& a_positions, float* a_out)
+	{
+		for (std::size_t i = 0; i < a_positions.Count(); i += block_size)
+		{
+			std::size_t valid = a_positions.Count() - i < block_size ? a_positions.Count() - i : block_size;
+
+			Simd::Float8 position[3] = { Simd::Load8(a_positions.X() + i), Simd::Load8(a_positions.Y() + i), Simd::Load8(a_positions.Z() + i) };
+			StorePartial(a_out + i, Evaluate(a_settings, position), valid);
+		}
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, float* a_out)
+	{
+		FillRows(a_settings, a_grid, 0, a_grid.RowCount(), a_out);
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, float* a_out)
+	{
+		FillRows(a_settings, a_grid, 0, a_grid.RowCount(), a_out);
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, float* a_out)
+	{
+		FillRows(a_settings, a_grid, 0, a_grid.RowCount(), a_out);
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, float* a_out, WorkerPool& a_pool)
+	{
+		FillRowsParallel(a_settings, a_grid, a_out, a_pool);
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, float* a_out, WorkerPool& a_pool)
+	{
+		FillRowsParallel(a_settings, a_grid, a_out, a_pool);
+	}
+
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, float* a_out, WorkerPool& a_pool)
+	{
+		FillRowsParallel(a_settings, a_grid, a_out, a_pool);
+	}
+
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out)
+	{
+		FillRows(a_settings, a_grid, a_firstRow, a_rowCount, a_out);
+	}
+
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out)
+	{
+		FillRows(a_settings, a_grid, a_firstRow, a_rowCount, a_out);
+	}
+
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out)
+	{
+		FillRows(a_settings, a_grid, a_firstRow, a_rowCount, a_out);
+	}
+}
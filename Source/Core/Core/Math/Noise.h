@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Vector.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	class WorkerPool;
+
+	enum class NoiseType
+	{
+		/// Random values at the integer lattice, smoothly interpolated. Blocky, but the cheapest
+		Value,
+		/// Gradient noise on the integer lattice (Perlin, "Improving Noise")
+		Perlin,
+		/// Gradient noise on a simplex lattice, fewer corners per sample and fewer axis aligned artifacts than Perlin
+		Simplex,
+		/// Distance to the nearest of one random feature point per cell (Worley), for cells, stones and caustics
+		Worley,
+	};
+
+	enum class NoiseFractal
+	{
+		None,
+		/// Fractal Brownian motion, octaves of the noise summed at rising frequency and falling amplitude
+		Fbm,
+		/// Like Fbm, but each octave folded to 1 - 2 * |noise|, which makes sharp ridges along its zero crossings
+		Ridged,
+	};
+
+	/**
+	 * \brief Selects one noise field, the same settings always give the same values
+	 * \remarks Every type and fractal returns values roughly in [-1, 1]. Values are the same on every SIMD backend,
+	 *          up to the last bits where a build contracts multiplies and adds to FMA.
+	 */
+	struct NoiseSettings
+	{
+		NoiseType    type    = NoiseType::Simplex;
+		NoiseFractal fractal = NoiseFractal::None;
+
+		int32 seed = 1337;
+
+		/// Scales the input positions, features of the first octave are about 1 / frequency apart
+		float frequency = 1.0f;
+
+		/// Number of layers summed by the fractals, each layer is lacunarity times the frequency and gain times the
+		/// amplitude of the one before
+		int32 octaves    = 4;
+		float lacunarity = 2.0f;
+		float gain       = 0.5f;
+	};
+
+	/**
+	 * \brief An axis aligned grid of sample positions, origin + index * step along each axis
+	 * \remarks Samples are laid out with x varying fastest, then y and so on. A row is a line of size.x samples
+	 *          along x, rows are the unit FillGridRows splits the work by.
+	 */
+	template<int Dimensions>
+	struct NoiseGrid_t
+	{
+		Vector_t<Dimensions, float>        origin;
+		Vector_t<Dimensions, float>        step;
+		Vector_t<Dimensions, unsigned int> size;
+
+		/// \return The number of lines along x
+		constexpr
+		std::size_t
+		RowCount() const
+		{
+			std::size_t result = 1;
+			for (int i = 1; i < Dimensions; i++)
+			{
+				result *= size.data[i];
+			}
+			return result;
+		}
+
+		constexpr std::size_t Count() const { return RowCount() * size.data[0]; }
+	};
+
+	typedef NoiseGrid_t<2> NoiseGrid2;
+	typedef NoiseGrid_t<3> NoiseGrid3;
+	typedef NoiseGrid_t<4> NoiseGrid4;
+}
+
+namespace Oyl::Noise
+{
+	// Every function evaluates eight samples per iteration, the single sample overloads run the same kernel on one
+	// lane and return the exact value a batch would. Prefer the batches wherever there is more than a handful.
+	// Coordinates times frequency need to stay within the int32 range.
+
+	OYL_CORE_API
+	extern
+	float
+	Sample(NoiseSettings const& a_settings, Vector2 const& a_position);
+
+	OYL_CORE_API
+	extern
+	float
+	Sample(NoiseSettings const& a_settings, Vector3 const& a_position);
+
+	OYL_CORE_API
+	extern
+	float
+	Sample(NoiseSettings const& a_settings, Vector4 const& a_position);
+
+	/// \brief a_out[i] = Noise::Sample(a_settings, a_positions[i])
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector2 const* a_positions, float* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Noise::Sample(a_settings, a_positions[i])
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector3 const* a_positions, float* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Noise::Sample(a_settings, a_positions[i])
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector4 const* a_positions, float* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Noise::Sample(a_settings, a_positions[i]), a_out needs room for a_positions.Count() values
+	OYL_CORE_API
+	extern
+	void
+	SampleBatch(NoiseSettings const& a_settings, Vector3Stream const& a_positions, float* a_out);
+
+	/// \brief Fills a_out with a_grid.Count() samples, see NoiseGrid_t for the layout
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, float* a_out);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, float* a_out);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, float* a_out);
+
+	/// \brief FillGrid with the rows split between the threads of a_pool, with the same result
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, float* a_out, WorkerPool& a_pool);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, float* a_out, WorkerPool& a_pool);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGrid(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, float* a_out, WorkerPool& a_pool);
+
+	/**
+	 * \brief Fills rows [a_firstRow, a_firstRow + a_rowCount) of a_grid, a_out points at the first of them
+	 * \remarks Samples only depend on their position, so a large grid can be split into row ranges filled by
+	 *          different worker threads into disjoint parts of the same buffer, with the same result as FillGrid.
+	 *          This is what the WorkerPool overloads do, other job systems can split the rows the same way.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid2 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid3 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out);
+
+	OYL_CORE_API
+	extern
+	void
+	FillGridRows(NoiseSettings const& a_settings, NoiseGrid4 const& a_grid, std::size_t a_firstRow, std::size_t a_rowCount, float* a_out);
+}
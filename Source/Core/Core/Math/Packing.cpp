@@ -0,0 +1,411 @@
+#include "pch.h"
+#include "Packing.h"
+
+#include "Simd.h"
+
+namespace Oyl::Packing
+{
+	namespace
+	{
+		constexpr std::size_t block_size = 4;
+
+		/// \return The lanes of a_ifTrue where a_mask is set, a_ifFalse elsewhere, with an integer mask
+		OYL_FORCE_INLINE
+		Simd::Float4
+		Select(Simd::Int4 a_mask, Simd::Float4 a_ifTrue, Simd::Float4 a_ifFalse)
+		{
+			return Simd::Select(Simd::BitCastToFloat(a_mask), a_ifTrue, a_ifFalse);
+		}
+
+		/// Same steps as Detail::FloatToHalfBits, with each branch computed for every lane and selected at the end
+		OYL_FORCE_INLINE
+		Simd::Int4
+		FloatToHalfBits(Simd::Float4 a_value)
+		{
+			Simd::Int4 const half_overflow   = Simd::SplatInt((127 + 16) << 23);
+			Simd::Int4 const half_min_normal = Simd::SplatInt(113 << 23);
+			Simd::Int4 const denormal_magic  = Simd::SplatInt(((127 - 15) + (23 - 10) + 1) << 23);
+
+			Simd::Int4 bits = Simd::BitCastToInt(a_value);
+			Simd::Int4 sign = Simd::And(bits, Simd::SplatInt(static_cast<std::int32_t>(0x80000000u)));
+			bits = Simd::Xor(bits, sign);
+
+			// With the sign cleared the bits order like the magnitudes, so signed compares are fine
+			Simd::Int4 isOverflow = Simd::Greater(bits, Simd::Sub(half_overflow, Simd::SplatInt(1)));
+			Simd::Int4 isNan      = Simd::Greater(bits, Simd::SplatInt(255 << 23));
+			Simd::Int4 overflow   = Simd::Select(isNan, Simd::SplatInt(0x7E00), Simd::SplatInt(0x7C00));
+
+			Simd::Int4 isDenormal = Simd::Less(bits, half_min_normal);
+			Simd::Int4 denormal   = Simd::Sub(
+				Simd::BitCastToInt(Simd::Add(Simd::BitCastToFloat(bits), Simd::BitCastToFloat(denormal_magic))),
+				denormal_magic
+			);
+
+			Simd::Int4 mantissaOdd = Simd::And(Simd::ShiftRightLogical<13>(bits), Simd::SplatInt(1));
+			Simd::Int4 normal      = Simd::Add(bits, Simd::SplatInt(-((127 - 15) << 23) + 0xFFF));
+			normal = Simd::ShiftRightLogical<13>(Simd::Add(normal, mantissaOdd));
+
+			Simd::Int4 result = Simd::Select(isOverflow, overflow, Simd::Select(isDenormal, denormal, normal));
+			return Simd::Or(result, Simd::ShiftRightLogical<16>(sign));
+		}
+
+		/// Same steps as Detail::HalfBitsToFloat
+		OYL_FORCE_INLINE
+		Simd::Float4
+		HalfBitsToFloat(Simd::Int4 a_bits)
+		{
+			Simd::Int4 const shifted_exponent = Simd::SplatInt(0x7C00 << 13);
+
+			Simd::Int4 bits     = Simd::ShiftLeft<13>(Simd::And(a_bits, Simd::SplatInt(0x7FFF)));
+			Simd::Int4 exponent = Simd::And(bits, shifted_exponent);
+			bits = Simd::Add(bits, Simd::SplatInt((127 - 15) << 23));
+
+			Simd::Int4 infinityOrNan = Simd::Add(bits, Simd::SplatInt((128 - 16) << 23));
+			Simd::Int4 denormal      = Simd::BitCastToInt(Simd::Sub(
+				Simd::BitCastToFloat(Simd::Add(bits, Simd::SplatInt(1 << 23))),
+				Simd::BitCastToFloat(Simd::SplatInt(113 << 23))
+			));
+
+			bits = Simd::Select(Simd::Equal(exponent, shifted_exponent), infinityOrNan, bits);
+			bits = Simd::Select(Simd::Equal(exponent, Simd::SplatInt(0)), denormal, bits);
+
+			Simd::Int4 sign = Simd::ShiftLeft<16>(Simd::And(a_bits, Simd::SplatInt(0x8000)));
+			return Simd::BitCastToFloat(Simd::Or(bits, sign));
+		}
+
+		/// Same steps as the single value EncodeOctahedral, for four unit vectors in SoA form
+		OYL_FORCE_INLINE
+		void
+		EncodeOctahedralBlock(Simd::Float4 a_x, Simd::Float4 a_y, Simd::Float4 a_z, Simd::Float4& a_outX, Simd::Float4& a_outY)
+		{
+			Simd::Float4 zero   = Simd::Zero();
+			Simd::Float4 length = Simd::Add(Simd::Add(Simd::Abs(a_x), Simd::Abs(a_y)), Simd::Abs(a_z));
+			Simd::Float4 isZero = Simd::Equal(length, zero);
+
+			Simd::Float4 x = Simd::Select(isZero, zero, Simd::Div(a_x, length));
+			Simd::Float4 y = Simd::Select(isZero, zero, Simd::Div(a_y, length));
+
+			Simd::Float4 one     = Simd::Splat(1.0f);
+			Simd::Float4 foldedX = Simd::FlipSign(Simd::Sub(one, Simd::Abs(y)), x);
+			Simd::Float4 foldedY = Simd::FlipSign(Simd::Sub(one, Simd::Abs(x)), y);
+
+			Simd::Float4 isLower = Simd::Less(a_z, zero);
+			a_outX = Simd::Select(isLower, foldedX, x);
+			a_outY = Simd::Select(isLower, foldedY, y);
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Int4
+		PackSnorm16(Simd::Float4 a_value)
+		{
+			// NaN lanes become 0 like Detail::PackSnorm16, Min and Max would pass them on as either bound
+			Simd::Int4   magnitude = Simd::And(Simd::BitCastToInt(a_value), Simd::SplatInt(0x7FFFFFFF));
+			Simd::Int4   isNan     = Simd::Greater(magnitude, Simd::SplatInt(255 << 23));
+			Simd::Float4 clamped   = Simd::Min(Simd::Max(a_value, Simd::Splat(-1.0f)), Simd::Splat(1.0f));
+			clamped = Select(isNan, Simd::Zero(), clamped);
+			return Simd::ConvertToInt(Simd::Mul(clamped, Simd::Splat(Detail::snorm16_scale)));
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float4
+		UnpackSnorm16(Simd::Int4 a_value)
+		{
+			Simd::Float4 value = Simd::Mul(Simd::ConvertToFloat(a_value), Simd::Splat(1.0f / Detail::snorm16_scale));
+			return Simd::Max(value, Simd::Splat(-1.0f));
+		}
+
+		/// Maps a smallest three component from [-1/sqrt(2), 1/sqrt(2)] to [0, 1023]
+		OYL_FORCE_INLINE
+		Simd::Int4
+		QuantizeQuaternion(Simd::Float4 a_value)
+		{
+			Simd::Float4 unit = Simd::Add(Simd::Mul(a_value, Simd::Splat(0.5f / Detail::quaternion_max)), Simd::Splat(0.5f));
+			unit = Simd::Min(Simd::Max(unit, Simd::Zero()), Simd::Splat(1.0f));
+			return Simd::ConvertToInt(Simd::Mul(unit, Simd::Splat(Detail::quaternion_bits)));
+		}
+
+		OYL_FORCE_INLINE
+		Simd::Float4
+		DequantizeQuaternion(Simd::Int4 a_bits)
+		{
+			Simd::Float4 unit = Simd::Mul(Simd::ConvertToFloat(Simd::And(a_bits, Simd::SplatInt(0x3FF))), Simd::Splat(1.0f / Detail::quaternion_bits));
+			return Simd::Mul(Simd::Sub(Simd::Mul(unit, Simd::Splat(2.0f)), Simd::Splat(1.0f)), Simd::Splat(Detail::quaternion_max));
+		}
+	}
+
+	void
+	EncodeHalf(float const* a_src, half* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+
+	#if OYL_SIMD_F16C
+		for (; i + 8 <= a_count; i += 8)
+		{
+			__m128i bits = _mm256_cvtps_ph(_mm256_loadu_ps(a_src + i), _MM_FROUND_TO_NEAREST_INT);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(a_dst + i), bits);
+		}
+	#endif
+
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Store(&a_dst[i].bits, FloatToHalfBits(Simd::Load(a_src + i)));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = half(a_src[i]);
+		}
+	}
+
+	void
+	DecodeHalf(half const* a_src, float* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+
+	#if OYL_SIMD_F16C
+		for (; i + 8 <= a_count; i += 8)
+		{
+			__m128i bits = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a_src + i));
+			_mm256_storeu_ps(a_dst + i, _mm256_cvtph_ps(bits));
+		}
+	#endif
+
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Store(a_dst + i, HalfBitsToFloat(Simd::LoadUint16(&a_src[i].bits)));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = a_src[i];
+		}
+	}
+
+	void
+	PackSnorm16(float const* a_src, int16* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Store(a_dst + i, PackSnorm16(Simd::Load(a_src + i)));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = Detail::PackSnorm16(a_src[i]);
+		}
+	}
+
+	void
+	UnpackSnorm16(int16 const* a_src, float* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Store(a_dst + i, UnpackSnorm16(Simd::LoadInt16(a_src + i)));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = Detail::UnpackSnorm16(a_src[i]);
+		}
+	}
+
+	void
+	PackUnorm8(float const* a_src, uint8* a_dst, std::size_t a_count)
+	{
+		Simd::Float4 scale = Simd::Splat(Detail::unorm8_scale);
+
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Float4 clamped = Simd::Min(Simd::Max(Simd::Load(a_src + i), Simd::Zero()), Simd::Splat(1.0f));
+			Simd::Store(a_dst + i, Simd::ConvertToInt(Simd::Mul(clamped, scale)));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = Detail::PackUnorm8(a_src[i]);
+		}
+	}
+
+	void
+	UnpackUnorm8(uint8 const* a_src, float* a_dst, std::size_t a_count)
+	{
+		Simd::Float4 scale = Simd::Splat(1.0f / Detail::unorm8_scale);
+
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Store(a_dst + i, Simd::Mul(Simd::ConvertToFloat(Simd::LoadUint8(a_src + i)), scale));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = Detail::UnpackUnorm8(a_src[i]);
+		}
+	}
+
+	void
+	EncodeOctahedral(Vector3 const* a_src, Snorm16x2* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Float4 x = Simd::Load3(a_src[i + 0].data);
+			Simd::Float4 y = Simd::Load3(a_src[i + 1].data);
+			Simd::Float4 z = Simd::Load3(a_src[i + 2].data);
+			Simd::Float4 w = Simd::Load3(a_src[i + 3].data);
+			Simd::Transpose(x, y, z, w);
+
+			Simd::Float4 encodedX, encodedY;
+			EncodeOctahedralBlock(x, y, z, encodedX, encodedY);
+
+			// Interleave back into (x0, y0, x1, y1), (x2, y2, x3, y3)
+			Simd::Float4 lo = Simd::Shuffle<0, 2, 1, 3>(Simd::Shuffle2<0, 1, 0, 1>(encodedX, encodedY));
+			Simd::Float4 hi = Simd::Shuffle<0, 2, 1, 3>(Simd::Shuffle2<2, 3, 2, 3>(encodedX, encodedY));
+
+			Simd::Store(a_dst[i + 0].data, PackSnorm16(lo));
+			Simd::Store(a_dst[i + 2].data, PackSnorm16(hi));
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = EncodeOctahedral(a_src[i]);
+		}
+	}
+
+	void
+	DecodeOctahedral(Snorm16x2 const* a_src, Vector3* a_dst, std::size_t a_count)
+	{
+		static_assert(sizeof(Snorm16x2) == sizeof(int16) * 2);
+
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Float4 lo = UnpackSnorm16(Simd::LoadInt16(a_src[i + 0].data));
+			Simd::Float4 hi = UnpackSnorm16(Simd::LoadInt16(a_src[i + 2].data));
+
+			Simd::Float4 x = Simd::Shuffle2<0, 2, 0, 2>(lo, hi);
+			Simd::Float4 y = Simd::Shuffle2<1, 3, 1, 3>(lo, hi);
+			Simd::Float4 z = Simd::Sub(Simd::Sub(Simd::Splat(1.0f), Simd::Abs(x)), Simd::Abs(y));
+
+			// Unfold the lower hemisphere, moving x and y towards zero by the depth below the equator
+			Simd::Float4 zero = Simd::Zero();
+			Simd::Float4 fold = Simd::Max(Simd::Sub(zero, z), zero);
+			x = Simd::Add(x, Simd::Select(Simd::Less(x, zero), fold, Simd::Sub(zero, fold)));
+			y = Simd::Add(y, Simd::Select(Simd::Less(y, zero), fold, Simd::Sub(zero, fold)));
+
+			// |x| + |y| + |z| == 1 so the length is never zero
+			Simd::Float4 magnitude = Simd::Sqrt(Simd::Add(Simd::Add(Simd::Mul(x, x), Simd::Mul(y, y)), Simd::Mul(z, z)));
+			x = Simd::Div(x, magnitude);
+			y = Simd::Div(y, magnitude);
+			z = Simd::Div(z, magnitude);
+
+			Simd::Float4 w = zero;
+			Simd::Transpose(x, y, z, w);
+			Simd::Store3(a_dst[i + 0].data, x);
+			Simd::Store3(a_dst[i + 1].data, y);
+			Simd::Store3(a_dst[i + 2].data, z);
+			Simd::Store3(a_dst[i + 3].data, w);
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = DecodeOctahedral(a_src[i]);
+		}
+	}
+
+	void
+	PackQuaternion(Quaternionf const* a_src, PackedQuaternion* a_dst, std::size_t a_count)
+	{
+		static_assert(sizeof(PackedQuaternion) == sizeof(std::int32_t));
+
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Float4 x = Simd::Load(a_src[i + 0].data);
+			Simd::Float4 y = Simd::Load(a_src[i + 1].data);
+			Simd::Float4 z = Simd::Load(a_src[i + 2].data);
+			Simd::Float4 w = Simd::Load(a_src[i + 3].data);
+			Simd::Transpose(x, y, z, w);
+
+			// First component with the largest magnitude, searching backwards so earlier lanes win ties
+			Simd::Float4 absX = Simd::Abs(x), absY = Simd::Abs(y), absZ = Simd::Abs(z), absW = Simd::Abs(w);
+			Simd::Float4 largest = Simd::Max(Simd::Max(absX, absY), Simd::Max(absZ, absW));
+
+			Simd::Int4   index = Simd::SplatInt(3);
+			Simd::Float4 value = w;
+			index = Simd::Select(Simd::BitCastToInt(Simd::Equal(absZ, largest)), Simd::SplatInt(2), index);
+			value = Simd::Select(Simd::Equal(absZ, largest), z, value);
+			index = Simd::Select(Simd::BitCastToInt(Simd::Equal(absY, largest)), Simd::SplatInt(1), index);
+			value = Simd::Select(Simd::Equal(absY, largest), y, value);
+			index = Simd::Select(Simd::BitCastToInt(Simd::Equal(absX, largest)), Simd::SplatInt(0), index);
+			value = Simd::Select(Simd::Equal(absX, largest), x, value);
+
+			Simd::Float4 sign = Simd::Select(Simd::Less(value, Simd::Zero()), Simd::Splat(-1.0f), Simd::Splat(1.0f));
+			x = Simd::Mul(x, sign);
+			y = Simd::Mul(y, sign);
+			z = Simd::Mul(z, sign);
+			w = Simd::Mul(w, sign);
+
+			// The remaining three components in order
+			Simd::Int4 isX = Simd::Equal(index, Simd::SplatInt(0));
+			Simd::Int4 isW = Simd::Equal(index, Simd::SplatInt(3));
+			Simd::Float4 a = Select(isX, y, x);
+			Simd::Float4 b = Select(Simd::Less(index, Simd::SplatInt(2)), z, y);
+			Simd::Float4 c = Select(isW, z, w);
+
+			Simd::Int4 bits = Simd::ShiftLeft<30>(index);
+			bits = Simd::Or(bits, Simd::ShiftLeft<20>(QuantizeQuaternion(a)));
+			bits = Simd::Or(bits, Simd::ShiftLeft<10>(QuantizeQuaternion(b)));
+			bits = Simd::Or(bits, QuantizeQuaternion(c));
+
+			Simd::Store(reinterpret_cast<std::int32_t*>(a_dst + i), bits);
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = PackQuaternion(a_src[i]);
+		}
+	}
+
+	void
+	UnpackQuaternion(PackedQuaternion const* a_src, Quaternionf* a_dst, std::size_t a_count)
+	{
+		std::size_t i = 0;
+		for (; i + block_size <= a_count; i += block_size)
+		{
+			Simd::Int4 bits  = Simd::LoadInt(reinterpret_cast<std::int32_t const*>(a_src + i));
+			Simd::Int4 index = Simd::ShiftRightLogical<30>(bits);
+
+			Simd::Float4 a = DequantizeQuaternion(Simd::ShiftRightLogical<20>(bits));
+			Simd::Float4 b = DequantizeQuaternion(Simd::ShiftRightLogical<10>(bits));
+			Simd::Float4 c = DequantizeQuaternion(bits);
+
+			Simd::Float4 sumSquares = Simd::Add(Simd::Add(Simd::Mul(a, a), Simd::Mul(b, b)), Simd::Mul(c, c));
+			Simd::Float4 largest    = Simd::Sqrt(Simd::Max(Simd::Sub(Simd::Splat(1.0f), sumSquares), Simd::Zero()));
+
+			Simd::Int4 isX = Simd::Equal(index, Simd::SplatInt(0));
+			Simd::Int4 isY = Simd::Equal(index, Simd::SplatInt(1));
+			Simd::Int4 isZ = Simd::Equal(index, Simd::SplatInt(2));
+			Simd::Int4 isW = Simd::Equal(index, Simd::SplatInt(3));
+
+			Simd::Float4 x = Select(isX, largest, a);
+			Simd::Float4 y = Select(isX, a, Select(isY, largest, b));
+			Simd::Float4 z = Select(isW, c, Select(isZ, largest, b));
+			Simd::Float4 w = Select(isW, largest, c);
+
+			Simd::Transpose(x, y, z, w);
+			Simd::Store(a_dst[i + 0].data, x);
+			Simd::Store(a_dst[i + 1].data, y);
+			Simd::Store(a_dst[i + 2].data, z);
+			Simd::Store(a_dst[i + 3].data, w);
+		}
+
+		for (; i < a_count; i++)
+		{
+			a_dst[i] = UnpackQuaternion(a_src[i]);
+		}
+	}
+}
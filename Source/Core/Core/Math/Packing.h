@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "Half.h"
+#include "Quaternion.h"
+#include "Vector.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/// Components in [-1, 1] stored as 16 bit signed integers, the absolute error is at most 1 / 65534 (1.5e-5)
+	template<int Size>
+	struct Snorm16_t
+	{
+		int16 data[Size];
+	};
+
+	typedef Snorm16_t<2> Snorm16x2;
+	typedef Snorm16_t<3> Snorm16x3;
+	typedef Snorm16_t<4> Snorm16x4;
+	static_assert(sizeof(Snorm16x3) == sizeof(int16) * 3);
+
+	/// Components in [0, 1] stored as 8 bit unsigned integers, the absolute error is at most 1 / 510 (2e-3)
+	template<int Size>
+	struct Unorm8_t
+	{
+		uint8 data[Size];
+	};
+
+	typedef Unorm8_t<2> Unorm8x2;
+	typedef Unorm8_t<3> Unorm8x3;
+	typedef Unorm8_t<4> Unorm8x4;
+	static_assert(sizeof(Unorm8x3) == sizeof(uint8) * 3);
+
+	/**
+	 * \brief A unit quaternion in 32 bits with "smallest three" encoding
+	 * \remarks The largest component is dropped and rebuilt from the unit length constraint, its index takes the
+	 *          top 2 bits. The other three lie in [-1/sqrt(2), 1/sqrt(2)] and get 10 bits each.
+	 *      <br>Each component is within 2e-3 of the original, which is a rotation error below 0.25 degrees.
+	 */
+	struct PackedQuaternion
+	{
+		uint32 bits;
+	};
+}
+
+namespace Oyl::Packing
+{
+	namespace Detail
+	{
+		constexpr float snorm16_scale   = 32767.0f;
+		constexpr float unorm8_scale    = 255.0f;
+		constexpr float quaternion_max  = 0.707106781186547524f;
+		constexpr float quaternion_bits = 1023.0f;
+
+		inline float Clamp(float a_value, float a_min, float a_max) { return a_value < a_min ? a_min : a_value > a_max ? a_max : a_value; }
+
+		/// Rounds half to even like the SIMD conversions, as long as the FPU is in its default rounding mode
+		inline int32 Round(float a_value) { return static_cast<int32>(std::nearbyint(a_value)); }
+
+		/// \brief NaN becomes 0, tested on the bits since fast math may fold away a compare of a_value with itself
+		inline
+		int16
+		PackSnorm16(float a_value)
+		{
+			if ((Oyl::Detail::FloatBits(a_value) & 0x7FFFFFFFu) > (255u << 23))
+			{
+				return 0;
+			}
+			return static_cast<int16>(Round(Clamp(a_value, -1.0f, 1.0f) * snorm16_scale));
+		}
+
+		inline
+		float
+		UnpackSnorm16(int16 a_value)
+		{
+			// -32768 is the only value below -1, clamp it so both ends are symmetric
+			float value = static_cast<float>(a_value) * (1.0f / snorm16_scale);
+			return value < -1.0f ? -1.0f : value;
+		}
+
+		inline uint8 PackUnorm8(float a_value) { return static_cast<uint8>(Round(Clamp(a_value, 0.0f, 1.0f) * unorm8_scale)); }
+
+		inline float UnpackUnorm8(uint8 a_value) { return static_cast<float>(a_value) * (1.0f / unorm8_scale); }
+	}
+
+#pragma region Single Values
+	template<int Size>
+	Snorm16_t<Size>
+	PackSnorm16(Vector_t<Size, float> const& a_value)
+	{
+		Snorm16_t<Size> result;
+		for (int i = 0; i < Size; i++)
+		{
+			result.data[i] = Detail::PackSnorm16(a_value.data[i]);
+		}
+		return result;
+	}
+
+	template<int Size>
+	Vector_t<Size, float>
+	UnpackSnorm16(Snorm16_t<Size> const& a_value)
+	{
+		Vector_t<Size, float> result;
+		for (int i = 0; i < Size; i++)
+		{
+			result.data[i] = Detail::UnpackSnorm16(a_value.data[i]);
+		}
+		return result;
+	}
+
+	template<int Size>
+	Unorm8_t<Size>
+	PackUnorm8(Vector_t<Size, float> const& a_value)
+	{
+		Unorm8_t<Size> result;
+		for (int i = 0; i < Size; i++)
+		{
+			result.data[i] = Detail::PackUnorm8(a_value.data[i]);
+		}
+		return result;
+	}
+
+	template<int Size>
+	Vector_t<Size, float>
+	UnpackUnorm8(Unorm8_t<Size> const& a_value)
+	{
+		Vector_t<Size, float> result;
+		for (int i = 0; i < Size; i++)
+		{
+			result.data[i] = Detail::UnpackUnorm8(a_value.data[i]);
+		}
+		return result;
+	}
+
+	/**
+	 * \brief Octahedral encoding of a unit vector into two snorm16 values (Cigolle et al., "A Survey of Efficient
+	 *        Representations for Independent Unit Vectors")
+	 * \remarks The angle between a decoded vector and the original is at most 0.004 degrees.
+	 *          A zero vector encodes to (0, 0), which decodes to (0, 0, 1).
+	 */
+	inline
+	Snorm16x2
+	EncodeOctahedral(Vector3 const& a_normal)
+	{
+		float length = std::abs(a_normal.x) + std::abs(a_normal.y) + std::abs(a_normal.z);
+		float x = length == 0 ? 0 : a_normal.x / length;
+		float y = length == 0 ? 0 : a_normal.y / length;
+
+		// Fold the lower hemisphere over the diagonals
+		if (a_normal.z < 0)
+		{
+			float foldedX = (1.0f - std::abs(y)) * std::copysign(1.0f, x);
+			float foldedY = (1.0f - std::abs(x)) * std::copysign(1.0f, y);
+			x = foldedX;
+			y = foldedY;
+		}
+
+		return PackSnorm16(Vector2(x, y));
+	}
+
+	inline
+	Vector3
+	DecodeOctahedral(Snorm16x2 const& a_value)
+	{
+		Vector2 packed = UnpackSnorm16(a_value);
+
+		Vector3 result(packed.x, packed.y, 1.0f - std::abs(packed.x) - std::abs(packed.y));
+
+		float fold = std::max(-result.z, 0.0f);
+		result.x += result.x >= 0 ? -fold : fold;
+		result.y += result.y >= 0 ? -fold : fold;
+
+		return Vector::Normalize(result);
+	}
+
+	inline
+	PackedQuaternion
+	PackQuaternion(Quaternionf const& a_rotation)
+	{
+		int largest = 0;
+		for (int i = 1; i < 4; i++)
+		{
+			if (std::abs(a_rotation.data[i]) > std::abs(a_rotation.data[largest]))
+			{
+				largest = i;
+			}
+		}
+
+		// q and -q are the same rotation, pick the one with a positive largest component so its sign is implied
+		float sign = a_rotation.data[largest] < 0 ? -1.0f : 1.0f;
+
+		uint32 bits  = static_cast<uint32>(largest) << 30;
+		int    shift = 20;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+
+			float value = a_rotation.data[i] * sign;
+			float unit  = Detail::Clamp(value * (0.5f / Detail::quaternion_max) + 0.5f, 0.0f, 1.0f);
+			bits |= static_cast<uint32>(Detail::Round(unit * Detail::quaternion_bits)) << shift;
+			shift -= 10;
+		}
+
+		return PackedQuaternion { bits };
+	}
+
+	inline
+	Quaternionf
+	UnpackQuaternion(PackedQuaternion const& a_value)
+	{
+		int largest = static_cast<int>(a_value.bits >> 30);
+
+		Quaternionf result;
+		float       sumSquares = 0;
+		int         shift      = 20;
+		for (int i = 0; i < 4; i++)
+		{
+			if (i == largest)
+			{
+				continue;
+			}
+
+			float unit = static_cast<float>((a_value.bits >> shift) & 0x3FF) * (1.0f / Detail::quaternion_bits);
+			result.data[i] = (unit * 2.0f - 1.0f) * Detail::quaternion_max;
+			sumSquares += result.data[i] * result.data[i];
+			shift -= 10;
+		}
+
+		result.data[largest] = std::sqrt(std::max(1.0f - sumSquares, 0.0f));
+		return result;
+	}
+#pragma endregion
+#pragma region Batched Conversions
+	// Bulk encode and decode, 4 or 8 values per iteration. Encoded bits are identical to the single value functions,
+	// decoded octahedral normals can differ in the last bit since they are normalized differently.
+	// Counts are in elements, ie. scalars for the float array overloads and vectors or quaternions otherwise.
+
+	/// \brief Uses F16C when it's available, otherwise integer SIMD with the same rounding as half's constructor
+	/// \remark F16C keeps NaN payloads where the software path always produces 0x7E00, either way NaN stays NaN
+	OYL_CORE_API
+	extern
+	void
+	EncodeHalf(float const* a_src, half* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	DecodeHalf(half const* a_src, float* a_dst, std::size_t a_count);
+
+	/// \remark Values are clamped to [-1, 1] and NaN encodes as 0, like the single value overload
+	OYL_CORE_API
+	extern
+	void
+	PackSnorm16(float const* a_src, int16* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	UnpackSnorm16(int16 const* a_src, float* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	PackUnorm8(float const* a_src, uint8* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	UnpackUnorm8(uint8 const* a_src, float* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	EncodeOctahedral(Vector3 const* a_src, Snorm16x2* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	DecodeOctahedral(Snorm16x2 const* a_src, Vector3* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	PackQuaternion(Quaternionf const* a_src, PackedQuaternion* a_dst, std::size_t a_count);
+
+	OYL_CORE_API
+	extern
+	void
+	UnpackQuaternion(PackedQuaternion const* a_src, Quaternionf* a_dst, std::size_t a_count);
+
+	// Typed wrappers for arrays of vectors, which are tightly packed arrays of their components
+
+	template<int Size>
+	void
+	EncodeHalf(Vector_t<Size, float> const* a_src, Vector_t<Size, half>* a_dst, std::size_t a_count)
+	{
+		static_assert(sizeof(Vector_t<Size, float>) == sizeof(float) * Size, "Padded vectors can't be encoded in bulk");
+		EncodeHalf(a_src->data, a_dst->data, a_count * Size);
+	}
+
+	template<int Size>
+	void
+	DecodeHalf(Vector_t<Size, half> const* a_src, Vector_t<Size, float>* a_dst, std::size_t a_count)
+	{
+		static_assert(sizeof(Vector_t<Size, float>) == sizeof(float) * Size, "Padded vectors can't be decoded in bulk");
+		DecodeHalf(a_src->data, a_dst->data, a_count * Size);
+	}
+
+	template<int Size>
+	void
+	PackSnorm16(Vector_t<Size, float> const* a_src, Snorm16_t<Size>* a_dst, std::size_t a_count)
+	{
+		PackSnorm16(a_src->data, a_dst->data, a_count * Size);
+	}
+
+	template<int Size>
+	void
+	UnpackSnorm16(Snorm16_t<Size> const* a_src, Vector_t<Size, float>* a_dst, std::size_t a_count)
+	{
+		UnpackSnorm16(a_src->data, a_dst->data, a_count * Size);
+	}
+
+	template<int Size>
+	void
+	PackUnorm8(Vector_t<Size, float> const* a_src, Unorm8_t<Size>* a_dst, std::size_t a_count)
+	{
+		PackUnorm8(a_src->data, a_dst->data, a_count * Size);
+	}
+
+	template<int Size>
+	void
+	UnpackUnorm8(Unorm8_t<Size> const* a_src, Vector_t<Size, float>* a_dst, std::size_t a_count)
+	{
+		UnpackUnorm8(a_src->data, a_dst->data, a_count * Size);
+	}
+#pragma endregion
+}
@@ -0,0 +1,285 @@
+#include "pch.h"
+#include "Quaternion.h"
+
+#include "Simd.h"
+
+namespace Oyl::Quaternion
+{
+	namespace
+	{
+		constexpr std::size_t block_size = 4;
+
+		/// Four quaternions in SoA form, lane i of each register belongs to the i-th quaternion
+		struct QuaternionBlock
+		{
+			Simd::Float4 x, y, z, w;
+		};
+
+		QuaternionBlock
+		LoadBlock(Quaternionf const* a_src, std::size_t a_lanes)
+		{
+			Simd::Float4 rows[block_size];
+			for (std::size_t i = 0; i < block_size; i++)
+			{
+				// Pad partial blocks with identity so the padding lanes stay well defined
+				rows[i] = i < a_lanes ? Simd::Load(a_src[i].data) : Simd::Set(0, 0, 0, 1);
+			}
+			Simd::Transpose(rows[0], rows[1], rows[2], rows[3]);
+			return QuaternionBlock { rows[0], rows[1], rows[2], rows[3] };
+		}
+
+		void
+		StoreBlock(Quaternionf* a_dst, QuaternionBlock a_block, std::size_t a_lanes)
+		{
+			Simd::Transpose(a_block.x, a_block.y, a_block.z, a_block.w);
+			Simd::Float4 rows[block_size] = { a_block.x, a_block.y, a_block.z, a_block.w };
+			for (std::size_t i = 0; i < a_lanes; i++)
+			{
+				Simd::Store(a_dst[i].data, rows[i]);
+			}
+		}
+
+		Simd::Float4
+		LoadScalars(float const* a_src, std::size_t a_lanes)
+		{
+			if (a_lanes == block_size)
+			{
+				return Simd::Load(a_src);
+			}
+
+			float padded[block_size] = { 0 };
+			for (std::size_t i = 0; i < a_lanes; i++)
+			{
+				padded[i] = a_src[i];
+			}
+			return Simd::Load(padded);
+		}
+
+		Simd::Float4
+		Dot(QuaternionBlock const& a_lhs, QuaternionBlock const& a_rhs)
+		{
+			Simd::Float4 result = Simd::Mul(a_lhs.x, a_rhs.x);
+			result = Simd::MulAdd(a_lhs.y, a_rhs.y, result);
+			result = Simd::MulAdd(a_lhs.z, a_rhs.z, result);
+			return Simd::MulAdd(a_lhs.w, a_rhs.w, result);
+		}
+
+		/// a_lhs * a_lhsWeight + a_rhs * a_rhsWeight
+		QuaternionBlock
+		Blend(QuaternionBlock const& a_lhs, Simd::Float4 a_lhsWeight, QuaternionBlock const& a_rhs, Simd::Float4 a_rhsWeight)
+		{
+			return QuaternionBlock {
+				Simd::MulAdd(a_rhs.x, a_rhsWeight, Simd::Mul(a_lhs.x, a_lhsWeight)),
+				Simd::MulAdd(a_rhs.y, a_rhsWeight, Simd::Mul(a_lhs.y, a_lhsWeight)),
+				Simd::MulAdd(a_rhs.z, a_rhsWeight, Simd::Mul(a_lhs.z, a_lhsWeight)),
+				Simd::MulAdd(a_rhs.w, a_rhsWeight, Simd::Mul(a_lhs.w, a_lhsWeight)),
+			};
+		}
+
+		QuaternionBlock
+		Multiply(QuaternionBlock const& a_lhs, QuaternionBlock const& a_rhs)
+		{
+			// Matrix order, a_lhs is applied first, see Quaternion_t
+			QuaternionBlock const& l = a_rhs;
+			QuaternionBlock const& r = a_lhs;
+
+			Simd::Float4 x = Simd::Mul(l.w, r.x);
+			x = Simd::MulAdd(l.x, r.w, x);
+			x = Simd::MulAdd(l.y, r.z, x);
+			x = Simd::Sub(x, Simd::Mul(l.z, r.y));
+
+			Simd::Float4 y = Simd::Mul(l.w, r.y);
+			y = Simd::MulAdd(l.y, r.w, y);
+			y = Simd::MulAdd(l.z, r.x, y);
+			y = Simd::Sub(y, Simd::Mul(l.x, r.z));
+
+			Simd::Float4 z = Simd::Mul(l.w, r.z);
+			z = Simd::MulAdd(l.x, r.y, z);
+			z = Simd::MulAdd(l.z, r.w, z);
+			z = Simd::Sub(z, Simd::Mul(l.y, r.x));
+
+			Simd::Float4 w = Simd::Mul(l.w, r.w);
+			w = Simd::Sub(w, Simd::Mul(l.x, r.x));
+			w = Simd::Sub(w, Simd::Mul(l.y, r.y));
+			w = Simd::Sub(w, Simd::Mul(l.z, r.z));
+
+			return QuaternionBlock { x, y, z, w };
+		}
+
+		QuaternionBlock
+		Nlerp(Simd::Float4 a_t, QuaternionBlock const& a_lhs, QuaternionBlock const& a_rhs)
+		{
+			Simd::Float4 lhsWeight = Simd::Sub(Simd::Splat(1), a_t);
+			Simd::Float4 rhsWeight = Simd::FlipSign(a_t, Dot(a_lhs, a_rhs));
+
+			QuaternionBlock result = Blend(a_lhs, lhsWeight, a_rhs, rhsWeight);
+
+			Simd::Float4 magnitude = Simd::Sqrt(Dot(result, result));
+			result.x = Simd::Div(result.x, magnitude);
+			result.y = Simd::Div(result.y, magnitude);
+			result.z = Simd::Div(result.z, magnitude);
+			result.w = Simd::Div(result.w, magnitude);
+			return result;
+		}
+
+		/**
+		 * sin(t * theta) / sin(theta) as a function of t and cos(theta), expanded as the nested series
+		 *     t * (1 + b1 * (1 + b2 * (1 + ... ))), b_i = (t^2 - i^2) / (i * (2i + 1)) * (cos(theta) - 1)
+		 * truncated after 8 terms. The last term is scaled by (1 + mu) to absorb the truncation error,
+		 * mu is picked to minimize the maximum error for cos(theta) in [0, 1].
+		 */
+		Simd::Float4
+		SlerpWeight(Simd::Float4 a_t, Simd::Float4 a_cosThetaMinusOne)
+		{
+			constexpr int   term_count  = 8;
+			constexpr float one_plus_mu = 1.85298109f;
+
+			constexpr float u[term_count] = {
+				1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7),  1.0f / (4 * 9),
+				1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), one_plus_mu / (8 * 17)
+			};
+			constexpr float v[term_count] = {
+				1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+				5.0f / 11, 6.0f / 13, 7.0f / 15, one_plus_mu * 8 / 17
+			};
+
+			Simd::Float4 one     = Simd::Splat(1);
+			Simd::Float4 tSquare = Simd::Mul(a_t, a_t);
+
+			Simd::Float4 result = one;
+			for (int i = term_count - 1; i >= 0; i--)
+			{
+				Simd::Float4 b = Simd::Mul(
+					Simd::Sub(Simd::Mul(Simd::Splat(u[i]), tSquare), Simd::Splat(v[i])),
+					a_cosThetaMinusOne
+				);
+				result = Simd::MulAdd(b, result, one);
+			}
+			return Simd::Mul(a_t, result);
+		}
+
+		QuaternionBlock
+		Slerp(Simd::Float4 a_t, QuaternionBlock const& a_lhs, QuaternionBlock const& a_rhs)
+		{
+			// Take the shortest arc by negating a_rhs where the inputs are in opposite hemispheres
+			Simd::Float4 cosTheta         = Dot(a_lhs, a_rhs);
+			Simd::Float4 cosThetaMinusOne = Simd::Sub(Simd::Abs(cosTheta), Simd::Splat(1));
+
+			Simd::Float4 lhsWeight = SlerpWeight(Simd::Sub(Simd::Splat(1), a_t), cosThetaMinusOne);
+			Simd::Float4 rhsWeight = Simd::FlipSign(SlerpWeight(a_t, cosThetaMinusOne), cosTheta);
+
+			return Blend(a_lhs, lhsWeight, a_rhs, rhsWeight);
+		}
+	}
+
+	void
+	MultiplyBatch(Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count)
+	{
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			QuaternionBlock lhs = LoadBlock(a_lhs + i, lanes);
+			QuaternionBlock rhs = LoadBlock(a_rhs + i, lanes);
+			StoreBlock(a_out + i, Multiply(lhs, rhs), lanes);
+		}
+	}
+
+	void
+	NlerpBatch(float const* a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count)
+	{
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			Simd::Float4    t   = LoadScalars(a_t + i, lanes);
+			QuaternionBlock lhs = LoadBlock(a_lhs + i, lanes);
+			QuaternionBlock rhs = LoadBlock(a_rhs + i, lanes);
+			StoreBlock(a_out + i, Nlerp(t, lhs, rhs), lanes);
+		}
+	}
+
+	void
+	NlerpBatch(float a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count)
+	{
+		Simd::Float4 t = Simd::Splat(a_t);
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			QuaternionBlock lhs = LoadBlock(a_lhs + i, lanes);
+			QuaternionBlock rhs = LoadBlock(a_rhs + i, lanes);
+			StoreBlock(a_out + i, Nlerp(t, lhs, rhs), lanes);
+		}
+	}
+
+	void
+	SlerpBatch(float const* a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count)
+	{
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			Simd::Float4    t   = LoadScalars(a_t + i, lanes);
+			QuaternionBlock lhs = LoadBlock(a_lhs + i, lanes);
+			QuaternionBlock rhs = LoadBlock(a_rhs + i, lanes);
+			StoreBlock(a_out + i, Slerp(t, lhs, rhs), lanes);
+		}
+	}
+
+	void
+	SlerpBatch(float a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count)
+	{
+		Simd::Float4 t = Simd::Splat(a_t);
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			QuaternionBlock lhs = LoadBlock(a_lhs + i, lanes);
+			QuaternionBlock rhs = LoadBlock(a_rhs + i, lanes);
+			StoreBlock(a_out + i, Slerp(t, lhs, rhs), lanes);
+		}
+	}
+
+	void
+	ToMatrix4Batch(Quaternionf const* a_rotations, Matrix4* a_out, std::size_t a_count)
+	{
+		Simd::Float4 zero    = Simd::Zero();
+		Simd::Float4 one     = Simd::Splat(1);
+		Simd::Float4 lastRow = Simd::Set(0, 0, 0, 1);
+
+		for (std::size_t i = 0; i < a_count; i += block_size)
+		{
+			std::size_t lanes = std::min(block_size, a_count - i);
+
+			QuaternionBlock q = LoadBlock(a_rotations + i, lanes);
+
+			Simd::Float4 x2 = Simd::Add(q.x, q.x);
+			Simd::Float4 y2 = Simd::Add(q.y, q.y);
+			Simd::Float4 z2 = Simd::Add(q.z, q.z);
+
+			Simd::Float4 xx = Simd::Mul(q.x, x2), yy = Simd::Mul(q.y, y2), zz = Simd::Mul(q.z, z2);
+			Simd::Float4 xy = Simd::Mul(q.x, y2), xz = Simd::Mul(q.x, z2), yz = Simd::Mul(q.y, z2);
+			Simd::Float4 wx = Simd::Mul(q.w, x2), wy = Simd::Mul(q.w, y2), wz = Simd::Mul(q.w, z2);
+
+			// Same terms as Quaternion::ToMatrix3, one register per matrix element across four quaternions
+			Simd::Float4 row0[block_size] = { Simd::Sub(Simd::Sub(one, yy), zz), Simd::Add(xy, wz), Simd::Sub(xz, wy), zero };
+			Simd::Float4 row1[block_size] = { Simd::Sub(xy, wz), Simd::Sub(Simd::Sub(one, xx), zz), Simd::Add(yz, wx), zero };
+			Simd::Float4 row2[block_size] = { Simd::Add(xz, wy), Simd::Sub(yz, wx), Simd::Sub(Simd::Sub(one, xx), yy), zero };
+
+			// Back to AoS, after transposing rowN[j] holds row N of the j-th matrix
+			Simd::Transpose(row0[0], row0[1], row0[2], row0[3]);
+			Simd::Transpose(row1[0], row1[1], row1[2], row1[3]);
+			Simd::Transpose(row2[0], row2[1], row2[2], row2[3]);
+
+			for (std::size_t j = 0; j < lanes; j++)
+			{
+				float* dst = a_out[i + j].data;
+				Simd::Store(dst + 0,  row0[j]);
+				Simd::Store(dst + 4,  row1[j]);
+				Simd::Store(dst + 8,  row2[j]);
+				Simd::Store(dst + 12, lastRow);
+			}
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Detail/type_Quaternion.h"
+
+#include "Matrix4.h"
+
+#include "Core/Common.h"
+
+namespace Oyl
+{
+	typedef Quaternion_t<float> Quaternionf;
+	static_assert(sizeof(Quaternionf) == sizeof(Quaternionf::data));
+}
+
+namespace Oyl::Quaternion
+{
+	// Batched operations over arrays of quaternions.
+	// Quaternions are processed four at a time in SoA form, so these are considerably faster than looping
+	// over the single quaternion functions for animation sized workloads.
+	// a_out may alias any of the inputs.
+
+	/// \brief a_out[i] = a_lhs[i] * a_rhs[i]
+	OYL_CORE_API
+	extern
+	void
+	MultiplyBatch(Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Quaternion::Nlerp(a_t[i], a_lhs[i], a_rhs[i])
+	OYL_CORE_API
+	extern
+	void
+	NlerpBatch(float const* a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Quaternion::Nlerp(a_t, a_lhs[i], a_rhs[i])
+	OYL_CORE_API
+	extern
+	void
+	NlerpBatch(float a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count);
+
+	/**
+	 * \brief a_out[i] = Quaternion::Slerp(a_t[i], a_lhs[i], a_rhs[i])
+	 * \remarks Evaluates the slerp weights with a polynomial instead of acos and sin (Eberly, "A Fast and Accurate
+	 *          Algorithm for Computing SLERP"), so there is no branch on the angle between the inputs.
+	 *          Results are within 3e-5 of the exact slerp per component over the whole range and stay unit length
+	 *          to the same tolerance.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	SlerpBatch(float const* a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Quaternion::Slerp(a_t, a_lhs[i], a_rhs[i]), see the per element overload for accuracy
+	OYL_CORE_API
+	extern
+	void
+	SlerpBatch(float a_t, Quaternionf const* a_lhs, Quaternionf const* a_rhs, Quaternionf* a_out, std::size_t a_count);
+
+	/// \brief a_out[i] = Quaternion::ToMatrix4(a_rotations[i])
+	OYL_CORE_API
+	extern
+	void
+	ToMatrix4Batch(Quaternionf const* a_rotations, Matrix4* a_out, std::size_t a_count);
+}
@@ -0,0 +1,474 @@
+#include "pch.h"
+#include "Random.h"
+
+#include <atomic>
+
+#include "Fast.h"
+#include "Simd.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		template<std::size_t Size>
+		void
+		JumpXoshiro256(uint64 (&a_state)[4], uint64 const (&a_polynomial)[Size], Xoshiro256& a_generator)
+		{
+			uint64 result[4] = {};
+			for (uint64 word : a_polynomial)
+			{
+				for (int bit = 0; bit < 64; bit++)
+				{
+					if (word & (uint64(1) << bit))
+					{
+						for (int i = 0; i < 4; i++)
+						{
+							result[i] ^= a_state[i];
+						}
+					}
+					a_generator.Next();
+				}
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				a_state[i] = result[i];
+			}
+		}
+
+		constexpr uint32 RotateLeft32(uint32 a_value, int a_bits) { return (a_value << a_bits) | (a_value >> (32 - a_bits)); }
+
+		/// One lane of Xoshiro128x8, only used to seed and jump the lanes
+		void
+		NextXoshiro128(uint32 (&a_state)[4])
+		{
+			uint32 t = a_state[1] << 9;
+
+			a_state[2] ^= a_state[0];
+			a_state[3] ^= a_state[1];
+			a_state[1] ^= a_state[2];
+			a_state[0] ^= a_state[3];
+			a_state[2] ^= t;
+			a_state[3] = RotateLeft32(a_state[3], 11);
+		}
+
+		void
+		JumpXoshiro128(uint32 (&a_state)[4], uint32 const (&a_polynomial)[4])
+		{
+			uint32 result[4] = {};
+			for (uint32 word : a_polynomial)
+			{
+				for (int bit = 0; bit < 32; bit++)
+				{
+					if (word & (1u << bit))
+					{
+						for (int i = 0; i < 4; i++)
+						{
+							result[i] ^= a_state[i];
+						}
+					}
+					NextXoshiro128(a_state);
+				}
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				a_state[i] = result[i];
+			}
+		}
+
+		// Jump polynomials from the reference implementations, 2^64 and 2^96 steps of xoshiro128
+		constexpr uint32 xoshiro128_jump[4]      = { 0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B };
+		constexpr uint32 xoshiro128_long_jump[4] = { 0xB523952E, 0x0B6F099F, 0xCCF5A0EF, 0x1C580662 };
+
+		void
+		SeedXoshiro128(uint32 (&a_state)[4], uint64 a_seed)
+		{
+			uint64 low  = Detail::SplitMix64(a_seed);
+			uint64 high = Detail::SplitMix64(a_seed);
+
+			a_state[0] = static_cast<uint32>(low);
+			a_state[1] = static_cast<uint32>(low >> 32);
+			a_state[2] = static_cast<uint32>(high);
+			a_state[3] = static_cast<uint32>(high >> 32);
+		}
+
+		/// Fills the lanes with a_first and the states following it 2^64 steps apart
+		void
+		FillLanes(Xoshiro128x8& a_generator, uint32 (&a_first)[4])
+		{
+			uint32 lane[4] = { a_first[0], a_first[1], a_first[2], a_first[3] };
+			for (std::size_t l = 0; l < Xoshiro128x8::lane_count; l++)
+			{
+				for (int i = 0; i < 4; i++)
+				{
+					a_generator.state[i][l] = lane[i];
+				}
+				JumpXoshiro128(lane, xoshiro128_jump);
+			}
+		}
+	}
+
+	Xoshiro256
+	Xoshiro256::Stream(uint64 a_seed, uint32 a_index) noexcept
+	{
+		Xoshiro256 result(a_seed);
+		for (uint32 i = 0; i < a_index; i++)
+		{
+			result.Jump();
+		}
+		return result;
+	}
+
+	void
+	Xoshiro256::Jump() noexcept
+	{
+		constexpr uint64 polynomial[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+		JumpXoshiro256(m_state, polynomial, *this);
+	}
+
+	void
+	Xoshiro256::LongJump() noexcept
+	{
+		constexpr uint64 polynomial[] = { 0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull };
+		JumpXoshiro256(m_state, polynomial, *this);
+	}
+
+	Xoshiro128x8::Xoshiro128x8(uint64 a_seed) noexcept
+		: state {}
+	{
+		uint32 first[4];
+		SeedXoshiro128(first, a_seed);
+		FillLanes(*this, first);
+	}
+
+	Xoshiro128x8
+	Xoshiro128x8::Stream(uint64 a_seed, uint32 a_index) noexcept
+	{
+		uint32 first[4];
+		SeedXoshiro128(first, a_seed);
+		for (uint32 i = 0; i < a_index; i++)
+		{
+			JumpXoshiro128(first, xoshiro128_long_jump);
+		}
+
+		Xoshiro128x8 result(a_seed);
+		FillLanes(result, first);
+		return result;
+	}
+}
+
+namespace Oyl::Random
+{
+	namespace
+	{
+		constexpr std::size_t lane_count = Xoshiro128x8::lane_count;
+		static_assert(Vector3Stream::block_size == lane_count);
+
+		std::atomic<uint32> g_nextThreadStream { 0 };
+		std::atomic<uint32> g_nextThreadBatchStream { 0 };
+
+		/// The generator state held in registers for the duration of a batch
+		struct Lanes
+		{
+			Simd::Int8 s0, s1, s2, s3;
+		};
+
+		Lanes
+		LoadLanes(Xoshiro128x8 const& a_generator)
+		{
+			auto load = [&](int a_word) { return Simd::LoadInt8(reinterpret_cast<std::int32_t const*>(a_generator.state[a_word])); };
+			return Lanes { load(0), load(1), load(2), load(3) };
+		}
+
+		void
+		StoreLanes(Xoshiro128x8& a_generator, Lanes const& a_lanes)
+		{
+			Simd::Store(reinterpret_cast<std::int32_t*>(a_generator.state[0]), a_lanes.s0);
+			Simd::Store(reinterpret_cast<std::int32_t*>(a_generator.state[1]), a_lanes.s1);
+			Simd::Store(reinterpret_cast<std::int32_t*>(a_generator.state[2]), a_lanes.s2);
+			Simd::Store(reinterpret_cast<std::int32_t*>(a_generator.state[3]), a_lanes.s3);
+		}
+
+		template<int Bits>
+		OYL_FORCE_INLINE
+		Simd::Int8
+		RotateLeft(Simd::Int8 a_value)
+		{
+			return Simd::Or(Simd::ShiftLeft<Bits>(a_value), Simd::ShiftRightLogical<32 - Bits>(a_value));
+		}
+
+		/// xoshiro128+ in every lane
+		OYL_FORCE_INLINE
+		Simd::Int8
+		NextBits(Lanes& a_lanes)
+		{
+			Simd::Int8 result = Simd::Add(a_lanes.s0, a_lanes.s3);
+			Simd::Int8 t      = Simd::ShiftLeft<9>(a_lanes.s1);
+
+			a_lanes.s2 = Simd::Xor(a_lanes.s2, a_lanes.s0);
+			a_lanes.s3 = Simd::Xor(a_lanes.s3, a_lanes.s1);
+			a_lanes.s1 = Simd::Xor(a_lanes.s1, a_lanes.s2);
+			a_lanes.s0 = Simd::Xor(a_lanes.s0, a_lanes.s3);
+			a_lanes.s2 = Simd::Xor(a_lanes.s2, t);
+			a_lanes.s3 = RotateLeft<11>(a_lanes.s3);
+
+			return result;
+		}
+
+		/// \return Floats in [0, 1) from the top 24 bits of each lane
+		OYL_FORCE_INLINE
+		Simd::Float8
+		NextUnit(Lanes& a_lanes)
+		{
+			Simd::Int8 bits = Simd::ShiftRightLogical<8>(NextBits(a_lanes));
+			return Simd::Mul(Simd::ConvertToFloat(bits), Simd::Splat8(1.0f / 16777216.0f));
+		}
+
+		/// \return Floats in (0, 1], safe to take the logarithm of
+		OYL_FORCE_INLINE
+		Simd::Float8
+		NextUnitNonZero(Lanes& a_lanes)
+		{
+			Simd::Int8 bits = Simd::Add(Simd::ShiftRightLogical<8>(NextBits(a_lanes)), Simd::SplatInt8(1));
+			return Simd::Mul(Simd::ConvertToFloat(bits), Simd::Splat8(1.0f / 16777216.0f));
+		}
+
+		/**
+		 * \return The natural logarithm of positive, normal a_value
+		 * \remarks Cephes logf: split off the exponent, then a polynomial in the mantissa moved to [sqrt(0.5), sqrt(2)).
+		 *          Relative error is around 1e-7.
+		 */
+		OYL_FORCE_INLINE
+		Simd::Float8
+		Log(Simd::Float8 a_value)
+		{
+			constexpr float coefficients[] = {
+				3.3333331174e-1f, -2.4999993993e-1f, 2.0000714765e-1f, -1.6668057665e-1f, 1.4249322787e-1f,
+				-1.2420140846e-1f, 1.1676998740e-1f, -1.1514610310e-1f, 7.0376836292e-2f,
+			};
+
+			Simd::Int8   bits     = Simd::BitCastToInt(a_value);
+			Simd::Int8   exponent = Simd::Sub(Simd::ShiftRightLogical<23>(bits), Simd::SplatInt8(127));
+			Simd::Float8 mantissa = Simd::BitCastToFloat(Simd::Or(Simd::And(bits, Simd::SplatInt8(0x007FFFFF)), Simd::SplatInt8(0x3F800000)));
+
+			// Halve the mantissas above sqrt(2), the all ones mask adds one to their exponent
+			Simd::Float8 isLarge = Simd::Greater(mantissa, Simd::Splat8(1.41421356f));
+			mantissa = Simd::Select(isLarge, Simd::Mul(mantissa, Simd::Splat8(0.5f)), mantissa);
+			exponent = Simd::Sub(exponent, Simd::BitCastToInt(isLarge));
+
+			Simd::Float8 e = Simd::ConvertToFloat(exponent);
+			Simd::Float8 x = Simd::Sub(mantissa, Simd::Splat8(1.0f));
+			Simd::Float8 z = Simd::Mul(x, x);
+
+			Simd::Float8 polynomial = Simd::Splat8(coefficients[8]);
+			for (int i = 7; i >= 0; i--)
+			{
+				polynomial = Simd::MulAdd(polynomial, x, Simd::Splat8(coefficients[i]));
+			}
+
+			// ln(2) is split in two so e * ln(2) stays accurate
+			Simd::Float8 y = Simd::Mul(Simd::Mul(polynomial, x), z);
+			y = Simd::MulAdd(e, Simd::Splat8(-2.12194440e-4f), y);
+			y = Simd::MulAdd(z, Simd::Splat8(-0.5f), y);
+
+			Simd::Float8 result = Simd::Add(x, y);
+			return Simd::MulAdd(e, Simd::Splat8(0.693359375f), result);
+		}
+
+		/// Stores the first a_count lanes of a_value, the rest of a_dst is left untouched
+		void
+		StorePartial(float* a_dst, Simd::Float8 a_value, std::size_t a_count)
+		{
+			if (a_count == lane_count)
+			{
+				Simd::Store(a_dst, a_value);
+				return;
+			}
+
+			alignas(32) float lanes[lane_count];
+			Simd::Store(lanes, a_value);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				a_dst[i] = lanes[i];
+			}
+		}
+
+		/// Interleaves the first a_count lanes of the components into a_dst
+		void
+		StoreVectors(Vector3* a_dst, Simd::Float8 a_x, Simd::Float8 a_y, Simd::Float8 a_z, std::size_t a_count)
+		{
+			alignas(32) float x[lane_count];
+			alignas(32) float y[lane_count];
+			alignas(32) float z[lane_count];
+			Simd::Store(x, a_x);
+			Simd::Store(y, a_y);
+			Simd::Store(z, a_z);
+
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				a_dst[i] = Vector3(x[i], y[i], z[i]);
+			}
+		}
+
+		/// Runs a_block once per lane_count outputs, handing it the output index and the number of valid lanes
+		template<typename TBlock>
+		void
+		Generate(Xoshiro128x8& a_generator, std::size_t a_count, TBlock&& a_block)
+		{
+			Lanes lanes = LoadLanes(a_generator);
+			for (std::size_t i = 0; i < a_count; i += lane_count)
+			{
+				std::size_t valid = a_count - i < lane_count ? a_count - i : lane_count;
+				a_block(lanes, i, valid);
+			}
+			StoreLanes(a_generator, lanes);
+		}
+
+		OYL_FORCE_INLINE
+		void
+		NextUnitVectors(Lanes& a_lanes, Simd::Float8& a_x, Simd::Float8& a_y, Simd::Float8& a_z)
+		{
+			constexpr float two_pi = 6.28318531f;
+
+			// z uniform in (-1, 1] and the angle around z uniform is uniform on the sphere (Archimedes)
+			a_z = Simd::Sub(Simd::Splat8(1.0f), Simd::Mul(NextUnit(a_lanes), Simd::Splat8(2.0f)));
+			Simd::Float8 angle  = Simd::Mul(NextUnit(a_lanes), Simd::Splat8(two_pi));
+			Simd::Float8 radius = Simd::Sqrt(Simd::Max(Simd::Sub(Simd::Splat8(1.0f), Simd::Mul(a_z, a_z)), Simd::Zero8()));
+
+			Simd::Float8 sin, cos;
+			Math::Fast::SinCos(angle, sin, cos);
+			a_x = Simd::Mul(radius, cos);
+			a_y = Simd::Mul(radius, sin);
+		}
+
+		struct BoxBlock
+		{
+			Simd::Float8 min[3];
+			Simd::Float8 size[3];
+		};
+
+		BoxBlock
+		LoadBox(AABB const& a_box)
+		{
+			Vector3 size = a_box.Size();
+
+			BoxBlock result;
+			for (int c = 0; c < 3; c++)
+			{
+				result.min[c]  = Simd::Splat8(a_box.min.data[c]);
+				result.size[c] = Simd::Splat8(size.data[c]);
+			}
+			return result;
+		}
+	}
+
+	void
+	Uniform(Xoshiro128x8& a_generator, float* a_out, std::size_t a_count, float a_min, float a_max)
+	{
+		Simd::Float8 min   = Simd::Splat8(a_min);
+		Simd::Float8 range = Simd::Splat8(a_max - a_min);
+
+		Generate(a_generator, a_count, [&](Lanes& a_lanes, std::size_t a_index, std::size_t a_valid)
+		{
+			StorePartial(a_out + a_index, Simd::MulAdd(NextUnit(a_lanes), range, min), a_valid);
+		});
+	}
+
+	void
+	Normal(Xoshiro128x8& a_generator, float* a_out, std::size_t a_count, float a_mean, float a_deviation)
+	{
+		constexpr float two_pi = 6.28318531f;
+
+		Simd::Float8 mean = Simd::Splat8(a_mean);
+
+		// Each step gives two blocks of outputs, the cosine and the sine halves of Box-Muller
+		Generate(a_generator, (a_count + 1) / 2, [&](Lanes& a_lanes, std::size_t a_index, std::size_t)
+		{
+			Simd::Float8 logarithm = Log(NextUnitNonZero(a_lanes));
+			Simd::Float8 radius    = Simd::Mul(Simd::Sqrt(Simd::Mul(logarithm, Simd::Splat8(-2.0f))), Simd::Splat8(a_deviation));
+			Simd::Float8 angle     = Simd::Mul(NextUnit(a_lanes), Simd::Splat8(two_pi));
+
+			Simd::Float8 sin, cos;
+			Math::Fast::SinCos(angle, sin, cos);
+
+			std::size_t first  = a_index * 2;
+			std::size_t valid  = a_count - first;
+			std::size_t cosines = valid < lane_count ? valid : lane_count;
+			StorePartial(a_out + first, Simd::MulAdd(radius, cos, mean), cosines);
+			if (valid > lane_count)
+			{
+				std::size_t sines = valid - lane_count < lane_count ? valid - lane_count : lane_count;
+				StorePartial(a_out + first + lane_count, Simd::MulAdd(radius, sin, mean), sines);
+			}
+		});
+	}
+
+	void
+	UnitVectors(Xoshiro128x8& a_generator, Vector3* a_out, std::size_t a_count)
+	{
+		Generate(a_generator, a_count, [&](Lanes& a_lanes, std::size_t a_index, std::size_t a_valid)
+		{
+			Simd::Float8 x, y, z;
+			NextUnitVectors(a_lanes, x, y, z);
+			StoreVectors(a_out + a_index, x, y, z, a_valid);
+		});
+	}
+
+	void
+	UnitVectors(Xoshiro128x8& a_generator, Vector3Stream& a_out, std::size_t a_count)
+	{
+		a_out.Resize(a_count);
+
+		// The padding lanes are unspecified, so whole blocks are stored
+		Generate(a_generator, a_count, [&](Lanes& a_lanes, std::size_t a_index, std::size_t)
+		{
+			Simd::Float8 x, y, z;
+			NextUnitVectors(a_lanes, x, y, z);
+			Simd::Store(a_out.X() + a_index, x);
+			Simd::Store(a_out.Y() + a_index, y);
+			Simd::Store(a_out.Z() + a_index, z);
+		});
+	}
+
+	void
+	PointsInBox(Xoshiro128x8& a_generator, AABB const& a_box, Vector3* a_out, std::size_t a_count)
+	{
+		BoxBlock box = LoadBox(a_box);
+
+		Generate(a_generator, a_count, [&](Lanes& a_lanes, std::size_t a_index, std::size_t a_valid)
+		{
+			Simd::Float8 x = Simd::MulAdd(NextUnit(a_lanes), box.size[0], box.min[0]);
+			Simd::Float8 y = Simd::MulAdd(NextUnit(a_lanes), box.size[1], box.min[1]);
+			Simd::Float8 z = Simd::MulAdd(NextUnit(a_lanes), box.size[2], box.min[2]);
+			StoreVectors(a_out + a_index, x, y, z, a_valid);
+		});
+	}
+
+	void
+	PointsInBox(Xoshiro128x8& a_generator, AABB const& a_box, Vector3Stream& a_out, std::size_t a_count)
+	{
+		BoxBlock box = LoadBox(a_box);
+		a_out.Resize(a_count);
+
+		Generate(a_generator, a_count, [&](Lanes& a_lanes, std::size_t a_index, std::size_t)
+		{
+			for (int c = 0; c < 3; c++)
+			{
+				Simd::Store(a_out.Component(c) + a_index, Simd::MulAdd(NextUnit(a_lanes), box.size[c], box.min[c]));
+			}
+		});
+	}
+
+	Xoshiro256&
+	ThreadGenerator()
+	{
+		thread_local Xoshiro256 generator = Xoshiro256::Stream(Xoshiro256::default_seed, g_nextThreadStream++);
+		return generator;
+	}
+
+	Xoshiro128x8&
+	ThreadBatchGenerator()
+	{
+		thread_local Xoshiro128x8 generator = Xoshiro128x8::Stream(Xoshiro256::default_seed, g_nextThreadBatchStream++);
+		return generator;
+	}
+}
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include "Bounds.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	namespace Detail
+	{
+		/// \brief SplitMix64, expands a single seed into well mixed generator state
+		constexpr
+		uint64
+		SplitMix64(uint64& a_state) noexcept
+		{
+			uint64 z = (a_state += 0x9E3779B97F4A7C15ull);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			return z ^ (z >> 31);
+		}
+
+		constexpr uint64 RotateLeft(uint64 a_value, int a_bits) noexcept { return (a_value << a_bits) | (a_value >> (64 - a_bits)); }
+	}
+
+	/**
+	 * \brief xoshiro256++ by Blackman and Vigna, the general purpose generator
+	 * \remarks Period 2^256 - 1, passes BigCrush, and a call is a handful of adds, shifts and xors.
+	 *          Satisfies UniformRandomBitGenerator, so it also works with the <random> distributions.
+	 *      <br>Don't share one between threads, give each its own through Stream, or use Random::ThreadGenerator.
+	 */
+	class Xoshiro256
+	{
+	public:
+		using result_type = uint64;
+
+		constexpr static uint64 default_seed = 0x0123456789ABCDEFull;
+
+		/// \brief Fills the state from a_seed with SplitMix64, the same seed always gives the same sequence
+		constexpr
+		explicit
+		Xoshiro256(uint64 a_seed = default_seed) noexcept
+			: m_state {}
+		{
+			for (uint64& word : m_state)
+			{
+				word = Detail::SplitMix64(a_seed);
+			}
+		}
+
+		/**
+		 * \return The generator for stream a_index of a_seed, which starts 2^128 values after stream a_index - 1
+		 * \remarks Streams of the same seed never overlap in practice, so a_index can be a thread or job index.
+		 *          Costs a_index jumps, cache the result for large indices.
+		 */
+		OYL_CORE_API
+		static
+		Xoshiro256
+		Stream(uint64 a_seed, uint32 a_index) noexcept;
+
+		constexpr static result_type min() noexcept { return 0; }
+		constexpr static result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+		constexpr result_type operator ()() noexcept { return Next(); }
+
+		constexpr
+		uint64
+		Next() noexcept
+		{
+			uint64 result = Detail::RotateLeft(m_state[0] + m_state[3], 23) + m_state[0];
+			uint64 t      = m_state[1] << 17;
+
+			m_state[2] ^= m_state[0];
+			m_state[3] ^= m_state[1];
+			m_state[1] ^= m_state[2];
+			m_state[0] ^= m_state[3];
+			m_state[2] ^= t;
+			m_state[3] = Detail::RotateLeft(m_state[3], 45);
+
+			return result;
+		}
+
+		/// \return A float in [0, 1) from the top 24 bits, every value is a multiple of 2^-24
+		constexpr float NextFloat() noexcept { return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f); }
+
+		/// \return An unbiased integer in [0, a_bound), a_bound must not be 0
+		constexpr
+		uint32
+		NextBounded(uint32 a_bound) noexcept
+		{
+			// Lemire, "Fast Random Integer Generation in an Interval"
+			uint64 product = (Next() >> 32) * a_bound;
+			if (static_cast<uint32>(product) < a_bound)
+			{
+				uint32 threshold = (0u - a_bound) % a_bound;
+				while (static_cast<uint32>(product) < threshold)
+				{
+					product = (Next() >> 32) * a_bound;
+				}
+			}
+			return static_cast<uint32>(product >> 32);
+		}
+
+		/// \brief Advances the generator by 2^128 calls of Next
+		OYL_CORE_API
+		void
+		Jump() noexcept;
+
+		/// \brief Advances the generator by 2^192 calls of Next
+		OYL_CORE_API
+		void
+		LongJump() noexcept;
+
+	private:
+		uint64 m_state[4];
+	};
+
+	/**
+	 * \brief PCG32 (PCG-XSH-RR 64/32) by O'Neill, a small generator with selectable streams
+	 * \remarks Period 2^64 in each of 2^63 streams, and Advance moves anywhere in the sequence in O(log n),
+	 *          ie. to the value of particle n or frame n without generating the ones before it.
+	 */
+	class Pcg32
+	{
+	public:
+		using result_type = uint32;
+
+		constexpr static uint64 default_seed = 0x853C49E6748FEA9Bull;
+
+		constexpr
+		explicit
+		Pcg32(uint64 a_seed = default_seed, uint64 a_stream = 0) noexcept
+			: m_state(0),
+			  m_increment((a_stream << 1) | 1)
+		{
+			Next();
+			m_state += a_seed;
+			Next();
+		}
+
+		constexpr static result_type min() noexcept { return 0; }
+		constexpr static result_type max() noexcept { return std::numeric_limits<result_type>::max(); }
+
+		constexpr result_type operator ()() noexcept { return Next(); }
+
+		constexpr
+		uint32
+		Next() noexcept
+		{
+			uint64 state = m_state;
+			m_state = state * multiplier + m_increment;
+
+			uint32 xorShifted = static_cast<uint32>(((state >> 18) ^ state) >> 27);
+			uint32 rotation   = static_cast<uint32>(state >> 59);
+			return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31));
+		}
+
+		/// \return A float in [0, 1) from the top 24 bits, every value is a multiple of 2^-24
+		constexpr float NextFloat() noexcept { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+		/// \return An unbiased integer in [0, a_bound), a_bound must not be 0
+		constexpr
+		uint32
+		NextBounded(uint32 a_bound) noexcept
+		{
+			uint64 product = static_cast<uint64>(Next()) * a_bound;
+			if (static_cast<uint32>(product) < a_bound)
+			{
+				uint32 threshold = (0u - a_bound) % a_bound;
+				while (static_cast<uint32>(product) < threshold)
+				{
+					product = static_cast<uint64>(Next()) * a_bound;
+				}
+			}
+			return static_cast<uint32>(product >> 32);
+		}
+
+		/**
+		 * \brief Moves the generator a_delta calls of Next ahead, in O(log a_delta)
+		 * \remarks The sequence has period 2^64, so Advance(0 - n) goes n calls back.
+		 */
+		constexpr
+		void
+		Advance(uint64 a_delta) noexcept
+		{
+			// Brown, "Random Number Generation with Arbitrary Stride", composing the LCG step with itself
+			uint64 accumulatedMultiplier = 1;
+			uint64 accumulatedIncrement  = 0;
+			uint64 currentMultiplier     = multiplier;
+			uint64 currentIncrement      = m_increment;
+			while (a_delta > 0)
+			{
+				if (a_delta & 1)
+				{
+					accumulatedMultiplier *= currentMultiplier;
+					accumulatedIncrement   = accumulatedIncrement * currentMultiplier + currentIncrement;
+				}
+				currentIncrement  = (currentMultiplier + 1) * currentIncrement;
+				currentMultiplier *= currentMultiplier;
+				a_delta >>= 1;
+			}
+			m_state = accumulatedMultiplier * m_state + accumulatedIncrement;
+		}
+
+	private:
+		constexpr static uint64 multiplier = 6364136223846793005ull;
+
+		uint64 m_state;
+		uint64 m_increment;
+	};
+
+	/**
+	 * \brief Eight xoshiro128+ generators in the lanes of a SIMD register, for the batch functions in Random
+	 * \remarks xoshiro128+ rather than xoshiro256++ because its 32 bit words fill the same Simd::Int8 lanes as the
+	 *          floats they become. Only the top 24 bits are used, which avoids the weak low bits of the + scrambler.
+	 *      <br>The lanes start 2^64 values apart, and streams of the same seed 2^96 apart. The generated bits are
+	 *          the same on every SIMD backend, float results only differ by the rounding of FMA where it's used.
+	 */
+	struct Xoshiro128x8
+	{
+		constexpr static std::size_t lane_count = 8;
+
+		OYL_CORE_API
+		explicit
+		Xoshiro128x8(uint64 a_seed = Xoshiro256::default_seed) noexcept;
+
+		/// \return The generator for stream a_index of a_seed, see Xoshiro256::Stream
+		OYL_CORE_API
+		static
+		Xoshiro128x8
+		Stream(uint64 a_seed, uint32 a_index) noexcept;
+
+		/// state[word][lane], loaded into four Simd::Int8 by the batch functions
+		alignas(32) uint32 state[4][lane_count];
+	};
+}
+
+namespace Oyl::Random
+{
+	// Batch sampling, lane_count values per step of the generator.
+	// A partial last step still advances every lane, so the values depend on how a request is split into calls.
+
+	/// \brief a_out[i] uniform in [a_min, a_max)
+	OYL_CORE_API
+	extern
+	void
+	Uniform(Xoshiro128x8& a_generator, float* a_out, std::size_t a_count, float a_min = 0.0f, float a_max = 1.0f);
+
+	/// \brief a_out[i] normally distributed with the given mean and standard deviation, through Box-Muller
+	OYL_CORE_API
+	extern
+	void
+	Normal(Xoshiro128x8& a_generator, float* a_out, std::size_t a_count, float a_mean = 0.0f, float a_deviation = 1.0f);
+
+	/// \brief a_out[i] uniformly distributed on the unit sphere
+	OYL_CORE_API
+	extern
+	void
+	UnitVectors(Xoshiro128x8& a_generator, Vector3* a_out, std::size_t a_count);
+
+	/// \brief Resizes a_out to a_count vectors uniformly distributed on the unit sphere
+	OYL_CORE_API
+	extern
+	void
+	UnitVectors(Xoshiro128x8& a_generator, Vector3Stream& a_out, std::size_t a_count);
+
+	/// \brief a_out[i] uniformly distributed in a_box
+	OYL_CORE_API
+	extern
+	void
+	PointsInBox(Xoshiro128x8& a_generator, AABB const& a_box, Vector3* a_out, std::size_t a_count);
+
+	/// \brief Resizes a_out to a_count points uniformly distributed in a_box
+	OYL_CORE_API
+	extern
+	void
+	PointsInBox(Xoshiro128x8& a_generator, AABB const& a_box, Vector3Stream& a_out, std::size_t a_count);
+
+	/**
+	 * \return A generator owned by the calling thread, on its own stream of Xoshiro256::default_seed
+	 * \remarks Threads get stream indices in the order they first call this, so the values are only reproducible
+	 *          when that order is. Use Xoshiro256::Stream with a job or entity index where it needs to be.
+	 */
+	OYL_CORE_API
+	extern
+	Xoshiro256&
+	ThreadGenerator();
+
+	/// \return The batch generator owned by the calling thread, see ThreadGenerator
+	OYL_CORE_API
+	extern
+	Xoshiro128x8&
+	ThreadBatchGenerator();
+}
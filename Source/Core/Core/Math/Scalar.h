@@ -2,11 +2,122 @@
 
 #include <type_traits>
 #include <cmath>
+#include <limits>
 
 #include "Constants.h"
 
+#include "Core/Common.h"
+
+#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+#	include "Fast.h"
+#endif
+
 namespace Oyl::Math
 {
+	/**
+	 * Libm-free implementations behind the constexpr Sqrt, Sin, Cos and Tan below, only used during constant evaluation.
+	 * They work in double precision so the float results are correctly rounded in practice.
+	 */
+	namespace Detail
+	{
+		constexpr double pi_over_180 = 3.14159265358979323846 / 180.0;
+
+		constexpr
+		double
+		Sqrt(double a_value)
+		{
+			if (!(a_value >= 0))
+			{
+				return std::numeric_limits<double>::quiet_NaN();
+			}
+
+			if (a_value == 0 || a_value == std::numeric_limits<double>::infinity())
+			{
+				return a_value;
+			}
+
+			// Newton-Raphson from above decreases monotonically until it has converged
+			double estimate = a_value > 1 ? a_value : 1;
+			while (true)
+			{
+				double next = 0.5 * (estimate + a_value / estimate);
+				if (next >= estimate)
+				{
+					return estimate;
+				}
+				estimate = next;
+			}
+		}
+
+		/**
+		 * \brief Sine and cosine of an angle in degrees
+		 * \remarks The angle is reduced to [-45, 45] degrees exactly before converting to radians,
+		 *          so multiples of 90 degrees give exact zeroes and ones.
+		 */
+		constexpr
+		void
+		SinCos(double a_angle, double& a_sin, double& a_cos)
+		{
+			if (a_angle - a_angle != 0)
+			{
+				// Infinity or NaN
+				a_sin = a_cos = std::numeric_limits<double>::quiet_NaN();
+				return;
+			}
+
+			bool   isNegative = a_angle < 0;
+			double angle      = isNegative ? -a_angle : a_angle;
+
+			// Long division by 360, each subtraction is exact since the operands are within a factor of 2
+			double multiple = 360;
+			while (multiple * 2 <= angle)
+			{
+				multiple *= 2;
+			}
+			while (angle >= 360)
+			{
+				while (multiple > angle)
+				{
+					multiple *= 0.5;
+				}
+				angle -= multiple;
+			}
+
+			int    quadrant = static_cast<int>(angle / 90 + 0.5);
+			double radians  = (angle - quadrant * 90.0) * pi_over_180;
+			double square   = radians * radians;
+
+			// Taylor series, the terms past x^17 are below double precision for |x| <= pi / 4
+			double sin  = 0;
+			double cos  = 0;
+			double term = radians;
+			for (int i = 1; i < 18; i += 2)
+			{
+				sin  += term;
+				term *= -square / ((i + 1) * (i + 2));
+			}
+			term = 1;
+			for (int i = 0; i < 18; i += 2)
+			{
+				cos  += term;
+				term *= -square / ((i + 1) * (i + 2));
+			}
+
+			switch (quadrant % 4)
+			{
+				case 0:  a_sin =  sin; a_cos =  cos; break;
+				case 1:  a_sin =  cos; a_cos = -sin; break;
+				case 2:  a_sin = -sin; a_cos = -cos; break;
+				default: a_sin = -cos; a_cos =  sin; break;
+			}
+
+			if (isNegative)
+			{
+				a_sin = -a_sin;
+			}
+		}
+	}
+
 	/**
 	 * \brief Returns the sign of the given value
 	 * \return -1 if a_value < 0,
@@ -47,6 +158,134 @@ namespace Oyl::Math
 		return a_lhs * (1 - a_t) + a_rhs * a_t;
 	}
 
+	/**
+	 * \return The square root of a_value, NaN if it is negative
+	 * \remarks Evaluates at compile time in constant expressions, at runtime it is std::sqrt.
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Sqrt(TScalar a_value)
+	{
+		if (!OYL_IS_CONSTANT_EVALUATED())
+		{
+			return std::sqrt(a_value);
+		}
+
+		return static_cast<TScalar>(Detail::Sqrt(static_cast<double>(a_value)));
+	}
+
+	/**
+	 * \brief Computes the sine and cosine of the angle a_angle in degrees together
+	 * \remarks Evaluates at compile time in constant expressions, at runtime it is libm or Math::Fast as before.
+	 *          The compile time path reduces the angle exactly in degrees, so it can differ from the runtime one
+	 *          by an ulp, or more for very large angles where the float conversion to radians loses precision.
+	 */
+	template<typename TScalar>
+	constexpr
+	void
+	SinCos(TScalar a_angle, TScalar& a_sin, TScalar& a_cos)
+	{
+		if (!OYL_IS_CONSTANT_EVALUATED())
+		{
+			// std::cos and sin expect radians
+			TScalar radians = a_angle * DEG_TO_RAD;
+
+		#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+			if constexpr (std::is_same_v<TScalar, float>)
+			{
+				Fast::SinCos<Fast::engine_accuracy>(radians, a_sin, a_cos);
+				return;
+			}
+		#endif
+
+			a_sin = std::sin(radians);
+			a_cos = std::cos(radians);
+			return;
+		}
+
+		double sin = 0, cos = 0;
+		Detail::SinCos(static_cast<double>(a_angle), sin, cos);
+
+		a_sin = static_cast<TScalar>(sin);
+		a_cos = static_cast<TScalar>(cos);
+	}
+
+	/** 
+	 * \return The sine of the angle a_angle in degrees, see SinCos
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Sin(TScalar a_angle)
+	{
+	#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+		if constexpr (std::is_same_v<TScalar, float>)
+		{
+			TScalar sin = 0, cos = 0;
+			SinCos(a_angle, sin, cos);
+			return sin;
+		} else
+	#endif
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return std::sin(a_angle * DEG_TO_RAD);
+			}
+
+			TScalar sin = 0, cos = 0;
+			SinCos(a_angle, sin, cos);
+			return sin;
+		}
+	}
+
+	/** 
+	 * \return The cosine of the angle a_angle in degrees, see SinCos
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Cos(TScalar a_angle)
+	{
+	#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+		if constexpr (std::is_same_v<TScalar, float>)
+		{
+			TScalar sin = 0, cos = 0;
+			SinCos(a_angle, sin, cos);
+			return cos;
+		} else
+	#endif
+		{
+			if (!OYL_IS_CONSTANT_EVALUATED())
+			{
+				return std::cos(a_angle * DEG_TO_RAD);
+			}
+
+			TScalar sin = 0, cos = 0;
+			SinCos(a_angle, sin, cos);
+			return cos;
+		}
+	}
+
+	/** 
+	 * \return The tangent of the angle a_angle in degrees
+	 * \remarks Odd multiples of 90 degrees are a division by zero, which doesn't compile in a constant expression.
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Tan(TScalar a_angle)
+	{
+		if (!OYL_IS_CONSTANT_EVALUATED())
+		{
+			return std::tan(a_angle * DEG_TO_RAD);
+		}
+
+		double sin = 0, cos = 0;
+		Detail::SinCos(static_cast<double>(a_angle), sin, cos);
+		return static_cast<TScalar>(sin / cos);
+	}
+
 	/** 
 	 * \return The angle about the origin of the vector with y component a_y and x component a_x.
 	 *         Takes into account the quadrant of the vector.
@@ -58,7 +297,15 @@ namespace Oyl::Math
 	{
 		// Flip x and y for some reason
 		// Probably a side effect of how we calculate angles in the model matrix
-		return std::atan2(a_x, a_y) * RAD_TO_DEG;
+	#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+		if constexpr (std::is_same_v<TScalar, float>)
+		{
+			return Fast::Atan2<Fast::engine_accuracy>(a_x, a_y) * RAD_TO_DEG;
+		} else
+	#endif
+		{
+			return std::atan2(a_x, a_y) * RAD_TO_DEG;
+		}
 	}
 	
 	/** 
@@ -69,6 +316,33 @@ namespace Oyl::Math
 	TScalar
 	Asin(TScalar a_x)
 	{
-		return std::asin(a_x) * RAD_TO_DEG;
+	#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+		if constexpr (std::is_same_v<TScalar, float>)
+		{
+			return Fast::Asin<Fast::engine_accuracy>(a_x) * RAD_TO_DEG;
+		} else
+	#endif
+		{
+			return std::asin(a_x) * RAD_TO_DEG;
+		}
+	}
+	
+	/** 
+	 * \return The arc-cos of the ratio a_x
+	 */
+	template<typename TScalar>
+	constexpr
+	TScalar
+	Acos(TScalar a_x)
+	{
+	#if defined(OYL_MATH_FAST_TRIG) && OYL_MATH_FAST_TRIG
+		if constexpr (std::is_same_v<TScalar, float>)
+		{
+			return Fast::Acos<Fast::engine_accuracy>(a_x) * RAD_TO_DEG;
+		} else
+	#endif
+		{
+			return std::acos(a_x) * RAD_TO_DEG;
+		}
 	}
 }
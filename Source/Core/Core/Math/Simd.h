@@ -0,0 +1,6 @@
+#pragma once
+
+#include "Detail/simd_Config.h"
+#include "Detail/simd_Float4.h"
+#include "Detail/simd_Int4.h"
+#include "Detail/simd_Float8.h"
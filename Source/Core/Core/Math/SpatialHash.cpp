@@ -0,0 +1,208 @@
+#include "pch.h"
+#include "SpatialHash.h"
+
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl
+{
+	namespace
+	{
+		uint32
+		NextPowerOfTwo(uint32 a_value)
+		{
+			uint32 result = 1;
+			while (result < a_value)
+			{
+				result <<= 1;
+			}
+			return result;
+		}
+
+		/// \brief The a_task'th of a_taskCount even parts of [0, a_count)
+		void
+		TaskRange(std::size_t a_count, std::size_t a_task, std::size_t a_taskCount, uint32& a_first, uint32& a_last)
+		{
+			a_first = static_cast<uint32>(a_count * a_task / a_taskCount);
+			a_last  = static_cast<uint32>(a_count * (a_task + 1) / a_taskCount);
+		}
+	}
+
+	void
+	SpatialHash::Build(Vector3 const* a_positions, std::size_t a_count, float a_cellSize)
+	{
+		BeginBuild(a_positions, a_count, a_cellSize, 1);
+		for (std::size_t pass = 0; pass < build_pass_count; pass++)
+		{
+			BuildTask(pass, 0);
+		}
+		EndBuild();
+	}
+
+	void
+	SpatialHash::Build(Vector3 const* a_positions, std::size_t a_count, float a_cellSize, WorkerPool& a_pool)
+	{
+		std::size_t const taskCount = BeginBuild(a_positions, a_count, a_cellSize, a_pool.ThreadCount());
+		for (std::size_t pass = 0; pass < build_pass_count; pass++)
+		{
+			a_pool.ParallelFor(taskCount, [this, pass](std::size_t a_task) { BuildTask(pass, a_task); });
+		}
+		EndBuild();
+	}
+
+	std::size_t
+	SpatialHash::BeginBuild(Vector3 const* a_positions, std::size_t a_count, float a_cellSize, std::size_t a_taskCount)
+	{
+		OYL_ASSERT(a_cellSize > 0);
+		OYL_ASSERT(a_count < (1u << 31));
+
+		uint32 const cellCount   = NextPowerOfTwo(std::max<uint32>(static_cast<uint32>(a_count), 1));
+		uint32 const bucketCount = std::min(cellCount, bucket_count);
+
+		m_source          = a_positions;
+		m_cellSize        = a_cellSize;
+		m_inverseCellSize = 1.0f / a_cellSize;
+		m_mask            = cellCount - 1;
+
+		// Both counts are powers of two, a bucket is the cells sharing the high bits of their key
+		m_bucketShift = 0;
+		while ((bucketCount << m_bucketShift) < cellCount)
+		{
+			m_bucketShift++;
+		}
+
+		// Every entry is written by the build, so none are cleared here
+		m_cellStarts.resize(cellCount + 1);
+		m_positions.resize(a_count);
+		m_indices.resize(a_count);
+		m_keys.resize(a_count);
+		m_bucketKeys.resize(a_count);
+		m_bucketIndices.resize(a_count);
+
+		std::size_t const taskCount = std::max<std::size_t>(std::min<std::size_t>(a_taskCount, bucketCount), 1);
+		m_bucketOffsets.resize(taskCount * bucketCount);
+		m_taskTotals.assign(taskCount, 0);
+		return taskCount;
+	}
+
+	void
+	SpatialHash::BuildTask(std::size_t a_pass, std::size_t a_task)
+	{
+		std::size_t const taskCount   = m_taskTotals.size();
+		std::size_t const bucketCount = m_bucketOffsets.size() / taskCount;
+		OYL_ASSERT(a_pass < build_pass_count && a_task < taskCount);
+
+		// Passes 0 and 2 split the points between the tasks, passes 1 and 3 split the buckets. No two tasks of a pass
+		// write the same memory, and the points keep their order within each bucket and cell, so the result doesn't
+		// depend on the task count.
+		uint32* const offsets = m_bucketOffsets.data() + a_task * bucketCount;
+		uint32        first, last;
+		if (a_pass == 0)
+		{
+			std::fill(offsets, offsets + bucketCount, 0u);
+
+			TaskRange(m_positions.size(), a_task, taskCount, first, last);
+			for (uint32 i = first; i < last; i++)
+			{
+				Vector3 const& position = m_source[i];
+				uint32 const   key      = Hash(Cell(position.x), Cell(position.y), Cell(position.z));
+				m_keys[i]               = key;
+				offsets[key >> m_bucketShift]++;
+			}
+			return;
+		}
+
+		if (a_pass == 1)
+		{
+			// Exclusive prefix sum over the task's buckets, and within each bucket over the tasks in order. The
+			// points of earlier tasks' buckets are added in pass 2.
+			TaskRange(bucketCount, a_task, taskCount, first, last);
+			uint32 total = 0;
+			for (uint32 bucket = first; bucket < last; bucket++)
+			{
+				for (std::size_t task = 0; task < taskCount; task++)
+				{
+					uint32& offset = m_bucketOffsets[task * bucketCount + bucket];
+					uint32  count  = offset;
+					offset         = total;
+					total         += count;
+				}
+			}
+			m_taskTotals[a_task] = total;
+			return;
+		}
+
+		if (a_pass == 2)
+		{
+			uint32 base = 0;
+			for (std::size_t task = 0; task < taskCount; task++)
+			{
+				TaskRange(bucketCount, task, taskCount, first, last);
+				for (uint32 bucket = first; bucket < last; bucket++)
+				{
+					offsets[bucket] += base;
+				}
+				base += m_taskTotals[task];
+			}
+
+			TaskRange(m_positions.size(), a_task, taskCount, first, last);
+			for (uint32 i = first; i < last; i++)
+			{
+				uint32 const key  = m_keys[i];
+				uint32 const slot = offsets[key >> m_bucketShift]++;
+				m_bucketKeys[slot]    = key;
+				m_bucketIndices[slot] = i;
+			}
+			return;
+		}
+
+		// Counting sort of the task's buckets into their cells, which are contiguous as are their points
+		TaskRange(bucketCount, a_task, taskCount, first, last);
+		uint32 const  cells  = (last - first) << m_bucketShift;
+		uint32* const starts = m_cellStarts.data() + (first << m_bucketShift);
+		uint32 const  offset = TaskOffset(a_task);
+		uint32 const  end    = offset + m_taskTotals[a_task];
+		uint32 const  base   = first << m_bucketShift;
+
+		std::fill(starts, starts + cells, 0u);
+		for (uint32 slot = offset; slot < end; slot++)
+		{
+			starts[m_bucketKeys[slot] - base]++;
+		}
+
+		uint32 total = offset;
+		for (uint32 i = 0; i < cells; i++)
+		{
+			uint32 cellCount = starts[i];
+			starts[i]        = total;
+			total           += cellCount;
+		}
+
+		// The starts advance as the cells fill, ending at the start of the next cell. Only indices are scattered, the
+		// positions are gathered after in order, which is cheaper than scattering them too.
+		for (uint32 slot = offset; slot < end; slot++)
+		{
+			m_indices[starts[m_bucketKeys[slot] - base]++] = m_bucketIndices[slot];
+		}
+
+		for (uint32 slot = offset; slot < end; slot++)
+		{
+			m_positions[slot] = m_source[m_indices[slot]];
+		}
+
+		for (uint32 i = cells; i-- > 1;)
+		{
+			starts[i] = starts[i - 1];
+		}
+		if (cells > 0)
+		{
+			starts[0] = offset;
+		}
+	}
+
+	void
+	SpatialHash::EndBuild()
+	{
+		m_cellStarts.back() = static_cast<uint32>(m_positions.size());
+		m_source            = nullptr;
+	}
+}
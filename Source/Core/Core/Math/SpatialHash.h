@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Vector3.h"
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	class WorkerPool;
+
+	/**
+	 * \brief Uniform grid over points hashed into a table of cells, for fixed radius neighbour queries over many points
+	 * \remarks Rebuilt from scratch every time the points move, by a counting sort into cell order. The points are
+	 *          stored sorted by cell, so the points of a cell are contiguous and neighbour queries read memory in
+	 *          order. The table has as many cells as the next power of two above the point count.
+	 *      <br>The build can be spread over a WorkerPool, or over another job system with BeginBuild. Queries are const and safe to run from many
+	 *          threads at once, and never allocate.
+	 */
+	class OYL_CORE_API SpatialHash
+	{
+	public:
+		/// Passes of the build, every task of a pass must finish before any task of the next starts
+		constexpr static std::size_t build_pass_count = 4;
+
+		/// Ranges of cells the build first sorts the points into, few enough that scattering into them stays in cache
+		constexpr static uint32 bucket_count = 256;
+
+		/**
+		 * \brief Sorts a_count points into cells of a_cellSize, the whole build on the calling thread
+		 * \param a_cellSize The largest radius ForEachNeighbor accepts, queries are fastest at about this radius
+		 */
+		void
+		Build(Vector3 const* a_positions, std::size_t a_count, float a_cellSize);
+
+		/// \brief Build with every pass split between the threads of a_pool, with the same result
+		void
+		Build(Vector3 const* a_positions, std::size_t a_count, float a_cellSize, WorkerPool& a_pool);
+
+		/**
+		 * \brief Starts a build to be run by BuildTask, then EndBuild
+		 * \param a_taskCount How many tasks to split each pass into, about the number of worker threads
+		 * \return The number of tasks of each pass
+		 * \remarks Run every task of pass 0, then of pass 1 and so on up to build_pass_count. The tasks of one pass
+		 *          may run on different threads at the same time. The result is the same whatever the task count.
+		 *      <br>The points are split between the tasks, each counts its points per bucket of cells, the counts are
+		 *          summed across buckets and tasks, and each task moves its points to their bucket. Then the buckets
+		 *          are split between the tasks, each sorting its buckets' points into cells. Every pass reads each
+		 *          point once in total, so more tasks only add work per bucket.
+		 *      <br>a_positions must stay valid until EndBuild.
+		 */
+		std::size_t
+		BeginBuild(Vector3 const* a_positions, std::size_t a_count, float a_cellSize, std::size_t a_taskCount);
+
+		void
+		BuildTask(std::size_t a_pass, std::size_t a_task);
+
+		void
+		EndBuild();
+
+		/**
+		 * \brief Calls a_func(index, distanceSquared) for every point within a_radius of a_point
+		 * \param a_radius At most the cell size
+		 * \remarks index is the point's index in the array passed to Build. Points are visited cell by cell.
+		 */
+		template<typename TFunc>
+		void
+		ForEachNeighbor(Vector3 const& a_point, float a_radius, TFunc&& a_func) const;
+
+		std::size_t PointCount() const noexcept { return m_positions.size(); }
+
+		std::size_t CellCount() const noexcept { return m_cellStarts.empty() ? 0 : m_cellStarts.size() - 1; }
+
+		float CellSize() const noexcept { return m_cellSize; }
+
+		/// The points in cell order
+		Vector3 const* SortedPositions() const noexcept { return m_positions.data(); }
+
+		/// Index in the array passed to Build of each of SortedPositions()
+		uint32 const* SortedIndices() const noexcept { return m_indices.data(); }
+
+	private:
+		float  m_cellSize        = 1;
+		float  m_inverseCellSize = 1;
+		uint32 m_mask            = 0;
+
+		/// The points of cell i are [m_cellStarts[i], m_cellStarts[i + 1]) of m_positions
+		std::vector<uint32>  m_cellStarts;
+		std::vector<Vector3> m_positions;
+		std::vector<uint32>  m_indices;
+
+		// Only while building, kept between builds to not allocate every frame
+		Vector3 const*      m_source      = nullptr;
+		uint32              m_bucketShift = 0;
+		std::vector<uint32> m_keys;
+		/// Keys and indices of the points in bucket order
+		std::vector<uint32> m_bucketKeys;
+		std::vector<uint32> m_bucketIndices;
+		/// Each task's count of its points per bucket, then where they go, [task * buckets + bucket]
+		std::vector<uint32> m_bucketOffsets;
+		/// Points in each task's range of buckets
+		std::vector<uint32> m_taskTotals;
+
+		/// \brief Where the points of a_task's range of buckets start, once the totals are counted
+		uint32
+		TaskOffset(std::size_t a_task) const
+		{
+			uint32 offset = 0;
+			for (std::size_t task = 0; task < a_task; task++)
+			{
+				offset += m_taskTotals[task];
+			}
+			return offset;
+		}
+
+		/// \brief Floor of a_value in cells, by truncation as std::floor is a library call without SSE4.1
+		int32
+		Cell(float a_value) const
+		{
+			float const scaled    = a_value * m_inverseCellSize;
+			int32 const truncated = static_cast<int32>(scaled);
+			return truncated - (scaled < static_cast<float>(truncated) ? 1 : 0);
+		}
+
+		/// \brief Spatial hash of Teschner et al., 2003
+		uint32
+		Hash(int32 a_x, int32 a_y, int32 a_z) const
+		{
+			return ((static_cast<uint32>(a_x) * 73856093u) ^ (static_cast<uint32>(a_y) * 19349663u) ^ (static_cast<uint32>(a_z) * 83492791u)) & m_mask;
+		}
+	};
+
+	template<typename TFunc>
+	void
+	SpatialHash::ForEachNeighbor(Vector3 const& a_point, float a_radius, TFunc&& a_func) const
+	{
+		OYL_ASSERT(a_radius <= m_cellSize);
+		if (m_positions.empty())
+		{
+			return;
+		}
+
+		// A radius of at most one cell spans three cells per axis, four when a_point ± a_radius rounds outward at
+		// a radius of exactly one cell. Only coordinates whose float spacing is about the cell size reach further,
+		// their cells are clamped so the table entries fit in visited. Cells can share a table entry, which is only
+		// visited once.
+		int32 const minX = Cell(a_point.x - a_radius), maxX = std::min(Cell(a_point.x + a_radius), minX + 3);
+		int32 const minY = Cell(a_point.y - a_radius), maxY = std::min(Cell(a_point.y + a_radius), minY + 3);
+		int32 const minZ = Cell(a_point.z - a_radius), maxZ = std::min(Cell(a_point.z + a_radius), minZ + 3);
+
+		uint32      visited[64];
+		std::size_t visitedCount  = 0;
+		float const radiusSquared = a_radius * a_radius;
+		for (int32 z = minZ; z <= maxZ; z++)
+		{
+			for (int32 y = minY; y <= maxY; y++)
+			{
+				for (int32 x = minX; x <= maxX; x++)
+				{
+					uint32 const cell = Hash(x, y, z);
+					if (std::find(visited, visited + visitedCount, cell) != visited + visitedCount)
+					{
+						continue;
+					}
+					visited[visitedCount++] = cell;
+
+					for (uint32 i = m_cellStarts[cell], end = m_cellStarts[cell + 1]; i < end; i++)
+					{
+						Vector3 const& position = m_positions[i];
+
+						float const dx = position.x - a_point.x;
+						float const dy = position.y - a_point.y;
+						float const dz = position.z - a_point.z;
+						float const distanceSquared = dx * dx + dy * dy + dz * dz;
+						if (distanceSquared <= radiusSquared)
+						{
+							a_func(m_indices[i], distanceSquared);
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,274 @@
+#include "pch.h"
+#include "TransformStream.h"
+
+#include "Simd.h"
+
+#include "Core/Threading/WorkerPool.h"
+
+namespace Oyl::Interpolation
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+		static_assert(Vector4Stream::block_size == block_size);
+
+		/// Eight interpolated transforms in SoA form, the rows of their Matrix4 without the implied last column
+		struct TransformBlock
+		{
+			/// Rotation and scale, linear[row][column]
+			Simd::Float8 linear[3][3];
+			Simd::Float8 translation[3];
+		};
+
+		/// Loads eight values from a_index on, copying them out first where the load would run past the padding
+		Simd::Float8
+		LoadLanes(float const* a_component, std::size_t a_index, std::size_t a_paddedCount)
+		{
+			if (a_index + block_size <= a_paddedCount)
+			{
+				return Simd::Load8(a_component + a_index);
+			}
+
+			alignas(32) float padded[block_size] = { 0 };
+			for (std::size_t i = 0; a_index + i < a_paddedCount; i++)
+			{
+				padded[i] = a_component[a_index + i];
+			}
+			return Simd::Load8(padded);
+		}
+
+		/// \brief Lerps component a_component of two streams
+		template<int Size>
+		Simd::Float8
+		Lerp(VectorStream_t<Size> const& a_previous, VectorStream_t<Size> const& a_current, int a_component, std::size_t a_index, Simd::Float8 a_alpha)
+		{
+			Simd::Float8 previous = LoadLanes(a_previous.Component(a_component), a_index, a_previous.PaddedCount());
+			Simd::Float8 current  = LoadLanes(a_current.Component(a_component), a_index, a_current.PaddedCount());
+			return Simd::MulAdd(Simd::Sub(current, previous), a_alpha, previous);
+		}
+
+		/// Same series as the slerp weights of Quaternion::SlerpBatch, eight lanes wide
+		Simd::Float8
+		SlerpWeight(Simd::Float8 a_t, Simd::Float8 a_cosThetaMinusOne)
+		{
+			constexpr int   term_count  = 8;
+			constexpr float one_plus_mu = 1.85298109f;
+
+			constexpr float u[term_count] = {
+				1.0f / (1 * 3), 1.0f / (2 * 5), 1.0f / (3 * 7),  1.0f / (4 * 9),
+				1.0f / (5 * 11), 1.0f / (6 * 13), 1.0f / (7 * 15), one_plus_mu / (8 * 17)
+			};
+			constexpr float v[term_count] = {
+				1.0f / 3, 2.0f / 5, 3.0f / 7, 4.0f / 9,
+				5.0f / 11, 6.0f / 13, 7.0f / 15, one_plus_mu * 8 / 17
+			};
+
+			Simd::Float8 one     = Simd::Splat8(1);
+			Simd::Float8 tSquare = Simd::Mul(a_t, a_t);
+
+			Simd::Float8 result = one;
+			for (int i = term_count - 1; i >= 0; i--)
+			{
+				Simd::Float8 b = Simd::Mul(
+					Simd::Sub(Simd::Mul(Simd::Splat8(u[i]), tSquare), Simd::Splat8(v[i])),
+					a_cosThetaMinusOne
+				);
+				result = Simd::MulAdd(b, result, one);
+			}
+			return Simd::Mul(a_t, result);
+		}
+
+		TransformBlock
+		InterpolateBlock(TransformStream const& a_previous, TransformStream const& a_current, std::size_t a_index, Simd::Float8 a_alpha)
+		{
+			TransformBlock result;
+			for (int c = 0; c < 3; c++)
+			{
+				result.translation[c] = Lerp(a_previous.translations, a_current.translations, c, a_index, a_alpha);
+			}
+
+			Simd::Float8 previous[4], current[4];
+			for (int c = 0; c < 4; c++)
+			{
+				previous[c] = LoadLanes(a_previous.rotations.Component(c), a_index, a_previous.rotations.PaddedCount());
+				current[c]  = LoadLanes(a_current.rotations.Component(c), a_index, a_current.rotations.PaddedCount());
+			}
+
+			// Shortest arc slerp, see Quaternion::SlerpBatch
+			Simd::Float8 cosTheta = Simd::Mul(previous[0], current[0]);
+			for (int c = 1; c < 4; c++)
+			{
+				cosTheta = Simd::MulAdd(previous[c], current[c], cosTheta);
+			}
+			Simd::Float8 cosThetaMinusOne = Simd::Sub(Simd::Abs(cosTheta), Simd::Splat8(1));
+
+			Simd::Float8 previousWeight = SlerpWeight(Simd::Sub(Simd::Splat8(1), a_alpha), cosThetaMinusOne);
+			Simd::Float8 currentWeight  = Simd::FlipSign(SlerpWeight(a_alpha, cosThetaMinusOne), cosTheta);
+
+			Simd::Float8 q[4];
+			for (int c = 0; c < 4; c++)
+			{
+				q[c] = Simd::MulAdd(current[c], currentWeight, Simd::Mul(previous[c], previousWeight));
+			}
+
+			Simd::Float8 x2 = Simd::Add(q[0], q[0]);
+			Simd::Float8 y2 = Simd::Add(q[1], q[1]);
+			Simd::Float8 z2 = Simd::Add(q[2], q[2]);
+
+			Simd::Float8 xx = Simd::Mul(q[0], x2), yy = Simd::Mul(q[1], y2), zz = Simd::Mul(q[2], z2);
+			Simd::Float8 xy = Simd::Mul(q[0], y2), xz = Simd::Mul(q[0], z2), yz = Simd::Mul(q[1], z2);
+			Simd::Float8 wx = Simd::Mul(q[3], x2), wy = Simd::Mul(q[3], y2), wz = Simd::Mul(q[3], z2);
+
+			Simd::Float8 const one = Simd::Splat8(1);
+
+			// Quaternion::ToMatrix3, with row i scaled by scale i as in Affine::FromTRS
+			Simd::Float8 const rotation[3][3] = {
+				{ Simd::Sub(Simd::Sub(one, yy), zz), Simd::Add(xy, wz), Simd::Sub(xz, wy) },
+				{ Simd::Sub(xy, wz), Simd::Sub(Simd::Sub(one, xx), zz), Simd::Add(yz, wx) },
+				{ Simd::Add(xz, wy), Simd::Sub(yz, wx), Simd::Sub(Simd::Sub(one, xx), yy) },
+			};
+			for (int row = 0; row < 3; row++)
+			{
+				Simd::Float8 scale = Lerp(a_previous.scales, a_current.scales, row, a_index, a_alpha);
+				for (int column = 0; column < 3; column++)
+				{
+					result.linear[row][column] = Simd::Mul(rotation[row][column], scale);
+				}
+			}
+			return result;
+		}
+
+		/// \brief Writes a_lanes of the four transforms in half a_half of a_block
+		void
+		StoreHalf(TransformBlock const& a_block, int a_half, std::size_t a_lanes, Matrix4* a_out)
+		{
+			auto half = [a_half](Simd::Float8 a_value) { return a_half == 0 ? Simd::Low(a_value) : Simd::High(a_value); };
+
+			// After transposing, rows[i][j] holds row i of the j-th matrix
+			Simd::Float4 rows[4][4];
+			for (int row = 0; row < 3; row++)
+			{
+				rows[row][0] = half(a_block.linear[row][0]);
+				rows[row][1] = half(a_block.linear[row][1]);
+				rows[row][2] = half(a_block.linear[row][2]);
+				rows[row][3] = Simd::Zero();
+			}
+			rows[3][0] = half(a_block.translation[0]);
+			rows[3][1] = half(a_block.translation[1]);
+			rows[3][2] = half(a_block.translation[2]);
+			rows[3][3] = Simd::Splat(1);
+
+			for (auto& row : rows)
+			{
+				Simd::Transpose(row[0], row[1], row[2], row[3]);
+			}
+
+			for (std::size_t j = 0; j < a_lanes; j++)
+			{
+				float* dst = a_out[j].data;
+				Simd::Store(dst + 0,  rows[0][j]);
+				Simd::Store(dst + 4,  rows[1][j]);
+				Simd::Store(dst + 8,  rows[2][j]);
+				Simd::Store(dst + 12, rows[3][j]);
+			}
+		}
+
+		void
+		StoreHalf(TransformBlock const& a_block, int a_half, std::size_t a_lanes, Affine3* a_out)
+		{
+			auto half = [a_half](Simd::Float8 a_value) { return a_half == 0 ? Simd::Low(a_value) : Simd::High(a_value); };
+
+			// An Affine3 column is a column of the linear part followed by that axis' translation, see Affine_t
+			Simd::Float4 columns[3][4];
+			for (int column = 0; column < 3; column++)
+			{
+				columns[column][0] = half(a_block.linear[0][column]);
+				columns[column][1] = half(a_block.linear[1][column]);
+				columns[column][2] = half(a_block.linear[2][column]);
+				columns[column][3] = half(a_block.translation[column]);
+				Simd::Transpose(columns[column][0], columns[column][1], columns[column][2], columns[column][3]);
+			}
+
+			for (std::size_t j = 0; j < a_lanes; j++)
+			{
+				float* dst = a_out[j].data;
+				Simd::Store(dst + 0, columns[0][j]);
+				Simd::Store(dst + 4, columns[1][j]);
+				Simd::Store(dst + 8, columns[2][j]);
+			}
+		}
+
+		template<typename TOutput>
+		void
+		Interpolate(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, std::size_t a_first, std::size_t a_count, TOutput* a_out)
+		{
+			OYL_ASSERT(a_previous.Count() == a_current.Count());
+			OYL_ASSERT(a_first + a_count <= a_current.Count());
+
+			constexpr std::size_t half_size = block_size / 2;
+
+			Simd::Float8 alpha = Simd::Splat8(a_alpha);
+			for (std::size_t i = 0; i < a_count; i += block_size)
+			{
+				std::size_t lanes = std::min(block_size, a_count - i);
+
+				TransformBlock block = InterpolateBlock(a_previous, a_current, a_first + i, alpha);
+				StoreHalf(block, 0, std::min(lanes, half_size), a_out + i);
+				if (lanes > half_size)
+				{
+					StoreHalf(block, 1, lanes - half_size, a_out + i + half_size);
+				}
+			}
+		}
+
+		template<typename TOutput>
+		void
+		InterpolateParallel(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, TOutput* a_out, WorkerPool& a_pool)
+		{
+			// Ranges of whole blocks, so every range loads the streams from the start of a block
+			std::size_t const count = a_current.Count();
+			a_pool.ParallelForRanges((count + block_size - 1) / block_size, [&](std::size_t a_firstBlock, std::size_t a_lastBlock)
+			{
+				std::size_t const first = a_firstBlock * block_size;
+				std::size_t const last  = std::min(a_lastBlock * block_size, count);
+				Interpolate(a_previous, a_current, a_alpha, first, last - first, a_out + first);
+			});
+		}
+	}
+
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Matrix4* a_out)
+	{
+		Interpolate(a_previous, a_current, a_alpha, 0, a_current.Count(), a_out);
+	}
+
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Affine3* a_out)
+	{
+		Interpolate(a_previous, a_current, a_alpha, 0, a_current.Count(), a_out);
+	}
+
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Matrix4* a_out, WorkerPool& a_pool)
+	{
+		InterpolateParallel(a_previous, a_current, a_alpha, a_out, a_pool);
+	}
+
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Affine3* a_out, WorkerPool& a_pool)
+	{
+		InterpolateParallel(a_previous, a_current, a_alpha, a_out, a_pool);
+	}
+
+	void
+	TransformRange(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, std::size_t a_first, std::size_t a_count, Matrix4* a_out)
+	{
+		Interpolate(a_previous, a_current, a_alpha, a_first, a_count, a_out);
+	}
+
+	void
+	TransformRange(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, std::size_t a_first, std::size_t a_count, Affine3* a_out)
+	{
+		Interpolate(a_previous, a_current, a_alpha, a_first, a_count, a_out);
+	}
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Affine3.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+
+namespace Oyl
+{
+	class WorkerPool;
+
+	/**
+	 * \brief Translation, rotation and scale of many transforms, one stream per channel
+	 * \remarks Made for simulations that step at Time::FixedDeltaTime() and render in between. Keep the state
+	 *          before and after the last fixed step, copy the current state over the previous one before each
+	 *          step, and interpolate between the two once per rendered frame, see Interpolation::TransformBatch.
+	 *      <br>Transforms scale, then rotate, then translate, like Affine::FromTRS.
+	 */
+	struct TransformStream
+	{
+		Vector3Stream translations;
+		/// Quaternions as (x, y, z, w), expected to be normalized
+		Vector4Stream rotations;
+		Vector3Stream scales;
+
+		std::size_t
+		Count() const noexcept { return translations.Count(); }
+
+		/// \brief Resizes every channel, new transforms are the identity
+		void
+		Resize(std::size_t a_count)
+		{
+			std::size_t previousCount = Count();
+
+			translations.Resize(a_count);
+			rotations.Resize(a_count);
+			scales.Resize(a_count);
+
+			for (std::size_t i = previousCount; i < a_count; i++)
+			{
+				rotations.W()[i] = 1.0f;
+				scales.X()[i]    = 1.0f;
+				scales.Y()[i]    = 1.0f;
+				scales.Z()[i]    = 1.0f;
+			}
+		}
+
+		void
+		Set(std::size_t a_index, Vector3 const& a_translation, Quaternionf const& a_rotation, Vector3 const& a_scale)
+		{
+			translations.Set(a_index, a_translation);
+			rotations.Set(a_index, Vector4(a_rotation));
+			scales.Set(a_index, a_scale);
+		}
+	};
+}
+
+namespace Oyl::Interpolation
+{
+	// Translations and scales are lerped and rotations slerped by a_alpha, 0 gives a_previous and 1 gives
+	// a_current exactly. Slerp uses the same polynomial as Quaternion::SlerpBatch, with the same accuracy.
+	// Eight transforms are interpolated per iteration and written straight to a_out in their final layout.
+	// Both states must have the same Count(), a_alpha usually comes from Time::FixedStepAlpha.
+
+	/// \brief a_out[i] = Matrix4 of transform i, a_out must hold at least a_previous.Count() matrices
+	OYL_CORE_API
+	extern
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Matrix4* a_out);
+
+	/// \brief a_out[i] = Affine3 of transform i, a_out must hold at least a_previous.Count() transforms
+	OYL_CORE_API
+	extern
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Affine3* a_out);
+
+	/// \brief TransformBatch with the transforms split between the threads of a_pool, with the same result
+	OYL_CORE_API
+	extern
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Matrix4* a_out, WorkerPool& a_pool);
+
+	OYL_CORE_API
+	extern
+	void
+	TransformBatch(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, Affine3* a_out, WorkerPool& a_pool);
+
+	/**
+	 * \brief Interpolates transforms [a_first, a_first + a_count), a_out points at the first of them
+	 * \remarks Transforms are independent, so a large stream can be split into ranges handled by different worker
+	 *          threads writing to disjoint parts of the same buffer, with the same result as TransformBatch.
+	 *          This is what the WorkerPool overloads do, other job systems can split the ranges the same way.
+	 */
+	OYL_CORE_API
+	extern
+	void
+	TransformRange(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, std::size_t a_first, std::size_t a_count, Matrix4* a_out);
+
+	OYL_CORE_API
+	extern
+	void
+	TransformRange(TransformStream const& a_previous, TransformStream const& a_current, float a_alpha, std::size_t a_first, std::size_t a_count, Affine3* a_out);
+}
@@ -2,10 +2,17 @@
 
 #include "Matrix3.h"
 #include "Matrix4.h"
+#include "Scalar.h"
 #include "Vector3.h"
+#include "Vector4.h"
 
 #include "Core/Common.h"
 
+/**
+ * The builders are constexpr so constant projections and basis changes are computed by the compiler,
+ * ie. constexpr Matrix4 projection = Matrix::Perspective(90, 9.0f / 16.0f, 0.1f, 1000.0f);
+ * At runtime they take the same libm or Math::Fast path as before, see Math::SinCos.
+ */
 namespace Oyl::Matrix
 {
 	/**
@@ -15,75 +22,157 @@ namespace Oyl::Matrix
 	 * \param a_farPlane The far plane in units
 	 * \return A 4x4 row-major perspective matrix
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix4
-	Perspective(float a_fieldOfView, float a_aspectRatio, float a_nearPlane, float a_farPlane);
+	Perspective(float a_fieldOfView, float a_aspectRatio, float a_nearPlane, float a_farPlane)
+	{
+		float focalLength = 1.0f / Math::Tan(a_fieldOfView * 0.5f);
+
+		return Matrix4(
+			Vector4(a_aspectRatio * focalLength, 0, 0, 0),
+			Vector4(0, focalLength, 0, 0),
+			Vector4(0, 0, a_farPlane / (a_farPlane - a_nearPlane), 1),
+			Vector4(0, 0, (-a_farPlane * a_nearPlane) / (a_farPlane - a_nearPlane), 0)
+		);
+	}
 	
 	/**
 	 * \param a_angle The angle in degrees by which to rotate
 	 * \return A 3x3 row-major matrix representing a rotation about the x axis in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix3
-	RotateX(float a_angle);
+	RotateX(float a_angle)
+	{
+		float sin = 0, cos = 0;
+		Math::SinCos(a_angle, sin, cos);
+
+		return Matrix3(
+			Vector3(1,    0,   0),
+			Vector3(0,  cos, sin),
+			Vector3(0, -sin, cos)
+		);
+	}
 
 	/**
 	 * \param a_angle The angle in degrees by which to rotate
 	 * \return A 3x3 row-major matrix representing a rotation about the y axis in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix3
-	RotateY(float a_angle);
+	RotateY(float a_angle)
+	{
+		float sin = 0, cos = 0;
+		Math::SinCos(a_angle, sin, cos);
+
+		return Matrix3(
+			Vector3( cos, 0, sin),
+			Vector3(   0, 1,   0),
+			Vector3(-sin, 0, cos)
+		);
+	}
 
 	/**
 	 * \param a_angle The angle in degrees by which to rotate
 	 * \return A 3x3 row-major matrix representing a rotation about the z axis in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix3
-	RotateZ(float a_angle);
+	RotateZ(float a_angle)
+	{
+		float sin = 0, cos = 0;
+		Math::SinCos(a_angle, sin, cos);
+
+		return Matrix3(
+			Vector3( cos, sin, 0),
+			Vector3(-sin, cos, 0),
+			Vector3(   0,   0, 1)
+		);
+	}
 
 	/**
 	 * \param a_angle The angle in degrees by which to rotate around the axis
 	 * \param a_axis The axis around which to rotate
 	 * \return A 3x3 row-major matrix representing a rotation about the given axis in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix3
-	Rotate(float a_angle, Vector3 a_axis);
+	Rotate(float a_angle, Vector3 a_axis)
+	{
+		Vector3 u = Vector::Normalize(a_axis);
+
+		// Through data, the union member the constructors initialize, so this also works in constant expressions
+		float x = u.data[0];
+		float y = u.data[1];
+		float z = u.data[2];
+
+		float sin_theta = 0, cos_theta = 0;
+		Math::SinCos(a_angle, sin_theta, cos_theta);
+
+		float one_minus_cos_theta = 1 - cos_theta;
+
+		return Matrix3(
+			Vector3(
+				cos_theta + Math::Square(x) * one_minus_cos_theta,
+				y * x * one_minus_cos_theta + z * sin_theta,
+				z * x * one_minus_cos_theta - y * sin_theta
+			),
+			Vector3(
+				x * y * one_minus_cos_theta - z * sin_theta,
+				cos_theta + Math::Square(y) * one_minus_cos_theta,
+				z * y * one_minus_cos_theta + x * sin_theta
+			),
+			Vector3(
+				x * z * one_minus_cos_theta + y * sin_theta,
+				y * z * one_minus_cos_theta - x * sin_theta,
+				cos_theta + Math::Square(z) * one_minus_cos_theta
+			)
+		);
+	}
 	
 	/**
 	 * \param a_scale The amount by which to scale
 	 * \return A 3x3 row-major matrix representing a scaling operation in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix4
-	Scale(Vector3 a_scale);
+	Scale(Vector3 a_scale)
+	{
+		return Matrix4(
+			Vector4(a_scale.data[0], 0, 0, 0),
+			Vector4(0, a_scale.data[1], 0, 0),
+			Vector4(0, 0, a_scale.data[2], 0),
+			Vector4(0, 0, 0, 1)
+		);
+	}
 
 	/**
 	 * \param a_position The position by which to translate
 	 * \return A 4x4 row-major matrix representing a transformation in 3D space
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix4
-	Translate(Vector3 a_position);
+	Translate(Vector3 a_position)
+	{
+		return Matrix4(
+			Vector4(1, 0, 0, 0),
+			Vector4(0, 1, 0, 0),
+			Vector4(0, 0, 1, 0),
+			Vector4(a_position, 1)
+		);
+	}
 
 	/**
-	 * \brief A quick algorithm for computing the view matrix given a loc-rot matrix
+	 * \brief A quick algorithm for computing the view matrix given a loc-rot matrix, see Matrix::InverseRigid
 	 * \param a_locRot The Model matrix for the object that represents a camera in 3D space
 	 * \return A 4x4 row-major matrix representing an inverse view matrix
 	 */
-	OYL_CORE_API
-	extern
+	constexpr
 	Matrix4
-	ViewInverse(Matrix4 a_locRot);
+	ViewInverse(Matrix4 a_locRot)
+	{
+		return InverseRigid(a_locRot);
+	}
 
 	/**
 	 * \brief Construct a 4x4 look-at transformation matrix from the given arguments
@@ -91,10 +180,25 @@ namespace Oyl::Matrix
 	 * \param a_target The point to look at
 	 * \param a_up The up-vector relative to the observer
 	 */
-	OYL_CORE_API
-	extern
+	// inspired by https://github.com/OneLoneCoder/videos/blob/master/OneLoneCoder_olcEngine3D_Part3.cpp
+	constexpr
 	Matrix4
-	LookAt(Vector3 a_position, Vector3 a_target, Vector3 a_up = Vector3::Up());
+	LookAt(Vector3 a_position, Vector3 a_target, Vector3 a_up = Vector3::Up())
+	{
+		Vector3 newForward = Vector::Normalize(a_target - a_position);
+
+		Vector3 a = newForward * Vector::Dot(a_up, newForward);
+		Vector3 newUp = Vector::Normalize(a_up - a);
+
+		Vector3 newRight = Vector::Cross(newUp, newForward);
+
+		return Matrix4(
+			Vector4(newRight,   0.0f),
+			Vector4(newUp,      0.0f),
+			Vector4(newForward, 0.0f),
+			Vector4(a_position, 1.0f)
+		);
+	}
 
 	/**
 	 * \brief Reconstruct one possible set of euler angles from the given rotation matrix
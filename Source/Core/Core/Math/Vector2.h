@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Half.h"
+
 #include "Detail/type_Vector2.h"
 
 namespace Oyl
@@ -14,4 +16,7 @@ namespace Oyl
 	
 	typedef Vector_t<2, unsigned int> Vector2u;
 	static_assert(sizeof(Vector2u) == sizeof(Vector2u::data));
+	
+	typedef Vector_t<2, half> Vector2h;
+	static_assert(sizeof(Vector2h) == sizeof(Vector2h::data));
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Half.h"
+
 #include "Detail/type_Vector3.h"
 
 namespace Oyl
@@ -14,4 +16,7 @@ namespace Oyl
 	
 	typedef Vector_t<3, unsigned int> Vector3u;
 	static_assert(sizeof(Vector3u) == sizeof(Vector3u::data));
+	
+	typedef Vector_t<3, half> Vector3h;
+	static_assert(sizeof(Vector3h) == sizeof(Vector3h::data));
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Half.h"
+
 #include "Detail/type_Vector4.h"
 
 namespace Oyl
@@ -14,4 +16,7 @@ namespace Oyl
 	
 	typedef Vector_t<4, unsigned int> Vector4u;
 	static_assert(sizeof(Vector4u) == sizeof(Vector4u::data));
+	
+	typedef Vector_t<4, half> Vector4h;
+	static_assert(sizeof(Vector4h) == sizeof(Vector4h::data));
 }
\ No newline at end of file
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "Simd.h"
+#include "Vector.h"
+#include "VectorStream.h"
+
+#include "Core/Common.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Deferred arithmetic on vectors and vector streams, evaluated in a single pass when assigned.
+	 * \remarks Every operator on Vector_t returns a finished vector, so a*s + b*t - c stores and reloads
+	 *          three temporaries, and the same chain written over streams would walk the arrays once per operator.
+	 *          Wrapping an operand in Vector::Lazy opts it in: +, -, * and / with an expression on either side build a
+	 *          tree of nodes instead, and nothing is computed until the expression is converted to a Vector_t,
+	 *          passed to Vector::Evaluate, or written into a stream with Vector::Assign.
+	 *          Operators between two plain Vector_t's stay eager, so each product needs its own Lazy.
+	 *          \code
+	 *          Vector3 position = Vector::Lazy(a) * s + Vector::Lazy(b) * t - c;
+	 *          Vector::Assign(positions, Vector::Lazy(positions) + Vector::Lazy(velocities) * deltaTime);
+	 *          \endcode
+	 *      <br>The operations and their order are those of the eager operators, so the results match them exactly,
+	 *          except where the compiler contracts a multiply and an add into an FMA in one form but not the other.
+	 *      <br>Nodes refer to their operands instead of copying them. Evaluate an expression within the statement
+	 *          that builds it, holding one in an auto variable past the lifetime of a temporary operand dangles.
+	 */
+	template<typename TNode>
+	struct VectorExpression
+	{
+		using value_type = typename TNode::value_type;
+		using result_type = Vector_t<TNode::size, value_type>;
+
+		constexpr static int  size      = TNode::size;
+		constexpr static bool is_stream = TNode::is_stream;
+
+		TNode node;
+
+		/// \brief Evaluates the expression, allowing it wherever a Vector_t is expected, ie. Vector::Dot(Vector3(e), b)
+		constexpr
+		operator result_type() const noexcept;
+	};
+
+	namespace Detail
+	{
+		/// \brief A Vector_t operand, read one element or one register at a time
+		template<int Size, typename TUnderlying>
+		struct VectorNode
+		{
+			using value_type = TUnderlying;
+
+			constexpr static int  size      = Size;
+			constexpr static bool is_stream = false;
+
+			Vector_t<Size, TUnderlying> const& value;
+
+			constexpr TUnderlying Element(int a_index) const noexcept { return value.data[a_index]; }
+
+			OYL_FORCE_INLINE Simd::Float4 Lanes() const noexcept { return LoadVector(value); }
+
+			/// \brief Inside a stream expression, the same vector is applied to every element
+			OYL_FORCE_INLINE Simd::Float8 Block(int a_component, std::size_t) const noexcept { return Simd::Splat8(value.data[a_component]); }
+
+			constexpr std::size_t Count() const noexcept { return 0; }
+		};
+
+		/// \brief A scalar operand, applied to every component
+		template<int Size, typename TUnderlying>
+		struct ScalarNode
+		{
+			using value_type = TUnderlying;
+
+			constexpr static int  size      = Size;
+			constexpr static bool is_stream = false;
+
+			TUnderlying value;
+
+			constexpr TUnderlying Element(int) const noexcept { return value; }
+
+			OYL_FORCE_INLINE Simd::Float4 Lanes() const noexcept { return Simd::Splat(value); }
+
+			OYL_FORCE_INLINE Simd::Float8 Block(int, std::size_t) const noexcept { return Simd::Splat8(value); }
+
+			constexpr std::size_t Count() const noexcept { return 0; }
+		};
+
+		/// \brief A vector stream operand, read block_size elements of one component at a time
+		template<int Size>
+		struct StreamNode
+		{
+			using value_type = float;
+
+			constexpr static int  size      = Size;
+			constexpr static bool is_stream = true;
+
+			VectorStream_t<Size> const& value;
+
+			OYL_FORCE_INLINE Simd::Float8 Block(int a_component, std::size_t a_index) const noexcept { return Simd::Load8(value.Component(a_component) + a_index); }
+
+			std::size_t Count() const noexcept { return value.Count(); }
+		};
+
+		// Operations applied by BinaryNode and UnaryNode, one overload per kind of evaluation
+
+		struct AddOperation
+		{
+			template<typename T> constexpr static T Element(T a_lhs, T a_rhs) noexcept { return a_lhs + a_rhs; }
+			OYL_FORCE_INLINE static Simd::Float4 Lanes(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept { return Simd::Add(a_lhs, a_rhs); }
+			OYL_FORCE_INLINE static Simd::Float8 Block(Simd::Float8 a_lhs, Simd::Float8 a_rhs) noexcept { return Simd::Add(a_lhs, a_rhs); }
+		};
+
+		struct SubOperation
+		{
+			template<typename T> constexpr static T Element(T a_lhs, T a_rhs) noexcept { return a_lhs - a_rhs; }
+			OYL_FORCE_INLINE static Simd::Float4 Lanes(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept { return Simd::Sub(a_lhs, a_rhs); }
+			OYL_FORCE_INLINE static Simd::Float8 Block(Simd::Float8 a_lhs, Simd::Float8 a_rhs) noexcept { return Simd::Sub(a_lhs, a_rhs); }
+		};
+
+		struct MulOperation
+		{
+			template<typename T> constexpr static T Element(T a_lhs, T a_rhs) noexcept { return a_lhs * a_rhs; }
+			OYL_FORCE_INLINE static Simd::Float4 Lanes(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept { return Simd::Mul(a_lhs, a_rhs); }
+			OYL_FORCE_INLINE static Simd::Float8 Block(Simd::Float8 a_lhs, Simd::Float8 a_rhs) noexcept { return Simd::Mul(a_lhs, a_rhs); }
+		};
+
+		struct DivOperation
+		{
+			template<typename T> constexpr static T Element(T a_lhs, T a_rhs) noexcept { return a_lhs / a_rhs; }
+			OYL_FORCE_INLINE static Simd::Float4 Lanes(Simd::Float4 a_lhs, Simd::Float4 a_rhs) noexcept { return Simd::Div(a_lhs, a_rhs); }
+			OYL_FORCE_INLINE static Simd::Float8 Block(Simd::Float8 a_lhs, Simd::Float8 a_rhs) noexcept { return Simd::Div(a_lhs, a_rhs); }
+		};
+
+		struct NegateOperation
+		{
+			template<typename T> constexpr static T Element(T a_value) noexcept { return -a_value; }
+			OYL_FORCE_INLINE static Simd::Float4 Lanes(Simd::Float4 a_value) noexcept { return Simd::Negate(a_value); }
+			OYL_FORCE_INLINE static Simd::Float8 Block(Simd::Float8 a_value) noexcept { return Simd::Negate(a_value); }
+		};
+
+		template<typename TLhs, typename TRhs, typename TOperation>
+		struct BinaryNode
+		{
+			static_assert(TLhs::size == TRhs::size, "Both sides of a vector expression need the same number of components");
+			static_assert(std::is_same_v<typename TLhs::value_type, typename TRhs::value_type>, "Both sides of a vector expression need the same underlying type");
+
+			using value_type = typename TLhs::value_type;
+
+			constexpr static int  size      = TLhs::size;
+			constexpr static bool is_stream = TLhs::is_stream || TRhs::is_stream;
+
+			TLhs lhs;
+			TRhs rhs;
+
+			constexpr value_type Element(int a_index) const noexcept { return TOperation::Element(lhs.Element(a_index), rhs.Element(a_index)); }
+
+			OYL_FORCE_INLINE Simd::Float4 Lanes() const noexcept { return TOperation::Lanes(lhs.Lanes(), rhs.Lanes()); }
+
+			OYL_FORCE_INLINE Simd::Float8 Block(int a_component, std::size_t a_index) const noexcept
+			{
+				return TOperation::Block(lhs.Block(a_component, a_index), rhs.Block(a_component, a_index));
+			}
+
+			/// \return The number of elements of the streams in the expression, which must all be the same
+			std::size_t
+			Count() const noexcept
+			{
+				if constexpr (TLhs::is_stream && TRhs::is_stream)
+				{
+					OYL_ASSERT(lhs.Count() == rhs.Count());
+				}
+				return TLhs::is_stream ? lhs.Count() : rhs.Count();
+			}
+		};
+
+		template<typename TValue, typename TOperation>
+		struct UnaryNode
+		{
+			using value_type = typename TValue::value_type;
+
+			constexpr static int  size      = TValue::size;
+			constexpr static bool is_stream = TValue::is_stream;
+
+			TValue value;
+
+			constexpr value_type Element(int a_index) const noexcept { return TOperation::Element(value.Element(a_index)); }
+
+			OYL_FORCE_INLINE Simd::Float4 Lanes() const noexcept { return TOperation::Lanes(value.Lanes()); }
+
+			OYL_FORCE_INLINE Simd::Float8 Block(int a_component, std::size_t a_index) const noexcept { return TOperation::Block(value.Block(a_component, a_index)); }
+
+			std::size_t Count() const noexcept { return value.Count(); }
+		};
+
+		template<typename TLhs, typename TRhs, typename TOperation>
+		constexpr
+		VectorExpression<BinaryNode<TLhs, TRhs, TOperation>>
+		MakeBinary(TLhs const& a_lhs, TRhs const& a_rhs, TOperation) noexcept
+		{
+			return { { a_lhs, a_rhs } };
+		}
+	}
+
+	namespace Vector
+	{
+		/// \brief Starts a deferred expression on a_value, see VectorExpression
+		template<int Size, typename TUnderlying>
+		constexpr
+		VectorExpression<Detail::VectorNode<Size, TUnderlying>>
+		Lazy(Vector_t<Size, TUnderlying> const& a_value) noexcept
+		{
+			return { { a_value } };
+		}
+
+		/// \brief Starts a deferred expression over every element of a_stream, see VectorExpression and Vector::Assign
+		template<int Size>
+		VectorExpression<Detail::StreamNode<Size>>
+		Lazy(VectorStream_t<Size> const& a_stream) noexcept
+		{
+			return { { a_stream } };
+		}
+
+		/**
+		 * \brief Evaluates a_expression in one pass, through a single Simd::Float4 sequence for 3 and 4 component
+		 *        float vectors and a single loop over the components otherwise
+		 */
+		template<typename TNode>
+		constexpr
+		typename VectorExpression<TNode>::result_type
+		Evaluate(VectorExpression<TNode> const& a_expression) noexcept
+		{
+			static_assert(!TNode::is_stream, "Expressions over streams are written into a stream with Vector::Assign");
+
+			using value_type = typename TNode::value_type;
+
+			if constexpr (Detail::use_simd_vector_v<TNode::size, value_type>)
+			{
+				if (!OYL_IS_CONSTANT_EVALUATED())
+				{
+					return Detail::StoreVector<TNode::size>(a_expression.node.Lanes());
+				}
+			}
+
+			typename VectorExpression<TNode>::result_type result {};
+			for (int i = 0; i < TNode::size; i++)
+			{
+				result.data[i] = a_expression.node.Element(i);
+			}
+			return result;
+		}
+
+		/**
+		 * \brief a_out[i] = a_expression evaluated for element i of its streams, in a single pass over the arrays
+		 * \remarks Each resizes a_out to match the streams in the expression, which must all have the same count.
+		 *          a_out may be one of the streams in the expression, ie. Assign(p, Lazy(p) + Lazy(v) * dt).
+		 *          Vector_t and scalar operands are applied to every element.
+		 */
+		template<int Size, typename TNode>
+		void
+		Assign(VectorStream_t<Size>& a_out, VectorExpression<TNode> const& a_expression)
+		{
+			static_assert(TNode::is_stream, "The expression has no stream to take the element count from");
+			static_assert(TNode::size == Size, "The expression has a different number of components than the stream");
+
+			a_out.Resize(a_expression.node.Count());
+
+			for (std::size_t i = 0; i < a_out.PaddedCount(); i += VectorStream_t<Size>::block_size)
+			{
+				for (int c = 0; c < Size; c++)
+				{
+					Simd::Store(a_out.Component(c) + i, a_expression.node.Block(c, i));
+				}
+			}
+		}
+	}
+
+	template<typename TNode>
+	constexpr
+	VectorExpression<TNode>::operator result_type() const noexcept
+	{
+		return Vector::Evaluate(*this);
+	}
+
+	// Each operator takes an expression on at least one side, so plain Vector_t arithmetic stays eager
+	#define _VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR(_operator_, _operation_) \
+		template<typename TLhs, typename TRhs> \
+		constexpr \
+		auto \
+		operator _operator_(VectorExpression<TLhs> const& a_lhs, VectorExpression<TRhs> const& a_rhs) noexcept \
+		{ \
+			return Detail::MakeBinary(a_lhs.node, a_rhs.node, Detail::_operation_()); \
+		} \
+		\
+		template<typename TLhs, int Size, typename TUnderlying> \
+		constexpr \
+		auto \
+		operator _operator_(VectorExpression<TLhs> const& a_lhs, Vector_t<Size, TUnderlying> const& a_rhs) noexcept \
+		{ \
+			return Detail::MakeBinary(a_lhs.node, Detail::VectorNode<Size, TUnderlying> { a_rhs }, Detail::_operation_()); \
+		} \
+		\
+		template<int Size, typename TUnderlying, typename TRhs> \
+		constexpr \
+		auto \
+		operator _operator_(Vector_t<Size, TUnderlying> const& a_lhs, VectorExpression<TRhs> const& a_rhs) noexcept \
+		{ \
+			return Detail::MakeBinary(Detail::VectorNode<Size, TUnderlying> { a_lhs }, a_rhs.node, Detail::_operation_()); \
+		} \
+		_OYL_REQUIRE_SEMICOLON
+
+	_VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR(+, AddOperation);
+	_VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR(-, SubOperation);
+	_VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR(*, MulOperation);
+	_VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR(/, DivOperation);
+
+	#undef _VECTOR_EXPRESSION_DEFINE_BINARY_OPERATOR
+
+	template<typename TNode>
+	constexpr
+	auto
+	operator *(VectorExpression<TNode> const& a_lhs, typename TNode::value_type a_rhs) noexcept
+	{
+		return Detail::MakeBinary(a_lhs.node, Detail::ScalarNode<TNode::size, typename TNode::value_type> { a_rhs }, Detail::MulOperation());
+	}
+
+	template<typename TNode>
+	constexpr
+	auto
+	operator *(typename TNode::value_type a_lhs, VectorExpression<TNode> const& a_rhs) noexcept
+	{
+		return Detail::MakeBinary(Detail::ScalarNode<TNode::size, typename TNode::value_type> { a_lhs }, a_rhs.node, Detail::MulOperation());
+	}
+
+	template<typename TNode>
+	constexpr
+	auto
+	operator /(VectorExpression<TNode> const& a_lhs, typename TNode::value_type a_rhs) noexcept
+	{
+		return Detail::MakeBinary(a_lhs.node, Detail::ScalarNode<TNode::size, typename TNode::value_type> { a_rhs }, Detail::DivOperation());
+	}
+
+	template<typename TNode>
+	constexpr
+	VectorExpression<Detail::UnaryNode<TNode, Detail::NegateOperation>>
+	operator -(VectorExpression<TNode> const& a_value) noexcept
+	{
+		return { { a_value.node } };
+	}
+}
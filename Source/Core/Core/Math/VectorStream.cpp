@@ -0,0 +1,230 @@
+#include "pch.h"
+#include "VectorStream.h"
+
+#include "Simd.h"
+
+namespace Oyl::Vector
+{
+	namespace
+	{
+		constexpr std::size_t block_size = Vector3Stream::block_size;
+		static_assert(Vector4Stream::block_size == block_size);
+
+		/// Row a_row of a_matrix broadcast into one register per column
+		struct MatrixRow
+		{
+			Simd::Float8 x, y, z, w;
+		};
+
+		MatrixRow
+		LoadRow(Matrix4 const& a_matrix, int a_row)
+		{
+			float const* row = a_matrix.data + a_row * 4;
+			return MatrixRow { Simd::Splat8(row[0]), Simd::Splat8(row[1]), Simd::Splat8(row[2]), Simd::Splat8(row[3]) };
+		}
+
+		/// Stores the first a_count lanes of a_value, the rest of a_dst is left untouched
+		void
+		StorePartial(float* a_dst, Simd::Float8 a_value, std::size_t a_count)
+		{
+			if (a_count == block_size)
+			{
+				Simd::Store(a_dst, a_value);
+				return;
+			}
+
+			alignas(32) float lanes[block_size];
+			Simd::Store(lanes, a_value);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				a_dst[i] = lanes[i];
+			}
+		}
+
+		/// Scales a_components by the inverse of their combined length, leaving zero length vectors untouched
+		template<int Size>
+		void
+		NormalizeBlock(Simd::Float8 (&a_components)[Size])
+		{
+			Simd::Float8 magnitudeSquared = Simd::Mul(a_components[0], a_components[0]);
+			for (int c = 1; c < Size; c++)
+			{
+				magnitudeSquared = Simd::MulAdd(a_components[c], a_components[c], magnitudeSquared);
+			}
+
+			Simd::Float8 isZero    = Simd::Equal(magnitudeSquared, Simd::Zero8());
+			Simd::Float8 magnitude = Simd::Sqrt(magnitudeSquared);
+			for (int c = 0; c < Size; c++)
+			{
+				// Divide rather than multiply by an rsqrt estimate to stay consistent with Vector::Normalize
+				a_components[c] = Simd::Select(isZero, a_components[c], Simd::Div(a_components[c], magnitude));
+			}
+		}
+
+		template<int Size>
+		void
+		NormalizeStream(VectorStream_t<Size> const& a_vectors, VectorStream_t<Size>& a_out)
+		{
+			a_out.Resize(a_vectors.Count());
+
+			for (std::size_t i = 0; i < a_vectors.PaddedCount(); i += block_size)
+			{
+				Simd::Float8 components[Size];
+				for (int c = 0; c < Size; c++)
+				{
+					components[c] = Simd::Load8(a_vectors.Component(c) + i);
+				}
+
+				NormalizeBlock(components);
+
+				for (int c = 0; c < Size; c++)
+				{
+					Simd::Store(a_out.Component(c) + i, components[c]);
+				}
+			}
+		}
+
+		template<int Size>
+		void
+		DotStream(VectorStream_t<Size> const& a_lhs, VectorStream_t<Size> const& a_rhs, float* a_out)
+		{
+			OYL_ASSERT(a_lhs.Count() == a_rhs.Count());
+
+			std::size_t count = a_lhs.Count();
+			for (std::size_t i = 0; i < count; i += block_size)
+			{
+				Simd::Float8 result = Simd::Mul(Simd::Load8(a_lhs.Component(0) + i), Simd::Load8(a_rhs.Component(0) + i));
+				for (int c = 1; c < Size; c++)
+				{
+					result = Simd::MulAdd(Simd::Load8(a_lhs.Component(c) + i), Simd::Load8(a_rhs.Component(c) + i), result);
+				}
+
+				StorePartial(a_out + i, result, std::min(block_size, count - i));
+			}
+		}
+
+		/// a_out[i] = (a_vectors[i], a_w) * a_matrix for 3 component streams
+		void
+		TransformStream3(Matrix4 const& a_matrix, Vector3Stream const& a_vectors, Vector3Stream& a_out, bool a_translate)
+		{
+			a_out.Resize(a_vectors.Count());
+
+			MatrixRow row0 = LoadRow(a_matrix, 0);
+			MatrixRow row1 = LoadRow(a_matrix, 1);
+			MatrixRow row2 = LoadRow(a_matrix, 2);
+			MatrixRow row3 = a_translate ? LoadRow(a_matrix, 3) : MatrixRow { Simd::Zero8(), Simd::Zero8(), Simd::Zero8(), Simd::Zero8() };
+
+			for (std::size_t i = 0; i < a_vectors.PaddedCount(); i += block_size)
+			{
+				Simd::Float8 x = Simd::Load8(a_vectors.X() + i);
+				Simd::Float8 y = Simd::Load8(a_vectors.Y() + i);
+				Simd::Float8 z = Simd::Load8(a_vectors.Z() + i);
+
+				Simd::Float8 resultX = Simd::MulAdd(z, row2.x, Simd::MulAdd(y, row1.x, Simd::MulAdd(x, row0.x, row3.x)));
+				Simd::Float8 resultY = Simd::MulAdd(z, row2.y, Simd::MulAdd(y, row1.y, Simd::MulAdd(x, row0.y, row3.y)));
+				Simd::Float8 resultZ = Simd::MulAdd(z, row2.z, Simd::MulAdd(y, row1.z, Simd::MulAdd(x, row0.z, row3.z)));
+
+				Simd::Store(a_out.X() + i, resultX);
+				Simd::Store(a_out.Y() + i, resultY);
+				Simd::Store(a_out.Z() + i, resultZ);
+			}
+		}
+	}
+
+	void
+	TransformPoints(Matrix4 const& a_matrix, Vector3Stream const& a_points, Vector3Stream& a_out)
+	{
+		TransformStream3(a_matrix, a_points, a_out, true);
+	}
+
+	void
+	TransformDirections(Matrix4 const& a_matrix, Vector3Stream const& a_directions, Vector3Stream& a_out)
+	{
+		TransformStream3(a_matrix, a_directions, a_out, false);
+	}
+
+	void
+	Transform(Matrix4 const& a_matrix, Vector4Stream const& a_vectors, Vector4Stream& a_out)
+	{
+		a_out.Resize(a_vectors.Count());
+
+		MatrixRow rows[4] = { LoadRow(a_matrix, 0), LoadRow(a_matrix, 1), LoadRow(a_matrix, 2), LoadRow(a_matrix, 3) };
+
+		for (std::size_t i = 0; i < a_vectors.PaddedCount(); i += block_size)
+		{
+			Simd::Float8 components[4] = {
+				Simd::Load8(a_vectors.X() + i),
+				Simd::Load8(a_vectors.Y() + i),
+				Simd::Load8(a_vectors.Z() + i),
+				Simd::Load8(a_vectors.W() + i),
+			};
+
+			Simd::Float8 resultX = Simd::Mul(components[0], rows[0].x);
+			Simd::Float8 resultY = Simd::Mul(components[0], rows[0].y);
+			Simd::Float8 resultZ = Simd::Mul(components[0], rows[0].z);
+			Simd::Float8 resultW = Simd::Mul(components[0], rows[0].w);
+			for (int r = 1; r < 4; r++)
+			{
+				resultX = Simd::MulAdd(components[r], rows[r].x, resultX);
+				resultY = Simd::MulAdd(components[r], rows[r].y, resultY);
+				resultZ = Simd::MulAdd(components[r], rows[r].z, resultZ);
+				resultW = Simd::MulAdd(components[r], rows[r].w, resultW);
+			}
+
+			Simd::Store(a_out.X() + i, resultX);
+			Simd::Store(a_out.Y() + i, resultY);
+			Simd::Store(a_out.Z() + i, resultZ);
+			Simd::Store(a_out.W() + i, resultW);
+		}
+	}
+
+	void
+	Normalize(Vector3Stream const& a_vectors, Vector3Stream& a_out)
+	{
+		NormalizeStream(a_vectors, a_out);
+	}
+
+	void
+	Normalize(Vector4Stream const& a_vectors, Vector4Stream& a_out)
+	{
+		NormalizeStream(a_vectors, a_out);
+	}
+
+	void
+	Dot(Vector3Stream const& a_lhs, Vector3Stream const& a_rhs, float* a_out)
+	{
+		DotStream(a_lhs, a_rhs, a_out);
+	}
+
+	void
+	Dot(Vector4Stream const& a_lhs, Vector4Stream const& a_rhs, float* a_out)
+	{
+		DotStream(a_lhs, a_rhs, a_out);
+	}
+
+	void
+	Cross(Vector3Stream const& a_lhs, Vector3Stream const& a_rhs, Vector3Stream& a_out)
+	{
+		OYL_ASSERT(a_lhs.Count() == a_rhs.Count());
+
+		a_out.Resize(a_lhs.Count());
+
+		for (std::size_t i = 0; i < a_lhs.PaddedCount(); i += block_size)
+		{
+			Simd::Float8 lhsX = Simd::Load8(a_lhs.X() + i);
+			Simd::Float8 lhsY = Simd::Load8(a_lhs.Y() + i);
+			Simd::Float8 lhsZ = Simd::Load8(a_lhs.Z() + i);
+			Simd::Float8 rhsX = Simd::Load8(a_rhs.X() + i);
+			Simd::Float8 rhsY = Simd::Load8(a_rhs.Y() + i);
+			Simd::Float8 rhsZ = Simd::Load8(a_rhs.Z() + i);
+
+			Simd::Float8 resultX = Simd::Sub(Simd::Mul(lhsY, rhsZ), Simd::Mul(lhsZ, rhsY));
+			Simd::Float8 resultY = Simd::Sub(Simd::Mul(lhsZ, rhsX), Simd::Mul(lhsX, rhsZ));
+			Simd::Float8 resultZ = Simd::Sub(Simd::Mul(lhsX, rhsY), Simd::Mul(lhsY, rhsX));
+
+			Simd::Store(a_out.X() + i, resultX);
+			Simd::Store(a_out.Y() + i, resultY);
+			Simd::Store(a_out.Z() + i, resultZ);
+		}
+	}
+}
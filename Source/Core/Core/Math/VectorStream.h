@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix4.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+#include "Core/Common.h"
+#include "Core/Types/AlignedAllocator.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Structure of arrays container for large sets of float vectors, ie. vertex positions or particles.
+	 * \remarks Each component lives in its own 64 byte aligned array, so the bulk kernels below can process
+	 *          block_size vectors per iteration with full width SIMD loads instead of shuffling Vector_t's apart.
+	 *          Storage is padded up to a multiple of block_size so kernels never need a scalar tail loop.
+	 *          The padding lanes are never exposed and their contents are unspecified.
+	 */
+	template<int Size>
+	class VectorStream_t
+	{
+		static_assert(Size == 3 || Size == 4, "Vector streams are only implemented for 3 and 4 component vectors");
+
+	public:
+		using value_type = Vector_t<Size, float>;
+		using component_storage = std::vector<float, AlignedAllocator<float, 64>>;
+
+		constexpr static int size = Size;
+
+		/// Number of vectors processed per iteration by the bulk kernels, and the granularity of the padding
+		constexpr static std::size_t block_size = 8;
+
+		VectorStream_t() = default;
+
+		explicit
+		VectorStream_t(std::size_t a_count)
+		{
+			Resize(a_count);
+		}
+
+		VectorStream_t(value_type const* a_src, std::size_t a_count)
+		{
+			Assign(a_src, a_count);
+		}
+
+		std::size_t
+		Count() const noexcept { return m_count; }
+
+		/// \return The number of elements in each component array, Count() rounded up to a multiple of block_size
+		std::size_t
+		PaddedCount() const noexcept { return m_components[0].size(); }
+
+		bool
+		Empty() const noexcept { return m_count == 0; }
+
+		/// \brief Resizes the stream, new elements are zero initialized
+		void
+		Resize(std::size_t a_count)
+		{
+			std::size_t paddedCount = (a_count + block_size - 1) & ~(block_size - 1);
+			for (auto& component : m_components)
+			{
+				component.resize(paddedCount, 0.0f);
+
+				// Shrinking then growing again would otherwise surface stale padding values
+				for (std::size_t i = m_count; i < a_count; i++)
+				{
+					component[i] = 0.0f;
+				}
+			}
+			m_count = a_count;
+		}
+
+		void
+		Reserve(std::size_t a_count)
+		{
+			std::size_t paddedCount = (a_count + block_size - 1) & ~(block_size - 1);
+			for (auto& component : m_components)
+			{
+				component.reserve(paddedCount);
+			}
+		}
+
+		void
+		Clear() noexcept
+		{
+			for (auto& component : m_components)
+			{
+				component.clear();
+			}
+			m_count = 0;
+		}
+
+		void
+		PushBack(value_type const& a_value)
+		{
+			std::size_t index = m_count;
+			Resize(m_count + 1);
+			Set(index, a_value);
+		}
+
+		/// \brief Replaces the contents of the stream with a_count vectors gathered from an array of structures
+		void
+		Assign(value_type const* a_src, std::size_t a_count)
+		{
+			Resize(a_count);
+			for (std::size_t i = 0; i < a_count; i++)
+			{
+				Set(i, a_src[i]);
+			}
+		}
+
+		/// \brief Scatters the stream back into an array of structures holding at least Count() vectors
+		void
+		CopyTo(value_type* a_dst) const
+		{
+			for (std::size_t i = 0; i < m_count; i++)
+			{
+				a_dst[i] = Get(i);
+			}
+		}
+
+		value_type
+		Get(std::size_t a_index) const
+		{
+			OYL_ASSERT(a_index < m_count);
+
+			value_type result;
+			for (int c = 0; c < Size; c++)
+			{
+				result.data[c] = m_components[c][a_index];
+			}
+			return result;
+		}
+
+		void
+		Set(std::size_t a_index, value_type const& a_value)
+		{
+			OYL_ASSERT(a_index < m_count);
+
+			for (int c = 0; c < Size; c++)
+			{
+				m_components[c][a_index] = a_value.data[c];
+			}
+		}
+
+		/// \return The 64 byte aligned array holding component a_component of every vector, PaddedCount() long
+		float*
+		Component(int a_component) noexcept { return m_components[a_component].data(); }
+
+		float const*
+		Component(int a_component) const noexcept { return m_components[a_component].data(); }
+
+		float*       X() noexcept { return Component(0); }
+		float const* X() const noexcept { return Component(0); }
+
+		float*       Y() noexcept { return Component(1); }
+		float const* Y() const noexcept { return Component(1); }
+
+		float*       Z() noexcept { return Component(2); }
+		float const* Z() const noexcept { return Component(2); }
+
+		float*
+		W() noexcept
+		{
+			static_assert(Size == 4, "Only 4 component streams have a w component");
+			return Component(3);
+		}
+
+		float const*
+		W() const noexcept
+		{
+			static_assert(Size == 4, "Only 4 component streams have a w component");
+			return Component(3);
+		}
+
+	private:
+		std::size_t m_count = 0;
+
+		component_storage m_components[Size];
+	};
+
+	typedef VectorStream_t<3> Vector3Stream;
+	typedef VectorStream_t<4> Vector4Stream;
+}
+
+namespace Oyl::Vector
+{
+	// Bulk kernels over vector streams.
+	// Each resizes a_out to match the input, and a_out may be the same stream as any of the inputs.
+	// Vectors follow the engine's row vector convention, v' = v * M.
+
+	/// \brief a_out[i] = (a_points[i], 1) * a_matrix, without a perspective divide
+	OYL_CORE_API
+	extern
+	void
+	TransformPoints(Matrix4 const& a_matrix, Vector3Stream const& a_points, Vector3Stream& a_out);
+
+	/// \brief a_out[i] = (a_directions[i], 0) * a_matrix, ie. translation is ignored
+	OYL_CORE_API
+	extern
+	void
+	TransformDirections(Matrix4 const& a_matrix, Vector3Stream const& a_directions, Vector3Stream& a_out);
+
+	/// \brief a_out[i] = a_vectors[i] * a_matrix
+	OYL_CORE_API
+	extern
+	void
+	Transform(Matrix4 const& a_matrix, Vector4Stream const& a_vectors, Vector4Stream& a_out);
+
+	/// \brief a_out[i] = Vector::Normalize(a_vectors[i]), zero length vectors are left unchanged
+	OYL_CORE_API
+	extern
+	void
+	Normalize(Vector3Stream const& a_vectors, Vector3Stream& a_out);
+
+	/// \brief a_out[i] = Vector::Normalize(a_vectors[i]), zero length vectors are left unchanged
+	OYL_CORE_API
+	extern
+	void
+	Normalize(Vector4Stream const& a_vectors, Vector4Stream& a_out);
+
+	/// \brief a_out[i] = Vector::Dot(a_lhs[i], a_rhs[i]), a_out must hold at least a_lhs.Count() floats
+	OYL_CORE_API
+	extern
+	void
+	Dot(Vector3Stream const& a_lhs, Vector3Stream const& a_rhs, float* a_out);
+
+	/// \brief a_out[i] = Vector::Dot(a_lhs[i], a_rhs[i]), a_out must hold at least a_lhs.Count() floats
+	OYL_CORE_API
+	extern
+	void
+	Dot(Vector4Stream const& a_lhs, Vector4Stream const& a_rhs, float* a_out);
+
+	/// \brief a_out[i] = Vector::Cross(a_lhs[i], a_rhs[i])
+	OYL_CORE_API
+	extern
+	void
+	Cross(Vector3Stream const& a_lhs, Vector3Stream const& a_rhs, Vector3Stream& a_out);
+}
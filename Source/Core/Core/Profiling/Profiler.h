@@ -8,9 +8,14 @@
 
 #	define OYL_PROFILE_SCOPE(...)       OYL_MACRO_OVERLOAD(_OYL_PROFILE_SCOPE, __VA_ARGS__)
 #	define _OYL_PROFILE_SCOPE_1(_name_) ZoneScopedN(_name_)
+// Zone named by a string only known at runtime, ie. a system's name
+#	define _OYL_PROFILE_SCOPE_2(_name_, _length_) ZoneScoped; ZoneName(_name_, _length_)
 
 #	define OYL_PROFILE_FUNCTION() ZoneScoped
 
+// Adds a sample to a graph over time, _name_ must be a string literal as the profiler keys graphs by its address
+#	define OYL_PROFILE_PLOT(_name_, _value_) TracyPlot(_name_, _value_)
+
 #	define OYL_FRAME_MARK()             FrameMark
 #	define OYL_FRAME_MARK_NAMED(_name_) FrameMarkNamed(_name_)
 
@@ -19,8 +24,11 @@
 #else
 #	define OYL_PROFILER_INIT()
 #	define OYL_PROFILER_SHUTDOWN()
-#	define OYL_PROFILE_SCOPE(...) OYL_UNUSED(__VA_ARGS__)
+#	define OYL_PROFILE_SCOPE(...) OYL_MACRO_OVERLOAD(_OYL_PROFILE_SCOPE, __VA_ARGS__)
+#	define _OYL_PROFILE_SCOPE_1(_name_) OYL_UNUSED(_name_)
+#	define _OYL_PROFILE_SCOPE_2(_name_, _length_) (OYL_UNUSED(_name_), OYL_UNUSED(_length_))
 #	define OYL_PROFILE_FUNCTION()
+#	define OYL_PROFILE_PLOT(_name_, _value_) (OYL_UNUSED(_name_), OYL_UNUSED(_value_))
 #	define OYL_FRAME_MARK()
 #	define OYL_FRAME_MARK_NAMED(_name_) OYL_UNUSED(_name_)
 #	define OYL_FRAME_MARK_START(_name_) OYL_UNUSED(_name_)
@@ -0,0 +1,115 @@
+#include "pch.h"
+#include "SpatialIndex.h"
+
+namespace Oyl
+{
+	uint32
+	SpatialIndex::Add(AABB const& a_bounds, uint32 a_userData)
+	{
+		m_frame.inserts++;
+		return m_tree.Insert(a_bounds, a_userData);
+	}
+
+	void
+	SpatialIndex::Remove(uint32 a_proxy)
+	{
+		// A queued move of the proxy would apply to whatever reuses its handle, drop it by moving the last one in
+		if (a_proxy < m_queueSlots.size() && m_queueSlots[a_proxy] != not_queued)
+		{
+			uint32 const slot = m_queueSlots[a_proxy];
+			uint32 const last = m_queuedProxies.back();
+
+			m_queuedProxies[slot]       = last;
+			m_queuedBounds[slot]        = m_queuedBounds.back();
+			m_queuedDisplacements[slot] = m_queuedDisplacements.back();
+			m_queueSlots[last]          = slot;
+
+			m_queuedProxies.pop_back();
+			m_queuedBounds.pop_back();
+			m_queuedDisplacements.pop_back();
+			m_queueSlots[a_proxy] = not_queued;
+		}
+
+		m_frame.removes++;
+		m_tree.Remove(a_proxy);
+	}
+
+	void
+	SpatialIndex::Move(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement)
+	{
+		if (a_proxy >= m_queueSlots.size())
+		{
+			m_queueSlots.resize(std::max<std::size_t>(m_tree.Capacity(), a_proxy + 1), not_queued);
+		}
+
+		uint32& slot = m_queueSlots[a_proxy];
+		if (slot != not_queued)
+		{
+			m_queuedBounds[slot]         = a_bounds;
+			m_queuedDisplacements[slot] += a_displacement;
+			return;
+		}
+
+		slot = static_cast<uint32>(m_queuedProxies.size());
+		m_queuedProxies.push_back(a_proxy);
+		m_queuedBounds.push_back(a_bounds);
+		m_queuedDisplacements.push_back(a_displacement);
+	}
+
+	void
+	SpatialIndex::Flush()
+	{
+		OYL_PROFILE_FUNCTION();
+
+		if (m_queuedProxies.empty())
+		{
+			return;
+		}
+
+		m_frame.moves     += m_queuedProxies.size();
+		m_frame.reinserts += m_tree.MoveBatch(
+			m_queuedProxies.data(),
+			m_queuedBounds.data(),
+			m_queuedProxies.size(),
+			m_queuedDisplacements.data()
+		);
+
+		for (uint32 proxy : m_queuedProxies)
+		{
+			m_queueSlots[proxy] = not_queued;
+		}
+		m_queuedProxies.clear();
+		m_queuedBounds.clear();
+		m_queuedDisplacements.clear();
+	}
+
+	void
+	SpatialIndex::OnUpdate()
+	{
+		OYL_PROFILE_FUNCTION();
+
+		Flush();
+
+		m_frame.proxyCount = m_tree.ProxyCount();
+		m_frame.height     = m_tree.Height();
+		m_lastFrame        = m_frame;
+		m_frame            = SpatialIndexStats {};
+
+		OYL_PROFILE_PLOT("Spatial Index Proxies", static_cast<int64>(m_lastFrame.proxyCount));
+		OYL_PROFILE_PLOT("Spatial Index Height", static_cast<int64>(m_lastFrame.height));
+		OYL_PROFILE_PLOT("Spatial Index Moves", static_cast<int64>(m_lastFrame.moves));
+		OYL_PROFILE_PLOT("Spatial Index Reinserts", static_cast<int64>(m_lastFrame.reinserts));
+		OYL_PROFILE_PLOT("Spatial Index Inserts", static_cast<int64>(m_lastFrame.inserts));
+		OYL_PROFILE_PLOT("Spatial Index Removes", static_cast<int64>(m_lastFrame.removes));
+	}
+
+	void
+	SpatialIndex::OnShutdown()
+	{
+		m_tree.Clear();
+		m_queuedProxies.clear();
+		m_queuedBounds.clear();
+		m_queuedDisplacements.clear();
+		m_queueSlots.clear();
+	}
+}
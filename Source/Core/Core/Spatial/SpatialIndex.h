@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "Core/Common.h"
+#include "Core/Application/Module.h"
+#include "Core/Math/Bounds.h"
+#include "Core/Math/DynamicTree.h"
+#include "Core/Math/Vector3.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/// Counters of one frame of SpatialIndex, also plotted in the profiler every update
+	struct SpatialIndexStats
+	{
+		std::size_t proxyCount = 0;
+		uint32      height     = 0;
+
+		std::size_t inserts = 0;
+		std::size_t removes = 0;
+		std::size_t moves   = 0;
+		/// Moves that left their fat box and were reinserted into the tree
+		std::size_t reinserts = 0;
+	};
+
+	/**
+	 * \brief Shared spatial index of moving objects, a DynamicTree updated once per frame
+	 * \remarks Add and Remove apply immediately. Move only queues the new box, every queued move is applied as one
+	 *          DynamicTree::MoveBatch in OnUpdate, or earlier with Flush. Moving a proxy several times in a frame
+	 *          keeps only its last box. Queries see the tree as of the last flush.
+	 */
+	class OYL_CORE_API SpatialIndex : public Module
+	{
+		OYL_DECLARE_MODULE(SpatialIndex, "Spatial Index");
+
+	public:
+#pragma region Updates
+		/// \return The proxy's handle, stays valid until Remove
+		uint32
+		Add(AABB const& a_bounds, uint32 a_userData);
+
+		void
+		Remove(uint32 a_proxy);
+
+		/// \param a_displacement How far the object moved this frame, summed over the frame's moves
+		void
+		Move(uint32 a_proxy, AABB const& a_bounds, Vector3 const& a_displacement = Vector3(0, 0, 0));
+
+		/// \brief Applies every queued move now instead of at the next update
+		void
+		Flush();
+
+		/// \brief Grows the tree's pool for at least a_proxyCount proxies
+		void Reserve(std::size_t a_proxyCount) { m_tree.Reserve(a_proxyCount); }
+#pragma endregion
+#pragma region Queries
+		// See the DynamicTree queries, the outputs must hold at least ProxyCount() elements.
+
+		std::size_t Overlap(AABB const& a_query, uint32* a_hits) const { return m_tree.Overlap(a_query, a_hits); }
+
+		std::size_t Overlap(Sphere const& a_query, uint32* a_hits) const { return m_tree.Overlap(a_query, a_hits); }
+
+		std::size_t Cull(Frustum const& a_frustum, uint32* a_hits) const { return m_tree.Cull(a_frustum, a_hits); }
+
+		std::size_t
+		Nearest(
+			Vector3 const& a_point,
+			std::size_t    a_count,
+			uint32*        a_hits,
+			float*         a_distances = nullptr,
+			float          a_maxDistance = std::numeric_limits<float>::infinity()
+		) const
+		{
+			return m_tree.Nearest(a_point, a_count, a_hits, a_distances, a_maxDistance);
+		}
+
+		void
+		OverlapBatch(AABB const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const
+		{
+			m_tree.OverlapBatch(a_queries, a_count, a_hits, a_offsets);
+		}
+
+		void
+		OverlapBatch(Sphere const* a_queries, std::size_t a_count, std::vector<uint32>& a_hits, uint32* a_offsets) const
+		{
+			m_tree.OverlapBatch(a_queries, a_count, a_hits, a_offsets);
+		}
+#pragma endregion
+
+		std::size_t ProxyCount() const noexcept { return m_tree.ProxyCount(); }
+
+		DynamicTree const& Tree() const noexcept { return m_tree; }
+
+		/// \brief Counters of the last update
+		SpatialIndexStats const& LastFrameStats() const noexcept { return m_lastFrame; }
+
+		void
+		OnUpdate() override;
+
+		void
+		OnShutdown() override;
+
+	private:
+		constexpr static uint32 not_queued = ~0u;
+
+		DynamicTree m_tree;
+
+		// Moves queued since the last flush, one entry per proxy
+		std::vector<uint32>  m_queuedProxies;
+		std::vector<AABB>    m_queuedBounds;
+		std::vector<Vector3> m_queuedDisplacements;
+		/// Index into the queue of each proxy, by proxy handle
+		std::vector<uint32>  m_queueSlots;
+
+		SpatialIndexStats m_frame;
+		SpatialIndexStats m_lastFrame;
+	};
+}
@@ -0,0 +1,125 @@
+#include "pch.h"
+#include "WorkerPool.h"
+
+#include <atomic>
+
+namespace Oyl
+{
+	WorkerPool::WorkerPool(std::size_t a_threadCount)
+	{
+		std::size_t threadCount = a_threadCount;
+		if (threadCount == 0)
+		{
+			threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		}
+
+		m_threads.reserve(threadCount - 1);
+		for (std::size_t index = 1; index < threadCount; index++)
+		{
+			m_threads.emplace_back(&WorkerPool::WorkerMain, this, index);
+		}
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stopping = true;
+		}
+		m_start.notify_all();
+
+		for (std::thread& thread : m_threads)
+		{
+			thread.join();
+		}
+	}
+
+	void
+	WorkerPool::Run(std::function<void(std::size_t)> const& a_func)
+	{
+		if (m_threads.empty())
+		{
+			a_func(0);
+			return;
+		}
+
+		{
+			std::lock_guard lock(m_mutex);
+			OYL_ASSERT(m_func == nullptr);
+			m_func    = &a_func;
+			m_running = m_threads.size();
+			m_region++;
+		}
+		m_start.notify_all();
+
+		a_func(0);
+
+		std::unique_lock lock(m_mutex);
+		m_finished.wait(lock, [this] { return m_running == 0; });
+		m_func = nullptr;
+	}
+
+	void
+	WorkerPool::ParallelFor(std::size_t a_count, std::function<void(std::size_t)> const& a_func)
+	{
+		if (m_threads.empty() || a_count <= 1)
+		{
+			for (std::size_t index = 0; index < a_count; index++)
+			{
+				a_func(index);
+			}
+			return;
+		}
+
+		std::atomic<std::size_t> next = 0;
+		Run([&next, a_count, &a_func](std::size_t)
+		{
+			for (std::size_t index = next++; index < a_count; index = next++)
+			{
+				a_func(index);
+			}
+		});
+	}
+
+	void
+	WorkerPool::ParallelForRanges(std::size_t a_count, std::function<void(std::size_t, std::size_t)> const& a_func)
+	{
+		std::size_t const rangeCount = std::min(a_count, ThreadCount() * ranges_per_thread);
+		ParallelFor(rangeCount, [a_count, rangeCount, &a_func](std::size_t a_range)
+		{
+			a_func(a_count * a_range / rangeCount, a_count * (a_range + 1) / rangeCount);
+		});
+	}
+
+	void
+	WorkerPool::WorkerMain(std::size_t a_index)
+	{
+		uint64 region = 0;
+		while (true)
+		{
+			std::function<void(std::size_t)> const* func;
+			{
+				std::unique_lock lock(m_mutex);
+				m_start.wait(lock, [this, region] { return m_stopping || m_region != region; });
+				if (m_stopping)
+				{
+					return;
+				}
+				region = m_region;
+				func   = m_func;
+			}
+
+			(*func)(a_index);
+
+			bool last;
+			{
+				std::lock_guard lock(m_mutex);
+				last = --m_running == 0;
+			}
+			if (last)
+			{
+				m_finished.notify_one();
+			}
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/Common.h"
+#include "Core/Types/Typedefs.h"
+
+namespace Oyl
+{
+	/**
+	 * \brief Fixed set of threads that run parallel regions, started once and kept waiting between them
+	 * \remarks The thread calling Run takes part as thread 0, so a pool of one thread starts no threads and runs
+	 *          everything inline. How the work is split between the threads is left to the function, ie. a queue
+	 *          the threads take tasks from.
+	 */
+	class OYL_CORE_API WorkerPool
+	{
+	public:
+		/// Ranges per thread ParallelForRanges makes, more than one so threads finishing early take over from slower ones
+		constexpr static std::size_t ranges_per_thread = 4;
+
+		/// \param a_threadCount Threads including the calling one, 0 for one per hardware thread
+		explicit
+		WorkerPool(std::size_t a_threadCount = 0);
+
+		~WorkerPool();
+
+		WorkerPool(WorkerPool const&) = delete;
+		WorkerPool&
+		operator =(WorkerPool const&) = delete;
+
+		/// \brief Threads Run calls its function on, including the calling one
+		std::size_t ThreadCount() const noexcept { return m_threads.size() + 1; }
+
+		/**
+		 * \brief Calls a_func(threadIndex) once on every thread, returning once every call has returned
+		 * \remarks Not reentrant, a_func cannot call Run on the same pool.
+		 */
+		void
+		Run(std::function<void(std::size_t)> const& a_func);
+
+		/**
+		 * \brief Calls a_func(index) for every index in [0, a_count) on the threads, returning once every call has returned
+		 * \remarks Each thread takes the next index whenever it finishes one, so uneven items still balance. Not
+		 *          reentrant, like Run.
+		 */
+		void
+		ParallelFor(std::size_t a_count, std::function<void(std::size_t)> const& a_func);
+
+		/**
+		 * \brief Splits [0, a_count) into ranges_per_thread ranges per thread and calls a_func(first, last) for each, like ParallelFor
+		 * \remarks For evenly sized items too small to hand out one at a time, ie. the rows of a grid.
+		 */
+		void
+		ParallelForRanges(std::size_t a_count, std::function<void(std::size_t a_first, std::size_t a_last)> const& a_func);
+
+	private:
+		std::vector<std::thread> m_threads;
+
+		std::mutex              m_mutex;
+		std::condition_variable m_start;
+		std::condition_variable m_finished;
+
+		std::function<void(std::size_t)> const* m_func = nullptr;
+		/// Bumped by every Run, so waiting threads tell a new region from a spurious wakeup
+		uint64      m_region   = 0;
+		std::size_t m_running  = 0;
+		bool        m_stopping = false;
+
+		void
+		WorkerMain(std::size_t a_index);
+	};
+}
@@ -66,7 +66,19 @@ namespace Oyl::Time
 	{
 		return Detail::g_fixedDeltaTime;
 	}
-	
+
+	/**
+	 * \brief How far a frame is between the last two fixed steps, the alpha to interpolate their states by
+	 * \param a_accumulator Time not yet consumed by fixed steps, between 0 and FixedDeltaTime()
+	 */
+	inline
+	float
+	FixedStepAlpha(float a_accumulator)
+	{
+		float const fixedDeltaTime = Detail::g_fixedDeltaTime;
+		return fixedDeltaTime > 0 ? std::clamp(a_accumulator / fixedDeltaTime, 0.0f, 1.0f) : 1.0f;
+	}
+
 	inline
 	float
 	SmoothDeltaTime()
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace Oyl
+{
+	/**
+	 * \brief Standard library allocator that aligns every allocation to Alignment bytes.
+	 * \remark Used by containers whose storage is read with wide SIMD loads, ie. std::vector<float, AlignedAllocator<float, 64>>
+	 */
+	template<typename T, std::size_t Alignment>
+	struct AlignedAllocator
+	{
+		static_assert(Alignment >= alignof(T), "Alignment must be at least the natural alignment of T");
+		static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+		using value_type = T;
+
+		template<typename TOther>
+		struct rebind
+		{
+			using other = AlignedAllocator<TOther, Alignment>;
+		};
+
+		constexpr
+		AlignedAllocator() noexcept = default;
+
+		template<typename TOther>
+		constexpr
+		AlignedAllocator(AlignedAllocator<TOther, Alignment> const&) noexcept {}
+
+		T*
+		allocate(std::size_t a_count)
+		{
+			return static_cast<T*>(::operator new(a_count * sizeof(T), std::align_val_t(Alignment)));
+		}
+
+		void
+		deallocate(T* a_pointer, std::size_t a_count) noexcept
+		{
+			::operator delete(a_pointer, a_count * sizeof(T), std::align_val_t(Alignment));
+		}
+
+		template<typename TOther>
+		constexpr
+		bool
+		operator ==(AlignedAllocator<TOther, Alignment> const&) const noexcept { return true; }
+
+		template<typename TOther>
+		constexpr
+		bool
+		operator !=(AlignedAllocator<TOther, Alignment> const&) const noexcept { return false; }
+	};
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+
 namespace Oyl
 {
 	using int8  = int8_t;